@@ -0,0 +1,46 @@
+#
+# Copyright 2024 Adobe. All rights reserved.
+# This file is licensed to you under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License. You may obtain a copy
+# of the License at http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software distributed under
+# the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR REPRESENTATIONS
+# OF ANY KIND, either express or implied. See the License for the specific language
+# governing permissions and limitations under the License.
+#
+if(TARGET draco::draco)
+    return()
+endif()
+
+message(STATUS "Third-party (external): creating target 'draco::draco'")
+
+option(DRACO_JS_GLUE "Enable JS Glue and JS targets when using Emscripten" OFF)
+option(DRACO_TESTS "Enables tests" OFF)
+option(DRACO_TRANSCODER_SUPPORTED "Enable the transcoder" OFF)
+
+include(CPM)
+CPMAddPackage(
+    NAME draco
+    GITHUB_REPOSITORY google/draco
+    GIT_TAG 1.5.7
+)
+
+# Draco does not export a namespaced target, and its generated feature header lives in the build
+# directory.
+if(TARGET draco_static)
+    set(LAGRANGE_DRACO_TARGET draco_static)
+else()
+    set(LAGRANGE_DRACO_TARGET draco)
+endif()
+
+add_library(lagrange_draco INTERFACE)
+add_library(draco::draco ALIAS lagrange_draco)
+target_link_libraries(lagrange_draco INTERFACE ${LAGRANGE_DRACO_TARGET})
+target_include_directories(lagrange_draco INTERFACE
+    $<BUILD_INTERFACE:${draco_SOURCE_DIR}/src>
+    $<BUILD_INTERFACE:${draco_BINARY_DIR}>
+)
+
+set_target_properties(${LAGRANGE_DRACO_TARGET} PROPERTIES FOLDER third_party)
+set_target_properties(${LAGRANGE_DRACO_TARGET} PROPERTIES POSITION_INDEPENDENT_CODE ON)
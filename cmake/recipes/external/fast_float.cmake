@@ -0,0 +1,28 @@
+#
+# Copyright 2024 Adobe. All rights reserved.
+# This file is licensed to you under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License. You may obtain a copy
+# of the License at http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software distributed under
+# the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR REPRESENTATIONS
+# OF ANY KIND, either express or implied. See the License for the specific language
+# governing permissions and limitations under the License.
+#
+if(TARGET FastFloat::fast_float)
+    return()
+endif()
+
+message(STATUS "Third-party (external): creating target 'FastFloat::fast_float'")
+
+include(CPM)
+CPMAddPackage(
+    NAME fast_float
+    GITHUB_REPOSITORY fastfloat/fast_float
+    GIT_TAG v6.1.1
+    OPTIONS
+        "FASTFLOAT_TEST OFF"
+        "FASTFLOAT_INSTALL ON"
+)
+
+set_target_properties(fast_float PROPERTIES FOLDER third_party)
@@ -0,0 +1,30 @@
+#
+# Copyright 2024 Adobe. All rights reserved.
+# This file is licensed to you under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License. You may obtain a copy
+# of the License at http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software distributed under
+# the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR REPRESENTATIONS
+# OF ANY KIND, either express or implied. See the License for the specific language
+# governing permissions and limitations under the License.
+#
+if(TARGET meshoptimizer::meshoptimizer)
+    return()
+endif()
+
+message(STATUS "Third-party (external): creating target 'meshoptimizer::meshoptimizer'")
+
+option(MESHOPT_BUILD_SHARED_LIBS "Build shared libraries" OFF)
+
+include(CPM)
+CPMAddPackage(
+    NAME meshoptimizer
+    GITHUB_REPOSITORY zeux/meshoptimizer
+    GIT_TAG v0.21
+)
+
+add_library(meshoptimizer::meshoptimizer ALIAS meshoptimizer)
+
+set_target_properties(meshoptimizer PROPERTIES FOLDER third_party)
+set_target_properties(meshoptimizer PROPERTIES POSITION_INDEPENDENT_CODE ON)
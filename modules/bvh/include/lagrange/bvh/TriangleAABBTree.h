@@ -0,0 +1,194 @@
+/*
+ * Copyright 2024 Adobe. All rights reserved.
+ * This file is licensed to you under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License. You may obtain a copy
+ * of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under
+ * the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR REPRESENTATIONS
+ * OF ANY KIND, either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+ */
+#pragma once
+
+#include <lagrange/SurfaceMesh.h>
+#include <lagrange/bvh/api.h>
+#include <lagrange/utils/invalid.h>
+#include <lagrange/utils/span.h>
+
+#include <Eigen/Core>
+#include <Eigen/Geometry>
+
+#include <limits>
+#include <vector>
+
+namespace lagrange {
+namespace bvh {
+
+///
+/// Options for building a TriangleAABBTree.
+///
+struct TriangleAABBTreeOptions
+{
+    /// Maximum number of triangles stored in a leaf node.
+    size_t max_leaf_size = 4;
+
+    /// Number of bins used to evaluate the surface area heuristic when splitting a node.
+    size_t num_sah_bins = 16;
+};
+
+///
+/// AABB tree over the facets of a 3D triangle mesh.
+///
+/// The tree is built directly from the buffers of a SurfaceMesh: vertex positions and facet
+/// indices are referenced, not copied. Nodes are stored in a single flat array, where the two
+/// children of an internal node are always stored next to each other. The tree is built top-down
+/// using a binned surface area heuristic, and subtrees are built in parallel.
+///
+/// @warning    The input mesh must outlive the tree, and its vertex positions and facets must not
+///             be modified while the tree is in use.
+///
+/// @tparam     Scalar  Mesh scalar type.
+/// @tparam     Index   Mesh index type.
+///
+template <typename Scalar, typename Index>
+class LA_BVH_API TriangleAABBTree
+{
+public:
+    using Point = Eigen::Matrix<Scalar, 3, 1>;
+    using AlignedBox = Eigen::AlignedBox<Scalar, 3>;
+
+    ///
+    /// Flattened tree node.
+    ///
+    struct Node
+    {
+        /// Node bounding box.
+        AlignedBox bbox;
+
+        /// For internal nodes, index of the left child (the right child is stored at first + 1).
+        /// For leaf nodes, offset of the first triangle in the permuted triangle list.
+        Index first = invalid<Index>();
+
+        /// Number of triangles in a leaf node, 0 for internal nodes.
+        Index count = 0;
+
+        bool is_leaf() const { return count != 0; }
+    };
+
+public:
+    ///
+    /// Construct an empty tree.
+    ///
+    TriangleAABBTree() = default;
+
+    ///
+    /// Construct an AABB tree over the facets of a triangle mesh.
+    ///
+    /// @param[in]  mesh     Input triangle mesh. Must be a 3D triangle mesh.
+    /// @param[in]  options  Build options.
+    ///
+    explicit TriangleAABBTree(
+        const SurfaceMesh<Scalar, Index>& mesh,
+        const TriangleAABBTreeOptions& options = {});
+
+    ///
+    /// Test whether the tree is empty.
+    ///
+    /// @return     True iff empty, False otherwise.
+    ///
+    bool empty() const { return m_nodes.empty(); }
+
+    ///
+    /// Gets the flattened list of tree nodes. The root node is stored first.
+    ///
+    /// @return     A span of the tree nodes.
+    ///
+    span<const Node> get_nodes() const { return m_nodes; }
+
+    ///
+    /// Gets the closest point on the mesh to a given query point.
+    ///
+    /// @param[in]  p                Query point.
+    /// @param[out] facet_id         Closest facet id.
+    /// @param[out] barycentric      Barycentric coordinates of the closest point in the facet.
+    /// @param[out] closest_sq_dist  Squared distance between closest point and query point.
+    ///
+    /// @return     True if a closest point was found, false if the tree is empty.
+    ///
+    bool get_closest_point(
+        const Point& p,
+        Index& facet_id,
+        Point& barycentric,
+        Scalar& closest_sq_dist) const;
+
+    ///
+    /// Computes the closest points on the mesh for a batch of query points. Queries are evaluated
+    /// in parallel.
+    ///
+    /// @param[in]  query_points        #N x 3 query points, stored contiguously.
+    /// @param[out] facet_ids           #N closest facet ids. May be empty.
+    /// @param[out] barycentric_coords  #N x 3 barycentric coordinates of the closest points in
+    ///                                 their facet. May be empty.
+    /// @param[out] squared_distances   #N squared distances to the closest points. May be empty.
+    ///
+    /// @note       Output spans that are empty are skipped. Facet ids are set to
+    ///             invalid<Index>() if the tree is empty.
+    ///
+    void batch_closest_point(
+        span<const Scalar> query_points,
+        span<Index> facet_ids,
+        span<Scalar> barycentric_coords,
+        span<Scalar> squared_distances) const;
+
+    ///
+    /// Intersects a ray with the mesh and retrieves the closest hit.
+    ///
+    /// @param[in]  origin       Ray origin.
+    /// @param[in]  direction    Ray direction. Does not need to be normalized.
+    /// @param[out] facet_id     Id of the facet hit.
+    /// @param[out] ray_depth    Ray parameter of the hit (hit point is origin + ray_depth *
+    ///                          direction).
+    /// @param[out] barycentric  Barycentric coordinates of the hit point in the facet.
+    /// @param[in]  tmax         Maximum ray parameter to consider.
+    ///
+    /// @return     True if the ray hits the mesh, false otherwise.
+    ///
+    bool intersect_ray(
+        const Point& origin,
+        const Point& direction,
+        Index& facet_id,
+        Scalar& ray_depth,
+        Point& barycentric,
+        Scalar tmax = std::numeric_limits<Scalar>::infinity()) const;
+
+    ///
+    /// Intersects a batch of rays with the mesh. Rays are evaluated in parallel.
+    ///
+    /// @param[in]  origins             #N x 3 ray origins, stored contiguously.
+    /// @param[in]  directions          #N x 3 ray directions, stored contiguously.
+    /// @param[out] facet_ids           #N facet ids hit by each ray, or invalid<Index>() for rays
+    ///                                 that do not hit the mesh. May be empty.
+    /// @param[out] ray_depths          #N ray parameters of each hit, or infinity for rays that do
+    ///                                 not hit the mesh. May be empty.
+    /// @param[out] barycentric_coords  #N x 3 barycentric coordinates of each hit. May be empty.
+    ///
+    void batch_intersect_rays(
+        span<const Scalar> origins,
+        span<const Scalar> directions,
+        span<Index> facet_ids,
+        span<Scalar> ray_depths,
+        span<Scalar> barycentric_coords) const;
+
+protected:
+    Point get_vertex(Index f, Index lv) const;
+
+protected:
+    span<const Scalar> m_vertices;
+    span<const Index> m_facets;
+    std::vector<Node> m_nodes;
+    std::vector<Index> m_triangles;
+};
+
+} // namespace bvh
+} // namespace lagrange
@@ -0,0 +1,514 @@
+/*
+ * Copyright 2024 Adobe. All rights reserved.
+ * This file is licensed to you under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License. You may obtain a copy
+ * of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under
+ * the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR REPRESENTATIONS
+ * OF ANY KIND, either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+ */
+#include <lagrange/bvh/TriangleAABBTree.h>
+
+#include <lagrange/Attribute.h>
+#include <lagrange/SurfaceMeshTypes.h>
+#include <lagrange/utils/SmallVector.h>
+#include <lagrange/utils/assert.h>
+#include <lagrange/utils/point_triangle_squared_distance.h>
+
+// clang-format off
+#include <lagrange/utils/warnoff.h>
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/parallel_invoke.h>
+#include <lagrange/utils/warnon.h>
+// clang-format on
+
+#include <algorithm>
+#include <atomic>
+#include <numeric>
+
+namespace lagrange {
+namespace bvh {
+
+namespace {
+
+// Subtrees with fewer triangles than this are built serially.
+constexpr size_t k_parallel_build_threshold = 1024;
+
+template <typename Scalar>
+Scalar half_surface_area(const Eigen::AlignedBox<Scalar, 3>& box)
+{
+    if (box.isEmpty()) return Scalar(0);
+    auto d = box.diagonal();
+    return d[0] * d[1] + d[1] * d[2] + d[2] * d[0];
+}
+
+///
+/// Slab test between a ray and a box.
+///
+/// @return     True if the ray segment [0, tmax] intersects the box, in which case @p tnear holds
+///             the ray parameter of the entry point.
+///
+template <typename Scalar>
+bool intersect_ray_box(
+    const Eigen::AlignedBox<Scalar, 3>& box,
+    const Eigen::Matrix<Scalar, 3, 1>& origin,
+    const Eigen::Matrix<Scalar, 3, 1>& inv_direction,
+    Scalar tmax,
+    Scalar& tnear)
+{
+    Scalar t0 = 0;
+    Scalar t1 = tmax;
+    for (int i = 0; i < 3; ++i) {
+        Scalar tn = (box.min()[i] - origin[i]) * inv_direction[i];
+        Scalar tf = (box.max()[i] - origin[i]) * inv_direction[i];
+        if (tn > tf) std::swap(tn, tf);
+        // Note: the argument order ensures NaNs (0 * inf) are ignored.
+        t0 = std::max(t0, tn);
+        t1 = std::min(t1, tf);
+        if (t0 > t1) return false;
+    }
+    tnear = t0;
+    return true;
+}
+
+///
+/// Möller-Trumbore ray-triangle intersection.
+///
+template <typename Scalar>
+bool intersect_ray_triangle(
+    const Eigen::Matrix<Scalar, 3, 1>& origin,
+    const Eigen::Matrix<Scalar, 3, 1>& direction,
+    const Eigen::Matrix<Scalar, 3, 1>& v0,
+    const Eigen::Matrix<Scalar, 3, 1>& v1,
+    const Eigen::Matrix<Scalar, 3, 1>& v2,
+    Scalar tmax,
+    Scalar& t,
+    Eigen::Matrix<Scalar, 3, 1>& barycentric)
+{
+    const Eigen::Matrix<Scalar, 3, 1> e1 = v1 - v0;
+    const Eigen::Matrix<Scalar, 3, 1> e2 = v2 - v0;
+    const Eigen::Matrix<Scalar, 3, 1> pvec = direction.cross(e2);
+    const Scalar det = e1.dot(pvec);
+    if (det == 0) return false;
+    const Scalar inv_det = Scalar(1) / det;
+
+    const Eigen::Matrix<Scalar, 3, 1> tvec = origin - v0;
+    const Scalar u = tvec.dot(pvec) * inv_det;
+    if (u < 0 || u > 1) return false;
+
+    const Eigen::Matrix<Scalar, 3, 1> qvec = tvec.cross(e1);
+    const Scalar v = direction.dot(qvec) * inv_det;
+    if (v < 0 || u + v > 1) return false;
+
+    const Scalar s = e2.dot(qvec) * inv_det;
+    if (s < 0 || s > tmax) return false;
+
+    t = s;
+    barycentric << Scalar(1) - u - v, u, v;
+    return true;
+}
+
+template <typename Scalar, typename Index>
+struct TreeBuilder
+{
+    using Tree = TriangleAABBTree<Scalar, Index>;
+    using Node = typename Tree::Node;
+    using AlignedBox = typename Tree::AlignedBox;
+    using Point = typename Tree::Point;
+
+    const TriangleAABBTreeOptions& options;
+    const std::vector<AlignedBox>& boxes;
+    const std::vector<Point>& centroids;
+    std::vector<Node>& nodes;
+    std::vector<Index>& triangles;
+    std::atomic<size_t> num_nodes{1};
+
+    struct Bin
+    {
+        AlignedBox bbox;
+        size_t count = 0;
+    };
+
+    void build(size_t node_id, size_t begin, size_t end)
+    {
+        AlignedBox bbox;
+        AlignedBox centroid_box;
+        for (size_t i = begin; i < end; ++i) {
+            bbox.extend(boxes[triangles[i]]);
+            centroid_box.extend(centroids[triangles[i]]);
+        }
+
+        Node& node = nodes[node_id];
+        node.bbox = bbox;
+
+        const size_t num_triangles = end - begin;
+        if (num_triangles <= std::max<size_t>(options.max_leaf_size, 1)) {
+            node.first = static_cast<Index>(begin);
+            node.count = static_cast<Index>(num_triangles);
+            return;
+        }
+
+        size_t mid = split_sah(begin, end, centroid_box);
+        if (mid == begin || mid == end) {
+            mid = split_median(begin, end, centroid_box);
+        }
+
+        const size_t left = num_nodes.fetch_add(2);
+        node.first = static_cast<Index>(left);
+        node.count = 0;
+
+        if (num_triangles > k_parallel_build_threshold) {
+            tbb::parallel_invoke(
+                [&] { build(left, begin, mid); },
+                [&] { build(left + 1, mid, end); });
+        } else {
+            build(left, begin, mid);
+            build(left + 1, mid, end);
+        }
+    }
+
+    // Binned SAH split. Returns the partition point, or `begin` if no valid split was found.
+    size_t split_sah(size_t begin, size_t end, const AlignedBox& centroid_box)
+    {
+        const size_t num_bins = std::max<size_t>(options.num_sah_bins, 2);
+        const Point extent = centroid_box.diagonal();
+        SmallVector<Bin, 32> bins(num_bins);
+        SmallVector<Scalar, 32> right_areas(num_bins);
+
+        int best_axis = -1;
+        size_t best_bin = 0;
+        Scalar best_cost = std::numeric_limits<Scalar>::max();
+
+        for (int axis = 0; axis < 3; ++axis) {
+            if (!(extent[axis] > 0)) continue;
+            const Scalar scale = Scalar(num_bins) / extent[axis];
+            std::fill(bins.begin(), bins.end(), Bin{});
+            for (size_t i = begin; i < end; ++i) {
+                const Index t = triangles[i];
+                const size_t b = bin_index(centroids[t][axis], centroid_box.min()[axis], scale);
+                bins[b].count++;
+                bins[b].bbox.extend(boxes[t]);
+            }
+
+            // Sweep from the right to accumulate right-hand side areas.
+            AlignedBox acc;
+            for (size_t b = num_bins - 1; b > 0; --b) {
+                acc.extend(bins[b].bbox);
+                right_areas[b] = half_surface_area(acc);
+            }
+
+            // Sweep from the left and evaluate the cost of splitting after each bin.
+            acc.setEmpty();
+            size_t left_count = 0;
+            for (size_t b = 0; b + 1 < num_bins; ++b) {
+                acc.extend(bins[b].bbox);
+                left_count += bins[b].count;
+                const size_t right_count = (end - begin) - left_count;
+                if (left_count == 0 || right_count == 0) continue;
+                const Scalar cost = half_surface_area(acc) * Scalar(left_count) +
+                                    right_areas[b + 1] * Scalar(right_count);
+                if (cost < best_cost) {
+                    best_cost = cost;
+                    best_axis = axis;
+                    best_bin = b;
+                }
+            }
+        }
+
+        if (best_axis < 0) return begin;
+
+        const Scalar scale = Scalar(num_bins) / extent[best_axis];
+        const Scalar min_value = centroid_box.min()[best_axis];
+        auto it = std::partition(
+            triangles.begin() + begin,
+            triangles.begin() + end,
+            [&](Index t) {
+                return bin_index(centroids[t][best_axis], min_value, scale) <= best_bin;
+            });
+        return static_cast<size_t>(it - triangles.begin());
+    }
+
+    // Median split along the longest axis of the centroid box.
+    size_t split_median(size_t begin, size_t end, const AlignedBox& centroid_box)
+    {
+        int axis = 0;
+        centroid_box.diagonal().maxCoeff(&axis);
+        const size_t mid = begin + (end - begin) / 2;
+        std::nth_element(
+            triangles.begin() + begin,
+            triangles.begin() + mid,
+            triangles.begin() + end,
+            [&](Index a, Index b) { return centroids[a][axis] < centroids[b][axis]; });
+        return mid;
+    }
+
+    size_t bin_index(Scalar value, Scalar min_value, Scalar scale) const
+    {
+        const size_t num_bins = std::max<size_t>(options.num_sah_bins, 2);
+        const auto b = static_cast<size_t>(std::max(Scalar(0), (value - min_value) * scale));
+        return std::min(b, num_bins - 1);
+    }
+};
+
+} // namespace
+
+template <typename Scalar, typename Index>
+TriangleAABBTree<Scalar, Index>::TriangleAABBTree(
+    const SurfaceMesh<Scalar, Index>& mesh,
+    const TriangleAABBTreeOptions& options)
+{
+    la_runtime_assert(mesh.get_dimension() == 3, "TriangleAABBTree only supports 3D meshes.");
+    la_runtime_assert(mesh.is_triangle_mesh(), "TriangleAABBTree only supports triangle meshes.");
+
+    m_vertices = mesh.get_vertex_to_position().get_all();
+    m_facets = mesh.get_corner_to_vertex().get_all();
+
+    const Index num_facets = mesh.get_num_facets();
+    if (num_facets == 0) return;
+
+    std::vector<AlignedBox> boxes(num_facets);
+    std::vector<Point> centroids(num_facets);
+    tbb::parallel_for(Index(0), num_facets, [&](Index f) {
+        AlignedBox box;
+        for (Index lv = 0; lv < 3; ++lv) {
+            box.extend(get_vertex(f, lv));
+        }
+        boxes[f] = box;
+        centroids[f] = box.center();
+    });
+
+    m_triangles.resize(num_facets);
+    std::iota(m_triangles.begin(), m_triangles.end(), Index(0));
+
+    // A binary tree where each leaf holds at least one triangle has at most 2n - 1 nodes.
+    m_nodes.resize(2 * static_cast<size_t>(num_facets) - 1);
+    TreeBuilder<Scalar, Index> builder{options, boxes, centroids, m_nodes, m_triangles};
+    builder.build(0, 0, num_facets);
+    m_nodes.resize(builder.num_nodes.load());
+    m_nodes.shrink_to_fit();
+}
+
+template <typename Scalar, typename Index>
+auto TriangleAABBTree<Scalar, Index>::get_vertex(Index f, Index lv) const -> Point
+{
+    const Index v = m_facets[f * 3 + lv];
+    return Point(m_vertices[v * 3], m_vertices[v * 3 + 1], m_vertices[v * 3 + 2]);
+}
+
+template <typename Scalar, typename Index>
+bool TriangleAABBTree<Scalar, Index>::get_closest_point(
+    const Point& p,
+    Index& facet_id,
+    Point& barycentric,
+    Scalar& closest_sq_dist) const
+{
+    facet_id = invalid<Index>();
+    closest_sq_dist = std::numeric_limits<Scalar>::infinity();
+    barycentric.setConstant(invalid<Scalar>());
+    if (empty()) return false;
+
+    SmallVector<std::pair<Index, Scalar>, 64> stack;
+    stack.emplace_back(Index(0), m_nodes[0].bbox.squaredExteriorDistance(p));
+    while (!stack.empty()) {
+        const auto [node_id, node_sq_dist] = stack.back();
+        stack.pop_back();
+        if (node_sq_dist > closest_sq_dist) continue;
+
+        const Node& node = m_nodes[node_id];
+        if (node.is_leaf()) {
+            for (Index i = node.first; i < node.first + node.count; ++i) {
+                const Index f = m_triangles[i];
+                Point closest_point;
+                Scalar l0, l1, l2;
+                const Scalar sq_dist = point_triangle_squared_distance(
+                    p,
+                    get_vertex(f, 0),
+                    get_vertex(f, 1),
+                    get_vertex(f, 2),
+                    closest_point,
+                    l0,
+                    l1,
+                    l2);
+                if (sq_dist < closest_sq_dist) {
+                    closest_sq_dist = sq_dist;
+                    facet_id = f;
+                    barycentric << l0, l1, l2;
+                }
+            }
+        } else {
+            const Index left = node.first;
+            const Index right = node.first + 1;
+            const Scalar dl = m_nodes[left].bbox.squaredExteriorDistance(p);
+            const Scalar dr = m_nodes[right].bbox.squaredExteriorDistance(p);
+
+            // Push the farthest child first so that the nearest subtree is explored first.
+            if (dl < dr) {
+                if (dr <= closest_sq_dist) stack.emplace_back(right, dr);
+                if (dl <= closest_sq_dist) stack.emplace_back(left, dl);
+            } else {
+                if (dl <= closest_sq_dist) stack.emplace_back(left, dl);
+                if (dr <= closest_sq_dist) stack.emplace_back(right, dr);
+            }
+        }
+    }
+
+    return facet_id != invalid<Index>();
+}
+
+template <typename Scalar, typename Index>
+void TriangleAABBTree<Scalar, Index>::batch_closest_point(
+    span<const Scalar> query_points,
+    span<Index> facet_ids,
+    span<Scalar> barycentric_coords,
+    span<Scalar> squared_distances) const
+{
+    la_runtime_assert(query_points.size() % 3 == 0, "Query points must be 3D.");
+    const size_t num_queries = query_points.size() / 3;
+    la_runtime_assert(facet_ids.empty() || facet_ids.size() == num_queries);
+    la_runtime_assert(barycentric_coords.empty() || barycentric_coords.size() == num_queries * 3);
+    la_runtime_assert(squared_distances.empty() || squared_distances.size() == num_queries);
+
+    tbb::parallel_for(
+        tbb::blocked_range<size_t>(0, num_queries),
+        [&](const tbb::blocked_range<size_t>& r) {
+            for (size_t i = r.begin(); i != r.end(); ++i) {
+                Point p(query_points[i * 3], query_points[i * 3 + 1], query_points[i * 3 + 2]);
+                Index facet_id;
+                Point barycentric;
+                Scalar sq_dist;
+                get_closest_point(p, facet_id, barycentric, sq_dist);
+                if (!facet_ids.empty()) facet_ids[i] = facet_id;
+                if (!squared_distances.empty()) squared_distances[i] = sq_dist;
+                if (!barycentric_coords.empty()) {
+                    barycentric_coords[i * 3] = barycentric[0];
+                    barycentric_coords[i * 3 + 1] = barycentric[1];
+                    barycentric_coords[i * 3 + 2] = barycentric[2];
+                }
+            }
+        });
+}
+
+template <typename Scalar, typename Index>
+bool TriangleAABBTree<Scalar, Index>::intersect_ray(
+    const Point& origin,
+    const Point& direction,
+    Index& facet_id,
+    Scalar& ray_depth,
+    Point& barycentric,
+    Scalar tmax) const
+{
+    facet_id = invalid<Index>();
+    ray_depth = std::numeric_limits<Scalar>::infinity();
+    barycentric.setConstant(invalid<Scalar>());
+    if (empty()) return false;
+
+    const Point inv_direction = direction.cwiseInverse();
+    Scalar closest_t = tmax;
+
+    Scalar t_root;
+    if (!intersect_ray_box(m_nodes[0].bbox, origin, inv_direction, closest_t, t_root)) {
+        return false;
+    }
+
+    SmallVector<std::pair<Index, Scalar>, 64> stack;
+    stack.emplace_back(Index(0), t_root);
+    while (!stack.empty()) {
+        const auto [node_id, node_t] = stack.back();
+        stack.pop_back();
+        if (node_t > closest_t) continue;
+
+        const Node& node = m_nodes[node_id];
+        if (node.is_leaf()) {
+            for (Index i = node.first; i < node.first + node.count; ++i) {
+                const Index f = m_triangles[i];
+                Scalar t;
+                Point bc;
+                if (intersect_ray_triangle(
+                        origin,
+                        direction,
+                        get_vertex(f, 0),
+                        get_vertex(f, 1),
+                        get_vertex(f, 2),
+                        closest_t,
+                        t,
+                        bc)) {
+                    closest_t = t;
+                    facet_id = f;
+                    ray_depth = t;
+                    barycentric = bc;
+                }
+            }
+        } else {
+            const Index left = node.first;
+            const Index right = node.first + 1;
+            Scalar tl, tr;
+            const bool hit_left =
+                intersect_ray_box(m_nodes[left].bbox, origin, inv_direction, closest_t, tl);
+            const bool hit_right =
+                intersect_ray_box(m_nodes[right].bbox, origin, inv_direction, closest_t, tr);
+
+            // Push the farthest child first so that the nearest subtree is explored first.
+            if (hit_left && hit_right) {
+                if (tl < tr) {
+                    stack.emplace_back(right, tr);
+                    stack.emplace_back(left, tl);
+                } else {
+                    stack.emplace_back(left, tl);
+                    stack.emplace_back(right, tr);
+                }
+            } else if (hit_left) {
+                stack.emplace_back(left, tl);
+            } else if (hit_right) {
+                stack.emplace_back(right, tr);
+            }
+        }
+    }
+
+    return facet_id != invalid<Index>();
+}
+
+template <typename Scalar, typename Index>
+void TriangleAABBTree<Scalar, Index>::batch_intersect_rays(
+    span<const Scalar> origins,
+    span<const Scalar> directions,
+    span<Index> facet_ids,
+    span<Scalar> ray_depths,
+    span<Scalar> barycentric_coords) const
+{
+    la_runtime_assert(origins.size() % 3 == 0, "Ray origins must be 3D.");
+    la_runtime_assert(origins.size() == directions.size(), "Ray origins/directions mismatch.");
+    const size_t num_rays = origins.size() / 3;
+    la_runtime_assert(facet_ids.empty() || facet_ids.size() == num_rays);
+    la_runtime_assert(ray_depths.empty() || ray_depths.size() == num_rays);
+    la_runtime_assert(barycentric_coords.empty() || barycentric_coords.size() == num_rays * 3);
+
+    tbb::parallel_for(
+        tbb::blocked_range<size_t>(0, num_rays),
+        [&](const tbb::blocked_range<size_t>& r) {
+            for (size_t i = r.begin(); i != r.end(); ++i) {
+                Point origin(origins[i * 3], origins[i * 3 + 1], origins[i * 3 + 2]);
+                Point direction(directions[i * 3], directions[i * 3 + 1], directions[i * 3 + 2]);
+                Index facet_id;
+                Scalar ray_depth;
+                Point barycentric;
+                intersect_ray(origin, direction, facet_id, ray_depth, barycentric);
+                if (!facet_ids.empty()) facet_ids[i] = facet_id;
+                if (!ray_depths.empty()) ray_depths[i] = ray_depth;
+                if (!barycentric_coords.empty()) {
+                    barycentric_coords[i * 3] = barycentric[0];
+                    barycentric_coords[i * 3 + 1] = barycentric[1];
+                    barycentric_coords[i * 3 + 2] = barycentric[2];
+                }
+            }
+        });
+}
+
+#define LA_X_TriangleAABBTree(_, Scalar, Index) \
+    template class LA_BVH_API TriangleAABBTree<Scalar, Index>;
+LA_SURFACE_MESH_X(TriangleAABBTree, 0)
+
+} // namespace bvh
+} // namespace lagrange
@@ -0,0 +1,115 @@
+/*
+ * Copyright 2024 Adobe. All rights reserved.
+ * This file is licensed to you under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License. You may obtain a copy
+ * of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under
+ * the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR REPRESENTATIONS
+ * OF ANY KIND, either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+ */
+#include <lagrange/testing/common.h>
+#include <lagrange/testing/create_test_mesh.h>
+#include <catch2/catch_approx.hpp>
+
+#include <lagrange/SurfaceMesh.h>
+#include <lagrange/bvh/TriangleAABBTree.h>
+#include <lagrange/utils/point_triangle_squared_distance.h>
+#include <lagrange/views.h>
+
+#include <random>
+
+TEST_CASE("bvh/TriangleAABBTree", "[bvh][aabb][triangle]")
+{
+    using namespace lagrange;
+    using Scalar = double;
+    using Index = uint32_t;
+    using Point = Eigen::Matrix<Scalar, 3, 1>;
+
+    auto mesh = testing::create_test_sphere<Scalar, Index>();
+    auto vertices = vertex_view(mesh);
+    auto facets = facet_view(mesh);
+
+    bvh::TriangleAABBTreeOptions options;
+    options.max_leaf_size = 2;
+    bvh::TriangleAABBTree<Scalar, Index> tree(mesh, options);
+    REQUIRE(!tree.empty());
+    REQUIRE(tree.get_nodes().size() <= 2 * mesh.get_num_facets() - 1);
+
+    auto brute_force_sq_dist = [&](const Point& p) {
+        Scalar best = std::numeric_limits<Scalar>::infinity();
+        for (Index f = 0; f < mesh.get_num_facets(); ++f) {
+            Point v0 = vertices.row(facets(f, 0)).transpose();
+            Point v1 = vertices.row(facets(f, 1)).transpose();
+            Point v2 = vertices.row(facets(f, 2)).transpose();
+            Point closest;
+            Scalar l0, l1, l2;
+            best = std::min(
+                best,
+                point_triangle_squared_distance(p, v0, v1, v2, closest, l0, l1, l2));
+        }
+        return best;
+    };
+
+    const size_t num_queries = 200;
+    std::mt19937 gen(0);
+    std::uniform_real_distribution<Scalar> dist(-1.5, 1.5);
+    std::vector<Scalar> points(num_queries * 3);
+    for (auto& x : points) x = dist(gen);
+
+    SECTION("Closest point") {
+        std::vector<Index> facet_ids(num_queries);
+        std::vector<Scalar> barycentric(num_queries * 3);
+        std::vector<Scalar> sq_dists(num_queries);
+        tree.batch_closest_point(points, facet_ids, barycentric, sq_dists);
+
+        for (size_t i = 0; i < num_queries; ++i) {
+            Point p(points[i * 3], points[i * 3 + 1], points[i * 3 + 2]);
+            REQUIRE(facet_ids[i] < mesh.get_num_facets());
+            REQUIRE(sq_dists[i] == Catch::Approx(brute_force_sq_dist(p)).margin(1e-12));
+
+            Point closest = Point::Zero();
+            for (Index k = 0; k < 3; ++k) {
+                closest += barycentric[i * 3 + k] *
+                           vertices.row(facets(facet_ids[i], k)).transpose();
+            }
+            REQUIRE((closest - p).squaredNorm() == Catch::Approx(sq_dists[i]).margin(1e-12));
+
+            Index facet_id;
+            Point bc;
+            Scalar sq_dist;
+            REQUIRE(tree.get_closest_point(p, facet_id, bc, sq_dist));
+            REQUIRE(sq_dist == Catch::Approx(sq_dists[i]));
+        }
+    }
+
+    SECTION("Ray intersection") {
+        std::vector<Scalar> origins(num_queries * 3, 0);
+        std::vector<Index> facet_ids(num_queries);
+        std::vector<Scalar> depths(num_queries);
+        std::vector<Scalar> barycentric(num_queries * 3);
+        tree.batch_intersect_rays(origins, points, facet_ids, depths, barycentric);
+
+        for (size_t i = 0; i < num_queries; ++i) {
+            // Rays shot from the center of the sphere always hit the surface.
+            REQUIRE(facet_ids[i] < mesh.get_num_facets());
+            Point d(points[i * 3], points[i * 3 + 1], points[i * 3 + 2]);
+            Point hit = depths[i] * d;
+            Point interp = Point::Zero();
+            for (Index k = 0; k < 3; ++k) {
+                interp += barycentric[i * 3 + k] *
+                          vertices.row(facets(facet_ids[i], k)).transpose();
+            }
+            REQUIRE((hit - interp).norm() == Catch::Approx(0).margin(1e-8));
+            REQUIRE(brute_force_sq_dist(hit) == Catch::Approx(0).margin(1e-12));
+        }
+
+        // Rays pointing away from the sphere miss.
+        Index facet_id;
+        Scalar depth;
+        Point bc;
+        REQUIRE(!tree.intersect_ray(Point(3, 0, 0), Point(1, 0, 0), facet_id, depth, bc));
+        REQUIRE(facet_id == invalid<Index>());
+    }
+}
@@ -12,6 +12,7 @@
 #pragma once
 
 #include <lagrange/AttributeFwd.h>
+#include <lagrange/utils/MemoryResource.h>
 #include <lagrange/utils/SharedSpan.h>
 #include <lagrange/utils/span.h>
 
@@ -390,6 +391,24 @@ public:
     ///
     AttributeCopyPolicy get_copy_policy() const { return m_copy_policy; }
 
+    ///
+    /// Sets the memory resource used to allocate the internal buffer. Existing internal data is
+    /// moved to a buffer allocated from the new resource. External buffers are not affected, but
+    /// any internal copy created later will use the new resource. Copies of this attribute
+    /// allocate from the same resource.
+    ///
+    /// @param[in]  resource  New memory resource, or nullptr to use the global heap. The resource
+    ///                       must outlive this attribute and all its copies.
+    ///
+    void set_memory_resource(MemoryResource* resource);
+
+    ///
+    /// Gets the memory resource used to allocate the internal buffer.
+    ///
+    /// @return     The memory resource, or nullptr if the global heap is used.
+    ///
+    MemoryResource* get_memory_resource() const { return m_data.get_allocator().resource(); }
+
     ///
     /// Creates an internal copy of the attribute data. The attribute buffer must be external before
     /// calling this function. An internal copy of the buffer is created (including padding size).
@@ -669,7 +688,7 @@ protected:
 
 protected:
     /// Internal buffer storing the data (when the attribute is not external).
-    std::vector<ValueType> m_data;
+    std::vector<ValueType, ResourceAllocator<ValueType>> m_data;
 
     /// Optional aliased ptr to extend the lifetime of memory owner object of
     /// external buffer.
@@ -17,18 +17,23 @@
 #include <lagrange/utils/span.h>
 #include <lagrange/utils/value_ptr.h>
 
+#include <cstdint>
 #include <initializer_list>
 #include <string_view>
 #include <type_traits>
 
 namespace lagrange {
 
+class MemoryResource;
+
 /// @cond LA_INTERNAL_DOCS
 /// Forward declarations
 namespace internal {
 template <typename T>
 class weak_ptr;
-}
+template <typename Index>
+struct UnorientedEdge;
+} // namespace internal
 /// @endcond
 
 /// @defgroup group-surfacemesh SurfaceMesh
@@ -149,6 +154,19 @@ public:
     ///
     explicit SurfaceMesh(Index dimension = 3);
 
+    ///
+    /// Constructs an empty mesh whose attributes allocate their internal buffers from a memory
+    /// resource. This includes reserved attributes (vertex positions, facet and edge connectivity),
+    /// as well as any attribute created later on this mesh or on its copies.
+    ///
+    /// @param[in]  dimension        Vertex dimension.
+    /// @param[in]  memory_resource  Memory resource for attribute buffers, or nullptr to use the
+    ///                              global heap. It must outlive this mesh and all its copies.
+    ///
+    /// @see        MonotonicArena
+    ///
+    SurfaceMesh(Index dimension, MemoryResource* memory_resource);
+
     ///
     /// Default destructor.
     ///
@@ -655,6 +673,13 @@ public:
     ///
     [[nodiscard]] Index get_dimension() const { return m_dimension; }
 
+    ///
+    /// Retrieves the memory resource used to allocate new attribute buffers.
+    ///
+    /// @return     The memory resource, or nullptr if the global heap is used.
+    ///
+    [[nodiscard]] MemoryResource* get_memory_resource() const;
+
     ///
     /// Retrieves the number of vertex per facet in a regular mesh. If the mesh is a hybrid mesh, an
     /// exception is thrown.
@@ -823,6 +848,30 @@ public:
     ///
     [[nodiscard]] std::string_view get_attribute_name(AttributeId id) const;
 
+    ///
+    /// Retrieve the modification generation of an attribute. The generation is incremented every
+    /// time write access to the attribute is requested (e.g. via ref_attribute(), ref_position(),
+    /// or when the mesh is resized), and when a new attribute is created in the same slot. Callers
+    /// caching derived data can compare generations to detect that an input attribute may have
+    /// changed. Generations are copied along with the mesh.
+    ///
+    /// @param[in]  name  %Attribute name.
+    ///
+    /// @return     The attribute generation.
+    ///
+    [[nodiscard]] uint64_t get_attribute_generation(std::string_view name) const;
+
+    ///
+    /// Retrieve the modification generation of an attribute.
+    ///
+    /// @param[in]  id    %Attribute id.
+    ///
+    /// @return     The attribute generation.
+    ///
+    /// @see        get_attribute_generation(std::string_view) const
+    ///
+    [[nodiscard]] uint64_t get_attribute_generation(AttributeId id) const;
+
     ///
     /// Create a new attribute and return the newly created attribute id. A mesh attribute is stored
     /// as a row-major R x C matrix. The number of rows (R) is determined by the number of elements
@@ -2119,6 +2168,10 @@ public:
     /// ordering of the mesh edges is provided, it must be a valid indexing (all edges should appear
     /// in the provided array).
     ///
+    /// Edges are computed in parallel, using #C + 3 * #V indices of transient memory. Algorithms
+    /// that only need to iterate over corners around vertices can use
+    /// `compute_vertex_corner_adjacency()` instead.
+    ///
     /// @param[in]  edges  M x 2 continuous array of mapping edge -> vertices, where M is the number
     ///                    of edges in the mesh.
     ///
@@ -2647,6 +2700,16 @@ protected:
         Index num_user_edges = 0,
         GetEdgeVertices* get_user_edge_ptr = nullptr);
 
+    ///
+    /// Computes edge information for the whole mesh in parallel. Used by
+    /// update_edges_range_internal when the facet range covers all facets of the mesh.
+    ///
+    /// @param[in]  edge_to_id_user  User-provided edge ordering, sorted by endpoints. Empty if no
+    ///                              user ordering was provided.
+    ///
+    void initialize_edges_whole_mesh_internal(
+        span<const internal::UnorientedEdge<Index>> edge_to_id_user);
+
     ///
     /// Same as update_edges_range_internal, but operate on the last count facets in the mesh
     /// instead.
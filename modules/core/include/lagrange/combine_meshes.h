@@ -15,6 +15,7 @@
 #include <lagrange/utils/function_ref.h>
 #include <lagrange/utils/span.h>
 
+#include <cstddef>
 #include <initializer_list>
 
 namespace lagrange {
@@ -27,9 +28,74 @@ namespace lagrange {
 ///
 /// @{
 
+/**
+ * Sizes of the mesh resulting from combining multiple meshes.
+ */
+struct CombinedMeshSizes
+{
+    /// Number of vertices of the combined mesh.
+    size_t num_vertices = 0;
+
+    /// Number of facets of the combined mesh.
+    size_t num_facets = 0;
+
+    /// Number of corners of the combined mesh.
+    size_t num_corners = 0;
+
+    /// Total number of edges of the input meshes. Edges are only initialized in the combined mesh
+    /// when combining edge attributes.
+    size_t num_edges = 0;
+
+    /// Dimension of the combined mesh.
+    size_t dimension = 0;
+
+    /// Number of vertices per facet if all input meshes are regular with the same facet size, 0 if
+    /// the combined mesh is hybrid.
+    size_t vertex_per_facet = 0;
+};
+
+/**
+ * Computes the sizes of the mesh resulting from combine_meshes, without allocating it. This can be
+ * used to reserve downstream buffers or check that the combined mesh fits in the index type before
+ * combining large scenes.
+ *
+ * @param[in]  num_meshes  Number of meshes to combine.
+ * @param[in]  get_mesh    Retrieve the i-th mesh to combine.
+ *
+ * @tparam     Scalar      Mesh scalar type.
+ * @tparam     Index       Mesh index type.
+ *
+ * @throws     Exception if the meshes have different dimensions, or if the combined mesh size
+ *             exceeds the capacity of the index type.
+ *
+ * @return     The sizes of the combined mesh.
+ */
+template <typename Scalar, typename Index>
+CombinedMeshSizes compute_combined_mesh_sizes(
+    size_t num_meshes,
+    function_ref<const SurfaceMesh<Scalar, Index>&(size_t)> get_mesh);
+
+/**
+ * Computes the sizes of the mesh resulting from combine_meshes, without allocating it.
+ *
+ * @param[in]  meshes  Meshes to combine.
+ *
+ * @tparam     Scalar  Mesh scalar type.
+ * @tparam     Index   Mesh index type.
+ *
+ * @return     The sizes of the combined mesh.
+ *
+ * @overload
+ */
+template <typename Scalar, typename Index>
+CombinedMeshSizes compute_combined_mesh_sizes(span<const SurfaceMesh<Scalar, Index>> meshes);
+
 /**
  * Combine multiple meshes into a single mesh.
  *
+ * Element offsets of each input mesh are computed once by prefix sum, then geometry and attributes
+ * are copied in parallel, both across meshes and within large meshes.
+ *
  * @param[in]  meshes               The set of input mesh pointers.
  * @param[in]  preserve_attributes  Preserve shared attributes and map them to the output mesh.
  *
@@ -63,7 +129,9 @@ SurfaceMesh<Scalar, Index> combine_meshes(
 
 /**
  * Combine multiple meshes into a single mesh. This is the most generic version, where `get_mesh(i)`
- * provides the `i`th mesh.
+ * provides the `i`th mesh. `get_mesh` is called once per mesh, sequentially, before any parallel
+ * work starts, so it does not need to be thread-safe. The returned references must stay valid until
+ * the function returns.
  *
  * @param[in]  num_meshes           Number of meshes to combine.
  * @param[in]  get_mesh             Retrieve the i-th mesh to combine.
@@ -13,6 +13,7 @@
 #pragma once
 
 #include <lagrange/SurfaceMesh.h>
+#include <lagrange/utils/span.h>
 
 #include <Eigen/Core>
 
@@ -54,6 +55,28 @@ AttributeId compute_facet_area(
     SurfaceMesh<Scalar, Index>& mesh,
     FacetAreaOptions options = {});
 
+///
+/// Incrementally update per-facet area after the positions of some vertices have changed. Only
+/// the facets incident to the modified vertices are recomputed. The mesh connectivity must not
+/// have changed since the facet areas were last computed. If the output attribute does not exist
+/// yet, facet areas are computed for the whole mesh.
+///
+/// @param[in,out] mesh               The input mesh. Edge information is initialized if needed.
+/// @param[in]     modified_vertices  Indices of vertices whose position has changed.
+/// @param[in]     options            The options controlling the computation.
+///
+/// @tparam        Scalar             Mesh scalar type.
+/// @tparam        Index              Mesh index type.
+///
+/// @return        The attribute id of the facet area attribute.
+/// @see           `FacetAreaOptions`
+///
+template <typename Scalar, typename Index>
+AttributeId update_facet_area(
+    SurfaceMesh<Scalar, Index>& mesh,
+    span<const Index> modified_vertices,
+    FacetAreaOptions options = {});
+
 ///
 /// Compute per-facet area.
 ///
@@ -43,6 +43,8 @@ struct ComponentOptions
  *
  * This method will create a per-facet component id in an attribute named
  * `ComponentOptions::output_attribute_name`.  Each component id is in [0, num_components-1].
+ * Components are numbered by increasing smallest facet index, i.e. in the order in which they
+ * first appear in the facet list. This numbering does not depend on the number of threads.
  *
  * @param      mesh     Input mesh.
  * @param      options  Options to control component computation.
@@ -62,6 +64,8 @@ size_t compute_components(SurfaceMesh<Scalar, Index>& mesh, ComponentOptions opt
  *
  * This method will create a per-facet component id in an attribute named
  * `ComponentOptions::output_attribute_name`.  Each component id is in [0, num_components-1].
+ * Components are numbered by increasing smallest facet index, i.e. in the order in which they
+ * first appear in the facet list. This numbering does not depend on the number of threads.
  *
  * @param      mesh             Input mesh.
  * @param      blocker_elements An array of blocker element indices. The blocker element index is
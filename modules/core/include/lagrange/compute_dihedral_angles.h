@@ -16,6 +16,7 @@
 #endif
 
 #include <lagrange/SurfaceMesh.h>
+#include <lagrange/utils/span.h>
 
 namespace lagrange {
 
@@ -70,5 +71,30 @@ AttributeId compute_dihedral_angles(
     SurfaceMesh<Scalar, Index>& mesh,
     const DihedralAngleOptions& options = {});
 
+///
+/// Incrementally updates dihedral angles after the positions of some vertices have changed. Only
+/// the edges of facets incident to the modified vertices are recomputed. If a facet normal
+/// attribute is cached in the mesh, it is updated incrementally as well. The mesh connectivity must
+/// not have changed since the dihedral angles were last computed. If the output attribute does not
+/// exist yet, dihedral angles are computed for the whole mesh.
+///
+/// @tparam Scalar               Mesh scalar type
+/// @tparam Index                Mesh index type
+///
+/// @param[in] mesh              The input mesh.
+/// @param[in] modified_vertices Indices of vertices whose position has changed.
+/// @param[in] options           Options for computing dihedral angles. The
+///                              `recompute_facet_normals` option is ignored.
+///
+/// @return                      The id of the dihedral angle attribute.
+///
+/// @see DihedralAngleOptions
+///
+template <typename Scalar, typename Index>
+AttributeId update_dihedral_angles(
+    SurfaceMesh<Scalar, Index>& mesh,
+    span<const Index> modified_vertices,
+    const DihedralAngleOptions& options = {});
+
 /// @}
 } // namespace lagrange
@@ -16,8 +16,12 @@
 #endif
 
 #include <lagrange/SurfaceMesh.h>
+#include <lagrange/utils/AdjacencyList.h>
 #include <lagrange/utils/SmallVector.h>
+#include <lagrange/utils/span.h>
+
 #include <optional>
+#include <vector>
 
 namespace lagrange {
 ///
@@ -48,6 +52,21 @@ struct DijkstraDistanceOptions
 
     /// Output involved vertices
     bool output_involved_vertices = false;
+
+    /// Use the parallel delta-stepping algorithm instead of the serial priority-queue Dijkstra.
+    /// Both compute the same distances. Involved vertices are sorted by increasing distance in
+    /// both cases.
+    bool parallel = false;
+
+    /// Bucket width of the delta-stepping algorithm. If zero, the average length of the edges
+    /// incident to the seed vertices is used. Only used if `parallel` is true.
+    Scalar delta = 0;
+
+    /// Optional precomputed vertex-vertex adjacency of the mesh (see
+    /// compute_vertex_vertex_adjacency). Providing it avoids traversing the mesh connectivity for
+    /// every query, which is useful when issuing many queries on the same mesh. It must be kept
+    /// up to date with the mesh connectivity by the caller.
+    const AdjacencyList<Index>* vertex_adjacency = nullptr;
 };
 
 
@@ -67,6 +86,25 @@ std::optional<std::vector<Index>> compute_dijkstra_distance(
     SurfaceMesh<Scalar, Index>& mesh,
     const DijkstraDistanceOptions<Scalar, Index>& options = {});
 
+///
+/// Computes dijkstra distances for many independent seed facets in one call. Each query writes to
+/// its own output attribute, so output attribute names must be distinct. Queries are processed in
+/// parallel, and share a single vertex-vertex adjacency (computed once, unless provided by the
+/// queries).
+///
+/// @param mesh     Input mesh.
+/// @param queries  Options for each query.
+///
+/// @tparam     Scalar  Mesh scalar type.
+/// @tparam     Index   Mesh index type.
+///
+/// @return For each query, optionally a vector of indices of vertices involved.
+///
+template <typename Scalar, typename Index>
+std::vector<std::optional<std::vector<Index>>> compute_dijkstra_distance(
+    SurfaceMesh<Scalar, Index>& mesh,
+    span<const DijkstraDistanceOptions<Scalar, Index>> queries);
+
 
 /// @}
 } // namespace lagrange
@@ -16,6 +16,7 @@
 #endif
 
 #include <lagrange/SurfaceMesh.h>
+#include <lagrange/utils/span.h>
 #include <string_view>
 
 namespace lagrange {
@@ -50,5 +51,26 @@ AttributeId compute_edge_lengths(
     SurfaceMesh<Scalar, Index>& mesh,
     const EdgeLengthOptions& options = {});
 
+///
+/// Incrementally updates the edge lengths attribute after the positions of some vertices have
+/// changed. Only the edges incident to the modified vertices are recomputed. The mesh connectivity
+/// must not have changed since the edge lengths were last computed. If the attribute does not
+/// exist yet, edge lengths are computed for the whole mesh.
+///
+/// @tparam Scalar            Mesh scalar type
+/// @tparam Index             Mesh index type
+///
+/// @param mesh               The input mesh
+/// @param modified_vertices  Indices of vertices whose position has changed.
+/// @param options            Options for computing edge lengths.
+///
+/// @return                   Attribute ID of the computed edge lengths attribute.
+///
+template <typename Scalar, typename Index>
+AttributeId update_edge_lengths(
+    SurfaceMesh<Scalar, Index>& mesh,
+    span<const Index> modified_vertices,
+    const EdgeLengthOptions& options = {});
+
 /// @}
 } // namespace lagrange
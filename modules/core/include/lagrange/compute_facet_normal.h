@@ -13,6 +13,7 @@
 
 #include <lagrange/NormalWeightingType.h>
 #include <lagrange/SurfaceMesh.h>
+#include <lagrange/utils/span.h>
 
 #include <string_view>
 
@@ -57,6 +58,29 @@ struct FacetNormalOptions
 template <typename Scalar, typename Index>
 AttributeId compute_facet_normal(SurfaceMesh<Scalar, Index>& mesh, FacetNormalOptions options = {});
 
+/**
+ * Incrementally update facet normals after the positions of some vertices have changed. Only the
+ * facets incident to the modified vertices are recomputed. The mesh connectivity must not have
+ * changed since the facet normals were last computed. If the output attribute does not exist yet,
+ * facet normals are computed for the whole mesh.
+ *
+ * @param[in, out] mesh               The input mesh. Edge information is initialized if needed.
+ * @param[in]      modified_vertices  Indices of vertices whose position has changed.
+ * @param[in]      options            Optional arguments to control normal generation.
+ *
+ * @tparam         Scalar             Mesh scalar type.
+ * @tparam         Index              Mesh index type.
+ *
+ * @return         AttributeId  The attribute id of the facet normal attribute.
+ *
+ * @see            `FacetNormalOptions`.
+ */
+template <typename Scalar, typename Index>
+AttributeId update_facet_normal(
+    SurfaceMesh<Scalar, Index>& mesh,
+    span<const Index> modified_vertices,
+    FacetNormalOptions options = {});
+
 /// @}
 
 } // namespace lagrange
@@ -0,0 +1,125 @@
+/*
+ * Copyright 2024 Adobe. All rights reserved.
+ * This file is licensed to you under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License. You may obtain a copy
+ * of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under
+ * the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR REPRESENTATIONS
+ * OF ANY KIND, either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+ */
+#pragma once
+
+#include <lagrange/SurfaceMesh.h>
+#include <lagrange/utils/span.h>
+
+#include <memory>
+#include <string_view>
+#include <vector>
+
+namespace lagrange {
+
+/// @addtogroup group-surfacemesh-utils
+/// @{
+
+///
+/// Option struct for heat method geodesic distances.
+///
+struct HeatGeodesicOptions
+{
+    /// Diffusion time, as a multiple of the squared mean edge length. Larger values give smoother
+    /// but less accurate distances.
+    double time_step = 1.0;
+
+    /// Output attribute name for the geodesic distance.
+    std::string_view output_attribute_name = "@geodesic_distance";
+};
+
+///
+/// Geodesic distance solver based on the heat method of Crane et al. [2013].
+///
+/// The cotangent Laplacian and lumped mass matrices of the mesh are assembled and prefactored once
+/// at construction. Each query then only costs two sparse back-substitutions, and queries for
+/// independent source sets can be evaluated in parallel. The solver keeps a copy of the mesh
+/// geometry it needs, so the input mesh can be modified or destroyed afterwards.
+///
+/// The input mesh must be a triangle mesh with 2 or 3 dimensions. Boundaries use Neumann
+/// conditions. Vertices that are not connected to any source vertex get an unspecified distance.
+///
+/// @tparam Scalar  Mesh scalar type.
+/// @tparam Index   Mesh index type.
+///
+template <typename Scalar, typename Index>
+class GeodesicSolver
+{
+public:
+    ///
+    /// Builds and prefactors the heat and Poisson systems of a mesh.
+    ///
+    /// @param mesh     Input triangle mesh.
+    /// @param options  Options for the heat method. The output attribute name is ignored.
+    ///
+    GeodesicSolver(const SurfaceMesh<Scalar, Index>& mesh, const HeatGeodesicOptions& options = {});
+
+    ~GeodesicSolver();
+    GeodesicSolver(GeodesicSolver&&) noexcept;
+    GeodesicSolver& operator=(GeodesicSolver&&) noexcept;
+    GeodesicSolver(const GeodesicSolver&) = delete;
+    GeodesicSolver& operator=(const GeodesicSolver&) = delete;
+
+    ///
+    /// Gets the number of vertices of the mesh this solver was built from.
+    ///
+    /// @return The number of vertices.
+    ///
+    Index get_num_vertices() const;
+
+    ///
+    /// Computes the geodesic distance from a set of source vertices.
+    ///
+    /// @param[in]  source_vertices  Non-empty list of source vertices.
+    /// @param[out] distances        Distance of each vertex to the closest source vertex. Must have
+    ///                              one entry per vertex.
+    ///
+    void compute(span<const Index> source_vertices, span<Scalar> distances) const;
+
+    ///
+    /// Computes the geodesic distances from several independent sets of source vertices, in
+    /// parallel.
+    ///
+    /// @param[in]  source_sets  Non-empty lists of source vertices.
+    /// @param[out] distances    Distances for each source set, stored contiguously: the
+    ///                          distance of vertex `v` to source set `i` is stored at
+    ///                          `i * #V + v`. Must have `#V` entries per source set.
+    ///
+    void compute(span<const std::vector<Index>> source_sets, span<Scalar> distances) const;
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> m_impl;
+};
+
+///
+/// Computes the geodesic distance from a set of source vertices using the heat method, and stores
+/// it as a vertex attribute. When issuing many queries on the same mesh, use GeodesicSolver
+/// directly to reuse its factorization.
+///
+/// @param mesh             Input triangle mesh.
+/// @param source_vertices  Non-empty list of source vertices.
+/// @param options          Options for the heat method.
+///
+/// @tparam     Scalar  Mesh scalar type.
+/// @tparam     Index   Mesh index type.
+///
+/// @return The id of the output distance attribute.
+///
+template <typename Scalar, typename Index>
+AttributeId compute_geodesic_distance_heat(
+    SurfaceMesh<Scalar, Index>& mesh,
+    span<const Index> source_vertices,
+    const HeatGeodesicOptions& options = {});
+
+/// @}
+
+} // namespace lagrange
@@ -0,0 +1,58 @@
+/*
+ * Copyright 2024 Adobe. All rights reserved.
+ * This file is licensed to you under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License. You may obtain a copy
+ * of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under
+ * the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR REPRESENTATIONS
+ * OF ANY KIND, either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+ */
+#pragma once
+
+#include <lagrange/SurfaceMesh.h>
+
+#include <cstddef>
+
+namespace lagrange {
+
+/// @addtogroup group-surfacemesh-utils
+/// @{
+
+///
+/// Post-transform vertex cache efficiency of a mesh index buffer.
+///
+struct VertexCacheStatistics
+{
+    /// Number of vertex cache misses, i.e. number of vertex shader invocations.
+    size_t num_cache_misses = 0;
+
+    /// Average cache miss ratio: number of cache misses per facet. Lower is better, the optimum
+    /// being around 0.5 for large triangle meshes.
+    double acmr = 0;
+
+    /// Average transform to vertex ratio: number of cache misses per referenced vertex. Lower is
+    /// better, the optimum being 1.
+    double atvr = 0;
+};
+
+///
+/// Simulates a FIFO post-transform vertex cache on the facet indices of a mesh, in facet order.
+///
+/// @param[in]  mesh        Input mesh.
+/// @param[in]  cache_size  Number of entries in the simulated vertex cache.
+///
+/// @tparam     Scalar      Mesh scalar type.
+/// @tparam     Index       Mesh index type.
+///
+/// @return     The vertex cache statistics of the mesh.
+///
+template <typename Scalar, typename Index>
+VertexCacheStatistics compute_vertex_cache_statistics(
+    const SurfaceMesh<Scalar, Index>& mesh,
+    size_t cache_size = 16);
+
+/// @}
+
+} // namespace lagrange
@@ -0,0 +1,42 @@
+/*
+ * Copyright 2024 Adobe. All rights reserved.
+ * This file is licensed to you under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License. You may obtain a copy
+ * of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under
+ * the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR REPRESENTATIONS
+ * OF ANY KIND, either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+ */
+#pragma once
+
+#include <lagrange/SurfaceMesh.h>
+#include <lagrange/utils/AdjacencyList.h>
+
+namespace lagrange {
+
+/// @addtogroup group-surfacemesh-utils
+/// @{
+
+/**
+ * Compute vertex-corner adjacency information, i.e. the list of facet corners incident to each
+ * vertex, in increasing order.
+ *
+ * This is a lightweight alternative to `SurfaceMesh::initialize_edges()` for algorithms that only
+ * need to iterate over corners around vertices: no edge is computed, the input mesh is left
+ * unchanged, and the adjacency is built in parallel with #C + 2 * #V transient memory.
+ *
+ * @tparam Scalar  Mesh scalar type.
+ * @tparam Index   Mesh index type.
+ *
+ * @param mesh     The input mesh.
+ *
+ * @return         The vertex-corner adjacency list.
+ */
+template <typename Scalar, typename Index>
+AdjacencyList<Index> compute_vertex_corner_adjacency(const SurfaceMesh<Scalar, Index>& mesh);
+
+/// @}
+
+} // namespace lagrange
@@ -17,6 +17,7 @@
 
 #include <lagrange/NormalWeightingType.h>
 #include <lagrange/SurfaceMesh.h>
+#include <lagrange/utils/span.h>
 
 #include <string_view>
 
@@ -74,6 +75,30 @@ AttributeId compute_vertex_normal(
     SurfaceMesh<Scalar, Index>& mesh,
     VertexNormalOptions options = {});
 
+/**
+ * Incrementally update per-vertex normals after the positions of some vertices have changed. Only
+ * the normals of vertices sharing a facet with a modified vertex are recomputed. The mesh
+ * connectivity must not have changed since the vertex normals were last computed. If the output
+ * attribute does not exist yet, vertex normals are computed for the whole mesh.
+ *
+ * @param[in]  mesh               The input mesh. Edge information is initialized if needed.
+ * @param[in]  modified_vertices  Indices of vertices whose position has changed.
+ * @param[in]  options            Optional arguments to control normal generation. The weighted
+ *                                corner normal attribute is neither used nor updated.
+ *
+ * @tparam     Scalar             Mesh scalar type.
+ * @tparam     Index              Mesh index type.
+ *
+ * @return     The attribute id of vertex normal attribute.
+ *
+ * @see        `VertexNormalOptions`.
+ */
+template <typename Scalar, typename Index>
+AttributeId update_vertex_normal(
+    SurfaceMesh<Scalar, Index>& mesh,
+    span<const Index> modified_vertices,
+    VertexNormalOptions options = {});
+
 /// @}
 
 } // namespace lagrange
@@ -0,0 +1,106 @@
+/*
+ * Copyright 2024 Adobe. All rights reserved.
+ * This file is licensed to you under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License. You may obtain a copy
+ * of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under
+ * the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR REPRESENTATIONS
+ * OF ANY KIND, either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+ */
+#pragma once
+
+#include <lagrange/SurfaceMesh.h>
+#include <lagrange/utils/invalid.h>
+#include <lagrange/utils/span.h>
+
+#include <limits>
+#include <vector>
+
+namespace lagrange {
+
+/// @addtogroup group-surfacemesh-utils
+/// @{
+
+///
+/// Options for quadric edge-collapse decimation.
+///
+struct DecimationOptions
+{
+    /// Target number of facets. If invalid, the target is computed from `target_facet_ratio`.
+    size_t target_num_facets = invalid<size_t>();
+
+    /// Target ratio between the number of output and input facets. Only used if
+    /// `target_num_facets` is invalid.
+    double target_facet_ratio = 0.5;
+
+    /// Maximum error of a single collapse, relative to the diagonal of the input bounding box. The
+    /// error includes the weighted attribute deviation. Decimation stops before reaching the
+    /// target if no edge can be collapsed within this bound.
+    double max_error = std::numeric_limits<double>::infinity();
+
+    /// Weight of the attribute deviation in the collapse cost, relative to the geometric error.
+    double attribute_weight = 1.0;
+
+    /// Attributes whose deviation contributes to the collapse cost. Only floating-point vertex and
+    /// indexed attributes are supported. If empty, every non-reserved vertex or indexed attribute
+    /// with a UV, Normal or Color usage is used.
+    std::vector<AttributeId> attribute_ids;
+
+    /// Whether to prevent boundary vertices from being collapsed.
+    bool lock_boundary = false;
+};
+
+///
+/// Decimates a triangle mesh by collapsing edges in order of increasing quadric error.
+///
+/// Each collapse merges a vertex into one of its neighbors, so vertex attributes of the remaining
+/// vertices are left unchanged. Seams of every indexed attribute (see `compute_seam_edges`) are
+/// preserved: a vertex lying on a seam can only slide along the seam, and the indices of the
+/// corners around a collapsed vertex are remapped to the values on the same side of the seam.
+/// Collapses that would flip a facet or make the mesh non-manifold are rejected, and non-manifold
+/// vertices are never collapsed.
+///
+/// Collapses are scheduled in rounds: at each round, a set of low-cost collapses with disjoint
+/// neighborhoods is selected and applied in parallel. The result is deterministic.
+///
+/// @note       Facet and corner attributes of the remaining facets are preserved. Edge
+///             attributes are discarded, and edge information is recomputed if it was present
+///             in the input mesh.
+///
+/// @param[in,out] mesh     Triangle mesh to decimate in place.
+/// @param[in]     options  Decimation options.
+///
+/// @tparam        Scalar   Mesh scalar type.
+/// @tparam        Index    Mesh index type.
+///
+template <typename Scalar, typename Index>
+void decimate_mesh(SurfaceMesh<Scalar, Index>& mesh, const DecimationOptions& options = {});
+
+///
+/// Decimates several triangle meshes jointly. Collapses of all meshes are ordered by a common
+/// error, so that the facet budget goes where it is most needed. This is the backend of the
+/// synchronized facet allocation strategy used by scene decimation.
+///
+/// @param[in,out] meshes         Triangle meshes to decimate in place.
+/// @param[in]     options        Decimation options. The facet target applies to the total
+///                               number of facets, and `attribute_ids` (if any) must be valid for
+///                               every mesh.
+/// @param[in]     error_weights  Optional per-mesh factor applied to collapse costs before they
+///                               are compared across meshes. Must be > 0.
+/// @param[in]     min_num_facets Optional per-mesh minimum number of facets.
+///
+/// @tparam        Scalar         Mesh scalar type.
+/// @tparam        Index          Mesh index type.
+///
+template <typename Scalar, typename Index>
+void decimate_meshes(
+    span<SurfaceMesh<Scalar, Index>* const> meshes,
+    const DecimationOptions& options = {},
+    span<const double> error_weights = {},
+    span<const size_t> min_num_facets = {});
+
+/// @}
+
+} // namespace lagrange
@@ -16,6 +16,7 @@
 #endif
 
 #include <lagrange/SurfaceMesh.h>
+#include <lagrange/utils/AdjacencyList.h>
 #include <lagrange/utils/function_ref.h>
 #include <lagrange/utils/span.h>
 
@@ -47,4 +48,65 @@ void dijkstra(
     const function_ref<Scalar(Index, Index)>& dist,
     const function_ref<bool(Index, Scalar)>& process);
 
+/**
+ * Traverse a graph given by a vertex-vertex adjacency list based on Dijkstra's algorithm with
+ * customized distance metric and process functions. This overload does not need to traverse the
+ * mesh connectivity, so the same adjacency list can be reused across many calls.
+ *
+ * @tparam Scalar  Mesh scalar type
+ * @tparam Index   Mesh index type
+ *
+ * @param adjacency         Vertex-vertex adjacency list (see compute_vertex_vertex_adjacency).
+ * @param seed_vertices     Seed vertices.
+ * @param seed_vertex_dist  Initial distance to the seed vertices.
+ * @param radius            The radius of the search. Radius <= 0 denotes the search is over the
+ *                          entire graph.
+ * @param dist              The distance metric.  e.g. `d = dist(v0, v1)`
+ * @param process           Call back function to process each new vertex reached.  Its return type
+ *                          indicates whether the search is done.
+ *                          e.g. `done = process(vid, v_dist)`
+ */
+template <typename Scalar, typename Index>
+void dijkstra(
+    const AdjacencyList<Index>& adjacency,
+    span<const Index> seed_vertices,
+    span<const Scalar> seed_vertex_dist,
+    Scalar radius,
+    const function_ref<Scalar(Index, Index)>& dist,
+    const function_ref<bool(Index, Scalar)>& process);
+
+/**
+ * Compute shortest path distances over a graph given by a vertex-vertex adjacency list, using the
+ * parallel delta-stepping algorithm. Vertices are grouped into buckets of width `delta` according
+ * to their tentative distance. Buckets are settled in increasing order, and edges leaving the
+ * vertices of the current bucket are relaxed in parallel.
+ *
+ * The resulting distances are the same as the ones computed by dijkstra(), and do not depend on
+ * the number of threads.
+ *
+ * @tparam Scalar  Mesh scalar type
+ * @tparam Index   Mesh index type
+ *
+ * @param adjacency         Vertex-vertex adjacency list (see compute_vertex_vertex_adjacency).
+ * @param seed_vertices     Seed vertices.
+ * @param seed_vertex_dist  Initial distance to the seed vertices.
+ * @param radius            The radius of the search. Radius <= 0 denotes the search is over the
+ *                          entire graph.
+ * @param delta             Bucket width. Must be positive. A good choice is the average edge
+ *                          length.
+ * @param dist              The distance metric.  e.g. `d = dist(v0, v1)`. It is called
+ *                          concurrently from multiple threads.
+ * @param distances         Output distance of each vertex. Vertices that are not reached within
+ *                          the radius are set to infinity. Must have one entry per vertex.
+ */
+template <typename Scalar, typename Index>
+void delta_stepping(
+    const AdjacencyList<Index>& adjacency,
+    span<const Index> seed_vertices,
+    span<const Scalar> seed_vertex_dist,
+    Scalar radius,
+    Scalar delta,
+    const function_ref<Scalar(Index, Index)>& dist,
+    span<Scalar> distances);
+
 } // namespace lagrange::internal
@@ -0,0 +1,66 @@
+/*
+ * Copyright 2024 Adobe. All rights reserved.
+ * This file is licensed to you under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License. You may obtain a copy
+ * of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under
+ * the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR REPRESENTATIONS
+ * OF ANY KIND, either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+ */
+#pragma once
+
+#include <lagrange/SurfaceMesh.h>
+#include <lagrange/extract_submesh.h>
+#include <lagrange/utils/span.h>
+
+#include <vector>
+
+namespace lagrange::internal {
+
+///
+/// Scratch buffers reused across successive submesh extractions from the same source mesh, so that
+/// the cost of each extraction is proportional to the size of the submesh rather than to the size
+/// of the source mesh. Entries of the buffers are invalid between extractions.
+///
+/// @tparam Index  The index type.
+///
+template <typename Index>
+struct SubmeshScratch
+{
+    /// Source vertex index to submesh vertex index.
+    std::vector<Index> vertex_old2new;
+
+    /// Source value index to submesh value index, for indexed attributes.
+    std::vector<Index> value_old2new;
+};
+
+///
+/// Extract a submesh that consists of a subset of the facets of the source mesh, using
+/// caller-provided scratch buffers.
+///
+/// @tparam Scalar              The scalar type.
+/// @tparam Index               The index type.
+///
+/// @param[in]     mesh             The source mesh.
+/// @param[in]     selected_facets  The set of selected facets to extract.
+/// @param[in]     options          Extraction options.
+/// @param[in,out] scratch          Scratch buffers. Must not be shared across threads.
+/// @param[in]     compact_indexed_values
+///                                 Drop the values of indexed attributes that are not referenced
+///                                 by the submesh, and renumber their indices. Otherwise the whole
+///                                 value buffer is copied and indices are kept, as done by the
+///                                 public extract_submesh().
+///
+/// @return The mesh containing the selected facets.
+///
+template <typename Scalar, typename Index>
+SurfaceMesh<Scalar, Index> extract_submesh(
+    const SurfaceMesh<Scalar, Index>& mesh,
+    span<const Index> selected_facets,
+    const SubmeshOptions& options,
+    SubmeshScratch<Index>& scratch,
+    bool compact_indexed_values);
+
+} // namespace lagrange::internal
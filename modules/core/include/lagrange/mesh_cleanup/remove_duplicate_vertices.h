@@ -32,11 +32,22 @@ struct RemoveDuplicateVerticesOptions
 
     /// Only remove duplicate vertices on the boundary.
     bool boundary_only = false;
+
+    /// Welding tolerance. If zero, vertices are merged only if their positions and extra
+    /// attributes are exactly equal. Otherwise, two vertices are merged if their positions are
+    /// within `tolerance` (Euclidean distance), and if each channel of the extra attributes differs
+    /// by at most `tolerance`. Merges are transitive, so a chain of close vertices is merged into a
+    /// single vertex. Vertex positions must be finite when a non-zero tolerance is used.
+    double tolerance = 0;
 };
 
 ///
 /// Removes duplicate vertices from a mesh.
 ///
+/// When a non-zero tolerance is specified, nearby vertices are found with a spatial hash grid in
+/// parallel. The resulting vertex ordering only depends on the input mesh, not on the number of
+/// threads: merged vertices are numbered by increasing smallest input vertex index.
+///
 /// @tparam Scalar          Mesh scalar type
 /// @tparam Index           Mesh index type
 ///
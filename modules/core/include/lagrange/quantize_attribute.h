@@ -0,0 +1,289 @@
+/*
+ * Copyright 2024 Adobe. All rights reserved.
+ * This file is licensed to you under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License. You may obtain a copy
+ * of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under
+ * the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR REPRESENTATIONS
+ * OF ANY KIND, either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+ */
+#pragma once
+
+#include <lagrange/Attribute.h>
+#include <lagrange/IndexedAttribute.h>
+#include <lagrange/SurfaceMesh.h>
+#include <lagrange/utils/assert.h>
+#include <lagrange/utils/quantization.h>
+#include <lagrange/views.h>
+
+#include <Eigen/Core>
+
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace lagrange {
+
+///
+/// @defgroup   group-surfacemesh-quantization Attribute quantization
+/// @ingroup    group-surfacemesh
+///
+/// Store floating point attributes in compact encodings, and decode them on the fly.
+///
+/// A quantized attribute keeps its name, element type and indices, but its values are replaced by
+/// a compact integer encoding. The parameters needed to decode it (encoding, original usage and
+/// number of channels, bounding box) are stored alongside, in a value attribute named after
+/// quantization_attribute_name(). Since that attribute follows the mesh through copies and
+/// attribute remapping, quantized attributes can be decoded at any later stage:
+///
+/// @code
+/// #include <lagrange/quantize_attribute.h>
+///
+/// QuantizeAttributeOptions options;
+/// options.encoding = AttributeEncoding::Octahedral16;
+/// quantize_attribute(mesh, "normal", options);
+///
+/// // Lazily decoded Eigen expression, no buffer is allocated.
+/// auto N = decoded_matrix_view<float>(mesh, "normal");
+/// Eigen::Vector3f n0 = N.row(0).transpose();
+/// @endcode
+///
+/// @{
+
+///
+/// Compact encoding of a floating point attribute.
+///
+enum class AttributeEncoding : uint8_t {
+    Half, ///< IEEE 754 half-precision floats, stored as uint16_t bit patterns.
+    Unorm8, ///< Values in [0, 1], stored as normalized uint8_t.
+    Unorm16, ///< Values in [0, 1], stored as normalized uint16_t.
+    Snorm8, ///< Values in [-1, 1], stored as normalized int8_t.
+    Snorm16, ///< Values in [-1, 1], stored as normalized int16_t.
+    Octahedral16, ///< Unit 3D vectors, stored as two int16_t octahedral coordinates. An optional
+                  ///< 4th channel (e.g. tangent sign) is stored as a normalized int16_t.
+    Bounded16, ///< Values remapped to the attribute bounding box, stored as normalized uint16_t.
+};
+
+///
+/// Parameters needed to decode a quantized attribute.
+///
+struct AttributeQuantization
+{
+    /// Encoding of the stored values.
+    AttributeEncoding encoding = AttributeEncoding::Half;
+
+    /// Usage of the decoded attribute.
+    AttributeUsage usage = AttributeUsage::Vector;
+
+    /// Number of channels of the decoded attribute.
+    size_t num_channels = 0;
+
+    /// Per-channel offset of the decoded values. Only used by AttributeEncoding::Bounded16.
+    std::vector<double> offset;
+
+    /// Per-channel scale of the decoded values. Only used by AttributeEncoding::Bounded16.
+    std::vector<double> scale;
+};
+
+///
+/// Option struct for quantizing attributes.
+///
+struct QuantizeAttributeOptions
+{
+    /// Encoding to use.
+    AttributeEncoding encoding = AttributeEncoding::Snorm16;
+
+    /// Output attribute name. If empty, the input attribute is replaced in place.
+    std::string_view output_attribute_name = "";
+};
+
+///
+/// Gets the name of the value attribute holding the quantization parameters of an attribute.
+///
+/// @param[in]  name  Name of the quantized attribute.
+///
+/// @return     Name of the parameter attribute.
+///
+LA_CORE_API std::string quantization_attribute_name(std::string_view name);
+
+///
+/// Quantizes a floating point attribute. The input attribute can be a vertex, facet, corner, edge
+/// or indexed attribute, with `float` or `double` values. Values are clamped to the range supported
+/// by the encoding, except for AttributeEncoding::Bounded16, whose range is computed from the data.
+///
+/// The quantized attribute has the usage AttributeUsage::Vector, so that it is left untouched by
+/// algorithms expecting floating point normals or positions. Its original usage is recorded in the
+/// quantization parameters.
+///
+/// @param[in,out] mesh     Input mesh.
+/// @param[in]     name     Name of the attribute to quantize.
+/// @param[in]     options  Quantization options.
+///
+/// @tparam        Scalar   Mesh scalar type.
+/// @tparam        Index    Mesh index type.
+///
+/// @return        Id of the quantized attribute.
+///
+/// @throws        Error if the output attribute already exists, in which case the mesh is left
+///                unchanged.
+///
+template <typename Scalar, typename Index>
+AttributeId quantize_attribute(
+    SurfaceMesh<Scalar, Index>& mesh,
+    std::string_view name,
+    const QuantizeAttributeOptions& options = {});
+
+///
+/// Gets the quantization parameters of an attribute.
+///
+/// @param[in]  mesh    Input mesh.
+/// @param[in]  name    Name of the attribute.
+///
+/// @tparam     Scalar  Mesh scalar type.
+/// @tparam     Index   Mesh index type.
+///
+/// @return     Quantization parameters, or std::nullopt if the attribute is not quantized.
+///
+/// @throws     Error if the stored parameters are invalid.
+///
+template <typename Scalar, typename Index>
+std::optional<AttributeQuantization> get_attribute_quantization(
+    const SurfaceMesh<Scalar, Index>& mesh,
+    std::string_view name);
+
+///
+/// Decodes a quantized attribute back to floating point values.
+///
+/// @param[in,out] mesh                   Input mesh.
+/// @param[in]     name                   Name of the quantized attribute.
+/// @param[in]     output_attribute_name  Output attribute name. If empty, the quantized attribute
+///                                       is replaced in place.
+///
+/// @tparam        ValueType              Output value type, either `float` or `double`.
+/// @tparam        Scalar                 Mesh scalar type.
+/// @tparam        Index                  Mesh index type.
+///
+/// @return        Id of the decoded attribute.
+///
+template <typename ValueType, typename Scalar, typename Index>
+AttributeId dequantize_attribute(
+    SurfaceMesh<Scalar, Index>& mesh,
+    std::string_view name,
+    std::string_view output_attribute_name = "");
+
+namespace internal {
+
+///
+/// Eigen nullary functor decoding a quantized buffer.
+///
+/// @tparam     T     Decoded value type.
+///
+template <typename T>
+class QuantizedDecoder
+{
+public:
+    QuantizedDecoder(
+        const void* data,
+        Eigen::Index num_stored_channels,
+        const AttributeQuantization& quantization)
+        : m_encoding(quantization.encoding)
+        , m_data(data)
+        , m_num_stored_channels(num_stored_channels)
+        , m_offset(quantization.offset)
+        , m_scale(quantization.scale)
+    {}
+
+    T operator()(Eigen::Index row, Eigen::Index col) const
+    {
+        const Eigen::Index i = row * m_num_stored_channels + col;
+        switch (m_encoding) {
+        case AttributeEncoding::Half: return T(half_to_float(get<uint16_t>(i)));
+        case AttributeEncoding::Unorm8: return decode_unorm<T>(get<uint8_t>(i));
+        case AttributeEncoding::Unorm16: return decode_unorm<T>(get<uint16_t>(i));
+        case AttributeEncoding::Snorm8: return decode_snorm<T>(get<int8_t>(i));
+        case AttributeEncoding::Snorm16: return decode_snorm<T>(get<int16_t>(i));
+        case AttributeEncoding::Bounded16:
+            return T(m_offset[col] + m_scale[col] * decode_unorm<double>(get<uint16_t>(i)));
+        case AttributeEncoding::Octahedral16: {
+            const Eigen::Index j = row * m_num_stored_channels;
+            if (col == 3) return decode_snorm<T>(get<int16_t>(j + 2));
+            return decode_octahedral<T>({get<int16_t>(j), get<int16_t>(j + 1)})[col];
+        }
+        }
+        return T(0);
+    }
+
+private:
+    template <typename ValueType>
+    ValueType get(Eigen::Index i) const
+    {
+        return static_cast<const ValueType*>(m_data)[i];
+    }
+
+private:
+    AttributeEncoding m_encoding;
+    const void* m_data;
+    Eigen::Index m_num_stored_channels;
+    std::vector<double> m_offset;
+    std::vector<double> m_scale;
+};
+
+} // namespace internal
+
+/// Type alias for a lazily decoded view of a quantized attribute.
+template <typename T>
+using DecodedMatrixView = Eigen::CwiseNullaryOp<internal::QuantizedDecoder<T>, RowMatrix<T>>;
+
+///
+/// Returns a read-only view of a quantized attribute, decoding values on the fly. Each coefficient
+/// access decodes the underlying value, so the view is meant for sparse access or single pass
+/// evaluation. Use dequantize_attribute() to decode a whole attribute for repeated access. The view
+/// is invalidated if the underlying attribute is modified.
+///
+/// For indexed attributes, the view covers the attribute values.
+///
+/// @param[in]  mesh    Input mesh.
+/// @param[in]  name    Name of the quantized attribute.
+///
+/// @tparam     T       Decoded value type.
+/// @tparam     Scalar  Mesh scalar type.
+/// @tparam     Index   Mesh index type.
+///
+/// @return     Eigen expression of size num_elements x num_channels.
+///
+template <typename T, typename Scalar, typename Index>
+DecodedMatrixView<T> decoded_matrix_view(
+    const SurfaceMesh<Scalar, Index>& mesh,
+    std::string_view name)
+{
+    auto quantization = get_attribute_quantization(mesh, name);
+    la_runtime_assert(quantization.has_value(), "Attribute is not quantized");
+    auto make_view = [&](auto stored_value) {
+        using ValueType = decltype(stored_value);
+        const Attribute<ValueType>& attr =
+            mesh.is_attribute_indexed(name)
+                ? mesh.template get_indexed_attribute<ValueType>(name).values()
+                : mesh.template get_attribute<ValueType>(name);
+        return DecodedMatrixView<T>(
+            static_cast<Eigen::Index>(attr.get_num_elements()),
+            static_cast<Eigen::Index>(quantization->num_channels),
+            internal::QuantizedDecoder<T>(
+                attr.get_all().data(),
+                static_cast<Eigen::Index>(attr.get_num_channels()),
+                *quantization));
+    };
+    switch (quantization->encoding) {
+    case AttributeEncoding::Unorm8: return make_view(uint8_t());
+    case AttributeEncoding::Snorm8: return make_view(int8_t());
+    case AttributeEncoding::Snorm16:
+    case AttributeEncoding::Octahedral16: return make_view(int16_t());
+    default: return make_view(uint16_t());
+    }
+}
+
+/// @}
+
+} // namespace lagrange
@@ -16,19 +16,28 @@
 namespace lagrange {
 
 ///
-/// Mesh reordering method to apply before decimation.
+/// Mesh reordering method to apply before decimation or rendering.
+///
+/// Spatial methods (Lexicographic, Morton, Hilbert) improve CPU cache locality. GPU-oriented
+/// methods (VertexCache, Overdraw, VertexFetch) improve the post-transform vertex cache hit rate,
+/// overdraw and vertex fetch locality when the mesh is rendered as an indexed triangle list.
 ///
 enum class ReorderingMethod {
     Lexicographic, ///< Sort vertices/facets lexicographically
     Morton, ///< Spatial sort vertices/facets using Morton encoding
     Hilbert, ///< Spatial sort vertices/facets using Hilbert curve
     None, ///< Do not reorder mesh vertices/facets
+    VertexCache, ///< Tipsify facet ordering for post-transform vertex cache, then VertexFetch
+    Overdraw, ///< VertexCache, then sort facet clusters to reduce overdraw, then VertexFetch
+    VertexFetch, ///< Sort vertices by first use in the facet order, keeping facets unchanged
 };
 
 ///
-/// Mesh reordering to improve cache locality. The reordering is done in place.
+/// Mesh reordering to improve cache locality. The reordering is done in place. All vertex, facet,
+/// corner and indexed attributes are permuted accordingly.
 ///
-/// @param[in,out] mesh    Mesh to reorder in place. For now we only support triangle meshes.
+/// @param[in,out] mesh    Mesh to reorder in place. The VertexCache and Overdraw methods require a
+///                        triangle mesh.
 /// @param[in]     method  Reordering method.
 ///
 /// @tparam        Scalar  Mesh scalar type.
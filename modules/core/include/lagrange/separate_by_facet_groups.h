@@ -65,15 +65,19 @@ struct SeparateByFacetGroupsOptions
 ///
 /// Extract a set of submeshes based on facet groups.
 ///
-/// Facets with the same group index are grouped together in a single submesh.
+/// Facets with the same group index are grouped together in a single submesh. Facets are sorted by
+/// group with a parallel counting sort, then submeshes are extracted in parallel. The total cost is
+/// proportional to the size of the input mesh, regardless of the number of groups. Unlike
+/// extract_submesh(), the indexed attributes of each submesh only keep the values referenced by
+/// its facets.
 ///
 /// @tparam Scalar                  The scalar type.
 /// @tparam Index                   The index type.
 ///
 /// @param[in] mesh                 The source mesh.
 /// @param[in] num_groups           The number of face groups.
-/// @param[in] facet_group_indices  The group index of each facet. Each group index must be in the range
-///                                 of [0, num_groups - 1].
+/// @param[in] facet_group_indices  The group index of each facet. Each group index must be in the
+///                                 range of [0, num_groups - 1].
 /// @param[in] options              Extraction options.
 ///
 /// @return A list of submeshes representing each facet group.
@@ -94,8 +98,8 @@ std::vector<SurfaceMesh<Scalar, Index>> separate_by_facet_groups(
 /// @tparam Index                   The index type.
 ///
 /// @param[in] mesh                 The source mesh.
-/// @param[in] facet_group_indices  The group index of each facet. Each group index must be in the range
-///                                 of [0, max(facet_group_indices)].
+/// @param[in] facet_group_indices  The group index of each facet. Each group index must be in the
+///                                 range of [0, max(facet_group_indices)].
 /// @param[in] options              Extraction options.
 ///
 /// @return A list of submeshes representing each facet group.
@@ -129,6 +133,32 @@ std::vector<SurfaceMesh<Scalar, Index>> separate_by_facet_groups(
     function_ref<Index(Index)> get_facet_group,
     const SeparateByFacetGroupsOptions& options = {});
 
+///
+/// Create zero-copy views of the facet groups of a regular mesh whose facets are already sorted by
+/// group.
+///
+/// Each view wraps the input vertex buffer and the contiguous range of facets of its group,
+/// without copying or remapping anything. As a consequence, every view keeps all the vertices of
+/// the input mesh, including the ones not referenced by its facets, and no attribute is mapped.
+/// The input mesh must outlive the views and must not be modified while they are in use. Use
+/// `separate_by_facet_groups` to get standalone submeshes instead.
+///
+/// @tparam Scalar                  The scalar type.
+/// @tparam Index                   The index type.
+///
+/// @param[in] mesh                 The source mesh. Must be a regular mesh.
+/// @param[in] num_groups           The number of face groups.
+/// @param[in] facet_group_indices  The group index of each facet, sorted in non-decreasing order.
+///                                 Each group index must be in the range of [0, num_groups - 1].
+///
+/// @return A list of mesh views representing each facet group.
+///
+template <typename Scalar, typename Index>
+std::vector<SurfaceMesh<Scalar, Index>> view_sorted_facet_groups(
+    const SurfaceMesh<Scalar, Index>& mesh,
+    size_t num_groups,
+    span<const Index> facet_group_indices);
+
 /// @}
 
 } // namespace lagrange
@@ -0,0 +1,232 @@
+/*
+ * Copyright 2024 Adobe. All rights reserved.
+ * This file is licensed to you under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License. You may obtain a copy
+ * of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under
+ * the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR REPRESENTATIONS
+ * OF ANY KIND, either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+ */
+#pragma once
+
+#include <lagrange/api.h>
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <vector>
+
+namespace lagrange {
+
+/// @addtogroup group-utils-misc
+/// @{
+
+///
+/// Abstract interface for a memory resource, mirroring `std::pmr::memory_resource`. Attributes
+/// allocate their internal buffers from a memory resource when one is provided, and from the
+/// global heap otherwise.
+///
+class LA_CORE_API MemoryResource
+{
+public:
+    virtual ~MemoryResource() = default;
+
+    ///
+    /// Allocates a block of memory.
+    ///
+    /// @param[in]  bytes      Number of bytes to allocate.
+    /// @param[in]  alignment  Alignment of the block, must be a power of two.
+    ///
+    /// @return     Pointer to the allocated block.
+    ///
+    void* allocate(size_t bytes, size_t alignment = alignof(std::max_align_t))
+    {
+        return do_allocate(bytes, alignment);
+    }
+
+    ///
+    /// Deallocates a block of memory previously obtained from this resource.
+    ///
+    /// @param[in]  p          Pointer to the block.
+    /// @param[in]  bytes      Size of the block, as passed to allocate().
+    /// @param[in]  alignment  Alignment of the block, as passed to allocate().
+    ///
+    void deallocate(void* p, size_t bytes, size_t alignment = alignof(std::max_align_t))
+    {
+        do_deallocate(p, bytes, alignment);
+    }
+
+    ///
+    /// Checks whether memory allocated from this resource can be deallocated from another one.
+    ///
+    /// @param[in]  other  The other resource.
+    ///
+    /// @return     True if both resources are interchangeable.
+    ///
+    bool is_equal(const MemoryResource& other) const noexcept { return do_is_equal(other); }
+
+protected:
+    /// @cond LA_INTERNAL_DOCS
+    virtual void* do_allocate(size_t bytes, size_t alignment) = 0;
+    virtual void do_deallocate(void* p, size_t bytes, size_t alignment) = 0;
+    virtual bool do_is_equal(const MemoryResource& other) const noexcept { return this == &other; }
+    /// @endcond
+};
+
+///
+/// Returns a memory resource that allocates from the global heap.
+///
+/// @return     Pointer to a static instance.
+///
+LA_CORE_API MemoryResource* new_delete_resource() noexcept;
+
+///
+/// Memory resource that carves allocations out of large blocks, and only releases them all at
+/// once when the arena is released or destroyed. Deallocating a single block is a no-op. This is
+/// intended for short-lived scratch meshes (e.g. one arena per job in a batch process), where it
+/// avoids contention on the global heap between worker threads.
+///
+/// Allocations are thread-safe, so that concurrent copy-on-write of attributes sharing the same
+/// arena is allowed. Allocations bump an atomic offset in the current block, and a lock is only
+/// taken when a new block is requested from upstream. The arena must outlive every mesh and
+/// attribute allocated from it, including copies of those meshes. Releasing the arena must not
+/// happen concurrently with allocations.
+///
+class LA_CORE_API MonotonicArena final : public MemoryResource
+{
+public:
+    ///
+    /// Constructs a new arena.
+    ///
+    /// @param[in]  initial_block_size  Size of the first block requested from upstream, in bytes.
+    ///                                 Subsequent blocks grow geometrically.
+    /// @param[in]  upstream            Resource used to allocate blocks. Defaults to the global
+    ///                                 heap.
+    ///
+    explicit MonotonicArena(
+        size_t initial_block_size = 64 * 1024,
+        MemoryResource* upstream = nullptr);
+
+    ///
+    /// Destroys the arena, releasing all memory allocated from it.
+    ///
+    ~MonotonicArena() override;
+
+    MonotonicArena(const MonotonicArena&) = delete;
+    MonotonicArena& operator=(const MonotonicArena&) = delete;
+
+    ///
+    /// Releases all blocks back to the upstream resource. Every buffer allocated from this arena
+    /// becomes invalid.
+    ///
+    void release();
+
+    ///
+    /// Gets the total number of bytes handed out by this arena since construction or the last
+    /// call to release().
+    ///
+    /// @return     Number of bytes allocated.
+    ///
+    size_t get_num_bytes_allocated() const;
+
+protected:
+    /// @cond LA_INTERNAL_DOCS
+    void* do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void* p, size_t bytes, size_t alignment) override;
+    /// @endcond
+
+private:
+    struct Block
+    {
+        std::byte* data;
+        size_t size;
+        std::atomic<size_t> offset{0};
+    };
+
+    /// Tries to carve an allocation out of a block, returns nullptr if the block is full.
+    static void* try_allocate(Block& block, size_t bytes, size_t alignment);
+
+    MemoryResource* m_upstream;
+    size_t m_next_block_size;
+    std::vector<std::unique_ptr<Block>> m_blocks;
+    std::atomic<Block*> m_current{nullptr};
+    std::atomic<size_t> m_num_bytes_allocated{0};
+    std::mutex m_mutex;
+};
+
+///
+/// Standard allocator that forwards to a MemoryResource. A null resource allocates from the global
+/// heap. The resource is propagated on copy, move and swap, so that a container keeps allocating
+/// from the resource of the container it was copied from.
+///
+/// @tparam     T     Value type.
+///
+template <typename T>
+class ResourceAllocator
+{
+public:
+    using value_type = T;
+    using propagate_on_container_copy_assignment = std::true_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+    using is_always_equal = std::false_type;
+
+public:
+    ResourceAllocator() noexcept = default;
+
+    ResourceAllocator(MemoryResource* resource) noexcept
+        : m_resource(resource)
+    {}
+
+    template <typename U>
+    ResourceAllocator(const ResourceAllocator<U>& other) noexcept
+        : m_resource(other.resource())
+    {}
+
+    T* allocate(size_t n)
+    {
+        if (m_resource) {
+            return static_cast<T*>(m_resource->allocate(n * sizeof(T), alignof(T)));
+        } else {
+            return std::allocator<T>().allocate(n);
+        }
+    }
+
+    void deallocate(T* p, size_t n)
+    {
+        if (m_resource) {
+            m_resource->deallocate(p, n * sizeof(T), alignof(T));
+        } else {
+            std::allocator<T>().deallocate(p, n);
+        }
+    }
+
+    ResourceAllocator select_on_container_copy_construction() const { return *this; }
+
+    MemoryResource* resource() const noexcept { return m_resource; }
+
+    template <typename U>
+    bool operator==(const ResourceAllocator<U>& other) const noexcept
+    {
+        if (m_resource == other.resource()) return true;
+        if (m_resource == nullptr || other.resource() == nullptr) return false;
+        return m_resource->is_equal(*other.resource());
+    }
+
+    template <typename U>
+    bool operator!=(const ResourceAllocator<U>& other) const noexcept
+    {
+        return !(*this == other);
+    }
+
+private:
+    MemoryResource* m_resource = nullptr;
+};
+
+/// @}
+
+} // namespace lagrange
@@ -0,0 +1,178 @@
+/*
+ * Copyright 2024 Adobe. All rights reserved.
+ * This file is licensed to you under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License. You may obtain a copy
+ * of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under
+ * the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR REPRESENTATIONS
+ * OF ANY KIND, either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+ */
+#pragma once
+
+#include <Eigen/Core>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+namespace lagrange {
+
+/// @addtogroup group-utils-misc
+/// @{
+
+///
+/// Converts a single-precision float to the bit pattern of an IEEE 754 half-precision float, with
+/// round-to-nearest-even.
+///
+/// @param[in]  x     Value to convert.
+///
+/// @return     Half-precision bit pattern.
+///
+inline uint16_t float_to_half(float x)
+{
+    return Eigen::numext::bit_cast<uint16_t>(Eigen::half(x));
+}
+
+///
+/// Converts the bit pattern of an IEEE 754 half-precision float to a single-precision float.
+///
+/// @param[in]  bits  Half-precision bit pattern.
+///
+/// @return     Decoded value.
+///
+inline float half_to_float(uint16_t bits)
+{
+    return static_cast<float>(Eigen::numext::bit_cast<Eigen::half>(bits));
+}
+
+///
+/// Encodes a value in [0, 1] as a normalized unsigned integer. Values outside of the range are
+/// clamped.
+///
+/// @param[in]  x     Value to encode.
+///
+/// @tparam     Int   Unsigned integer type.
+///
+/// @return     Encoded value.
+///
+template <typename Int, typename T>
+Int encode_unorm(T x)
+{
+    static_assert(std::is_unsigned_v<Int>);
+    constexpr T max_value = T(std::numeric_limits<Int>::max());
+    return static_cast<Int>(std::round(std::clamp(x, T(0), T(1)) * max_value));
+}
+
+///
+/// Decodes a normalized unsigned integer to a value in [0, 1].
+///
+/// @param[in]  x     Encoded value.
+///
+/// @tparam     T     Output type.
+///
+/// @return     Decoded value.
+///
+template <typename T, typename Int>
+T decode_unorm(Int x)
+{
+    static_assert(std::is_unsigned_v<Int>);
+    return T(x) / T(std::numeric_limits<Int>::max());
+}
+
+///
+/// Encodes a value in [-1, 1] as a normalized signed integer. Values outside of the range are
+/// clamped.
+///
+/// @param[in]  x     Value to encode.
+///
+/// @tparam     Int   Signed integer type.
+///
+/// @return     Encoded value.
+///
+template <typename Int, typename T>
+Int encode_snorm(T x)
+{
+    static_assert(std::is_signed_v<Int>);
+    constexpr T max_value = T(std::numeric_limits<Int>::max());
+    return static_cast<Int>(std::round(std::clamp(x, T(-1), T(1)) * max_value));
+}
+
+///
+/// Decodes a normalized signed integer to a value in [-1, 1]. Follows the glTF convention, where
+/// both the minimum and the minimum + 1 integer values map to -1.
+///
+/// @param[in]  x     Encoded value.
+///
+/// @tparam     T     Output type.
+///
+/// @return     Decoded value.
+///
+template <typename T, typename Int>
+T decode_snorm(Int x)
+{
+    static_assert(std::is_signed_v<Int>);
+    return std::max(T(x) / T(std::numeric_limits<Int>::max()), T(-1));
+}
+
+///
+/// Encodes a unit 3D vector with an octahedral mapping, using two normalized 16-bit integers. The
+/// input vector does not need to be normalized, but must not be zero.
+///
+/// @see        "A Survey of Efficient Representations for Independent Unit Vectors", Cigolle et
+///             al., JCGT 2014.
+///
+/// @param[in]  x     First coordinate.
+/// @param[in]  y     Second coordinate.
+/// @param[in]  z     Third coordinate.
+///
+/// @return     Encoded vector.
+///
+template <typename T>
+std::array<int16_t, 2> encode_octahedral(T x, T y, T z)
+{
+    const T l1 = std::abs(x) + std::abs(y) + std::abs(z);
+    if (l1 == T(0)) {
+        return {0, 0};
+    }
+    T u = x / l1;
+    T v = y / l1;
+    if (z < T(0)) {
+        const T su = u >= T(0) ? T(1) : T(-1);
+        const T sv = v >= T(0) ? T(1) : T(-1);
+        const T w = (T(1) - std::abs(v)) * su;
+        v = (T(1) - std::abs(u)) * sv;
+        u = w;
+    }
+    return {encode_snorm<int16_t>(u), encode_snorm<int16_t>(v)};
+}
+
+///
+/// Decodes a unit 3D vector encoded with encode_octahedral().
+///
+/// @param[in]  e     Encoded vector.
+///
+/// @tparam     T     Output scalar type.
+///
+/// @return     Decoded unit vector.
+///
+template <typename T>
+std::array<T, 3> decode_octahedral(const std::array<int16_t, 2>& e)
+{
+    T x = decode_snorm<T>(e[0]);
+    T y = decode_snorm<T>(e[1]);
+    const T z = T(1) - std::abs(x) - std::abs(y);
+    const T t = std::max(-z, T(0));
+    x += x >= T(0) ? -t : t;
+    y += y >= T(0) ? -t : t;
+    const T l = std::sqrt(x * x + y * y + z * z);
+    return {x / l, y / l, z / l};
+}
+
+/// @}
+
+} // namespace lagrange
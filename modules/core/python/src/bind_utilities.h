@@ -1026,6 +1026,12 @@ argument. Each component id is in [0, num_components-1] range.
                 reorder_method = ReorderingMethod::Hilbert;
             } else if (method == "None" || method == "none") {
                 reorder_method = ReorderingMethod::None;
+            } else if (method == "VertexCache" || method == "vertex_cache") {
+                reorder_method = ReorderingMethod::VertexCache;
+            } else if (method == "Overdraw" || method == "overdraw") {
+                reorder_method = ReorderingMethod::Overdraw;
+            } else if (method == "VertexFetch" || method == "vertex_fetch") {
+                reorder_method = ReorderingMethod::VertexFetch;
             } else {
                 throw std::runtime_error(fmt::format("Invalid reordering method: {}", method));
             }
@@ -1037,9 +1043,10 @@ argument. Each component id is in [0, num_components-1] range.
         R"(Reorder a mesh in place.
 
 :param mesh: input mesh
-:param method: reordering method, options are 'Lexicographic', 'Morton', 'Hilbert', 'None' (default is 'Morton').)",
+:param method: reordering method, options are 'Lexicographic', 'Morton', 'Hilbert', 'None', 'VertexCache', 'Overdraw', 'VertexFetch' (default is 'Morton').)",
         nb::sig("def reorder_mesh(mesh: SurfaceMesh, "
-                "method: typing.Literal['Lexicographic', 'Morton', 'Hilbert', 'None']) -> None"));
+                "method: typing.Literal['Lexicographic', 'Morton', 'Hilbert', 'None', "
+                "'VertexCache', 'Overdraw', 'VertexFetch']) -> None"));
 
     m.def(
         "separate_by_facet_groups",
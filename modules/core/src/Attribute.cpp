@@ -234,6 +234,8 @@ Attribute<TargetValueType> Attribute<TargetValueType>::cast_copy(
         }
     }
 
+    target.m_data = decltype(target.m_data)(
+        ResourceAllocator<TargetValueType>(source.get_memory_resource()));
     target.m_data.reserve(std::max(source.m_data.capacity(), source.m_const_view.size()));
     std::transform(
         source.m_const_view.begin(),
@@ -384,6 +386,22 @@ void Attribute<ValueType>::shrink_to_fit()
     }
 }
 
+template <typename ValueType>
+void Attribute<ValueType>::set_memory_resource(MemoryResource* resource)
+{
+    if (get_memory_resource() == resource) return;
+    using Allocator = ResourceAllocator<ValueType>;
+    std::vector<ValueType, Allocator> data{Allocator(resource)};
+    if (!m_data.empty()) {
+        data.reserve(m_data.capacity());
+        data.assign(m_data.begin(), m_data.end());
+    }
+    m_data = std::move(data);
+    if (!is_external()) {
+        update_views();
+    }
+}
+
 template <typename ValueType>
 void Attribute<ValueType>::reserve_entries(size_t new_cap)
 {
@@ -21,12 +21,15 @@
 #include <lagrange/internal/attribute_string_utils.h>
 #include <lagrange/internal/fast_edge_sort.h>
 #include <lagrange/utils/Error.h>
+#include <lagrange/utils/MemoryResource.h>
 #include <lagrange/utils/assert.h>
 #include <lagrange/utils/copy_on_write_ptr.h>
 #include <lagrange/utils/invalid.h>
 #include <lagrange/utils/strings.h>
 #include <lagrange/utils/warning.h>
 
+#include "internal/bucket_sort.h"
+
 // clang-format off
 #include <lagrange/utils/warnoff.h>
 #include <tbb/parallel_for.h>
@@ -35,6 +38,7 @@
 // clang-format on
 
 #include <array>
+#include <atomic>
 #include <map>
 #include <string>
 
@@ -61,8 +65,9 @@ struct SurfaceMesh<Scalar, Index>::AttributeManager
         la_debug_assert(element != AttributeElement::Indexed);
         auto id = create_id(name);
         m_attributes.at(id).first = name;
-        m_attributes.at(id).second = copy_on_write_ptr<AttributeBase>(
-            internal::make_shared<Attribute<ValueType>>(element, usage, num_channels));
+        auto attr = internal::make_shared<Attribute<ValueType>>(element, usage, num_channels);
+        attr->set_memory_resource(m_memory_resource);
+        m_attributes.at(id).second = copy_on_write_ptr<AttributeBase>(std::move(attr));
         return id;
     }
 
@@ -71,8 +76,10 @@ struct SurfaceMesh<Scalar, Index>::AttributeManager
     {
         auto id = create_id(name);
         m_attributes.at(id).first = name;
-        m_attributes.at(id).second = copy_on_write_ptr<AttributeBase>(
-            internal::make_shared<IndexedAttribute<ValueType, Index>>(usage, num_channels));
+        auto attr = internal::make_shared<IndexedAttribute<ValueType, Index>>(usage, num_channels);
+        attr->values().set_memory_resource(m_memory_resource);
+        attr->indices().set_memory_resource(m_memory_resource);
+        m_attributes.at(id).second = copy_on_write_ptr<AttributeBase>(std::move(attr));
         return id;
     }
 
@@ -81,9 +88,10 @@ struct SurfaceMesh<Scalar, Index>::AttributeManager
     {
         auto id = create_id(name);
         m_attributes.at(id).first = name;
-        m_attributes.at(id).second =
-            copy_on_write_ptr<AttributeBase>(internal::make_shared<Attribute<TargetValueType>>(
-                Attribute<TargetValueType>::cast_copy(attr)));
+        auto target = Attribute<TargetValueType>::cast_copy(attr);
+        target.set_memory_resource(m_memory_resource);
+        m_attributes.at(id).second = copy_on_write_ptr<AttributeBase>(
+            internal::make_shared<Attribute<TargetValueType>>(std::move(target)));
         return id;
     }
 
@@ -207,6 +215,7 @@ struct SurfaceMesh<Scalar, Index>::AttributeManager
     {
         auto& ptr = m_attributes.at(id).second;
         la_debug_assert(ptr);
+        bump_generation(id);
         return *ptr.template static_write<Attribute<ValueType>>();
     }
 
@@ -215,6 +224,7 @@ struct SurfaceMesh<Scalar, Index>::AttributeManager
     {
         auto& ptr = m_attributes.at(id).second;
         la_debug_assert(ptr);
+        bump_generation(id);
         return *ptr.template static_write<IndexedAttribute<ValueType, Index>>();
     }
 
@@ -262,10 +272,25 @@ struct SurfaceMesh<Scalar, Index>::AttributeManager
     {
         auto& ptr = m_attributes.at(id).second;
         la_debug_assert(ptr);
+        bump_generation(id);
         return ptr._get_weak_ptr();
     }
 
+    void set_memory_resource(MemoryResource* resource) { m_memory_resource = resource; }
+
+    [[nodiscard]] MemoryResource* get_memory_resource() const { return m_memory_resource; }
+
+    [[nodiscard]] uint64_t get_generation(AttributeId id) const
+    {
+        return m_generations.at(id).value.load(std::memory_order_relaxed);
+    }
+
 protected:
+    void bump_generation(AttributeId id)
+    {
+        m_generations[id].value.fetch_add(1, std::memory_order_relaxed);
+    }
+
     AttributeId create_id(std::string_view name)
     {
         // Note: heterogenous lookup is only available in C++20!
@@ -282,7 +307,11 @@ protected:
                 // Allocate a new slot
                 it->second = static_cast<AttributeId>(m_attributes.size());
                 m_attributes.emplace_back();
+                m_generations.emplace_back();
             }
+            // Generations of reused slots keep increasing, so a recreated attribute is never
+            // mistaken for the one it replaces.
+            bump_generation(it->second);
         } else {
             la_runtime_assert(false, fmt::format("Attribute '{}' already exist!", name));
         }
@@ -314,6 +343,30 @@ protected:
 
     /// List of previously erased attribute ids.
     std::vector<AttributeId> m_free_ids;
+
+    /// Memory resource used to allocate buffers of newly created attributes (nullptr for the
+    /// global heap).
+    MemoryResource* m_memory_resource = nullptr;
+
+    /// Atomic counter that can be copied along with the attribute manager.
+    struct Generation
+    {
+        std::atomic<uint64_t> value{0};
+
+        Generation() = default;
+        Generation(const Generation& other)
+            : value(other.value.load(std::memory_order_relaxed))
+        {}
+        Generation& operator=(const Generation& other)
+        {
+            value.store(other.value.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            return *this;
+        }
+    };
+
+    /// Modification counter of each attribute slot, incremented on creation and on every write
+    /// access. Indexed by attribute id, and never reset when a slot is reused.
+    std::vector<Generation> m_generations;
 };
 
 namespace {
@@ -1416,10 +1469,17 @@ SurfaceMesh<Scalar, Index>::SurfaceMesh(BareMeshTag)
 
 template <typename Scalar, typename Index>
 SurfaceMesh<Scalar, Index>::SurfaceMesh(Index dimension)
+    : SurfaceMesh(dimension, nullptr)
+{}
+
+template <typename Scalar, typename Index>
+SurfaceMesh<Scalar, Index>::SurfaceMesh(Index dimension, MemoryResource* memory_resource)
     : m_dimension(dimension)
     , m_attributes(make_value_ptr<AttributeManager>())
 {
     la_runtime_assert(m_dimension > 0, "Vertex dimension must be > 0");
+    // Set the resource first so that reserved attributes are allocated from it as well.
+    m_attributes->set_memory_resource(memory_resource);
     m_reserved_ids.vertex_to_position() = create_attribute_internal<Scalar>(
         s_reserved_names.vertex_to_position(),
         AttributeElement::Vertex,
@@ -1432,6 +1492,25 @@ SurfaceMesh<Scalar, Index>::SurfaceMesh(Index dimension)
         1);
 }
 
+template <typename Scalar, typename Index>
+uint64_t SurfaceMesh<Scalar, Index>::get_attribute_generation(std::string_view name) const
+{
+    return get_attribute_generation(get_attribute_id(name));
+}
+
+template <typename Scalar, typename Index>
+uint64_t SurfaceMesh<Scalar, Index>::get_attribute_generation(AttributeId id) const
+{
+    la_debug_assert(id != invalid_attribute_id());
+    return m_attributes->get_generation(id);
+}
+
+template <typename Scalar, typename Index>
+MemoryResource* SurfaceMesh<Scalar, Index>::get_memory_resource() const
+{
+    return m_attributes->get_memory_resource();
+}
+
 template <typename Scalar, typename Index>
 SurfaceMesh<Scalar, Index>::~SurfaceMesh() = default;
 
@@ -1466,6 +1545,7 @@ SurfaceMesh<TargetScalar, TargetIndex> SurfaceMesh<TargetScalar, TargetIndex>::s
     const SurfaceMesh<SourceScalar, SourceIndex>& source_mesh)
 {
     SurfaceMesh<TargetScalar, TargetIndex> target_mesh(BareMeshTag{});
+    target_mesh.m_attributes->set_memory_resource(source_mesh.get_memory_resource());
     target_mesh.m_num_vertices = static_cast<TargetIndex>(source_mesh.m_num_vertices);
     target_mesh.m_num_facets = static_cast<TargetIndex>(source_mesh.m_num_facets);
     target_mesh.m_num_corners = static_cast<TargetIndex>(source_mesh.m_num_corners);
@@ -1507,6 +1587,7 @@ SurfaceMesh<TargetScalar, TargetIndex> SurfaceMesh<TargetScalar, TargetIndex>::s
     SurfaceMesh<SourceScalar, SourceIndex>&& source_mesh)
 {
     SurfaceMesh<TargetScalar, TargetIndex> target_mesh(BareMeshTag{});
+    target_mesh.m_attributes->set_memory_resource(source_mesh.get_memory_resource());
     target_mesh.m_num_vertices = static_cast<TargetIndex>(source_mesh.m_num_vertices);
     target_mesh.m_num_facets = static_cast<TargetIndex>(source_mesh.m_num_facets);
     target_mesh.m_num_corners = static_cast<TargetIndex>(source_mesh.m_num_corners);
@@ -2311,10 +2392,26 @@ void SurfaceMesh<Scalar, Index>::update_edges_range_internal(
     auto next_corner_around_edge =
         ref_attribute<Index>(m_reserved_ids.next_corner_around_edge()).ref_all();
 
+    // Sort user-defined edges (if available)
+    std::vector<UnorientedEdge> edge_to_id_user;
+    if (get_user_edge_ptr != nullptr) {
+        edge_to_id_user.reserve(num_user_edges);
+        for (Index e = 0; e < num_user_edges; ++e) {
+            auto v = (*get_user_edge_ptr)(e);
+            edge_to_id_user.emplace_back(v[0], v[1], e);
+        }
+        tbb::parallel_sort(edge_to_id_user.begin(), edge_to_id_user.end());
+    }
+
+    const bool whole_mesh = (facet_end - facet_begin == get_num_facets());
+    if (whole_mesh) {
+        initialize_edges_whole_mesh_internal(edge_to_id_user);
+        return;
+    }
+
     // Sort new unoriented edges + assign corner -> edge mapping to previously existing edges
     std::vector<UnorientedEdge> edge_to_corner;
     edge_to_corner.reserve(corner_end - corner_begin);
-    const bool whole_mesh = (facet_end - facet_begin == get_num_facets());
     for (Index f = facet_begin; f < facet_end; ++f) {
         const Index c0 = get_facet_corner_begin(f);
         const Index nv = get_facet_size(f);
@@ -2323,26 +2420,23 @@ void SurfaceMesh<Scalar, Index>::update_edges_range_internal(
             auto v2 = corner_to_vertex[c0 + ((lv + 1) % nv)];
             UnorientedEdge edge(v1, v2, c0 + lv);
             Index assigned_e = invalid<Index>();
-            if (!whole_mesh) {
-                // Check corners around v1 and v2 for existing edges with endpoints {v1, v2}
-                // This look is disabled when we are assigning edge ids for the whole mesh, since
-                // this adds a significant overhead. We should look into more efficient ways to
-                // incrementally add vertices/facets on a mesh with edge id information.
-                for (Index v : {v1, v2}) {
-                    if (assigned_e == invalid<Index>()) {
-                        foreach_edge_around_vertex_with_duplicates(v, [&](Index e) {
-                            if (assigned_e != invalid<Index>()) {
-                                return;
-                            }
-                            if (e != invalid<Index>()) {
-                                auto w = get_edge_vertices(e);
-                                UnorientedEdge other(w[0], w[1], e);
-                                if (edge.key() == other.key()) {
-                                    assigned_e = e;
-                                }
+            // Check corners around v1 and v2 for existing edges with endpoints {v1, v2}. We
+            // should look into more efficient ways to incrementally add vertices/facets on a mesh
+            // with edge id information.
+            for (Index v : {v1, v2}) {
+                if (assigned_e == invalid<Index>()) {
+                    foreach_edge_around_vertex_with_duplicates(v, [&](Index e) {
+                        if (assigned_e != invalid<Index>()) {
+                            return;
+                        }
+                        if (e != invalid<Index>()) {
+                            auto w = get_edge_vertices(e);
+                            UnorientedEdge other(w[0], w[1], e);
+                            if (edge.key() == other.key()) {
+                                assigned_e = e;
                             }
-                        });
-                    }
+                        }
+                    });
                 }
             }
             if (assigned_e != invalid<Index>()) {
@@ -2359,17 +2453,6 @@ void SurfaceMesh<Scalar, Index>::update_edges_range_internal(
     // it needs to do a copy of the whole buffer... Something to revisit later.
     tbb::parallel_sort(edge_to_corner.begin(), edge_to_corner.end());
 
-    // Sort user-defined edges (if available)
-    std::vector<UnorientedEdge> edge_to_id_user;
-    if (get_user_edge_ptr != nullptr) {
-        edge_to_id_user.reserve(num_user_edges);
-        for (Index e = 0; e < num_user_edges; ++e) {
-            auto v = (*get_user_edge_ptr)(e);
-            edge_to_id_user.emplace_back(v[0], v[1], e);
-        }
-        tbb::parallel_sort(edge_to_id_user.begin(), edge_to_id_user.end());
-    }
-
     // Assign unique edge ids
     const bool has_custom_edges = !edge_to_id_user.empty();
     const Index old_num_edges = get_num_edges();
@@ -2420,6 +2503,118 @@ void SurfaceMesh<Scalar, Index>::update_edges_range_internal(
     }
 }
 
+template <typename Scalar, typename Index>
+void SurfaceMesh<Scalar, Index>::initialize_edges_whole_mesh_internal(
+    span<const internal::UnorientedEdge<Index>> edge_to_id_user)
+{
+    // Corners are bucketed by the smallest endpoint of their outgoing edge, and each bucket is
+    // sorted and deduplicated independently. Edge ids follow the lexicographic order of their
+    // endpoints, and corners are chained in decreasing order, exactly like the incremental path.
+    // Transient memory is #C + 3 * #V indices.
+    const Index num_vertices = get_num_vertices();
+    const Index num_corners = get_num_corners();
+    const Index num_facets = get_num_facets();
+    const Index vertex_per_facet = m_vertex_per_facet;
+    auto corner_to_vertex = get_corner_to_vertex().get_all();
+    span<const Index> corner_to_facet;
+    span<const Index> facet_to_first_corner;
+    if (!is_regular()) {
+        corner_to_facet = get_attribute<Index>(m_reserved_ids.corner_to_facet()).get_all();
+        facet_to_first_corner =
+            get_attribute<Index>(m_reserved_ids.facet_to_first_corner()).get_all();
+    }
+    auto next_corner_in_facet = [&](Index c) -> Index {
+        if (corner_to_facet.empty()) {
+            return (c + 1) % vertex_per_facet == 0 ? c + 1 - vertex_per_facet : c + 1;
+        }
+        const Index f = corner_to_facet[c];
+        const Index c_end = f + 1 == num_facets ? num_corners : facet_to_first_corner[f + 1];
+        return c + 1 == c_end ? facet_to_first_corner[f] : c + 1;
+    };
+    auto get_min_vertex = [&](Index c) {
+        return std::min(corner_to_vertex[c], corner_to_vertex[next_corner_in_facet(c)]);
+    };
+    auto get_max_vertex = [&](Index c) {
+        return std::max(corner_to_vertex[c], corner_to_vertex[next_corner_in_facet(c)]);
+    };
+
+    std::vector<Index> sorted_corners(num_corners);
+    auto buckets = internal::parallel_bucket_sort(sorted_corners, num_vertices, get_min_vertex);
+    const auto& offsets = buckets.representative_offsets;
+
+    // Sort each bucket by the other edge endpoint, and count unique edges
+    std::vector<Index> edge_offsets(size_t(num_vertices) + 1, 0);
+    tbb::parallel_for(Index(0), num_vertices, [&](Index v) {
+        auto begin = sorted_corners.begin() + offsets[v];
+        auto end = sorted_corners.begin() + offsets[v + 1];
+        std::sort(begin, end, [&](Index c0, Index c1) {
+            return std::make_pair(get_max_vertex(c0), c0) < std::make_pair(get_max_vertex(c1), c1);
+        });
+        Index count = 0;
+        for (auto it = begin; it != end; ++it) {
+            if (it == begin || get_max_vertex(*it) != get_max_vertex(*std::prev(it))) ++count;
+        }
+        edge_offsets[v + 1] = count;
+    });
+    std::partial_sum(edge_offsets.begin(), edge_offsets.end(), edge_offsets.begin());
+    const Index num_edges = edge_offsets.back();
+    const bool has_custom_edges = !edge_to_id_user.empty();
+    la_runtime_assert(
+        !has_custom_edges || num_edges == Index(edge_to_id_user.size()),
+        "Incorrect number of edges in user-provided indexing!");
+
+    resize_edges_internal(num_edges);
+    auto corner_to_edge = ref_attribute<Index>(m_reserved_ids.corner_to_edge()).ref_all();
+    auto edge_to_first_corner =
+        ref_attribute<Index>(m_reserved_ids.edge_to_first_corner()).ref_all();
+    auto next_corner_around_edge =
+        ref_attribute<Index>(m_reserved_ids.next_corner_around_edge()).ref_all();
+
+    // Assign edge ids and chain corners around edges
+    tbb::parallel_for(Index(0), num_vertices, [&](Index v) {
+        Index edge_rank = edge_offsets[v];
+        const auto end = sorted_corners.begin() + offsets[v + 1];
+        for (auto it_begin = sorted_corners.begin() + offsets[v]; it_begin != end; ++edge_rank) {
+            const Index w = get_max_vertex(*it_begin);
+            auto it_end =
+                std::find_if(it_begin, end, [&](Index c) { return get_max_vertex(c) != w; });
+            Index edge_id = edge_rank;
+            if (has_custom_edges) {
+                la_runtime_assert(
+                    edge_to_id_user[edge_rank].key() == std::make_pair(v, w),
+                    "Mismatched edge vertices!");
+                edge_id = edge_to_id_user[edge_rank].id;
+            }
+            Index prev = edge_to_first_corner[edge_id];
+            for (auto it = it_begin; it != it_end; ++it) {
+                corner_to_edge[*it] = edge_id;
+                next_corner_around_edge[*it] = prev;
+                prev = *it;
+            }
+            edge_to_first_corner[edge_id] = prev;
+            it_begin = it_end;
+        }
+    });
+
+    // Chain corners around vertices
+    auto vertex_to_first_corner =
+        ref_attribute<Index>(m_reserved_ids.vertex_to_first_corner()).ref_all();
+    auto next_corner_around_vertex =
+        ref_attribute<Index>(m_reserved_ids.next_corner_around_vertex()).ref_all();
+    sorted_corners.resize(num_corners);
+    buckets = internal::parallel_bucket_sort(sorted_corners, num_vertices, [&](Index c) {
+        return corner_to_vertex[c];
+    });
+    tbb::parallel_for(Index(0), num_vertices, [&](Index v) {
+        Index prev = vertex_to_first_corner[v];
+        for (Index i = offsets[v]; i < offsets[v + 1]; ++i) {
+            next_corner_around_vertex[sorted_corners[i]] = prev;
+            prev = sorted_corners[i];
+        }
+        vertex_to_first_corner[v] = prev;
+    });
+}
+
 template <typename Scalar, typename Index>
 void SurfaceMesh<Scalar, Index>::clear_edges()
 {
@@ -17,16 +17,106 @@
 #include <lagrange/utils/assert.h>
 #include <lagrange/views.h>
 
+// clang-format off
+#include <lagrange/utils/warnoff.h>
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <lagrange/utils/warnon.h>
+// clang-format on
+
 #include <algorithm>
+#include <limits>
 
 namespace lagrange {
 
 namespace {
 
+/// Number of rows below which a block copy is not worth splitting across threads.
+constexpr Eigen::Index s_copy_grain_size = 1 << 14;
+
+///
+/// Prefix sums of the element counts of the input meshes: the elements of mesh `i` are stored in
+/// the range `[x[i], x[i + 1])` of the combined mesh.
+///
+template <typename Index>
+struct MeshOffsets
+{
+    std::vector<Index> vertices;
+    std::vector<Index> facets;
+    std::vector<Index> corners;
+    std::vector<Index> edges;
+
+    const std::vector<Index>* from_element(AttributeElement element) const
+    {
+        switch (element) {
+        case AttributeElement::Vertex: return &vertices;
+        case AttributeElement::Facet: return &facets;
+        case AttributeElement::Corner: return &corners;
+        case AttributeElement::Edge: return &edges;
+        default: return nullptr;
+        }
+    }
+
+    const std::vector<Index>* from_usage(AttributeUsage usage) const
+    {
+        switch (usage) {
+        case AttributeUsage::VertexIndex: return &vertices;
+        case AttributeUsage::FacetIndex: return &facets;
+        case AttributeUsage::CornerIndex: return &corners;
+        case AttributeUsage::EdgeIndex: return &edges;
+        default: return nullptr;
+        }
+    }
+};
+
+///
+/// Converts per-mesh counts into offsets in place, checking that the total fits in the index type.
+///
+template <typename Index>
+void counts_to_offsets(std::vector<size_t>& counts, std::vector<Index>& offsets)
+{
+    offsets.resize(counts.size() + 1);
+    size_t total = 0;
+    offsets[0] = 0;
+    for (size_t i = 0; i < counts.size(); ++i) {
+        total += counts[i];
+        la_runtime_assert(
+            total <= static_cast<size_t>(std::numeric_limits<Index>::max()),
+            "combine_meshes: combined mesh size exceeds the capacity of the index type");
+        offsets[i + 1] = static_cast<Index>(total);
+    }
+}
+
+///
+/// Copies `src` into the rows of `dst` starting at `first_row`, adding `offset` to every entry.
+/// Large blocks are split into chunks copied in parallel.
+///
+template <typename DstMap, typename SrcMap, typename ValueType>
+void copy_rows(DstMap& dst, Eigen::Index first_row, const SrcMap& src, ValueType offset)
+{
+    auto copy_range = [&](Eigen::Index begin, Eigen::Index end) {
+        if (offset == ValueType(0)) {
+            dst.middleRows(first_row + begin, end - begin) = src.middleRows(begin, end - begin);
+        } else {
+            dst.middleRows(first_row + begin, end - begin) =
+                src.middleRows(begin, end - begin).array() + offset;
+        }
+    };
+
+    const Eigen::Index num_rows = src.rows();
+    if (num_rows <= s_copy_grain_size) {
+        copy_range(0, num_rows);
+    } else {
+        tbb::parallel_for(
+            tbb::blocked_range<Eigen::Index>(0, num_rows, s_copy_grain_size),
+            [&](const tbb::blocked_range<Eigen::Index>& r) { copy_range(r.begin(), r.end()); });
+    }
+}
+
 template <typename Scalar, typename Index, typename ValueType>
 bool validate_attribute_metadata(
     size_t num_meshes,
-    function_ref<const SurfaceMesh<Scalar, Index>(size_t)> get_mesh,
+    function_ref<const SurfaceMesh<Scalar, Index>&(size_t)> get_mesh,
     std::string_view name,
     AttributeElement target_element,
     size_t target_num_channels,
@@ -61,114 +151,98 @@ bool validate_attribute_metadata(
     return true;
 }
 
-template <typename Scalar, typename Index>
-Index offset_from_usage(const SurfaceMesh<Scalar, Index>& mesh, AttributeUsage usage)
-{
-    switch (usage) {
-    case AttributeUsage::VertexIndex: return mesh.get_num_vertices();
-    case AttributeUsage::FacetIndex: return mesh.get_num_facets();
-    case AttributeUsage::CornerIndex: return mesh.get_num_corners();
-    case AttributeUsage::EdgeIndex: return mesh.get_num_edges();
-    default: return Index(0);
-    }
-};
-
 template <typename Scalar, typename Index>
 void combine_attributes(
     size_t num_meshes,
     function_ref<const SurfaceMesh<Scalar, Index>&(size_t)> get_mesh,
+    const MeshOffsets<Index>& offsets,
     SurfaceMesh<Scalar, Index>& out_mesh)
 {
     la_debug_assert(num_meshes > 0);
 
-    auto resize_value_attribute = [&](auto&& attr, auto mesh_to_attr) {
-        size_t num_elements = 0;
-        for (size_t i = 0; i < num_meshes; ++i) {
-            const auto& local_attr = mesh_to_attr(i);
-            num_elements += local_attr.get_num_elements();
-        }
-        attr.resize_elements(num_elements);
+    // Offsets of value attributes, or values of indexed attributes, depend on the attribute.
+    auto compute_value_offsets = [&](auto mesh_to_attr) {
+        std::vector<size_t> counts(num_meshes);
+        tbb::parallel_for(size_t(0), num_meshes, [&](size_t i) {
+            counts[i] = mesh_to_attr(i).get_num_elements();
+        });
+        std::vector<Index> value_offsets;
+        counts_to_offsets(counts, value_offsets);
+        return value_offsets;
     };
 
     auto combine_attribute = [&](std::string_view name, auto&& attr) {
         using AttributeType = std::decay_t<decltype(attr)>;
         using ValueType = typename AttributeType::ValueType;
 
-        AttributeUsage usage = attr.get_usage();
+        auto get_local_attr = [&](size_t i) -> decltype(auto) {
+            return get_mesh(i).template get_attribute<ValueType>(name);
+        };
 
+        std::vector<Index> value_offsets;
+        const std::vector<Index>* element_offsets = offsets.from_element(attr.get_element_type());
         if (attr.get_element_type() == Value) {
-            resize_value_attribute(attr, [&](auto i) -> decltype(auto) {
-                return get_mesh(i).template get_attribute<ValueType>(name);
-            });
+            value_offsets = compute_value_offsets(get_local_attr);
+            attr.resize_elements(value_offsets.back());
+            element_offsets = &value_offsets;
         }
+        la_debug_assert(element_offsets != nullptr);
+        const std::vector<Index>* index_offsets = offsets.from_usage(attr.get_usage());
 
         auto attr_view = matrix_ref(attr);
-        size_t element_count = 0;
-        Index offset = 0;
-        for (size_t i = 0; i < num_meshes; ++i) {
-            const auto& mesh = get_mesh(i);
-            la_debug_assert(!mesh.is_attribute_indexed(name));
-            const auto& local_attr = mesh.template get_attribute<ValueType>(name);
-            auto local_view = matrix_view(local_attr);
-            attr_view.middleRows(element_count, local_view.rows()) =
-                local_view.array() + static_cast<ValueType>(offset);
-            element_count += local_view.rows();
-            offset += offset_from_usage(mesh, usage);
-        }
+        tbb::parallel_for(size_t(0), num_meshes, [&](size_t i) {
+            la_debug_assert(!get_mesh(i).is_attribute_indexed(name));
+            const ValueType offset =
+                index_offsets ? static_cast<ValueType>((*index_offsets)[i]) : ValueType(0);
+            copy_rows(attr_view, (*element_offsets)[i], matrix_view(get_local_attr(i)), offset);
+        });
     };
 
     auto combine_indexed_attribute = [&](std::string_view name, auto&& attr) {
         using AttributeType = std::decay_t<decltype(attr)>;
         using ValueType = typename AttributeType::ValueType;
 
-        AttributeUsage usage = attr.get_usage();
         auto& value_attr = attr.values();
         auto& index_attr = attr.indices();
         la_debug_assert(index_attr.get_num_elements() == out_mesh.get_num_corners());
 
-        resize_value_attribute(value_attr, [&](auto i) -> decltype(auto) {
-            return get_mesh(i).template get_indexed_attribute<ValueType>(name).values();
-        });
+        auto get_local_attr = [&](size_t i) -> decltype(auto) {
+            return get_mesh(i).template get_indexed_attribute<ValueType>(name);
+        };
+        const auto value_offsets = compute_value_offsets(
+            [&](size_t i) -> decltype(auto) { return get_local_attr(i).values(); });
+        value_attr.resize_elements(value_offsets.back());
+        const std::vector<Index>* index_offsets = offsets.from_usage(attr.get_usage());
 
         auto value_view = matrix_ref(value_attr);
         auto index_view = matrix_ref(index_attr);
-        size_t value_count = 0;
-        size_t index_count = 0;
-        Index offset = 0;
-        for (size_t i = 0; i < num_meshes; ++i) {
-            const auto& mesh = get_mesh(i);
-            const auto& local_attr = mesh.template get_indexed_attribute<ValueType>(name);
-            auto local_value_view = matrix_view(local_attr.values());
-            auto local_index_view = matrix_view(local_attr.indices());
-            value_view.middleRows(value_count, local_value_view.rows()) =
-                local_value_view.array() + static_cast<ValueType>(offset);
-            index_view.middleRows(index_count, local_index_view.rows()) =
-                local_index_view.array() + static_cast<Index>(value_count);
-            value_count += local_value_view.rows();
-            index_count += local_index_view.rows();
-            offset += offset_from_usage(mesh, usage);
-        }
+        tbb::parallel_for(size_t(0), num_meshes, [&](size_t i) {
+            const auto& local_attr = get_local_attr(i);
+            const ValueType offset =
+                index_offsets ? static_cast<ValueType>((*index_offsets)[i]) : ValueType(0);
+            copy_rows(value_view, value_offsets[i], matrix_view(local_attr.values()), offset);
+            copy_rows(
+                index_view,
+                offsets.corners[i],
+                matrix_view(local_attr.indices()),
+                value_offsets[i]);
+        });
     };
 
     // When combining meshes with edge attributes, we cannot assume the new default edge ordering
     // will be compatible with the user-provided mesh edges. So we need to specify explicitly the
     // new edge ordering for the combined mesh.
     auto combined_edge_vertices = [&]() {
-        size_t num_edges = 0;
-        for (size_t i = 0; i < num_meshes; ++i) {
-            num_edges += get_mesh(i).get_num_edges();
-        }
-        std::vector<std::array<Index, 2>> edges;
-        edges.reserve(num_edges);
-        Index current_v = 0;
-        for (size_t i = 0; i < num_meshes; ++i) {
+        std::vector<std::array<Index, 2>> edges(offsets.edges.back());
+        tbb::parallel_for(size_t(0), num_meshes, [&](size_t i) {
             const auto& mesh = get_mesh(i);
+            const Index current_v = offsets.vertices[i];
+            const Index current_e = offsets.edges[i];
             for (Index e = 0; e < mesh.get_num_edges(); ++e) {
                 auto v = mesh.get_edge_vertices(e);
-                edges.push_back({v[0] + current_v, v[1] + current_v});
+                edges[current_e + e] = {v[0] + current_v, v[1] + current_v};
             }
-            current_v += mesh.get_num_vertices();
-        }
+        });
         return edges;
     };
 
@@ -208,84 +282,133 @@ void combine_attributes(
     });
 }
 
-} // namespace
-
+///
+/// Computes the combined mesh sizes, as well as the per-mesh element offsets if requested.
+///
 template <typename Scalar, typename Index>
-SurfaceMesh<Scalar, Index> combine_meshes(
+CombinedMeshSizes compute_offsets(
     size_t num_meshes,
     function_ref<const SurfaceMesh<Scalar, Index>&(size_t)> get_mesh,
-    bool preserve_attributes)
+    MeshOffsets<Index>* offsets)
 {
-    if (num_meshes == 0) return SurfaceMesh<Scalar, Index>{};
+    CombinedMeshSizes sizes;
+    std::vector<size_t> num_vertices(num_meshes);
+    std::vector<size_t> num_facets(num_meshes);
+    std::vector<size_t> num_corners(num_meshes);
+    std::vector<size_t> num_edges(num_meshes);
 
-    // Count combined mesh size
-    Index total_num_vertices = 0;
-    Index total_num_facets = 0;
-    Index total_num_corners = 0;
-    Index vertex_per_facet = 0;
-    Index dimension = 0;
     bool is_regular = true;
     for (size_t i = 0; i < num_meshes; ++i) {
         const auto& mesh = get_mesh(i);
-        if (dimension == 0) {
-            dimension = mesh.get_dimension();
-        } else if (mesh.get_dimension() != dimension) {
+        if (sizes.dimension == 0) {
+            sizes.dimension = mesh.get_dimension();
+        } else if (mesh.get_dimension() != sizes.dimension) {
             throw std::runtime_error("combine_meshes: Incompatible mesh dimensions");
         }
-        total_num_vertices += mesh.get_num_vertices();
-        total_num_facets += mesh.get_num_facets();
-        total_num_corners += mesh.get_num_corners();
+        num_vertices[i] = mesh.get_num_vertices();
+        num_facets[i] = mesh.get_num_facets();
+        num_corners[i] = mesh.get_num_corners();
+        num_edges[i] = mesh.has_edges() ? mesh.get_num_edges() : 0;
         if (is_regular && mesh.is_regular()) {
-            if (vertex_per_facet == 0) {
-                vertex_per_facet = mesh.get_vertex_per_facet();
-            } else if (mesh.get_vertex_per_facet() != vertex_per_facet) {
+            if (sizes.vertex_per_facet == 0) {
+                sizes.vertex_per_facet = mesh.get_vertex_per_facet();
+            } else if (mesh.get_vertex_per_facet() != sizes.vertex_per_facet) {
                 is_regular = false;
             }
         } else {
             is_regular = false;
         }
     }
-    SurfaceMesh<Scalar, Index> combined_mesh(dimension);
+    if (!is_regular) sizes.vertex_per_facet = 0;
+
+    MeshOffsets<Index> local_offsets;
+    if (offsets == nullptr) offsets = &local_offsets;
+    counts_to_offsets(num_vertices, offsets->vertices);
+    counts_to_offsets(num_facets, offsets->facets);
+    counts_to_offsets(num_corners, offsets->corners);
+    counts_to_offsets(num_edges, offsets->edges);
+
+    sizes.num_vertices = offsets->vertices.back();
+    sizes.num_facets = offsets->facets.back();
+    sizes.num_corners = offsets->corners.back();
+    sizes.num_edges = offsets->edges.back();
+    return sizes;
+}
+
+} // namespace
+
+template <typename Scalar, typename Index>
+CombinedMeshSizes compute_combined_mesh_sizes(
+    size_t num_meshes,
+    function_ref<const SurfaceMesh<Scalar, Index>&(size_t)> get_mesh)
+{
+    return compute_offsets<Scalar, Index>(num_meshes, get_mesh, nullptr);
+}
+
+template <typename Scalar, typename Index>
+CombinedMeshSizes compute_combined_mesh_sizes(span<const SurfaceMesh<Scalar, Index>> meshes)
+{
+    return compute_combined_mesh_sizes<Scalar, Index>(
+        meshes.size(),
+        [&](size_t i) -> const SurfaceMesh<Scalar, Index>& { return meshes[i]; });
+}
+
+template <typename Scalar, typename Index>
+SurfaceMesh<Scalar, Index> combine_meshes(
+    size_t num_meshes,
+    function_ref<const SurfaceMesh<Scalar, Index>&(size_t)> get_mesh_serial,
+    bool preserve_attributes)
+{
+    if (num_meshes == 0) return SurfaceMesh<Scalar, Index>{};
+
+    // The user callback is not assumed to be thread-safe: retrieve all meshes once, serially, and
+    // only access them through the collected pointers in the parallel loops below.
+    std::vector<const SurfaceMesh<Scalar, Index>*> mesh_ptrs(num_meshes);
+    for (size_t i = 0; i < num_meshes; ++i) {
+        mesh_ptrs[i] = &get_mesh_serial(i);
+    }
+    auto get_mesh = [&](size_t i) -> const SurfaceMesh<Scalar, Index>& { return *mesh_ptrs[i]; };
+
+    // Count combined mesh size and element offsets of each mesh
+    MeshOffsets<Index> offsets;
+    const CombinedMeshSizes sizes = compute_offsets<Scalar, Index>(num_meshes, get_mesh, &offsets);
+    SurfaceMesh<Scalar, Index> combined_mesh(static_cast<Index>(sizes.dimension));
 
     // Allocate combined mesh
-    combined_mesh.add_vertices(total_num_vertices);
-    if (is_regular) {
+    combined_mesh.add_vertices(static_cast<Index>(sizes.num_vertices));
+    if (sizes.vertex_per_facet != 0) {
         // Fast path for combining meshes with the same facet sizes
-        combined_mesh.add_polygons(total_num_facets, vertex_per_facet);
+        combined_mesh.add_polygons(
+            static_cast<Index>(sizes.num_facets),
+            static_cast<Index>(sizes.vertex_per_facet));
     } else {
-        // Slow path for hybrid cases
-        for (size_t i = 0; i < num_meshes; ++i) {
+        // Hybrid case: gather all facet sizes, and allocate facets at once
+        std::vector<Index> facet_sizes(sizes.num_facets);
+        tbb::parallel_for(size_t(0), num_meshes, [&](size_t i) {
             const auto& mesh = get_mesh(i);
-            combined_mesh.add_hybrid(
-                mesh.get_num_facets(),
-                [&](Index f) { return mesh.get_facet_size(f); },
-                []([[maybe_unused]] Index f, [[maybe_unused]] span<Index> t) {});
-        }
+            const Index current_f = offsets.facets[i];
+            for (Index f = 0; f < mesh.get_num_facets(); ++f) {
+                facet_sizes[current_f + f] = mesh.get_facet_size(f);
+            }
+        });
+        combined_mesh.add_hybrid(facet_sizes);
     }
 
     // Assign positions + offset vertex indices
     auto vertices = vertex_ref(combined_mesh);
     auto corners = vector_ref<Index>(combined_mesh.ref_corner_to_vertex());
-
-    Index current_v = 0;
-    Index current_c = 0;
-    for (size_t i = 0; i < num_meshes; ++i) {
+    tbb::parallel_for(size_t(0), num_meshes, [&](size_t i) {
         const auto& mesh = get_mesh(i);
-        vertices.middleRows(current_v, mesh.get_num_vertices()) = vertex_view(mesh);
-        corners.segment(current_c, mesh.get_num_corners()) =
-            vector_view<Index>(mesh.get_corner_to_vertex()).array() + current_v;
-
-        current_v += mesh.get_num_vertices();
-        current_c += mesh.get_num_corners();
-        if (is_regular) {
-            la_debug_assert(mesh.get_num_corners() == mesh.get_num_facets() * vertex_per_facet);
-        }
-    }
-    la_debug_assert(current_v == combined_mesh.get_num_vertices());
-    la_debug_assert(current_c == combined_mesh.get_num_corners());
+        copy_rows(vertices, offsets.vertices[i], vertex_view(mesh), Scalar(0));
+        copy_rows(
+            corners,
+            offsets.corners[i],
+            vector_view<Index>(mesh.get_corner_to_vertex()),
+            offsets.vertices[i]);
+    });
 
     if (preserve_attributes) {
-        combine_attributes(num_meshes, get_mesh, combined_mesh);
+        combine_attributes<Scalar, Index>(num_meshes, get_mesh, offsets, combined_mesh);
     }
 
     return combined_mesh;
@@ -325,7 +448,12 @@ SurfaceMesh<Scalar, Index> combine_meshes(
     template LA_CORE_API SurfaceMesh<Scalar, Index> combine_meshes<Scalar, Index>( \
         size_t,                                                        \
         function_ref<const SurfaceMesh<Scalar, Index>&(size_t)>,       \
-        bool);
+        bool);                                                         \
+    template LA_CORE_API CombinedMeshSizes compute_combined_mesh_sizes<Scalar, Index>( \
+        size_t,                                                        \
+        function_ref<const SurfaceMesh<Scalar, Index>&(size_t)>);      \
+    template LA_CORE_API CombinedMeshSizes compute_combined_mesh_sizes<Scalar, Index>( \
+        span<const SurfaceMesh<Scalar, Index>>);
 LA_SURFACE_MESH_X(combine_meshes, 0)
 
 } // namespace lagrange
@@ -22,6 +22,9 @@
 #include <lagrange/utils/triangle_area.h>
 #include <lagrange/views.h>
 
+#include "internal/incremental_update.h"
+#include "internal/triangle_batch.h"
+
 // clang-format off
 #include <lagrange/utils/warnoff.h>
 #include <tbb/parallel_for.h>
@@ -31,6 +34,10 @@
 
 #include <Eigen/Geometry>
 
+#include <cmath>
+#include <optional>
+#include <type_traits>
+
 namespace lagrange {
 
 namespace {
@@ -99,6 +106,7 @@ void compute_triangle_area(
     SurfaceMesh<Scalar, Index>& mesh,
     AttributeId id,
     bool use_signed_area,
+    const std::optional<span<const Index>>& facets,
     FacetPositionsArgs... args)
 {
     const auto num_facets = mesh.get_num_facets();
@@ -109,19 +117,52 @@ void compute_triangle_area(
     la_debug_assert(static_cast<Index>(attr.get_num_channels()) == 1);
     auto attr_ref = matrix_ref(attr);
 
+    if constexpr (std::is_same_v<FacetPositions, FacetPositionsView<Scalar, Index>>) {
+        // Untransformed triangles are processed in batches, with vertex positions gathered in SoA
+        // form. 2D positions get a zero z coordinate, so that the z component of the cross product
+        // holds twice the signed area.
+        if (dim == 2 || dim == 3) {
+            const Scalar* positions = mesh.get_vertex_to_position().get_all().data();
+            const Index* corner_to_vertex = mesh.get_corner_to_vertex().get_all().data();
+            internal::par_foreach_batch(
+                num_facets,
+                facets,
+                [&](const auto& ids, Eigen::Index count) {
+                    internal::PointBatch<Scalar> p[3];
+                    for (Index k = 0; k < 3; ++k) {
+                        p[k] = internal::gather_points(positions, dim, count, [&](Eigen::Index i) {
+                            return corner_to_vertex[static_cast<size_t>(ids[i]) * 3 + k];
+                        });
+                    }
+                    const auto n = internal::cross(p[1] - p[0], p[2] - p[0]);
+                    internal::BatchLanes<Scalar> area;
+                    if (dim == 3) {
+                        area = Scalar(0.5) * internal::norm(n);
+                    } else {
+                        area = Scalar(0.5) * n.z;
+                        if (!use_signed_area) area = area.abs();
+                    }
+                    for (Eigen::Index i = 0; i < count; ++i) {
+                        attr_ref(ids[i]) = area[i];
+                    }
+                });
+            return;
+        }
+    }
+
     if (dim == 3) {
         using S = span<const Scalar, 3>;
-        tbb::parallel_for(Index(0), num_facets, [&](Index fid) {
+        internal::par_foreach_selected(num_facets, facets, [&](Index fid) {
             FacetPositions p(mesh, fid, std::forward<FacetPositionsArgs>(args)...);
             attr_ref(fid) = triangle_area_3d<Scalar>(S(p(0)), S(p(1)), S(p(2)));
         });
     } else if (dim == 2) {
         using S = span<const Scalar, 2>;
-        tbb::parallel_for(Index(0), num_facets, [&](Index fid) {
+        internal::par_foreach_selected(num_facets, facets, [&](Index fid) {
             FacetPositions p(mesh, fid, std::forward<FacetPositionsArgs>(args)...);
             attr_ref(fid) = triangle_area_2d<Scalar>(S(p(0)), S(p(1)), S(p(2)));
+            if (!use_signed_area) attr_ref(fid) = std::abs(attr_ref(fid));
         });
-        if (!use_signed_area) attr_ref = attr_ref.array().abs();
     } else {
         // High dimensional triangle area can be computed from the edge lengths.
         // This is not implemented due to limited use cases.
@@ -134,6 +175,7 @@ void compute_quad_area(
     SurfaceMesh<Scalar, Index>& mesh,
     AttributeId id,
     bool use_signed_area,
+    const std::optional<span<const Index>>& facets,
     FacetPositionsArgs... args)
 {
     const auto num_facets = mesh.get_num_facets();
@@ -146,17 +188,17 @@ void compute_quad_area(
 
     if (dim == 3) {
         using S = span<const Scalar, 3>;
-        tbb::parallel_for(Index(0), num_facets, [&](Index fid) {
+        internal::par_foreach_selected(num_facets, facets, [&](Index fid) {
             FacetPositions p(mesh, fid, std::forward<FacetPositionsArgs>(args)...);
             attr_ref(fid) = quad_area_3d<Scalar>(S(p(0)), S(p(1)), S(p(2)), S(p(3)));
         });
     } else if (dim == 2) {
         using S = span<const Scalar, 2>;
-        tbb::parallel_for(Index(0), num_facets, [&](Index fid) {
+        internal::par_foreach_selected(num_facets, facets, [&](Index fid) {
             FacetPositions p(mesh, fid, std::forward<FacetPositionsArgs>(args)...);
             attr_ref(fid) = quad_area_2d<Scalar>(S(p(0)), S(p(1)), S(p(2)), S(p(3)));
+            if (!use_signed_area) attr_ref(fid) = std::abs(attr_ref(fid));
         });
-        if (!use_signed_area) attr_ref = attr_ref.array().abs();
     } else {
         // This is not implemented due to limited use cases.
         throw Error("High dimensional quad area computation is not implemented!");
@@ -168,6 +210,7 @@ void compute_polygon_area(
     SurfaceMesh<Scalar, Index>& mesh,
     AttributeId id,
     bool use_signed_area,
+    const std::optional<span<const Index>>& facets,
     FacetPositionsArgs... args)
 {
     const auto num_facets = mesh.get_num_facets();
@@ -180,7 +223,7 @@ void compute_polygon_area(
 
     if (dim == 3) {
         using S = span<const Scalar, 3>;
-        tbb::parallel_for(Index(0), num_facets, [&](Index fid) {
+        internal::par_foreach_selected(num_facets, facets, [&](Index fid) {
             FacetPositions p(mesh, fid, std::forward<FacetPositionsArgs>(args)...);
             const auto n = static_cast<Index>(mesh.get_facet_size(fid));
             Scalar _center[3]{0, 0, 0};
@@ -203,7 +246,7 @@ void compute_polygon_area(
         });
     } else if (dim == 2) {
         using S = span<const Scalar, 2>;
-        tbb::parallel_for(Index(0), num_facets, [&](Index fid) {
+        internal::par_foreach_selected(num_facets, facets, [&](Index fid) {
             FacetPositions p(mesh, fid, std::forward<FacetPositionsArgs>(args)...);
             const auto n = static_cast<Index>(mesh.get_facet_size(fid));
             // 2D triangle area is signed, so no need of computing polygon center.
@@ -215,8 +258,8 @@ void compute_polygon_area(
                 Index curr = i;
                 attr_ref(fid) += triangle_area_2d<Scalar>(S(p(prev)), S(p(curr)), S(O));
             }
+            if (!use_signed_area) attr_ref(fid) = std::abs(attr_ref(fid));
         });
-        if (!use_signed_area) attr_ref = attr_ref.array().abs();
     } else {
         // This is not implemented due to limited use cases.
         throw Error("High dimensional area computation is not implemented!");
@@ -227,6 +270,7 @@ template <typename Scalar, typename Index, typename FacetPositions, typename...
 AttributeId compute_facet_area_impl(
     SurfaceMesh<Scalar, Index>& mesh,
     FacetAreaOptions options,
+    const std::optional<span<const Index>>& facets,
     FacetPositionsArgs... args)
 {
     AttributeId id = internal::find_or_create_attribute<Scalar>(
@@ -243,6 +287,7 @@ AttributeId compute_facet_area_impl(
             mesh,
             id,
             options.use_signed_area,
+            facets,
             vertex_positions,
             std::forward<FacetPositionsArgs>(args)...);
     } else if (mesh.is_quad_mesh()) {
@@ -250,6 +295,7 @@ AttributeId compute_facet_area_impl(
             mesh,
             id,
             options.use_signed_area,
+            facets,
             vertex_positions,
             std::forward<FacetPositionsArgs>(args)...);
     } else {
@@ -257,6 +303,7 @@ AttributeId compute_facet_area_impl(
             mesh,
             id,
             options.use_signed_area,
+            facets,
             vertex_positions,
             std::forward<FacetPositionsArgs>(args)...);
     }
@@ -276,6 +323,7 @@ Scalar compute_mesh_area_impl(
         area_id = compute_facet_area_impl<Scalar, Index, FacetPositions>(
             mesh,
             fa_options,
+            std::nullopt,
             std::forward<FacetPositionsArgs>(args)...);
     } else {
         area_id = mesh.get_attribute_id(options.input_attribute_name);
@@ -303,7 +351,27 @@ Scalar compute_mesh_area_impl(
 template <typename Scalar, typename Index>
 AttributeId compute_facet_area(SurfaceMesh<Scalar, Index>& mesh, FacetAreaOptions options)
 {
-    return compute_facet_area_impl<Scalar, Index, FacetPositionsView<Scalar, Index>>(mesh, options);
+    return compute_facet_area_impl<Scalar, Index, FacetPositionsView<Scalar, Index>>(
+        mesh,
+        options,
+        std::nullopt);
+}
+
+template <typename Scalar, typename Index>
+AttributeId update_facet_area(
+    SurfaceMesh<Scalar, Index>& mesh,
+    span<const Index> modified_vertices,
+    FacetAreaOptions options)
+{
+    if (!mesh.has_attribute(options.output_attribute_name)) {
+        return compute_facet_area(mesh, options);
+    }
+    mesh.initialize_edges();
+    const auto facets = internal::collect_facets_around_vertices(mesh, modified_vertices);
+    return compute_facet_area_impl<Scalar, Index, FacetPositionsView<Scalar, Index>>(
+        mesh,
+        options,
+        span<const Index>(facets));
 }
 
 template <typename Scalar, typename Index, int Dimension>
@@ -315,7 +383,11 @@ AttributeId compute_facet_area(
     return compute_facet_area_impl<
         Scalar,
         Index,
-        FacetPositionsTransformed<Scalar, Index, Dimension>>(mesh, options, transformation);
+        FacetPositionsTransformed<Scalar, Index, Dimension>>(
+        mesh,
+        options,
+        std::nullopt,
+        transformation);
 }
 
 template <typename Scalar, typename Index>
@@ -344,6 +416,10 @@ Scalar compute_mesh_area(
     template LA_CORE_API AttributeId compute_facet_area<Scalar, Index>( \
         SurfaceMesh<Scalar, Index>&,                        \
         FacetAreaOptions);                                  \
+    template LA_CORE_API AttributeId update_facet_area<Scalar, Index>( \
+        SurfaceMesh<Scalar, Index>&,                        \
+        span<const Index>,                                  \
+        FacetAreaOptions);                                  \
     template LA_CORE_API Scalar compute_mesh_area<Scalar, Index>(       \
         const SurfaceMesh<Scalar, Index>&,                  \
         MeshAreaOptions);
@@ -12,11 +12,16 @@
 #include <lagrange/Attribute.h>
 #include <lagrange/SurfaceMeshTypes.h>
 #include <lagrange/compute_components.h>
-#include <lagrange/utils/DisjointSets.h>
+#include <lagrange/utils/ConcurrentDisjointSets.h>
 #include <lagrange/utils/Error.h>
 #include <lagrange/utils/assert.h>
 #include <lagrange/utils/invalid.h>
-#include <lagrange/utils/range.h>
+
+// clang-format off
+#include <lagrange/utils/warnoff.h>
+#include <tbb/parallel_for.h>
+#include <lagrange/utils/warnon.h>
+// clang-format on
 
 #include <algorithm>
 #include <numeric>
@@ -41,9 +46,11 @@ size_t compute_vertex_based_components(
         is_blocked[vi] = true;
     });
 
-    DisjointSets<Index> components(num_facets);
-    for (auto vi : range(num_vertices)) {
-        if (is_blocked[vi]) continue;
+    // Facets are merged concurrently. Since set roots are always the smallest facet index, the
+    // resulting component ids do not depend on the scheduling.
+    ConcurrentDisjointSets<Index> components(num_facets);
+    tbb::parallel_for(Index(0), num_vertices, [&](Index vi) {
+        if (is_blocked[vi]) return;
         Index rep_facet_id = invalid_index;
         for (Index ci = mesh.get_first_corner_around_vertex(vi); ci != invalid_index;
              ci = mesh.get_next_corner_around_vertex(ci)) {
@@ -54,7 +61,7 @@ size_t compute_vertex_based_components(
                 components.merge(rep_facet_id, fi);
             }
         }
-    }
+    });
 
     return components.extract_disjoint_set_indices(component_id);
 };
@@ -77,9 +84,9 @@ size_t compute_edge_based_components(
         is_blocked[ei] = true;
     });
 
-    DisjointSets<Index> components(num_facets);
-    for (auto ei : range(num_edges)) {
-        if (is_blocked[ei]) continue;
+    ConcurrentDisjointSets<Index> components(num_facets);
+    tbb::parallel_for(Index(0), num_edges, [&](Index ei) {
+        if (is_blocked[ei]) return;
         Index rep_facet_id = invalid_index;
         for (Index ci = mesh.get_first_corner_around_edge(ei); ci != invalid_index;
              ci = mesh.get_next_corner_around_edge(ci)) {
@@ -90,7 +97,7 @@ size_t compute_edge_based_components(
                 components.merge(rep_facet_id, fi);
             }
         }
-    }
+    });
 
     return components.extract_disjoint_set_indices(component_id);
 };
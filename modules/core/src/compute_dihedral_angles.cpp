@@ -12,12 +12,14 @@
 #include <lagrange/AttributeFwd.h>
 #include <lagrange/SurfaceMeshTypes.h>
 #include <lagrange/compute_dihedral_angles.h>
+#include <lagrange/compute_facet_normal.h>
 #include <lagrange/internal/find_attribute_utils.h>
 #include <lagrange/utils/assert.h>
 #include <lagrange/utils/geometry3d.h>
 #include <lagrange/utils/invalid.h>
 #include <lagrange/views.h>
 
+#include "internal/incremental_update.h"
 #include "internal/recompute_facet_normal_if_needed.h"
 
 // clang-format off
@@ -26,32 +28,24 @@
 #include <lagrange/utils/warnon.h>
 // clang-format on
 
+#include <optional>
+
 namespace lagrange {
 
+namespace {
+
 template <typename Scalar, typename Index>
-AttributeId compute_dihedral_angles(
+void compute_dihedral_angles_impl(
     SurfaceMesh<Scalar, Index>& mesh,
-    const DihedralAngleOptions& options)
+    AttributeId facet_normal_id,
+    AttributeId attr_id,
+    const std::optional<span<const Index>>& edges)
 {
-    mesh.initialize_edges();
-
-    auto [facet_normal_id, had_facet_normals] = internal::recompute_facet_normal_if_needed(
-        mesh,
-        options.facet_normal_attribute_name,
-        options.recompute_facet_normals);
     auto facet_normal = attribute_matrix_view<Scalar>(mesh, facet_normal_id);
-
-    AttributeId attr_id = internal::find_or_create_attribute<Scalar>(
-        mesh,
-        options.output_attribute_name,
-        Edge,
-        AttributeUsage::Scalar,
-        1,
-        internal::ResetToDefault::Yes);
     auto dihedral_angles = attribute_matrix_ref<Scalar>(mesh, attr_id);
 
     const auto num_edges = mesh.get_num_edges();
-    tbb::parallel_for((Index)0, num_edges, [&](Index ei) {
+    internal::par_foreach_selected(num_edges, edges, [&](Index ei) {
         Index c0 = mesh.get_first_corner_around_edge(ei);
         la_debug_assert(c0 != invalid<Index>());
         Index c1 = mesh.get_next_corner_around_edge(c0);
@@ -74,6 +68,70 @@ AttributeId compute_dihedral_angles(
         const Eigen::Matrix<Scalar, 1, 3> n1 = facet_normal.row(f1);
         dihedral_angles(ei) = angle_between(n0, n1);
     });
+}
+
+} // namespace
+
+template <typename Scalar, typename Index>
+AttributeId compute_dihedral_angles(
+    SurfaceMesh<Scalar, Index>& mesh,
+    const DihedralAngleOptions& options)
+{
+    mesh.initialize_edges();
+
+    auto [facet_normal_id, had_facet_normals] = internal::recompute_facet_normal_if_needed(
+        mesh,
+        options.facet_normal_attribute_name,
+        options.recompute_facet_normals);
+
+    AttributeId attr_id = internal::find_or_create_attribute<Scalar>(
+        mesh,
+        options.output_attribute_name,
+        Edge,
+        AttributeUsage::Scalar,
+        1,
+        internal::ResetToDefault::Yes);
+    compute_dihedral_angles_impl<Scalar, Index>(mesh, facet_normal_id, attr_id, std::nullopt);
+
+    if (!options.keep_facet_normals && !had_facet_normals) {
+        mesh.delete_attribute(options.facet_normal_attribute_name);
+    }
+    return attr_id;
+}
+
+template <typename Scalar, typename Index>
+AttributeId update_dihedral_angles(
+    SurfaceMesh<Scalar, Index>& mesh,
+    span<const Index> modified_vertices,
+    const DihedralAngleOptions& options)
+{
+    if (!mesh.has_attribute(options.output_attribute_name)) {
+        return compute_dihedral_angles(mesh, options);
+    }
+    mesh.initialize_edges();
+
+    // Facet normals are only updated around the modified vertices when they are cached.
+    const bool had_facet_normals = mesh.has_attribute(options.facet_normal_attribute_name);
+    FacetNormalOptions facet_normal_options;
+    facet_normal_options.output_attribute_name = options.facet_normal_attribute_name;
+    AttributeId facet_normal_id =
+        update_facet_normal(mesh, modified_vertices, facet_normal_options);
+
+    AttributeId attr_id = internal::find_attribute<Scalar>(
+        mesh,
+        options.output_attribute_name,
+        Edge,
+        AttributeUsage::Scalar,
+        1);
+
+    // Every edge of a facet whose normal changed may have a different dihedral angle.
+    const auto facets = internal::collect_facets_around_vertices(mesh, modified_vertices);
+    const auto edges = internal::collect_facet_edges(mesh, span<const Index>(facets));
+    compute_dihedral_angles_impl<Scalar, Index>(
+        mesh,
+        facet_normal_id,
+        attr_id,
+        span<const Index>(edges));
 
     if (!options.keep_facet_normals && !had_facet_normals) {
         mesh.delete_attribute(options.facet_normal_attribute_name);
@@ -81,9 +139,13 @@ AttributeId compute_dihedral_angles(
     return attr_id;
 }
 
-#define LA_X_compute_dihedral_angles(_, Scalar, Index)           \
+#define LA_X_compute_dihedral_angles(_, Scalar, Index)                       \
     template LA_CORE_API AttributeId compute_dihedral_angles<Scalar, Index>( \
-        SurfaceMesh<Scalar, Index>&,                             \
+        SurfaceMesh<Scalar, Index>&,                                         \
+        const DihedralAngleOptions&);                                        \
+    template LA_CORE_API AttributeId update_dihedral_angles<Scalar, Index>(  \
+        SurfaceMesh<Scalar, Index>&,                                         \
+        span<const Index>,                                                   \
         const DihedralAngleOptions&);
 LA_SURFACE_MESH_X(compute_dihedral_angles, 0)
 
@@ -10,18 +10,32 @@
  * governing permissions and limitations under the License.
  */
 
+#include <lagrange/Attribute.h>
 #include <lagrange/SurfaceMeshTypes.h>
 #include <lagrange/compute_dijkstra_distance.h>
+#include <lagrange/compute_vertex_vertex_adjacency.h>
 #include <lagrange/internal/dijkstra.h>
 #include <lagrange/internal/find_attribute_utils.h>
 #include <lagrange/utils/assert.h>
 #include <lagrange/views.h>
 
+// clang-format off
+#include <lagrange/utils/warnoff.h>
+#include <tbb/parallel_for.h>
+#include <lagrange/utils/warnon.h>
+// clang-format on
+
+#include <algorithm>
+#include <cmath>
+#include <set>
+#include <utility>
+
 namespace lagrange {
 
+namespace {
 
 template <typename Scalar, typename Index>
-std::optional<std::vector<Index>> compute_dijkstra_distance(
+AttributeId prepare_output_attribute(
     SurfaceMesh<Scalar, Index>& mesh,
     const DijkstraDistanceOptions<Scalar, Index>& options)
 {
@@ -35,7 +49,15 @@ std::optional<std::vector<Index>> compute_dijkstra_distance(
 
     auto dist_data = attribute_vector_ref<Scalar>(mesh, dist_attr_id);
     dist_data.setConstant(Scalar(-1));
+    return dist_attr_id;
+}
 
+/// Computes the distance from the seed point to each vertex of the seed facet.
+template <typename Scalar, typename Index>
+Vector<Scalar> compute_seed_vertex_distances(
+    const SurfaceMesh<Scalar, Index>& mesh,
+    const DijkstraDistanceOptions<Scalar, Index>& options)
+{
     const auto seed_vertices = mesh.get_facet_vertices(options.seed_facet);
     const auto vertices = vertex_view(mesh);
 
@@ -53,6 +75,122 @@ std::optional<std::vector<Index>> compute_dijkstra_distance(
     for (Index i = 0; i < seed_vertices.size(); i++) {
         initial_dist[i] = (vertices.row(seed_vertices[i]).transpose() - pt).norm();
     }
+    return initial_dist;
+}
+
+///
+/// Runs a single query over a precomputed vertex-vertex adjacency. The mesh is only read from, so
+/// multiple queries can run concurrently as long as they write to different outputs.
+///
+template <typename Scalar, typename Index>
+std::optional<std::vector<Index>> compute_dijkstra_distance_with_adjacency(
+    const SurfaceMesh<Scalar, Index>& mesh,
+    const AdjacencyList<Index>& adjacency,
+    const DijkstraDistanceOptions<Scalar, Index>& options,
+    span<Scalar> dist_data)
+{
+    const Index num_vertices = mesh.get_num_vertices();
+    la_runtime_assert(
+        adjacency.get_num_entries() == num_vertices,
+        "Vertex adjacency does not match the mesh");
+
+    const auto seed_vertices = mesh.get_facet_vertices(options.seed_facet);
+    const auto initial_dist = compute_seed_vertex_distances(mesh, options);
+    const span<const Scalar> seed_vertex_dist(
+        initial_dist.data(),
+        static_cast<size_t>(initial_dist.size()));
+    const auto vertices = vertex_view(mesh);
+
+    const auto dist = [&](Index vi, Index vj) {
+        return (vertices.row(vi) - vertices.row(vj)).norm();
+    };
+
+    std::optional<std::vector<Index>> involved_vts;
+    if (options.output_involved_vertices) {
+        involved_vts = std::vector<Index>();
+    }
+
+    if (!options.parallel) {
+        internal::dijkstra<Scalar, Index>(
+            adjacency,
+            seed_vertices,
+            seed_vertex_dist,
+            options.radius,
+            dist,
+            [&](Index vi, Scalar d) {
+                dist_data[vi] = d;
+                if (involved_vts) involved_vts->push_back(vi);
+                return false;
+            });
+        return involved_vts;
+    }
+
+    Scalar delta = options.delta;
+    if (delta <= 0) {
+        // Average length of the edges incident to the seed vertices
+        Scalar total_length = 0;
+        size_t num_edges = 0;
+        for (Index vi : seed_vertices) {
+            for (Index vj : adjacency.get_neighbors(vi)) {
+                total_length += dist(vi, vj);
+                ++num_edges;
+            }
+        }
+        delta = num_edges > 0 ? total_length / static_cast<Scalar>(num_edges) : Scalar(0);
+        if (!(delta > 0)) delta = Scalar(1);
+    }
+
+    internal::delta_stepping<Scalar, Index>(
+        adjacency,
+        seed_vertices,
+        seed_vertex_dist,
+        options.radius,
+        delta,
+        dist,
+        dist_data);
+
+    if (involved_vts) {
+        for (Index vi = 0; vi < num_vertices; ++vi) {
+            if (std::isfinite(dist_data[vi])) involved_vts->push_back(vi);
+        }
+        // Match the order in which the serial algorithm reaches vertices
+        std::sort(involved_vts->begin(), involved_vts->end(), [&](Index vi, Index vj) {
+            return std::make_pair(dist_data[vi], vi) < std::make_pair(dist_data[vj], vj);
+        });
+    }
+    tbb::parallel_for(Index(0), num_vertices, [&](Index vi) {
+        if (!std::isfinite(dist_data[vi])) dist_data[vi] = Scalar(-1);
+    });
+
+    return involved_vts;
+}
+
+} // namespace
+
+template <typename Scalar, typename Index>
+std::optional<std::vector<Index>> compute_dijkstra_distance(
+    SurfaceMesh<Scalar, Index>& mesh,
+    const DijkstraDistanceOptions<Scalar, Index>& options)
+{
+    const auto dist_attr_id = prepare_output_attribute(mesh, options);
+
+    if (options.parallel || options.vertex_adjacency != nullptr) {
+        std::optional<AdjacencyList<Index>> adjacency;
+        if (options.vertex_adjacency == nullptr) {
+            adjacency = compute_vertex_vertex_adjacency(mesh);
+        }
+        auto dist_data = mesh.template ref_attribute<Scalar>(dist_attr_id).ref_all();
+        return compute_dijkstra_distance_with_adjacency(
+            std::as_const(mesh),
+            adjacency ? *adjacency : *options.vertex_adjacency,
+            options,
+            dist_data);
+    }
+
+    auto dist_data = attribute_vector_ref<Scalar>(mesh, dist_attr_id);
+    const auto seed_vertices = mesh.get_facet_vertices(options.seed_facet);
+    const auto initial_dist = compute_seed_vertex_distances(std::as_const(mesh), options);
+    const auto vertices = vertex_view(mesh);
 
     const auto dist = [&](Index vi, Index vj) {
         return (vertices.row(vi) - vertices.row(vj)).norm();
@@ -88,10 +226,57 @@ std::optional<std::vector<Index>> compute_dijkstra_distance(
     return involved_vts;
 }
 
+template <typename Scalar, typename Index>
+std::vector<std::optional<std::vector<Index>>> compute_dijkstra_distance(
+    SurfaceMesh<Scalar, Index>& mesh,
+    span<const DijkstraDistanceOptions<Scalar, Index>> queries)
+{
+    const size_t num_queries = queries.size();
+
+    // Output attributes are created and made writable before the parallel loop, since mesh
+    // modifications are not thread-safe.
+    std::set<std::string_view> output_names;
+    std::vector<AttributeId> dist_attr_ids(num_queries);
+    bool needs_adjacency = false;
+    for (size_t i = 0; i < num_queries; ++i) {
+        la_runtime_assert(
+            output_names.insert(queries[i].output_attribute_name).second,
+            "Dijkstra queries must have distinct output attribute names");
+        dist_attr_ids[i] = prepare_output_attribute(mesh, queries[i]);
+        needs_adjacency = needs_adjacency || queries[i].vertex_adjacency == nullptr;
+    }
+    std::vector<span<Scalar>> dist_data(num_queries);
+    for (size_t i = 0; i < num_queries; ++i) {
+        dist_data[i] = mesh.template ref_attribute<Scalar>(dist_attr_ids[i]).ref_all();
+    }
+
+    std::optional<AdjacencyList<Index>> adjacency;
+    if (needs_adjacency) {
+        adjacency = compute_vertex_vertex_adjacency(mesh);
+    }
+
+    std::vector<std::optional<std::vector<Index>>> involved_vts(num_queries);
+    const auto& const_mesh = mesh;
+    tbb::parallel_for(size_t(0), num_queries, [&](size_t i) {
+        const auto& query = queries[i];
+        involved_vts[i] = compute_dijkstra_distance_with_adjacency(
+            const_mesh,
+            query.vertex_adjacency ? *query.vertex_adjacency : *adjacency,
+            query,
+            dist_data[i]);
+    });
+
+    return involved_vts;
+}
+
 #define LA_X_compute_dijkstra_distance(_, Scalar, Index)                                 \
     template LA_CORE_API std::optional<std::vector<Index>> compute_dijkstra_distance<Scalar, Index>( \
         SurfaceMesh<Scalar, Index>&,                                                     \
-        const DijkstraDistanceOptions<Scalar, Index>& options);
+        const DijkstraDistanceOptions<Scalar, Index>& options);                          \
+    template LA_CORE_API std::vector<std::optional<std::vector<Index>>>                  \
+    compute_dijkstra_distance<Scalar, Index>(                                            \
+        SurfaceMesh<Scalar, Index>&,                                                     \
+        span<const DijkstraDistanceOptions<Scalar, Index>>);
 LA_SURFACE_MESH_X(compute_dijkstra_distance, 0)
 
 } // namespace lagrange
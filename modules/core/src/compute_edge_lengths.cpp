@@ -10,25 +10,37 @@
  * governing permissions and limitations under the License.
  */
 
+#include <lagrange/Attribute.h>
 #include <lagrange/AttributeFwd.h>
 #include <lagrange/SurfaceMeshTypes.h>
 #include <lagrange/compute_edge_lengths.h>
 #include <lagrange/internal/find_attribute_utils.h>
+#include <lagrange/utils/assert.h>
 #include <lagrange/views.h>
 
+#include "internal/incremental_update.h"
+#include "internal/triangle_batch.h"
+
 // clang-format off
 #include <lagrange/utils/warnoff.h>
 #include <tbb/parallel_for.h>
 #include <lagrange/utils/warnon.h>
 // clang-format on
 
+#include <array>
+#include <optional>
+#include <vector>
+
 namespace lagrange {
 
+namespace {
+
 template <typename Scalar, typename Index>
-AttributeId compute_edge_lengths(SurfaceMesh<Scalar, Index>& mesh, const EdgeLengthOptions& options)
+AttributeId compute_edge_lengths_impl(
+    SurfaceMesh<Scalar, Index>& mesh,
+    const std::optional<span<const Index>>& edges,
+    const EdgeLengthOptions& options)
 {
-    mesh.initialize_edges();
-
     AttributeId attr_id = internal::find_or_create_attribute<Scalar>(
         mesh,
         options.output_attribute_name,
@@ -38,9 +50,35 @@ AttributeId compute_edge_lengths(SurfaceMesh<Scalar, Index>& mesh, const EdgeLen
         internal::ResetToDefault::No);
     auto edge_lengths = attribute_matrix_ref<Scalar>(mesh, attr_id);
 
-    auto vertices = vertex_view(mesh);
     const auto num_edges = mesh.get_num_edges();
-    tbb::parallel_for((Index)0, num_edges, [&](Index ei) {
+    const auto dim = static_cast<Eigen::Index>(mesh.get_dimension());
+    if (dim == 2 || dim == 3) {
+        // Edge end points are gathered in SoA form, and lengths are computed a batch at a time.
+        const Scalar* positions = mesh.get_vertex_to_position().get_all().data();
+        internal::par_foreach_batch(
+            num_edges,
+            edges,
+            [&](const auto& ids, Eigen::Index count) {
+                std::array<std::array<Index, 2>, internal::batch_size> end_points;
+                for (Eigen::Index i = 0; i < count; ++i) {
+                    end_points[i] = mesh.get_edge_vertices(ids[i]);
+                }
+                const auto p0 = internal::gather_points(positions, dim, count, [&](Eigen::Index i) {
+                    return end_points[i][0];
+                });
+                const auto p1 = internal::gather_points(positions, dim, count, [&](Eigen::Index i) {
+                    return end_points[i][1];
+                });
+                const auto lengths = internal::norm(p0 - p1);
+                for (Eigen::Index i = 0; i < count; ++i) {
+                    edge_lengths(ids[i]) = lengths[i];
+                }
+            });
+        return attr_id;
+    }
+
+    auto vertices = vertex_view(mesh);
+    internal::par_foreach_selected(num_edges, edges, [&](Index ei) {
         auto end_points = mesh.get_edge_vertices(ei);
         edge_lengths(ei) = (vertices.row(end_points[0]) - vertices.row(end_points[1])).norm();
     });
@@ -48,9 +86,41 @@ AttributeId compute_edge_lengths(SurfaceMesh<Scalar, Index>& mesh, const EdgeLen
     return attr_id;
 }
 
-#define LA_X_compute_edge_lengths(_, Scalar, Index)           \
+} // namespace
+
+template <typename Scalar, typename Index>
+AttributeId compute_edge_lengths(SurfaceMesh<Scalar, Index>& mesh, const EdgeLengthOptions& options)
+{
+    mesh.initialize_edges();
+    return compute_edge_lengths_impl<Scalar, Index>(mesh, std::nullopt, options);
+}
+
+template <typename Scalar, typename Index>
+AttributeId update_edge_lengths(
+    SurfaceMesh<Scalar, Index>& mesh,
+    span<const Index> modified_vertices,
+    const EdgeLengthOptions& options)
+{
+    if (!mesh.has_attribute(options.output_attribute_name)) {
+        return compute_edge_lengths(mesh, options);
+    }
+    mesh.initialize_edges();
+    std::vector<Index> edges;
+    for (Index v : modified_vertices) {
+        la_runtime_assert(v < mesh.get_num_vertices(), "Vertex index out of range");
+        mesh.foreach_edge_around_vertex_with_duplicates(v, [&](Index e) { edges.push_back(e); });
+    }
+    internal::sort_unique(edges);
+    return compute_edge_lengths_impl<Scalar, Index>(mesh, span<const Index>(edges), options);
+}
+
+#define LA_X_compute_edge_lengths(_, Scalar, Index)                       \
     template LA_CORE_API AttributeId compute_edge_lengths<Scalar, Index>( \
-        SurfaceMesh<Scalar, Index>&,                          \
+        SurfaceMesh<Scalar, Index>&,                                      \
+        const EdgeLengthOptions&);                                        \
+    template LA_CORE_API AttributeId update_edge_lengths<Scalar, Index>(  \
+        SurfaceMesh<Scalar, Index>&,                                      \
+        span<const Index>,                                                \
         const EdgeLengthOptions&);
 LA_SURFACE_MESH_X(compute_edge_lengths, 0)
 
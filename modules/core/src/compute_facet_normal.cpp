@@ -20,6 +20,9 @@
 #include <lagrange/utils/assert.h>
 #include <lagrange/views.h>
 
+#include "internal/incremental_update.h"
+#include "internal/triangle_batch.h"
+
 // clang-format off
 #include <lagrange/utils/warnoff.h>
 #include <tbb/parallel_for.h>
@@ -28,10 +31,17 @@
 
 #include <Eigen/Dense>
 
+#include <optional>
+
 namespace lagrange {
 
+namespace {
+
 template <typename Scalar, typename Index>
-AttributeId compute_facet_normal(SurfaceMesh<Scalar, Index>& mesh, FacetNormalOptions options)
+AttributeId compute_facet_normal_impl(
+    SurfaceMesh<Scalar, Index>& mesh,
+    const std::optional<span<const Index>>& facets,
+    const FacetNormalOptions& options)
 {
     la_runtime_assert(mesh.get_dimension() == 3, "Only 3D mesh is supported.");
     const auto num_facets = mesh.get_num_facets();
@@ -48,8 +58,34 @@ AttributeId compute_facet_normal(SurfaceMesh<Scalar, Index>& mesh, FacetNormalOp
     la_debug_assert(static_cast<Index>(attr.get_num_elements()) == num_facets);
     auto attr_ref = attr.ref_all(); // Just to trigger copy-on-write.
 
+    if (mesh.is_triangle_mesh()) {
+        // Triangle normals are computed in batches, with vertex positions gathered in SoA form.
+        const Scalar* positions = mesh.get_vertex_to_position().get_all().data();
+        const Index* corner_to_vertex = mesh.get_corner_to_vertex().get_all().data();
+        internal::par_foreach_batch(
+            num_facets,
+            facets,
+            [&](const auto& ids, Eigen::Index count) {
+                internal::PointBatch<Scalar> p[3];
+                for (Index k = 0; k < 3; ++k) {
+                    p[k] = internal::gather_points(positions, 3, count, [&](Eigen::Index i) {
+                        return corner_to_vertex[static_cast<size_t>(ids[i]) * 3 + k];
+                    });
+                }
+                auto normal = internal::cross(p[1] - p[0], p[2] - p[0]);
+                internal::stable_normalize(normal);
+                for (Eigen::Index i = 0; i < count; ++i) {
+                    const size_t fid = static_cast<size_t>(ids[i]);
+                    attr_ref[fid * 3] = normal.x[i];
+                    attr_ref[fid * 3 + 1] = normal.y[i];
+                    attr_ref[fid * 3 + 2] = normal.z[i];
+                }
+            });
+        return id;
+    }
+
     const auto& vertex_positions = vertex_view(mesh);
-    tbb::parallel_for(Index(0), num_facets, [&](Index fid) {
+    internal::par_foreach_selected(num_facets, facets, [&](Index fid) {
         // Robust polygon normal calculation
         // n ~ p0 x p1 + p1 x p2 + ... + pn x p0
         const auto facet_vertices = mesh.get_facet_vertices(fid);
@@ -69,8 +105,36 @@ AttributeId compute_facet_normal(SurfaceMesh<Scalar, Index>& mesh, FacetNormalOp
     return id;
 }
 
-#define LA_X_compute_facet_normal(_, Scalar, Index) \
-    template LA_CORE_API AttributeId compute_facet_normal(SurfaceMesh<Scalar, Index>& mesh, FacetNormalOptions);
+} // namespace
+
+template <typename Scalar, typename Index>
+AttributeId compute_facet_normal(SurfaceMesh<Scalar, Index>& mesh, FacetNormalOptions options)
+{
+    return compute_facet_normal_impl<Scalar, Index>(mesh, std::nullopt, options);
+}
+
+template <typename Scalar, typename Index>
+AttributeId update_facet_normal(
+    SurfaceMesh<Scalar, Index>& mesh,
+    span<const Index> modified_vertices,
+    FacetNormalOptions options)
+{
+    if (!mesh.has_attribute(options.output_attribute_name)) {
+        return compute_facet_normal(mesh, options);
+    }
+    mesh.initialize_edges();
+    const auto facets = internal::collect_facets_around_vertices(mesh, modified_vertices);
+    return compute_facet_normal_impl<Scalar, Index>(mesh, span<const Index>(facets), options);
+}
+
+#define LA_X_compute_facet_normal(_, Scalar, Index)        \
+    template LA_CORE_API AttributeId compute_facet_normal( \
+        SurfaceMesh<Scalar, Index>& mesh,                  \
+        FacetNormalOptions);                               \
+    template LA_CORE_API AttributeId update_facet_normal(  \
+        SurfaceMesh<Scalar, Index>& mesh,                  \
+        span<const Index>,                                 \
+        FacetNormalOptions);
 LA_SURFACE_MESH_X(compute_facet_normal, 0)
 
 } // namespace lagrange
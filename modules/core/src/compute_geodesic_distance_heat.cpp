@@ -0,0 +1,289 @@
+/*
+ * Copyright 2024 Adobe. All rights reserved.
+ * This file is licensed to you under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License. You may obtain a copy
+ * of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under
+ * the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR REPRESENTATIONS
+ * OF ANY KIND, either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+ */
+#include <lagrange/Attribute.h>
+#include <lagrange/SurfaceMeshTypes.h>
+#include <lagrange/compute_geodesic_distance_heat.h>
+#include <lagrange/compute_vertex_corner_adjacency.h>
+#include <lagrange/internal/find_attribute_utils.h>
+#include <lagrange/utils/assert.h>
+#include <lagrange/views.h>
+
+// clang-format off
+#include <lagrange/utils/warnoff.h>
+#include <Eigen/Geometry>
+#include <Eigen/Sparse>
+#include <tbb/parallel_for.h>
+#include <tbb/parallel_reduce.h>
+#include <lagrange/utils/warnon.h>
+// clang-format on
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+namespace lagrange {
+
+template <typename Scalar, typename Index>
+struct GeodesicSolver<Scalar, Index>::Impl
+{
+    using SparseMatrix = Eigen::SparseMatrix<double>;
+    using Solver = Eigen::SimplicialLDLT<SparseMatrix>;
+    using RowMatrix3 = Eigen::Matrix<double, Eigen::Dynamic, 3, Eigen::RowMajor>;
+    using FacetMatrix = Eigen::Matrix<Index, Eigen::Dynamic, 3, Eigen::RowMajor>;
+
+    /// Vertex positions, padded with zeros for 2D meshes.
+    RowMatrix3 vertices;
+
+    /// Triangle vertex indices.
+    FacetMatrix facets;
+
+    /// Cotangent of the interior angle at each facet corner.
+    RowMatrix3 cotangents;
+
+    /// Facet corners around each vertex.
+    AdjacencyList<Index> vertex_corners;
+
+    /// Factorization of M + t L, for heat diffusion.
+    Solver heat_solver;
+
+    /// Factorization of L (slightly regularized), for distance recovery.
+    Solver poisson_solver;
+
+    Impl(const SurfaceMesh<Scalar, Index>& mesh, const HeatGeodesicOptions& options)
+        : vertex_corners(compute_vertex_corner_adjacency(mesh))
+    {
+        la_runtime_assert(mesh.is_triangle_mesh(), "Heat method requires a triangle mesh");
+        la_runtime_assert(
+            mesh.get_dimension() == 2 || mesh.get_dimension() == 3,
+            "Heat method requires a 2D or 3D mesh");
+        la_runtime_assert(options.time_step > 0, "Heat method time step must be positive");
+
+        const Index num_vertices = mesh.get_num_vertices();
+        const Index num_facets = mesh.get_num_facets();
+        const Index dim = mesh.get_dimension();
+        la_runtime_assert(num_facets > 0, "Heat method requires a non-empty mesh");
+
+        vertices = RowMatrix3::Zero(num_vertices, 3);
+        vertices.leftCols(dim) = vertex_view(mesh).template cast<double>();
+        facets = facet_view(mesh);
+        cotangents.resize(num_facets, 3);
+
+        // Each facet contributes 4 Laplacian entries per edge and 1 mass entry per corner.
+        using Triplet = Eigen::Triplet<double, typename SparseMatrix::StorageIndex>;
+        std::vector<Triplet> laplacian_triplets(size_t(num_facets) * 12);
+        std::vector<Triplet> mass_triplets(size_t(num_facets) * 3);
+
+        const double total_edge_length = tbb::parallel_reduce(
+            tbb::blocked_range<Index>(0, num_facets),
+            0.0,
+            [&](const tbb::blocked_range<Index>& range, double sum) {
+                for (Index f = range.begin(); f != range.end(); ++f) {
+                    const double area =
+                        0.5 * (vertices.row(facets(f, 1)) - vertices.row(facets(f, 0)))
+                                  .cross(vertices.row(facets(f, 2)) - vertices.row(facets(f, 0)))
+                                  .norm();
+                    for (Index k = 0; k < 3; ++k) {
+                        const Index vi = facets(f, k);
+                        const Index vj = facets(f, (k + 1) % 3);
+                        const Index vk = facets(f, (k + 2) % 3);
+                        const Eigen::RowVector3d a = vertices.row(vj) - vertices.row(vi);
+                        const Eigen::RowVector3d b = vertices.row(vk) - vertices.row(vi);
+                        const double sin_area = a.cross(b).norm();
+                        const double cot = sin_area > 0 ? a.dot(b) / sin_area : 0.0;
+                        cotangents(f, k) = cot;
+                        sum += a.norm();
+
+                        // Edge (vj, vk) is opposite to corner k.
+                        const double w = 0.5 * cot;
+                        const auto sj = static_cast<typename SparseMatrix::StorageIndex>(vj);
+                        const auto sk = static_cast<typename SparseMatrix::StorageIndex>(vk);
+                        const size_t offset = size_t(f) * 12 + size_t(k) * 4;
+                        laplacian_triplets[offset + 0] = Triplet(sj, sk, -w);
+                        laplacian_triplets[offset + 1] = Triplet(sk, sj, -w);
+                        laplacian_triplets[offset + 2] = Triplet(sj, sj, w);
+                        laplacian_triplets[offset + 3] = Triplet(sk, sk, w);
+                        mass_triplets[size_t(f) * 3 + k] = Triplet(
+                            static_cast<typename SparseMatrix::StorageIndex>(vi),
+                            static_cast<typename SparseMatrix::StorageIndex>(vi),
+                            area / 3);
+                    }
+                }
+                return sum;
+            },
+            std::plus<double>());
+        const double mean_edge_length = total_edge_length / (3.0 * num_facets);
+        la_runtime_assert(mean_edge_length > 0, "Heat method requires non-degenerate facets");
+
+        SparseMatrix laplacian(num_vertices, num_vertices);
+        laplacian.setFromTriplets(laplacian_triplets.begin(), laplacian_triplets.end());
+        SparseMatrix mass(num_vertices, num_vertices);
+        mass.setFromTriplets(mass_triplets.begin(), mass_triplets.end());
+
+        const double t = options.time_step * mean_edge_length * mean_edge_length;
+        heat_solver.compute(mass + t * laplacian);
+        la_runtime_assert(
+            heat_solver.info() == Eigen::Success,
+            "Failed to factorize heat method diffusion system");
+
+        // The Laplacian is singular (constants are in its kernel). A tiny mass shift makes it
+        // definite without visibly changing the solution, which is shifted afterwards anyway.
+        const double shift = 1e-8 / (mean_edge_length * mean_edge_length);
+        poisson_solver.compute(laplacian + shift * mass);
+        la_runtime_assert(
+            poisson_solver.info() == Eigen::Success,
+            "Failed to factorize heat method Poisson system");
+    }
+
+    void compute(span<const Index> source_vertices, span<Scalar> distances) const
+    {
+        const Index num_vertices = static_cast<Index>(vertices.rows());
+        const Index num_facets = static_cast<Index>(facets.rows());
+        la_runtime_assert(!source_vertices.empty(), "Heat method requires source vertices");
+        la_runtime_assert(distances.size() == num_vertices);
+
+        // 1. Diffuse heat from the sources.
+        Eigen::VectorXd u0 = Eigen::VectorXd::Zero(num_vertices);
+        for (Index v : source_vertices) {
+            la_runtime_assert(v < num_vertices, "Invalid source vertex");
+            u0[v] = 1;
+        }
+        const Eigen::VectorXd u = heat_solver.solve(u0);
+
+        // 2. Normalize the negated heat gradient on each facet, and compute the contribution of
+        // each corner to the integrated divergence of the resulting field.
+        std::vector<double> corner_divergence(size_t(num_facets) * 3);
+        tbb::parallel_for(Index(0), num_facets, [&](Index f) {
+            const Eigen::RowVector3d p0 = vertices.row(facets(f, 0));
+            const Eigen::RowVector3d p1 = vertices.row(facets(f, 1));
+            const Eigen::RowVector3d p2 = vertices.row(facets(f, 2));
+            Eigen::RowVector3d n = (p1 - p0).cross(p2 - p0);
+            const double double_area = n.norm();
+            Eigen::RowVector3d X = Eigen::RowVector3d::Zero();
+            if (double_area > 0) {
+                n /= double_area;
+                const Eigen::RowVector3d grad =
+                    (u[facets(f, 0)] * n.cross(p2 - p1) + u[facets(f, 1)] * n.cross(p0 - p2) +
+                     u[facets(f, 2)] * n.cross(p1 - p0)) /
+                    double_area;
+                const double grad_norm = grad.norm();
+                if (grad_norm > 0) X = -grad / grad_norm;
+            }
+            for (Index k = 0; k < 3; ++k) {
+                const Index j = (k + 1) % 3;
+                const Index l = (k + 2) % 3;
+                const Eigen::RowVector3d pk = vertices.row(facets(f, k));
+                const double dj = (vertices.row(facets(f, j)) - pk).dot(X);
+                const double dl = (vertices.row(facets(f, l)) - pk).dot(X);
+                corner_divergence[size_t(f) * 3 + k] =
+                    0.5 * (cotangents(f, l) * dj + cotangents(f, j) * dl);
+            }
+        });
+
+        Eigen::VectorXd divergence(num_vertices);
+        tbb::parallel_for(Index(0), num_vertices, [&](Index v) {
+            double sum = 0;
+            for (Index c : vertex_corners.get_neighbors(v)) {
+                sum += corner_divergence[c];
+            }
+            divergence[v] = sum;
+        });
+
+        // 3. Recover the distance whose gradient best matches the normalized field.
+        const Eigen::VectorXd phi = poisson_solver.solve(-divergence);
+
+        // Distances are defined up to a constant. Shift them so that the sources are at zero.
+        double min_source_phi = std::numeric_limits<double>::max();
+        for (Index v : source_vertices) {
+            min_source_phi = std::min(min_source_phi, phi[v]);
+        }
+        tbb::parallel_for(Index(0), num_vertices, [&](Index v) {
+            distances[v] = static_cast<Scalar>(phi[v] - min_source_phi);
+        });
+    }
+};
+
+template <typename Scalar, typename Index>
+GeodesicSolver<Scalar, Index>::GeodesicSolver(
+    const SurfaceMesh<Scalar, Index>& mesh,
+    const HeatGeodesicOptions& options)
+    : m_impl(std::make_unique<Impl>(mesh, options))
+{}
+
+template <typename Scalar, typename Index>
+GeodesicSolver<Scalar, Index>::~GeodesicSolver() = default;
+
+template <typename Scalar, typename Index>
+GeodesicSolver<Scalar, Index>::GeodesicSolver(GeodesicSolver&&) noexcept = default;
+
+template <typename Scalar, typename Index>
+GeodesicSolver<Scalar, Index>& GeodesicSolver<Scalar, Index>::operator=(GeodesicSolver&&) noexcept =
+    default;
+
+template <typename Scalar, typename Index>
+Index GeodesicSolver<Scalar, Index>::get_num_vertices() const
+{
+    return static_cast<Index>(m_impl->vertices.rows());
+}
+
+template <typename Scalar, typename Index>
+void GeodesicSolver<Scalar, Index>::compute(
+    span<const Index> source_vertices,
+    span<Scalar> distances) const
+{
+    m_impl->compute(source_vertices, distances);
+}
+
+template <typename Scalar, typename Index>
+void GeodesicSolver<Scalar, Index>::compute(
+    span<const std::vector<Index>> source_sets,
+    span<Scalar> distances) const
+{
+    const size_t num_vertices = get_num_vertices();
+    la_runtime_assert(
+        distances.size() == source_sets.size() * num_vertices,
+        "Output must have one distance per vertex and per source set");
+
+    tbb::parallel_for(size_t(0), source_sets.size(), [&](size_t i) {
+        m_impl->compute(source_sets[i], distances.subspan(i * num_vertices, num_vertices));
+    });
+}
+
+template <typename Scalar, typename Index>
+AttributeId compute_geodesic_distance_heat(
+    SurfaceMesh<Scalar, Index>& mesh,
+    span<const Index> source_vertices,
+    const HeatGeodesicOptions& options)
+{
+    GeodesicSolver<Scalar, Index> solver(mesh, options);
+
+    const auto dist_attr_id = internal::find_or_create_attribute<Scalar>(
+        mesh,
+        options.output_attribute_name,
+        AttributeElement::Vertex,
+        AttributeUsage::Scalar,
+        1,
+        internal::ResetToDefault::No);
+    auto distances = mesh.template ref_attribute<Scalar>(dist_attr_id).ref_all();
+    solver.compute(source_vertices, distances);
+
+    return dist_attr_id;
+}
+
+#define LA_X_compute_geodesic_distance_heat(_, Scalar, Index)                   \
+    template class LA_CORE_API GeodesicSolver<Scalar, Index>;                   \
+    template LA_CORE_API AttributeId compute_geodesic_distance_heat<Scalar, Index>( \
+        SurfaceMesh<Scalar, Index>&,                                            \
+        span<const Index>,                                                      \
+        const HeatGeodesicOptions&);
+LA_SURFACE_MESH_X(compute_geodesic_distance_heat, 0)
+
+} // namespace lagrange
@@ -0,0 +1,63 @@
+/*
+ * Copyright 2024 Adobe. All rights reserved.
+ * This file is licensed to you under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License. You may obtain a copy
+ * of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under
+ * the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR REPRESENTATIONS
+ * OF ANY KIND, either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+ */
+#include <lagrange/compute_vertex_cache_statistics.h>
+
+#include <lagrange/Attribute.h>
+#include <lagrange/SurfaceMeshTypes.h>
+#include <lagrange/utils/assert.h>
+
+#include <vector>
+
+namespace lagrange {
+
+template <typename Scalar, typename Index>
+VertexCacheStatistics compute_vertex_cache_statistics(
+    const SurfaceMesh<Scalar, Index>& mesh,
+    size_t cache_size)
+{
+    la_runtime_assert(cache_size > 0, "Vertex cache size must be positive");
+
+    // A vertex is in the FIFO cache iff fewer than `cache_size` vertices were pushed since it was.
+    const Index num_vertices = mesh.get_num_vertices();
+    std::vector<size_t> cache_time(num_vertices, 0);
+    std::vector<bool> referenced(num_vertices, false);
+    size_t time = cache_size + 1;
+    size_t num_referenced = 0;
+
+    VertexCacheStatistics stats;
+    for (Index v : mesh.get_corner_to_vertex().get_all()) {
+        if (time - cache_time[v] > cache_size) {
+            cache_time[v] = time++;
+            ++stats.num_cache_misses;
+        }
+        if (!referenced[v]) {
+            referenced[v] = true;
+            ++num_referenced;
+        }
+    }
+
+    if (mesh.get_num_facets() > 0) {
+        stats.acmr = double(stats.num_cache_misses) / double(mesh.get_num_facets());
+    }
+    if (num_referenced > 0) {
+        stats.atvr = double(stats.num_cache_misses) / double(num_referenced);
+    }
+    return stats;
+}
+
+#define LA_X_compute_vertex_cache_statistics(_, Scalar, Index)                              \
+    template LA_CORE_API VertexCacheStatistics compute_vertex_cache_statistics<Scalar, Index>( \
+        const SurfaceMesh<Scalar, Index>&,                                                  \
+        size_t);
+LA_SURFACE_MESH_X(compute_vertex_cache_statistics, 0)
+
+} // namespace lagrange
@@ -0,0 +1,46 @@
+/*
+ * Copyright 2024 Adobe. All rights reserved.
+ * This file is licensed to you under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License. You may obtain a copy
+ * of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under
+ * the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR REPRESENTATIONS
+ * OF ANY KIND, either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+ */
+#include <lagrange/Attribute.h>
+#include <lagrange/SurfaceMeshTypes.h>
+#include <lagrange/compute_vertex_corner_adjacency.h>
+
+#include "internal/bucket_sort.h"
+
+#include <vector>
+
+namespace lagrange {
+
+template <typename Scalar, typename Index>
+AdjacencyList<Index> compute_vertex_corner_adjacency(const SurfaceMesh<Scalar, Index>& mesh)
+{
+    using ValueArray = typename AdjacencyList<Index>::ValueArray;
+    using IndexArray = typename AdjacencyList<Index>::IndexArray;
+
+    auto corner_to_vertex = mesh.get_corner_to_vertex().get_all();
+    ValueArray adjacency_data(mesh.get_num_corners());
+    auto buckets = internal::parallel_bucket_sort(
+        adjacency_data,
+        mesh.get_num_vertices(),
+        [&](Index c) { return corner_to_vertex[c]; });
+    IndexArray adjacency_index(
+        buckets.representative_offsets.begin(),
+        buckets.representative_offsets.end());
+
+    return AdjacencyList<Index>(std::move(adjacency_data), std::move(adjacency_index));
+}
+
+#define LA_X_compute_vertex_corner_adjacency(_, Scalar, Index)                  \
+    template LA_CORE_API AdjacencyList<Index> compute_vertex_corner_adjacency( \
+        const SurfaceMesh<Scalar, Index>&);
+LA_SURFACE_MESH_X(compute_vertex_corner_adjacency, 0)
+
+} // namespace lagrange
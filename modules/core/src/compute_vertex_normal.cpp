@@ -13,6 +13,7 @@
 #include <lagrange/AttributeFwd.h>
 #include <lagrange/Logger.h>
 #include <lagrange/SurfaceMeshTypes.h>
+#include <lagrange/compute_vertex_corner_adjacency.h>
 #include <lagrange/compute_vertex_normal.h>
 #include <lagrange/compute_weighted_corner_normal.h>
 #include <lagrange/internal/find_attribute_utils.h>
@@ -21,6 +22,7 @@
 #include <lagrange/views.h>
 
 #include "internal/compute_weighted_corner_normal.h"
+#include "internal/incremental_update.h"
 
 // clang-format off
 #include <lagrange/utils/warnoff.h>
@@ -28,6 +30,8 @@
 #include <lagrange/utils/warnon.h>
 // clang-format on
 
+#include <vector>
+
 namespace lagrange {
 
 template <typename Scalar, typename Index>
@@ -49,7 +53,19 @@ AttributeId compute_vertex_normal(SurfaceMesh<Scalar, Index>& mesh, VertexNormal
     la_debug_assert(static_cast<Index>(normals.rows()) == num_vertices);
     normals.setZero();
 
-    if (mesh.has_edges()) {
+    if (mesh.has_edges() && mesh.is_triangle_mesh()) {
+        // Corner normals are computed in batches first, then gathered around each vertex.
+        std::vector<Scalar> corner_normals(static_cast<size_t>(mesh.get_num_corners()) * 3);
+        internal::compute_triangle_corner_normals(mesh, options.weight_type, {corner_normals});
+        using Vector3 = Eigen::Matrix<Scalar, 3, 1>;
+        tbb::parallel_for(Index(0), num_vertices, [&](Index vi) {
+            Vector3 n = Vector3::Zero();
+            mesh.foreach_corner_around_vertex(vi, [&](Index ci) {
+                n += Eigen::Map<const Vector3>(corner_normals.data() + static_cast<size_t>(ci) * 3);
+            });
+            normals.row(vi) = n.stableNormalized().transpose();
+        });
+    } else if (mesh.has_edges()) {
         tbb::parallel_for(Index(0), num_vertices, [&](Index vi) {
             mesh.foreach_corner_around_vertex(vi, [&](Index ci) {
                 LA_IGNORE_ARRAY_BOUNDS_BEGIN
@@ -77,14 +93,17 @@ AttributeId compute_vertex_normal(SurfaceMesh<Scalar, Index>& mesh, VertexNormal
         }
         auto corner_normals = matrix_view(mesh.template get_attribute<Scalar>(corner_normal_id));
 
-        for (Index ci = 0; ci < mesh.get_num_corners(); ci++) {
-            const Index vi = mesh.get_corner_vertex(ci);
-            normals.row(vi) += corner_normals.row(ci);
-        }
-
+        // Gather corner normals around each vertex rather than scattering them, so that vertices
+        // can be processed in parallel without atomics. Corners are visited in increasing order,
+        // which gives the same summation order as a serial scatter.
+        //
         // Note: For some reason stableNormalize() is not yet available as a vectorwise operation,
         // so we cannot simply call `vertex_normals.rowwise().stableNormalize()` and call it a day.
+        const auto vertex_corners = compute_vertex_corner_adjacency(mesh);
         tbb::parallel_for(Index(0), num_vertices, [&](Index v) {
+            for (Index ci : vertex_corners.get_neighbors(v)) {
+                normals.row(v) += corner_normals.row(ci);
+            }
             normals.row(v).stableNormalize();
         });
 
@@ -96,9 +115,53 @@ AttributeId compute_vertex_normal(SurfaceMesh<Scalar, Index>& mesh, VertexNormal
     return id;
 }
 
+template <typename Scalar, typename Index>
+AttributeId update_vertex_normal(
+    SurfaceMesh<Scalar, Index>& mesh,
+    span<const Index> modified_vertices,
+    VertexNormalOptions options)
+{
+    if (!mesh.has_attribute(options.output_attribute_name)) {
+        return compute_vertex_normal(mesh, options);
+    }
+    la_runtime_assert(mesh.get_dimension() == 3, "Only 3D meshes are supported.");
+    mesh.initialize_edges();
+
+    AttributeId id = internal::find_attribute<Scalar>(
+        mesh,
+        options.output_attribute_name,
+        Vertex,
+        AttributeUsage::Normal,
+        3);
+    auto normals = matrix_ref(mesh.template ref_attribute<Scalar>(id));
+    la_debug_assert(static_cast<Index>(normals.rows()) == mesh.get_num_vertices());
+
+    // Moving a vertex changes the corner weights and normals of every incident facet, which in
+    // turn affect the normals of all the vertices of those facets.
+    const auto facets = internal::collect_facets_around_vertices(mesh, modified_vertices);
+    const auto vertices = internal::collect_facet_vertices(mesh, span<const Index>(facets));
+    tbb::parallel_for(size_t(0), vertices.size(), [&](size_t i) {
+        const Index vi = vertices[i];
+        normals.row(vi).setZero();
+        mesh.foreach_corner_around_vertex(vi, [&](Index ci) {
+            LA_IGNORE_ARRAY_BOUNDS_BEGIN
+            normals.row(vi) +=
+                internal::compute_weighted_corner_normal(mesh, ci, options.weight_type);
+            LA_IGNORE_ARRAY_BOUNDS_END
+        });
+        normals.row(vi).stableNormalize();
+    });
+
+    return id;
+}
+
 #define LA_X_compute_vertex_normal(_, Scalar, Index)                       \
     template LA_CORE_API AttributeId compute_vertex_normal<Scalar, Index>( \
         SurfaceMesh<Scalar, Index>&,                                       \
+        VertexNormalOptions);                                              \
+    template LA_CORE_API AttributeId update_vertex_normal<Scalar, Index>(  \
+        SurfaceMesh<Scalar, Index>&,                                       \
+        span<const Index>,                                                 \
         VertexNormalOptions);
 LA_SURFACE_MESH_X(compute_vertex_normal, 0)
 
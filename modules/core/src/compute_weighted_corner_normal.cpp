@@ -9,6 +9,7 @@
  * OF ANY KIND, either express or implied. See the License for the specific language
  * governing permissions and limitations under the License.
  */
+#include <lagrange/Attribute.h>
 #include <lagrange/AttributeFwd.h>
 #include <lagrange/Logger.h>
 #include <lagrange/SurfaceMeshTypes.h>
@@ -46,6 +47,14 @@ AttributeId compute_weighted_corner_normal(
     auto normals = matrix_ref(mesh.template ref_attribute<Scalar>(id));
     la_debug_assert(static_cast<Index>(normals.rows()) == num_corners);
 
+    if (mesh.is_triangle_mesh() && mesh.get_dimension() == 3) {
+        internal::compute_triangle_corner_normals(
+            mesh,
+            options.weight_type,
+            mesh.template ref_attribute<Scalar>(id).ref_all());
+        return id;
+    }
+
     tbb::parallel_for(Index(0), num_corners, [&](Index ci) {
         LA_IGNORE_ARRAY_BOUNDS_BEGIN
         normals.row(ci) += internal::compute_weighted_corner_normal(mesh, ci, options.weight_type);
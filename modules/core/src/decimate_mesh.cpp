@@ -0,0 +1,908 @@
+/*
+ * Copyright 2024 Adobe. All rights reserved.
+ * This file is licensed to you under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License. You may obtain a copy
+ * of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under
+ * the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR REPRESENTATIONS
+ * OF ANY KIND, either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+ */
+#include <lagrange/decimate_mesh.h>
+
+#include <lagrange/Attribute.h>
+#include <lagrange/IndexedAttribute.h>
+#include <lagrange/SurfaceMeshTypes.h>
+#include <lagrange/compute_seam_edges.h>
+#include <lagrange/internal/visit_attribute.h>
+#include <lagrange/topology.h>
+#include <lagrange/utils/Error.h>
+#include <lagrange/utils/SmallVector.h>
+#include <lagrange/utils/assert.h>
+
+// clang-format off
+#include <lagrange/utils/warnoff.h>
+#include <tbb/parallel_for.h>
+#include <tbb/parallel_sort.h>
+#include <lagrange/utils/warnon.h>
+// clang-format on
+
+#include <Eigen/Geometry>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <tuple>
+
+namespace lagrange {
+
+namespace {
+
+/// Weight of the constraint planes added along boundary and seam edges.
+constexpr double s_constraint_weight = 10.0;
+
+/// Fraction of the cheapest candidate collapses considered at each round.
+constexpr double s_round_fraction = 0.25;
+
+///
+/// Symmetric 4x4 error quadric, stored as the upper triangle of the matrix, along with the total
+/// area of the facet planes it accumulates.
+///
+struct Quadric
+{
+    std::array<double, 10> q = {};
+    double area = 0;
+
+    static Quadric from_plane(const Eigen::Vector3d& n, double d, double weight)
+    {
+        Quadric res;
+        res.q = {
+            n.x() * n.x(),
+            n.x() * n.y(),
+            n.x() * n.z(),
+            n.x() * d,
+            n.y() * n.y(),
+            n.y() * n.z(),
+            n.y() * d,
+            n.z() * n.z(),
+            n.z() * d,
+            d * d};
+        for (auto& x : res.q) x *= weight;
+        return res;
+    }
+
+    Quadric& operator+=(const Quadric& other)
+    {
+        for (size_t i = 0; i < q.size(); ++i) q[i] += other.q[i];
+        area += other.area;
+        return *this;
+    }
+
+    double evaluate(const Eigen::Vector3d& p) const
+    {
+        const double x = p.x();
+        const double y = p.y();
+        const double z = p.z();
+        return q[0] * x * x + 2 * q[1] * x * y + 2 * q[2] * x * z + 2 * q[3] * x + q[4] * y * y +
+               2 * q[5] * y * z + 2 * q[6] * y + q[7] * z * z + 2 * q[8] * z + q[9];
+    }
+};
+
+///
+/// Attribute whose deviation contributes to the collapse cost.
+///
+struct CostAttribute
+{
+    /// Slot of the attribute in the list of indexed attributes, or invalid for vertex attributes.
+    size_t indexed_slot = invalid<size_t>();
+
+    size_t num_channels = 0;
+
+    /// Attribute values converted to double.
+    std::vector<double> values;
+
+    double squared_distance(size_t i, size_t j) const
+    {
+        double d2 = 0;
+        for (size_t k = 0; k < num_channels; ++k) {
+            const double d = values[i * num_channels + k] - values[j * num_channels + k];
+            d2 += d * d;
+        }
+        return d2;
+    }
+};
+
+///
+/// Mapping between the attribute indices of the corners around a collapsed vertex and the
+/// indices of the corners around the vertex it is merged into.
+///
+template <typename Index>
+struct IndexMap
+{
+    std::array<std::pair<Index, Index>, 2> pairs;
+    size_t size = 0;
+
+    const std::pair<Index, Index>* find(Index key) const
+    {
+        for (size_t i = 0; i < size; ++i) {
+            if (pairs[i].first == key) return &pairs[i];
+        }
+        return nullptr;
+    }
+};
+
+///
+/// Decimation state of a single mesh. The mesh connectivity is only written back at the end.
+///
+template <typename Scalar, typename Index>
+class MeshDecimator
+{
+public:
+    using MeshType = SurfaceMesh<Scalar, Index>;
+    using NeighborList = SmallVector<std::pair<Index, Index>, 32>;
+    using IndexMapList = SmallVector<IndexMap<Index>, 8>;
+
+    struct Candidate
+    {
+        Index target = invalid<Index>();
+        double cost = std::numeric_limits<double>::infinity();
+    };
+
+public:
+    MeshDecimator(MeshType& mesh, const DecimationOptions& options)
+        : m_mesh(mesh)
+        , m_had_edges(mesh.has_edges())
+        , m_lock_boundary(options.lock_boundary)
+        , m_attribute_weight(options.attribute_weight)
+        , m_max_error_sq(options.max_error * options.max_error)
+    {
+        const Index num_vertices = mesh.get_num_vertices();
+        const Index num_facets = mesh.get_num_facets();
+        const Index dim = mesh.get_dimension();
+        la_runtime_assert(
+            num_facets == 0 || mesh.is_triangle_mesh(),
+            "Input must be a triangle mesh");
+        la_runtime_assert(dim == 2 || dim == 3, "Input must be a 2D or 3D mesh");
+
+        // Positions, normalized once the bounding box of all meshes is known
+        m_positions.assign(num_vertices, Eigen::Vector3d::Zero());
+        for (Index v = 0; v < num_vertices; ++v) {
+            auto p = mesh.get_position(v);
+            for (Index k = 0; k < dim; ++k) m_positions[v][k] = static_cast<double>(p[k]);
+        }
+
+        // Facets
+        m_facets.resize(num_facets);
+        m_facet_removed.assign(num_facets, 0);
+        m_vertex_facets.resize(num_vertices);
+        for (Index f = 0; f < num_facets; ++f) {
+            auto fv = mesh.get_facet_vertices(f);
+            m_facets[f] = {fv[0], fv[1], fv[2]};
+            for (Index v : fv) m_vertex_facets[v].push_back(f);
+        }
+        m_vertex_locked.assign(num_vertices, 0);
+        m_vertex_removed.assign(num_vertices, 0);
+        m_num_facets = num_facets;
+        if (num_facets == 0) return;
+
+        // Non-manifold vertices and edges are never collapsed
+        {
+            VertexManifoldOptions manifold_options;
+            manifold_options.output_attribute_name = "@decimate_vertex_is_manifold";
+            auto id = compute_vertex_is_manifold(mesh, manifold_options);
+            auto is_manifold = mesh.template get_attribute<uint8_t>(id).get_all();
+            for (Index v = 0; v < num_vertices; ++v) {
+                m_vertex_locked[v] = !is_manifold[v];
+            }
+            mesh.delete_attribute(manifold_options.output_attribute_name);
+        }
+        std::vector<Index> edge_valence(mesh.get_num_edges());
+        for (Index e = 0; e < mesh.get_num_edges(); ++e) {
+            edge_valence[e] = mesh.count_num_corners_around_edge(e);
+            if (edge_valence[e] > 2) {
+                for (Index v : mesh.get_edge_vertices(e)) m_vertex_locked[v] = 1;
+            }
+        }
+
+        // Seams of all indexed attributes. Their corner indices are copied so they can be remapped
+        // as vertices are collapsed.
+        mesh.seq_foreach_attribute_id([&](AttributeId id) {
+            if (mesh.get_attribute_base(id).get_element_type() == AttributeElement::Indexed) {
+                m_indexed_ids.push_back(id);
+            }
+        });
+        std::vector<uint8_t> is_seam(mesh.get_num_edges(), 0);
+        for (AttributeId id : m_indexed_ids) {
+            SeamEdgesOptions seam_options;
+            seam_options.output_attribute_name = "@decimate_seam_edges";
+            auto seam_id = compute_seam_edges(mesh, id, seam_options);
+            auto seam = mesh.template get_attribute<uint8_t>(seam_id).get_all();
+            for (size_t e = 0; e < seam.size(); ++e) is_seam[e] |= seam[e];
+            mesh.delete_attribute(seam_options.output_attribute_name);
+
+            internal::visit_attribute_read(mesh, id, [&](auto&& attr) {
+                using AttributeType = std::decay_t<decltype(attr)>;
+                if constexpr (AttributeType::IsIndexed) {
+                    auto indices = attr.indices().get_all();
+                    m_corner_values.emplace_back(indices.begin(), indices.end());
+                }
+            });
+        }
+
+        // Boundary and seam edges get additional constraint planes
+        for (Index e = 0; e < mesh.get_num_edges(); ++e) {
+            if (edge_valence[e] > 2 || (edge_valence[e] == 2 && !is_seam[e])) continue;
+            mesh.foreach_corner_around_edge(e, [&](Index c) {
+                const Index f = mesh.get_corner_facet(c);
+                const Index v0 = mesh.get_corner_vertex(c);
+                const Index v1 = mesh.get_corner_vertex(mesh.get_next_corner_around_facet(c));
+                m_constraint_edges.push_back({v0, v1, f});
+            });
+        }
+
+        // Attributes contributing to the collapse cost
+        std::vector<AttributeId> cost_ids = options.attribute_ids;
+        if (cost_ids.empty()) {
+            mesh.seq_foreach_attribute_id([&](std::string_view name, AttributeId id) {
+                if (mesh.attr_name_is_reserved(name)) return;
+                const auto& attr = mesh.get_attribute_base(id);
+                const auto element = attr.get_element_type();
+                const auto usage = attr.get_usage();
+                const auto value_type = attr.get_value_type();
+                if ((element == AttributeElement::Vertex || element == AttributeElement::Indexed) &&
+                    (usage == AttributeUsage::UV || usage == AttributeUsage::Normal ||
+                     usage == AttributeUsage::Color) &&
+                    (value_type == AttributeValueType::e_float ||
+                     value_type == AttributeValueType::e_double)) {
+                    cost_ids.push_back(id);
+                }
+            });
+        }
+        for (AttributeId id : cost_ids) {
+            add_cost_attribute(id);
+        }
+    }
+
+    /// Bounding box of the input vertices.
+    Eigen::AlignedBox3d compute_bbox() const
+    {
+        Eigen::AlignedBox3d bbox;
+        for (const auto& p : m_positions) bbox.extend(p);
+        return bbox;
+    }
+
+    ///
+    /// Normalizes vertex positions and computes the initial vertex quadrics.
+    ///
+    void initialize(
+        const Eigen::Vector3d& origin,
+        double scale,
+        double error_weight,
+        size_t min_facets)
+    {
+        m_error_weight = error_weight;
+        m_min_facets = min_facets;
+        tbb::parallel_for(size_t(0), m_positions.size(), [&](size_t v) {
+            m_positions[v] = (m_positions[v] - origin) * scale;
+        });
+
+        const Index num_vertices = static_cast<Index>(m_positions.size());
+        const Index num_facets = static_cast<Index>(m_facets.size());
+        std::vector<Quadric> facet_quadrics(num_facets);
+        tbb::parallel_for(Index(0), num_facets, [&](Index f) {
+            Eigen::Vector3d n = facet_normal(m_facets[f]);
+            const double double_area = n.norm();
+            if (double_area > 0) {
+                n /= double_area;
+                const double d = -n.dot(m_positions[m_facets[f][0]]);
+                facet_quadrics[f] = Quadric::from_plane(n, d, double_area / 2);
+                facet_quadrics[f].area = double_area / 2;
+            }
+        });
+
+        m_quadrics.assign(num_vertices, Quadric());
+        tbb::parallel_for(Index(0), num_vertices, [&](Index v) {
+            for (Index f : m_vertex_facets[v]) m_quadrics[v] += facet_quadrics[f];
+        });
+
+        for (const auto& [v0, v1, f] : m_constraint_edges) {
+            const Eigen::Vector3d e = m_positions[v1] - m_positions[v0];
+            Eigen::Vector3d n = e.cross(facet_normal(m_facets[f]));
+            const double norm = n.norm();
+            if (norm == 0) continue;
+            n /= norm;
+            Quadric quadric = Quadric::from_plane(
+                n,
+                -n.dot(m_positions[v0]),
+                s_constraint_weight * e.squaredNorm());
+            m_quadrics[v0] += quadric;
+            m_quadrics[v1] += quadric;
+        }
+
+        m_candidates.assign(num_vertices, Candidate());
+        m_dirty.assign(num_vertices, 1);
+        m_marks.assign(num_vertices, 0);
+    }
+
+    size_t get_num_facets() const { return m_num_facets; }
+
+    size_t get_min_facets() const { return m_min_facets; }
+
+    /// Recomputes the best collapse of every vertex whose neighborhood changed.
+    void update_candidates()
+    {
+        tbb::parallel_for(size_t(0), m_candidates.size(), [&](size_t v) {
+            if (!m_dirty[v]) return;
+            m_candidates[v] = evaluate(static_cast<Index>(v));
+            m_dirty[v] = 0;
+        });
+    }
+
+    template <typename Func>
+    void foreach_candidate(Func&& func) const
+    {
+        for (size_t v = 0; v < m_candidates.size(); ++v) {
+            if (m_candidates[v].target != invalid<Index>()) {
+                func(static_cast<Index>(v), m_candidates[v]);
+            }
+        }
+    }
+
+    ///
+    /// Reserves the neighborhood of a collapse for the current round.
+    ///
+    /// @return     Number of facets removed by the collapse, or 0 if the collapse is no longer
+    ///             valid, conflicts with a collapse already scheduled for this round, or would go
+    ///             below the facet budget.
+    ///
+    Index try_schedule(Index u, Index v)
+    {
+        // A collapse modifies the closed 1-ring of u, and its validity depends on the 1-ring of
+        // v. Two collapses can run concurrently as long as the region modified by one does not
+        // intersect the region read by the other.
+        SmallVector<Index, 32> modified;
+        SmallVector<Index, 32> read;
+        Index num_shared = 0;
+        for (Index f : m_vertex_facets[u]) {
+            for (Index x : m_facets[f]) modified.push_back(x);
+            num_shared += has_vertex(f, v);
+        }
+        for (Index f : m_vertex_facets[v]) {
+            for (Index x : m_facets[f]) read.push_back(x);
+        }
+        if (m_num_facets - m_num_pending < m_min_facets + num_shared) return 0;
+        for (Index x : modified) {
+            if (m_marks[x] != 0) return 0;
+        }
+        for (Index x : read) {
+            if (m_marks[x] == s_modified) return 0;
+        }
+
+        // Only the 1-ring of a collapse is re-evaluated, so the candidate may have been
+        // invalidated by a collapse further away.
+        NeighborList neighbors;
+        get_neighbors(u, neighbors);
+        if (!std::isfinite(compute_cost(u, v, num_shared, neighbors, 0))) {
+            m_dirty[u] = 1;
+            return 0;
+        }
+
+        for (Index x : read) {
+            if (m_marks[x] == 0) m_marked.push_back(x);
+            m_marks[x] = s_read;
+        }
+        for (Index x : modified) {
+            if (m_marks[x] == 0) m_marked.push_back(x);
+            m_marks[x] = s_modified;
+        }
+        m_num_pending += num_shared;
+        return num_shared;
+    }
+
+    ///
+    /// Merges vertex u into vertex v. Collapses scheduled during the same round touch disjoint
+    /// neighborhoods, and can be applied concurrently.
+    ///
+    void collapse(Index u, Index v)
+    {
+        IndexMapList maps(m_corner_values.size());
+        for (size_t slot = 0; slot < m_corner_values.size(); ++slot) {
+            la_runtime_assert(
+                map_indices(slot, u, v, maps[slot]),
+                "Invalid collapse: attribute seam mapping failed");
+        }
+        for (Index f : m_vertex_facets[u]) {
+            auto& facet = m_facets[f];
+            const Index lu = local_index(f, u);
+            const Index lv = local_index(f, v);
+            if (lv != invalid<Index>()) {
+                m_facet_removed[f] = 1;
+                const Index w = facet[3 - lu - lv];
+                remove_from(m_vertex_facets[w], f);
+                remove_from(m_vertex_facets[v], f);
+            } else {
+                for (size_t slot = 0; slot < m_corner_values.size(); ++slot) {
+                    auto& value = m_corner_values[slot][3 * static_cast<size_t>(f) + lu];
+                    const auto* pair = maps[slot].find(value);
+                    la_runtime_assert(pair != nullptr, "Invalid collapse: unmapped corner value");
+                    value = pair->second;
+                }
+                facet[lu] = v;
+                m_vertex_facets[v].push_back(f);
+            }
+        }
+        m_vertex_facets[u] = {};
+        m_vertex_removed[u] = 1;
+        m_quadrics[v] += m_quadrics[u];
+    }
+
+    ///
+    /// Flags the candidates whose cost is affected by a collapse for re-evaluation. Those are the
+    /// vertices whose facets changed, and the vertices adjacent to v, whose quadric changed.
+    ///
+    void mark_dirty(Index u, Index v)
+    {
+        m_candidates[u] = Candidate();
+        for (Index f : m_vertex_facets[v]) {
+            for (Index x : m_facets[f]) m_dirty[x] = 1;
+        }
+    }
+
+    /// Clears the reservations of the current round.
+    void end_round()
+    {
+        for (Index x : m_marked) m_marks[x] = 0;
+        m_marked.clear();
+        m_num_facets -= m_num_pending;
+        m_num_collapsed_facets += m_num_pending;
+        m_num_pending = 0;
+    }
+
+    /// Writes the decimated connectivity back to the mesh.
+    void finalize()
+    {
+        if (m_num_collapsed_facets > 0) {
+            if (m_mesh.has_edges()) m_mesh.clear_edges();
+            auto corner_to_vertex = m_mesh.ref_corner_to_vertex().ref_all();
+            tbb::parallel_for(size_t(0), m_facets.size(), [&](size_t f) {
+                for (size_t k = 0; k < 3; ++k) corner_to_vertex[3 * f + k] = m_facets[f][k];
+            });
+            for (size_t slot = 0; slot < m_indexed_ids.size(); ++slot) {
+                internal::visit_attribute_write(m_mesh, m_indexed_ids[slot], [&](auto&& attr) {
+                    using AttributeType = std::decay_t<decltype(attr)>;
+                    if constexpr (AttributeType::IsIndexed) {
+                        auto indices = attr.indices().ref_all();
+                        std::copy(
+                            m_corner_values[slot].begin(),
+                            m_corner_values[slot].end(),
+                            indices.begin());
+                    }
+                });
+            }
+            m_mesh.remove_facets([&](Index f) { return m_facet_removed[f] != 0; });
+            m_mesh.remove_vertices([&](Index v) { return m_vertex_removed[v] != 0; });
+        }
+        if (m_had_edges) {
+            m_mesh.initialize_edges();
+        } else if (m_mesh.has_edges()) {
+            m_mesh.clear_edges();
+        }
+    }
+
+protected:
+    void add_cost_attribute(AttributeId id)
+    {
+        internal::visit_attribute_read(m_mesh, id, [&](auto&& attr) {
+            using AttributeType = std::decay_t<decltype(attr)>;
+            using ValueType = typename AttributeType::ValueType;
+            if constexpr (!std::is_floating_point_v<ValueType>) {
+                throw Error("Decimation cost attributes must have a floating-point value type");
+            } else {
+                CostAttribute cost_attribute;
+                cost_attribute.num_channels = attr.get_num_channels();
+                span<const ValueType> values;
+                if constexpr (AttributeType::IsIndexed) {
+                    auto it = std::find(m_indexed_ids.begin(), m_indexed_ids.end(), id);
+                    la_debug_assert(it != m_indexed_ids.end());
+                    cost_attribute.indexed_slot = static_cast<size_t>(it - m_indexed_ids.begin());
+                    values = attr.values().get_all();
+                } else {
+                    if (attr.get_element_type() != AttributeElement::Vertex) {
+                        throw Error("Decimation cost attributes must be vertex or indexed");
+                    }
+                    values = attr.get_all();
+                }
+                cost_attribute.values.assign(values.begin(), values.end());
+                m_cost_attributes.push_back(std::move(cost_attribute));
+            }
+        });
+    }
+
+    Eigen::Vector3d facet_normal(const std::array<Index, 3>& facet) const
+    {
+        const auto& p0 = m_positions[facet[0]];
+        return (m_positions[facet[1]] - p0).cross(m_positions[facet[2]] - p0);
+    }
+
+    Index local_index(Index f, Index v) const
+    {
+        const auto& facet = m_facets[f];
+        for (Index k = 0; k < 3; ++k) {
+            if (facet[k] == v) return k;
+        }
+        return invalid<Index>();
+    }
+
+    bool has_vertex(Index f, Index v) const { return local_index(f, v) != invalid<Index>(); }
+
+    static void remove_from(std::vector<Index>& facets, Index f)
+    {
+        auto it = std::find(facets.begin(), facets.end(), f);
+        la_debug_assert(it != facets.end());
+        *it = facets.back();
+        facets.pop_back();
+    }
+
+    /// Lists the neighbors of a vertex, along with the number of facets shared with each of them.
+    void get_neighbors(Index u, NeighborList& neighbors) const
+    {
+        neighbors.clear();
+        for (Index f : m_vertex_facets[u]) {
+            for (Index x : m_facets[f]) {
+                if (x == u) continue;
+                auto it = std::find_if(neighbors.begin(), neighbors.end(), [&](const auto& n) {
+                    return n.first == x;
+                });
+                if (it == neighbors.end()) {
+                    neighbors.emplace_back(x, 1);
+                } else {
+                    ++it->second;
+                }
+            }
+        }
+    }
+
+    bool is_adjacent(Index v, Index x) const
+    {
+        for (Index f : m_vertex_facets[v]) {
+            if (has_vertex(f, x)) return true;
+        }
+        return false;
+    }
+
+    ///
+    /// Maps the attribute indices of the corners around u to the indices of the corners around v
+    /// on the same side of the collapsed edge.
+    ///
+    /// @return     False if the collapse would break a seam of the attribute.
+    ///
+    bool map_indices(size_t slot, Index u, Index v, IndexMap<Index>& map) const
+    {
+        const auto& values = m_corner_values[slot];
+        map.size = 0;
+        for (Index f : m_vertex_facets[u]) {
+            const Index lv = local_index(f, v);
+            if (lv == invalid<Index>()) continue;
+            const size_t c0 = 3 * static_cast<size_t>(f);
+            const Index a = values[c0 + local_index(f, u)];
+            const Index b = values[c0 + lv];
+            if (auto pair = map.find(a)) {
+                if (pair->second != b) return false;
+            } else {
+                // More than two facets around the edge (non-manifold): reject the collapse.
+                if (map.size >= map.pairs.size()) return false;
+                map.pairs[map.size++] = {a, b};
+            }
+        }
+        for (Index f : m_vertex_facets[u]) {
+            if (has_vertex(f, v)) continue;
+            if (!map.find(values[3 * static_cast<size_t>(f) + local_index(f, u)])) return false;
+        }
+        return true;
+    }
+
+    ///
+    /// Computes the part of the cost of merging u into v that does not depend on the collapse
+    /// being valid: the quadric error and the deviation of vertex attributes. It is a lower bound
+    /// of the full cost.
+    ///
+    double compute_base_cost(Index u, Index v) const
+    {
+        Quadric quadric = m_quadrics[u];
+        quadric += m_quadrics[v];
+        double cost = 0;
+        if (quadric.area > 0) {
+            cost = std::max(0.0, quadric.evaluate(m_positions[v])) / quadric.area;
+        }
+        double attribute_cost = 0;
+        for (const auto& attr : m_cost_attributes) {
+            if (attr.indexed_slot == invalid<size_t>()) {
+                attribute_cost += attr.squared_distance(u, v);
+            }
+        }
+        return cost + m_attribute_weight * attribute_cost;
+    }
+
+    ///
+    /// Checks whether u can be merged into v, and computes the full cost of the collapse.
+    ///
+    /// @return     The unweighted cost, or infinity if the collapse is not allowed.
+    ///
+    double compute_cost(
+        Index u,
+        Index v,
+        Index num_shared,
+        const NeighborList& neighbors,
+        double base_cost) const
+    {
+        constexpr double invalid_cost = std::numeric_limits<double>::infinity();
+
+        // Link condition: the only common neighbors of u and v are the opposite vertices of the
+        // collapsed edge.
+        Index num_common = 0;
+        for (const auto& n : neighbors) {
+            if (n.first != v && is_adjacent(v, n.first)) ++num_common;
+        }
+        if (num_common != num_shared) return invalid_cost;
+
+        // Opposite vertices must keep enough facets not to become degenerate
+        for (Index f : m_vertex_facets[u]) {
+            const Index lv = local_index(f, v);
+            if (lv == invalid<Index>()) continue;
+            const Index w = m_facets[f][3 - local_index(f, u) - lv];
+            if (m_vertex_facets[w].size() <= (num_shared == 2 ? 3u : 1u)) return invalid_cost;
+        }
+
+        // Seams
+        IndexMapList maps(m_corner_values.size());
+        for (size_t slot = 0; slot < m_corner_values.size(); ++slot) {
+            if (!map_indices(slot, u, v, maps[slot])) return invalid_cost;
+        }
+
+        // Facet flips
+        double total_area = 0;
+        for (Index f : m_vertex_facets[u]) {
+            if (has_vertex(f, v)) continue;
+            std::array<Index, 3> facet = m_facets[f];
+            const Eigen::Vector3d n0 = facet_normal(facet);
+            facet[local_index(f, u)] = v;
+            const Eigen::Vector3d n1 = facet_normal(facet);
+            if (!n0.isZero() && n0.dot(n1) <= 0) return invalid_cost;
+            total_area += n0.norm();
+        }
+
+        // Deviation of indexed attributes, weighted by the area of the corners facets
+        double attribute_cost = 0;
+        if (total_area > 0) {
+            for (const auto& attr : m_cost_attributes) {
+                if (attr.indexed_slot == invalid<size_t>()) continue;
+                const auto& values = m_corner_values[attr.indexed_slot];
+                const auto& map = maps[attr.indexed_slot];
+                double deviation = 0;
+                for (Index f : m_vertex_facets[u]) {
+                    if (has_vertex(f, v)) continue;
+                    const Index a = values[3 * static_cast<size_t>(f) + local_index(f, u)];
+                    const auto* pair = map.find(a);
+                    if (pair == nullptr) return invalid_cost;
+                    const Index b = pair->second;
+                    deviation += facet_normal(m_facets[f]).norm() * attr.squared_distance(a, b);
+                }
+                attribute_cost += deviation / total_area;
+            }
+        }
+        return base_cost + m_attribute_weight * attribute_cost;
+    }
+
+    /// Finds the cheapest valid collapse of a vertex into one of its neighbors.
+    Candidate evaluate(Index u) const
+    {
+        Candidate best;
+        if (m_vertex_locked[u] || m_vertex_facets[u].empty()) return best;
+
+        NeighborList neighbors;
+        get_neighbors(u, neighbors);
+        Index num_boundary_edges = 0;
+        for (const auto& n : neighbors) {
+            if (n.second > 2) return best;
+            if (n.second == 1) ++num_boundary_edges;
+        }
+
+        // Boundary vertices can only slide along the boundary
+        if (num_boundary_edges > 0 && (m_lock_boundary || num_boundary_edges != 2)) return best;
+
+        // Validity checks are the expensive part, so targets are visited by increasing lower
+        // bound of their cost, until the bound exceeds the best valid cost found so far.
+        SmallVector<std::tuple<double, Index, Index>, 32> targets;
+        for (const auto& [v, num_shared] : neighbors) {
+            if (num_boundary_edges > 0 && num_shared != 1) continue;
+            const double base_cost = compute_base_cost(u, v);
+            if (base_cost > m_max_error_sq) continue;
+            targets.emplace_back(base_cost, v, num_shared);
+        }
+        std::sort(targets.begin(), targets.end());
+        for (const auto& [base_cost, v, num_shared] : targets) {
+            if (base_cost * m_error_weight >= best.cost) break;
+            const double cost = compute_cost(u, v, num_shared, neighbors, base_cost);
+            if (!std::isfinite(cost) || cost > m_max_error_sq) continue;
+            if (cost * m_error_weight < best.cost) {
+                best.target = v;
+                best.cost = cost * m_error_weight;
+            }
+        }
+        return best;
+    }
+
+protected:
+    MeshType& m_mesh;
+    bool m_had_edges = false;
+    bool m_lock_boundary = false;
+    double m_attribute_weight = 1;
+    double m_max_error_sq = 0;
+    double m_error_weight = 1;
+    size_t m_min_facets = 0;
+
+    std::vector<Eigen::Vector3d> m_positions;
+    std::vector<std::array<Index, 3>> m_facets;
+    std::vector<std::vector<Index>> m_vertex_facets;
+    std::vector<uint8_t> m_facet_removed;
+    std::vector<uint8_t> m_vertex_removed;
+    std::vector<uint8_t> m_vertex_locked;
+    std::vector<Quadric> m_quadrics;
+
+    /// Boundary and seam edges (v0, v1, facet).
+    std::vector<std::array<Index, 3>> m_constraint_edges;
+
+    /// Indexed attributes, and a working copy of their corner indices.
+    std::vector<AttributeId> m_indexed_ids;
+    std::vector<std::vector<Index>> m_corner_values;
+
+    std::vector<CostAttribute> m_cost_attributes;
+
+    std::vector<Candidate> m_candidates;
+    std::vector<uint8_t> m_dirty;
+
+    /// Vertices reserved by collapses scheduled during the current round.
+    static constexpr uint8_t s_read = 1;
+    static constexpr uint8_t s_modified = 2;
+    std::vector<uint8_t> m_marks;
+    std::vector<Index> m_marked;
+
+    size_t m_num_facets = 0;
+    size_t m_num_pending = 0;
+    size_t m_num_collapsed_facets = 0;
+};
+
+} // namespace
+
+template <typename Scalar, typename Index>
+void decimate_meshes(
+    span<SurfaceMesh<Scalar, Index>* const> meshes,
+    const DecimationOptions& options,
+    span<const double> error_weights,
+    span<const size_t> min_num_facets)
+{
+    la_runtime_assert(error_weights.empty() || error_weights.size() == meshes.size());
+    la_runtime_assert(min_num_facets.empty() || min_num_facets.size() == meshes.size());
+    la_runtime_assert(options.max_error >= 0, "Maximum error must be non-negative");
+
+    std::vector<MeshDecimator<Scalar, Index>> decimators;
+    decimators.reserve(meshes.size());
+    Eigen::AlignedBox3d bbox;
+    size_t num_facets = 0;
+    for (auto* mesh : meshes) {
+        decimators.emplace_back(*mesh, options);
+        bbox.extend(decimators.back().compute_bbox());
+        num_facets += mesh->get_num_facets();
+    }
+
+    size_t target_num_facets = options.target_num_facets;
+    if (target_num_facets == invalid<size_t>()) {
+        la_runtime_assert(
+            options.target_facet_ratio >= 0 && options.target_facet_ratio <= 1,
+            "Target facet ratio must be in [0, 1]");
+        target_num_facets = static_cast<size_t>(
+            std::ceil(options.target_facet_ratio * static_cast<double>(num_facets)));
+    }
+
+    // Errors are measured relative to the bounding box of all meshes
+    const double diag = bbox.isEmpty() ? 0 : bbox.diagonal().norm();
+    const Eigen::Vector3d origin = bbox.isEmpty() ? Eigen::Vector3d::Zero() : bbox.min();
+    for (size_t i = 0; i < decimators.size(); ++i) {
+        const double weight = error_weights.empty() ? 1.0 : error_weights[i];
+        la_runtime_assert(weight > 0, "Error weights must be positive");
+        decimators[i].initialize(
+            origin,
+            diag > 0 ? 1 / diag : 1,
+            weight,
+            min_num_facets.empty() ? 0 : min_num_facets[i]);
+    }
+
+    struct Collapse
+    {
+        double cost;
+        size_t mesh;
+        Index u;
+        Index v;
+    };
+    auto cheaper = [](const Collapse& a, const Collapse& b) {
+        return std::tie(a.cost, a.mesh, a.u) < std::tie(b.cost, b.mesh, b.u);
+    };
+
+    std::vector<Collapse> candidates;
+    std::vector<Collapse> scheduled;
+    while (num_facets > target_num_facets) {
+        candidates.clear();
+        for (size_t i = 0; i < decimators.size(); ++i) {
+            auto& decimator = decimators[i];
+            if (decimator.get_num_facets() <= decimator.get_min_facets()) continue;
+            decimator.update_candidates();
+            decimator.foreach_candidate([&](Index u, const auto& candidate) {
+                candidates.push_back({candidate.cost, i, u, candidate.target});
+            });
+        }
+        if (candidates.empty()) break;
+
+        // Only the cheapest candidates are considered at each round, so collapses are applied in
+        // roughly increasing order of error.
+        const size_t num_considered = std::max<size_t>(
+            1,
+            static_cast<size_t>(static_cast<double>(candidates.size()) * s_round_fraction));
+        if (num_considered < candidates.size()) {
+            std::nth_element(
+                candidates.begin(),
+                candidates.begin() + static_cast<std::ptrdiff_t>(num_considered),
+                candidates.end(),
+                cheaper);
+            candidates.resize(num_considered);
+        }
+        tbb::parallel_sort(candidates.begin(), candidates.end(), cheaper);
+
+        // Greedily select collapses with disjoint neighborhoods
+        scheduled.clear();
+        size_t num_removed = 0;
+        for (const auto& c : candidates) {
+            const Index n = decimators[c.mesh].try_schedule(c.u, c.v);
+            if (n == 0) continue;
+            scheduled.push_back(c);
+            num_removed += n;
+            if (num_facets - num_removed <= target_num_facets) break;
+        }
+        if (scheduled.empty()) break;
+
+        tbb::parallel_for(size_t(0), scheduled.size(), [&](size_t i) {
+            decimators[scheduled[i].mesh].collapse(scheduled[i].u, scheduled[i].v);
+        });
+        for (const auto& c : scheduled) {
+            decimators[c.mesh].mark_dirty(c.u, c.v);
+        }
+        for (auto& decimator : decimators) {
+            decimator.end_round();
+        }
+        num_facets -= num_removed;
+    }
+
+    for (auto& decimator : decimators) {
+        decimator.finalize();
+    }
+}
+
+template <typename Scalar, typename Index>
+void decimate_mesh(SurfaceMesh<Scalar, Index>& mesh, const DecimationOptions& options)
+{
+    SurfaceMesh<Scalar, Index>* meshes[] = {&mesh};
+    decimate_meshes<Scalar, Index>(meshes, options);
+}
+
+#define LA_X_decimate_mesh(_, Scalar, Index)                   \
+    template LA_CORE_API void decimate_mesh(                   \
+        SurfaceMesh<Scalar, Index>& mesh,                      \
+        const DecimationOptions& options);                     \
+    template LA_CORE_API void decimate_meshes(                 \
+        span<SurfaceMesh<Scalar, Index>* const> meshes,        \
+        const DecimationOptions& options,                      \
+        span<const double> error_weights,                      \
+        span<const size_t> min_num_facets);
+LA_SURFACE_MESH_X(decimate_mesh, 0)
+
+} // namespace lagrange
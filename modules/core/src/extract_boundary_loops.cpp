@@ -15,7 +15,14 @@
 #include <lagrange/extract_boundary_loops.h>
 #include <lagrange/utils/chain_edges.h>
 
+// clang-format off
+#include <lagrange/utils/warnoff.h>
+#include <tbb/parallel_for.h>
+#include <lagrange/utils/warnon.h>
+// clang-format on
+
 #include <array>
+#include <numeric>
 #include <vector>
 
 namespace lagrange {
@@ -29,17 +36,21 @@ std::vector<std::vector<Index>> extract_boundary_loops(const SurfaceMesh<Scalar,
         return extract_boundary_loops(mesh_copy);
     }
 
+    // Mark boundary edges and compact them in parallel, preserving the edge order.
     const auto num_edges = mesh.get_num_edges();
-    std::vector<Index> bd_edges;
-    bd_edges.reserve(num_edges * 2);
-
-    for (Index i = 0; i < num_edges; i++) {
-        if (mesh.is_boundary_edge(i)) {
-            auto e = mesh.get_edge_vertices(i);
-            bd_edges.push_back(e[0]);
-            bd_edges.push_back(e[1]);
-        }
-    }
+    std::vector<Index> bd_offsets(num_edges + 1, 0);
+    tbb::parallel_for(Index(0), num_edges, [&](Index i) {
+        bd_offsets[i + 1] = mesh.is_boundary_edge(i) ? 1 : 0;
+    });
+    std::partial_sum(bd_offsets.begin(), bd_offsets.end(), bd_offsets.begin());
+
+    std::vector<Index> bd_edges(bd_offsets.back() * 2);
+    tbb::parallel_for(Index(0), num_edges, [&](Index i) {
+        if (bd_offsets[i] == bd_offsets[i + 1]) return;
+        auto e = mesh.get_edge_vertices(i);
+        bd_edges[bd_offsets[i] * 2] = e[0];
+        bd_edges[bd_offsets[i] * 2 + 1] = e[1];
+    });
 
     auto result = chain_directed_edges<Index>({bd_edges.data(), bd_edges.size()});
     const auto& loops = result.loops;
@@ -14,6 +14,7 @@
 #include <lagrange/SurfaceMeshTypes.h>
 #include <lagrange/extract_submesh.h>
 #include <lagrange/foreach_attribute.h>
+#include <lagrange/internal/extract_submesh.h>
 #include <lagrange/internal/map_attributes.h>
 #include <lagrange/views.h>
 
@@ -22,19 +23,25 @@
 
 namespace lagrange {
 
+namespace internal {
+
 template <typename Scalar, typename Index>
 SurfaceMesh<Scalar, Index> extract_submesh(
     const SurfaceMesh<Scalar, Index>& mesh,
     span<const Index> selected_facets,
-    const SubmeshOptions& options)
+    const SubmeshOptions& options,
+    SubmeshScratch<Index>& scratch,
+    bool compact_indexed_values)
 {
     SurfaceMesh<Scalar, Index> output_mesh(mesh.get_dimension());
 
     // Compute vertex mapping.
     const auto num_vertices = mesh.get_num_vertices();
-    std::vector<Index> vertex_old2new(num_vertices, invalid<Index>());
+    auto& vertex_old2new = scratch.vertex_old2new;
+    if (vertex_old2new.size() < num_vertices) {
+        vertex_old2new.resize(num_vertices, invalid<Index>());
+    }
     std::vector<Index> vertex_new2old;
-    vertex_new2old.reserve(num_vertices);
 
     for (auto fid : selected_facets) {
         auto f = mesh.get_facet_vertices(fid);
@@ -145,10 +152,37 @@ SurfaceMesh<Scalar, Index> extract_submesh(
                 attr.get_usage(),
                 attr.get_num_channels());
             auto& target_attr = output_mesh.template ref_indexed_attribute<ValueType>(id);
-            target_attr.values() = values;
             auto& target_indices = target_attr.indices();
+            if (!compact_indexed_values) {
+                target_attr.values() = values;
+                for (Index ci = 0; ci < num_corners; ci++) {
+                    target_indices.ref(ci) = indices.get(corner_mapping[ci]);
+                }
+                return;
+            }
+
+            // Only keep values referenced by the submesh.
+            auto& value_old2new = scratch.value_old2new;
+            if (value_old2new.size() < values.get_num_elements()) {
+                value_old2new.resize(values.get_num_elements(), invalid<Index>());
+            }
+            std::vector<Index> value_new2old;
             for (Index ci = 0; ci < num_corners; ci++) {
-                target_indices.ref(ci) = indices.get(corner_mapping[ci]);
+                const Index i = indices.get(corner_mapping[ci]);
+                if (value_old2new[i] == invalid<Index>()) {
+                    value_old2new[i] = static_cast<Index>(value_new2old.size());
+                    value_new2old.push_back(i);
+                }
+                target_indices.ref(ci) = value_old2new[i];
+            }
+
+            auto& target_values = target_attr.values();
+            target_values.resize_elements(value_new2old.size());
+            auto source_data = matrix_view(values);
+            auto target_data = matrix_ref(target_values);
+            for (size_t i = 0; i < value_new2old.size(); i++) {
+                target_data.row(i) = source_data.row(value_new2old[i]);
+                value_old2new[value_new2old[i]] = invalid<Index>();
             }
         });
 
@@ -164,15 +198,44 @@ SurfaceMesh<Scalar, Index> extract_submesh(
         }
     }
 
+    // Leave scratch buffers ready for the next extraction.
+    for (Index vid : vertex_new2old) {
+        vertex_old2new[vid] = invalid<Index>();
+    }
+
     return output_mesh;
 }
 
+} // namespace internal
+
+template <typename Scalar, typename Index>
+SurfaceMesh<Scalar, Index> extract_submesh(
+    const SurfaceMesh<Scalar, Index>& mesh,
+    span<const Index> selected_facets,
+    const SubmeshOptions& options)
+{
+    internal::SubmeshScratch<Index> scratch;
+    constexpr bool compact_indexed_values = false;
+    return internal::extract_submesh(
+        mesh,
+        selected_facets,
+        options,
+        scratch,
+        compact_indexed_values);
+}
+
 
-#define LA_X_extract_submesh(_, Scalar, Index)                           \
-    template LA_CORE_API SurfaceMesh<Scalar, Index> extract_submesh(                 \
-        const SurfaceMesh<Scalar, Index>&,                               \
-        span<const Index>,                                               \
-        const SubmeshOptions&);
+#define LA_X_extract_submesh(_, Scalar, Index)                                \
+    template LA_CORE_API SurfaceMesh<Scalar, Index> extract_submesh(           \
+        const SurfaceMesh<Scalar, Index>&,                                    \
+        span<const Index>,                                                    \
+        const SubmeshOptions&);                                               \
+    template LA_CORE_API SurfaceMesh<Scalar, Index> internal::extract_submesh( \
+        const SurfaceMesh<Scalar, Index>&,                                    \
+        span<const Index>,                                                    \
+        const SubmeshOptions&,                                                \
+        internal::SubmeshScratch<Index>&,                                     \
+        bool);
 
 LA_SURFACE_MESH_X(extract_submesh, 0)
 
@@ -14,6 +14,14 @@
 #include <lagrange/internal/invert_mapping.h>
 #include <lagrange/utils/DisjointSets.h>
 
+// clang-format off
+#include <lagrange/utils/warnoff.h>
+#include <tbb/parallel_for.h>
+#include <lagrange/utils/warnon.h>
+// clang-format on
+
+#include <algorithm>
+#include <atomic>
 #include <numeric>
 
 namespace lagrange::internal {
@@ -133,4 +141,64 @@ bucket_sort(std::vector<Index>& elements, Index num_buckets, Function get_repres
     return result;
 }
 
+///
+/// Perform a parallel bucket sort over a range of elements. Elements are scattered into their
+/// bucket concurrently, and each bucket is then sorted in parallel, so the output is identical to
+/// the serial `bucket_sort()`: elements of a bucket appear in increasing order.
+///
+/// Besides the output, the transient memory is one atomic counter per bucket.
+///
+/// @param[in,out] elements            Elements to sort. Only the size of the input vector is used
+///                                    (number of elements to sort).
+/// @param[in]     num_buckets         Number of buckets.
+/// @param[in]     get_representative  Function to get the representative bucket for a given
+///                                    element. Elements mapped to `invalid<Index>()` are skipped.
+///                                    Must be safe to call from multiple threads.
+///
+/// @tparam        Index               Index type.
+/// @tparam        Function            Callback function type.
+///
+/// @return        Info about the sorted buckets.
+///
+template <typename Index, typename Function>
+BucketSortOffset<Index>
+parallel_bucket_sort(std::vector<Index>& elements, Index num_buckets, Function get_representative)
+{
+    const Index num_elements = static_cast<Index>(elements.size());
+    BucketSortOffset<Index> result;
+    result.num_representatives = num_buckets;
+    auto& offsets = result.representative_offsets;
+
+    // Count elements in each bucket
+    std::vector<std::atomic<Index>> cursor(num_buckets);
+    tbb::parallel_for(Index(0), num_buckets, [&](Index b) {
+        cursor[b].store(0, std::memory_order_relaxed);
+    });
+    tbb::parallel_for(Index(0), num_elements, [&](Index i) {
+        const Index b = get_representative(i);
+        if (b == invalid<Index>()) return;
+        la_debug_assert(b < num_buckets);
+        cursor[b].fetch_add(1, std::memory_order_relaxed);
+    });
+    offsets.resize(size_t(num_buckets) + 1);
+    offsets[0] = 0;
+    for (Index b = 0; b < num_buckets; ++b) {
+        offsets[b + 1] = offsets[b] + cursor[b].load(std::memory_order_relaxed);
+        cursor[b].store(offsets[b], std::memory_order_relaxed);
+    }
+
+    // Scatter elements, then restore a deterministic order within each bucket
+    elements.resize(offsets.back());
+    tbb::parallel_for(Index(0), num_elements, [&](Index i) {
+        const Index b = get_representative(i);
+        if (b == invalid<Index>()) return;
+        elements[cursor[b].fetch_add(1, std::memory_order_relaxed)] = i;
+    });
+    tbb::parallel_for(Index(0), num_buckets, [&](Index b) {
+        std::sort(elements.begin() + offsets[b], elements.begin() + offsets[b + 1]);
+    });
+
+    return result;
+}
+
 } // namespace lagrange::internal
@@ -10,7 +10,9 @@
  * governing permissions and limitations under the License.
  */
 #include "compute_weighted_corner_normal.h"
+#include "triangle_batch.h"
 
+#include <lagrange/Attribute.h>
 #include <lagrange/SurfaceMeshTypes.h>
 #include <lagrange/utils/Error.h>
 #include <lagrange/utils/assert.h>
@@ -18,6 +20,8 @@
 
 #include <Eigen/Dense>
 
+#include <cmath>
+
 namespace lagrange::internal {
 
 template <typename Scalar, typename Index>
@@ -62,11 +66,69 @@ Eigen::Matrix<Scalar, 3, 1> compute_weighted_corner_normal(
     }
 }
 
+template <typename Scalar, typename Index>
+void compute_triangle_corner_normals(
+    const SurfaceMesh<Scalar, Index>& mesh,
+    NormalWeightingType weighting,
+    span<Scalar> normals)
+{
+    la_debug_assert(mesh.get_dimension() == 3, "Only 3D meshes are supported.");
+    la_debug_assert(mesh.is_triangle_mesh());
+    la_debug_assert(normals.size() == static_cast<size_t>(mesh.get_num_corners()) * 3);
+
+    const Scalar* positions = mesh.get_vertex_to_position().get_all().data();
+    const Index* corner_to_vertex = mesh.get_corner_to_vertex().get_all().data();
+    par_foreach_batch(
+        mesh.get_num_facets(),
+        std::optional<span<const Index>>(),
+        [&](const auto& ids, Eigen::Index count) {
+            PointBatch<Scalar> p[3];
+            for (Index k = 0; k < 3; ++k) {
+                p[k] = gather_points(positions, 3, count, [&](Eigen::Index i) {
+                    return corner_to_vertex[static_cast<size_t>(ids[i]) * 3 + k];
+                });
+            }
+            for (Index k = 0; k < 3; ++k) {
+                const auto e_next = p[(k + 1) % 3] - p[k];
+                const auto e_prev = p[(k + 2) % 3] - p[k];
+                auto n = cross(e_next, e_prev);
+                switch (weighting) {
+                case NormalWeightingType::Uniform: stable_normalize(n); break;
+                case NormalWeightingType::CornerTriangleArea: break;
+                case NormalWeightingType::Angle: {
+                    const BatchLanes<Scalar> l = norm(n);
+                    const BatchLanes<Scalar> d = dot(e_next, e_prev);
+                    BatchLanes<Scalar> theta;
+                    for (Eigen::Index i = 0; i < batch_size; ++i) {
+                        theta[i] = std::atan2(l[i], d[i]);
+                    }
+                    stable_normalize(n);
+                    n.x *= theta;
+                    n.y *= theta;
+                    n.z *= theta;
+                    break;
+                }
+                default: throw Error("Unsupported weighting type detected.");
+                }
+                for (Eigen::Index i = 0; i < count; ++i) {
+                    const size_t ci = static_cast<size_t>(ids[i]) * 3 + k;
+                    normals[ci * 3] = n.x[i];
+                    normals[ci * 3 + 1] = n.y[i];
+                    normals[ci * 3 + 2] = n.z[i];
+                }
+            }
+        });
+}
+
 #define LA_X_compute_weighted_corner_normal(_, Scalar, Index)                           \
     template Eigen::Matrix<Scalar, 3, 1> compute_weighted_corner_normal<Scalar, Index>( \
         SurfaceMesh<Scalar, Index>&,                                                    \
         Index,                                                                          \
-        NormalWeightingType);
+        NormalWeightingType);                                                           \
+    template void compute_triangle_corner_normals<Scalar, Index>(                       \
+        const SurfaceMesh<Scalar, Index>&,                                              \
+        NormalWeightingType,                                                            \
+        span<Scalar>);
 LA_SURFACE_MESH_X(compute_weighted_corner_normal, 0)
 
 } // namespace lagrange::internal
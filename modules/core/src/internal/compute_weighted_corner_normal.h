@@ -13,6 +13,7 @@
 
 #include <lagrange/NormalWeightingType.h>
 #include <lagrange/SurfaceMesh.h>
+#include <lagrange/utils/span.h>
 
 #include <Eigen/Core>
 
@@ -33,4 +34,18 @@ Eigen::Matrix<Scalar, 3, 1> compute_weighted_corner_normal(
     Index ci,
     NormalWeightingType weighting = NormalWeightingType::CornerTriangleArea);
 
+/**
+ * Compute the weighted normals of all corners of a 3D triangle mesh. Facets are processed in
+ * batches, with vertex positions gathered in SoA form.
+ *
+ * @param[in]  mesh       The input triangle mesh.
+ * @param[in]  weighting  The weighting type.
+ * @param[out] normals    Output corner normals, stored row by row (3 * #C values).
+ */
+template <typename Scalar, typename Index>
+void compute_triangle_corner_normals(
+    const SurfaceMesh<Scalar, Index>& mesh,
+    NormalWeightingType weighting,
+    span<Scalar> normals);
+
 } // namespace lagrange::internal
@@ -11,13 +11,25 @@
  */
 #include <lagrange/internal/dijkstra.h>
 
+#include <algorithm>
+#include <atomic>
 #include <limits>
+#include <map>
 #include <queue>
 #include <vector>
 
 #include <lagrange/SurfaceMeshTypes.h>
 #include <lagrange/utils/assert.h>
 
+// clang-format off
+#include <lagrange/utils/warnoff.h>
+#include <tbb/blocked_range.h>
+#include <tbb/enumerable_thread_specific.h>
+#include <tbb/parallel_for.h>
+#include <tbb/parallel_sort.h>
+#include <lagrange/utils/warnon.h>
+// clang-format on
+
 namespace lagrange::internal {
 
 template <typename Scalar, typename Index>
@@ -85,6 +97,178 @@ void dijkstra(
     }
 }
 
+template <typename Scalar, typename Index>
+void dijkstra(
+    const AdjacencyList<Index>& adjacency,
+    span<const Index> seed_vertices,
+    span<const Scalar> seed_vertex_dist,
+    Scalar radius,
+    const function_ref<Scalar(Index, Index)>& dist,
+    const function_ref<bool(Index, Scalar)>& process)
+{
+    if (radius <= 0) {
+        radius = std::numeric_limits<Scalar>::max();
+    }
+
+    const auto num_vertices = static_cast<Index>(adjacency.get_num_entries());
+
+    using Entry = std::pair<Scalar, Index>;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> Q;
+    std::vector<bool> visited(num_vertices, false);
+
+    size_t num_seeds = seed_vertices.size();
+    la_runtime_assert(num_seeds == seed_vertex_dist.size());
+    for (size_t i = 0; i < num_seeds; i++) {
+        la_runtime_assert(seed_vertices[i] < num_vertices);
+        Q.push({seed_vertex_dist[i], seed_vertices[i]});
+    }
+
+    while (!Q.empty()) {
+        Entry entry = Q.top();
+        Q.pop();
+
+        Index vi = entry.second;
+        Scalar di = entry.first;
+
+        if (visited[vi]) continue;
+
+        bool done = process(vi, di);
+        if (done) break;
+        visited[vi] = true;
+
+        for (Index vj : adjacency.get_neighbors(vi)) {
+            if (visited[vj]) continue;
+            Scalar dj = di + dist(vi, vj);
+            if (dj < radius) {
+                Q.push({dj, vj});
+            }
+        }
+    }
+}
+
+namespace {
+
+/// Atomically replace `target` by `value` if `value` is smaller. Returns true if it was replaced.
+template <typename Scalar>
+bool atomic_fetch_min(std::atomic<Scalar>& target, Scalar value)
+{
+    Scalar current = target.load(std::memory_order_relaxed);
+    while (value < current) {
+        if (target.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace
+
+template <typename Scalar, typename Index>
+void delta_stepping(
+    const AdjacencyList<Index>& adjacency,
+    span<const Index> seed_vertices,
+    span<const Scalar> seed_vertex_dist,
+    Scalar radius,
+    Scalar delta,
+    const function_ref<Scalar(Index, Index)>& dist,
+    span<Scalar> distances)
+{
+    if (radius <= 0) {
+        radius = std::numeric_limits<Scalar>::max();
+    }
+    la_runtime_assert(delta > 0, "Delta-stepping bucket width must be positive");
+
+    const auto num_vertices = static_cast<Index>(adjacency.get_num_entries());
+    la_runtime_assert(distances.size() == num_vertices);
+
+    constexpr Scalar unreached = std::numeric_limits<Scalar>::infinity();
+    std::vector<std::atomic<Scalar>> tentative(num_vertices);
+    tbb::parallel_for(Index(0), num_vertices, [&](Index v) {
+        tentative[v].store(unreached, std::memory_order_relaxed);
+    });
+
+    // Bucket indices are clamped so that a tiny delta or a huge distance cannot overflow.
+    constexpr size_t max_bucket = std::numeric_limits<size_t>::max() / 2;
+    auto bucket_of = [&](Scalar d) {
+        const Scalar b = d / delta;
+        return b < static_cast<Scalar>(max_bucket) ? static_cast<size_t>(b) : max_bucket;
+    };
+
+    // Buckets are stored sparsely, keyed by bucket index, so that memory only grows with the
+    // number of non-empty buckets, whatever the ratio between distances and delta. Buckets may
+    // contain stale entries: vertices whose tentative distance has since been lowered into an
+    // earlier bucket. They are discarded when the bucket is processed.
+    std::map<size_t, std::vector<Index>> buckets;
+    auto add_to_bucket = [&](Index v, size_t b) { buckets[b].push_back(v); };
+
+    size_t num_seeds = seed_vertices.size();
+    la_runtime_assert(num_seeds == seed_vertex_dist.size());
+    for (size_t i = 0; i < num_seeds; i++) {
+        la_runtime_assert(seed_vertices[i] < num_vertices);
+        if (atomic_fetch_min(tentative[seed_vertices[i]], seed_vertex_dist[i])) {
+            add_to_bucket(seed_vertices[i], bucket_of(seed_vertex_dist[i]));
+        }
+    }
+
+    tbb::enumerable_thread_specific<std::vector<Index>> updated_vertices;
+    std::vector<Index> frontier;
+    while (!buckets.empty()) {
+        const size_t b = buckets.begin()->first;
+        frontier.clear();
+        frontier.swap(buckets.begin()->second);
+        buckets.erase(buckets.begin());
+
+        // Relaxing edges may lower vertices into the current bucket, which then need to be
+        // processed again. Iterate until the bucket is settled.
+        while (!frontier.empty()) {
+            tbb::parallel_sort(frontier.begin(), frontier.end());
+            frontier.erase(std::unique(frontier.begin(), frontier.end()), frontier.end());
+            frontier.erase(
+                std::remove_if(
+                    frontier.begin(),
+                    frontier.end(),
+                    [&](Index v) {
+                        return bucket_of(tentative[v].load(std::memory_order_relaxed)) != b;
+                    }),
+                frontier.end());
+
+            tbb::parallel_for(
+                tbb::blocked_range<size_t>(0, frontier.size()),
+                [&](const tbb::blocked_range<size_t>& range) {
+                    auto& local_updates = updated_vertices.local();
+                    for (size_t k = range.begin(); k != range.end(); ++k) {
+                        const Index vi = frontier[k];
+                        const Scalar di = tentative[vi].load(std::memory_order_relaxed);
+                        for (Index vj : adjacency.get_neighbors(vi)) {
+                            const Scalar dj = di + dist(vi, vj);
+                            if (dj < radius && atomic_fetch_min(tentative[vj], dj)) {
+                                local_updates.push_back(vj);
+                            }
+                        }
+                    }
+                });
+
+            frontier.clear();
+            for (auto& local_updates : updated_vertices) {
+                for (Index vj : local_updates) {
+                    const size_t bj = bucket_of(tentative[vj].load(std::memory_order_relaxed));
+                    la_debug_assert(bj >= b);
+                    if (bj == b) {
+                        frontier.push_back(vj);
+                    } else {
+                        add_to_bucket(vj, bj);
+                    }
+                }
+                local_updates.clear();
+            }
+        }
+    }
+
+    tbb::parallel_for(Index(0), num_vertices, [&](Index v) {
+        distances[v] = tentative[v].load(std::memory_order_relaxed);
+    });
+}
+
 #define LA_X_dijkstra(_, Scalar, Index)            \
     template LA_CORE_API void dijkstra<Scalar, Index>(         \
         SurfaceMesh<Scalar, Index>&,               \
@@ -96,4 +280,23 @@ void dijkstra(
 
 LA_SURFACE_MESH_X(dijkstra, 0)
 
+#define LA_X_dijkstra_adjacency(_, Scalar, Index)         \
+    template LA_CORE_API void dijkstra<Scalar, Index>(    \
+        const AdjacencyList<Index>&,                      \
+        span<const Index>,                                \
+        span<const Scalar>,                               \
+        Scalar,                                           \
+        const function_ref<Scalar(Index, Index)>&,        \
+        const function_ref<bool(Index, Scalar)>&);        \
+    template LA_CORE_API void delta_stepping<Scalar, Index>( \
+        const AdjacencyList<Index>&,                      \
+        span<const Index>,                                \
+        span<const Scalar>,                               \
+        Scalar,                                           \
+        Scalar,                                           \
+        const function_ref<Scalar(Index, Index)>&,        \
+        span<Scalar>);
+
+LA_SURFACE_MESH_X(dijkstra_adjacency, 0)
+
 } // namespace lagrange::internal
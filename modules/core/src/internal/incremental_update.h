@@ -0,0 +1,131 @@
+/*
+ * Copyright 2024 Adobe. All rights reserved.
+ * This file is licensed to you under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License. You may obtain a copy
+ * of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under
+ * the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR REPRESENTATIONS
+ * OF ANY KIND, either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+ */
+#pragma once
+
+#include <lagrange/SurfaceMesh.h>
+#include <lagrange/utils/assert.h>
+#include <lagrange/utils/span.h>
+
+// clang-format off
+#include <lagrange/utils/warnoff.h>
+#include <tbb/parallel_for.h>
+#include <lagrange/utils/warnon.h>
+// clang-format on
+
+#include <algorithm>
+#include <optional>
+#include <vector>
+
+namespace lagrange::internal {
+
+///
+/// Sorts and removes duplicate entries of an element list.
+///
+template <typename Index>
+void sort_unique(std::vector<Index>& elements)
+{
+    std::sort(elements.begin(), elements.end());
+    elements.erase(std::unique(elements.begin(), elements.end()), elements.end());
+}
+
+///
+/// Collects the facets incident to a set of vertices. The mesh must have edge information.
+///
+/// @param[in]  mesh      Input mesh.
+/// @param[in]  vertices  Vertex indices.
+///
+/// @return     Sorted list of unique facet indices.
+///
+template <typename Scalar, typename Index>
+std::vector<Index> collect_facets_around_vertices(
+    const SurfaceMesh<Scalar, Index>& mesh,
+    span<const Index> vertices)
+{
+    la_debug_assert(mesh.has_edges());
+    std::vector<Index> facets;
+    for (Index v : vertices) {
+        la_runtime_assert(v < mesh.get_num_vertices(), "Vertex index out of range");
+        mesh.foreach_facet_around_vertex(v, [&](Index f) { facets.push_back(f); });
+    }
+    sort_unique(facets);
+    return facets;
+}
+
+///
+/// Collects the vertices of a set of facets.
+///
+/// @param[in]  mesh    Input mesh.
+/// @param[in]  facets  Facet indices.
+///
+/// @return     Sorted list of unique vertex indices.
+///
+template <typename Scalar, typename Index>
+std::vector<Index> collect_facet_vertices(
+    const SurfaceMesh<Scalar, Index>& mesh,
+    span<const Index> facets)
+{
+    std::vector<Index> vertices;
+    for (Index f : facets) {
+        auto facet_vertices = mesh.get_facet_vertices(f);
+        vertices.insert(vertices.end(), facet_vertices.begin(), facet_vertices.end());
+    }
+    sort_unique(vertices);
+    return vertices;
+}
+
+///
+/// Collects the edges of a set of facets. The mesh must have edge information.
+///
+/// @param[in]  mesh    Input mesh.
+/// @param[in]  facets  Facet indices.
+///
+/// @return     Sorted list of unique edge indices.
+///
+template <typename Scalar, typename Index>
+std::vector<Index> collect_facet_edges(
+    const SurfaceMesh<Scalar, Index>& mesh,
+    span<const Index> facets)
+{
+    la_debug_assert(mesh.has_edges());
+    std::vector<Index> edges;
+    for (Index f : facets) {
+        for (Index c = mesh.get_facet_corner_begin(f); c < mesh.get_facet_corner_end(f); ++c) {
+            edges.push_back(mesh.get_corner_edge(c));
+        }
+    }
+    sort_unique(edges);
+    return edges;
+}
+
+///
+/// Applies a function in parallel to a selection of elements, or to all elements if no selection
+/// is provided.
+///
+/// @param[in]  num_elements  Total number of elements.
+/// @param[in]  selection     Optional list of elements to process.
+/// @param[in]  func          Function to apply to each element index.
+///
+template <typename Index, typename Func>
+void par_foreach_selected(
+    Index num_elements,
+    const std::optional<span<const Index>>& selection,
+    Func&& func)
+{
+    if (selection.has_value()) {
+        const span<const Index> elements = selection.value();
+        tbb::parallel_for(size_t(0), elements.size(), [&](size_t i) { func(elements[i]); });
+    } else {
+        tbb::parallel_for(Index(0), num_elements, [&](Index i) { func(i); });
+    }
+}
+
+} // namespace lagrange::internal
@@ -0,0 +1,167 @@
+/*
+ * Copyright 2024 Adobe. All rights reserved.
+ * This file is licensed to you under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License. You may obtain a copy
+ * of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under
+ * the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR REPRESENTATIONS
+ * OF ANY KIND, either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+ */
+#pragma once
+
+#include <lagrange/utils/span.h>
+
+// clang-format off
+#include <lagrange/utils/warnoff.h>
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <lagrange/utils/warnon.h>
+// clang-format on
+
+#include <Eigen/Core>
+
+#include <algorithm>
+#include <array>
+#include <optional>
+
+///
+/// @file triangle_batch.h
+///
+/// Structure-of-arrays kernels processing a fixed number of elements (triangles, edges, corners)
+/// at once. Coordinates are gathered into fixed-size Eigen arrays, one per component, so that the
+/// arithmetic is carried out on full SIMD packets by Eigen's vectorization backend, whichever
+/// instruction set the library is compiled for.
+///
+
+namespace lagrange::internal {
+
+/// Number of elements processed by a single batch.
+constexpr Eigen::Index batch_size = 8;
+
+/// One value per element of a batch.
+template <typename Scalar>
+using BatchLanes = Eigen::Array<Scalar, batch_size, 1>;
+
+///
+/// Coordinates of one 3D point per element of a batch, stored as structure of arrays. 2D points
+/// have a zero z coordinate.
+///
+template <typename Scalar>
+struct PointBatch
+{
+    BatchLanes<Scalar> x;
+    BatchLanes<Scalar> y;
+    BatchLanes<Scalar> z;
+};
+
+///
+/// Gathers vertex positions into a point batch. Lanes past `count` are set to zero.
+///
+/// @param[in]  positions  Row-major vertex positions.
+/// @param[in]  dim        Vertex dimension, either 2 or 3.
+/// @param[in]  count      Number of valid lanes.
+/// @param[in]  vertex_at  Function returning the vertex index of a given lane.
+///
+/// @return     The gathered points.
+///
+template <typename Scalar, typename VertexFunc>
+PointBatch<Scalar>
+gather_points(const Scalar* positions, Eigen::Index dim, Eigen::Index count, VertexFunc&& vertex_at)
+{
+    PointBatch<Scalar> p;
+    for (Eigen::Index i = 0; i < count; ++i) {
+        const Scalar* q = positions + static_cast<size_t>(vertex_at(i)) * dim;
+        p.x[i] = q[0];
+        p.y[i] = q[1];
+        p.z[i] = dim > 2 ? q[2] : Scalar(0);
+    }
+    for (Eigen::Index i = count; i < batch_size; ++i) {
+        p.x[i] = p.y[i] = p.z[i] = Scalar(0);
+    }
+    return p;
+}
+
+/// Lane-wise difference a - b.
+template <typename Scalar>
+PointBatch<Scalar> operator-(const PointBatch<Scalar>& a, const PointBatch<Scalar>& b)
+{
+    return {a.x - b.x, a.y - b.y, a.z - b.z};
+}
+
+/// Lane-wise cross product a x b.
+template <typename Scalar>
+PointBatch<Scalar> cross(const PointBatch<Scalar>& a, const PointBatch<Scalar>& b)
+{
+    return {a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x};
+}
+
+/// Lane-wise dot product a . b.
+template <typename Scalar>
+BatchLanes<Scalar> dot(const PointBatch<Scalar>& a, const PointBatch<Scalar>& b)
+{
+    return a.x * b.x + a.y * b.y + a.z * b.z;
+}
+
+/// Lane-wise Euclidean norm.
+template <typename Scalar>
+BatchLanes<Scalar> norm(const PointBatch<Scalar>& a)
+{
+    return dot(a, a).sqrt();
+}
+
+///
+/// Lane-wise normalization, following the same steps as Eigen's stableNormalize(): vectors are
+/// rescaled by their largest component first to avoid underflow and overflow, and zero vectors are
+/// left unchanged.
+///
+template <typename Scalar>
+void stable_normalize(PointBatch<Scalar>& a)
+{
+    const BatchLanes<Scalar> ones = BatchLanes<Scalar>::Ones();
+    BatchLanes<Scalar> w = a.x.abs().max(a.y.abs()).max(a.z.abs());
+    w = (w > Scalar(0)).select(w, ones);
+    const PointBatch<Scalar> z = {a.x / w, a.y / w, a.z / w};
+    const BatchLanes<Scalar> n2 = dot(z, z);
+    const BatchLanes<Scalar> s = (n2 > Scalar(0)).select(n2.sqrt() * w, ones);
+    a.x /= s;
+    a.y /= s;
+    a.z /= s;
+}
+
+///
+/// Applies a function in parallel to batches of elements, taken either from a selection or from
+/// the full range [0, num_elements). The function receives the element indices of the batch and
+/// the number of valid entries, which is only smaller than batch_size for the last batch.
+///
+/// @param[in]  num_elements  Total number of elements.
+/// @param[in]  selection     Optional list of elements to process.
+/// @param[in]  func          Function `(const std::array<Index, batch_size>&, Eigen::Index)`.
+///
+template <typename Index, typename Func>
+void par_foreach_batch(
+    Index num_elements,
+    const std::optional<span<const Index>>& selection,
+    Func&& func)
+{
+    const size_t n = selection.has_value() ? selection->size() : static_cast<size_t>(num_elements);
+    const size_t num_batches = (n + batch_size - 1) / batch_size;
+    tbb::parallel_for(
+        tbb::blocked_range<size_t>(0, num_batches),
+        [&](const tbb::blocked_range<size_t>& r) {
+            std::array<Index, batch_size> ids;
+            for (size_t b = r.begin(); b != r.end(); ++b) {
+                const size_t first = b * batch_size;
+                const auto count =
+                    static_cast<Eigen::Index>(std::min<size_t>(batch_size, n - first));
+                for (Eigen::Index i = 0; i < count; ++i) {
+                    ids[i] = selection.has_value() ? (*selection)[first + i]
+                                                   : static_cast<Index>(first + i);
+                }
+                func(ids, count);
+            }
+        });
+}
+
+} // namespace lagrange::internal
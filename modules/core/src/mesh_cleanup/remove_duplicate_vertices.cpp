@@ -10,25 +10,159 @@
  * governing permissions and limitations under the License.
  */
 
+#include <lagrange/Attribute.h>
 #include <lagrange/SurfaceMeshTypes.h>
 #include <lagrange/foreach_attribute.h>
 #include <lagrange/mesh_cleanup/remove_duplicate_vertices.h>
 #include <lagrange/remap_vertices.h>
+#include <lagrange/utils/ConcurrentDisjointSets.h>
 #include <lagrange/utils/Error.h>
 #include <lagrange/utils/invalid.h>
 
 // clang-format off
 #include <lagrange/utils/warnoff.h>
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/parallel_reduce.h>
 #include <tbb/parallel_sort.h>
 #include <lagrange/utils/warnon.h>
 // clang-format on
 
 #include <algorithm>
+#include <cmath>
+#include <limits>
 #include <numeric>
 #include <vector>
 
 namespace lagrange {
 
+namespace {
+
+///
+/// Compute the vertex mapping merging candidate vertices within a given tolerance. Candidates are
+/// hashed into a uniform grid with cells of the size of the tolerance, so that close vertices are
+/// found by visiting the 3^dim cells around each vertex. Cells are enlarged when the tolerance is
+/// too small for the cell coordinates of the candidates to fit in 64-bit integers.
+///
+template <typename Scalar, typename Index>
+std::vector<Index> compute_welded_vertex_mapping(
+    const SurfaceMesh<Scalar, Index>& mesh,
+    const std::vector<Index>& candidates,
+    const RemoveDuplicateVerticesOptions& options)
+{
+    using CellCoord = int64_t;
+
+    const Index num_vertices = mesh.get_num_vertices();
+    const Index dim = mesh.get_dimension();
+    const Index num_candidates = static_cast<Index>(candidates.size());
+    const Scalar tolerance = static_cast<Scalar>(options.tolerance);
+    auto positions = mesh.get_vertex_to_position().get_all();
+
+    std::vector<const Attribute<Scalar>*> extra_attributes;
+    for (const auto& id : options.extra_attributes) {
+        extra_attributes.push_back(&mesh.template get_attribute<Scalar>(id));
+    }
+
+    auto is_close = [&](Index vi, Index vj) {
+        Scalar sq_dist = 0;
+        for (Index k = 0; k < dim; ++k) {
+            const Scalar d = positions[size_t(vi) * dim + k] - positions[size_t(vj) * dim + k];
+            sq_dist += d * d;
+        }
+        if (sq_dist > tolerance * tolerance) return false;
+        for (const auto* attr : extra_attributes) {
+            for (size_t k = 0; k < attr->get_num_channels(); ++k) {
+                if (std::abs(attr->get(vi, k) - attr->get(vj, k)) > tolerance) return false;
+            }
+        }
+        return true;
+    };
+
+    // Any cell size larger than the tolerance is valid. Clamp it so that cell coordinates, and
+    // their neighbors, stay well within the range of CellCoord.
+    const Scalar max_abs_coord = tbb::parallel_reduce(
+        tbb::blocked_range<Index>(0, num_candidates),
+        Scalar(0),
+        [&](const tbb::blocked_range<Index>& r, Scalar result) {
+            for (Index i = r.begin(); i != r.end(); ++i) {
+                for (Index k = 0; k < dim; ++k) {
+                    const Scalar x = std::abs(positions[size_t(candidates[i]) * dim + k]);
+                    result = std::isfinite(x) ? std::max(result, x)
+                                              : std::numeric_limits<Scalar>::infinity();
+                }
+            }
+            return result;
+        },
+        [](Scalar a, Scalar b) { return std::max(a, b); });
+    la_runtime_assert(
+        std::isfinite(max_abs_coord),
+        "Vertex positions must be finite to remove duplicate vertices with a tolerance.");
+    constexpr int max_cell_exponent = std::numeric_limits<CellCoord>::digits - 2;
+    const Scalar cell_size = std::max(
+        {tolerance,
+         std::ldexp(max_abs_coord, -max_cell_exponent),
+         std::numeric_limits<Scalar>::min()});
+
+    // Sort candidates by grid cell.
+    std::vector<CellCoord> cells(size_t(num_candidates) * dim);
+    tbb::parallel_for(Index(0), num_candidates, [&](Index i) {
+        for (Index k = 0; k < dim; ++k) {
+            cells[size_t(i) * dim + k] = static_cast<CellCoord>(
+                std::floor(positions[size_t(candidates[i]) * dim + k] / cell_size));
+        }
+    });
+    auto get_cell = [&](Index i) { return cells.data() + size_t(i) * dim; };
+    auto cell_less = [&](const CellCoord* a, const CellCoord* b) {
+        return std::lexicographical_compare(a, a + dim, b, b + dim);
+    };
+    std::vector<Index> order(num_candidates);
+    std::iota(order.begin(), order.end(), Index(0));
+    tbb::parallel_sort(order.begin(), order.end(), [&](Index i, Index j) {
+        return cell_less(get_cell(i), get_cell(j)) ||
+               (!cell_less(get_cell(j), get_cell(i)) && i < j);
+    });
+
+    // Merge close candidates in neighboring cells. Since the roots of the disjoint sets are always
+    // the smallest vertex index, the result does not depend on the scheduling.
+    Index num_neighbor_cells = 1;
+    for (Index k = 0; k < dim; ++k) num_neighbor_cells *= 3;
+    ConcurrentDisjointSets<Index> groups(num_vertices);
+    tbb::parallel_for(tbb::blocked_range<Index>(0, num_candidates), [&](const auto& r) {
+        std::vector<CellCoord> query(dim);
+        for (Index i = r.begin(); i != r.end(); ++i) {
+            const Index vi = candidates[i];
+            for (Index n = 0; n < num_neighbor_cells; ++n) {
+                Index code = n;
+                for (Index k = 0; k < dim; ++k, code /= 3) {
+                    query[k] = get_cell(i)[k] + CellCoord(code % 3) - 1;
+                }
+                auto lo = std::lower_bound(
+                    order.begin(),
+                    order.end(),
+                    query,
+                    [&](Index j, const auto& q) { return cell_less(get_cell(j), q.data()); });
+                auto hi = std::upper_bound(
+                    lo,
+                    order.end(),
+                    query,
+                    [&](const auto& q, Index j) { return cell_less(q.data(), get_cell(j)); });
+                for (auto it = lo; it != hi; ++it) {
+                    const Index vj = candidates[*it];
+                    if (vj > vi && is_close(vi, vj)) {
+                        groups.merge(vi, vj);
+                    }
+                }
+            }
+        }
+    });
+
+    std::vector<Index> old_to_new;
+    groups.extract_disjoint_set_indices(old_to_new);
+    return old_to_new;
+}
+
+} // namespace
+
 template <typename Scalar, typename Index>
 void remove_duplicate_vertices(
     SurfaceMesh<Scalar, Index>& mesh,
@@ -44,6 +178,7 @@ void remove_duplicate_vertices(
             mesh.template is_attribute_type<Scalar>(id),
             "Attribute type must be Scalar.");
     }
+    la_runtime_assert(options.tolerance >= 0, "Tolerance must be non-negative.");
 
     // Step 1: Sort vertices with custom comp.
     auto compare_vertex_attr = [&](Index vi, Index vj, AttributeId id) -> short {
@@ -166,6 +301,12 @@ void remove_duplicate_vertices(
         std::iota(order.begin(), order.end(), 0);
     }
 
+    if (options.tolerance > 0) {
+        auto old_to_new = compute_welded_vertex_mapping(mesh, order, options);
+        remap_vertices<Scalar, Index>(mesh, old_to_new);
+        return;
+    }
+
     tbb::parallel_sort(order.begin(), order.end(), [&](Index vi, Index vj) {
         return compare_vertices(vi, vj) < 0;
     });
@@ -9,6 +9,7 @@
  * OF ANY KIND, either express or implied. See the License for the specific language
  * governing permissions and limitations under the License.
  */
+#include <lagrange/IndexedAttribute.h>
 #include <lagrange/SurfaceMeshTypes.h>
 #include <lagrange/foreach_attribute.h>
 #include <lagrange/permute_facets.h>
@@ -97,6 +98,10 @@ void permute_facets(SurfaceMesh<Scalar, Index>& mesh, span<const Index> new_to_o
     par_foreach_attribute_write<AttributeElement::Facet>(mesh, permute_facet);
     // Permute corner attributes (corner-to-vertex attribute included).
     par_foreach_attribute_write<AttributeElement::Corner>(mesh, permute_corner);
+    // Permute indices of indexed attributes, which are per-corner.
+    par_foreach_attribute_write<AttributeElement::Indexed>(mesh, [&](auto&& attr) {
+        permute_corner(attr.indices());
+    });
 }
 
 #define LA_X_permute_facets(_, Scalar, Index) \
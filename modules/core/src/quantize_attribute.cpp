@@ -0,0 +1,331 @@
+/*
+ * Copyright 2024 Adobe. All rights reserved.
+ * This file is licensed to you under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License. You may obtain a copy
+ * of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under
+ * the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR REPRESENTATIONS
+ * OF ANY KIND, either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+ */
+#include <lagrange/quantize_attribute.h>
+
+#include <lagrange/Attribute.h>
+#include <lagrange/IndexedAttribute.h>
+#include <lagrange/Logger.h>
+#include <lagrange/SurfaceMeshTypes.h>
+#include <lagrange/internal/visit_attribute.h>
+#include <lagrange/utils/Error.h>
+#include <lagrange/utils/assert.h>
+
+// clang-format off
+#include <lagrange/utils/warnoff.h>
+#include <tbb/parallel_for.h>
+#include <lagrange/utils/warnon.h>
+// clang-format on
+
+#include <cmath>
+#include <string>
+#include <vector>
+
+namespace lagrange {
+
+namespace {
+
+// Layout of the parameter attribute: encoding, usage, num_channels, offset[num_channels],
+// scale[num_channels]. Offset and scale are only present for bounded encodings.
+std::vector<double> serialize_quantization(const AttributeQuantization& quantization)
+{
+    std::vector<double> params;
+    params.push_back(static_cast<double>(quantization.encoding));
+    params.push_back(static_cast<double>(quantization.usage));
+    params.push_back(static_cast<double>(quantization.num_channels));
+    params.insert(params.end(), quantization.offset.begin(), quantization.offset.end());
+    params.insert(params.end(), quantization.scale.begin(), quantization.scale.end());
+    return params;
+}
+
+/// Reads a stored parameter that must be an integer in [0, max_value].
+size_t get_integer_param(double value, size_t max_value, std::string_view what)
+{
+    if (!(value >= 0 && value <= static_cast<double>(max_value)) || value != std::floor(value)) {
+        throw Error(fmt::format("Invalid quantization parameters: {} {}", what, value));
+    }
+    return static_cast<size_t>(value);
+}
+
+size_t get_num_stored_channels(AttributeEncoding encoding, size_t num_channels)
+{
+    return encoding == AttributeEncoding::Octahedral16 ? num_channels - 1 : num_channels;
+}
+
+template <typename StoredType, typename ValueType>
+std::vector<StoredType> encode_values(
+    const Attribute<ValueType>& attr,
+    const AttributeQuantization& quantization)
+{
+    const size_t num_elements = attr.get_num_elements();
+    const size_t num_channels = attr.get_num_channels();
+    const size_t num_stored_channels =
+        get_num_stored_channels(quantization.encoding, num_channels);
+    std::vector<StoredType> stored(num_elements * num_stored_channels);
+
+    tbb::parallel_for(size_t(0), num_elements, [&](size_t e) {
+        auto in = attr.get_row(e);
+        StoredType* out = stored.data() + e * num_stored_channels;
+        switch (quantization.encoding) {
+        case AttributeEncoding::Octahedral16: {
+            auto oct = encode_octahedral(in[0], in[1], in[2]);
+            out[0] = oct[0];
+            out[1] = oct[1];
+            if (num_channels == 4) out[2] = encode_snorm<int16_t>(in[3]);
+            break;
+        }
+        case AttributeEncoding::Bounded16:
+            for (size_t c = 0; c < num_channels; ++c) {
+                const double s = quantization.scale[c];
+                const double t = s > 0 ? (double(in[c]) - quantization.offset[c]) / s : 0.0;
+                out[c] = static_cast<StoredType>(encode_unorm<uint16_t>(t));
+            }
+            break;
+        default:
+            for (size_t c = 0; c < num_channels; ++c) {
+                if constexpr (std::is_same_v<StoredType, uint16_t>) {
+                    out[c] = quantization.encoding == AttributeEncoding::Half
+                                 ? float_to_half(static_cast<float>(in[c]))
+                                 : encode_unorm<uint16_t>(in[c]);
+                } else if constexpr (std::is_unsigned_v<StoredType>) {
+                    out[c] = encode_unorm<StoredType>(in[c]);
+                } else {
+                    out[c] = encode_snorm<StoredType>(in[c]);
+                }
+            }
+            break;
+        }
+    });
+
+    return stored;
+}
+
+} // namespace
+
+std::string quantization_attribute_name(std::string_view name)
+{
+    return "@quantization:" + std::string(name);
+}
+
+template <typename Scalar, typename Index>
+AttributeId quantize_attribute(
+    SurfaceMesh<Scalar, Index>& mesh,
+    std::string_view name,
+    const QuantizeAttributeOptions& options)
+{
+    la_runtime_assert(mesh.has_attribute(name), fmt::format("Attribute {} does not exist", name));
+    la_runtime_assert(
+        !get_attribute_quantization(mesh, name).has_value(),
+        fmt::format("Attribute {} is already quantized", name));
+    const std::string input_name(name);
+    const std::string output_name(
+        options.output_attribute_name.empty() ? name : options.output_attribute_name);
+    la_runtime_assert(
+        output_name == input_name || !mesh.has_attribute(output_name),
+        fmt::format("Output attribute {} already exists", output_name));
+    const bool is_reserved = SurfaceMesh<Scalar, Index>::attr_name_is_reserved(output_name);
+    la_runtime_assert(
+        !is_reserved,
+        fmt::format("Output attribute name {} is reserved", output_name));
+    const AttributeId input_id = mesh.get_attribute_id(input_name);
+    const auto& input_base = mesh.get_attribute_base(input_id);
+    const AttributeElement element = input_base.get_element_type();
+    la_runtime_assert(element != AttributeElement::Value, "Value attributes cannot be quantized");
+
+    AttributeQuantization quantization;
+    quantization.encoding = options.encoding;
+    quantization.usage = input_base.get_usage();
+    quantization.num_channels = input_base.get_num_channels();
+    if (quantization.encoding == AttributeEncoding::Octahedral16) {
+        la_runtime_assert(
+            quantization.num_channels == 3 || quantization.num_channels == 4,
+            "Octahedral encoding requires 3 or 4 channels");
+    }
+
+    std::vector<Index> indices;
+    auto encode = [&](auto stored_value) {
+        using StoredType = decltype(stored_value);
+        std::vector<StoredType> stored;
+        internal::visit_attribute_read(mesh, input_id, [&](auto& attr) {
+            using AttributeType = std::decay_t<decltype(attr)>;
+            using ValueType = typename AttributeType::ValueType;
+            if constexpr (!std::is_floating_point_v<ValueType>) {
+                throw Error(fmt::format("Cannot quantize non floating point attribute {}", name));
+            } else {
+                const Attribute<ValueType>* values = nullptr;
+                if constexpr (AttributeType::IsIndexed) {
+                    values = &attr.values();
+                    auto input_indices = attr.indices().get_all();
+                    indices.assign(input_indices.begin(), input_indices.end());
+                } else {
+                    values = &attr;
+                }
+                if (quantization.encoding == AttributeEncoding::Bounded16) {
+                    auto M = matrix_view(*values);
+                    for (Eigen::Index c = 0; c < M.cols(); ++c) {
+                        const double lo = M.rows() > 0 ? double(M.col(c).minCoeff()) : 0.0;
+                        const double hi = M.rows() > 0 ? double(M.col(c).maxCoeff()) : 0.0;
+                        quantization.offset.push_back(lo);
+                        quantization.scale.push_back(hi - lo);
+                    }
+                }
+                stored = encode_values<StoredType>(*values, quantization);
+            }
+        });
+
+        if (output_name == input_name) {
+            mesh.delete_attribute(input_name);
+        }
+        const std::string params_name = quantization_attribute_name(output_name);
+        if (mesh.has_attribute(params_name)) {
+            mesh.delete_attribute(params_name);
+        }
+        const auto params = serialize_quantization(quantization);
+        mesh.template create_attribute<double>(
+            params_name,
+            AttributeElement::Value,
+            AttributeUsage::Vector,
+            1,
+            params);
+        return mesh.template create_attribute<StoredType>(
+            output_name,
+            element,
+            AttributeUsage::Vector,
+            get_num_stored_channels(quantization.encoding, quantization.num_channels),
+            stored,
+            indices);
+    };
+
+    switch (quantization.encoding) {
+    case AttributeEncoding::Unorm8: return encode(uint8_t());
+    case AttributeEncoding::Snorm8: return encode(int8_t());
+    case AttributeEncoding::Snorm16:
+    case AttributeEncoding::Octahedral16: return encode(int16_t());
+    default: return encode(uint16_t());
+    }
+}
+
+template <typename Scalar, typename Index>
+std::optional<AttributeQuantization> get_attribute_quantization(
+    const SurfaceMesh<Scalar, Index>& mesh,
+    std::string_view name)
+{
+    const std::string params_name = quantization_attribute_name(name);
+    if (!mesh.has_attribute(params_name) || !mesh.has_attribute(name)) {
+        return std::nullopt;
+    }
+    auto params = mesh.template get_attribute<double>(params_name).get_all();
+    la_runtime_assert(params.size() >= 3, "Invalid quantization parameters");
+
+    // Parameters may come from a file, so the enums are validated before being cast.
+    AttributeQuantization quantization;
+    quantization.encoding = static_cast<AttributeEncoding>(get_integer_param(
+        params[0],
+        static_cast<size_t>(AttributeEncoding::Bounded16),
+        "encoding"));
+    const size_t usage = get_integer_param(
+        params[1],
+        static_cast<size_t>(AttributeUsage::String),
+        "usage");
+    if (usage == 0 || (usage & (usage - 1)) != 0) {
+        throw Error(fmt::format("Invalid quantization parameters: usage {}", usage));
+    }
+    quantization.usage = static_cast<AttributeUsage>(usage);
+    const size_t num_stored_channels = mesh.get_attribute_base(name).get_num_channels();
+    quantization.num_channels =
+        get_integer_param(params[2], num_stored_channels + 1, "number of channels");
+    if (quantization.num_channels == 0 ||
+        (quantization.encoding == AttributeEncoding::Octahedral16 &&
+         quantization.num_channels != 3 && quantization.num_channels != 4) ||
+        get_num_stored_channels(quantization.encoding, quantization.num_channels) !=
+            num_stored_channels) {
+        throw Error(fmt::format(
+            "Invalid quantization parameters: {} channels for attribute {} with {} channels",
+            quantization.num_channels,
+            name,
+            num_stored_channels));
+    }
+    if (quantization.encoding == AttributeEncoding::Bounded16) {
+        const size_t n = quantization.num_channels;
+        la_runtime_assert(params.size() == 3 + 2 * n, "Invalid quantization parameters");
+        quantization.offset.assign(params.begin() + 3, params.begin() + 3 + n);
+        quantization.scale.assign(params.begin() + 3 + n, params.end());
+    }
+    return quantization;
+}
+
+template <typename ValueType, typename Scalar, typename Index>
+AttributeId dequantize_attribute(
+    SurfaceMesh<Scalar, Index>& mesh,
+    std::string_view name,
+    std::string_view output_attribute_name)
+{
+    static_assert(std::is_floating_point_v<ValueType>);
+    auto quantization = get_attribute_quantization(mesh, name);
+    la_runtime_assert(quantization.has_value(), fmt::format("Attribute {} is not quantized", name));
+    const std::string input_name(name);
+    const std::string output_name(output_attribute_name.empty() ? name : output_attribute_name);
+    const AttributeId input_id = mesh.get_attribute_id(input_name);
+    const AttributeElement element = mesh.get_attribute_base(input_id).get_element_type();
+
+    std::vector<Index> indices;
+    if (element == AttributeElement::Indexed) {
+        internal::visit_attribute_read(mesh, input_id, [&](auto& attr) {
+            using AttributeType = std::decay_t<decltype(attr)>;
+            if constexpr (AttributeType::IsIndexed) {
+                auto input_indices = attr.indices().get_all();
+                indices.assign(input_indices.begin(), input_indices.end());
+            }
+        });
+    }
+
+    auto view = decoded_matrix_view<ValueType>(mesh, input_name);
+    const size_t num_channels = quantization->num_channels;
+    std::vector<ValueType> values(static_cast<size_t>(view.rows()) * num_channels);
+    tbb::parallel_for(Eigen::Index(0), view.rows(), [&](Eigen::Index i) {
+        for (size_t c = 0; c < num_channels; ++c) {
+            values[i * num_channels + c] = view(i, static_cast<Eigen::Index>(c));
+        }
+    });
+
+    if (output_name == input_name) {
+        mesh.delete_attribute(input_name);
+        mesh.delete_attribute(quantization_attribute_name(input_name));
+    }
+    return mesh.template create_attribute<ValueType>(
+        output_name,
+        element,
+        quantization->usage,
+        num_channels,
+        values,
+        indices);
+}
+
+#define LA_X_quantize_attribute(_, Scalar, Index)                                 \
+    template LA_CORE_API AttributeId quantize_attribute<Scalar, Index>(           \
+        SurfaceMesh<Scalar, Index>&,                                              \
+        std::string_view,                                                         \
+        const QuantizeAttributeOptions&);                                         \
+    template LA_CORE_API std::optional<AttributeQuantization>                     \
+    get_attribute_quantization<Scalar, Index>(                                    \
+        const SurfaceMesh<Scalar, Index>&,                                        \
+        std::string_view);                                                        \
+    template LA_CORE_API AttributeId dequantize_attribute<float, Scalar, Index>(  \
+        SurfaceMesh<Scalar, Index>&,                                              \
+        std::string_view,                                                         \
+        std::string_view);                                                        \
+    template LA_CORE_API AttributeId dequantize_attribute<double, Scalar, Index>( \
+        SurfaceMesh<Scalar, Index>&,                                              \
+        std::string_view,                                                         \
+        std::string_view);
+LA_SURFACE_MESH_X(quantize_attribute, 0)
+
+} // namespace lagrange
@@ -16,6 +16,8 @@
 #include <lagrange/SurfaceMesh.h>
 #include <lagrange/SurfaceMeshTypes.h>
 #include <lagrange/compute_centroid.h>
+#include <lagrange/compute_vertex_cache_statistics.h>
+#include <lagrange/compute_vertex_corner_adjacency.h>
 #include <lagrange/permute_facets.h>
 #include <lagrange/permute_vertices.h>
 #include <lagrange/utils/assert.h>
@@ -158,6 +160,301 @@ std::vector<Index> spatial_ordering_points(
     return indices;
 }
 
+// Size of the post-transform vertex cache targeted by GPU-oriented reordering methods.
+constexpr size_t s_vertex_cache_size = 16;
+
+// Cluster ACMR threshold, relative to the mesh ACMR, below which a soft cluster boundary is added.
+constexpr double s_overdraw_threshold = 1.05;
+
+///
+/// Compute a facet ordering optimized for a FIFO post-transform vertex cache, using the Tipsify
+/// algorithm described in:
+///
+/// Sander, P. V., Nehab, D., & Barczak, J. (2007). Fast triangle reordering for vertex locality and
+/// reduced overdraw. ACM Transactions on Graphics, 26(3), 89.
+///
+/// @param[in]  mesh             Triangle mesh to reorder.
+/// @param[in]  cache_size       Size of the targeted vertex cache.
+/// @param[out] hard_boundaries  Offsets into the output ordering where Tipsify had to jump to a
+///                              non-adjacent vertex, followed by the number of facets.
+///
+/// @return     Sorted facet indices for the new->old mapping.
+///
+template <typename Scalar, typename Index>
+std::vector<Index> tipsify_ordering(
+    const SurfaceMesh<Scalar, Index>& mesh,
+    size_t cache_size,
+    std::vector<Index>& hard_boundaries)
+{
+    const Index num_vertices = mesh.get_num_vertices();
+    const Index num_facets = mesh.get_num_facets();
+    const auto vertex_to_corners = compute_vertex_corner_adjacency(mesh);
+
+    std::vector<Index> live_count(num_vertices);
+    for (Index v = 0; v < num_vertices; ++v) {
+        live_count[v] = static_cast<Index>(vertex_to_corners.get_num_neighbors(v));
+    }
+    std::vector<size_t> cache_time(num_vertices, 0);
+    std::vector<bool> emitted(num_facets, false);
+    std::vector<Index> dead_end_stack;
+    std::vector<Index> candidates;
+    std::vector<Index> order;
+    order.reserve(num_facets);
+    hard_boundaries.clear();
+
+    size_t time = cache_size + 1;
+    Index cursor = 0;
+
+    // Pops the dead-end stack, then scans vertices in input order, until a vertex with live facets
+    // is found.
+    auto skip_dead_end = [&]() -> Index {
+        while (!dead_end_stack.empty()) {
+            Index v = dead_end_stack.back();
+            dead_end_stack.pop_back();
+            if (live_count[v] > 0) return v;
+        }
+        for (; cursor < num_vertices; ++cursor) {
+            if (live_count[cursor] > 0) return cursor;
+        }
+        return invalid<Index>();
+    };
+
+    Index fan = skip_dead_end();
+    while (fan != invalid<Index>()) {
+        // Emit all remaining facets around the fanning vertex
+        candidates.clear();
+        for (Index c : vertex_to_corners.get_neighbors(fan)) {
+            const Index f = mesh.get_corner_facet(c);
+            if (emitted[f]) continue;
+            emitted[f] = true;
+            order.push_back(f);
+            for (Index v : mesh.get_facet_vertices(f)) {
+                dead_end_stack.push_back(v);
+                candidates.push_back(v);
+                --live_count[v];
+                if (time - cache_time[v] > cache_size) {
+                    cache_time[v] = time++;
+                }
+            }
+        }
+
+        // Pick the next fanning vertex among the 1-ring candidates: prefer the oldest vertex that
+        // will still be in the cache after emitting all its remaining facets.
+        Index next = invalid<Index>();
+        size_t best_priority = 0;
+        for (Index v : candidates) {
+            if (live_count[v] == 0) continue;
+            size_t priority = 1;
+            if (time - cache_time[v] + 2 * size_t(live_count[v]) <= cache_size) {
+                priority += time - cache_time[v];
+            }
+            if (priority > best_priority) {
+                best_priority = priority;
+                next = v;
+            }
+        }
+        if (next == invalid<Index>()) {
+            next = skip_dead_end();
+            if (next != invalid<Index>()) {
+                hard_boundaries.push_back(static_cast<Index>(order.size()));
+            }
+        }
+        fan = next;
+    }
+    la_debug_assert(order.size() == num_facets);
+
+    hard_boundaries.insert(hard_boundaries.begin(), Index(0));
+    hard_boundaries.push_back(num_facets);
+    return order;
+}
+
+///
+/// Sort clusters of facets to reduce overdraw, following the view-independent approach of Sander et
+/// al. [2007]. Hard clusters from Tipsify are first split into smaller clusters whose own ACMR is
+/// close to the ACMR of the whole ordering, then clusters are sorted by decreasing dot product
+/// between their normal and their offset from the mesh centroid, so that outward-facing clusters,
+/// which are more likely to occlude the rest of the mesh, are drawn first.
+///
+/// @param[in]  mesh             Triangle mesh to reorder.
+/// @param[in]  order            Facet ordering computed by Tipsify.
+/// @param[in]  hard_boundaries  Cluster boundaries computed by Tipsify.
+/// @param[in]  cache_size       Size of the targeted vertex cache.
+///
+/// @return     Sorted facet indices for the new->old mapping.
+///
+template <typename Scalar, typename Index>
+std::vector<Index> overdraw_ordering(
+    const SurfaceMesh<Scalar, Index>& mesh,
+    const std::vector<Index>& order,
+    const std::vector<Index>& hard_boundaries,
+    size_t cache_size)
+{
+    const Index num_facets = mesh.get_num_facets();
+    if (num_facets == 0) return order;
+
+    // Simulate the vertex cache to find soft boundaries
+    std::vector<size_t> cache_time(mesh.get_num_vertices(), 0);
+    size_t time = cache_size + 1;
+    auto count_misses = [&](Index f) {
+        size_t misses = 0;
+        for (Index v : mesh.get_facet_vertices(f)) {
+            if (time - cache_time[v] > cache_size) {
+                cache_time[v] = time++;
+                ++misses;
+            }
+        }
+        return misses;
+    };
+
+    size_t total_misses = 0;
+    for (Index f : order) {
+        total_misses += count_misses(f);
+    }
+    const double threshold = s_overdraw_threshold * double(total_misses) / double(num_facets);
+
+    std::vector<Index> boundaries;
+    boundaries.reserve(hard_boundaries.size());
+    for (size_t k = 0; k + 1 < hard_boundaries.size(); ++k) {
+        Index start = hard_boundaries[k];
+        const Index end = hard_boundaries[k + 1];
+        boundaries.push_back(start);
+        time += cache_size + 1; // flush the cache
+        size_t misses = 0;
+        for (Index i = start; i < end; ++i) {
+            misses += count_misses(order[i]);
+            if (i + 1 < end && double(misses) <= threshold * double(i + 1 - start)) {
+                start = i + 1;
+                boundaries.push_back(start);
+                misses = 0;
+                time += cache_size + 1;
+            }
+        }
+    }
+    boundaries.push_back(num_facets);
+    const size_t num_clusters = boundaries.size() - 1;
+
+    // Area-weighted centroid and normal of each cluster
+    auto vertices = vertex_view(mesh);
+    auto position = [&](Index v) {
+        Eigen::Vector3d p = Eigen::Vector3d::Zero();
+        p.head(vertices.cols()) = vertices.row(v).transpose().template cast<double>();
+        return p;
+    };
+    std::vector<Eigen::Vector3d> cluster_centroids(num_clusters);
+    std::vector<Eigen::Vector3d> cluster_normals(num_clusters);
+    std::vector<double> cluster_areas(num_clusters);
+    tbb::parallel_for(size_t(0), num_clusters, [&](size_t k) {
+        Eigen::Vector3d centroid = Eigen::Vector3d::Zero();
+        Eigen::Vector3d normal = Eigen::Vector3d::Zero();
+        double area = 0;
+        for (Index i = boundaries[k]; i < boundaries[k + 1]; ++i) {
+            auto fv = mesh.get_facet_vertices(order[i]);
+            const Eigen::Vector3d p0 = position(fv[0]);
+            const Eigen::Vector3d p1 = position(fv[1]);
+            const Eigen::Vector3d p2 = position(fv[2]);
+            const Eigen::Vector3d n = (p1 - p0).cross(p2 - p0);
+            const double a = 0.5 * n.norm();
+            centroid += a * (p0 + p1 + p2) / 3.0;
+            normal += n;
+            area += a;
+        }
+        cluster_centroids[k] = centroid;
+        cluster_normals[k] = normal.stableNormalized();
+        cluster_areas[k] = area;
+    });
+
+    Eigen::Vector3d mesh_centroid = Eigen::Vector3d::Zero();
+    double mesh_area = 0;
+    for (size_t k = 0; k < num_clusters; ++k) {
+        mesh_centroid += cluster_centroids[k];
+        mesh_area += cluster_areas[k];
+        if (cluster_areas[k] > 0) cluster_centroids[k] /= cluster_areas[k];
+    }
+    if (mesh_area > 0) mesh_centroid /= mesh_area;
+
+    std::vector<double> sort_keys(num_clusters);
+    for (size_t k = 0; k < num_clusters; ++k) {
+        sort_keys[k] = (cluster_centroids[k] - mesh_centroid).dot(cluster_normals[k]);
+    }
+    std::vector<size_t> cluster_order(num_clusters);
+    std::iota(cluster_order.begin(), cluster_order.end(), size_t(0));
+    std::stable_sort(cluster_order.begin(), cluster_order.end(), [&](size_t i, size_t j) {
+        return sort_keys[i] > sort_keys[j];
+    });
+
+    std::vector<Index> result;
+    result.reserve(num_facets);
+    for (size_t k : cluster_order) {
+        result.insert(
+            result.end(),
+            order.begin() + boundaries[k],
+            order.begin() + boundaries[k + 1]);
+    }
+    return result;
+}
+
+///
+/// Compute a vertex ordering following the first use of each vertex in the facet order, to improve
+/// vertex fetch locality. Unreferenced vertices are moved to the end, in their original order.
+///
+/// @param[in]  mesh  Mesh to reorder.
+///
+/// @return     Sorted vertex indices for the new->old mapping.
+///
+template <typename Scalar, typename Index>
+std::vector<Index> vertex_fetch_ordering(const SurfaceMesh<Scalar, Index>& mesh)
+{
+    const Index num_vertices = mesh.get_num_vertices();
+    std::vector<bool> visited(num_vertices, false);
+    std::vector<Index> order;
+    order.reserve(num_vertices);
+    for (Index v : mesh.get_corner_to_vertex().get_all()) {
+        if (!visited[v]) {
+            visited[v] = true;
+            order.push_back(v);
+        }
+    }
+    for (Index v = 0; v < num_vertices; ++v) {
+        if (!visited[v]) order.push_back(v);
+    }
+    return order;
+}
+
+///
+/// GPU-oriented mesh reordering: facets are reordered for vertex cache efficiency and optionally
+/// overdraw, then vertices are reordered for vertex fetch locality.
+///
+/// @param[in,out] mesh    Mesh to reorder.
+/// @param[in]     method  One of VertexCache, Overdraw or VertexFetch.
+///
+template <typename Scalar, typename Index>
+void reorder_mesh_for_gpu(SurfaceMesh<Scalar, Index>& mesh, ReorderingMethod method)
+{
+    auto log_statistics = [&](const char* when) {
+        if (!logger().should_log(spdlog::level::debug)) return;
+        auto stats = compute_vertex_cache_statistics(mesh, s_vertex_cache_size);
+        logger().debug(
+            "Vertex cache {} reordering: ACMR = {:.3f}, ATVR = {:.3f}",
+            when,
+            stats.acmr,
+            stats.atvr);
+    };
+    log_statistics("before");
+
+    if (method != ReorderingMethod::VertexFetch) {
+        la_runtime_assert(mesh.is_triangle_mesh(), "Only triangle meshes are supported");
+        std::vector<Index> boundaries;
+        auto order = tipsify_ordering(mesh, s_vertex_cache_size, boundaries);
+        if (method == ReorderingMethod::Overdraw) {
+            order = overdraw_ordering(mesh, order, boundaries, s_vertex_cache_size);
+        }
+        permute_facets<Scalar, Index>(mesh, order);
+    }
+    permute_vertices<Scalar, Index>(mesh, vertex_fetch_ordering(mesh));
+
+    log_statistics("after");
+}
+
 } // namespace
 
 ///
@@ -183,6 +480,13 @@ void reorder_mesh(SurfaceMesh<Scalar, Index>& mesh, ReorderingMethod method)
     }
     logger().debug("Mesh reordering...");
 
+    if (method == ReorderingMethod::VertexCache || method == ReorderingMethod::Overdraw ||
+        method == ReorderingMethod::VertexFetch) {
+        reorder_mesh_for_gpu(mesh, method);
+        logger().debug("Mesh reordering done.");
+        return;
+    }
+
     // 1st: Permute vertices
     permute_vertices<Scalar, Index>(
         mesh,
@@ -9,13 +9,18 @@
  * OF ANY KIND, either express or implied. See the License for the specific language
  * governing permissions and limitations under the License.
  */
+#include <lagrange/Attribute.h>
 #include <lagrange/SurfaceMeshTypes.h>
 #include <lagrange/extract_submesh.h>
+#include <lagrange/internal/extract_submesh.h>
 #include <lagrange/separate_by_facet_groups.h>
+#include <lagrange/utils/assert.h>
 
 // clang-format off
 #include <lagrange/utils/warnoff.h>
+#include <tbb/enumerable_thread_specific.h>
 #include <tbb/parallel_for.h>
+#include <tbb/task_arena.h>
 #include <lagrange/utils/warnon.h>
 // clang-format on
 
@@ -25,6 +30,71 @@
 
 namespace lagrange {
 
+namespace {
+
+/// Minimum number of facets per chunk when sorting facets by group.
+constexpr size_t s_sort_grain_size = 1 << 16;
+
+///
+/// Counting sort of facets by group, in parallel over chunks of facets. Facets of each group are
+/// kept in increasing order.
+///
+/// @param[in]  facet_group_indices  The group index of each facet.
+/// @param[in]  num_groups           The number of groups.
+/// @param[out] facet_indices        Facets sorted by group.
+/// @param[out] group_offsets        Facets of group `i` are `facet_indices[group_offsets[i]]` to
+///                                  `facet_indices[group_offsets[i + 1] - 1]`.
+///
+template <typename Index>
+void sort_facets_by_group(
+    span<const Index> facet_group_indices,
+    size_t num_groups,
+    std::vector<Index>& facet_indices,
+    std::vector<Index>& group_offsets)
+{
+    const size_t num_facets = facet_group_indices.size();
+    const size_t max_chunks =
+        static_cast<size_t>(std::max(tbb::this_task_arena::max_concurrency(), 1));
+    const size_t num_chunks =
+        std::clamp<size_t>(num_facets / s_sort_grain_size, size_t(1), max_chunks);
+    auto chunk_begin = [&](size_t k) { return k * num_facets / num_chunks; };
+
+    // Per-chunk histograms, stored chunk-major.
+    std::vector<Index> counts(num_chunks * num_groups, 0);
+    tbb::parallel_for(size_t(0), num_chunks, [&](size_t k) {
+        Index* chunk_counts = counts.data() + k * num_groups;
+        for (size_t f = chunk_begin(k); f < chunk_begin(k + 1); ++f) {
+            const Index g = facet_group_indices[f];
+            la_runtime_assert(static_cast<size_t>(g) < num_groups, "Invalid facet group index");
+            ++chunk_counts[g];
+        }
+    });
+
+    // Exclusive scan in group-major order gives the first output slot of each (chunk, group).
+    group_offsets.assign(num_groups + 1, 0);
+    Index offset = 0;
+    for (size_t g = 0; g < num_groups; ++g) {
+        group_offsets[g] = offset;
+        for (size_t k = 0; k < num_chunks; ++k) {
+            const Index count = counts[k * num_groups + g];
+            counts[k * num_groups + g] = offset;
+            offset += count;
+        }
+    }
+    group_offsets[num_groups] = offset;
+    la_debug_assert(static_cast<size_t>(offset) == num_facets);
+
+    facet_indices.resize(num_facets);
+    tbb::parallel_for(size_t(0), num_chunks, [&](size_t k) {
+        Index* chunk_offsets = counts.data() + k * num_groups;
+        for (size_t f = chunk_begin(k); f < chunk_begin(k + 1); ++f) {
+            facet_indices[chunk_offsets[facet_group_indices[f]]++] = static_cast<Index>(f);
+        }
+    });
+}
+
+} // namespace
+
 template <typename Scalar, typename Index>
 std::vector<SurfaceMesh<Scalar, Index>> separate_by_facet_groups(
     const SurfaceMesh<Scalar, Index>& mesh,
@@ -35,28 +105,29 @@ std::vector<SurfaceMesh<Scalar, Index>> separate_by_facet_groups(
     const Index num_facets = mesh.get_num_facets();
     if (num_facets == 0) return {};
     la_runtime_assert(static_cast<Index>(facet_group_indices.size()) == num_facets);
-    std::vector<Index> facet_indices(num_facets);
-    std::vector<Index> group_offsets(num_groups + 1, 0);
-    for (auto i : facet_group_indices) {
-        group_offsets[i + 1]++;
-    }
-    std::partial_sum(group_offsets.begin(), group_offsets.end(), group_offsets.begin());
-    la_debug_assert(group_offsets.back() == num_facets);
-    for (Index i = 0; i < num_facets; i++) {
-        facet_indices[group_offsets[facet_group_indices[i]]++] = i;
-    }
-    std::rotate(group_offsets.begin(), std::prev(group_offsets.end()), group_offsets.end());
-    group_offsets[0] = 0;
-    la_debug_assert(group_offsets.back() == num_facets);
 
+    std::vector<Index> facet_indices;
+    std::vector<Index> group_offsets;
+    sort_facets_by_group(facet_group_indices, num_groups, facet_indices, group_offsets);
+
+    // Each thread reuses its scratch buffers across groups, and indexed attribute values are
+    // compacted, so the total cost of the extraction is proportional to the size of the input mesh
+    // rather than to #groups times its size.
     std::vector<SurfaceMesh<Scalar, Index>> results(num_groups);
+    tbb::enumerable_thread_specific<internal::SubmeshScratch<Index>> scratch;
 
     SubmeshOptions submesh_options(options);
+    constexpr bool compact_indexed_values = true;
     tbb::parallel_for((size_t)0, num_groups, [&](size_t i) {
         span<const Index> selected_facets(
             facet_indices.data() + group_offsets[i],
             static_cast<size_t>(group_offsets[i + 1] - group_offsets[i]));
-        results[i] = extract_submesh(mesh, selected_facets, submesh_options);
+        results[i] = internal::extract_submesh(
+            mesh,
+            selected_facets,
+            submesh_options,
+            scratch.local(),
+            compact_indexed_values);
     });
     return results;
 }
@@ -80,9 +151,9 @@ std::vector<SurfaceMesh<Scalar, Index>> separate_by_facet_groups(
     function_ref<Index(Index)> get_facet_group,
     const SeparateByFacetGroupsOptions& options)
 {
-    std::vector<Index> facet_group_indices(num_groups);
-    for (size_t i = 0; i < num_groups; i++) {
-        facet_group_indices[i] = get_facet_group(static_cast<Index>(i));
+    std::vector<Index> facet_group_indices(mesh.get_num_facets());
+    for (Index f = 0; f < mesh.get_num_facets(); f++) {
+        facet_group_indices[f] = get_facet_group(f);
     }
     return separate_by_facet_groups(
         mesh,
@@ -91,6 +162,54 @@ std::vector<SurfaceMesh<Scalar, Index>> separate_by_facet_groups(
         options);
 }
 
+template <typename Scalar, typename Index>
+std::vector<SurfaceMesh<Scalar, Index>> view_sorted_facet_groups(
+    const SurfaceMesh<Scalar, Index>& mesh,
+    size_t num_groups,
+    span<const Index> facet_group_indices)
+{
+    const Index num_facets = mesh.get_num_facets();
+    la_runtime_assert(static_cast<Index>(facet_group_indices.size()) == num_facets);
+    la_runtime_assert(mesh.is_regular(), "Facet group views require a regular mesh");
+    la_runtime_assert(
+        std::is_sorted(facet_group_indices.begin(), facet_group_indices.end()),
+        "Facets must be sorted by group");
+    la_runtime_assert(
+        num_facets == 0 || static_cast<size_t>(facet_group_indices.back()) < num_groups,
+        "Invalid facet group index");
+
+    // Facets of group `i` are the range [group_offsets[i], group_offsets[i + 1]).
+    std::vector<Index> group_offsets(num_groups + 1);
+    for (size_t i = 0; i <= num_groups; i++) {
+        group_offsets[i] = static_cast<Index>(
+            std::lower_bound(
+                facet_group_indices.begin(),
+                facet_group_indices.end(),
+                static_cast<Index>(i)) -
+            facet_group_indices.begin());
+    }
+
+    const Index num_vertices = mesh.get_num_vertices();
+    const Index vertex_per_facet = num_facets > 0 ? mesh.get_vertex_per_facet() : 3;
+    const auto vertices = mesh.get_vertex_to_position().get_all();
+    const auto corners = mesh.get_corner_to_vertex().get_all();
+
+    std::vector<SurfaceMesh<Scalar, Index>> results(num_groups);
+    tbb::parallel_for((size_t)0, num_groups, [&](size_t i) {
+        const Index group_num_facets = group_offsets[i + 1] - group_offsets[i];
+        auto& view = results[i];
+        view = SurfaceMesh<Scalar, Index>(mesh.get_dimension());
+        view.wrap_as_const_vertices(vertices, num_vertices);
+        view.wrap_as_const_facets(
+            corners.subspan(
+                static_cast<size_t>(group_offsets[i]) * vertex_per_facet,
+                static_cast<size_t>(group_num_facets) * vertex_per_facet),
+            group_num_facets,
+            vertex_per_facet);
+    });
+    return results;
+}
+
 #define LA_X_separate_by_facet_groups(_, Scalar, Index)                        \
     template LA_CORE_API std::vector<SurfaceMesh<Scalar, Index>> separate_by_facet_groups( \
         const SurfaceMesh<Scalar, Index>&,                                     \
@@ -105,7 +224,11 @@ std::vector<SurfaceMesh<Scalar, Index>> separate_by_facet_groups(
         const SurfaceMesh<Scalar, Index>&,                                     \
         size_t,                                                                \
         function_ref<Index(Index)>,                                            \
-        const SeparateByFacetGroupsOptions&);
+        const SeparateByFacetGroupsOptions&);                                  \
+    template LA_CORE_API std::vector<SurfaceMesh<Scalar, Index>> view_sorted_facet_groups( \
+        const SurfaceMesh<Scalar, Index>&,                                     \
+        size_t,                                                                \
+        span<const Index>);
 
 LA_SURFACE_MESH_X(separate_by_facet_groups, 0)
 
@@ -114,7 +114,7 @@ SurfaceMesh<Scalar, Index> unify_index_buffer(
     }
 
     // Part 2: generate output mesh.
-    SurfaceMesh<Scalar, Index> output_mesh;
+    SurfaceMesh<Scalar, Index> output_mesh(mesh.get_dimension(), mesh.get_memory_resource());
 
     // Map vertices.
     std::vector<Index> corner_to_vertex(mesh.get_num_corners(), invalid<Index>());
@@ -0,0 +1,122 @@
+/*
+ * Copyright 2024 Adobe. All rights reserved.
+ * This file is licensed to you under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License. You may obtain a copy
+ * of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under
+ * the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR REPRESENTATIONS
+ * OF ANY KIND, either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+ */
+#include <lagrange/AttributeTypes.h>
+#include <lagrange/utils/ConcurrentDisjointSets.h>
+#include <lagrange/utils/assert.h>
+#include <lagrange/utils/invalid.h>
+#include <lagrange/utils/safe_cast.h>
+
+// clang-format off
+#include <lagrange/utils/warnoff.h>
+#include <spdlog/fmt/fmt.h>
+#include <tbb/parallel_for.h>
+#include <lagrange/utils/warnon.h>
+// clang-format on
+
+#include <algorithm>
+
+namespace lagrange {
+
+template <typename IndexType>
+void ConcurrentDisjointSets<IndexType>::init(size_t n)
+{
+    m_parent = std::vector<std::atomic<IndexType>>(n);
+    tbb::parallel_for(size_t(0), n, [&](size_t i) {
+        m_parent[i].store(static_cast<IndexType>(i), std::memory_order_relaxed);
+    });
+}
+
+template <typename IndexType>
+IndexType ConcurrentDisjointSets<IndexType>::find(IndexType i)
+{
+    la_runtime_assert(i >= 0 && i < safe_cast<IndexType>(m_parent.size()), "Index out of bound!");
+    while (true) {
+        const IndexType parent = m_parent[i].load(std::memory_order_relaxed);
+        if (parent == i) return i;
+        const IndexType grandparent = m_parent[parent].load(std::memory_order_relaxed);
+        if (parent != grandparent) {
+            // Path splitting: point i to its grandparent. Failure means another thread already
+            // moved i closer to its root, which is just as good.
+            IndexType expected = parent;
+            m_parent[i].compare_exchange_weak(expected, grandparent, std::memory_order_relaxed);
+        }
+        i = parent;
+    }
+}
+
+template <typename IndexType>
+IndexType ConcurrentDisjointSets<IndexType>::merge(IndexType i, IndexType j)
+{
+    while (true) {
+        IndexType root_i = find(i);
+        IndexType root_j = find(j);
+        if (root_i == root_j) return root_i;
+
+        // Always link the larger root under the smaller one, so that roots are deterministic and
+        // concurrent links can never form a cycle.
+        if (root_i > root_j) std::swap(root_i, root_j);
+        IndexType expected = root_j;
+        if (m_parent[root_j].compare_exchange_strong(
+                expected,
+                root_i,
+                std::memory_order_relaxed)) {
+            return root_i;
+        }
+        // root_j was linked by another thread in the meantime, try again from the new roots.
+        i = root_i;
+        j = root_j;
+    }
+}
+
+template <typename IndexType>
+size_t ConcurrentDisjointSets<IndexType>::extract_disjoint_set_indices(
+    std::vector<IndexType>& index_map)
+{
+    index_map.resize(size(), invalid<IndexType>());
+    return extract_disjoint_set_indices({index_map.data(), index_map.size()});
+}
+
+template <typename IndexType>
+size_t ConcurrentDisjointSets<IndexType>::extract_disjoint_set_indices(span<IndexType> index_map)
+{
+    const size_t num_entries = size();
+    la_runtime_assert(
+        index_map.size() >= num_entries,
+        fmt::format("Index map must be large enough to hold {} entries!", num_entries));
+
+    // Number roots in increasing order. Since a root is the smallest entry of its set, this
+    // matches the order in which sets first appear.
+    IndexType counter = 0;
+    for (size_t i = 0; i < num_entries; ++i) {
+        if (m_parent[i].load(std::memory_order_relaxed) == static_cast<IndexType>(i)) {
+            index_map[i] = counter++;
+        }
+    }
+
+    // Assign all members the same index as their root. Roots are left untouched, so there is no
+    // concurrent write to an entry being read.
+    tbb::parallel_for(size_t(0), num_entries, [&](size_t i) {
+        const IndexType root = find(static_cast<IndexType>(i));
+        if (root != static_cast<IndexType>(i)) {
+            index_map[i] = index_map[static_cast<size_t>(root)];
+        }
+    });
+    std::fill(index_map.begin() + num_entries, index_map.end(), invalid<IndexType>());
+
+    return static_cast<size_t>(counter);
+}
+
+#define LA_X_ConcurrentDisjointSets(_, Index) \
+    template class LA_CORE_API ConcurrentDisjointSets<Index>;
+LA_ATTRIBUTE_INDEX_X(ConcurrentDisjointSets, 0)
+
+} // namespace lagrange
@@ -0,0 +1,127 @@
+/*
+ * Copyright 2024 Adobe. All rights reserved.
+ * This file is licensed to you under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License. You may obtain a copy
+ * of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under
+ * the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR REPRESENTATIONS
+ * OF ANY KIND, either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+ */
+#include <lagrange/utils/MemoryResource.h>
+
+#include <lagrange/utils/assert.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <new>
+
+namespace lagrange {
+
+namespace {
+
+class NewDeleteResource final : public MemoryResource
+{
+protected:
+    void* do_allocate(size_t bytes, size_t alignment) override
+    {
+        return ::operator new(bytes, std::align_val_t(alignment));
+    }
+
+    void do_deallocate(void* p, size_t, size_t alignment) override
+    {
+        ::operator delete(p, std::align_val_t(alignment));
+    }
+
+    bool do_is_equal(const MemoryResource& other) const noexcept override
+    {
+        return dynamic_cast<const NewDeleteResource*>(&other) != nullptr;
+    }
+};
+
+} // namespace
+
+MemoryResource* new_delete_resource() noexcept
+{
+    static NewDeleteResource s_resource;
+    return &s_resource;
+}
+
+MonotonicArena::MonotonicArena(size_t initial_block_size, MemoryResource* upstream)
+    : m_upstream(upstream ? upstream : new_delete_resource())
+    , m_next_block_size(std::max<size_t>(initial_block_size, 64))
+{}
+
+MonotonicArena::~MonotonicArena()
+{
+    release();
+}
+
+void MonotonicArena::release()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_current.store(nullptr);
+    for (const auto& block : m_blocks) {
+        m_upstream->deallocate(block->data, block->size, alignof(std::max_align_t));
+    }
+    m_blocks.clear();
+    m_num_bytes_allocated.store(0);
+}
+
+size_t MonotonicArena::get_num_bytes_allocated() const
+{
+    return m_num_bytes_allocated.load(std::memory_order_relaxed);
+}
+
+void* MonotonicArena::try_allocate(Block& block, size_t bytes, size_t alignment)
+{
+    const auto base = reinterpret_cast<uintptr_t>(block.data);
+    size_t offset = block.offset.load(std::memory_order_relaxed);
+    for (;;) {
+        const uintptr_t aligned = (base + offset + alignment - 1) & ~uintptr_t(alignment - 1);
+        const size_t begin = static_cast<size_t>(aligned - base);
+        if (begin > block.size || block.size - begin < bytes) return nullptr;
+        // On failure, `offset` is updated with the latest value and the allocation is retried.
+        if (block.offset.compare_exchange_weak(offset, begin + bytes, std::memory_order_relaxed)) {
+            return block.data + begin;
+        }
+    }
+}
+
+void* MonotonicArena::do_allocate(size_t bytes, size_t alignment)
+{
+    la_runtime_assert(alignment > 0 && (alignment & (alignment - 1)) == 0);
+    bytes = std::max<size_t>(bytes, 1);
+
+    for (;;) {
+        Block* current = m_current.load(std::memory_order_acquire);
+        if (current != nullptr) {
+            if (void* ptr = try_allocate(*current, bytes, alignment)) {
+                m_num_bytes_allocated.fetch_add(bytes, std::memory_order_relaxed);
+                return ptr;
+            }
+        }
+
+        // Current block is exhausted: request a new one large enough to hold this allocation,
+        // unless another thread already did.
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_current.load(std::memory_order_relaxed) == current) {
+            const size_t block_size = std::max(m_next_block_size, bytes + alignment);
+            auto block = std::make_unique<Block>();
+            block->data = static_cast<std::byte*>(
+                m_upstream->allocate(block_size, alignof(std::max_align_t)));
+            block->size = block_size;
+            m_next_block_size = block_size * 2;
+            m_blocks.push_back(std::move(block));
+            m_current.store(m_blocks.back().get(), std::memory_order_release);
+        }
+    }
+}
+
+void MonotonicArena::do_deallocate(void*, size_t, size_t)
+{
+    // Memory is only reclaimed when the arena is released.
+}
+
+} // namespace lagrange
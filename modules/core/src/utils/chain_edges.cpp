@@ -15,9 +15,20 @@
 #include <lagrange/utils/invalid.h>
 #include <lagrange/utils/span.h>
 
+// clang-format off
+#include <lagrange/utils/warnoff.h>
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/parallel_reduce.h>
+#include <lagrange/utils/warnon.h>
+// clang-format on
+
 #include <algorithm>
 #include <array>
+#include <functional>
 #include <iostream>
+#include <iterator>
+#include <numeric>
 #include <vector>
 
 namespace lagrange {
@@ -44,6 +55,105 @@ span<const Index> get_edge(const span<const Index>& edges, Index i)
     return edges.subspan(i * 2, 2);
 }
 
+///
+/// Extracts the cycles formed by a set of edges under a successor map, using parallel pointer
+/// jumping. Each cycle starts at its smallest edge, and cycles are sorted by their first edge.
+/// This is the same output as a serial traversal growing a loop from each unvisited edge in
+/// increasing order.
+///
+/// @param[in]  active  Sorted list of edges to chain. Every successor of an active edge must be
+///                     active.
+/// @param[in]  next    Successor of each edge.
+///
+/// @return     The list of cycles, as lists of edge indices.
+///
+template <typename Index>
+std::vector<std::vector<Index>> extract_cycles(
+    const std::vector<Index>& active,
+    const std::vector<Index>& next)
+{
+    const size_t m = active.size();
+    if (m == 0) return {};
+
+    // Successor of each active edge, as an index into `active`.
+    std::vector<Index> to_local(next.size(), invalid<Index>());
+    tbb::parallel_for(size_t(0), m, [&](size_t i) { to_local[active[i]] = static_cast<Index>(i); });
+    std::vector<Index> succ(m);
+    tbb::parallel_for(size_t(0), m, [&](size_t i) {
+        succ[i] = to_local[next[active[i]]];
+        la_debug_assert(succ[i] != invalid<Index>());
+    });
+
+    // Label each edge with the smallest edge of its cycle. After k rounds, label[i] is the minimum
+    // over the 2^k edges following i. Once a round leaves all labels unchanged, each label is the
+    // minimum over its entire cycle.
+    std::vector<Index> label(m), jump(succ), label_tmp(m), jump_tmp(m);
+    std::iota(label.begin(), label.end(), Index(0));
+    for (bool changed = true; changed;) {
+        changed = tbb::parallel_reduce(
+            tbb::blocked_range<size_t>(0, m),
+            false,
+            [&](const tbb::blocked_range<size_t>& r, bool c) {
+                for (size_t i = r.begin(); i != r.end(); ++i) {
+                    label_tmp[i] = std::min(label[i], label[jump[i]]);
+                    jump_tmp[i] = jump[jump[i]];
+                    c = c || label_tmp[i] != label[i];
+                }
+                return c;
+            },
+            std::logical_or<bool>());
+        std::swap(label, label_tmp);
+        std::swap(jump, jump_tmp);
+    }
+
+    // List ranking: number of steps from each edge to the first edge of its cycle.
+    std::vector<Index> dist(m), dist_tmp(m);
+    tbb::parallel_for(size_t(0), m, [&](size_t i) {
+        const bool is_first = label[i] == static_cast<Index>(i);
+        dist[i] = is_first ? 0 : 1;
+        jump[i] = is_first ? static_cast<Index>(i) : succ[i];
+    });
+    for (bool changed = true; changed;) {
+        changed = tbb::parallel_reduce(
+            tbb::blocked_range<size_t>(0, m),
+            false,
+            [&](const tbb::blocked_range<size_t>& r, bool c) {
+                for (size_t i = r.begin(); i != r.end(); ++i) {
+                    dist_tmp[i] = dist[i] + dist[jump[i]];
+                    jump_tmp[i] = jump[jump[i]];
+                    c = c || jump_tmp[i] != jump[i];
+                }
+                return c;
+            },
+            std::logical_or<bool>());
+        std::swap(dist, dist_tmp);
+        std::swap(jump, jump_tmp);
+    }
+
+    // Cycle sizes, and cycle index of each first edge, in increasing order of first edge.
+    std::vector<Index> cycle_index(m, invalid<Index>());
+    std::vector<Index> cycle_size;
+    for (size_t i = 0; i < m; ++i) {
+        if (label[i] == static_cast<Index>(i)) {
+            cycle_index[i] = static_cast<Index>(cycle_size.size());
+            cycle_size.push_back(0);
+        }
+    }
+    for (size_t i = 0; i < m; ++i) {
+        ++cycle_size[cycle_index[label[i]]];
+    }
+
+    // An edge k steps before the first edge of its cycle sits at position (size - k) % size.
+    std::vector<std::vector<Index>> cycles(cycle_size.size());
+    tbb::parallel_for(size_t(0), cycles.size(), [&](size_t k) { cycles[k].resize(cycle_size[k]); });
+    tbb::parallel_for(size_t(0), m, [&](size_t i) {
+        const Index k = cycle_index[label[i]];
+        const Index n = cycle_size[k];
+        cycles[k][(n - dist[i]) % n] = active[i];
+    });
+    return cycles;
+}
+
 } // namespace detail
 
 
@@ -88,11 +198,11 @@ ChainEdgesResult<Index> chain_directed_edges(
             path_to_first_edge.push_back(i);
         }
     }
-    for (Index i = 0; i < num_edges; i++) {
+    tbb::parallel_for(Index(0), num_edges, [&](Index i) {
         auto e = detail::get_edge(edges, i);
         auto v1 = e[1];
         next_edge_along_path[i] = vertex_to_outgoing_edge[v1];
-    }
+    });
 
     ChainEdgesResult<Index> result;
     auto& loops = result.loops;
@@ -212,10 +322,20 @@ ChainEdgesResult<Index> chain_directed_edges(
         }
     }
 
-    // Extract simple loops.
-    for (Index i = 0; i < num_edges; i++) {
-        if (piece_indices[i] != invalid<size_t>()) continue;
-        loops.push_back(grow_chain(i));
+    // Extract simple loops. The remaining edges only go through vertices with a single incoming
+    // and outgoing edge, so they form disjoint cycles along `next_edge_along_path`, which are
+    // resolved in parallel. This is the common case for mesh boundaries, where all edges end up
+    // here.
+    {
+        std::vector<Index> remaining_edges;
+        for (Index i = 0; i < num_edges; i++) {
+            if (piece_indices[i] == invalid<size_t>()) remaining_edges.push_back(i);
+        }
+        auto cycles = detail::extract_cycles(remaining_edges, next_edge_along_path);
+        loops.insert(
+            loops.end(),
+            std::make_move_iterator(cycles.begin()),
+            std::make_move_iterator(cycles.end()));
     }
 
     if (!options.output_edge_index) {
@@ -230,7 +350,8 @@ ChainEdgesResult<Index> chain_directed_edges(
             }
             chain.push_back(next_vertex);
         }
-        for (auto& loop : loops) {
+        tbb::parallel_for(size_t(0), loops.size(), [&](size_t i) {
+            auto& loop = loops[i];
             for (auto& entry : loop) {
                 auto e = detail::get_edge(edges, entry);
                 entry = e[0];
@@ -238,7 +359,7 @@ ChainEdgesResult<Index> chain_directed_edges(
             if (options.close_loop_with_identical_vertices) {
                 loop.push_back(loop.front());
             }
-        }
+        });
     }
 
     return result;
@@ -18,6 +18,14 @@
 #include <lagrange/testing/check_mesh.h>
 #include <lagrange/views.h>
 
+#include <limits>
+
+// clang-format off
+#include <lagrange/utils/warnoff.h>
+#include <tbb/task_arena.h>
+#include <lagrange/utils/warnon.h>
+// clang-format on
+
 #ifdef LAGRANGE_ENABLE_LEGACY_FUNCTIONS
     #include <lagrange/Mesh.h>
     #include <lagrange/attributes/attribute_utils.h>
@@ -117,6 +125,129 @@ TEST_CASE("remove_duplicate_vertices", "[mesh_cleanup][surface][duplicate]")
     }
 }
 
+TEST_CASE("remove_duplicate_vertices with tolerance", "[mesh_cleanup][surface][duplicate]")
+{
+    using namespace lagrange;
+    using Scalar = double;
+    using Index = uint32_t;
+
+    // Two strips of quads with a seam that is not bit-identical.
+    constexpr Index n = 20;
+    SurfaceMesh<Scalar, Index> mesh;
+    for (Index side = 0; side < 2; ++side) {
+        const Index v0 = mesh.get_num_vertices();
+        for (Index i = 0; i <= n; ++i) {
+            const Scalar noise = (side == 1 ? 1e-7 * Scalar(i % 3) : 0);
+            mesh.add_vertex({Scalar(i), noise, noise});
+            mesh.add_vertex({Scalar(i), side == 0 ? -1 : 1, 0});
+        }
+        for (Index i = 0; i < n; ++i) {
+            mesh.add_quad(v0 + 2 * i, v0 + 2 * i + 2, v0 + 2 * i + 3, v0 + 2 * i + 1);
+        }
+    }
+    const Index num_vertices = mesh.get_num_vertices();
+
+    SECTION("exact")
+    {
+        remove_duplicate_vertices(mesh);
+        REQUIRE(mesh.get_num_vertices() == num_vertices - (n / 3 + 1));
+        lagrange::testing::check_mesh(mesh);
+    }
+
+    SECTION("tolerance")
+    {
+        RemoveDuplicateVerticesOptions opts;
+        opts.tolerance = 1e-5;
+        remove_duplicate_vertices(mesh, opts);
+        REQUIRE(mesh.get_num_vertices() == num_vertices - (n + 1));
+        REQUIRE(mesh.get_num_facets() == 2 * n);
+        lagrange::testing::check_mesh(mesh);
+
+        // Representatives are ordered by smallest input vertex index.
+        auto vertices = vertex_view(mesh);
+        for (Index i = 0; i <= n; ++i) {
+            REQUIRE(vertices(2 * i, 0) == Scalar(i));
+            REQUIRE(std::abs(vertices(2 * i, 1)) < 1e-6);
+        }
+    }
+
+    SECTION("tolerance too small")
+    {
+        RemoveDuplicateVerticesOptions opts;
+        opts.tolerance = 1e-8;
+        remove_duplicate_vertices(mesh, opts);
+        REQUIRE(mesh.get_num_vertices() == num_vertices - (n / 3 + 1));
+        lagrange::testing::check_mesh(mesh);
+    }
+
+    SECTION("boundary only")
+    {
+        // Isolated vertex close to the seam: welded unless only boundary vertices are considered.
+        mesh.add_vertex({1, 1e-7, 0});
+        RemoveDuplicateVerticesOptions opts;
+        opts.tolerance = 1e-5;
+        opts.boundary_only = true;
+        remove_duplicate_vertices(mesh, opts);
+        REQUIRE(mesh.get_num_vertices() == num_vertices + 1 - (n + 1));
+        lagrange::testing::check_mesh(mesh);
+    }
+
+    SECTION("extra attributes")
+    {
+        auto id = mesh.create_attribute<Scalar>(
+            "uv",
+            AttributeElement::Vertex,
+            AttributeUsage::UV,
+            2);
+        auto uv = attribute_matrix_ref<Scalar>(mesh, "uv");
+        uv.setZero();
+        // Make the uv of the first seam vertex of the second strip differ.
+        uv(2 * (n + 1), 0) = 1;
+        RemoveDuplicateVerticesOptions opts;
+        opts.tolerance = 1e-5;
+        opts.extra_attributes.push_back(id);
+        remove_duplicate_vertices(mesh, opts);
+        REQUIRE(mesh.get_num_vertices() == num_vertices - n);
+        lagrange::testing::check_mesh(mesh);
+    }
+
+    SECTION("tiny tolerance with large coordinates")
+    {
+        // Cell coordinates would overflow 64-bit integers with cells of the size of the tolerance.
+        SurfaceMesh<Scalar, Index> far_mesh;
+        far_mesh.add_vertex({1e10, -1e10, 0});
+        far_mesh.add_vertex({1e10, -1e10, 0});
+        far_mesh.add_vertex({1e10, -1e10 + 1e-5, 0});
+        far_mesh.add_vertex({-1e10, 1e10, 0});
+        far_mesh.add_vertex({-1e10, 1e10, 0});
+        RemoveDuplicateVerticesOptions opts;
+        opts.tolerance = 1e-300;
+        remove_duplicate_vertices(far_mesh, opts);
+        REQUIRE(far_mesh.get_num_vertices() == 3);
+        REQUIRE(far_mesh.get_position(1)[1] == -1e10 + 1e-5);
+    }
+
+    SECTION("non-finite positions")
+    {
+        mesh.add_vertex({std::numeric_limits<Scalar>::infinity(), 0, 0});
+        RemoveDuplicateVerticesOptions opts;
+        opts.tolerance = 1e-5;
+        LA_REQUIRE_THROWS(remove_duplicate_vertices(mesh, opts));
+    }
+
+    SECTION("deterministic")
+    {
+        RemoveDuplicateVerticesOptions opts;
+        opts.tolerance = 1e-5;
+        auto serial_mesh = mesh;
+        tbb::task_arena arena(1);
+        arena.execute([&] { remove_duplicate_vertices(serial_mesh, opts); });
+        remove_duplicate_vertices(mesh, opts);
+        REQUIRE(vertex_view(mesh) == vertex_view(serial_mesh));
+        REQUIRE(facet_view(mesh) == facet_view(serial_mesh));
+    }
+}
+
 TEST_CASE("remove_duplicate_vertices benchmark", "[surface][mesh_cleanup][duplicate][!benchmark]")
 {
     using namespace lagrange;
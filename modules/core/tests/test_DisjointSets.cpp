@@ -11,8 +11,17 @@
  */
 #include <lagrange/testing/common.h>
 
+#include <lagrange/utils/ConcurrentDisjointSets.h>
 #include <lagrange/utils/DisjointSets.h>
 
+// clang-format off
+#include <lagrange/utils/warnoff.h>
+#include <tbb/parallel_for.h>
+#include <lagrange/utils/warnon.h>
+// clang-format on
+
+#include <random>
+
 TEST_CASE("DisjointSets", "[disjoint_sets]")
 {
     using namespace lagrange;
@@ -88,3 +97,62 @@ TEST_CASE("DisjointSets", "[disjoint_sets]")
         REQUIRE(data.find(0) == data.find(2));
     }
 }
+
+TEST_CASE("ConcurrentDisjointSets", "[disjoint_sets]")
+{
+    using namespace lagrange;
+    ConcurrentDisjointSets<int> data;
+    std::vector<int> disjoint_set_indices;
+
+    SECTION("Init")
+    {
+        auto n = data.extract_disjoint_set_indices(disjoint_set_indices);
+        REQUIRE(n == 0);
+
+        data.init(10);
+        n = data.extract_disjoint_set_indices(disjoint_set_indices);
+        REQUIRE(n == 10);
+
+        data.clear();
+        n = data.extract_disjoint_set_indices(disjoint_set_indices);
+        REQUIRE(n == 0);
+    }
+
+    SECTION("Invalid index")
+    {
+        data.init(10);
+        LA_REQUIRE_THROWS(data.find(10));
+        LA_REQUIRE_THROWS(data.find(-1));
+    }
+
+    SECTION("Cyclic merge")
+    {
+        data.init(3);
+        REQUIRE(data.merge(2, 1) == 1);
+        REQUIRE(data.merge(1, 0) == 0);
+        REQUIRE(data.merge(0, 2) == 0);
+        REQUIRE(data.find(2) == 0);
+        REQUIRE(data.extract_disjoint_set_indices(disjoint_set_indices) == 1);
+    }
+
+    SECTION("Concurrent merge")
+    {
+        // Entries with the same value modulo k end up in the same set
+        constexpr int n = 100000;
+        constexpr int k = 37;
+        std::vector<std::pair<int, int>> pairs;
+        for (int i = k; i < n; ++i) pairs.emplace_back(i, i - k);
+        std::mt19937 gen(0);
+        std::shuffle(pairs.begin(), pairs.end(), gen);
+
+        data.init(n);
+        tbb::parallel_for(size_t(0), pairs.size(), [&](size_t i) {
+            data.merge(pairs[i].first, pairs[i].second);
+        });
+        REQUIRE(data.extract_disjoint_set_indices(disjoint_set_indices) == k);
+        for (int i = 0; i < n; ++i) {
+            REQUIRE(data.find(i) == i % k);
+            REQUIRE(disjoint_set_indices[i] == i % k);
+        }
+    }
+}
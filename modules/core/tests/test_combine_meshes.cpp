@@ -18,6 +18,10 @@
 #include <lagrange/map_attribute.h>
 #include <lagrange/views.h>
 
+#include <algorithm>
+#include <numeric>
+#include <thread>
+
 #ifdef LAGRANGE_ENABLE_LEGACY_FUNCTIONS
     #include <lagrange/combine_mesh_list.h>
     #include <lagrange/mesh_convert.h>
@@ -358,6 +362,130 @@ TEST_CASE("combine_meshes hybrid", "[surface][utilities]")
     REQUIRE(mesh.get_num_facets() == 392);
 }
 
+TEST_CASE("combine_meshes many meshes", "[surface][utilities]")
+{
+    using Scalar = double;
+    using Index = uint32_t;
+
+    auto add_attributes = [](SurfaceMesh<Scalar, Index>& mesh) {
+        std::vector<Index> vertex_ids(mesh.get_num_vertices());
+        std::iota(vertex_ids.begin(), vertex_ids.end(), Index(0));
+        mesh.template create_attribute<Index>(
+            "vertex_id",
+            AttributeElement::Vertex,
+            AttributeUsage::VertexIndex,
+            1,
+            vertex_ids);
+        std::vector<Scalar> x(mesh.get_num_vertices());
+        for (Index v = 0; v < mesh.get_num_vertices(); ++v) x[v] = mesh.get_position(v)[0];
+        mesh.template create_attribute<Scalar>(
+            "corner_x",
+            AttributeElement::Indexed,
+            AttributeUsage::Scalar,
+            1,
+            x,
+            mesh.get_corner_to_vertex().get_all());
+    };
+
+    // Large mesh, copied by parallel chunks
+    const Index n = 130;
+    SurfaceMesh<Scalar, Index> grid;
+    for (Index j = 0; j <= n; ++j) {
+        for (Index i = 0; i <= n; ++i) {
+            grid.add_vertex({Scalar(i), Scalar(j), 0});
+        }
+    }
+    for (Index j = 0; j < n; ++j) {
+        for (Index i = 0; i < n; ++i) {
+            const Index v0 = j * (n + 1) + i;
+            grid.add_triangle(v0, v0 + 1, v0 + n + 2);
+            grid.add_triangle(v0, v0 + n + 2, v0 + n + 1);
+        }
+    }
+    add_attributes(grid);
+
+    // Small hybrid mesh
+    SurfaceMesh<Scalar, Index> hybrid;
+    hybrid.add_vertices(5, {-1, 0, 0, -2, 0, 0, -2, 1, 0, -1, 1, 0, -3, 0, 0});
+    hybrid.add_quad(0, 1, 2, 3);
+    hybrid.add_triangle(1, 4, 2);
+    add_attributes(hybrid);
+
+    std::vector<SurfaceMesh<Scalar, Index>> meshes(500, hybrid);
+    meshes[250] = grid;
+
+    auto sizes = compute_combined_mesh_sizes<Scalar, Index>(meshes);
+    REQUIRE(sizes.num_vertices == 499 * 5 + grid.get_num_vertices());
+    REQUIRE(sizes.num_facets == 499 * 2 + grid.get_num_facets());
+    REQUIRE(sizes.num_corners == 499 * 7 + grid.get_num_corners());
+    REQUIRE(sizes.num_edges == 0);
+    REQUIRE(sizes.dimension == 3);
+    REQUIRE(sizes.vertex_per_facet == 0);
+
+    auto out_mesh = combine_meshes<Scalar, Index>(meshes);
+    REQUIRE(out_mesh.get_num_vertices() == sizes.num_vertices);
+    REQUIRE(out_mesh.get_num_facets() == sizes.num_facets);
+    REQUIRE(out_mesh.get_num_corners() == sizes.num_corners);
+
+    Index f_out = 0;
+    for (const auto& mesh : meshes) {
+        for (Index f = 0; f < mesh.get_num_facets(); ++f, ++f_out) {
+            REQUIRE(out_mesh.get_facet_size(f_out) == mesh.get_facet_size(f));
+        }
+    }
+
+    auto vertex_ids = out_mesh.template get_attribute<Index>("vertex_id").get_all();
+    for (Index v = 0; v < out_mesh.get_num_vertices(); ++v) {
+        REQUIRE(vertex_ids[v] == v);
+    }
+    const auto& corner_x = out_mesh.template get_indexed_attribute<Scalar>("corner_x");
+    for (Index c = 0; c < out_mesh.get_num_corners(); ++c) {
+        REQUIRE(
+            corner_x.values().get(corner_x.indices().get(c)) ==
+            out_mesh.get_position(out_mesh.get_corner_vertex(c))[0]);
+    }
+
+    // Regular meshes
+    std::vector<SurfaceMesh<Scalar, Index>> grids(3, grid);
+    sizes = compute_combined_mesh_sizes<Scalar, Index>(grids);
+    REQUIRE(sizes.vertex_per_facet == 3);
+    out_mesh = combine_meshes<Scalar, Index>(grids);
+    REQUIRE(out_mesh.is_triangle_mesh());
+    REQUIRE(vertex_view(out_mesh).bottomRows(grid.get_num_vertices()) == vertex_view(grid));
+    REQUIRE(
+        (facet_view(out_mesh).bottomRows(grid.get_num_facets()).array() ==
+         facet_view(grid).array() + 2 * grid.get_num_vertices())
+            .all());
+}
+
+TEST_CASE("combine_meshes serial callback", "[surface][utilities]")
+{
+    using Scalar = double;
+    using Index = uint32_t;
+
+    SurfaceMesh<Scalar, Index> mesh;
+    mesh.add_vertices(5, {-1, 0, 0, -2, 0, 0, -2, 1, 0, -1, 1, 0, -3, 0, 0});
+    mesh.add_quad(0, 1, 2, 3);
+    mesh.add_triangle(1, 4, 2);
+    std::vector<SurfaceMesh<Scalar, Index>> meshes(200, mesh);
+
+    // The callback is not thread-safe: it must be called once per mesh, from the calling thread.
+    const auto thread_id = std::this_thread::get_id();
+    std::vector<size_t> num_calls(meshes.size(), 0);
+    bool same_thread = true;
+    auto out_mesh = combine_meshes<Scalar, Index>(
+        meshes.size(),
+        [&](size_t i) -> const SurfaceMesh<Scalar, Index>& {
+            same_thread = same_thread && std::this_thread::get_id() == thread_id;
+            ++num_calls[i];
+            return meshes[i];
+        });
+    REQUIRE(same_thread);
+    REQUIRE(std::all_of(num_calls.begin(), num_calls.end(), [](size_t n) { return n == 1; }));
+    REQUIRE(out_mesh.get_num_vertices() == 200 * 5);
+    REQUIRE(out_mesh.get_num_facets() == 200 * 2);
+}
+
 TEST_CASE("combine_meshes benchmark", "[surface][utilities][!benchmark]")
 {
     using namespace lagrange;
@@ -25,9 +25,13 @@
 #include <lagrange/Attribute.h>
 #include <lagrange/SurfaceMesh.h>
 #include <lagrange/compute_components.h>
+#include <lagrange/utils/DisjointSets.h>
 #include <lagrange/mesh_convert.h>
+#include <lagrange/utils/invalid.h>
 #include <lagrange/views.h>
 
+#include <random>
+
 TEST_CASE("compute_components", "[surface][components][utilities]")
 {
     using namespace lagrange;
@@ -300,6 +304,112 @@ TEST_CASE("compute_components", "[surface][components][utilities]")
             REQUIRE(num_components == 2);
         }
     }
+
+    SECTION("Same partition as serial disjoint sets")
+    {
+        // Serial merging roots the component {0, 3} at facet 3, so serial disjoint sets number
+        // the facets of this mesh {1, 0, 0, 1}. Components are numbered by their smallest facet
+        // instead, which gives {0, 1, 1, 0}.
+        SurfaceMesh<Scalar, Index> mesh;
+        mesh.add_vertices(8);
+        mesh.add_triangle(0, 1, 2);
+        mesh.add_triangle(3, 4, 5);
+        mesh.add_triangle(3, 5, 6);
+        mesh.add_triangle(2, 1, 7);
+        mesh.initialize_edges();
+
+        for (auto type :
+             {ComponentOptions::ConnectivityType::Vertex,
+              ComponentOptions::ConnectivityType::Edge}) {
+            const bool by_vertex = (type == ComponentOptions::ConnectivityType::Vertex);
+            const Index num_elements = by_vertex ? mesh.get_num_vertices() : mesh.get_num_edges();
+            auto first_corner = [&](Index e) {
+                return by_vertex ? mesh.get_first_corner_around_vertex(e)
+                                 : mesh.get_first_corner_around_edge(e);
+            };
+            auto next_corner = [&](Index c) {
+                return by_vertex ? mesh.get_next_corner_around_vertex(c)
+                                 : mesh.get_next_corner_around_edge(c);
+            };
+
+            DisjointSets<Index> serial(mesh.get_num_facets());
+            for (Index e = 0; e < num_elements; ++e) {
+                Index rep_facet_id = invalid<Index>();
+                for (Index c = first_corner(e); c != invalid<Index>(); c = next_corner(c)) {
+                    const Index f = mesh.get_corner_facet(c);
+                    if (rep_facet_id == invalid<Index>()) {
+                        rep_facet_id = f;
+                    } else {
+                        serial.merge(rep_facet_id, f);
+                    }
+                }
+            }
+            std::vector<Index> serial_ids;
+            const size_t num_serial = serial.extract_disjoint_set_indices(serial_ids);
+
+            opt.connectivity_type = type;
+            REQUIRE(compute_components(mesh, opt) == num_serial);
+            auto ids = mesh.template get_attribute<Index>(opt.output_attribute_name).get_all();
+
+            // Same partition: serial and concurrent ids are related by a bijection.
+            std::vector<Index> serial_to_ids(num_serial, invalid<Index>());
+            std::vector<Index> ids_to_serial(num_serial, invalid<Index>());
+            for (Index f = 0; f < mesh.get_num_facets(); ++f) {
+                if (serial_to_ids[serial_ids[f]] == invalid<Index>()) {
+                    serial_to_ids[serial_ids[f]] = ids[f];
+                }
+                if (ids_to_serial[ids[f]] == invalid<Index>()) {
+                    ids_to_serial[ids[f]] = serial_ids[f];
+                }
+                REQUIRE(serial_to_ids[serial_ids[f]] == ids[f]);
+                REQUIRE(ids_to_serial[ids[f]] == serial_ids[f]);
+            }
+
+            // Numbered by smallest facet index.
+            REQUIRE(ids[0] == 0);
+            REQUIRE(ids[1] == 1);
+            REQUIRE(ids[2] == 1);
+            REQUIRE(ids[3] == 0);
+        }
+    }
+
+    SECTION("Deterministic component ids")
+    {
+        // Interleaved triangle strips, with facets in random order
+        constexpr Index num_strips = 64;
+        constexpr Index strip_length = 100;
+        std::vector<std::pair<Index, std::array<Index, 3>>> triangles;
+        for (Index k = 0; k < num_strips; ++k) {
+            const Index a = 2 * k * (strip_length + 1);
+            const Index b = a + strip_length + 1;
+            for (Index i = 0; i < strip_length; ++i) {
+                triangles.push_back({k, {a + i, a + i + 1, b + i}});
+                triangles.push_back({k, {b + i, a + i + 1, b + i + 1}});
+            }
+        }
+        std::mt19937 gen(0);
+        std::shuffle(triangles.begin(), triangles.end(), gen);
+
+        SurfaceMesh<Scalar, Index> mesh;
+        mesh.add_vertices(2 * num_strips * (strip_length + 1));
+        std::vector<Index> expected_ids(num_strips, invalid<Index>());
+        Index num_expected = 0;
+        for (const auto& [k, t] : triangles) {
+            mesh.add_triangle(t[0], t[1], t[2]);
+            if (expected_ids[k] == invalid<Index>()) expected_ids[k] = num_expected++;
+        }
+
+        for (auto type :
+             {ComponentOptions::ConnectivityType::Vertex,
+              ComponentOptions::ConnectivityType::Edge}) {
+            opt.connectivity_type = type;
+            REQUIRE(compute_components(mesh, opt) == num_strips);
+            auto ids = mesh.template get_attribute<Index>(opt.output_attribute_name).get_all();
+            for (Index f = 0; f < mesh.get_num_facets(); ++f) {
+                REQUIRE(ids[f] == expected_ids[triangles[f].first]);
+            }
+        }
+    }
 }
 
 TEST_CASE("compute_components benchmark", "[surface][components][utilities][!benchmark]")
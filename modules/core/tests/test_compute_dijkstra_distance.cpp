@@ -13,6 +13,7 @@
 #include <catch2/catch_approx.hpp>
 
 #include <lagrange/compute_dijkstra_distance.h>
+#include <lagrange/compute_vertex_vertex_adjacency.h>
 #include <lagrange/views.h>
 
 #ifdef LAGRANGE_ENABLE_LEGACY_FUNCTIONS
@@ -116,3 +117,107 @@ TEST_CASE("DijkstraDistance", "[dijstra][surface][triangle]")
         }
     }
 }
+
+TEST_CASE("DijkstraDistance parallel", "[dijstra][surface][triangle]")
+{
+    using namespace lagrange;
+    using Scalar = double;
+    using Index = uint32_t;
+
+    // Slightly perturbed triangulated grid
+    const Index n = 40;
+    SurfaceMesh<Scalar, Index> mesh;
+    for (Index j = 0; j <= n; ++j) {
+        for (Index i = 0; i <= n; ++i) {
+            const Scalar jitter = Scalar((i * 7 + j * 13) % 5) * 0.05;
+            mesh.add_vertex({Scalar(i) + jitter, Scalar(j) - jitter, jitter});
+        }
+    }
+    for (Index j = 0; j < n; ++j) {
+        for (Index i = 0; i < n; ++i) {
+            const Index v0 = j * (n + 1) + i;
+            mesh.add_triangle(v0, v0 + 1, v0 + n + 1);
+            mesh.add_triangle(v0 + n + 1, v0 + 1, v0 + n + 2);
+        }
+    }
+
+    auto check_same = [&](std::string_view name_a, std::string_view name_b) {
+        auto dist_a = attribute_vector_view<Scalar>(mesh, name_a);
+        auto dist_b = attribute_vector_view<Scalar>(mesh, name_b);
+        REQUIRE(dist_a.size() == dist_b.size());
+        for (Eigen::Index v = 0; v < dist_a.size(); ++v) {
+            REQUIRE(dist_a[v] == Catch::Approx(dist_b[v]).margin(1e-10));
+        }
+    };
+
+    for (Scalar radius : {0.0, 5.0, 17.5}) {
+        DijkstraDistanceOptions<Scalar, Index> options;
+        options.seed_facet = 517;
+        options.barycentric_coords = {0.2, 0.3, 0.5};
+        options.radius = radius;
+        options.output_involved_vertices = true;
+        options.output_attribute_name = "serial";
+        auto serial_vts = compute_dijkstra_distance(mesh, options);
+
+        options.parallel = true;
+        options.output_attribute_name = "parallel";
+        auto parallel_vts = compute_dijkstra_distance(mesh, options);
+        check_same("serial", "parallel");
+        REQUIRE(serial_vts.has_value());
+        REQUIRE(parallel_vts.has_value());
+        REQUIRE(serial_vts->size() == parallel_vts->size());
+
+        options.delta = 0.25;
+        options.output_attribute_name = "parallel_small_delta";
+        compute_dijkstra_distance(mesh, options);
+        check_same("serial", "parallel_small_delta");
+
+        // Buckets are sparse: a tiny delta must not allocate one bucket per delta step.
+        options.delta = 1e-12;
+        options.output_attribute_name = "parallel_tiny_delta";
+        compute_dijkstra_distance(mesh, options);
+        check_same("serial", "parallel_tiny_delta");
+
+        auto adjacency = compute_vertex_vertex_adjacency(mesh);
+        options.parallel = false;
+        options.vertex_adjacency = &adjacency;
+        options.output_attribute_name = "serial_adjacency";
+        auto adjacency_vts = compute_dijkstra_distance(mesh, options);
+        check_same("serial", "serial_adjacency");
+        REQUIRE(*adjacency_vts == *serial_vts);
+    }
+
+    SECTION("many queries")
+    {
+        const Index num_queries = 16;
+        std::vector<std::string> names(num_queries);
+        std::vector<DijkstraDistanceOptions<Scalar, Index>> queries(num_queries);
+        for (Index q = 0; q < num_queries; ++q) {
+            names[q] = "batch_" + std::to_string(q);
+            queries[q].seed_facet = (q * 211) % mesh.get_num_facets();
+            queries[q].barycentric_coords = {1, 0, 0};
+            queries[q].radius = Scalar(3 + q);
+            queries[q].output_attribute_name = names[q];
+            queries[q].output_involved_vertices = (q % 2 == 0);
+            queries[q].parallel = (q % 3 == 0);
+        }
+        auto results = compute_dijkstra_distance<Scalar, Index>(mesh, queries);
+        REQUIRE(results.size() == num_queries);
+
+        for (Index q = 0; q < num_queries; ++q) {
+            auto options = queries[q];
+            options.parallel = false;
+            options.output_attribute_name = "reference";
+            auto expected = compute_dijkstra_distance(mesh, options);
+            check_same(names[q], "reference");
+            REQUIRE(results[q].has_value() == expected.has_value());
+            if (expected.has_value()) {
+                REQUIRE(results[q]->size() == expected->size());
+            }
+        }
+
+        // Output attribute names must be distinct
+        queries[1].output_attribute_name = queries[0].output_attribute_name;
+        LA_REQUIRE_THROWS(compute_dijkstra_distance<Scalar, Index>(mesh, queries));
+    }
+}
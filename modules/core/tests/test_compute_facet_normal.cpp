@@ -18,6 +18,8 @@
 #include <lagrange/views.h>
 #include <catch2/catch_approx.hpp>
 
+#include <cmath>
+
 TEST_CASE("compute_facet_normal", "[core][normal]")
 {
     using namespace lagrange;
@@ -94,6 +96,39 @@ TEST_CASE("compute_facet_normal", "[core][normal]")
         Eigen::Vector3<Scalar> ground_truth(0, 0, 1);
         REQUIRE((normals - ground_truth.transpose()).squaredNorm() == Catch::Approx(0));
     }
+
+    SECTION("Triangle grid")
+    {
+        // The number of facets is not a multiple of the internal batch size.
+        SurfaceMesh<Scalar, Index> mesh;
+        const Index n = 6;
+        for (Index i = 0; i <= n; ++i) {
+            for (Index j = 0; j <= n; ++j) {
+                mesh.add_vertex({Scalar(i), Scalar(j), std::sin(Scalar(i * j))});
+            }
+        }
+        for (Index i = 0; i < n; ++i) {
+            for (Index j = 0; j < n; ++j) {
+                const Index v = i * (n + 1) + j;
+                mesh.add_triangle(v, v + n + 1, v + 1);
+                if (j + 1 < n) mesh.add_triangle(v + 1, v + n + 1, v + n + 2);
+            }
+        }
+        mesh.add_triangle(0, 1, 1);
+        REQUIRE(mesh.get_num_facets() % 8 != 0);
+
+        auto id = compute_facet_normal(mesh);
+        const auto& normals = matrix_view(mesh.get_attribute<Scalar>(id));
+        const auto& vertices = vertex_view(mesh);
+        for (Index f = 0; f < mesh.get_num_facets(); ++f) {
+            const auto fv = mesh.get_facet_vertices(f);
+            const Eigen::Vector3<Scalar> e1 = vertices.row(fv[1]) - vertices.row(fv[0]);
+            const Eigen::Vector3<Scalar> e2 = vertices.row(fv[2]) - vertices.row(fv[0]);
+            const Eigen::Vector3<Scalar> expected = e1.cross(e2).stableNormalized();
+            REQUIRE((normals.row(f).transpose() - expected).norm() < 1e-12);
+        }
+        REQUIRE(normals.row(mesh.get_num_facets() - 1).isZero());
+    }
 }
 
 #ifdef LAGRANGE_ENABLE_LEGACY_FUNCTIONS
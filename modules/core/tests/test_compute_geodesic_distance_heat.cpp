@@ -0,0 +1,123 @@
+/*
+ * Copyright 2024 Adobe. All rights reserved.
+ * This file is licensed to you under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License. You may obtain a copy
+ * of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under
+ * the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR REPRESENTATIONS
+ * OF ANY KIND, either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+ */
+#include <lagrange/testing/common.h>
+#include <catch2/catch_approx.hpp>
+
+#include <lagrange/compute_geodesic_distance_heat.h>
+#include <lagrange/views.h>
+
+#include <cmath>
+
+namespace {
+
+template <typename Scalar, typename Index>
+lagrange::SurfaceMesh<Scalar, Index> create_grid(Index n, Scalar size)
+{
+    lagrange::SurfaceMesh<Scalar, Index> mesh;
+    for (Index j = 0; j <= n; ++j) {
+        for (Index i = 0; i <= n; ++i) {
+            mesh.add_vertex({size * Scalar(i) / Scalar(n), size * Scalar(j) / Scalar(n), 0});
+        }
+    }
+    for (Index j = 0; j < n; ++j) {
+        for (Index i = 0; i < n; ++i) {
+            const Index v0 = j * (n + 1) + i;
+            mesh.add_triangle(v0, v0 + 1, v0 + n + 2);
+            mesh.add_triangle(v0, v0 + n + 2, v0 + n + 1);
+        }
+    }
+    return mesh;
+}
+
+} // namespace
+
+TEST_CASE("compute_geodesic_distance_heat", "[surface][geodesic]")
+{
+    using namespace lagrange;
+    using Scalar = double;
+    using Index = uint32_t;
+
+    const Index n = 40;
+    auto mesh = create_grid<Scalar, Index>(n, 2.0);
+    const Index num_vertices = mesh.get_num_vertices();
+    const Index center = (n / 2) * (n + 1) + n / 2;
+    const Index corner = 0;
+    auto vertices = vertex_view(mesh);
+
+    SECTION("planar distance")
+    {
+        Index sources[] = {center};
+        auto id = compute_geodesic_distance_heat<Scalar, Index>(mesh, sources);
+        REQUIRE(mesh.get_attribute_name(id) == "@geodesic_distance");
+        auto dist = attribute_vector_view<Scalar>(mesh, id);
+        REQUIRE(dist[center] == Catch::Approx(0).margin(1e-12));
+
+        // Away from the source, the heat method closely matches the Euclidean distance, including
+        // along directions that are not aligned with grid edges.
+        for (Index v = 0; v < num_vertices; ++v) {
+            const Scalar expected = (vertices.row(v) - vertices.row(center)).norm();
+            if (expected < 0.2) continue;
+            REQUIRE(std::abs(dist[v] - expected) < 0.05 * expected + 0.01);
+        }
+    }
+
+    SECTION("solver reuse")
+    {
+        GeodesicSolver<Scalar, Index> solver(mesh);
+        REQUIRE(solver.get_num_vertices() == num_vertices);
+
+        std::vector<Scalar> dist_center(num_vertices);
+        std::vector<Scalar> dist_corner(num_vertices);
+        std::vector<Scalar> dist_both(num_vertices);
+        std::vector<Index> both = {center, corner};
+        solver.compute(span<const Index>(&center, 1), dist_center);
+        solver.compute(span<const Index>(&corner, 1), dist_corner);
+        solver.compute(both, dist_both);
+
+        // Multiple sources give approximately the minimum of individual distances
+        for (Index v = 0; v < num_vertices; ++v) {
+            const Scalar expected = std::min(dist_center[v], dist_corner[v]);
+            REQUIRE(std::abs(dist_both[v] - expected) < 0.15);
+        }
+
+        // Batched queries match individual queries
+        std::vector<std::vector<Index>> source_sets = {{center}, {corner}, both};
+        std::vector<Scalar> dist_batch(num_vertices * source_sets.size());
+        solver.compute(source_sets, dist_batch);
+        for (Index v = 0; v < num_vertices; ++v) {
+            REQUIRE(dist_batch[v] == Catch::Approx(dist_center[v]));
+            REQUIRE(dist_batch[num_vertices + v] == Catch::Approx(dist_corner[v]));
+            REQUIRE(dist_batch[2 * num_vertices + v] == Catch::Approx(dist_both[v]));
+        }
+
+        LA_REQUIRE_THROWS(solver.compute(both, span<Scalar>(dist_batch.data(), 3)));
+        LA_REQUIRE_THROWS(solver.compute(span<const Index>(), dist_center));
+    }
+
+    SECTION("float")
+    {
+        auto mesh_f = create_grid<float, uint64_t>(20, 1.0f);
+        uint64_t sources[] = {0};
+        auto id = compute_geodesic_distance_heat<float, uint64_t>(mesh_f, sources);
+        auto dist = attribute_vector_view<float>(mesh_f, id);
+        const uint64_t opposite = mesh_f.get_num_vertices() - 1;
+        REQUIRE(dist[opposite] == Catch::Approx(std::sqrt(2.0f)).epsilon(0.05));
+    }
+
+    SECTION("non-triangle mesh")
+    {
+        SurfaceMesh<Scalar, Index> quad;
+        quad.add_vertices(4);
+        quad.add_quad(0, 1, 2, 3);
+        LA_REQUIRE_THROWS(GeodesicSolver<Scalar, Index>(quad));
+    }
+}
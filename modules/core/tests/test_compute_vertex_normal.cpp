@@ -19,6 +19,7 @@
 #include <lagrange/compute_vertex_normal.h>
 #include <lagrange/create_mesh.h>
 #include <lagrange/mesh_convert.h>
+#include <lagrange/triangulate_polygonal_facets.h>
 #include <lagrange/utils/geometry3d.h>
 #include <lagrange/views.h>
 
@@ -95,6 +96,60 @@ TEST_CASE("compute_vertex_normal: corner normal attr", "[surface][attribute][nor
     REQUIRE(!mesh.has_attribute(corner_normal_name));
 }
 
+TEST_CASE("compute_vertex_normal: triangle mesh", "[surface][attribute][normal][utilities]")
+{
+    using namespace lagrange;
+    using Scalar = double;
+    using Index = uint32_t;
+    using Vector3 = Eigen::Vector3<Scalar>;
+
+    // Perturbed triangulated cube, with a number of facets that is not a multiple of the internal
+    // batch size.
+    auto mesh = make_cube<Scalar, Index>();
+    triangulate_polygonal_facets(mesh);
+    mesh.add_vertex({0.5, 0.5, 1.5});
+    mesh.add_triangle(4, 5, 8);
+    REQUIRE(mesh.get_num_facets() % 8 != 0);
+    auto vertices = vertex_ref(mesh);
+    for (Index v = 0; v < 8; ++v) {
+        vertices.row(v) += 0.1 * Eigen::RowVector3d(std::sin(v), std::cos(v), std::sin(2. * v));
+    }
+
+    for (auto weighting :
+         {NormalWeightingType::Uniform,
+          NormalWeightingType::CornerTriangleArea,
+          NormalWeightingType::Angle}) {
+        // Reference normals, accumulated one corner at a time.
+        RowMatrix<Scalar> expected = RowMatrix<Scalar>::Zero(mesh.get_num_vertices(), 3);
+        for (Index c = 0; c < mesh.get_num_corners(); ++c) {
+            const Index f = mesh.get_corner_facet(c);
+            const Index lc = c - mesh.get_facet_corner_begin(f);
+            const auto fv = mesh.get_facet_vertices(f);
+            const Vector3 p = vertices.row(fv[lc]);
+            const Vector3 e_next = Vector3(vertices.row(fv[(lc + 1) % 3])) - p;
+            const Vector3 e_prev = Vector3(vertices.row(fv[(lc + 2) % 3])) - p;
+            Vector3 n = e_next.cross(e_prev);
+            if (weighting == NormalWeightingType::Uniform) {
+                n.stableNormalize();
+            } else if (weighting == NormalWeightingType::Angle) {
+                n = n.stableNormalized() * std::atan2(n.norm(), e_next.dot(e_prev));
+            }
+            expected.row(fv[lc]) += n.transpose();
+        }
+        expected.rowwise().normalize();
+
+        VertexNormalOptions options;
+        options.weight_type = weighting;
+        auto copy = mesh;
+        for (bool with_edges : {false, true}) {
+            if (with_edges) copy.initialize_edges();
+            auto id = compute_vertex_normal(copy, options);
+            auto normals = matrix_view(copy.template get_attribute<Scalar>(id));
+            REQUIRE((normals - expected).norm() < 1e-12);
+        }
+    }
+}
+
 TEST_CASE("compute_vertex_normal Waffle", "[surface][attribute][normal][utilities]" LA_CORP_FLAG)
 {
     using namespace lagrange;
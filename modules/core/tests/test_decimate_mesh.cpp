@@ -0,0 +1,234 @@
+/*
+ * Copyright 2024 Adobe. All rights reserved.
+ * This file is licensed to you under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License. You may obtain a copy
+ * of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under
+ * the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR REPRESENTATIONS
+ * OF ANY KIND, either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+ */
+#include <lagrange/testing/check_mesh.h>
+#include <lagrange/testing/common.h>
+#include <lagrange/testing/create_test_mesh.h>
+
+#include <lagrange/attribute_names.h>
+#include <lagrange/compute_seam_edges.h>
+#include <lagrange/decimate_mesh.h>
+#include <lagrange/topology.h>
+
+#include <cmath>
+
+namespace {
+
+using Scalar = double;
+using Index = uint32_t;
+
+///
+/// Creates a n x n grid in the unit square, with an indexed UV attribute that has a seam along
+/// the middle column.
+///
+lagrange::SurfaceMesh<Scalar, Index> create_grid(Index n, bool flat)
+{
+    lagrange::SurfaceMesh<Scalar, Index> mesh;
+    for (Index j = 0; j <= n; ++j) {
+        for (Index i = 0; i <= n; ++i) {
+            const Scalar x = Scalar(i) / n;
+            const Scalar y = Scalar(j) / n;
+            const Scalar z = flat ? 0 : 0.2 * std::sin(3 * x) * std::cos(2 * y);
+            mesh.add_vertex({x, y, z});
+        }
+    }
+    auto vid = [&](Index i, Index j) { return j * (n + 1) + i; };
+    for (Index j = 0; j < n; ++j) {
+        for (Index i = 0; i < n; ++i) {
+            mesh.add_triangle(vid(i, j), vid(i + 1, j), vid(i + 1, j + 1));
+            mesh.add_triangle(vid(i, j), vid(i + 1, j + 1), vid(i, j + 1));
+        }
+    }
+
+    // UV values: one per vertex, plus a duplicate of the middle column for the right side
+    const Index num_vertices = mesh.get_num_vertices();
+    std::vector<Scalar> uv_values;
+    for (Index v = 0; v < num_vertices; ++v) {
+        auto p = mesh.get_position(v);
+        uv_values.insert(uv_values.end(), {p[0], p[1]});
+    }
+    for (Index j = 0; j <= n; ++j) {
+        uv_values.insert(uv_values.end(), {0.75, Scalar(j) / n});
+    }
+    std::vector<Index> uv_indices(mesh.get_num_corners());
+    for (Index f = 0; f < mesh.get_num_facets(); ++f) {
+        const bool right = mesh.get_position(mesh.get_facet_vertices(f)[1])[0] > 0.5 + 1e-6;
+        for (Index c = mesh.get_facet_corner_begin(f); c < mesh.get_facet_corner_end(f); ++c) {
+            const Index v = mesh.get_corner_vertex(c);
+            const Index i = v % (n + 1);
+            uv_indices[c] = (right && i == n / 2) ? num_vertices + v / (n + 1) : v;
+        }
+    }
+    mesh.template create_attribute<Scalar>(
+        lagrange::AttributeName::texcoord,
+        lagrange::AttributeElement::Indexed,
+        lagrange::AttributeUsage::UV,
+        2,
+        uv_values,
+        uv_indices);
+    return mesh;
+}
+
+size_t count_seam_edges(lagrange::SurfaceMesh<Scalar, Index>& mesh)
+{
+    auto id = lagrange::compute_seam_edges(
+        mesh,
+        mesh.get_attribute_id(lagrange::AttributeName::texcoord));
+    auto is_seam = mesh.get_attribute<uint8_t>(id).get_all();
+    return std::count(is_seam.begin(), is_seam.end(), uint8_t(1));
+}
+
+size_t count_boundary_vertices(lagrange::SurfaceMesh<Scalar, Index>& mesh)
+{
+    mesh.initialize_edges();
+    std::vector<uint8_t> on_boundary(mesh.get_num_vertices(), 0);
+    for (Index e = 0; e < mesh.get_num_edges(); ++e) {
+        if (!mesh.is_boundary_edge(e)) continue;
+        for (Index v : mesh.get_edge_vertices(e)) on_boundary[v] = 1;
+    }
+    return std::count(on_boundary.begin(), on_boundary.end(), uint8_t(1));
+}
+
+} // namespace
+
+TEST_CASE("decimate_mesh", "[core][decimate]")
+{
+    SECTION("Flat grid")
+    {
+        auto mesh = create_grid(16, true);
+        lagrange::DecimationOptions options;
+        options.target_num_facets = 4;
+        options.max_error = 1e-6;
+        options.attribute_weight = 0;
+        lagrange::decimate_mesh(mesh, options);
+        lagrange::testing::check_mesh(mesh);
+        REQUIRE(mesh.get_num_facets() <= 12);
+        REQUIRE(lagrange::is_manifold(mesh));
+        REQUIRE(!mesh.has_edges());
+
+        // The UV seam and the square boundary are preserved
+        REQUIRE(count_seam_edges(mesh) > 0);
+        const auto& uv = mesh.get_indexed_attribute<Scalar>(lagrange::AttributeName::texcoord);
+        REQUIRE(lagrange::testing::is_in_range(
+            uv.indices().get_all(),
+            Index(0),
+            static_cast<Index>(uv.values().get_num_elements())));
+        for (Index v = 0; v < mesh.get_num_vertices(); ++v) {
+            auto p = mesh.get_position(v);
+            REQUIRE(std::abs(p[2]) == 0);
+        }
+    }
+
+    SECTION("Curved grid")
+    {
+        auto mesh = create_grid(20, false);
+        const size_t num_seam_edges = count_seam_edges(mesh);
+        lagrange::DecimationOptions options;
+        options.target_facet_ratio = 0.25;
+        lagrange::decimate_mesh(mesh, options);
+        lagrange::testing::check_mesh(mesh);
+        REQUIRE(mesh.get_num_facets() <= 200);
+        REQUIRE(mesh.get_num_facets() > 150);
+        REQUIRE(lagrange::is_manifold(mesh));
+        REQUIRE(count_seam_edges(mesh) > 0);
+        REQUIRE(count_seam_edges(mesh) <= num_seam_edges);
+    }
+
+    SECTION("Lock boundary")
+    {
+        auto mesh = create_grid(10, false);
+        const size_t num_boundary_vertices = count_boundary_vertices(mesh);
+        lagrange::DecimationOptions options;
+        options.target_facet_ratio = 0.2;
+        options.lock_boundary = true;
+        lagrange::decimate_mesh(mesh, options);
+        lagrange::testing::check_mesh(mesh);
+        REQUIRE(mesh.has_edges());
+        REQUIRE(mesh.get_num_facets() < 200);
+        REQUIRE(count_boundary_vertices(mesh) == num_boundary_vertices);
+    }
+
+    SECTION("Max error")
+    {
+        // Indexed normals of the test sphere are per-facet, which would lock every vertex
+        lagrange::testing::CreateOptions create_options;
+        create_options.with_indexed_normal = false;
+        auto mesh = lagrange::testing::create_test_sphere<Scalar, Index>(create_options);
+        const Index num_facets = mesh.get_num_facets();
+        lagrange::DecimationOptions options;
+        options.target_num_facets = 0;
+        options.max_error = 0;
+        options.attribute_weight = 0;
+        lagrange::decimate_mesh(mesh, options);
+        REQUIRE(mesh.get_num_facets() == num_facets);
+
+        options.max_error = 0.1;
+        lagrange::decimate_mesh(mesh, options);
+        lagrange::testing::check_mesh(mesh);
+        REQUIRE(mesh.get_num_facets() < num_facets);
+        REQUIRE(mesh.get_num_facets() >= 4);
+        REQUIRE(lagrange::compute_euler(mesh) == 2);
+    }
+
+    SECTION("Deterministic")
+    {
+        auto mesh0 = create_grid(20, false);
+        auto mesh1 = create_grid(20, false);
+        lagrange::decimate_mesh(mesh0);
+        lagrange::decimate_mesh(mesh1);
+        auto f0 = mesh0.get_corner_to_vertex().get_all();
+        auto f1 = mesh1.get_corner_to_vertex().get_all();
+        REQUIRE(std::equal(f0.begin(), f0.end(), f1.begin(), f1.end()));
+    }
+
+    SECTION("Multiple meshes")
+    {
+        auto mesh0 = create_grid(10, true);
+        auto mesh1 = create_grid(10, false);
+        std::array<lagrange::SurfaceMesh<Scalar, Index>*, 2> meshes = {&mesh0, &mesh1};
+        std::array<size_t, 2> min_num_facets = {0, 150};
+        lagrange::DecimationOptions options;
+        options.target_num_facets = 200;
+        lagrange::decimate_meshes<Scalar, Index>(meshes, options, {}, min_num_facets);
+        REQUIRE(mesh0.get_num_facets() + mesh1.get_num_facets() <= 200);
+        REQUIRE(mesh1.get_num_facets() >= 150);
+
+        // The flat mesh is simplified first
+        REQUIRE(mesh0.get_num_facets() < mesh1.get_num_facets());
+    }
+
+    SECTION("Non-manifold edge")
+    {
+        // Attach two extra fins to an interior edge so that four facets share it, with UV indices
+        // that differ around the edge.
+        auto mesh = create_grid(6, false);
+        const Index a = 3 * 7 + 2;
+        const Index b = 3 * 7 + 3;
+        for (Scalar h : {0.3, -0.3}) {
+            const Index w = mesh.get_num_vertices();
+            mesh.add_vertex({2. / 6, 3. / 6, h});
+            mesh.add_triangle(a, b, w);
+        }
+        lagrange::DecimationOptions options;
+        options.target_num_facets = 20;
+        lagrange::decimate_mesh(mesh, options);
+        REQUIRE(mesh.get_num_facets() < 74);
+        lagrange::testing::check_mesh(mesh);
+    }
+
+    SECTION("Non-triangle mesh")
+    {
+        lagrange::SurfaceMesh<Scalar, Index> mesh;
+        mesh.add_vertices(4, {0, 0, 0, 1, 0, 0, 1, 1, 0, 0, 1, 0});
+        mesh.add_quad(0, 1, 2, 3);
+        LA_REQUIRE_THROWS(lagrange::decimate_mesh(mesh));
+    }
+}
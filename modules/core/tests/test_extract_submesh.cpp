@@ -16,7 +16,9 @@
     #include <lagrange/create_mesh.h>
 #endif
 
+#include <lagrange/IndexedAttribute.h>
 #include <lagrange/Logger.h>
+#include <lagrange/attribute_names.h>
 #include <lagrange/common.h>
 #include <lagrange/compute_facet_normal.h>
 #include <lagrange/compute_vertex_normal.h>
@@ -26,6 +28,7 @@
 #include <lagrange/utils/range.h>
 #include <lagrange/views.h>
 
+#include <algorithm>
 #include <array>
 
 namespace {
@@ -213,6 +216,30 @@ TEST_CASE("extract_submesh", "[core][utilities][submesh]")
             options.source_vertex_attr_name,
             options.source_facet_attr_name);
     }
+    SECTION("Indexed attributes")
+    {
+        // Value buffers are copied as a whole, and value indices are unchanged.
+        std::array<const Index, 2> selected_facets{3, 7};
+        auto submesh = lagrange::extract_submesh(
+            mesh,
+            {selected_facets.data(), selected_facets.size()},
+            options);
+        const auto& uv = mesh.get_indexed_attribute<Scalar>(lagrange::AttributeName::texcoord);
+        const auto& sub_uv =
+            submesh.get_indexed_attribute<Scalar>(lagrange::AttributeName::texcoord);
+        REQUIRE(sub_uv.values().get_all().size() == uv.values().get_all().size());
+        REQUIRE(std::equal(
+            sub_uv.values().get_all().begin(),
+            sub_uv.values().get_all().end(),
+            uv.values().get_all().begin()));
+        for (Index f = 0; f < submesh.get_num_facets(); ++f) {
+            const Index c0 = submesh.get_facet_corner_begin(f);
+            const Index source_c0 = mesh.get_facet_corner_begin(selected_facets[f]);
+            for (Index lv = 0; lv < submesh.get_facet_size(f); ++lv) {
+                REQUIRE(sub_uv.indices().get(c0 + lv) == uv.indices().get(source_c0 + lv));
+            }
+        }
+    }
 }
 
 TEST_CASE("extract_submesh benchmark", "[core][utilities][submesh][!benchmark]")
@@ -0,0 +1,193 @@
+/*
+ * Copyright 2024 Adobe. All rights reserved.
+ * This file is licensed to you under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License. You may obtain a copy
+ * of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under
+ * the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR REPRESENTATIONS
+ * OF ANY KIND, either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+ */
+#include <lagrange/testing/common.h>
+
+#include <lagrange/Attribute.h>
+#include <lagrange/compute_area.h>
+#include <lagrange/compute_dihedral_angles.h>
+#include <lagrange/compute_edge_lengths.h>
+#include <lagrange/compute_facet_normal.h>
+#include <lagrange/compute_vertex_normal.h>
+#include <lagrange/views.h>
+
+#include <cmath>
+#include <string_view>
+#include <vector>
+
+namespace {
+
+template <typename Scalar, typename Index>
+lagrange::SurfaceMesh<Scalar, Index> create_bumpy_grid(Index n)
+{
+    lagrange::SurfaceMesh<Scalar, Index> mesh;
+    for (Index j = 0; j <= n; ++j) {
+        for (Index i = 0; i <= n; ++i) {
+            const Scalar x = Scalar(i) / Scalar(n);
+            const Scalar y = Scalar(j) / Scalar(n);
+            const Scalar z = Scalar(0.1) * std::sin(Scalar(7) * x) * std::cos(Scalar(5) * y);
+            mesh.add_vertex({x, y, z});
+        }
+    }
+    for (Index j = 0; j < n; ++j) {
+        for (Index i = 0; i < n; ++i) {
+            const Index v0 = j * (n + 1) + i;
+            mesh.add_triangle(v0, v0 + 1, v0 + n + 2);
+            mesh.add_triangle(v0, v0 + n + 2, v0 + n + 1);
+        }
+    }
+    return mesh;
+}
+
+template <typename Scalar, typename Index>
+void require_same_attribute(
+    const lagrange::SurfaceMesh<Scalar, Index>& a,
+    const lagrange::SurfaceMesh<Scalar, Index>& b,
+    std::string_view name)
+{
+    auto va = lagrange::attribute_matrix_view<Scalar>(a, name);
+    auto vb = lagrange::attribute_matrix_view<Scalar>(b, name);
+    REQUIRE(va.rows() == vb.rows());
+    REQUIRE(va.cols() == vb.cols());
+    REQUIRE((va - vb).cwiseAbs().maxCoeff() < 1e-12);
+}
+
+} // namespace
+
+TEST_CASE("incremental update", "[surface][incremental]")
+{
+    using namespace lagrange;
+    using Scalar = double;
+    using Index = uint32_t;
+
+    auto mesh = create_bumpy_grid<Scalar, Index>(12);
+    mesh.initialize_edges();
+    compute_facet_normal(mesh);
+    compute_vertex_normal(mesh);
+    compute_facet_area(mesh);
+    compute_edge_lengths(mesh);
+    DihedralAngleOptions dihedral_options;
+    dihedral_options.keep_facet_normals = true;
+    compute_dihedral_angles(mesh, dihedral_options);
+
+    // Sculpt a few vertices, including a boundary vertex.
+    std::vector<Index> modified = {0, 40, 41, 90};
+    for (Index v : modified) {
+        auto p = mesh.ref_position(v);
+        p[2] += 0.25;
+        p[0] += 0.01;
+    }
+
+    // Reference: full recomputation on a copy.
+    auto expected = mesh;
+    compute_facet_normal(expected);
+    compute_vertex_normal(expected);
+    compute_facet_area(expected);
+    compute_edge_lengths(expected);
+    compute_dihedral_angles(expected, dihedral_options);
+
+    SECTION("facet normal")
+    {
+        update_facet_normal<Scalar, Index>(mesh, modified);
+        require_same_attribute(mesh, expected, "@facet_normal");
+    }
+
+    SECTION("vertex normal")
+    {
+        update_vertex_normal<Scalar, Index>(mesh, modified);
+        require_same_attribute(mesh, expected, "@vertex_normal");
+    }
+
+    SECTION("facet area")
+    {
+        update_facet_area<Scalar, Index>(mesh, modified);
+        require_same_attribute(mesh, expected, "@facet_area");
+    }
+
+    SECTION("edge lengths")
+    {
+        update_edge_lengths<Scalar, Index>(mesh, modified);
+        require_same_attribute(mesh, expected, "@edge_length");
+    }
+
+    SECTION("dihedral angles")
+    {
+        update_dihedral_angles<Scalar, Index>(mesh, modified, dihedral_options);
+        require_same_attribute(mesh, expected, "@dihedral_angle");
+        require_same_attribute(mesh, expected, "@facet_normal");
+    }
+
+    SECTION("braced default options select the full computation")
+    {
+        compute_facet_normal(mesh, {});
+        compute_vertex_normal(mesh, {});
+        compute_facet_area(mesh, {});
+        compute_edge_lengths(mesh, {});
+        require_same_attribute(mesh, expected, "@facet_normal");
+        require_same_attribute(mesh, expected, "@vertex_normal");
+        require_same_attribute(mesh, expected, "@facet_area");
+        require_same_attribute(mesh, expected, "@edge_length");
+    }
+
+    SECTION("stale attributes are left untouched")
+    {
+        // Only the modified region is recomputed, so an empty list is a no-op.
+        update_facet_area<Scalar, Index>(mesh, span<const Index>());
+        auto area = attribute_vector_view<Scalar>(mesh, "@facet_area");
+        auto expected_area = attribute_vector_view<Scalar>(expected, "@facet_area");
+        REQUIRE((area - expected_area).cwiseAbs().maxCoeff() > 1e-6);
+    }
+
+    SECTION("missing attribute falls back to full computation")
+    {
+        FacetAreaOptions options;
+        options.output_attribute_name = "area";
+        update_facet_area<Scalar, Index>(mesh, modified, options);
+        auto area = attribute_vector_view<Scalar>(mesh, "area");
+        auto expected_area = attribute_vector_view<Scalar>(expected, "@facet_area");
+        REQUIRE((area - expected_area).cwiseAbs().maxCoeff() < 1e-12);
+    }
+}
+
+TEST_CASE("attribute generation", "[surface][incremental]")
+{
+    using namespace lagrange;
+    using Scalar = double;
+    using Index = uint32_t;
+
+    auto mesh = create_bumpy_grid<Scalar, Index>(2);
+    const auto position_id = mesh.attr_id_vertex_to_position();
+
+    const auto g0 = mesh.get_attribute_generation(position_id);
+    [[maybe_unused]] auto p = mesh.get_position(0);
+    REQUIRE(mesh.get_attribute_generation(position_id) == g0);
+
+    mesh.ref_position(0)[2] = 1;
+    const auto g1 = mesh.get_attribute_generation(position_id);
+    REQUIRE(g1 > g0);
+
+    // Copies keep their generation, and diverge once written to.
+    auto copy = mesh;
+    REQUIRE(copy.get_attribute_generation(position_id) == g1);
+    copy.ref_position(1)[2] = 1;
+    REQUIRE(copy.get_attribute_generation(position_id) > g1);
+    REQUIRE(mesh.get_attribute_generation(position_id) == g1);
+
+    // Recreating an attribute with the same name never reuses a previous generation.
+    auto id = mesh.create_attribute<int>("flag", AttributeElement::Vertex);
+    const auto h0 = mesh.get_attribute_generation("flag");
+    mesh.ref_attribute<int>(id).ref(0) = 1;
+    const auto h1 = mesh.get_attribute_generation(id);
+    REQUIRE(h1 > h0);
+    mesh.delete_attribute("flag");
+    id = mesh.create_attribute<int>("flag", AttributeElement::Vertex);
+    REQUIRE(mesh.get_attribute_generation(id) > h1);
+}
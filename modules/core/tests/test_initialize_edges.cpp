@@ -11,10 +11,120 @@
  */
 #include <lagrange/Logger.h>
 #include <lagrange/SurfaceMesh.h>
+#include <lagrange/compute_vertex_corner_adjacency.h>
 #include <lagrange/testing/common.h>
 
 #include <catch2/benchmark/catch_benchmark.hpp>
 
+#include <algorithm>
+#include <map>
+#include <vector>
+
+TEST_CASE("initialize_edges parallel", "[core][surface]")
+{
+    using Scalar = float;
+    using Index = uint32_t;
+
+    // Hybrid grid with a non-manifold fin, facets in scrambled order
+    constexpr Index n = 30;
+    lagrange::SurfaceMesh<Scalar, Index> mesh;
+    for (Index j = 0; j <= n; ++j) {
+        for (Index i = 0; i <= n; ++i) {
+            mesh.add_vertex({Scalar(i), Scalar(j), 0});
+        }
+    }
+    const Index apex = mesh.get_num_vertices();
+    mesh.add_vertex({0, 0, 1});
+    mesh.add_vertex({0, 0, 2});
+    std::vector<std::vector<Index>> facets;
+    for (Index j = 0; j < n; ++j) {
+        for (Index i = 0; i < n; ++i) {
+            const Index v0 = j * (n + 1) + i;
+            const Index v1 = v0 + 1;
+            const Index v2 = v0 + n + 2;
+            const Index v3 = v0 + n + 1;
+            if ((i + j) % 3 == 0) {
+                facets.push_back({v0, v1, v2, v3});
+            } else {
+                facets.push_back({v0, v1, v2});
+                facets.push_back({v0, v2, v3});
+            }
+        }
+    }
+    facets.push_back({0, 1, apex});
+    facets.push_back({1, 0, apex + 1});
+    for (size_t f = 0; f < facets.size(); ++f) {
+        const auto& facet = facets[(f * 7919) % facets.size()];
+        mesh.add_polygon({facet.data(), facet.size()});
+    }
+
+    // Reference: unique edges in lexicographic order, corners in increasing order
+    auto make_edge = [](Index v0, Index v1) {
+        return std::make_pair(std::min(v0, v1), std::max(v0, v1));
+    };
+    std::map<std::pair<Index, Index>, std::vector<Index>> edge_corners;
+    for (Index f = 0; f < mesh.get_num_facets(); ++f) {
+        const Index c_begin = mesh.get_facet_corner_begin(f);
+        const Index c_end = mesh.get_facet_corner_end(f);
+        for (Index c = c_begin; c < c_end; ++c) {
+            Index v0 = mesh.get_corner_vertex(c);
+            Index v1 = mesh.get_corner_vertex(c + 1 == c_end ? c_begin : c + 1);
+            edge_corners[make_edge(v0, v1)].push_back(c);
+        }
+    }
+
+    auto corners_around_edge = [&](Index e) {
+        std::vector<Index> corners;
+        mesh.foreach_corner_around_edge(e, [&](Index c) { corners.push_back(c); });
+        return corners;
+    };
+
+    SECTION("Default ordering")
+    {
+        mesh.initialize_edges();
+        REQUIRE(mesh.get_num_edges() == edge_corners.size());
+        Index e = 0;
+        for (const auto& [key, corners] : edge_corners) {
+            auto v = mesh.get_edge_vertices(e);
+            REQUIRE(make_edge(v[0], v[1]) == key);
+            std::vector<Index> expected(corners.rbegin(), corners.rend());
+            REQUIRE(corners_around_edge(e) == expected);
+            for (Index c : corners) REQUIRE(mesh.get_corner_edge(c) == e);
+            ++e;
+        }
+
+        auto adjacency = lagrange::compute_vertex_corner_adjacency(mesh);
+        REQUIRE(adjacency.get_num_entries() == mesh.get_num_vertices());
+        for (Index v = 0; v < mesh.get_num_vertices(); ++v) {
+            std::vector<Index> corners;
+            mesh.foreach_corner_around_vertex(v, [&](Index c) { corners.push_back(c); });
+            auto neighbors = adjacency.get_neighbors(v);
+            REQUIRE(
+                std::equal(corners.rbegin(), corners.rend(), neighbors.begin(), neighbors.end()));
+        }
+    }
+
+    SECTION("User ordering")
+    {
+        std::vector<Index> user_edges;
+        for (auto it = edge_corners.rbegin(); it != edge_corners.rend(); ++it) {
+            user_edges.insert(user_edges.end(), {it->first.second, it->first.first});
+        }
+        mesh.initialize_edges(user_edges);
+        REQUIRE(mesh.get_num_edges() == edge_corners.size());
+        for (Index e = 0; e < mesh.get_num_edges(); ++e) {
+            auto v = mesh.get_edge_vertices(e);
+            REQUIRE(
+                make_edge(v[0], v[1]) == make_edge(user_edges[2 * e], user_edges[2 * e + 1]));
+            for (Index c : corners_around_edge(e)) REQUIRE(mesh.get_corner_edge(c) == e);
+        }
+
+        user_edges.resize(user_edges.size() - 2);
+        mesh.clear_edges();
+        LA_REQUIRE_THROWS(mesh.initialize_edges(user_edges));
+    }
+}
+
 TEST_CASE("initialize_edges", "[core][!benchmark]")
 {
     using Scalar = float;
@@ -0,0 +1,201 @@
+/*
+ * Copyright 2024 Adobe. All rights reserved.
+ * This file is licensed to you under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License. You may obtain a copy
+ * of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under
+ * the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR REPRESENTATIONS
+ * OF ANY KIND, either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+ */
+#include <lagrange/testing/common.h>
+
+#include <lagrange/Attribute.h>
+#include <lagrange/IndexedAttribute.h>
+#include <lagrange/SurfaceMesh.h>
+#include <lagrange/mesh_cleanup/remove_duplicate_vertices.h>
+#include <lagrange/unify_index_buffer.h>
+#include <lagrange/utils/MemoryResource.h>
+
+// clang-format off
+#include <lagrange/utils/warnoff.h>
+#include <tbb/parallel_for.h>
+#include <lagrange/utils/warnon.h>
+// clang-format on
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+TEST_CASE("MonotonicArena", "[memory_resource]")
+{
+    using namespace lagrange;
+
+    SECTION("alignment and growth")
+    {
+        MonotonicArena arena(128);
+        std::vector<void*> ptrs;
+        for (size_t i = 0; i < 100; ++i) {
+            const size_t alignment = size_t(1) << (i % 7);
+            void* p = arena.allocate(i + 1, alignment);
+            REQUIRE(reinterpret_cast<uintptr_t>(p) % alignment == 0);
+            ptrs.push_back(p);
+        }
+        // Blocks larger than the initial block size are honored.
+        void* big = arena.allocate(4096, 64);
+        REQUIRE(reinterpret_cast<uintptr_t>(big) % 64 == 0);
+        REQUIRE(arena.get_num_bytes_allocated() >= 4096 + 100 * 101 / 2);
+        arena.deallocate(big, 4096, 64);
+
+        arena.release();
+        REQUIRE(arena.get_num_bytes_allocated() == 0);
+        REQUIRE(arena.allocate(8) != nullptr);
+    }
+
+    SECTION("concurrent allocations")
+    {
+        MonotonicArena arena(256);
+        std::vector<int*> ptrs(1000);
+        tbb::parallel_for(size_t(0), ptrs.size(), [&](size_t i) {
+            // Allocations of varying sizes, filled to detect overlapping blocks.
+            const size_t n = 1 + i % 13;
+            ptrs[i] = static_cast<int*>(arena.allocate(n * sizeof(int), alignof(int)));
+            std::fill_n(ptrs[i], n, static_cast<int>(i));
+        });
+        size_t num_bytes = 0;
+        for (size_t i = 0; i < ptrs.size(); ++i) {
+            const size_t n = 1 + i % 13;
+            REQUIRE(reinterpret_cast<uintptr_t>(ptrs[i]) % alignof(int) == 0);
+            for (size_t k = 0; k < n; ++k) {
+                REQUIRE(ptrs[i][k] == static_cast<int>(i));
+            }
+            num_bytes += n * sizeof(int);
+        }
+        REQUIRE(arena.get_num_bytes_allocated() == num_bytes);
+    }
+
+    SECTION("equality")
+    {
+        MonotonicArena a;
+        MonotonicArena b;
+        REQUIRE(a.is_equal(a));
+        REQUIRE(!a.is_equal(b));
+        REQUIRE(new_delete_resource()->is_equal(*new_delete_resource()));
+        REQUIRE(ResourceAllocator<int>(&a) == ResourceAllocator<float>(&a));
+        REQUIRE(ResourceAllocator<int>(&a) != ResourceAllocator<int>(&b));
+        REQUIRE(ResourceAllocator<int>() != ResourceAllocator<int>(&a));
+    }
+}
+
+TEST_CASE("Attribute memory resource", "[memory_resource][attribute]")
+{
+    using namespace lagrange;
+
+    MonotonicArena arena;
+    Attribute<float> attr(AttributeElement::Vertex, AttributeUsage::Vector, 2);
+    attr.insert_elements({1.f, 2.f, 3.f, 4.f});
+    REQUIRE(attr.get_memory_resource() == nullptr);
+
+    // Existing data is moved to the new resource.
+    attr.set_memory_resource(&arena);
+    REQUIRE(attr.get_memory_resource() == &arena);
+    REQUIRE(arena.get_num_bytes_allocated() >= 4 * sizeof(float));
+    REQUIRE(attr.get_num_elements() == 2);
+    REQUIRE(attr.get(1, 1) == 4.f);
+
+    // Copies and casts stay in the same resource.
+    Attribute<float> copy(attr);
+    REQUIRE(copy.get_memory_resource() == &arena);
+    REQUIRE(copy.get(0, 0) == 1.f);
+    auto cast = Attribute<double>::cast_copy(attr);
+    REQUIRE(cast.get_memory_resource() == &arena);
+    REQUIRE(cast.get(1, 0) == 3.0);
+
+    // Growth keeps allocating from the resource.
+    const size_t num_bytes = arena.get_num_bytes_allocated();
+    copy.insert_elements(100);
+    REQUIRE(arena.get_num_bytes_allocated() > num_bytes);
+    REQUIRE(copy.get_num_elements() == 102);
+    REQUIRE(attr.get_num_elements() == 2);
+
+    // Move back to the global heap.
+    copy.set_memory_resource(nullptr);
+    REQUIRE(copy.get_memory_resource() == nullptr);
+    REQUIRE(copy.get(0, 1) == 2.f);
+}
+
+TEST_CASE("SurfaceMesh memory resource", "[memory_resource][surface]")
+{
+    using namespace lagrange;
+    using Scalar = double;
+    using Index = uint32_t;
+
+    MonotonicArena arena;
+    SurfaceMesh<Scalar, Index> mesh(3, &arena);
+    REQUIRE(mesh.get_memory_resource() == &arena);
+
+    // Two triangles with duplicate vertices along their shared edge.
+    mesh.add_vertex({0, 0, 0});
+    mesh.add_vertex({1, 0, 0});
+    mesh.add_vertex({0, 1, 0});
+    mesh.add_vertex({1, 0, 0});
+    mesh.add_vertex({1, 1, 0});
+    mesh.add_vertex({0, 1, 0});
+    mesh.add_triangle(0, 1, 2);
+    mesh.add_triangle(3, 4, 5);
+    REQUIRE(mesh.get_vertex_to_position().get_memory_resource() == &arena);
+    REQUIRE(mesh.get_corner_to_vertex().get_memory_resource() == &arena);
+
+    auto id = mesh.create_attribute<int>("flag", AttributeElement::Facet, AttributeUsage::Scalar);
+    REQUIRE(mesh.get_attribute<int>(id).get_memory_resource() == &arena);
+    auto uv_id =
+        mesh.create_attribute<float>("uv", AttributeElement::Indexed, AttributeUsage::UV, 2);
+    auto& uv = mesh.ref_indexed_attribute<float>(uv_id);
+    uv.values().insert_elements({0.f, 0.f});
+    REQUIRE(uv.values().get_memory_resource() == &arena);
+    REQUIRE(uv.indices().get_memory_resource() == &arena);
+
+    mesh.initialize_edges();
+    const size_t num_bytes = arena.get_num_bytes_allocated();
+    REQUIRE(num_bytes > 0);
+
+    SECTION("copy on write")
+    {
+        auto copy = mesh;
+        REQUIRE(copy.get_memory_resource() == &arena);
+        copy.ref_position(0)[0] = 2;
+        REQUIRE(copy.get_vertex_to_position().get_memory_resource() == &arena);
+        REQUIRE(arena.get_num_bytes_allocated() > num_bytes);
+        REQUIRE(mesh.get_position(0)[0] == 0);
+    }
+
+    SECTION("cast")
+    {
+        auto other = SurfaceMesh<float, uint64_t>::stripped_copy(mesh);
+        REQUIRE(other.get_memory_resource() == &arena);
+        REQUIRE(other.get_vertex_to_position().get_memory_resource() == &arena);
+        REQUIRE(other.get_corner_to_vertex().get_memory_resource() == &arena);
+    }
+
+    SECTION("cleanup")
+    {
+        remove_duplicate_vertices(mesh);
+        REQUIRE(mesh.get_num_vertices() == 4);
+        REQUIRE(mesh.get_vertex_to_position().get_memory_resource() == &arena);
+
+        auto unified = unify_index_buffer(mesh);
+        REQUIRE(unified.get_memory_resource() == &arena);
+        REQUIRE(unified.get_num_vertices() == 4);
+        REQUIRE(unified.get_vertex_to_position().get_memory_resource() == &arena);
+    }
+
+    SECTION("default heap")
+    {
+        SurfaceMesh<Scalar, Index> heap_mesh;
+        REQUIRE(heap_mesh.get_memory_resource() == nullptr);
+        heap_mesh.add_vertex({0, 0, 0});
+        REQUIRE(heap_mesh.get_vertex_to_position().get_memory_resource() == nullptr);
+        REQUIRE(arena.get_num_bytes_allocated() == num_bytes);
+    }
+}
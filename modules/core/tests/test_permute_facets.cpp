@@ -10,6 +10,7 @@
  * governing permissions and limitations under the License.
  */
 #include <lagrange/Attribute.h>
+#include <lagrange/IndexedAttribute.h>
 #include <lagrange/permute_facets.h>
 #include <lagrange/testing/check_mesh.h>
 #include <lagrange/testing/common.h>
@@ -99,6 +100,29 @@ TEST_CASE("permute_facets", "[surface][reorder_facets]")
         lagrange::testing::check_mesh(mesh);
     }
 
+    SECTION("with indexed attributes")
+    {
+        std::vector<int> values{10, 20, 30};
+        std::vector<Index> indices{0, 1, 2, 0, 2, 1};
+        auto id = mesh.template create_attribute<int>(
+            "indexed",
+            AttributeElement::Indexed,
+            AttributeUsage::Scalar,
+            1,
+            values,
+            indices);
+
+        std::vector<Index> order{1, 0};
+        permute_facets<Scalar, Index>(mesh, order);
+
+        const auto& attr = mesh.get_indexed_attribute<int>(id);
+        REQUIRE(attr.values().get_num_elements() == 3);
+        auto new_indices = attr.indices().get_all();
+        REQUIRE(std::vector<Index>(new_indices.begin(), new_indices.end()) ==
+                std::vector<Index>{0, 2, 1, 0, 1, 2});
+        lagrange::testing::check_mesh(mesh);
+    }
+
     SECTION("with connectivity")
     {
         mesh.initialize_edges();
@@ -0,0 +1,220 @@
+/*
+ * Copyright 2024 Adobe. All rights reserved.
+ * This file is licensed to you under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License. You may obtain a copy
+ * of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under
+ * the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR REPRESENTATIONS
+ * OF ANY KIND, either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+ */
+#include <lagrange/testing/common.h>
+
+#include <lagrange/AttributeValueType.h>
+#include <lagrange/compute_vertex_normal.h>
+#include <lagrange/quantize_attribute.h>
+#include <lagrange/unify_index_buffer.h>
+#include <lagrange/utils/quantization.h>
+#include <lagrange/views.h>
+
+#include <catch2/catch_approx.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+TEST_CASE("quantization codecs", "[quantization]")
+{
+    using namespace lagrange;
+
+    SECTION("half")
+    {
+        for (float x : {0.f, 1.f, -2.5f, 0.333f, 1024.f, 65504.f}) {
+            REQUIRE(half_to_float(float_to_half(x)) == Catch::Approx(x).epsilon(1e-3));
+        }
+        REQUIRE(float_to_half(1.f) == 0x3c00);
+    }
+
+    SECTION("normalized integers")
+    {
+        REQUIRE(encode_unorm<uint8_t>(1.0) == 255);
+        REQUIRE(encode_unorm<uint8_t>(2.0) == 255);
+        REQUIRE(encode_unorm<uint16_t>(-1.0) == 0);
+        REQUIRE(
+            decode_unorm<double>(encode_unorm<uint16_t>(0.25)) ==
+            Catch::Approx(0.25).margin(1e-5));
+        REQUIRE(encode_snorm<int16_t>(-1.0) == -32767);
+        REQUIRE(decode_snorm<float>(int16_t(-32768)) == -1.f);
+        REQUIRE(
+            decode_snorm<double>(encode_snorm<int8_t>(0.5)) == Catch::Approx(0.5).margin(1e-2));
+    }
+
+    SECTION("octahedral")
+    {
+        for (int i = 0; i < 200; ++i) {
+            const double theta = 0.1 + 0.03 * i;
+            const double phi = 0.7 * i;
+            Eigen::Vector3d n(
+                std::sin(theta) * std::cos(phi),
+                std::sin(theta) * std::sin(phi),
+                std::cos(theta));
+            auto d = decode_octahedral<double>(encode_octahedral(n.x(), n.y(), n.z()));
+            Eigen::Vector3d m(d[0], d[1], d[2]);
+            REQUIRE(m.norm() == Catch::Approx(1.0));
+            REQUIRE(n.dot(m) > std::cos(1e-3));
+        }
+    }
+}
+
+TEST_CASE("quantize_attribute", "[quantization][surface]")
+{
+    using namespace lagrange;
+    using Scalar = double;
+    using Index = uint32_t;
+
+    SurfaceMesh<Scalar, Index> mesh;
+    mesh.add_vertex({0, 0, 0});
+    mesh.add_vertex({1, 0, 0.5});
+    mesh.add_vertex({0, 1, 0.2});
+    mesh.add_vertex({1, 1, -0.3});
+    mesh.add_triangle(0, 1, 2);
+    mesh.add_triangle(2, 1, 3);
+    compute_vertex_normal(mesh);
+    const auto expected_normals = attribute_matrix_view<Scalar>(mesh, "@vertex_normal").eval();
+
+    SECTION("octahedral normals")
+    {
+        QuantizeAttributeOptions options;
+        options.encoding = AttributeEncoding::Octahedral16;
+        auto id = quantize_attribute(mesh, "@vertex_normal", options);
+        REQUIRE(mesh.get_attribute_base(id).get_num_channels() == 2);
+        REQUIRE(mesh.get_attribute_base(id).get_value_type() == AttributeValueType::e_int16_t);
+
+        auto quantization = get_attribute_quantization(mesh, "@vertex_normal");
+        REQUIRE(quantization.has_value());
+        REQUIRE(quantization->usage == AttributeUsage::Normal);
+        REQUIRE(quantization->num_channels == 3);
+
+        auto N = decoded_matrix_view<float>(mesh, "@vertex_normal");
+        REQUIRE(N.rows() == 4);
+        REQUIRE(N.cols() == 3);
+        REQUIRE((N.cast<double>() - expected_normals).cwiseAbs().maxCoeff() < 1e-4);
+
+        dequantize_attribute<double>(mesh, "@vertex_normal");
+        REQUIRE(!get_attribute_quantization(mesh, "@vertex_normal").has_value());
+        REQUIRE(!mesh.has_attribute(quantization_attribute_name("@vertex_normal")));
+        const auto& normals = mesh.get_attribute<double>("@vertex_normal");
+        REQUIRE(normals.get_usage() == AttributeUsage::Normal);
+        REQUIRE((matrix_view(normals) - expected_normals).cwiseAbs().maxCoeff() < 1e-4);
+    }
+
+    SECTION("half uvs")
+    {
+        const std::vector<float> uv_values = {0.f, 0.f, 0.5f, 0.25f, 0.125f, 1.f, 7.5f, -2.f};
+        const std::vector<Index> uv_indices = {0, 1, 2, 2, 1, 3};
+        mesh.create_attribute<float>(
+            "uv",
+            AttributeElement::Indexed,
+            AttributeUsage::UV,
+            2,
+            uv_values,
+            uv_indices);
+        QuantizeAttributeOptions options;
+        options.encoding = AttributeEncoding::Half;
+        quantize_attribute(mesh, "uv", options);
+        const auto& uv = mesh.get_indexed_attribute<uint16_t>("uv");
+        REQUIRE(std::equal(uv_indices.begin(), uv_indices.end(), uv.indices().get_all().begin()));
+
+        auto UV = decoded_matrix_view<float>(mesh, "uv");
+        for (Eigen::Index i = 0; i < UV.size(); ++i) {
+            REQUIRE(UV(i / 2, i % 2) == uv_values[i]);
+        }
+
+        // Parameters follow the attribute through remapping.
+        auto unified = unify_index_buffer(mesh);
+        REQUIRE(get_attribute_quantization(unified, "uv").has_value());
+        auto UV2 = decoded_matrix_view<float>(unified, "uv");
+        REQUIRE(UV2.rows() == Eigen::Index(unified.get_num_vertices()));
+    }
+
+    SECTION("bounded positions")
+    {
+        mesh.create_attribute<double>(
+            "rest_position",
+            AttributeElement::Vertex,
+            AttributeUsage::Vector,
+            3,
+            mesh.get_vertex_to_position().get_all());
+        QuantizeAttributeOptions options;
+        options.encoding = AttributeEncoding::Bounded16;
+        options.output_attribute_name = "rest_position_q";
+        quantize_attribute(mesh, "rest_position", options);
+        REQUIRE(mesh.has_attribute("rest_position"));
+
+        auto quantization = get_attribute_quantization(mesh, "rest_position_q");
+        REQUIRE(quantization->offset == std::vector<double>{0, 0, -0.3});
+        auto P = decoded_matrix_view<double>(mesh, "rest_position_q");
+        REQUIRE((P - vertex_view(mesh)).cwiseAbs().maxCoeff() < 1e-4);
+    }
+
+    SECTION("colors")
+    {
+        const std::vector<float> colors = {1, 0, 0, 0.5f, 0, 1, 0, 0.5f, 0, 0, 1, 1, 1, 1, 1, 0};
+        mesh.create_attribute<float>(
+            "color",
+            AttributeElement::Vertex,
+            AttributeUsage::Color,
+            4,
+            colors);
+        QuantizeAttributeOptions options;
+        options.encoding = AttributeEncoding::Unorm8;
+        quantize_attribute(mesh, "color", options);
+        REQUIRE(mesh.get_attribute<uint8_t>("color").get(0, 3) == 128);
+        auto C = decoded_matrix_view<float>(mesh, "color");
+        REQUIRE(C(2, 2) == 1.f);
+        REQUIRE(C(0, 3) == Catch::Approx(0.5f).margin(1.f / 255));
+    }
+
+    SECTION("errors")
+    {
+        mesh.create_attribute<int>("label", AttributeElement::Facet);
+        LA_REQUIRE_THROWS(quantize_attribute(mesh, "label"));
+        quantize_attribute(mesh, "@vertex_normal");
+        LA_REQUIRE_THROWS(quantize_attribute(mesh, "@vertex_normal"));
+        LA_REQUIRE_THROWS(decoded_matrix_view<float>(mesh, "label"));
+    }
+
+    SECTION("existing output")
+    {
+        mesh.create_attribute<float>("quantized", AttributeElement::Vertex, 3);
+        QuantizeAttributeOptions options;
+        options.output_attribute_name = "quantized";
+        LA_REQUIRE_THROWS(quantize_attribute(mesh, "@vertex_normal", options));
+        REQUIRE(mesh.is_attribute_type<float>("quantized"));
+        REQUIRE(!mesh.has_attribute(quantization_attribute_name("quantized")));
+        REQUIRE(mesh.has_attribute("@vertex_normal"));
+        REQUIRE(!get_attribute_quantization(mesh, "@vertex_normal").has_value());
+    }
+
+    SECTION("invalid parameters")
+    {
+        quantize_attribute(mesh, "@vertex_normal");
+        const std::string params_name = quantization_attribute_name("@vertex_normal");
+        auto corrupt = [&](size_t i, double value) {
+            auto params = mesh.ref_attribute<double>(params_name).ref_all();
+            const double old_value = params[i];
+            params[i] = value;
+            LA_REQUIRE_THROWS(get_attribute_quantization(mesh, "@vertex_normal"));
+            params[i] = old_value;
+        };
+        corrupt(0, 42); // Encoding
+        corrupt(0, -1);
+        corrupt(0, 1.5);
+        corrupt(1, 3); // Usage, must be a single flag
+        corrupt(1, 1 << 13);
+        corrupt(2, 0); // Number of channels
+        corrupt(2, 4);
+        corrupt(2, std::nan(""));
+        REQUIRE(get_attribute_quantization(mesh, "@vertex_normal").has_value());
+    }
+}
@@ -10,10 +10,17 @@
  * governing permissions and limitations under the License.
  */
 
+#include <lagrange/Attribute.h>
+#include <lagrange/IndexedAttribute.h>
+#include <lagrange/compute_vertex_cache_statistics.h>
 #include <lagrange/reorder_mesh.h>
 #include <lagrange/testing/common.h>
 #include <lagrange/views.h>
 
+#include <algorithm>
+#include <array>
+#include <random>
+
 TEST_CASE("reorder_mesh", "[core][reorder_mesh]")
 {
     auto mesh = lagrange::testing::load_surface_mesh<double, uint32_t>("open/core/dragon.obj");
@@ -39,3 +46,100 @@ TEST_CASE("reorder_mesh", "[core][reorder_mesh]")
     REQUIRE(facet_view(mesh3) == facet_view(mesh4));
 }
 
+
+TEST_CASE("reorder_mesh gpu", "[core][reorder_mesh]")
+{
+    using namespace lagrange;
+    using Scalar = double;
+    using Index = uint32_t;
+
+    // Grid with shuffled facets, and an indexed attribute storing corner positions
+    const Index n = 50;
+    SurfaceMesh<Scalar, Index> mesh;
+    for (Index j = 0; j <= n; ++j) {
+        for (Index i = 0; i <= n; ++i) {
+            mesh.add_vertex({Scalar(i), Scalar(j), Scalar((i * j) % 7)});
+        }
+    }
+    std::vector<std::array<Index, 3>> triangles;
+    for (Index j = 0; j < n; ++j) {
+        for (Index i = 0; i < n; ++i) {
+            const Index v0 = j * (n + 1) + i;
+            triangles.push_back({v0, v0 + 1, v0 + n + 2});
+            triangles.push_back({v0, v0 + n + 2, v0 + n + 1});
+        }
+    }
+    std::mt19937 gen(0);
+    std::shuffle(triangles.begin(), triangles.end(), gen);
+    for (const auto& t : triangles) {
+        mesh.add_triangle(t[0], t[1], t[2]);
+    }
+    mesh.template create_attribute<Scalar>(
+        "corner_pos",
+        AttributeElement::Indexed,
+        AttributeUsage::Vector,
+        3,
+        span<const Scalar>(mesh.get_vertex_to_position().get_all()),
+        mesh.get_corner_to_vertex().get_all());
+
+    auto check_preserved = [&](const SurfaceMesh<Scalar, Index>& other) {
+        REQUIRE(other.get_num_vertices() == mesh.get_num_vertices());
+        REQUIRE(other.get_num_facets() == mesh.get_num_facets());
+        auto& attr = other.template get_indexed_attribute<Scalar>("corner_pos");
+        auto values = matrix_view(attr.values());
+        auto indices = attr.indices().get_all();
+        auto vertices = vertex_view(other);
+        for (Index c = 0; c < other.get_num_corners(); ++c) {
+            REQUIRE(values.row(indices[c]) == vertices.row(other.get_corner_vertex(c)));
+        }
+    };
+
+    const auto before = compute_vertex_cache_statistics(mesh);
+    REQUIRE(before.atvr >= 1.0);
+
+    SECTION("vertex cache")
+    {
+        auto mesh2 = mesh;
+        reorder_mesh(mesh2, ReorderingMethod::VertexCache);
+        check_preserved(mesh2);
+        const auto after = compute_vertex_cache_statistics(mesh2);
+        REQUIRE(after.acmr < 0.8);
+        REQUIRE(after.acmr < 0.5 * before.acmr);
+        REQUIRE(after.atvr >= 1.0);
+
+        // Vertices are sorted by first use
+        Index max_vertex = 0;
+        for (Index v : mesh2.get_corner_to_vertex().get_all()) {
+            REQUIRE(v <= max_vertex + 1);
+            max_vertex = std::max(max_vertex, v);
+        }
+    }
+
+    SECTION("overdraw")
+    {
+        auto mesh2 = mesh;
+        reorder_mesh(mesh2, ReorderingMethod::Overdraw);
+        check_preserved(mesh2);
+        const auto after = compute_vertex_cache_statistics(mesh2);
+        REQUIRE(after.acmr < 0.5 * before.acmr);
+    }
+
+    SECTION("vertex fetch")
+    {
+        auto mesh2 = mesh;
+        reorder_mesh(mesh2, ReorderingMethod::VertexFetch);
+        check_preserved(mesh2);
+        REQUIRE(compute_vertex_cache_statistics(mesh2).acmr == before.acmr);
+    }
+
+    SECTION("polygonal mesh")
+    {
+        SurfaceMesh<Scalar, Index> quad;
+        quad.add_vertices(5);
+        quad.add_quad(4, 3, 2, 1);
+        LA_REQUIRE_THROWS(reorder_mesh(quad, ReorderingMethod::VertexCache));
+        reorder_mesh(quad, ReorderingMethod::VertexFetch);
+        REQUIRE(quad.get_facet_vertex(0, 0) == 0);
+        REQUIRE(quad.get_facet_vertex(0, 3) == 3);
+    }
+}
@@ -0,0 +1,168 @@
+/*
+ * Copyright 2024 Adobe. All rights reserved.
+ * This file is licensed to you under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License. You may obtain a copy
+ * of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under
+ * the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR REPRESENTATIONS
+ * OF ANY KIND, either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+ */
+#include <lagrange/testing/common.h>
+
+#include <lagrange/Attribute.h>
+#include <lagrange/IndexedAttribute.h>
+#include <lagrange/extract_submesh.h>
+#include <lagrange/separate_by_facet_groups.h>
+#include <lagrange/views.h>
+
+#include <numeric>
+
+namespace {
+
+template <typename Scalar, typename Index>
+lagrange::SurfaceMesh<Scalar, Index> create_grid(Index n)
+{
+    using namespace lagrange;
+    SurfaceMesh<Scalar, Index> mesh;
+    for (Index j = 0; j <= n; ++j) {
+        for (Index i = 0; i <= n; ++i) {
+            mesh.add_vertex({Scalar(i), Scalar(j), 0});
+        }
+    }
+    for (Index j = 0; j < n; ++j) {
+        for (Index i = 0; i < n; ++i) {
+            const Index v0 = j * (n + 1) + i;
+            mesh.add_triangle(v0, v0 + 1, v0 + n + 2);
+            mesh.add_triangle(v0, v0 + n + 2, v0 + n + 1);
+        }
+    }
+
+    // Indexed attribute with one value per vertex, plus unreferenced values
+    std::vector<Scalar> values(2 * mesh.get_num_vertices());
+    std::iota(values.begin(), values.end(), Scalar(0));
+    mesh.template create_attribute<Scalar>(
+        "value",
+        AttributeElement::Indexed,
+        AttributeUsage::Scalar,
+        1,
+        values,
+        mesh.get_corner_to_vertex().get_all());
+    return mesh;
+}
+
+} // namespace
+
+TEST_CASE("separate_by_facet_groups", "[core][utilities][submesh]")
+{
+    using namespace lagrange;
+    using Scalar = double;
+    using Index = uint32_t;
+
+    auto mesh = create_grid<Scalar, Index>(30);
+    const Index num_facets = mesh.get_num_facets();
+    const size_t num_groups = 7;
+
+    // Interleaved groups, sharing most of their vertices
+    std::vector<Index> groups(num_facets);
+    for (Index f = 0; f < num_facets; ++f) groups[f] = f % num_groups;
+
+    SeparateByFacetGroupsOptions options;
+    options.source_vertex_attr_name = "source_vertex";
+    options.source_facet_attr_name = "source_facet";
+    options.map_attributes = true;
+
+    auto check_submeshes = [&](const std::vector<SurfaceMesh<Scalar, Index>>& submeshes) {
+        REQUIRE(submeshes.size() == num_groups);
+        Index total_facets = 0;
+        for (size_t g = 0; g < num_groups; ++g) {
+            const auto& submesh = submeshes[g];
+            total_facets += submesh.get_num_facets();
+
+            // Same result as extracting each group on its own
+            std::vector<Index> selected;
+            for (Index f = g; f < num_facets; f += num_groups) selected.push_back(f);
+            auto expected = extract_submesh<Scalar, Index>(mesh, selected, SubmeshOptions(options));
+            REQUIRE(vertex_view(submesh) == vertex_view(expected));
+            REQUIRE(facet_view(submesh) == facet_view(expected));
+
+            auto source_facets = submesh.template get_attribute<Index>("source_facet").get_all();
+            REQUIRE(std::equal(source_facets.begin(), source_facets.end(), selected.begin()));
+            auto source_vertices = submesh.template get_attribute<Index>("source_vertex").get_all();
+
+            // Indexed values are preserved, and unreferenced values are dropped
+            const auto& attr = submesh.template get_indexed_attribute<Scalar>("value");
+            REQUIRE(attr.values().get_num_elements() == submesh.get_num_vertices());
+            for (Index c = 0; c < submesh.get_num_corners(); ++c) {
+                REQUIRE(
+                    attr.values().get(attr.indices().get(c)) ==
+                    Scalar(source_vertices[submesh.get_corner_vertex(c)]));
+            }
+        }
+        REQUIRE(total_facets == num_facets);
+    };
+
+    SECTION("group indices")
+    {
+        check_submeshes(separate_by_facet_groups<Scalar, Index>(mesh, groups, options));
+    }
+
+    SECTION("group function")
+    {
+        check_submeshes(separate_by_facet_groups<Scalar, Index>(
+            mesh,
+            num_groups,
+            [&](Index f) { return groups[f]; },
+            options));
+    }
+
+    SECTION("empty groups")
+    {
+        auto submeshes = separate_by_facet_groups<Scalar, Index>(mesh, 10, groups, options);
+        REQUIRE(submeshes.size() == 10);
+        for (size_t g = num_groups; g < 10; ++g) {
+            REQUIRE(submeshes[g].get_num_facets() == 0);
+            REQUIRE(submeshes[g].get_num_vertices() == 0);
+        }
+    }
+
+    SECTION("invalid groups")
+    {
+        LA_REQUIRE_THROWS(separate_by_facet_groups<Scalar, Index>(mesh, 3, groups, options));
+    }
+}
+
+TEST_CASE("view_sorted_facet_groups", "[core][utilities][submesh]")
+{
+    using namespace lagrange;
+    using Scalar = double;
+    using Index = uint32_t;
+
+    auto mesh = create_grid<Scalar, Index>(10);
+    const Index num_facets = mesh.get_num_facets();
+    std::vector<Index> groups(num_facets);
+    for (Index f = 0; f < num_facets; ++f) groups[f] = f < 50 ? 0 : (f < 120 ? 2 : 3);
+
+    auto views = view_sorted_facet_groups<Scalar, Index>(mesh, 4, groups);
+    REQUIRE(views.size() == 4);
+    REQUIRE(views[0].get_num_facets() == 50);
+    REQUIRE(views[1].get_num_facets() == 0);
+    REQUIRE(views[2].get_num_facets() == 70);
+    REQUIRE(views[3].get_num_facets() == num_facets - 120);
+
+    Index f = 0;
+    for (const auto& view : views) {
+        REQUIRE(view.get_num_vertices() == mesh.get_num_vertices());
+        REQUIRE(view.get_vertex_to_position().get_all().data() ==
+                mesh.get_vertex_to_position().get_all().data());
+        for (Index i = 0; i < view.get_num_facets(); ++i, ++f) {
+            REQUIRE(view.get_facet_vertex(i, 0) == mesh.get_facet_vertex(f, 0));
+            REQUIRE(view.get_facet_vertex(i, 2) == mesh.get_facet_vertex(f, 2));
+        }
+    }
+    REQUIRE(f == num_facets);
+
+    std::swap(groups.front(), groups.back());
+    LA_REQUIRE_THROWS(view_sorted_facet_groups<Scalar, Index>(mesh, 4, groups));
+}
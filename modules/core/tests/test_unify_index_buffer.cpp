@@ -521,4 +521,21 @@ TEST_CASE("unify_index_buffer", "[attribute][next][unify]")
         mesh2.initialize_edges();
         check_for_consistency(mesh, mesh2);
     }
+
+    SECTION("2D mesh")
+    {
+        lagrange::SurfaceMesh<Scalar, Index> mesh(2);
+        mesh.add_vertices(4, {0, 0, 1, 0, 1, 1, 0, 1});
+        mesh.add_triangle(0, 1, 2);
+        mesh.add_triangle(0, 2, 3);
+
+        std::vector<Scalar> values = {0, 1};
+        std::vector<Index> indices = {0, 0, 0, 1, 1, 1};
+        add_indexed_attribute(mesh, "facet_id", values, indices);
+
+        auto mesh2 = unify_index_buffer(mesh);
+        REQUIRE(mesh2.get_dimension() == 2);
+        REQUIRE(mesh2.get_num_vertices() == 6);
+        check_for_consistency(mesh, mesh2);
+    }
 }
@@ -16,6 +16,8 @@
 #include <lagrange/utils/warning.h>
 #include <catch2/benchmark/catch_benchmark.hpp>
 
+#include <algorithm>
+#include <array>
 #include <fstream>
 #include <vector>
 
@@ -153,6 +155,48 @@ TEST_CASE("utils/chain_edges", "[core][utils]")
         }
     }
 
+    SECTION("Many loops")
+    {
+        // Loops of varying sizes, with edges listed in a scrambled order.
+        const Index num_loops = 1000;
+        std::vector<std::array<Index, 2>> loop_edges;
+        Index num_vertices = 0;
+        for (Index k = 0; k < num_loops; ++k) {
+            const Index n = 3 + k % 7;
+            for (Index i = 0; i < n; ++i) {
+                loop_edges.push_back({num_vertices + i, num_vertices + (i + 1) % n});
+            }
+            num_vertices += n;
+        }
+        const size_t num_edges = loop_edges.size();
+        std::vector<Index> edges;
+        for (size_t i = 0; i < num_edges; ++i) {
+            const auto& e = loop_edges[(i * 7919) % num_edges];
+            edges.insert(edges.end(), e.begin(), e.end());
+        }
+        REQUIRE(num_edges % 7919 != 0);
+
+        ChainEdgesOptions opt;
+        opt.output_edge_index = true;
+        auto r = lagrange::chain_directed_edges<Index>(edges, opt);
+        REQUIRE(r.chains.empty());
+        REQUIRE(r.loops.size() == num_loops);
+        size_t total_edges = 0;
+        for (size_t k = 0; k < r.loops.size(); ++k) {
+            const auto& loop = r.loops[k];
+            total_edges += loop.size();
+            // Loops start at their smallest edge, and are sorted by first edge.
+            REQUIRE(*std::min_element(loop.begin(), loop.end()) == loop.front());
+            if (k > 0) REQUIRE(r.loops[k - 1].front() < loop.front());
+            for (size_t i = 0; i < loop.size(); ++i) {
+                const Index e0 = loop[i];
+                const Index e1 = loop[(i + 1) % loop.size()];
+                REQUIRE(edges[e0 * 2 + 1] == edges[e1 * 2]);
+            }
+        }
+        REQUIRE(total_edges == num_edges);
+    }
+
     SECTION("Bug")
     {
         lagrange::fs::path data_path = testing::get_data_path("open/core/chain_edges_data1.txt");
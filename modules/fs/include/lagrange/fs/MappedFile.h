@@ -0,0 +1,83 @@
+/*
+ * Copyright 2024 Adobe. All rights reserved.
+ * This file is licensed to you under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License. You may obtain a copy
+ * of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under
+ * the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR REPRESENTATIONS
+ * OF ANY KIND, either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+ */
+#pragma once
+
+#include <lagrange/fs/api.h>
+#include <lagrange/fs/filesystem.h>
+#include <lagrange/utils/span.h>
+
+#include <cstddef>
+#include <string_view>
+
+namespace lagrange {
+namespace fs {
+
+///
+/// Read-only memory mapping of a file.
+///
+/// The file content is mapped in the address space of the process for as long as the object is
+/// alive. Pages are loaded lazily by the OS, so mapping a large file is cheap, and only the parts
+/// that are actually read are paged in.
+///
+class LA_FS_API MappedFile
+{
+public:
+    ///
+    /// Create an empty mapping.
+    ///
+    MappedFile() = default;
+
+    ///
+    /// Map a file in memory.
+    ///
+    /// @param[in]  filename  Path of the file to map.
+    ///
+    /// @throws     lagrange::Error if the file cannot be opened or mapped.
+    ///
+    explicit MappedFile(const path& filename);
+
+    ~MappedFile();
+
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    /// Pointer to the first byte of the file, or nullptr if the mapping is empty.
+    const char* data() const { return m_data; }
+
+    /// Size of the mapped file in bytes.
+    size_t size() const { return m_size; }
+
+    /// Whether the mapping is empty.
+    bool empty() const { return m_size == 0; }
+
+    /// Mapped file content as a span of bytes.
+    span<const char> bytes() const { return {m_data, m_size}; }
+
+    /// Mapped file content as a string view.
+    std::string_view view() const { return {m_data, m_size}; }
+
+private:
+    void unmap();
+
+private:
+    const char* m_data = nullptr;
+    size_t m_size = 0;
+#ifdef _WIN32
+    void* m_file = nullptr;
+    void* m_mapping = nullptr;
+#endif
+};
+
+} // namespace fs
+} // namespace lagrange
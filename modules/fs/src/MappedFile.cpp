@@ -0,0 +1,149 @@
+/*
+ * Copyright 2024 Adobe. All rights reserved.
+ * This file is licensed to you under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License. You may obtain a copy
+ * of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under
+ * the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR REPRESENTATIONS
+ * OF ANY KIND, either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+ */
+#include <lagrange/fs/MappedFile.h>
+
+#include <lagrange/Logger.h>
+#include <lagrange/utils/Error.h>
+
+#ifdef _WIN32
+    #ifndef NOMINMAX
+        #define NOMINMAX
+    #endif
+    #include <Windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+#include <utility>
+
+namespace lagrange {
+namespace fs {
+
+#ifdef _WIN32
+
+MappedFile::MappedFile(const path& filename)
+{
+    HANDLE file = CreateFileW(
+        filename.wstring().c_str(),
+        GENERIC_READ,
+        FILE_SHARE_READ,
+        nullptr,
+        OPEN_EXISTING,
+        FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN,
+        nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        throw Error(fmt::format("Failed to open file: '{}'", filename.string()));
+    }
+    m_file = file;
+
+    LARGE_INTEGER file_size;
+    if (!GetFileSizeEx(file, &file_size)) {
+        unmap();
+        throw Error(fmt::format("Failed to query file size: '{}'", filename.string()));
+    }
+    m_size = static_cast<size_t>(file_size.QuadPart);
+    if (m_size == 0) return;
+
+    HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping == nullptr) {
+        unmap();
+        throw Error(fmt::format("Failed to map file: '{}'", filename.string()));
+    }
+    m_mapping = mapping;
+
+    void* ptr = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (ptr == nullptr) {
+        unmap();
+        throw Error(fmt::format("Failed to map file: '{}'", filename.string()));
+    }
+    m_data = static_cast<const char*>(ptr);
+}
+
+void MappedFile::unmap()
+{
+    if (m_data) UnmapViewOfFile(m_data);
+    if (m_mapping) CloseHandle(static_cast<HANDLE>(m_mapping));
+    if (m_file) CloseHandle(static_cast<HANDLE>(m_file));
+    m_data = nullptr;
+    m_mapping = nullptr;
+    m_file = nullptr;
+    m_size = 0;
+}
+
+#else
+
+MappedFile::MappedFile(const path& filename)
+{
+    int fd = ::open(filename.string().c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw Error(fmt::format("Failed to open file: '{}'", filename.string()));
+    }
+
+    struct stat st;
+    if (::fstat(fd, &st) != 0) {
+        ::close(fd);
+        throw Error(fmt::format("Failed to query file size: '{}'", filename.string()));
+    }
+    m_size = static_cast<size_t>(st.st_size);
+    if (m_size == 0) {
+        ::close(fd);
+        return;
+    }
+
+    void* ptr = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    // The mapping holds its own reference to the file, so the descriptor can be closed right away.
+    ::close(fd);
+    if (ptr == MAP_FAILED) {
+        m_size = 0;
+        throw Error(fmt::format("Failed to map file: '{}'", filename.string()));
+    }
+    m_data = static_cast<const char*>(ptr);
+}
+
+void MappedFile::unmap()
+{
+    if (m_data) ::munmap(const_cast<char*>(m_data), m_size);
+    m_data = nullptr;
+    m_size = 0;
+}
+
+#endif
+
+MappedFile::~MappedFile()
+{
+    unmap();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+{
+    *this = std::move(other);
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+{
+    if (this != &other) {
+        unmap();
+        std::swap(m_data, other.m_data);
+        std::swap(m_size, other.m_size);
+#ifdef _WIN32
+        std::swap(m_file, other.m_file);
+        std::swap(m_mapping, other.m_mapping);
+#endif
+    }
+    return *this;
+}
+
+} // namespace fs
+} // namespace lagrange
@@ -0,0 +1,31 @@
+/*
+ * Copyright 2024 Adobe. All rights reserved.
+ * This file is licensed to you under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License. You may obtain a copy
+ * of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under
+ * the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR REPRESENTATIONS
+ * OF ANY KIND, either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+ */
+#include <lagrange/testing/common.h>
+
+#include <lagrange/fs/MappedFile.h>
+
+TEST_CASE("MappedFile", "[io]")
+{
+    using namespace lagrange;
+
+    fs::MappedFile file(testing::get_data_path("open/core/a_simple_text_file.txt"));
+    REQUIRE(!file.empty());
+    REQUIRE(file.size() == 12);
+    REQUIRE(file.view() == "Hello World!");
+
+    fs::MappedFile moved = std::move(file);
+    REQUIRE(file.empty());
+    REQUIRE(file.data() == nullptr);
+    REQUIRE(moved.view() == "Hello World!");
+
+    LA_REQUIRE_THROWS(fs::MappedFile("path/to/nonexistent/file.txt"));
+}
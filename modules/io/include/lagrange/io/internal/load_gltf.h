@@ -0,0 +1,39 @@
+/*
+ * Copyright 2024 Adobe. All rights reserved.
+ * This file is licensed to you under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License. You may obtain a copy
+ * of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under
+ * the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR REPRESENTATIONS
+ * OF ANY KIND, either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+ */
+#pragma once
+
+#include <lagrange/fs/filesystem.h>
+#include <lagrange/io/api.h>
+#include <lagrange/io/types.h>
+
+#include <memory>
+
+namespace tinygltf {
+class Model;
+}
+
+namespace lagrange::io::internal {
+
+/**
+ * Parse a glTF or GLB file into a tinygltf model. Images are kept encoded, and compressed
+ * geometry is decoded.
+ */
+LA_IO_API std::shared_ptr<tinygltf::Model> load_tinygltf(const fs::path& filename);
+
+/**
+ * Convert a parsed glTF model into a scene. Meshes and lazy images may share the ownership of the
+ * model, whose encoded images are released unless they are needed by lazy images.
+ */
+template <typename SceneType>
+SceneType load_scene_gltf(std::shared_ptr<tinygltf::Model> model, const LoadOptions& options = {});
+
+} // namespace lagrange::io::internal
@@ -13,6 +13,7 @@
 
 #include <lagrange/SurfaceMesh.h>
 #include <lagrange/fs/filesystem.h>
+#include <lagrange/io/api.h>
 #include <lagrange/io/types.h>
 
 #include <tiny_obj_loader.h>
@@ -24,12 +25,12 @@ namespace lagrange::io::internal {
 /**
  * Load with tinyobj from file.
  */
-tinyobj::ObjReader load_obj(const fs::path& filename, const LoadOptions& options = {});
+LA_IO_API tinyobj::ObjReader load_obj(const fs::path& filename, const LoadOptions& options = {});
 
 /**
  * Load with tinyobj from stream.
  */
-tinyobj::ObjReader load_obj(
+LA_IO_API tinyobj::ObjReader load_obj(
     std::istream& input_stream_obj,
     std::istream& input_stream_mtl,
     const LoadOptions& options = {});
@@ -114,4 +115,14 @@ auto load_mesh_obj(
     const LoadOptions& options = {})
     -> ObjReaderResult<typename MeshType::Scalar, typename MeshType::Index>;
 
+/**
+ * Sets the approximate size (in bytes) of the text chunks parsed in parallel by the .obj loader
+ * above. Only meant for unit tests, to exercise chunk boundaries with small files.
+ *
+ * @param[in]  chunk_size  New chunk size, or 0 to restore the default size.
+ *
+ * @return     The previous chunk size.
+ */
+LA_IO_API size_t set_obj_chunk_size(size_t chunk_size);
+
 } // namespace lagrange::io::internal
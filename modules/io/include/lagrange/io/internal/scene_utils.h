@@ -17,7 +17,8 @@
 namespace lagrange::io::internal {
 
 /**
- * Load an image from disk, and store it in the Image.
+ * Load an image from disk, and store it in the Image. If `options.lazy_images` is set, only a
+ * lazy image reading the file on first access is created.
  *
  * @param[in] name.     Name of texture or relative or full path to texture.
  * @param[in] options.  Options. Remember to set options.search_path if necessary.
@@ -37,6 +37,10 @@ MeshType load_mesh_gltf(std::istream& input_stream, const LoadOptions& options =
  * Loads a mesh from a file in glTF or GLB format. If the scene contains multiple meshes, they will
  * be merged into one.
  *
+ * GLB files are parsed from a read-only memory mapping. Tightly packed accessors whose component
+ * type matches the mesh scalar, index or attribute value type are wrapped without copy, and keep
+ * the parsed glTF buffers alive. Wrapped buffers are copied upon their first modification.
+ *
  * @param[in]  filename  Input filename.
  * @param[in]  options   Load options.
  *
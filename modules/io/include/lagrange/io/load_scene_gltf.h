@@ -22,6 +22,12 @@ namespace lagrange::io {
 /**
  * Load a scene using gltf.
  *
+ * Mesh buffers and attributes are shared with the glTF buffers whenever the accessor layout
+ * allows it, and are copied upon their first modification. Primitives are converted and images are
+ * decoded concurrently. If `options.load_images` is false, images are not decoded and only hold
+ * their name and uri. If `options.lazy_images` is true, images keep their encoded data, shared with
+ * the glTF model, and are decoded on first access.
+ *
  * @param[in] filename input file name
  * @param[in] options
  *
@@ -22,6 +22,11 @@ namespace lagrange::io {
 /**
  * Saves a mesh to an output stream in glTF or GLB format.
  *
+ * Attributes quantized with quantize_attribute() are written as normalized integer accessors when
+ * glTF supports their encoding, declaring the KHR_mesh_quantization extension for integer normals,
+ * tangents and signed texture coordinates. Octahedral normals are re-encoded as normalized 16-bit
+ * vectors, half precision and bounded attributes are decoded to float.
+ *
  * @param[in]  output_stream Output data stream.
  * @param[in]  mesh          Mesh to write.
  * @param[in]  options       Save options.
@@ -0,0 +1,67 @@
+/*
+ * Copyright 2024 Adobe. All rights reserved.
+ * This file is licensed to you under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License. You may obtain a copy
+ * of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under
+ * the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR REPRESENTATIONS
+ * OF ANY KIND, either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+ */
+#pragma once
+
+#include <lagrange/SurfaceMesh.h>
+#include <lagrange/fs/filesystem.h>
+#include <lagrange/io/types.h>
+
+#include <iosfwd>
+
+namespace lagrange::io {
+
+/**
+ * Saves a mesh to a stream in Lagrange binary mesh format (.lgm). If the mesh cannot be saved, an
+ * exception is raised.
+ *
+ * The .lgm format stores a SurfaceMesh losslessly: vertices, facets, edges and all attributes are
+ * written as-is, along with their element type, usage, value type and number of channels. Data
+ * buffers are aligned on 64 bytes, so that they can be used in place when loading the file. If
+ * `options.compress` is set, large buffers are compressed individually with deflate.
+ *
+ * @param[in,out] output_stream  Output stream.
+ * @param[in]     mesh           Input mesh.
+ * @param[in]     options        Save options. Only `output_attributes`, `selected_attributes` and
+ *                               `compress` are used.
+ *
+ * @tparam        Scalar         Mesh scalar type.
+ * @tparam        Index          Mesh index type.
+ */
+template <typename Scalar, typename Index>
+void save_mesh_lgm(
+    std::ostream& output_stream,
+    const SurfaceMesh<Scalar, Index>& mesh,
+    const SaveOptions& options = {});
+
+/**
+ * @overload
+ *
+ * Saves a mesh to a file in Lagrange binary mesh format (.lgm). If the mesh cannot be saved, an
+ * exception is raised.
+ *
+ * @param[in]  filename  Output filename.
+ * @param[in]  mesh      Mesh to write.
+ * @param[in]  options   Save options.
+ *
+ * @see        save_mesh_lgm(std::ostream&, const SurfaceMesh<S, I>&, const SaveOptions&) for more
+ *             info.
+ *
+ * @tparam     Scalar    Mesh scalar type.
+ * @tparam     Index     Mesh index type.
+ */
+template <typename Scalar, typename Index>
+void save_mesh_lgm(
+    const fs::path& filename,
+    const SurfaceMesh<Scalar, Index>& mesh,
+    const SaveOptions& options = {});
+
+} // namespace lagrange::io
@@ -22,6 +22,8 @@ namespace lagrange::io {
 /**
  * Save a scene to a gltf or glb file.
  *
+ * Lazy PNG and JPEG images holding their encoded data are written as is, without being decoded.
+ *
  * @param output_stream Stream to output data
  * @param scene         Scene to save
  * @param options       SaveOptions, check the struct for more details.
@@ -35,6 +37,8 @@ void save_scene_gltf(
 /**
  * Save a scene to a gltf or glb file.
  *
+ * Lazy PNG and JPEG images holding their encoded data are written as is, without being decoded.
+ *
  * @param filename      path to output file
  * @param scene         Scene to save
  * @param options       SaveOptions, check the struct for more details.
@@ -13,16 +13,21 @@
 
 #include <lagrange/AttributeFwd.h>
 #include <lagrange/fs/filesystem.h>
+#include <lagrange/reorder_mesh.h>
 #include <lagrange/scene/SceneExtension.h>
 #include <lagrange/utils/warning.h>
 
+#include <memory>
 #include <vector>
 
 namespace lagrange {
+namespace scene {
+class ImageCacheExperimental;
+}
 namespace io {
 
 enum class FileEncoding { Binary, Ascii };
-enum class FileFormat { Obj, Ply, Gltf, Msh, Fbx, Unknown };
+enum class FileFormat { Obj, Ply, Gltf, Msh, Fbx, Lgm, Unknown };
 
 /**
  * Options used when saving a mesh or a scene.
@@ -66,6 +71,42 @@ struct SaveOptions
     /// Whether to embed images in the file (if supported by the filetype)
     bool embed_images = false;
 
+    /// Whether to compress binary data buffers (if supported by the filetype, currently .lgm only).
+    /// Compressed buffers need to be decoded when loading the file.
+    bool compress = false;
+
+    /// Reorder mesh facets and vertices before saving (currently .gltf/.glb only). Use
+    /// ReorderingMethod::VertexCache or ReorderingMethod::Overdraw to optimize exported meshes for
+    /// GPU rendering. Indexed attributes are preserved. Input meshes are left unchanged.
+    ReorderingMethod reorder_method = ReorderingMethod::None;
+
+    /**
+     * Geometry compression codec for exported meshes (currently .gltf/.glb only).
+     */
+    enum class GeometryCompression {
+        None, ///< Raw vertex and index buffers (default).
+        Draco, ///< KHR_draco_mesh_compression. Requires building with LAGRANGE_WITH_DRACO.
+    };
+
+    /// The geometry compression codec to use.
+    GeometryCompression geometry_compression = GeometryCompression::None;
+
+    /**
+     * Number of quantization bits per component used by lossy geometry compression. Only floating
+     * point attributes are quantized. A value of 0 stores the corresponding attributes losslessly.
+     */
+    struct QuantizationBits
+    {
+        int position = 14; ///< Vertex positions.
+        int normal = 10; ///< Normals and tangents.
+        int texcoord = 12; ///< Texture coordinates.
+        int color = 8; ///< Vertex colors.
+        int generic = 12; ///< Any other attribute.
+    };
+
+    /// Quantization settings used by geometry compression.
+    QuantizationBits quantization_bits;
+
     std::vector<scene::UserDataConverter*> extension_converters;
 };
 
@@ -115,6 +156,14 @@ struct LoadOptions
     /// Load external images
     bool load_images = true;
 
+    /// Keep images encoded when loading a scene, and decode their pixels on first access instead
+    /// (see scene::ImageExperimental::get_image()). Only used if `load_images` is true.
+    bool lazy_images = false;
+
+    /// Optional cache bounding the memory used by the decoded pixels of lazy images. A single cache
+    /// can be shared by several scenes.
+    std::shared_ptr<scene::ImageCacheExperimental> image_cache;
+
     /// Stitch duplicate boundary vertices together when loading file formats such as glTF
     bool stitch_vertices = false;
 
@@ -21,6 +21,7 @@
 #include <lagrange/io/load_simple_scene.h>
 #include <lagrange/io/save_mesh.h>
 #include <lagrange/io/save_mesh_gltf.h>
+#include <lagrange/io/save_mesh_lgm.h>
 #include <lagrange/io/save_mesh_msh.h>
 #include <lagrange/io/save_mesh_obj.h>
 #include <lagrange/io/save_mesh_ply.h>
@@ -117,7 +118,7 @@ void populate_io_module(nb::module_& m)
         "selected_attributes"_a = nb::none(),
         R"(Save mesh to file.
 
-Filename extension determines the file format. Supported formats are: `obj`, `ply`, `msh`, `glb` and `gltf`.
+Filename extension determines the file format. Supported formats are: `obj`, `ply`, `msh`, `lgm`, `glb` and `gltf`.
 
 :param filename: The output file name.
 :param mesh: The input mesh.
@@ -246,6 +247,8 @@ Filename extension determines the file format. Supported formats are: `obj`, `pl
                 io::save_mesh_ply(ss, mesh, opts);
             } else if (format == "msh") {
                 io::save_mesh_msh(ss, mesh, opts);
+            } else if (format == "lgm") {
+                io::save_mesh_lgm(ss, mesh, opts);
             } else if (format == "gltf") {
                 opts.encoding = io::FileEncoding::Ascii;
                 io::save_mesh_gltf(ss, mesh, opts);
@@ -267,7 +270,7 @@ Filename extension determines the file format. Supported formats are: `obj`, `pl
         R"(Convert a mesh to a binary string based on specified format.
 
 :param mesh: The input mesh.
-:param format: Format to use. Supported formats are "obj", "ply", "gltf" and "msh".
+:param format: Format to use. Supported formats are "obj", "ply", "gltf", "msh" and "lgm".
 :param binary: Whether to save the mesh in binary format if supported. Defaults to True. Only `msh`, `ply` and `glb` support binary format.
 :param exact_match: Whether to save attributes in their exact form. Some mesh formats may not support all the attribute types. If set to False, attributes will be converted to the closest supported attribute type. Defaults to True.
 :param selected_attributes: A list of attribute ids to save. If not specified, all attributes will be saved. Defaults to None.
@@ -288,7 +291,7 @@ Filename extension determines the file format. Supported formats are: `obj`, `pl
         R"(Convert a binary string to a mesh.
 
 The binary string should use one of the supported formats. Supported formats include `obj`, `ply`,
-`gltf`, `glb`, `fbx` and `msh`. Format is automatically detected.
+`gltf`, `glb`, `fbx`, `msh` and `lgm`. Format is automatically detected.
 
 :param data:        A binary string representing the mesh data in a supported format.
 :param triangulate: Whether to triangulate the mesh if it is not already triangulated. Defaults to False.
@@ -38,6 +38,8 @@ FileFormat detect_file_format(std::istream& input_stream)
         return FileFormat::Gltf;
     } else if (starts_with(header_str, "ply")) {
         return FileFormat::Ply;
+    } else if (starts_with(header_str, "\x89LGM")) {
+        return FileFormat::Lgm;
     } else if (starts_with(header_str, "$Mesh")) {
         return FileFormat::Msh;
     } else if (starts_with(header_str, "Kayda")) {
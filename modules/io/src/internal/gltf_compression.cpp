@@ -0,0 +1,717 @@
+/*
+ * Copyright 2024 Adobe. All rights reserved.
+ * This file is licensed to you under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License. You may obtain a copy
+ * of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under
+ * the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR REPRESENTATIONS
+ * OF ANY KIND, either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+ */
+#include "gltf_compression.h"
+
+#include <lagrange/Logger.h>
+#include <lagrange/utils/Error.h>
+#include <lagrange/utils/assert.h>
+#include <lagrange/utils/safe_cast.h>
+
+#ifdef LAGRANGE_WITH_MESHOPTIMIZER
+    #include <meshoptimizer.h>
+#endif
+
+#ifdef LAGRANGE_WITH_DRACO
+    #include <draco/compression/decode.h>
+    #include <draco/compression/encode.h>
+    #include <draco/mesh/mesh.h>
+#endif
+
+// clang-format off
+#include <lagrange/utils/warnoff.h>
+#include <tbb/parallel_for.h>
+#include <lagrange/utils/warnon.h>
+// clang-format on
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace lagrange::io::internal {
+
+namespace {
+
+constexpr const char* s_meshopt_extension = "EXT_meshopt_compression";
+constexpr const char* s_draco_extension = "KHR_draco_mesh_compression";
+
+[[maybe_unused]] bool is_required(const tinygltf::Model& model, const std::string& extension)
+{
+    return std::find(
+               model.extensionsRequired.begin(),
+               model.extensionsRequired.end(),
+               extension) != model.extensionsRequired.end();
+}
+
+[[maybe_unused]] void remove_extension(tinygltf::Model& model, const std::string& extension)
+{
+    for (auto* list : {&model.extensionsUsed, &model.extensionsRequired}) {
+        list->erase(std::remove(list->begin(), list->end(), extension), list->end());
+    }
+}
+
+[[maybe_unused]] size_t
+get_size(const tinygltf::Value& object, const char* key, size_t default_value = 0)
+{
+    if (!object.Has(key)) return default_value;
+    const tinygltf::Value& value = object.Get(key);
+    la_runtime_assert(value.IsNumber(), fmt::format("Invalid glTF property '{}'", key));
+    return static_cast<size_t>(value.GetNumberAsDouble());
+}
+
+// =====================================
+// EXT_meshopt_compression
+// =====================================
+
+void decode_meshopt(tinygltf::Model& model)
+{
+    std::vector<int> compressed_views;
+    for (size_t i = 0; i < model.bufferViews.size(); ++i) {
+        if (model.bufferViews[i].extensions.count(s_meshopt_extension)) {
+            compressed_views.push_back(static_cast<int>(i));
+        }
+    }
+    if (compressed_views.empty()) return;
+
+#ifdef LAGRANGE_WITH_MESHOPTIMIZER
+    std::vector<std::vector<unsigned char>> decoded(compressed_views.size());
+    std::vector<size_t> strides(compressed_views.size(), 0);
+    tbb::parallel_for(size_t(0), compressed_views.size(), [&](size_t i) {
+        const tinygltf::BufferView& view = model.bufferViews[compressed_views[i]];
+        const tinygltf::Value& ext = view.extensions.at(s_meshopt_extension);
+        const tinygltf::Buffer& buffer = model.buffers.at(get_size(ext, "buffer"));
+        const size_t byte_offset = get_size(ext, "byteOffset");
+        const size_t byte_length = get_size(ext, "byteLength");
+        const size_t byte_stride = get_size(ext, "byteStride");
+        const size_t count = get_size(ext, "count");
+        const std::string mode = ext.Has("mode") ? ext.Get("mode").Get<std::string>() : "";
+        const std::string filter =
+            ext.Has("filter") ? ext.Get("filter").Get<std::string>() : "NONE";
+        if (byte_offset + byte_length > buffer.data.size()) {
+            throw Error("Invalid EXT_meshopt_compression buffer view: data out of bounds");
+        }
+
+        const unsigned char* source = buffer.data.data() + byte_offset;
+        std::vector<unsigned char> data(count * byte_stride);
+        int result = -1;
+        if (mode == "ATTRIBUTES") {
+            result =
+                meshopt_decodeVertexBuffer(data.data(), count, byte_stride, source, byte_length);
+            strides[i] = byte_stride;
+        } else if (mode == "TRIANGLES") {
+            result =
+                meshopt_decodeIndexBuffer(data.data(), count, byte_stride, source, byte_length);
+        } else if (mode == "INDICES") {
+            result =
+                meshopt_decodeIndexSequence(data.data(), count, byte_stride, source, byte_length);
+        } else {
+            throw Error(fmt::format("Unsupported EXT_meshopt_compression mode '{}'", mode));
+        }
+        if (result != 0) {
+            throw Error(fmt::format("Failed to decode EXT_meshopt_compression data ({})", result));
+        }
+
+        if (filter == "OCTAHEDRAL") {
+            meshopt_decodeFilterOct(data.data(), count, byte_stride);
+        } else if (filter == "QUATERNION") {
+            meshopt_decodeFilterQuat(data.data(), count, byte_stride);
+        } else if (filter == "EXPONENTIAL") {
+            meshopt_decodeFilterExp(data.data(), count, byte_stride);
+        } else if (filter != "NONE") {
+            throw Error(fmt::format("Unsupported EXT_meshopt_compression filter '{}'", filter));
+        }
+        decoded[i] = std::move(data);
+    });
+
+    // Point each buffer view to its decoded data. Fallback buffers are left untouched.
+    for (size_t i = 0; i < compressed_views.size(); ++i) {
+        tinygltf::BufferView& view = model.bufferViews[compressed_views[i]];
+        view.buffer = static_cast<int>(model.buffers.size());
+        view.byteOffset = 0;
+        view.byteLength = decoded[i].size();
+        view.byteStride = strides[i];
+        view.extensions.erase(s_meshopt_extension);
+
+        tinygltf::Buffer buffer;
+        buffer.data = std::move(decoded[i]);
+        model.buffers.push_back(std::move(buffer));
+    }
+    remove_extension(model, s_meshopt_extension);
+#else
+    if (is_required(model, s_meshopt_extension)) {
+        throw Error(
+            "glTF file requires EXT_meshopt_compression. You may want to compile with "
+            "LAGRANGE_WITH_MESHOPTIMIZER=ON.");
+    }
+    logger().debug("Ignoring EXT_meshopt_compression, using uncompressed fallback buffers.");
+#endif
+}
+
+// =====================================
+// KHR_draco_mesh_compression
+// =====================================
+
+#ifdef LAGRANGE_WITH_DRACO
+
+size_t get_num_channels(int type)
+{
+    switch (type) {
+    case TINYGLTF_TYPE_SCALAR: return 1;
+    case TINYGLTF_TYPE_VEC2: return 2;
+    case TINYGLTF_TYPE_VEC3: return 3;
+    case TINYGLTF_TYPE_VEC4: return 4;
+    case TINYGLTF_TYPE_MAT2: return 4;
+    case TINYGLTF_TYPE_MAT3: return 9;
+    case TINYGLTF_TYPE_MAT4: return 16;
+    default: throw Error(fmt::format("Unsupported accessor type {}", type));
+    }
+}
+
+size_t get_component_size(int component_type)
+{
+    switch (component_type) {
+    case TINYGLTF_COMPONENT_TYPE_BYTE:
+    case TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE: return 1;
+    case TINYGLTF_COMPONENT_TYPE_SHORT:
+    case TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT: return 2;
+    case TINYGLTF_COMPONENT_TYPE_INT:
+    case TINYGLTF_COMPONENT_TYPE_UNSIGNED_INT:
+    case TINYGLTF_COMPONENT_TYPE_FLOAT: return 4;
+    case TINYGLTF_COMPONENT_TYPE_DOUBLE: return 8;
+    default: throw Error(fmt::format("Unsupported component type {}", component_type));
+    }
+}
+
+///
+/// Calls a function with a value of the C++ type matching a glTF component type.
+///
+template <typename Func>
+decltype(auto) visit_component_type(int component_type, Func&& func)
+{
+    switch (component_type) {
+    case TINYGLTF_COMPONENT_TYPE_BYTE: return func(int8_t());
+    case TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE: return func(uint8_t());
+    case TINYGLTF_COMPONENT_TYPE_SHORT: return func(int16_t());
+    case TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT: return func(uint16_t());
+    case TINYGLTF_COMPONENT_TYPE_UNSIGNED_INT: return func(uint32_t());
+    case TINYGLTF_COMPONENT_TYPE_FLOAT: return func(float());
+    default: throw Error(fmt::format("Unsupported component type {}", component_type));
+    }
+}
+
+/// Appends data to a new buffer, and returns the index of a new buffer view covering it.
+int add_buffer_view(tinygltf::Model& model, std::vector<unsigned char> data, size_t byte_stride)
+{
+    tinygltf::BufferView view;
+    view.buffer = static_cast<int>(model.buffers.size());
+    view.byteOffset = 0;
+    view.byteLength = data.size();
+    view.byteStride = byte_stride;
+
+    tinygltf::Buffer buffer;
+    buffer.data = std::move(data);
+    model.buffers.push_back(std::move(buffer));
+    model.bufferViews.push_back(std::move(view));
+    return static_cast<int>(model.bufferViews.size()) - 1;
+}
+
+///
+/// Counts the references to each accessor from mesh primitives, morph targets, skins and
+/// animations.
+///
+std::vector<size_t> count_accessor_references(const tinygltf::Model& model)
+{
+    std::vector<size_t> references(model.accessors.size(), 0);
+    auto add = [&](int accessor) {
+        if (accessor >= 0 && static_cast<size_t>(accessor) < references.size()) {
+            ++references[accessor];
+        }
+    };
+    for (const tinygltf::Mesh& mesh : model.meshes) {
+        for (const tinygltf::Primitive& primitive : mesh.primitives) {
+            add(primitive.indices);
+            for (const auto& [name, accessor] : primitive.attributes) add(accessor);
+            for (const auto& target : primitive.targets) {
+                for (const auto& [name, accessor] : target) add(accessor);
+            }
+        }
+    }
+    for (const tinygltf::Skin& skin : model.skins) add(skin.inverseBindMatrices);
+    for (const tinygltf::Animation& animation : model.animations) {
+        for (const tinygltf::AnimationSampler& sampler : animation.samplers) {
+            add(sampler.input);
+            add(sampler.output);
+        }
+    }
+    return references;
+}
+
+///
+/// Ensures that a primitive is the only user of an accessor it references, before the accessor
+/// is rewritten for that primitive. A shared accessor is cloned, and the reference is updated to
+/// point to the clone.
+///
+/// @param[in,out] model       The glTF model.
+/// @param[in,out] references  Reference count of each accessor, updated accordingly.
+/// @param[in,out] accessor    Accessor index referenced by the primitive.
+///
+void make_unique_accessor(tinygltf::Model& model, std::vector<size_t>& references, int& accessor)
+{
+    la_runtime_assert(
+        accessor >= 0 && static_cast<size_t>(accessor) < model.accessors.size(),
+        fmt::format("Invalid accessor index {}", accessor));
+    if (references[accessor] <= 1) return;
+    --references[accessor];
+    tinygltf::Accessor clone = model.accessors[accessor];
+    model.accessors.push_back(std::move(clone));
+    references.push_back(1);
+    accessor = static_cast<int>(model.accessors.size()) - 1;
+}
+
+/// Decoded data for a single accessor.
+struct DecodedAccessor
+{
+    /// Name of the primitive attribute, or empty for the facet indices.
+    std::string attribute;
+    int component_type = -1;
+    size_t count = 0;
+    std::vector<unsigned char> data;
+};
+
+template <typename T>
+std::vector<unsigned char> decode_draco_attribute(
+    const draco::Mesh& mesh,
+    const draco::PointAttribute& attribute,
+    size_t num_channels)
+{
+    std::vector<unsigned char> data(mesh.num_points() * num_channels * sizeof(T));
+    T* values = reinterpret_cast<T*>(data.data());
+    for (draco::PointIndex p(0); p < mesh.num_points(); ++p) {
+        if (!attribute.ConvertValue<T>(
+                attribute.mapped_index(p),
+                static_cast<int8_t>(num_channels),
+                values + p.value() * num_channels)) {
+            throw Error("Failed to convert Draco attribute values");
+        }
+    }
+    return data;
+}
+
+std::vector<DecodedAccessor> decode_draco_primitive(
+    const tinygltf::Model& model,
+    const tinygltf::Primitive& primitive)
+{
+    const tinygltf::Value& ext = primitive.extensions.at(s_draco_extension);
+    const tinygltf::BufferView& view = model.bufferViews.at(get_size(ext, "bufferView"));
+    const tinygltf::Buffer& buffer = model.buffers.at(view.buffer);
+    if (view.byteOffset + view.byteLength > buffer.data.size()) {
+        throw Error("Invalid KHR_draco_mesh_compression buffer view: data out of bounds");
+    }
+
+    draco::DecoderBuffer draco_buffer;
+    draco_buffer.Init(
+        reinterpret_cast<const char*>(buffer.data.data() + view.byteOffset),
+        view.byteLength);
+    draco::Decoder decoder;
+    auto result = decoder.DecodeMeshFromBuffer(&draco_buffer);
+    if (!result.ok()) {
+        throw Error(fmt::format(
+            "Failed to decode Draco primitive: {}",
+            result.status().error_msg_string()));
+    }
+    std::unique_ptr<draco::Mesh> mesh = std::move(result).value();
+
+    std::vector<DecodedAccessor> decoded;
+    if (primitive.indices >= 0) {
+        DecodedAccessor indices;
+        indices.component_type = TINYGLTF_COMPONENT_TYPE_UNSIGNED_INT;
+        indices.count = mesh->num_faces() * 3;
+        indices.data.resize(indices.count * sizeof(uint32_t));
+        uint32_t* values = reinterpret_cast<uint32_t*>(indices.data.data());
+        for (draco::FaceIndex f(0); f < mesh->num_faces(); ++f) {
+            const draco::Mesh::Face& face = mesh->face(f);
+            for (size_t k = 0; k < 3; ++k) {
+                values[3 * f.value() + k] = face[k].value();
+            }
+        }
+        decoded.push_back(std::move(indices));
+    }
+
+    const tinygltf::Value& attributes = ext.Get("attributes");
+    for (const std::string& name : attributes.Keys()) {
+        auto it = primitive.attributes.find(name);
+        if (it == primitive.attributes.end()) continue;
+        const tinygltf::Accessor& accessor = model.accessors.at(it->second);
+        const draco::PointAttribute* attribute =
+            mesh->GetAttributeByUniqueId(safe_cast<uint32_t>(get_size(attributes, name.c_str())));
+        if (attribute == nullptr) {
+            throw Error(fmt::format("Missing Draco attribute for '{}'", name));
+        }
+
+        DecodedAccessor values;
+        values.attribute = name;
+        values.component_type = accessor.componentType;
+        values.count = mesh->num_points();
+        values.data = visit_component_type(accessor.componentType, [&](auto dummy) {
+            using T = decltype(dummy);
+            return decode_draco_attribute<T>(*mesh, *attribute, get_num_channels(accessor.type));
+        });
+        decoded.push_back(std::move(values));
+    }
+    return decoded;
+}
+
+#endif
+
+void decode_draco(tinygltf::Model& model)
+{
+    std::vector<tinygltf::Primitive*> compressed_primitives;
+    for (tinygltf::Mesh& mesh : model.meshes) {
+        for (tinygltf::Primitive& primitive : mesh.primitives) {
+            if (primitive.extensions.count(s_draco_extension)) {
+                compressed_primitives.push_back(&primitive);
+            }
+        }
+    }
+    if (compressed_primitives.empty()) return;
+
+#ifdef LAGRANGE_WITH_DRACO
+    std::vector<std::vector<DecodedAccessor>> decoded(compressed_primitives.size());
+    tbb::parallel_for(size_t(0), compressed_primitives.size(), [&](size_t i) {
+        decoded[i] = decode_draco_primitive(model, *compressed_primitives[i]);
+    });
+
+    // Accessors may be shared by several primitives, but each primitive decodes its own data.
+    std::vector<size_t> references = count_accessor_references(model);
+    for (size_t i = 0; i < compressed_primitives.size(); ++i) {
+        tinygltf::Primitive& primitive = *compressed_primitives[i];
+        for (DecodedAccessor& values : decoded[i]) {
+            int& index = values.attribute.empty() ? primitive.indices
+                                                  : primitive.attributes.at(values.attribute);
+            make_unique_accessor(model, references, index);
+            const int view = add_buffer_view(model, std::move(values.data), 0);
+            tinygltf::Accessor& accessor = model.accessors[index];
+            accessor.bufferView = view;
+            accessor.byteOffset = 0;
+            accessor.componentType = values.component_type;
+            accessor.count = values.count;
+            accessor.sparse.isSparse = false;
+        }
+        primitive.extensions.erase(s_draco_extension);
+    }
+    remove_extension(model, s_draco_extension);
+#else
+    if (is_required(model, s_draco_extension)) {
+        throw Error(
+            "glTF file requires KHR_draco_mesh_compression. You may want to compile with "
+            "LAGRANGE_WITH_DRACO=ON.");
+    }
+    logger().debug("Ignoring KHR_draco_mesh_compression, using uncompressed fallback buffers.");
+#endif
+}
+
+#ifdef LAGRANGE_WITH_DRACO
+
+/// A primitive compressed with Draco.
+struct EncodedPrimitive
+{
+    std::vector<unsigned char> data;
+    std::vector<std::pair<std::string, int>> attribute_ids;
+    size_t num_points = 0;
+    size_t num_faces = 0;
+};
+
+/// Copies the elements of an accessor into a tightly packed array.
+std::vector<unsigned char> read_accessor(
+    const tinygltf::Model& model,
+    const tinygltf::Accessor& accessor)
+{
+    const tinygltf::BufferView& view = model.bufferViews.at(accessor.bufferView);
+    const tinygltf::Buffer& buffer = model.buffers.at(view.buffer);
+    const size_t element_size =
+        get_num_channels(accessor.type) * get_component_size(accessor.componentType);
+    const size_t stride = view.byteStride ? view.byteStride : element_size;
+    const size_t start = view.byteOffset + accessor.byteOffset;
+    if (accessor.count > 0 &&
+        start + stride * (accessor.count - 1) + element_size > buffer.data.size()) {
+        throw Error("Accessor data exceeds the size of its buffer");
+    }
+
+    std::vector<unsigned char> data(accessor.count * element_size);
+    for (size_t i = 0; i < accessor.count; ++i) {
+        std::memcpy(
+            data.data() + i * element_size,
+            buffer.data.data() + start + i * stride,
+            element_size);
+    }
+    return data;
+}
+
+draco::DataType get_draco_data_type(int component_type)
+{
+    switch (component_type) {
+    case TINYGLTF_COMPONENT_TYPE_BYTE: return draco::DT_INT8;
+    case TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE: return draco::DT_UINT8;
+    case TINYGLTF_COMPONENT_TYPE_SHORT: return draco::DT_INT16;
+    case TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT: return draco::DT_UINT16;
+    case TINYGLTF_COMPONENT_TYPE_UNSIGNED_INT: return draco::DT_UINT32;
+    case TINYGLTF_COMPONENT_TYPE_FLOAT: return draco::DT_FLOAT32;
+    default: throw Error(fmt::format("Unsupported component type {}", component_type));
+    }
+}
+
+draco::GeometryAttribute::Type get_draco_attribute_type(const std::string& name)
+{
+    if (name == "POSITION") return draco::GeometryAttribute::POSITION;
+    if (name == "NORMAL") return draco::GeometryAttribute::NORMAL;
+    if (name.rfind("TEXCOORD_", 0) == 0) return draco::GeometryAttribute::TEX_COORD;
+    if (name.rfind("COLOR_", 0) == 0) return draco::GeometryAttribute::COLOR;
+    return draco::GeometryAttribute::GENERIC;
+}
+
+EncodedPrimitive encode_draco_primitive(
+    const tinygltf::Model& model,
+    const tinygltf::Primitive& primitive,
+    const SaveOptions::QuantizationBits& bits)
+{
+    const tinygltf::Accessor& positions = model.accessors.at(primitive.attributes.at("POSITION"));
+    const tinygltf::Accessor& indices = model.accessors.at(primitive.indices);
+    const size_t num_points = positions.count;
+    const size_t num_faces = indices.count / 3;
+
+    draco::Mesh mesh;
+    mesh.set_num_points(safe_cast<uint32_t>(num_points));
+    mesh.SetNumFaces(num_faces);
+    {
+        const std::vector<unsigned char> data = read_accessor(model, indices);
+        visit_component_type(indices.componentType, [&](auto dummy) {
+            using T = decltype(dummy);
+            const T* values = reinterpret_cast<const T*>(data.data());
+            for (size_t f = 0; f < num_faces; ++f) {
+                draco::Mesh::Face face;
+                for (size_t k = 0; k < 3; ++k) {
+                    face[k] = draco::PointIndex(static_cast<uint32_t>(values[3 * f + k]));
+                }
+                mesh.SetFace(draco::FaceIndex(static_cast<uint32_t>(f)), face);
+            }
+        });
+    }
+
+    std::vector<std::pair<std::string, int>> attribute_ids;
+    for (const auto& [name, accessor_index] : primitive.attributes) {
+        const tinygltf::Accessor& accessor = model.accessors.at(accessor_index);
+        la_runtime_assert(accessor.count == num_points, "Inconsistent primitive attributes");
+        const size_t num_channels = get_num_channels(accessor.type);
+        const size_t element_size = num_channels * get_component_size(accessor.componentType);
+
+        draco::GeometryAttribute attribute;
+        attribute.Init(
+            get_draco_attribute_type(name),
+            nullptr,
+            static_cast<uint8_t>(num_channels),
+            get_draco_data_type(accessor.componentType),
+            accessor.normalized,
+            static_cast<int64_t>(element_size),
+            0);
+        const int id = mesh.AddAttribute(attribute, true, safe_cast<uint32_t>(num_points));
+        draco::PointAttribute* point_attribute = mesh.attribute(id);
+        const std::vector<unsigned char> data = read_accessor(model, accessor);
+        for (size_t i = 0; i < num_points; ++i) {
+            point_attribute->SetAttributeValue(
+                draco::AttributeValueIndex(static_cast<uint32_t>(i)),
+                data.data() + i * element_size);
+        }
+        attribute_ids.emplace_back(name, static_cast<int>(point_attribute->unique_id()));
+    }
+
+    draco::Encoder encoder;
+    auto set_quantization = [&](draco::GeometryAttribute::Type type, int num_bits) {
+        if (num_bits > 0) encoder.SetAttributeQuantization(type, num_bits);
+    };
+    set_quantization(draco::GeometryAttribute::POSITION, bits.position);
+    set_quantization(draco::GeometryAttribute::NORMAL, bits.normal);
+    set_quantization(draco::GeometryAttribute::TEX_COORD, bits.texcoord);
+    set_quantization(draco::GeometryAttribute::COLOR, bits.color);
+    set_quantization(draco::GeometryAttribute::GENERIC, bits.generic);
+
+    draco::EncoderBuffer buffer;
+    const draco::Status status = encoder.EncodeMeshToBuffer(mesh, &buffer);
+    if (!status.ok()) {
+        throw Error(fmt::format("Failed to encode Draco primitive: {}", status.error_msg_string()));
+    }
+
+    EncodedPrimitive encoded;
+    encoded.data.assign(buffer.data(), buffer.data() + buffer.size());
+    encoded.attribute_ids = std::move(attribute_ids);
+    encoded.num_points = encoder.num_encoded_points();
+    encoded.num_faces = encoder.num_encoded_faces();
+    return encoded;
+}
+
+///
+/// Removes buffer views that are not referenced anymore, and packs the remaining ones into a
+/// single buffer.
+///
+void compact_buffers(tinygltf::Model& model)
+{
+    std::vector<int> remap(model.bufferViews.size(), -1);
+    auto mark = [&](int view) {
+        if (view >= 0) remap[view] = 0;
+    };
+    for (const tinygltf::Accessor& accessor : model.accessors) {
+        mark(accessor.bufferView);
+        if (accessor.sparse.isSparse) {
+            mark(accessor.sparse.indices.bufferView);
+            mark(accessor.sparse.values.bufferView);
+        }
+    }
+    for (const tinygltf::Image& image : model.images) {
+        mark(image.bufferView);
+    }
+
+    tinygltf::Buffer packed;
+    std::vector<tinygltf::BufferView> views;
+    for (size_t i = 0; i < remap.size(); ++i) {
+        if (remap[i] < 0) continue;
+        tinygltf::BufferView view = model.bufferViews[i];
+        const tinygltf::Buffer& buffer = model.buffers.at(view.buffer);
+        // Buffer views are aligned to 4 bytes, as required for vertex attributes.
+        const size_t offset = (packed.data.size() + 3) / 4 * 4;
+        packed.data.resize(offset + view.byteLength);
+        std::memcpy(
+            packed.data.data() + offset,
+            buffer.data.data() + view.byteOffset,
+            view.byteLength);
+        view.buffer = 0;
+        view.byteOffset = offset;
+        remap[i] = static_cast<int>(views.size());
+        views.push_back(std::move(view));
+    }
+
+    auto apply = [&](int& view) {
+        if (view >= 0) view = remap[view];
+    };
+    for (tinygltf::Accessor& accessor : model.accessors) {
+        apply(accessor.bufferView);
+        if (accessor.sparse.isSparse) {
+            apply(accessor.sparse.indices.bufferView);
+            apply(accessor.sparse.values.bufferView);
+        }
+    }
+    for (tinygltf::Image& image : model.images) {
+        apply(image.bufferView);
+    }
+
+    model.bufferViews = std::move(views);
+    model.buffers.clear();
+    model.buffers.push_back(std::move(packed));
+}
+
+void encode_draco(tinygltf::Model& model, const SaveOptions& options)
+{
+    std::vector<tinygltf::Primitive*> primitives;
+    for (tinygltf::Mesh& mesh : model.meshes) {
+        for (tinygltf::Primitive& primitive : mesh.primitives) {
+            if (primitive.mode == TINYGLTF_MODE_TRIANGLES && primitive.indices >= 0 &&
+                primitive.attributes.count("POSITION") && primitive.targets.empty()) {
+                primitives.push_back(&primitive);
+            }
+        }
+    }
+    if (primitives.empty()) return;
+
+    // Compressed accessors are rewritten for each primitive below, so they must not be shared.
+    // Clones still refer to the original buffer views, which are read by the encoder.
+    std::vector<size_t> references = count_accessor_references(model);
+    for (tinygltf::Primitive* primitive : primitives) {
+        make_unique_accessor(model, references, primitive->indices);
+        for (auto& [name, accessor_index] : primitive->attributes) {
+            make_unique_accessor(model, references, accessor_index);
+        }
+    }
+
+    std::vector<EncodedPrimitive> encoded(primitives.size());
+    tbb::parallel_for(size_t(0), primitives.size(), [&](size_t i) {
+        encoded[i] = encode_draco_primitive(model, *primitives[i], options.quantization_bits);
+    });
+
+    // Compressed accessors do not refer to any buffer view.
+    for (size_t i = 0; i < primitives.size(); ++i) {
+        tinygltf::Accessor& indices = model.accessors[primitives[i]->indices];
+        indices.bufferView = -1;
+        indices.byteOffset = 0;
+        indices.count = encoded[i].num_faces * 3;
+        for (const auto& [name, accessor_index] : primitives[i]->attributes) {
+            tinygltf::Accessor& accessor = model.accessors[accessor_index];
+            accessor.bufferView = -1;
+            accessor.byteOffset = 0;
+            accessor.count = encoded[i].num_points;
+        }
+    }
+    compact_buffers(model);
+
+    for (size_t i = 0; i < primitives.size(); ++i) {
+        tinygltf::Buffer& buffer = model.buffers.front();
+        tinygltf::BufferView view;
+        view.buffer = 0;
+        view.byteOffset = (buffer.data.size() + 3) / 4 * 4;
+        view.byteLength = encoded[i].data.size();
+        buffer.data.resize(view.byteOffset + view.byteLength);
+        std::copy(
+            encoded[i].data.begin(),
+            encoded[i].data.end(),
+            buffer.data.begin() + view.byteOffset);
+        model.bufferViews.push_back(std::move(view));
+
+        tinygltf::Value::Object attributes;
+        for (const auto& [name, id] : encoded[i].attribute_ids) {
+            attributes.insert({name, tinygltf::Value(id)});
+        }
+        tinygltf::Value::Object ext;
+        ext.insert({"bufferView", tinygltf::Value(int(model.bufferViews.size()) - 1)});
+        ext.insert({"attributes", tinygltf::Value(std::move(attributes))});
+        primitives[i]->extensions[s_draco_extension] = tinygltf::Value(std::move(ext));
+    }
+
+    for (auto* list : {&model.extensionsUsed, &model.extensionsRequired}) {
+        if (std::find(list->begin(), list->end(), s_draco_extension) == list->end()) {
+            list->push_back(s_draco_extension);
+        }
+    }
+}
+
+#endif
+
+} // namespace
+
+void decode_gltf_compression(tinygltf::Model& model)
+{
+    decode_meshopt(model);
+    decode_draco(model);
+}
+
+void encode_gltf_compression([[maybe_unused]] tinygltf::Model& model, const SaveOptions& options)
+{
+    switch (options.geometry_compression) {
+    case SaveOptions::GeometryCompression::None: break;
+    case SaveOptions::GeometryCompression::Draco:
+#ifdef LAGRANGE_WITH_DRACO
+        encode_draco(model, options);
+#else
+        throw Error("Draco compression requires compiling with LAGRANGE_WITH_DRACO=ON.");
+#endif
+        break;
+    }
+}
+
+} // namespace lagrange::io::internal
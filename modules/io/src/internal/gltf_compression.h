@@ -0,0 +1,48 @@
+/*
+ * Copyright 2024 Adobe. All rights reserved.
+ * This file is licensed to you under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License. You may obtain a copy
+ * of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under
+ * the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR REPRESENTATIONS
+ * OF ANY KIND, either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+ */
+#pragma once
+
+#include <lagrange/io/types.h>
+
+#include <tiny_gltf.h>
+
+namespace lagrange::io::internal {
+
+///
+/// Decodes the compressed geometry of a glTF model in place, so that every accessor refers to a
+/// plain buffer view afterwards.
+///
+/// Buffer views compressed with EXT_meshopt_compression are decoded into new buffers, and
+/// primitives compressed with KHR_draco_mesh_compression have their accessors pointed to newly
+/// decoded buffers. Accessors shared by several Draco primitives are cloned, so that each primitive
+/// refers to its own decoded data. Compressed buffer views and primitives are decoded in parallel.
+///
+/// @param[in,out] model  The glTF model to decode.
+///
+/// @throws     Error if the model requires a codec that Lagrange was compiled without.
+///
+void decode_gltf_compression(tinygltf::Model& model);
+
+///
+/// Compresses the triangle primitives of a glTF model in place, using the codec and quantization
+/// settings from the save options. Buffer views that are no longer referenced are removed, and the
+/// remaining data is repacked into a single buffer. Accessors shared between primitives are cloned
+/// before compression. Primitives are encoded in parallel.
+///
+/// @param[in,out] model    The glTF model to compress.
+/// @param[in]     options  Save options.
+///
+/// @throws     Error if the requested codec is not available.
+///
+void encode_gltf_compression(tinygltf::Model& model, const SaveOptions& options);
+
+} // namespace lagrange::io::internal
@@ -0,0 +1,369 @@
+/*
+ * Copyright 2024 Adobe. All rights reserved.
+ * This file is licensed to you under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License. You may obtain a copy
+ * of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under
+ * the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR REPRESENTATIONS
+ * OF ANY KIND, either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+ */
+#pragma once
+
+#include <lagrange/AttributeFwd.h>
+#include <lagrange/AttributeTypes.h>
+#include <lagrange/AttributeValueType.h>
+#include <lagrange/Logger.h>
+#include <lagrange/utils/Error.h>
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+///
+/// Layout of a .lgm file (all values are stored in the byte order of the writer, which is
+/// recorded in the file header):
+///
+/// | Offset | Content                                                                   |
+/// |--------|---------------------------------------------------------------------------|
+/// | 0      | Header (64 bytes): magic, version, byte order mark, table of contents size |
+/// | 64     | Table of contents: mesh sizes and attribute descriptions                  |
+/// | ...    | Data blobs, each starting at an offset that is a multiple of 64 bytes     |
+///
+/// Blobs are referenced from the table of contents by absolute file offset. Each blob can be
+/// stored either raw (in which case it can be used in place from a memory-mapped file) or
+/// compressed with deflate.
+///
+namespace lagrange::io::internal {
+
+/// Magic number at the start of every .lgm file.
+constexpr std::string_view lgm_magic{"\x89LGM\r\n\x1a\n", 8};
+
+/// Current version of the format.
+constexpr uint32_t lgm_version = 1;
+
+/// Written as a uint32 to detect files written with a different byte order.
+constexpr uint32_t lgm_byte_order_mark = 0x01020304;
+
+/// Size of the file header in bytes.
+constexpr size_t lgm_header_size = 64;
+
+/// Alignment of data blobs in bytes.
+constexpr size_t lgm_alignment = 64;
+
+/// Blobs smaller than this are never compressed.
+constexpr size_t lgm_min_compressed_size = 4096;
+
+///
+/// Compression method of a data blob.
+///
+enum class LgmCompression : uint8_t { None = 0, Deflate = 1 };
+
+///
+/// Location of a data blob in the file.
+///
+struct LgmBlob
+{
+    /// Offset of the blob from the start of the file.
+    uint64_t offset = 0;
+
+    /// Size of the blob as stored in the file.
+    uint64_t size = 0;
+
+    /// Size of the blob once decompressed.
+    uint64_t raw_size = 0;
+
+    /// Compression method.
+    LgmCompression compression = LgmCompression::None;
+};
+
+///
+/// Description of a mesh attribute.
+///
+struct LgmAttribute
+{
+    std::string name;
+    AttributeElement element = AttributeElement::Vertex;
+    AttributeUsage usage = AttributeUsage::Vector;
+    AttributeValueType value_type = AttributeValueType::e_double;
+    uint64_t num_channels = 0;
+
+    /// Number of rows in the value buffer.
+    uint64_t num_values = 0;
+
+    /// Raw bytes of the attribute default value.
+    std::array<uint8_t, 8> default_value = {};
+
+    LgmBlob values;
+
+    /// Corner -> value indices, only for indexed attributes.
+    LgmBlob indices;
+};
+
+///
+/// Table of contents of a .lgm file.
+///
+struct LgmToc
+{
+    AttributeValueType scalar_type = AttributeValueType::e_double;
+    AttributeValueType index_type = AttributeValueType::e_uint32_t;
+    uint32_t dimension = 3;
+
+    /// Number of vertices per facet, or 0 for hybrid meshes.
+    uint32_t vertex_per_facet = 0;
+
+    uint64_t num_vertices = 0;
+    uint64_t num_facets = 0;
+    uint64_t num_corners = 0;
+    uint64_t num_edges = 0;
+    bool has_edges = false;
+
+    LgmBlob positions;
+    LgmBlob corner_to_vertex;
+
+    /// Facet -> first corner, only for hybrid meshes.
+    LgmBlob facet_to_first_corner;
+
+    /// Edge -> vertex endpoints, only for meshes with edge information.
+    LgmBlob edge_to_vertices;
+
+    std::vector<LgmAttribute> attributes;
+};
+
+/// Number of attribute value types, i.e. one past the last valid AttributeValueType.
+constexpr uint8_t lgm_num_value_types = 0
+#define LA_X_lgm_num_value_types(_, ValueType) +1
+    LA_ATTRIBUTE_X(lgm_num_value_types, 0)
+#undef LA_X_lgm_num_value_types
+    ;
+
+/// Size in bytes of an attribute value type.
+inline size_t lgm_value_type_size(AttributeValueType value_type)
+{
+    switch (value_type) {
+#define LA_X_lgm_value_type_size(_, ValueType) \
+    case AttributeValueType::e_##ValueType: return sizeof(ValueType);
+        LA_ATTRIBUTE_X(lgm_value_type_size, 0)
+#undef LA_X_lgm_value_type_size
+    default: throw Error("Invalid attribute value type in .lgm file");
+    }
+}
+
+///
+/// Calls a function with a default-constructed value of the C++ type corresponding to an attribute
+/// value type.
+///
+template <typename Func>
+decltype(auto) visit_lgm_value_type(AttributeValueType value_type, Func&& func)
+{
+    switch (value_type) {
+#define LA_X_visit_lgm_value_type(_, ValueType) \
+    case AttributeValueType::e_##ValueType: return func(ValueType());
+        LA_ATTRIBUTE_X(visit_lgm_value_type, 0)
+#undef LA_X_visit_lgm_value_type
+    default: throw Error("Invalid attribute value type in .lgm file");
+    }
+}
+
+/// Writes the fixed-size file header.
+inline std::string write_lgm_header(uint64_t toc_size)
+{
+    std::string header(lgm_header_size, '\0');
+    std::memcpy(header.data(), lgm_magic.data(), lgm_magic.size());
+    std::memcpy(header.data() + 8, &lgm_version, sizeof(uint32_t));
+    std::memcpy(header.data() + 12, &lgm_byte_order_mark, sizeof(uint32_t));
+    std::memcpy(header.data() + 16, &toc_size, sizeof(uint64_t));
+    return header;
+}
+
+///
+/// Validates the file header.
+///
+/// @param[in]  data  Buffer starting with the file header.
+///
+/// @throws     lagrange::Error if the header is invalid or was written with an unsupported version
+///             or byte order.
+///
+/// @return     Size of the table of contents in bytes.
+///
+inline uint64_t read_lgm_header(std::string_view data)
+{
+    if (data.size() < lgm_header_size || data.substr(0, lgm_magic.size()) != lgm_magic) {
+        throw Error("Invalid .lgm file: bad magic number");
+    }
+    uint32_t version = 0;
+    uint32_t byte_order_mark = 0;
+    uint64_t toc_size = 0;
+    std::memcpy(&version, data.data() + 8, sizeof(uint32_t));
+    std::memcpy(&byte_order_mark, data.data() + 12, sizeof(uint32_t));
+    std::memcpy(&toc_size, data.data() + 16, sizeof(uint64_t));
+    if (byte_order_mark != lgm_byte_order_mark) {
+        throw Error("Unsupported .lgm file: written with a different byte order");
+    }
+    if (version == 0 || version > lgm_version) {
+        throw Error(fmt::format("Unsupported .lgm file version: {}", version));
+    }
+    return toc_size;
+}
+
+///
+/// Serializes the table of contents.
+///
+inline std::string write_lgm_toc(const LgmToc& toc)
+{
+    std::string out;
+    auto write = [&](auto value) {
+        static_assert(std::is_trivially_copyable_v<decltype(value)>);
+        out.append(reinterpret_cast<const char*>(&value), sizeof(value));
+    };
+    auto write_string = [&](std::string_view str) {
+        write(static_cast<uint32_t>(str.size()));
+        out.append(str);
+    };
+    auto write_blob = [&](const LgmBlob& blob) {
+        write(blob.offset);
+        write(blob.size);
+        write(blob.raw_size);
+        write(static_cast<uint8_t>(blob.compression));
+    };
+
+    write(static_cast<uint8_t>(toc.scalar_type));
+    write(static_cast<uint8_t>(toc.index_type));
+    write(toc.dimension);
+    write(toc.vertex_per_facet);
+    write(toc.num_vertices);
+    write(toc.num_facets);
+    write(toc.num_corners);
+    write(toc.num_edges);
+    write(static_cast<uint8_t>(toc.has_edges));
+    write_blob(toc.positions);
+    write_blob(toc.corner_to_vertex);
+    write_blob(toc.facet_to_first_corner);
+    write_blob(toc.edge_to_vertices);
+
+    write(static_cast<uint32_t>(toc.attributes.size()));
+    for (const auto& attr : toc.attributes) {
+        write_string(attr.name);
+        write(static_cast<uint32_t>(attr.element));
+        write(static_cast<uint32_t>(attr.usage));
+        write(static_cast<uint8_t>(attr.value_type));
+        write(attr.num_channels);
+        write(attr.num_values);
+        write(attr.default_value);
+        write_blob(attr.values);
+        write_blob(attr.indices);
+    }
+    return out;
+}
+
+///
+/// Parses the table of contents.
+///
+/// @param[in]  data  Serialized table of contents.
+///
+/// @throws     lagrange::Error if the data is truncated or contains invalid values.
+///
+/// @return     The table of contents.
+///
+inline LgmToc read_lgm_toc(std::string_view data)
+{
+    size_t pos = 0;
+    auto read = [&](auto& value) {
+        static_assert(std::is_trivially_copyable_v<std::decay_t<decltype(value)>>);
+        if (data.size() - pos < sizeof(value)) {
+            throw Error("Invalid .lgm file: truncated table of contents");
+        }
+        std::memcpy(&value, data.data() + pos, sizeof(value));
+        pos += sizeof(value);
+    };
+    auto read_u8 = [&]() {
+        uint8_t value;
+        read(value);
+        return value;
+    };
+    auto read_u32 = [&]() {
+        uint32_t value;
+        read(value);
+        return value;
+    };
+    auto read_value_type = [&]() {
+        uint8_t value = read_u8();
+        if (value >= lgm_num_value_types) {
+            throw Error(fmt::format("Invalid .lgm file: unknown attribute value type {}", value));
+        }
+        return static_cast<AttributeValueType>(value);
+    };
+    auto read_element = [&]() {
+        // Attribute elements are single bits, from Vertex to Indexed.
+        uint32_t value = read_u32();
+        if (value == 0 || (value & (value - 1)) != 0 ||
+            value > static_cast<uint32_t>(AttributeElement::Indexed)) {
+            throw Error(fmt::format("Invalid .lgm file: unknown attribute element {}", value));
+        }
+        return static_cast<AttributeElement>(value);
+    };
+    auto read_usage = [&]() {
+        // Attribute usages are single bits, from Vector to String.
+        uint32_t value = read_u32();
+        if (value == 0 || (value & (value - 1)) != 0 ||
+            value > static_cast<uint32_t>(AttributeUsage::String)) {
+            throw Error(fmt::format("Invalid .lgm file: unknown attribute usage {}", value));
+        }
+        return static_cast<AttributeUsage>(value);
+    };
+    auto read_blob = [&](LgmBlob& blob) {
+        read(blob.offset);
+        read(blob.size);
+        read(blob.raw_size);
+        uint8_t compression = read_u8();
+        if (compression > static_cast<uint8_t>(LgmCompression::Deflate)) {
+            throw Error("Invalid .lgm file: unknown compression method");
+        }
+        blob.compression = static_cast<LgmCompression>(compression);
+    };
+
+    LgmToc toc;
+    toc.scalar_type = read_value_type();
+    toc.index_type = read_value_type();
+    read(toc.dimension);
+    read(toc.vertex_per_facet);
+    read(toc.num_vertices);
+    read(toc.num_facets);
+    read(toc.num_corners);
+    read(toc.num_edges);
+    toc.has_edges = read_u8() != 0;
+    read_blob(toc.positions);
+    read_blob(toc.corner_to_vertex);
+    read_blob(toc.facet_to_first_corner);
+    read_blob(toc.edge_to_vertices);
+
+    uint32_t num_attributes = read_u32();
+    if (num_attributes > data.size() - pos) {
+        throw Error("Invalid .lgm file: truncated table of contents");
+    }
+    toc.attributes.resize(num_attributes);
+    for (auto& attr : toc.attributes) {
+        uint32_t name_size = read_u32();
+        if (data.size() - pos < name_size) {
+            throw Error("Invalid .lgm file: truncated table of contents");
+        }
+        attr.name = data.substr(pos, name_size);
+        pos += name_size;
+        attr.element = read_element();
+        attr.usage = read_usage();
+        attr.value_type = read_value_type();
+        read(attr.num_channels);
+        read(attr.num_values);
+        read(attr.default_value);
+        read_blob(attr.values);
+        read_blob(attr.indices);
+    }
+    return toc;
+}
+
+} // namespace lagrange::io::internal
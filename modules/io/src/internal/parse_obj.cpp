@@ -0,0 +1,776 @@
+/*
+ * Copyright 2024 Adobe. All rights reserved.
+ * This file is licensed to you under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License. You may obtain a copy
+ * of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under
+ * the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR REPRESENTATIONS
+ * OF ANY KIND, either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+ */
+#include "parse_obj.h"
+
+#include "../stitch_mesh.h"
+
+#include <lagrange/Attribute.h>
+#include <lagrange/IndexedAttribute.h>
+#include <lagrange/Logger.h>
+#include <lagrange/SurfaceMeshTypes.h>
+#include <lagrange/attribute_names.h>
+#include <lagrange/utils/assert.h>
+#include <lagrange/utils/invalid.h>
+#include <lagrange/utils/safe_cast.h>
+#include <lagrange/utils/strings.h>
+
+#include <fast_float/fast_float.h>
+
+// clang-format off
+#include <lagrange/utils/warnoff.h>
+#include <tbb/parallel_for.h>
+#include <lagrange/utils/warnon.h>
+// clang-format on
+
+#include <atomic>
+#include <charconv>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace lagrange::io::internal {
+
+namespace {
+
+/// Default approximate size (in bytes) of the chunks of text parsed in parallel.
+constexpr size_t k_default_chunk_size = size_t(1) << 20;
+
+/// Current chunk size. Only overridden by unit tests, see set_obj_chunk_size().
+std::atomic<size_t> s_chunk_size(k_default_chunk_size);
+
+///
+/// Statement changing the current object or material, recorded during the counting pass.
+///
+struct ObjEvent
+{
+    enum class Type { Object, Group, Material, MaterialLib };
+
+    Type type;
+
+    /// Number of facets preceding the statement in its chunk.
+    size_t facet;
+
+    /// Argument of the statement.
+    std::string name;
+};
+
+///
+/// Material and object id applied to a range of facets of a chunk, starting at `facet`.
+///
+struct ObjFacetRun
+{
+    size_t facet;
+    int material_id;
+    size_t object_id;
+};
+
+template <typename Index>
+struct ObjChunk
+{
+    // Line-aligned text range
+    const char* begin = nullptr;
+    const char* end = nullptr;
+
+    // Element counts (facet and corner counts are computed after triangulation)
+    size_t num_lines = 0;
+    size_t num_vertices = 0;
+    size_t num_colors = 0;
+    size_t num_texcoords = 0;
+    size_t num_normals = 0;
+    size_t num_facets = 0;
+    size_t num_corners = 0;
+    size_t num_skipped_facets = 0;
+
+    // Size of the facets in the chunk if they all have the same size. Otherwise, the size of each
+    // facet is stored in `facet_sizes`.
+    Index facet_size = 0;
+    std::vector<Index> facet_sizes;
+
+    // Object/group/material statements
+    std::vector<ObjEvent> events;
+
+    // Offsets of the chunk elements in the mesh buffers
+    size_t line_offset = 0;
+    size_t vertex_offset = 0;
+    size_t texcoord_offset = 0;
+    size_t normal_offset = 0;
+    size_t facet_offset = 0;
+    size_t corner_offset = 0;
+
+    // Resolved material and object ids
+    std::vector<ObjFacetRun> runs;
+
+    // Parsing diagnostics
+    size_t num_missing_texcoords = 0;
+    size_t num_missing_normals = 0;
+    std::string error;
+
+    void add_facets(Index size, size_t count)
+    {
+        if (facet_sizes.empty() && (facet_size == 0 || facet_size == size)) {
+            facet_size = size;
+        } else {
+            if (facet_sizes.empty()) {
+                facet_sizes.assign(num_facets, facet_size);
+            }
+            facet_sizes.insert(facet_sizes.end(), count, size);
+        }
+        num_facets += count;
+        num_corners += count * size;
+    }
+
+    bool is_uniform() const { return facet_sizes.empty(); }
+};
+
+inline bool is_blank(char c)
+{
+    return c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+}
+
+inline const char* skip_blanks(const char* p, const char* end)
+{
+    while (p < end && is_blank(*p)) ++p;
+    return p;
+}
+
+inline const char* skip_token(const char* p, const char* end)
+{
+    while (p < end && !is_blank(*p)) ++p;
+    return p;
+}
+
+inline const char* find_line_end(const char* p, const char* end)
+{
+    const void* nl = std::memchr(p, '\n', static_cast<size_t>(end - p));
+    return nl ? static_cast<const char*>(nl) : end;
+}
+
+inline std::string_view trim(const char* p, const char* end)
+{
+    p = skip_blanks(p, end);
+    while (end > p && is_blank(end[-1])) --end;
+    return std::string_view(p, static_cast<size_t>(end - p));
+}
+
+inline size_t count_tokens(const char* p, const char* end)
+{
+    size_t count = 0;
+    for (p = skip_blanks(p, end); p < end; p = skip_blanks(skip_token(p, end), end)) {
+        ++count;
+    }
+    return count;
+}
+
+/// Parses a floating point value, leaving `value` untouched if the token is not a number.
+inline void parse_real(const char*& p, const char* end, double& value)
+{
+    p = skip_blanks(p, end);
+    if (p < end && *p == '+') ++p;
+    auto res = fast_float::from_chars(p, end, value);
+    p = (res.ec == std::errc() ? res.ptr : skip_token(p, end));
+}
+
+/// Parses a signed integer. Returns false if the token does not start with an integer.
+inline bool parse_int(const char*& p, const char* end, int64_t& value)
+{
+    if (p < end && *p == '+') ++p;
+    auto res = std::from_chars(p, end, value);
+    if (res.ec != std::errc()) return false;
+    p = res.ptr;
+    return true;
+}
+
+///
+/// Reads the keyword at the start of a line.
+///
+/// @param[in,out] p    Start of the line. Set to the first character after the keyword.
+/// @param[in]     end  End of the line.
+///
+/// @return     The keyword, or an empty string for blank lines.
+///
+inline std::string_view read_keyword(const char*& p, const char* end)
+{
+    const char* first = skip_blanks(p, end);
+    p = skip_token(first, end);
+    return std::string_view(first, static_cast<size_t>(p - first));
+}
+
+///
+/// Splits a text buffer into chunks whose boundaries lie right after a newline character.
+///
+/// @param[in]  data        Text buffer.
+/// @param[in]  chunk_size  Minimum size (in bytes) of a chunk, except for the last one.
+///
+template <typename Index>
+std::vector<ObjChunk<Index>> split_chunks(std::string_view data, size_t chunk_size)
+{
+    std::vector<ObjChunk<Index>> chunks;
+    const char* const data_end = data.data() + data.size();
+    const char* p = data.data();
+    while (p < data_end) {
+        const char* end = data_end;
+        if (static_cast<size_t>(data_end - p) > chunk_size) {
+            end = find_line_end(p + chunk_size, data_end);
+            if (end < data_end) ++end;
+        }
+        ObjChunk<Index> chunk;
+        chunk.begin = p;
+        chunk.end = end;
+        chunks.push_back(std::move(chunk));
+        p = end;
+    }
+    return chunks;
+}
+
+///
+/// First pass: counts the number of elements in a chunk and records statements affecting object
+/// and material ids.
+///
+template <typename Index>
+void count_chunk(ObjChunk<Index>& chunk, const LoadOptions& options)
+{
+    for (const char* line = chunk.begin; line < chunk.end;) {
+        const char* line_end = find_line_end(line, chunk.end);
+        const char* p = line;
+        line = line_end + 1;
+        ++chunk.num_lines;
+
+        std::string_view keyword = read_keyword(p, line_end);
+        if (keyword.empty() || keyword[0] == '#') continue;
+
+        if (keyword == "v") {
+            ++chunk.num_vertices;
+            if (options.load_vertex_colors && count_tokens(p, line_end) >= 6) {
+                ++chunk.num_colors;
+            }
+        } else if (keyword == "vt") {
+            ++chunk.num_texcoords;
+        } else if (keyword == "vn") {
+            ++chunk.num_normals;
+        } else if (keyword == "f") {
+            const size_t nv = count_tokens(p, line_end);
+            if (nv < 3) {
+                ++chunk.num_skipped_facets;
+            } else if (options.triangulate && nv > 3) {
+                chunk.add_facets(3, nv - 2);
+            } else {
+                chunk.add_facets(safe_cast<Index>(nv), 1);
+            }
+        } else if (keyword == "o") {
+            chunk.events.push_back(
+                {ObjEvent::Type::Object, chunk.num_facets, std::string(trim(p, line_end))});
+        } else if (keyword == "g") {
+            // Multiple group names are concatenated with a space, like tinyobj does.
+            std::string name;
+            for (p = skip_blanks(p, line_end); p < line_end;) {
+                const char* q = skip_token(p, line_end);
+                if (!name.empty()) name += ' ';
+                name.append(p, q);
+                p = skip_blanks(q, line_end);
+            }
+            chunk.events.push_back({ObjEvent::Type::Group, chunk.num_facets, std::move(name)});
+        } else if (keyword == "usemtl") {
+            p = skip_blanks(p, line_end);
+            chunk.events.push_back(
+                {ObjEvent::Type::Material,
+                 chunk.num_facets,
+                 std::string(p, skip_token(p, line_end))});
+        } else if (keyword == "mtllib") {
+            chunk.events.push_back(
+                {ObjEvent::Type::MaterialLib,
+                 chunk.num_facets,
+                 std::string(trim(p, line_end))});
+        }
+    }
+}
+
+///
+/// Output buffers of the parsing pass.
+///
+template <typename Scalar, typename Index>
+struct ObjBuffers
+{
+    span<Scalar> positions;
+    span<Scalar> colors;
+    span<Scalar> texcoords;
+    span<Scalar> normals;
+    span<Index> vertex_indices;
+    span<Index> texcoord_indices;
+    span<Index> normal_indices;
+    size_t num_vertices = 0;
+    size_t num_texcoords = 0;
+    size_t num_normals = 0;
+};
+
+struct ObjCorner
+{
+    size_t v;
+    size_t vt;
+    size_t vn;
+};
+
+///
+/// Resolves a 1-based (or negative relative) obj index into a 0-based index.
+///
+/// @return     False if the index is out of bounds.
+///
+inline bool resolve_index(int64_t idx, size_t num_seen, size_t num_total, size_t& out)
+{
+    if (idx > 0) {
+        out = static_cast<size_t>(idx - 1);
+    } else if (idx < 0 && static_cast<size_t>(-idx) <= num_seen) {
+        out = num_seen - static_cast<size_t>(-idx);
+    } else {
+        return false;
+    }
+    return out < num_total;
+}
+
+///
+/// Second pass: parses the values in a chunk and writes them directly into the mesh buffers.
+///
+template <typename Scalar, typename Index>
+void parse_chunk(
+    ObjChunk<Index>& chunk,
+    const ObjBuffers<Scalar, Index>& buffers,
+    const LoadOptions& options)
+{
+    size_t v = chunk.vertex_offset;
+    size_t vt = chunk.texcoord_offset;
+    size_t vn = chunk.normal_offset;
+    size_t c = chunk.corner_offset;
+    size_t line_number = chunk.line_offset;
+    std::vector<ObjCorner> corners;
+
+    auto fail = [&](std::string_view msg) {
+        chunk.error = fmt::format("Line {}: {}", line_number, msg);
+    };
+
+    for (const char* line = chunk.begin; line < chunk.end;) {
+        const char* line_end = find_line_end(line, chunk.end);
+        const char* p = line;
+        line = line_end + 1;
+        ++line_number;
+
+        std::string_view keyword = read_keyword(p, line_end);
+        if (keyword.empty() || keyword[0] == '#') continue;
+
+        if (keyword == "v") {
+            double xyz[3] = {0, 0, 0};
+            for (double& x : xyz) parse_real(p, line_end, x);
+            for (size_t k = 0; k < 3; ++k) {
+                buffers.positions[v * 3 + k] = static_cast<Scalar>(xyz[k]);
+            }
+            if (!buffers.colors.empty()) {
+                double rgb[3] = {1, 1, 1};
+                for (double& x : rgb) parse_real(p, line_end, x);
+                for (size_t k = 0; k < 3; ++k) {
+                    buffers.colors[v * 3 + k] = static_cast<Scalar>(rgb[k]);
+                }
+            }
+            ++v;
+        } else if (keyword == "vt") {
+            if (!buffers.texcoords.empty()) {
+                double uv[2] = {0, 0};
+                for (double& x : uv) parse_real(p, line_end, x);
+                buffers.texcoords[vt * 2 + 0] = static_cast<Scalar>(uv[0]);
+                buffers.texcoords[vt * 2 + 1] = static_cast<Scalar>(uv[1]);
+            }
+            ++vt;
+        } else if (keyword == "vn") {
+            if (!buffers.normals.empty()) {
+                double n[3] = {0, 0, 0};
+                for (double& x : n) parse_real(p, line_end, x);
+                for (size_t k = 0; k < 3; ++k) {
+                    buffers.normals[vn * 3 + k] = static_cast<Scalar>(n[k]);
+                }
+            }
+            ++vn;
+        } else if (keyword == "f") {
+            // Parse v, v/vt, v//vn or v/vt/vn triplets.
+            corners.clear();
+            for (p = skip_blanks(p, line_end); p < line_end; p = skip_blanks(p, line_end)) {
+                ObjCorner corner{0, invalid<size_t>(), invalid<size_t>()};
+                int64_t idx = 0;
+                if (!parse_int(p, line_end, idx) ||
+                    !resolve_index(idx, v, buffers.num_vertices, corner.v)) {
+                    return fail("invalid vertex index");
+                }
+                if (p < line_end && *p == '/') {
+                    ++p;
+                    if (p < line_end && *p != '/') {
+                        if (!parse_int(p, line_end, idx) ||
+                            !resolve_index(idx, vt, buffers.num_texcoords, corner.vt)) {
+                            return fail("invalid texture coordinate index");
+                        }
+                    }
+                    if (p < line_end && *p == '/') {
+                        ++p;
+                        if (!parse_int(p, line_end, idx) ||
+                            !resolve_index(idx, vn, buffers.num_normals, corner.vn)) {
+                            return fail("invalid normal index");
+                        }
+                    }
+                }
+                if (p < line_end && !is_blank(*p)) {
+                    return fail("invalid facet statement");
+                }
+                corners.push_back(corner);
+            }
+            if (corners.size() < 3) continue;
+
+            auto write_corner = [&](const ObjCorner& corner) {
+                buffers.vertex_indices[c] = static_cast<Index>(corner.v);
+                if (!buffers.texcoord_indices.empty()) {
+                    if (corner.vt == invalid<size_t>()) {
+                        buffers.texcoord_indices[c] = invalid<Index>();
+                        ++chunk.num_missing_texcoords;
+                    } else {
+                        buffers.texcoord_indices[c] = static_cast<Index>(corner.vt);
+                    }
+                }
+                if (!buffers.normal_indices.empty()) {
+                    if (corner.vn == invalid<size_t>()) {
+                        buffers.normal_indices[c] = invalid<Index>();
+                        ++chunk.num_missing_normals;
+                    } else {
+                        buffers.normal_indices[c] = static_cast<Index>(corner.vn);
+                    }
+                }
+                ++c;
+            };
+
+            if (options.triangulate && corners.size() > 3) {
+                // Fan triangulation
+                for (size_t k = 1; k + 1 < corners.size(); ++k) {
+                    write_corner(corners[0]);
+                    write_corner(corners[k]);
+                    write_corner(corners[k + 1]);
+                }
+            } else {
+                for (const auto& corner : corners) write_corner(corner);
+            }
+        }
+    }
+}
+
+///
+/// Loads a material library, either from the user-provided stream or from the search path.
+///
+void load_material_library(
+    const std::string& filenames,
+    std::istream* input_stream_mtl,
+    const fs::path& search_path,
+    std::map<std::string, int>& material_map,
+    std::vector<tinyobj::material_t>& materials,
+    std::string& warn,
+    std::string& err)
+{
+    if (input_stream_mtl) {
+        tinyobj::LoadMtl(&material_map, &materials, input_stream_mtl, &warn, &err);
+        return;
+    }
+
+    // Load the first material file that can be found.
+    for (const auto& filename : string_split(filenames, ' ')) {
+        if (filename.empty()) continue;
+        std::ifstream fin((search_path / filename).string());
+        if (fin.good()) {
+            tinyobj::LoadMtl(&material_map, &materials, &fin, &warn, &err);
+            return;
+        }
+    }
+    warn += fmt::format("Failed to load material file(s): '{}'\n", filenames);
+}
+
+} // namespace
+
+size_t set_obj_chunk_size(size_t chunk_size)
+{
+    return s_chunk_size.exchange(chunk_size == 0 ? k_default_chunk_size : chunk_size);
+}
+
+template <typename MeshType>
+auto parse_obj(std::string_view data, std::istream* input_stream_mtl, const LoadOptions& options)
+    -> ObjReaderResult<typename MeshType::Scalar, typename MeshType::Index>
+{
+    using Scalar = typename MeshType::Scalar;
+    using Index = typename MeshType::Index;
+    using SignedIndex = typename MeshType::SignedIndex;
+
+    ObjReaderResult<Scalar, Index> result;
+    auto& mesh = result.mesh;
+
+    // 1st pass: count elements in each chunk
+    logger().trace("[load_mesh_obj] Counting elements");
+    auto chunks = split_chunks<Index>(data, s_chunk_size.load());
+    tbb::parallel_for(size_t(0), chunks.size(), [&](size_t i) { count_chunk(chunks[i], options); });
+
+    // Compute chunk offsets
+    size_t num_vertices = 0;
+    size_t num_colors = 0;
+    size_t num_texcoords = 0;
+    size_t num_normals = 0;
+    size_t num_facets = 0;
+    size_t num_corners = 0;
+    size_t num_lines = 0;
+    size_t num_skipped_facets = 0;
+    bool uniform = true;
+    Index facet_size = 0;
+    for (auto& chunk : chunks) {
+        chunk.line_offset = num_lines;
+        chunk.vertex_offset = num_vertices;
+        chunk.texcoord_offset = num_texcoords;
+        chunk.normal_offset = num_normals;
+        chunk.facet_offset = num_facets;
+        chunk.corner_offset = num_corners;
+        num_lines += chunk.num_lines;
+        num_vertices += chunk.num_vertices;
+        num_colors += chunk.num_colors;
+        num_texcoords += chunk.num_texcoords;
+        num_normals += chunk.num_normals;
+        num_facets += chunk.num_facets;
+        num_corners += chunk.num_corners;
+        num_skipped_facets += chunk.num_skipped_facets;
+        if (chunk.num_facets > 0) {
+            uniform = uniform && chunk.is_uniform() &&
+                      (facet_size == 0 || facet_size == chunk.facet_size);
+            facet_size = chunk.facet_size;
+        }
+    }
+
+    // Resolve object and material ids, following tinyobj conventions: a new object is only
+    // created by an `o` or `g` statement if the current object has facets.
+    logger().trace("[load_mesh_obj] Resolving objects and materials");
+    std::map<std::string, int> material_map;
+    std::vector<tinyobj::material_t> materials;
+    std::string mtl_warn;
+    std::string mtl_err;
+    bool mtl_stream_consumed = false;
+    int material_id = -1;
+    size_t object_id = 0;
+    size_t object_start = 0;
+    std::string object_name;
+    for (auto& chunk : chunks) {
+        chunk.runs.push_back({0, material_id, object_id});
+        for (const auto& event : chunk.events) {
+            const size_t facet = chunk.facet_offset + event.facet;
+            switch (event.type) {
+            case ObjEvent::Type::Object:
+            case ObjEvent::Type::Group:
+                if (facet > object_start) {
+                    result.names.push_back(std::move(object_name));
+                    ++object_id;
+                    object_start = facet;
+                }
+                object_name = event.name;
+                break;
+            case ObjEvent::Type::Material:
+                if (!options.load_materials) break;
+                if (auto it = material_map.find(event.name); it != material_map.end()) {
+                    material_id = it->second;
+                } else {
+                    mtl_warn += fmt::format("Material '{}' not found in .mtl\n", event.name);
+                    material_id = -1;
+                }
+                break;
+            case ObjEvent::Type::MaterialLib:
+                if (!options.load_materials || mtl_stream_consumed) break;
+                load_material_library(
+                    event.name,
+                    input_stream_mtl,
+                    options.search_path,
+                    material_map,
+                    materials,
+                    mtl_warn,
+                    mtl_err);
+                mtl_stream_consumed = (input_stream_mtl != nullptr);
+                break;
+            }
+            if (chunk.runs.back().facet == event.facet) {
+                chunk.runs.back() = {event.facet, material_id, object_id};
+            } else {
+                chunk.runs.push_back({event.facet, material_id, object_id});
+            }
+        }
+    }
+    if (num_facets > object_start) {
+        result.names.push_back(std::move(object_name));
+    }
+    for (const auto& msg : string_split(mtl_warn, '\n')) {
+        if (!msg.empty()) logger().warn("[load_mesh_obj] {}", msg);
+    }
+    for (const auto& msg : string_split(mtl_err, '\n')) {
+        if (!msg.empty()) logger().error("[load_mesh_obj] {}", msg);
+    }
+    if (options.load_materials) {
+        result.materials = std::move(materials);
+    }
+    if (num_skipped_facets) {
+        logger().warn(
+            "[load_mesh_obj] Skipped {} facets with fewer than 3 vertices",
+            num_skipped_facets);
+    }
+
+    // Allocate mesh buffers
+    logger().trace("[load_mesh_obj] Allocating mesh buffers");
+    ObjBuffers<Scalar, Index> buffers;
+    buffers.num_vertices = num_vertices;
+    buffers.num_texcoords = num_texcoords;
+    buffers.num_normals = num_normals;
+
+    mesh.add_vertices(safe_cast<Index>(num_vertices));
+    buffers.positions = mesh.ref_vertex_to_position().ref_all();
+
+    IndexedAttribute<Scalar, Index>* uv_attr = nullptr;
+    if (options.load_uvs && num_texcoords > 0) {
+        auto id = mesh.template create_attribute<Scalar>(
+            AttributeName::texcoord,
+            AttributeElement::Indexed,
+            AttributeUsage::UV,
+            2);
+        uv_attr = &mesh.template ref_indexed_attribute<Scalar>(id);
+        uv_attr->values().resize_elements(num_texcoords);
+        buffers.texcoords = uv_attr->values().ref_all();
+    }
+
+    IndexedAttribute<Scalar, Index>* nrm_attr = nullptr;
+    if (options.load_normals && num_normals > 0) {
+        auto id = mesh.template create_attribute<Scalar>(
+            AttributeName::normal,
+            AttributeElement::Indexed,
+            AttributeUsage::Normal,
+            3);
+        nrm_attr = &mesh.template ref_indexed_attribute<Scalar>(id);
+        nrm_attr->values().resize_elements(num_normals);
+        buffers.normals = nrm_attr->values().ref_all();
+    }
+
+    // Vertex colors are only loaded if every vertex has a color.
+    if (options.load_vertex_colors && num_vertices > 0 && num_colors == num_vertices) {
+        auto id = mesh.template create_attribute<Scalar>(
+            AttributeName::color,
+            AttributeElement::Vertex,
+            AttributeUsage::Color,
+            3);
+        buffers.colors = mesh.template ref_attribute<Scalar>(id).ref_all();
+    }
+
+    if (num_facets > 0) {
+        if (uniform) {
+            mesh.add_polygons(safe_cast<Index>(num_facets), facet_size);
+        } else {
+            std::vector<Index> facet_sizes(num_facets);
+            tbb::parallel_for(size_t(0), chunks.size(), [&](size_t i) {
+                const auto& chunk = chunks[i];
+                auto first = facet_sizes.begin() + static_cast<ptrdiff_t>(chunk.facet_offset);
+                if (chunk.is_uniform()) {
+                    std::fill_n(first, chunk.num_facets, chunk.facet_size);
+                } else {
+                    std::copy(chunk.facet_sizes.begin(), chunk.facet_sizes.end(), first);
+                }
+            });
+            mesh.add_hybrid(facet_sizes);
+        }
+    }
+    la_runtime_assert(mesh.get_num_corners() == num_corners);
+
+    Attribute<SignedIndex>* mat_attr = nullptr;
+    if (options.load_materials) {
+        auto id = mesh.template create_attribute<SignedIndex>(
+            AttributeName::material_id,
+            AttributeElement::Facet,
+            AttributeUsage::Scalar);
+        mat_attr = &mesh.template ref_attribute<SignedIndex>(id);
+    }
+
+    Attribute<Index>* id_attr = nullptr;
+    if (options.load_object_ids) {
+        auto id = mesh.template create_attribute<Index>(
+            AttributeName::object_id,
+            AttributeElement::Facet,
+            AttributeUsage::Scalar);
+        id_attr = &mesh.template ref_attribute<Index>(id);
+    }
+
+    buffers.vertex_indices = mesh.ref_corner_to_vertex().ref_all();
+    if (uv_attr) buffers.texcoord_indices = uv_attr->indices().ref_all();
+    if (nrm_attr) buffers.normal_indices = nrm_attr->indices().ref_all();
+
+    // 2nd pass: parse values directly into the mesh buffers
+    logger().trace("[load_mesh_obj] Parsing elements");
+    tbb::parallel_for(size_t(0), chunks.size(), [&](size_t i) {
+        auto& chunk = chunks[i];
+        parse_chunk(chunk, buffers, options);
+
+        // Fill material and object ids
+        for (size_t r = 0; r < chunk.runs.size(); ++r) {
+            const auto& run = chunk.runs[r];
+            const size_t run_end =
+                (r + 1 < chunk.runs.size() ? chunk.runs[r + 1].facet : chunk.num_facets);
+            const size_t run_size = run_end - run.facet;
+            if (run_size == 0) continue;
+            if (mat_attr) {
+                auto ids = mat_attr->ref_middle(chunk.facet_offset + run.facet, run_size);
+                std::fill(ids.begin(), ids.end(), static_cast<SignedIndex>(run.material_id));
+            }
+            if (id_attr) {
+                auto ids = id_attr->ref_middle(chunk.facet_offset + run.facet, run_size);
+                std::fill(ids.begin(), ids.end(), static_cast<Index>(run.object_id));
+            }
+        }
+    });
+
+    size_t num_missing_texcoords = 0;
+    size_t num_missing_normals = 0;
+    for (const auto& chunk : chunks) {
+        if (!chunk.error.empty()) {
+            logger().error("[load_mesh_obj] {}", chunk.error);
+            result.success = false;
+        }
+        num_missing_texcoords += chunk.num_missing_texcoords;
+        num_missing_normals += chunk.num_missing_normals;
+    }
+    if (!result.success) {
+        return result;
+    }
+    if (num_missing_texcoords) {
+        logger().warn(
+            "Found {} vertices without UV indices. UV attribute will have invalid values.",
+            num_missing_texcoords);
+    }
+    if (num_missing_normals) {
+        logger().warn(
+            "Found {} vertices without normal indices. Normal attribute will have invalid values.",
+            num_missing_normals);
+    }
+    logger().trace("[load_mesh_obj] Loading complete");
+
+    if (options.stitch_vertices) {
+        stitch_mesh(result.mesh);
+    }
+
+    return result;
+}
+
+#define LA_X_parse_obj(_, Scalar, Index)                                         \
+    template ObjReaderResult<Scalar, Index> parse_obj<SurfaceMesh<Scalar, Index>>( \
+        std::string_view,                                                        \
+        std::istream*,                                                           \
+        const LoadOptions&);
+LA_SURFACE_MESH_X(parse_obj, 0)
+#undef LA_X_parse_obj
+
+} // namespace lagrange::io::internal
@@ -0,0 +1,45 @@
+/*
+ * Copyright 2024 Adobe. All rights reserved.
+ * This file is licensed to you under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License. You may obtain a copy
+ * of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under
+ * the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR REPRESENTATIONS
+ * OF ANY KIND, either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+ */
+#pragma once
+
+#include <lagrange/io/internal/load_obj.h>
+#include <lagrange/io/types.h>
+
+#include <iosfwd>
+#include <string_view>
+
+namespace lagrange::io::internal {
+
+///
+/// Parses the content of a .obj file directly into a SurfaceMesh.
+///
+/// The text buffer is split into line-aligned chunks that are parsed in parallel. A first pass
+/// counts elements and records object/group/material changes in each chunk, which are then
+/// resolved serially to allocate the mesh buffers once. A second parallel pass parses the values
+/// and writes them directly into the mesh buffers. The resulting mesh, object ids and material ids
+/// are identical to the ones produced by tinyobj.
+///
+/// @param[in]  data              Content of the .obj file.
+/// @param[in]  input_stream_mtl  Stream to read materials from when a `mtllib` statement is
+///                               encountered. If null, material libraries are loaded from
+///                               `options.search_path` instead.
+/// @param[in]  options           Load options.
+///
+/// @tparam     MeshType          Mesh type to load.
+///
+/// @return     Result of the load.
+///
+template <typename MeshType>
+auto parse_obj(std::string_view data, std::istream* input_stream_mtl, const LoadOptions& options)
+    -> ObjReaderResult<typename MeshType::Scalar, typename MeshType::Index>;
+
+} // namespace lagrange::io::internal
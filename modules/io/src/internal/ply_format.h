@@ -0,0 +1,293 @@
+/*
+ * Copyright 2024 Adobe. All rights reserved.
+ * This file is licensed to you under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License. You may obtain a copy
+ * of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under
+ * the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR REPRESENTATIONS
+ * OF ANY KIND, either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+ */
+#pragma once
+
+#include <lagrange/Logger.h>
+#include <lagrange/utils/Error.h>
+#include <lagrange/utils/strings.h>
+
+#include <algorithm>
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace lagrange::io::internal {
+
+///
+/// Scalar types supported by the PLY format.
+///
+enum class PlyType : uint8_t { Int8, UInt8, Int16, UInt16, Int32, UInt32, Float32, Float64 };
+
+///
+/// Encoding of the PLY payload.
+///
+enum class PlyFormat : uint8_t { Ascii, BinaryLittleEndian, BinaryBigEndian };
+
+///
+/// A property of a PLY element, either a scalar or a list of scalars.
+///
+struct PlyProperty
+{
+    std::string name;
+    PlyType type = PlyType::Float32;
+    bool is_list = false;
+    PlyType count_type = PlyType::UInt8;
+};
+
+///
+/// A PLY element, i.e. a group of records sharing the same properties.
+///
+struct PlyElement
+{
+    std::string name;
+    size_t count = 0;
+    std::vector<PlyProperty> properties;
+
+    /// Returns the index of a property with a given name, or `properties.size()` if not found.
+    size_t find_property(std::string_view property_name) const
+    {
+        size_t i = 0;
+        while (i < properties.size() && properties[i].name != property_name) ++i;
+        return i;
+    }
+};
+
+///
+/// Parsed PLY header.
+///
+struct PlyHeader
+{
+    PlyFormat format = PlyFormat::Ascii;
+    std::vector<PlyElement> elements;
+
+    /// Size of the header in bytes, including the `end_header` line.
+    size_t size = 0;
+
+    /// Returns a pointer to the element with a given name, or nullptr if not found.
+    const PlyElement* find_element(std::string_view element_name) const
+    {
+        for (const auto& element : elements) {
+            if (element.name == element_name) return &element;
+        }
+        return nullptr;
+    }
+};
+
+/// Size in bytes of a PLY scalar type.
+inline size_t ply_type_size(PlyType type)
+{
+    switch (type) {
+    case PlyType::Int8:
+    case PlyType::UInt8: return 1;
+    case PlyType::Int16:
+    case PlyType::UInt16: return 2;
+    case PlyType::Int32:
+    case PlyType::UInt32:
+    case PlyType::Float32: return 4;
+    case PlyType::Float64: return 8;
+    }
+    return 0;
+}
+
+/// Name of a PLY scalar type, as written in PLY headers.
+inline std::string_view ply_type_name(PlyType type)
+{
+    switch (type) {
+    case PlyType::Int8: return "char";
+    case PlyType::UInt8: return "uchar";
+    case PlyType::Int16: return "short";
+    case PlyType::UInt16: return "ushort";
+    case PlyType::Int32: return "int";
+    case PlyType::UInt32: return "uint";
+    case PlyType::Float32: return "float";
+    case PlyType::Float64: return "double";
+    }
+    return "";
+}
+
+/// PLY scalar type corresponding to a C++ type.
+template <typename T>
+constexpr PlyType ply_type_of()
+{
+    if constexpr (std::is_same_v<T, int8_t>) return PlyType::Int8;
+    if constexpr (std::is_same_v<T, uint8_t>) return PlyType::UInt8;
+    if constexpr (std::is_same_v<T, int16_t>) return PlyType::Int16;
+    if constexpr (std::is_same_v<T, uint16_t>) return PlyType::UInt16;
+    if constexpr (std::is_same_v<T, int32_t>) return PlyType::Int32;
+    if constexpr (std::is_same_v<T, uint32_t>) return PlyType::UInt32;
+    if constexpr (std::is_same_v<T, float>) return PlyType::Float32;
+    if constexpr (std::is_same_v<T, double>) return PlyType::Float64;
+}
+
+///
+/// Calls a function with a default-constructed value of the C++ type corresponding to a PLY type.
+///
+template <typename Func>
+decltype(auto) visit_ply_type(PlyType type, Func&& func)
+{
+    switch (type) {
+    case PlyType::Int8: return func(int8_t());
+    case PlyType::UInt8: return func(uint8_t());
+    case PlyType::Int16: return func(int16_t());
+    case PlyType::UInt16: return func(uint16_t());
+    case PlyType::Int32: return func(int32_t());
+    case PlyType::UInt32: return func(uint32_t());
+    case PlyType::Float32: return func(float());
+    default: return func(double());
+    }
+}
+
+/// Whether the host stores multi-byte values in little endian order.
+inline bool host_is_little_endian()
+{
+    const uint16_t x = 1;
+    uint8_t b;
+    std::memcpy(&b, &x, 1);
+    return b == 1;
+}
+
+/// Whether the binary payload of a PLY file uses the host byte order.
+inline bool is_native_byte_order(PlyFormat format)
+{
+    return (format == PlyFormat::BinaryLittleEndian) == host_is_little_endian();
+}
+
+inline PlyType parse_ply_type(std::string_view name)
+{
+    if (name == "char" || name == "int8") return PlyType::Int8;
+    if (name == "uchar" || name == "uint8") return PlyType::UInt8;
+    if (name == "short" || name == "int16") return PlyType::Int16;
+    if (name == "ushort" || name == "uint16") return PlyType::UInt16;
+    if (name == "int" || name == "int32") return PlyType::Int32;
+    if (name == "uint" || name == "uint32") return PlyType::UInt32;
+    if (name == "float" || name == "float32") return PlyType::Float32;
+    if (name == "double" || name == "float64") return PlyType::Float64;
+    throw Error(fmt::format("Unsupported PLY property type: '{}'", name));
+}
+
+/// Parses the number of records of an element.
+inline size_t parse_ply_count(std::string_view text)
+{
+    size_t count = 0;
+    const char* end = text.data() + text.size();
+    auto [ptr, ec] = std::from_chars(text.data(), end, count);
+    if (ec != std::errc() || ptr != end) {
+        throw Error(fmt::format("Invalid PLY element count: '{}'", text));
+    }
+    return count;
+}
+
+///
+/// Parses the header of a PLY file.
+///
+/// @param[in]  data  Buffer starting with the PLY header. It may contain the payload as well, only
+///                   the header part is read.
+///
+/// @throws     lagrange::Error if the header is malformed.
+///
+/// @return     The parsed header.
+///
+inline PlyHeader parse_ply_header(std::string_view data)
+{
+    PlyHeader header;
+    bool has_format = false;
+    size_t pos = 0;
+    size_t line_number = 0;
+    while (true) {
+        if (pos >= data.size()) {
+            throw Error("Invalid PLY header: missing 'end_header'");
+        }
+        size_t eol = data.find('\n', pos);
+        if (eol == std::string_view::npos) eol = data.size();
+        std::string line(data.substr(pos, eol - pos));
+        pos = std::min(eol + 1, data.size());
+
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        auto tokens = string_split(line, ' ');
+        tokens.erase(std::remove(tokens.begin(), tokens.end(), std::string()), tokens.end());
+
+        if (line_number++ == 0) {
+            if (tokens.size() != 1 || tokens[0] != "ply") {
+                throw Error("Invalid PLY header: missing 'ply' magic number");
+            }
+            continue;
+        }
+        if (tokens.empty() || tokens[0] == "comment" || tokens[0] == "obj_info") continue;
+
+        if (tokens[0] == "end_header") {
+            break;
+        } else if (tokens[0] == "format" && tokens.size() >= 2) {
+            if (tokens[1] == "ascii") {
+                header.format = PlyFormat::Ascii;
+            } else if (tokens[1] == "binary_little_endian") {
+                header.format = PlyFormat::BinaryLittleEndian;
+            } else if (tokens[1] == "binary_big_endian") {
+                header.format = PlyFormat::BinaryBigEndian;
+            } else {
+                throw Error(fmt::format("Invalid PLY format: '{}'", tokens[1]));
+            }
+            has_format = true;
+        } else if (tokens[0] == "element" && tokens.size() == 3) {
+            PlyElement element;
+            element.name = tokens[1];
+            element.count = parse_ply_count(tokens[2]);
+            header.elements.push_back(std::move(element));
+        } else if (tokens[0] == "property" && !header.elements.empty()) {
+            PlyProperty property;
+            if (tokens.size() == 5 && tokens[1] == "list") {
+                property.is_list = true;
+                property.count_type = parse_ply_type(tokens[2]);
+                property.type = parse_ply_type(tokens[3]);
+                property.name = tokens[4];
+            } else if (tokens.size() == 3) {
+                property.type = parse_ply_type(tokens[1]);
+                property.name = tokens[2];
+            } else {
+                throw Error(fmt::format("Invalid PLY property: '{}'", line));
+            }
+            header.elements.back().properties.push_back(std::move(property));
+        } else {
+            throw Error(fmt::format("Invalid PLY header line: '{}'", line));
+        }
+    }
+    if (!has_format) {
+        throw Error("Invalid PLY header: missing format");
+    }
+    header.size = pos;
+    return header;
+}
+
+///
+/// Reads the header of a PLY file from a stream, leaving the stream at the start of the payload.
+///
+/// @param[in,out] input_stream  Input stream.
+///
+/// @return     The raw header text, including the `end_header` line.
+///
+inline std::string read_ply_header(std::istream& input_stream)
+{
+    std::string header;
+    std::string line;
+    while (std::getline(input_stream, line)) {
+        header += line;
+        header += '\n';
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (line == "end_header") break;
+    }
+    return header;
+}
+
+} // namespace lagrange::io::internal
@@ -13,22 +13,18 @@
 #include <lagrange/AttributeValueType.h>
 #include <lagrange/image_io/load_image.h>
 #include <lagrange/io/internal/scene_utils.h>
+#include <lagrange/utils/Error.h>
+#include <lagrange/utils/assert.h>
 
 namespace lagrange::io::internal {
 
-bool try_load_image(
-    const std::string& name,
-    const LoadOptions& options,
-    scene::ImageExperimental& image)
-{
-    fs::path path = name;
-    if (path.is_relative() && !options.search_path.empty()) path = options.search_path / name;
-    if (path.empty()) return false;
+namespace {
 
+bool load_image_buffer(const fs::path& path, scene::ImageBufferExperimental& buffer)
+{
     image_io::LoadImageResult result = image_io::load_image(path);
     if (!result.valid) return false;
 
-    scene::ImageBufferExperimental& buffer = image.image;
     buffer.width = result.width;
     buffer.height = result.height;
     buffer.num_channels = static_cast<size_t>(result.channel);
@@ -55,4 +51,35 @@ bool try_load_image(
     return true;
 }
 
+} // namespace
+
+bool try_load_image(
+    const std::string& name,
+    const LoadOptions& options,
+    scene::ImageExperimental& image)
+{
+    fs::path path = name;
+    if (path.is_relative() && !options.search_path.empty()) path = options.search_path / name;
+    if (path.empty()) return false;
+
+    if (options.lazy_images) {
+        // Only keep a handle to the file, which is read and decoded on first access.
+        if (!fs::exists(path)) return false;
+        image.lazy_image = std::make_shared<scene::LazyImageExperimental>(
+            SharedSpan<const unsigned char>(),
+            std::string(),
+            [path]() {
+                scene::ImageBufferExperimental buffer;
+                if (!load_image_buffer(path, buffer)) {
+                    throw Error(fmt::format("Failed to load image {}", path.string()));
+                }
+                return buffer;
+            },
+            options.image_cache);
+        return true;
+    }
+
+    return load_image_buffer(path, image.image);
+}
+
 } // namespace lagrange::io::internal
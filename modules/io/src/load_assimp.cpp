@@ -41,7 +41,15 @@
 
     #include <Eigen/Core>
 
+    // clang-format off
+    #include <lagrange/utils/warnoff.h>
+    #include <tbb/parallel_for.h>
+    #include <tbb/task_group.h>
+    #include <lagrange/utils/warnon.h>
+    // clang-format on
+
     #include <istream>
+    #include <unordered_map>
 
 // =====================================
 // internal/load_assimp.h
@@ -298,9 +306,9 @@ MeshType load_mesh_assimp(const aiScene& scene, const LoadOptions& options)
         return convert_mesh_assimp_to_lagrange<MeshType>(*scene.mMeshes[0], options);
     } else {
         std::vector<MeshType> meshes(scene.mNumMeshes);
-        for (unsigned int i = 0; i < scene.mNumMeshes; ++i) {
+        tbb::parallel_for(0u, scene.mNumMeshes, [&](unsigned int i) {
             meshes[i] = convert_mesh_assimp_to_lagrange<MeshType>(*scene.mMeshes[i], options);
-        }
+        });
         bool preserve_attributes = true;
         return combine_meshes<typename MeshType::Scalar, typename MeshType::Index>(
             meshes,
@@ -325,10 +333,14 @@ SceneType load_simple_scene_assimp(const aiScene& scene, const LoadOptions& opti
 
     SceneType lscene;
 
-    for (unsigned int i = 0; i < scene.mNumMeshes; ++i) {
+    std::vector<MeshType> lmeshes(scene.mNumMeshes);
+    tbb::parallel_for(0u, scene.mNumMeshes, [&](unsigned int i) {
+        lmeshes[i] = convert_mesh_assimp_to_lagrange<MeshType>(*scene.mMeshes[i], options);
+    });
+    for (MeshType& lmesh : lmeshes) {
         // By adding in the same order, we can assume that assimp's indexing is the same
         // as in the lagrange scene. We use this later.
-        lscene.add_mesh(convert_mesh_assimp_to_lagrange<MeshType>(*scene.mMeshes[i], options));
+        lscene.add_mesh(std::move(lmesh));
     }
     std::function<void(aiNode*, AffineTransform)> visit_node;
     visit_node = [&](aiNode* node, const AffineTransform& parent_transform) -> void {
@@ -365,13 +377,20 @@ LA_SIMPLE_SCENE_X(load_simple_scene_assimp, 0);
 template <typename SceneType>
 SceneType load_scene_assimp(const aiScene& scene, const LoadOptions& options)
 {
+    using MeshType = typename SceneType::MeshType;
+
     SceneType lscene;
     lscene.name = scene.mName.C_Str();
-    for (unsigned int i = 0; i < scene.mNumMeshes; ++i) {
-        lscene.add(convert_mesh_assimp_to_lagrange<typename SceneType::MeshType>(
-            *scene.mMeshes[i],
-            options));
-    }
+
+    // Meshes are converted in the background while the other scene elements are converted on the
+    // calling thread. They are added to the scene in the assimp order once the task is done.
+    std::vector<MeshType> lmeshes(scene.mNumMeshes);
+    tbb::task_group tasks;
+    tasks.run([&] {
+        tbb::parallel_for(0u, scene.mNumMeshes, [&](unsigned int i) {
+            lmeshes[i] = convert_mesh_assimp_to_lagrange<MeshType>(*scene.mMeshes[i], options);
+        });
+    });
 
     // note that assimp's textures are really images.
     // We must load these before the materials below, or indices will be off.
@@ -406,26 +425,24 @@ SceneType load_scene_assimp(const aiScene& scene, const LoadOptions& options)
         lscene.add(std::move(limage));
     }
 
-    // load an image from embedded or from disk.
-    // If successful, saves the image in the scene and returns its index.
-    // Otherwise, returns -1.
+    // find an image from embedded or from disk, and returns its index.
+    // Images on disk are added once per path, and their pixels are loaded in parallel after all
+    // materials are converted.
+    std::unordered_map<std::string, int> external_images;
     auto try_image_load = [&](const aiMaterial*, const char* s) -> int {
         auto [texture, index] = scene.GetEmbeddedTextureAndIndex(s);
         if (index >= 0) {
             return index;
         } else {
+            auto it = external_images.find(s);
+            if (it != external_images.end()) return it->second;
+
             scene::ImageExperimental limage;
             limage.name = s;
             limage.uri = s;
-            if (options.load_images) {
-                if (io::internal::try_load_image(s, options, limage)) {
-                    return static_cast<int>(lscene.add(std::move(limage)));
-                } else {
-                    return -1;
-                }
-            } else {
-                return static_cast<int>(lscene.add(std::move(limage)));
-            }
+            const int image_idx = static_cast<int>(lscene.add(std::move(limage)));
+            external_images.emplace(s, image_idx);
+            return image_idx;
         }
     };
     auto convert_map_mode = [](aiTextureMapMode mode) -> scene::Texture::WrapMode {
@@ -553,9 +570,28 @@ SceneType load_scene_assimp(const aiScene& scene, const LoadOptions& options)
 
         lscene.materials.emplace_back(std::move(lmat));
     }
+    if (options.load_images) {
+        std::vector<int> image_indices;
+        image_indices.reserve(external_images.size());
+        for (const auto& [name, image_idx] : external_images) {
+            image_indices.push_back(image_idx);
+        }
+        tbb::parallel_for(size_t(0), image_indices.size(), [&](size_t i) {
+            scene::ImageExperimental& limage = lscene.images[image_indices[i]];
+            if (!io::internal::try_load_image(limage.name, options, limage)) {
+                logger().warn("Failed to load image '{}'", limage.name);
+            }
+        });
+    }
     for (unsigned int i = 0; i < scene.mNumAnimations; ++i) {
         // TODO
     }
+
+    tasks.wait();
+    for (MeshType& lmesh : lmeshes) {
+        lscene.add(std::move(lmesh));
+    }
+
     for (unsigned int i = 0; i < scene.mNumLights; ++i) {
         lscene.lights.push_back(convert_light_assimp_to_lagrange(scene.mLights[i]));
     }
@@ -12,32 +12,47 @@
 
 // this .cpp provides implementations for functions defined in those headers:
 #include <lagrange/io/api.h>
+#include <lagrange/io/internal/load_gltf.h>
 #include <lagrange/io/load_mesh_gltf.h>
 #include <lagrange/io/load_scene_gltf.h>
 #include <lagrange/io/load_simple_scene_gltf.h>
 
+#include "internal/gltf_compression.h"
 #include "stitch_mesh.h"
 
 // ====
 
+#include <lagrange/Attribute.h>
 #include <lagrange/AttributeValueType.h>
 #include <lagrange/Logger.h>
 #include <lagrange/SurfaceMeshTypes.h>
 #include <lagrange/combine_meshes.h>
+#include <lagrange/fs/MappedFile.h>
 #include <lagrange/internal/skinning.h>
 #include <lagrange/scene/SceneTypes.h>
 #include <lagrange/scene/SimpleSceneTypes.h>
 #include <lagrange/scene/scene_utils.h>
 #include <lagrange/scene/simple_scene_convert.h>
 #include <lagrange/utils/Error.h>
+#include <lagrange/utils/SharedSpan.h>
 #include <lagrange/utils/assert.h>
 #include <lagrange/utils/safe_cast.h>
 #include <lagrange/utils/strings.h>
 
+#include <stb_image.h>
 #include <tiny_gltf.h>
 #include <Eigen/Geometry>
 
+// clang-format off
+#include <lagrange/utils/warnoff.h>
+#include <tbb/parallel_for.h>
+#include <tbb/task_group.h>
+#include <lagrange/utils/warnon.h>
+// clang-format on
+
+#include <cstring>
 #include <istream>
+#include <memory>
 #include <optional>
 
 namespace lagrange::io {
@@ -117,30 +132,85 @@ size_t get_num_channels(int type)
     return invalid<size_t>();
 }
 
-template <typename Orig_t, typename Target_t>
-std::vector<Target_t> load_buffer_data_internal(
-    const tinygltf::Model& model,
-    const tinygltf::Accessor& accessor)
+template <typename T>
+constexpr int get_component_type()
 {
-    const tinygltf::BufferView& buffer_view = model.bufferViews[accessor.bufferView];
-    const tinygltf::Buffer& buffer = model.buffers[buffer_view.buffer];
-
-    size_t size = get_num_channels(accessor.type);
+    if constexpr (std::is_same_v<T, int8_t>) {
+        return TINYGLTF_COMPONENT_TYPE_BYTE;
+    } else if constexpr (std::is_same_v<T, uint8_t>) {
+        return TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE;
+    } else if constexpr (std::is_same_v<T, int16_t>) {
+        return TINYGLTF_COMPONENT_TYPE_SHORT;
+    } else if constexpr (std::is_same_v<T, uint16_t>) {
+        return TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT;
+    } else if constexpr (std::is_same_v<T, int32_t>) {
+        return TINYGLTF_COMPONENT_TYPE_INT;
+    } else if constexpr (std::is_same_v<T, uint32_t>) {
+        return TINYGLTF_COMPONENT_TYPE_UNSIGNED_INT;
+    } else if constexpr (std::is_same_v<T, float>) {
+        return TINYGLTF_COMPONENT_TYPE_FLOAT;
+    } else if constexpr (std::is_same_v<T, double>) {
+        return TINYGLTF_COMPONENT_TYPE_DOUBLE;
+    } else {
+        return -1;
+    }
+}
 
-    std::vector<Orig_t> data(accessor.count * size);
+///
+/// Gets a pointer to the first element of an accessor, checking that all its elements lie within
+/// the underlying buffer.
+///
+/// @param model         The glTF model object.
+/// @param accessor      The accessor object.
+/// @param num_channels  The number of components per element.
+/// @param stride        The number of bytes between two consecutive elements.
+///
+/// @tparam Orig_t       The component type stored in the buffer.
+///
+/// @return Pointer to the first byte of the accessor data.
+///
+template <typename Orig_t>
+const unsigned char* get_accessor_data(
+    const tinygltf::Model& model,
+    const tinygltf::Accessor& accessor,
+    size_t num_channels,
+    size_t stride)
+{
+    const tinygltf::BufferView& buffer_view = model.bufferViews.at(accessor.bufferView);
+    const tinygltf::Buffer& buffer = model.buffers.at(buffer_view.buffer);
 
     const size_t start = accessor.byteOffset + buffer_view.byteOffset;
-    if (buffer_view.byteStride) {
-        for (size_t i = 0; i < accessor.count; ++i) {
-            size_t buf_idx = start + buffer_view.byteStride * i;
-            std::memcpy(&data.at(i * size), &buffer.data.at(buf_idx), size * sizeof(Orig_t));
-        }
-    } else if (accessor.count > 0) {
-        std::memcpy(&data.at(0), &buffer.data.at(start), accessor.count * size * sizeof(Orig_t));
+    if (accessor.count > 0 &&
+        start + stride * (accessor.count - 1) + num_channels * sizeof(Orig_t) >
+            buffer.data.size()) {
+        throw Error("Accessor data exceeds the size of its buffer");
     }
+    return buffer.data.data() + start;
+}
 
-    std::vector<Target_t> ret;
-    std::transform(data.begin(), data.end(), std::back_inserter(ret), [&](Orig_t x) {
+template <typename Orig_t>
+size_t get_byte_stride(const tinygltf::BufferView& buffer_view, size_t num_channels)
+{
+    return buffer_view.byteStride ? buffer_view.byteStride : num_channels * sizeof(Orig_t);
+}
+
+template <typename Orig_t, typename Target_t>
+std::vector<Target_t> load_buffer_data_internal(
+    const tinygltf::Model& model,
+    const tinygltf::Accessor& accessor)
+{
+    const tinygltf::BufferView& buffer_view = model.bufferViews.at(accessor.bufferView);
+    const size_t size = get_num_channels(accessor.type);
+    const size_t stride = get_byte_stride<Orig_t>(buffer_view, size);
+    const unsigned char* data = get_accessor_data<Orig_t>(model, accessor, size, stride);
+
+    if (accessor.normalized && accessor.componentType != TINYGLTF_COMPONENT_TYPE_BYTE &&
+        accessor.componentType != TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE &&
+        accessor.componentType != TINYGLTF_COMPONENT_TYPE_SHORT &&
+        accessor.componentType != TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT) {
+        throw Error("Invalid normalized/componentType pair!");
+    }
+    auto convert = [&](Orig_t x) {
         if (accessor.normalized) {
             // If needed, convert normalized values into float or double. Details here:
             // https://registry.khronos.org/glTF/specs/2.0/glTF-2.0.html#animations
@@ -150,59 +220,102 @@ std::vector<Target_t> load_buffer_data_internal(
                 return Target_t(x / 255.0);
             } else if (accessor.componentType == TINYGLTF_COMPONENT_TYPE_SHORT) {
                 return Target_t(std::max(x / 32767.0, -1.0));
-            } else if (accessor.componentType == TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT) {
-                return Target_t(x / 65535.0);
             } else {
-                la_runtime_assert("Invalid normalized/componentType pair!");
-                return Target_t(0); // happy compiler
+                return Target_t(x / 65535.0);
             }
         } else {
             return Target_t(x);
         }
+    };
+
+    // Strided and normalized data is decoded in a single pass, straight from the glTF buffer.
+    std::vector<Target_t> ret(accessor.count * size);
+    tbb::parallel_for(size_t(0), size_t(accessor.count), [&](size_t i) {
+        const unsigned char* element = data + i * stride;
+        for (size_t c = 0; c < size; ++c) {
+            Orig_t x;
+            std::memcpy(&x, element + c * sizeof(Orig_t), sizeof(Orig_t));
+            ret[i * size + c] = convert(x);
+        }
     });
     return ret;
 }
 
 ///
-/// Load accessor buffer data as a span of ValueType without any copy.
+/// Wraps accessor buffer data as a span of ValueType without any copy. This is only possible if
+/// the accessor is tightly packed, properly aligned, and stores values of type ValueType.
+///
+/// @tparam ValueType  The value type of the span.
+/// @param model       The glTF model object.
+/// @param accessor    The accessor object.
+/// @param owner       Owner of the model buffers, or nullptr if they cannot be shared.
+///
+/// @return A span sharing the ownership of the glTF buffer, or std::nullopt if the accessor data
+///         needs to be copied.
+///
+template <typename ValueType>
+std::optional<SharedSpan<const ValueType>> wrap_buffer(
+    const tinygltf::Model& model,
+    const tinygltf::Accessor& accessor,
+    const std::shared_ptr<const void>& owner)
+{
+    if (owner == nullptr || accessor.sparse.isSparse || accessor.bufferView < 0 ||
+        accessor.count == 0 || accessor.componentType != get_component_type<ValueType>()) {
+        return std::nullopt;
+    }
+    const size_t num_channels = get_num_channels(accessor.type);
+    if (num_channels == invalid<size_t>()) return std::nullopt;
+
+    const tinygltf::BufferView& buffer_view = model.bufferViews.at(accessor.bufferView);
+    const size_t stride = get_byte_stride<ValueType>(buffer_view, num_channels);
+    if (stride != num_channels * sizeof(ValueType)) return std::nullopt;
+
+    const unsigned char* data = get_accessor_data<ValueType>(model, accessor, num_channels, stride);
+    if (reinterpret_cast<uintptr_t>(data) % alignof(ValueType) != 0) return std::nullopt;
+
+    return make_shared_span(
+        owner,
+        reinterpret_cast<const ValueType*>(data),
+        accessor.count * num_channels);
+}
+
+///
+/// Load accessor buffer data as a span of ValueType, without any conversion. Tightly packed data
+/// is shared with the glTF buffer, strided data is copied into a new buffer.
 ///
-/// @tparam ValueType      The value type of the span.
-/// @param model           The glTF model object.
-/// @param accessor        The accessor object.
-/// @param working_buffer  A working buffer to store the data if necessary.
+/// @tparam ValueType  The value type of the span.
+/// @param model       The glTF model object.
+/// @param accessor    The accessor object.
+/// @param owner       Owner of the model buffers, or nullptr if they cannot be shared.
 ///
-/// @return A span of ValueType that points to the buffer data stored in the accessor.
+/// @return A span sharing the ownership of the buffer data.
 ///
 template <typename ValueType>
-span<const ValueType> load_buffer(
+SharedSpan<const ValueType> load_buffer(
     const tinygltf::Model& model,
     const tinygltf::Accessor& accessor,
-    std::vector<ValueType>& working_buffer)
+    const std::shared_ptr<const void>& owner)
 {
-    const tinygltf::BufferView& buffer_view = model.bufferViews[accessor.bufferView];
-    const tinygltf::Buffer& buffer = model.buffers[buffer_view.buffer];
+    if (auto values = wrap_buffer<ValueType>(model, accessor, owner)) {
+        return *values;
+    }
 
-    size_t num_channels = get_num_channels(accessor.type);
+    const size_t num_channels = get_num_channels(accessor.type);
     if (num_channels == invalid<size_t>())
         throw Error(fmt::format("Unsupported accessor type {}", accessor.type));
 
-    const size_t start = accessor.byteOffset + buffer_view.byteOffset;
+    const tinygltf::BufferView& buffer_view = model.bufferViews.at(accessor.bufferView);
+    const size_t stride = get_byte_stride<ValueType>(buffer_view, num_channels);
+    const unsigned char* data = get_accessor_data<ValueType>(model, accessor, num_channels, stride);
 
-    if (buffer_view.byteStride != 0) {
-        working_buffer.resize(accessor.count * num_channels);
-        for (size_t i = 0; i < accessor.count; ++i) {
-            size_t buf_idx = start + buffer_view.byteStride * i;
-            std::copy_n(
-                reinterpret_cast<const ValueType*>(buffer.data.data() + buf_idx),
-                num_channels,
-                working_buffer.data() + i * num_channels);
-        }
-        return {working_buffer.data(), working_buffer.size()};
-    } else {
-        return {
-            reinterpret_cast<const ValueType*>(buffer.data.data() + start),
-            accessor.count * num_channels};
-    }
+    auto values = std::make_shared<std::vector<ValueType>>(accessor.count * num_channels);
+    tbb::parallel_for(size_t(0), size_t(accessor.count), [&](size_t i) {
+        std::memcpy(
+            values->data() + i * num_channels,
+            data + i * stride,
+            num_channels * sizeof(ValueType));
+    });
+    return make_shared_span(values, static_cast<const ValueType*>(values->data()), values->size());
 }
 
 template <typename T>
@@ -233,13 +346,143 @@ std::vector<T> load_buffer_data_as(const tinygltf::Model& model, const tinygltf:
     return std::vector<T>(); // make compiler happy
 }
 
+///
+/// Load accessor buffer data as a span of T. The accessor data is shared with the glTF buffer when
+/// it is tightly packed and stored as T, and decoded into a new buffer otherwise.
+///
+/// @tparam T        The target value type.
+/// @param model     The glTF model object.
+/// @param accessor  The accessor object.
+/// @param owner     Owner of the model buffers, or nullptr if they cannot be shared.
+///
+/// @return A span sharing the ownership of the data.
+///
+template <typename T>
+SharedSpan<const T> load_buffer_data_as(
+    const tinygltf::Model& model,
+    const tinygltf::Accessor& accessor,
+    const std::shared_ptr<const void>& owner)
+{
+    if (!accessor.normalized) {
+        if (auto values = wrap_buffer<T>(model, accessor, owner)) {
+            return *values;
+        }
+    }
+    auto values = std::make_shared<std::vector<T>>(load_buffer_data_as<T>(model, accessor));
+    return make_shared_span(values, static_cast<const T*>(values->data()), values->size());
+}
+
+/// Wrapped buffers are copied when modified, resized or shrunk.
+template <typename ValueType>
+void set_copy_on_write(Attribute<ValueType>& attr)
+{
+    attr.set_write_policy(AttributeWritePolicy::SilentCopy);
+    attr.set_growth_policy(AttributeGrowthPolicy::SilentCopy);
+    attr.set_shrink_policy(AttributeShrinkPolicy::SilentCopy);
+}
+
 // =====================================
 
+///
+/// Image loader callback keeping the encoded image bytes instead of decoding them while the glTF
+/// file is parsed. Images are decoded afterwards with decode_image(), concurrently with the mesh
+/// conversion, and only when they are actually needed.
+///
+bool store_encoded_image(
+    tinygltf::Image* image,
+    const int /*image_idx*/,
+    std::string* /*err*/,
+    std::string* /*warn*/,
+    int /*req_width*/,
+    int /*req_height*/,
+    const unsigned char* bytes,
+    int size,
+    void* /*user_data*/)
+{
+    image->image.assign(bytes, bytes + size);
+    return true;
+}
+
+///
+/// Decodes a PNG or JPEG image kept encoded by store_encoded_image(). Pixels are decoded to 8-bit
+/// or 16-bit RGBA, matching the default image loader of tinygltf.
+///
+/// @param[in]  bytes  The encoded image.
+/// @param[in]  name   The image name, used in error messages.
+///
+/// @return     The decoded image.
+///
+scene::ImageBufferExperimental decode_image(
+    span<const unsigned char> bytes,
+    const std::string& name)
+{
+    la_runtime_assert(!bytes.empty(), fmt::format("Missing data for image '{}'", name));
+
+    const int size = safe_cast<int>(bytes.size());
+    constexpr int num_channels = 4;
+    int width = 0;
+    int height = 0;
+    int file_channels = 0;
+    void* pixels = nullptr;
+    scene::ImageBufferExperimental buffer;
+    if (stbi_is_16_bit_from_memory(bytes.data(), size)) {
+        pixels = stbi_load_16_from_memory(
+            bytes.data(),
+            size,
+            &width,
+            &height,
+            &file_channels,
+            num_channels);
+        buffer.element_type = AttributeValueType::e_uint16_t;
+    }
+    if (pixels == nullptr) {
+        pixels = stbi_load_from_memory(
+            bytes.data(),
+            size,
+            &width,
+            &height,
+            &file_channels,
+            num_channels);
+        buffer.element_type = AttributeValueType::e_uint8_t;
+    }
+    if (pixels == nullptr) {
+        throw Error(fmt::format("Failed to decode image '{}': {}", name, stbi_failure_reason()));
+    }
+    std::unique_ptr<void, decltype(&stbi_image_free)> guard(pixels, &stbi_image_free);
+
+    buffer.width = static_cast<size_t>(width);
+    buffer.height = static_cast<size_t>(height);
+    buffer.num_channels = num_channels;
+    const size_t num_bytes =
+        buffer.width * buffer.height * buffer.num_channels * buffer.get_bits_per_element() / 8;
+    buffer.data.assign(
+        static_cast<const unsigned char*>(pixels),
+        static_cast<const unsigned char*>(pixels) + num_bytes);
+    return buffer;
+}
+
+///
+/// Gets the mime type of an encoded image, from its signature or from the glTF image declaration.
+///
+std::string get_image_mime_type(const tinygltf::Image& image)
+{
+    const std::vector<unsigned char>& bytes = image.image;
+    if (bytes.size() >= 4 && bytes[0] == 0x89 && bytes[1] == 'P' && bytes[2] == 'N' &&
+        bytes[3] == 'G') {
+        return "image/png";
+    }
+    if (bytes.size() >= 3 && bytes[0] == 0xFF && bytes[1] == 0xD8 && bytes[2] == 0xFF) {
+        return "image/jpeg";
+    }
+    return image.mimeType;
+}
+
 tinygltf::Model load_tinygltf(std::istream& input_stream)
 {
     tinygltf::Model model;
     tinygltf::TinyGLTF loader;
     loader.SetStoreOriginalJSONForExtrasAndExtensions(true);
+    loader.SetImageLoader(&store_encoded_image, nullptr);
     std::string err;
     std::string warn;
     bool ret;
@@ -275,6 +518,7 @@ tinygltf::Model load_tinygltf(std::istream& input_stream)
     if (!ret || !err.empty()) {
         throw std::runtime_error(err);
     }
+    internal::decode_gltf_compression(model);
 
     return model;
 }
@@ -284,6 +528,7 @@ tinygltf::Model load_tinygltf(const fs::path& filename)
     tinygltf::Model model;
     tinygltf::TinyGLTF loader;
     loader.SetStoreOriginalJSONForExtrasAndExtensions(true);
+    loader.SetImageLoader(&store_encoded_image, nullptr);
     std::string err;
     std::string warn;
     bool ret;
@@ -291,7 +536,15 @@ tinygltf::Model load_tinygltf(const fs::path& filename)
         ret = loader.LoadASCIIFromFile(&model, &err, &warn, filename.string());
     } else {
         la_runtime_assert(to_lower(filename.extension().string()) == ".glb");
-        ret = loader.LoadBinaryFromFile(&model, &err, &warn, filename.string());
+        // Parse the file straight from a read-only mapping, instead of reading it into memory.
+        fs::MappedFile file(filename);
+        ret = loader.LoadBinaryFromMemory(
+            &model,
+            &err,
+            &warn,
+            reinterpret_cast<const unsigned char*>(file.data()),
+            safe_cast<unsigned int>(file.size()),
+            filename.parent_path().string());
     }
 
     if (!warn.empty()) {
@@ -302,6 +555,7 @@ tinygltf::Model load_tinygltf(const fs::path& filename)
     if (!ret || !err.empty()) {
         throw std::runtime_error(err);
     }
+    internal::decode_gltf_compression(model);
 
     return model;
 }
@@ -315,6 +569,7 @@ tinygltf::Model load_tinygltf(const fs::path& filename)
 ///
 /// @param model        The gltf model object.
 /// @param accessor     The gltf accessor object.
+/// @param owner        Owner of the model buffers, or nullptr if they cannot be shared.
 /// @param name         The attribute name.
 /// @param target_usage The target attribute usage if any.
 /// @param mesh         The lagrange mesh.
@@ -323,13 +578,11 @@ template <typename ValueType, typename Scalar, typename Index>
 void accessor_to_attribute_internal(
     const tinygltf::Model& model,
     const tinygltf::Accessor& accessor,
+    const std::shared_ptr<const void>& owner,
     std::string_view name,
     std::optional<AttributeUsage> target_usage,
     SurfaceMesh<Scalar, Index>& mesh)
 {
-    std::vector<ValueType> working_buffer;
-    span<const ValueType> data = load_buffer<ValueType>(model, accessor, working_buffer);
-    Index num_channels = static_cast<Index>(data.size() / accessor.count);
     AttributeElement element = AttributeElement::Vertex;
     AttributeUsage usage = AttributeUsage::Scalar;
 
@@ -362,7 +615,14 @@ void accessor_to_attribute_internal(
         }
     }
 
-    mesh.template create_attribute<ValueType>(name, element, usage, num_channels, data);
+    SharedSpan<const ValueType> values = load_buffer<ValueType>(model, accessor, owner);
+    AttributeId id = mesh.template wrap_as_const_attribute<ValueType>(
+        name,
+        element,
+        usage,
+        get_num_channels(accessor.type),
+        values);
+    set_copy_on_write(mesh.template ref_attribute<ValueType>(id));
 }
 
 ///
@@ -376,6 +636,7 @@ void accessor_to_attribute_internal(
 ///
 /// @param model        The gltf model object.
 /// @param accessor     The gltf accessor object.
+/// @param owner        Owner of the model buffers, or nullptr if they cannot be shared.
 /// @param name         The attribute name.
 /// @param target_usage The target attribute usage if any.
 /// @param mesh         The lagrange mesh.
@@ -384,34 +645,35 @@ template <typename Scalar, typename Index>
 void accessor_to_attribute(
     const tinygltf::Model& model,
     const tinygltf::Accessor& accessor,
+    const std::shared_ptr<const void>& owner,
     std::string_view name,
     std::optional<AttributeUsage> target_usage,
     SurfaceMesh<Scalar, Index>& mesh)
 {
     switch (accessor.componentType) {
     case TINYGLTF_COMPONENT_TYPE_BYTE:
-        accessor_to_attribute_internal<int8_t>(model, accessor, name, target_usage, mesh);
+        accessor_to_attribute_internal<int8_t>(model, accessor, owner, name, target_usage, mesh);
         break;
     case TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE:
-        accessor_to_attribute_internal<uint8_t>(model, accessor, name, target_usage, mesh);
+        accessor_to_attribute_internal<uint8_t>(model, accessor, owner, name, target_usage, mesh);
         break;
     case TINYGLTF_COMPONENT_TYPE_SHORT:
-        accessor_to_attribute_internal<int16_t>(model, accessor, name, target_usage, mesh);
+        accessor_to_attribute_internal<int16_t>(model, accessor, owner, name, target_usage, mesh);
         break;
     case TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT:
-        accessor_to_attribute_internal<uint16_t>(model, accessor, name, target_usage, mesh);
+        accessor_to_attribute_internal<uint16_t>(model, accessor, owner, name, target_usage, mesh);
         break;
     case TINYGLTF_COMPONENT_TYPE_INT:
-        accessor_to_attribute_internal<int32_t>(model, accessor, name, target_usage, mesh);
+        accessor_to_attribute_internal<int32_t>(model, accessor, owner, name, target_usage, mesh);
         break;
     case TINYGLTF_COMPONENT_TYPE_UNSIGNED_INT:
-        accessor_to_attribute_internal<uint32_t>(model, accessor, name, target_usage, mesh);
+        accessor_to_attribute_internal<uint32_t>(model, accessor, owner, name, target_usage, mesh);
         break;
     case TINYGLTF_COMPONENT_TYPE_FLOAT:
-        accessor_to_attribute_internal<float>(model, accessor, name, target_usage, mesh);
+        accessor_to_attribute_internal<float>(model, accessor, owner, name, target_usage, mesh);
         break;
     case TINYGLTF_COMPONENT_TYPE_DOUBLE:
-        accessor_to_attribute_internal<double>(model, accessor, name, target_usage, mesh);
+        accessor_to_attribute_internal<double>(model, accessor, owner, name, target_usage, mesh);
         break;
     default:
         logger().warn(
@@ -424,6 +686,7 @@ void accessor_to_attribute(
 template <typename MeshType>
 MeshType convert_tinygltf_primitive_to_lagrange_mesh(
     const tinygltf::Model& model,
+    const std::shared_ptr<const void>& owner,
     const tinygltf::Primitive& primitive,
     const LoadOptions& options)
 {
@@ -443,8 +706,12 @@ MeshType convert_tinygltf_primitive_to_lagrange_mesh(
         const tinygltf::Accessor& accessor = model.accessors[it->second];
         const size_t num_vertices = accessor.count;
         la_debug_assert(accessor.type == TINYGLTF_TYPE_VEC3);
-        std::vector<Scalar> coords = load_buffer_data_as<Scalar>(model, accessor);
-        lmesh.add_vertices(Index(num_vertices), coords);
+        if (num_vertices > 0) {
+            lmesh.wrap_as_const_vertices(
+                load_buffer_data_as<Scalar>(model, accessor, owner),
+                Index(num_vertices));
+            set_copy_on_write(lmesh.ref_vertex_to_position());
+        }
     }
 
     // read faces
@@ -454,8 +721,13 @@ MeshType convert_tinygltf_primitive_to_lagrange_mesh(
         const size_t num_facets = num_indices / 3; // because triangle
         la_debug_assert(accessor.type == TINYGLTF_TYPE_SCALAR);
 
-        std::vector<Index> indices = load_buffer_data_as<Index>(model, accessor);
-        lmesh.add_triangles(Index(num_facets), indices);
+        if (num_facets > 0) {
+            lmesh.wrap_as_const_facets(
+                load_buffer_data_as<Index>(model, accessor, owner),
+                Index(num_facets),
+                Index(3));
+            set_copy_on_write(lmesh.ref_corner_to_vertex());
+        }
     }
 
     // read other attributes
@@ -474,28 +746,70 @@ MeshType convert_tinygltf_primitive_to_lagrange_mesh(
 
         // https://registry.khronos.org/glTF/specs/2.0/glTF-2.0.html#meshes
         if (starts_with(name, "NORMAL") && options.load_normals) {
-            accessor_to_attribute(model, accessor, name_lowercase, AttributeUsage::Normal, lmesh);
+            accessor_to_attribute(
+                model,
+                accessor,
+                owner,
+                name_lowercase,
+                AttributeUsage::Normal,
+                lmesh);
         } else if (starts_with(name, "TANGENT") && options.load_tangents) {
-            accessor_to_attribute(model, accessor, name_lowercase, AttributeUsage::Tangent, lmesh);
+            accessor_to_attribute(
+                model,
+                accessor,
+                owner,
+                name_lowercase,
+                AttributeUsage::Tangent,
+                lmesh);
         } else if (starts_with(name, "COLOR") && options.load_vertex_colors) {
-            accessor_to_attribute(model, accessor, name_lowercase, AttributeUsage::Color, lmesh);
+            accessor_to_attribute(
+                model,
+                accessor,
+                owner,
+                name_lowercase,
+                AttributeUsage::Color,
+                lmesh);
         } else if (starts_with(name, "JOINTS") && options.load_weights) {
             la_runtime_assert(accessor.type == TINYGLTF_TYPE_VEC4);
             la_runtime_assert(
                 accessor.componentType == TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE ||
                 accessor.componentType == TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT);
-            accessor_to_attribute(model, accessor, name_lowercase, AttributeUsage::Vector, lmesh);
+            accessor_to_attribute(
+                model,
+                accessor,
+                owner,
+                name_lowercase,
+                AttributeUsage::Vector,
+                lmesh);
         } else if (starts_with(name, "WEIGHTS") && options.load_weights) {
             la_runtime_assert(accessor.type == TINYGLTF_TYPE_VEC4);
             la_runtime_assert(
                 accessor.componentType == TINYGLTF_COMPONENT_TYPE_FLOAT ||
                 accessor.componentType == TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE ||
                 accessor.componentType == TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT);
-            accessor_to_attribute(model, accessor, name_lowercase, AttributeUsage::Vector, lmesh);
+            accessor_to_attribute(
+                model,
+                accessor,
+                owner,
+                name_lowercase,
+                AttributeUsage::Vector,
+                lmesh);
         } else if (starts_with(name, "TEXCOORD") && options.load_uvs) {
-            accessor_to_attribute(model, accessor, name_lowercase, AttributeUsage::UV, lmesh);
+            accessor_to_attribute(
+                model,
+                accessor,
+                owner,
+                name_lowercase,
+                AttributeUsage::UV,
+                lmesh);
         } else {
-            accessor_to_attribute(model, accessor, name_lowercase, {}, lmesh);
+            accessor_to_attribute(
+                model,
+                accessor,
+                owner,
+                name_lowercase,
+                {},
+                lmesh);
         }
     }
     // for future reference, material is here. No need in this function.
@@ -548,9 +862,51 @@ Eigen::Transform<Scalar, 3, 2> get_node_transform(const tinygltf::Node& node)
     return t;
 }
 
+///
+/// Converts the primitives of all glTF meshes in parallel.
+///
+/// @param model    The gltf model object.
+/// @param owner    Owner of the model buffers, or nullptr if they cannot be shared.
+/// @param options  Load options.
+///
+/// @return     One mesh per primitive, ordered by glTF mesh and then by primitive.
+///
+template <typename MeshType>
+std::vector<MeshType> convert_tinygltf_primitives(
+    const tinygltf::Model& model,
+    const std::shared_ptr<const void>& owner,
+    const LoadOptions& options)
+{
+    std::vector<const tinygltf::Primitive*> primitives;
+    for (const tinygltf::Mesh& mesh : model.meshes) {
+        for (const tinygltf::Primitive& primitive : mesh.primitives) {
+            primitives.push_back(&primitive);
+        }
+    }
+
+    // Each task writes to its own slot, so the output order does not depend on scheduling.
+    std::vector<MeshType> lmeshes(primitives.size());
+    tbb::parallel_for(size_t(0), primitives.size(), [&](size_t i) {
+        lmeshes[i] = convert_tinygltf_primitive_to_lagrange_mesh<MeshType>(
+            model,
+            owner,
+            *primitives[i],
+            options);
+    });
+    return lmeshes;
+}
+
 template <typename SceneType>
-SceneType load_simple_scene_gltf(const tinygltf::Model& model, const LoadOptions& options)
+SceneType load_simple_scene_gltf(
+    std::shared_ptr<tinygltf::Model> model_ptr,
+    const LoadOptions& options)
 {
+    // Images are not part of simple scenes. Release them before the model buffers are shared with
+    // the loaded meshes.
+    model_ptr->images.clear();
+    const std::shared_ptr<const void> owner = model_ptr;
+    const tinygltf::Model& model = *model_ptr;
+
     using MeshType = typename SceneType::MeshType;
     using Scalar = typename MeshType::Scalar;
     using Index = typename MeshType::Index;
@@ -560,24 +916,33 @@ SceneType load_simple_scene_gltf(const tinygltf::Model& model, const LoadOptions
 
     SceneType lscene;
 
-    for (const tinygltf::Mesh& mesh : model.meshes) {
+    std::vector<MeshType> lprimitives =
+        convert_tinygltf_primitives<MeshType>(model, owner, options);
+
+    // Merge the primitives of each mesh, one mesh per task.
+    std::vector<size_t> primitive_offsets(model.meshes.size() + 1, 0);
+    for (size_t i = 0; i < model.meshes.size(); ++i) {
+        primitive_offsets[i + 1] = primitive_offsets[i] + model.meshes[i].primitives.size();
+    }
+    std::vector<MeshType> lmeshes(model.meshes.size());
+    tbb::parallel_for(size_t(0), model.meshes.size(), [&](size_t i) {
+        const size_t first = primitive_offsets[i];
+        const size_t count = primitive_offsets[i + 1] - first;
+        if (count == 1) {
+            lmeshes[i] = std::move(lprimitives[first]);
+        } else if (count > 1) {
+            constexpr bool preserve_attributes = true;
+            lmeshes[i] = lagrange::combine_meshes<Scalar, Index>(
+                span<const MeshType>(lprimitives.data() + first, count),
+                preserve_attributes);
+        }
+    });
+
+    for (size_t i = 0; i < model.meshes.size(); ++i) {
         // By adding in the same order, we can assume that tinygltf's indexing is the same
         // as in the lagrange scene. We use this later.
-        std::vector<MeshType> lmeshes;
-        for (const tinygltf::Primitive& prim : mesh.primitives) {
-            lmeshes.push_back(
-                convert_tinygltf_primitive_to_lagrange_mesh<MeshType>(model, prim, options));
-        }
-        if (!lmeshes.empty()) {
-            if (lmeshes.size() == 1) {
-                lscene.add_mesh(lmeshes.front());
-            } else {
-                constexpr bool preserve_attributes = true;
-                lscene.add_mesh(
-                    lagrange::combine_meshes<typename MeshType::Scalar, typename MeshType::Index>(
-                        lmeshes,
-                        preserve_attributes));
-            }
+        if (!model.meshes[i].primitives.empty()) {
+            lscene.add_mesh(std::move(lmeshes[i]));
         }
     }
 
@@ -618,9 +983,22 @@ SceneType load_simple_scene_gltf(const tinygltf::Model& model, const LoadOptions
     return lscene;
 }
 
+} // namespace
+
+namespace internal {
+
+std::shared_ptr<tinygltf::Model> load_tinygltf(const fs::path& filename)
+{
+    return std::make_shared<tinygltf::Model>(io::load_tinygltf(filename));
+}
+
 template <typename SceneType>
-SceneType load_scene_gltf(const tinygltf::Model& model, const LoadOptions& options)
+SceneType load_scene_gltf(std::shared_ptr<tinygltf::Model> model_ptr, const LoadOptions& options)
 {
+    // Mesh buffers and encoded lazy images are shared with the model.
+    const std::shared_ptr<const void> owner = model_ptr;
+    tinygltf::Model& model = *model_ptr;
+
     SceneType lscene;
     using MeshType = typename SceneType::MeshType;
 
@@ -631,14 +1009,26 @@ SceneType load_scene_gltf(const tinygltf::Model& model, const LoadOptions& optio
     size_t primitive_count_tmp = 0;
 
     for (const tinygltf::Mesh& mesh : model.meshes) {
-        for (const tinygltf::Primitive& primitive : mesh.primitives) {
-            lscene.add(
-                convert_tinygltf_primitive_to_lagrange_mesh<MeshType>(model, primitive, options));
-        }
         primitive_count.push_back(primitive_count_tmp);
         primitive_count_tmp += mesh.primitives.size();
     }
 
+    // Primitives are converted and images are decoded in the background, while the lightweight
+    // scene elements below are converted on the calling thread. Results are added to the scene in
+    // the model order once all tasks are done.
+    std::vector<MeshType> lmeshes;
+    std::vector<scene::ImageBufferExperimental> limage_buffers(model.images.size());
+    tbb::task_group tasks;
+    tasks.run([&] { lmeshes = convert_tinygltf_primitives<MeshType>(model, owner, options); });
+    if (options.load_images && !options.lazy_images) {
+        tasks.run([&] {
+            tbb::parallel_for(size_t(0), model.images.size(), [&](size_t i) {
+                const tinygltf::Image& image = model.images[i];
+                limage_buffers[i] = decode_image(image.image, image.name);
+            });
+        });
+    }
+
     auto convert_map_mode = [](int mode) -> scene::Texture::WrapMode {
         switch (mode) {
         case TINYGLTF_TEXTURE_WRAP_REPEAT: return scene::Texture::WrapMode::Wrap;
@@ -714,17 +1104,14 @@ SceneType load_scene_gltf(const tinygltf::Model& model, const LoadOptions& optio
 
         lscene.add(lanim);
     }
-    for (const tinygltf::Image& image : model.images) {
-        // Note:
-        // We assume the image data was loaded by tinygltf.
-        // If this assumptions does not always hold, then we will have
-        // to instead read the gltf buffer or file from disk.
-        la_runtime_assert(image.width > 0);
-        la_runtime_assert(image.height > 0);
-        la_runtime_assert(image.component > 0);
-        la_runtime_assert(
-            static_cast<int>(image.image.size()) == image.width * image.height * image.component);
 
+    tasks.wait();
+    for (MeshType& lmesh : lmeshes) {
+        lscene.add(std::move(lmesh));
+    }
+
+    for (size_t i = 0; i < model.images.size(); ++i) {
+        const tinygltf::Image& image = model.images[i];
         scene::ImageExperimental limage;
         limage.name = image.name;
 
@@ -733,45 +1120,37 @@ SceneType load_scene_gltf(const tinygltf::Model& model, const LoadOptions& optio
             limage.uri = image.uri;
         }
 
-        // TinyGltf always loads images into memory.
-        scene::ImageBufferExperimental& limage_buffer = limage.image;
-        limage_buffer.width = image.width;
-        limage_buffer.height = image.height;
-        limage_buffer.num_channels = image.component;
+        if (!options.load_images) {
+            lscene.add(std::move(limage));
+            continue;
+        }
 
-        switch (image.pixel_type) {
-        case TINYGLTF_COMPONENT_TYPE_BYTE:
-            limage_buffer.element_type = AttributeValueType::e_int8_t;
-            break;
-        case TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE:
-            limage_buffer.element_type = AttributeValueType::e_uint8_t;
-            break;
-        case TINYGLTF_COMPONENT_TYPE_INT:
-            limage_buffer.element_type = AttributeValueType::e_int32_t;
-            break;
-        case TINYGLTF_COMPONENT_TYPE_UNSIGNED_INT:
-            limage_buffer.element_type = AttributeValueType::e_uint32_t;
-            break;
-        case TINYGLTF_COMPONENT_TYPE_FLOAT:
-            limage_buffer.element_type = AttributeValueType::e_float;
-            break;
-        case TINYGLTF_COMPONENT_TYPE_DOUBLE:
-            limage_buffer.element_type = AttributeValueType::e_double;
-            break;
-        case TINYGLTF_COMPONENT_TYPE_SHORT:
-            limage_buffer.element_type = AttributeValueType::e_int16_t;
-            break;
-        case TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT:
-            limage_buffer.element_type = AttributeValueType::e_uint16_t;
-            break;
-        default:
-            logger().warn("Loading image with unsupported pixel precision!");
-            throw std::runtime_error("Unsupported pixel type");
+        if (options.lazy_images) {
+            // The encoded bytes are shared with the model, and only decoded on first access.
+            const std::string& name = image.name;
+            auto encoded_data = make_shared_span(
+                owner,
+                static_cast<const unsigned char*>(image.image.data()),
+                image.image.size());
+            limage.lazy_image = std::make_shared<scene::LazyImageExperimental>(
+                encoded_data,
+                get_image_mime_type(image),
+                [encoded_data, name]() { return decode_image(encoded_data.get(), name); },
+                options.image_cache);
+        } else {
+            // Images were decoded in memory by the task above.
+            limage.image = std::move(limage_buffers[i]);
         }
-        limage_buffer.data = std::move(image.image);
 
         lscene.add(std::move(limage));
     }
+    if (!options.load_images || !options.lazy_images) {
+        // The model outlives this function through the mesh buffers. Release the encoded images,
+        // which are only needed by lazy images.
+        for (tinygltf::Image& image : model.images) {
+            std::vector<unsigned char>().swap(image.image);
+        }
+    }
 
     for (const tinygltf::Light& light : model.lights) {
         // note that this is not part of the gltf official spec, it is an extension.
@@ -902,7 +1281,7 @@ SceneType load_scene_gltf(const tinygltf::Model& model, const LoadOptions& optio
     return lscene;
 }
 
-} // namespace
+} // namespace internal
 
 // =====================================
 // load_mesh_gltf.h
@@ -931,14 +1310,14 @@ MeshType load_mesh_gltf(const fs::path& filename, const LoadOptions& options)
 template <typename SceneType>
 SceneType load_simple_scene_gltf(const fs::path& filename, const LoadOptions& options)
 {
-    tinygltf::Model model = load_tinygltf(filename);
-    return load_simple_scene_gltf<SceneType>(model, options);
+    auto model = std::make_shared<tinygltf::Model>(load_tinygltf(filename));
+    return load_simple_scene_gltf<SceneType>(std::move(model), options);
 }
 template <typename SceneType>
 SceneType load_simple_scene_gltf(std::istream& input_stream, const LoadOptions& options)
 {
-    tinygltf::Model model = load_tinygltf(input_stream);
-    return load_simple_scene_gltf<SceneType>(model, options);
+    auto model = std::make_shared<tinygltf::Model>(load_tinygltf(input_stream));
+    return load_simple_scene_gltf<SceneType>(std::move(model), options);
 }
 
 // =====================================
@@ -947,14 +1326,13 @@ SceneType load_simple_scene_gltf(std::istream& input_stream, const LoadOptions&
 template <typename SceneType>
 SceneType load_scene_gltf(const fs::path& filename, const LoadOptions& options)
 {
-    tinygltf::Model model = load_tinygltf(filename);
-    return load_scene_gltf<SceneType>(model, options);
+    return internal::load_scene_gltf<SceneType>(internal::load_tinygltf(filename), options);
 }
 template <typename SceneType>
 SceneType load_scene_gltf(std::istream& input_stream, const LoadOptions& options)
 {
-    tinygltf::Model model = load_tinygltf(input_stream);
-    return load_scene_gltf<SceneType>(model, options);
+    auto model = std::make_shared<tinygltf::Model>(load_tinygltf(input_stream));
+    return internal::load_scene_gltf<SceneType>(std::move(model), options);
 }
 
 // =====================================
@@ -987,4 +1365,11 @@ LA_SIMPLE_SCENE_X(load_simple_scene_gltf, 0);
 LA_SCENE_X(load_scene_gltf, 0);
 #undef LA_X_load_scene_gltf
 
+#define LA_X_load_scene_gltf_model(_, S, I)                          \
+    template LA_IO_API scene::Scene<S, I> internal::load_scene_gltf( \
+        std::shared_ptr<tinygltf::Model> model,                      \
+        const LoadOptions& options);
+LA_SCENE_X(load_scene_gltf_model, 0);
+#undef LA_X_load_scene_gltf_model
+
 } // namespace lagrange::io
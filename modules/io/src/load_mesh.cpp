@@ -17,6 +17,7 @@
 #include <lagrange/io/load_mesh.h>
 #include <lagrange/io/load_mesh_fbx.h>
 #include <lagrange/io/load_mesh_gltf.h>
+#include <lagrange/io/load_mesh_lgm.h>
 #include <lagrange/io/load_mesh_msh.h>
 #include <lagrange/io/load_mesh_obj.h>
 #include <lagrange/io/load_mesh_ply.h>
@@ -41,6 +42,7 @@ MeshType load_mesh(std::istream& input_stream, const LoadOptions& options)
     case FileFormat::Ply: return load_mesh_ply<MeshType>(input_stream, options);
     case FileFormat::Obj: return load_mesh_obj<MeshType>(input_stream, options);
     case FileFormat::Fbx: return load_mesh_fbx<MeshType>(input_stream, options);
+    case FileFormat::Lgm: return load_mesh_lgm<MeshType>(input_stream, options);
     default:
 #ifdef LAGRANGE_WITH_ASSIMP
         return load_mesh_assimp<MeshType>(input_stream, options);
@@ -67,6 +69,8 @@ MeshType load_mesh(const fs::path& filename, const LoadOptions& options)
         return load_mesh_gltf<MeshType>(filename, options);
     } else if (ext == ".fbx") {
         return load_mesh_fbx<MeshType>(filename, options);
+    } else if (ext == ".lgm") {
+        return load_mesh_lgm<MeshType>(filename, options);
     } else {
 #ifdef LAGRANGE_WITH_ASSIMP
         return load_mesh_assimp<MeshType>(filename, options);
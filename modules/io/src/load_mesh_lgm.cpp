@@ -0,0 +1,334 @@
+/*
+ * Copyright 2024 Adobe. All rights reserved.
+ * This file is licensed to you under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License. You may obtain a copy
+ * of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under
+ * the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR REPRESENTATIONS
+ * OF ANY KIND, either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+ */
+
+#include <lagrange/Attribute.h>
+#include <lagrange/IndexedAttribute.h>
+#include <lagrange/Logger.h>
+#include <lagrange/SurfaceMeshTypes.h>
+#include <lagrange/fs/MappedFile.h>
+#include <lagrange/io/api.h>
+#include <lagrange/io/load_mesh_lgm.h>
+#include <lagrange/utils/SharedSpan.h>
+#include <lagrange/utils/assert.h>
+#include <lagrange/utils/invalid.h>
+#include <lagrange/utils/safe_cast.h>
+
+#include "internal/lgm_format.h"
+
+// clang-format off
+#include <lagrange/utils/warnoff.h>
+#include <miniz.h>
+#include <tbb/parallel_for.h>
+#include <lagrange/utils/warnon.h>
+// clang-format on
+
+#include <istream>
+#include <memory>
+#include <unordered_map>
+
+namespace lagrange::io {
+
+namespace {
+
+///
+/// A decoded data blob. The memory is either part of the file content, or a decompressed buffer.
+///
+struct LgmBuffer
+{
+    std::shared_ptr<const void> owner;
+    const char* data = nullptr;
+    size_t size = 0;
+};
+
+LgmBuffer decode_blob(
+    const internal::LgmBlob& blob,
+    std::string_view content,
+    const std::shared_ptr<const void>& owner)
+{
+    if (blob.offset > content.size() || blob.size > content.size() - blob.offset) {
+        throw Error("Invalid .lgm file: truncated data");
+    }
+    const char* data = content.data() + blob.offset;
+    if (blob.compression == internal::LgmCompression::None) {
+        if (blob.size != blob.raw_size) {
+            throw Error("Invalid .lgm file: inconsistent blob size");
+        }
+        return {owner, data, blob.size};
+    }
+
+    // Use 8-byte words to guarantee the alignment of any attribute value type.
+    auto buffer = std::make_shared<std::vector<uint64_t>>((blob.raw_size + 7) / 8);
+    mz_ulong size = static_cast<mz_ulong>(blob.raw_size);
+    int status = mz_uncompress(
+        reinterpret_cast<unsigned char*>(buffer->data()),
+        &size,
+        reinterpret_cast<const unsigned char*>(data),
+        static_cast<mz_ulong>(blob.size));
+    if (status != MZ_OK || size != blob.raw_size) {
+        throw Error("Invalid .lgm file: failed to decompress data");
+    }
+    return {buffer, reinterpret_cast<const char*>(buffer->data()), blob.raw_size};
+}
+
+template <typename Target, typename Source>
+Target convert_value(Source value)
+{
+    if constexpr (std::is_integral_v<Target> && std::is_integral_v<Source>) {
+        return value == invalid<Source>() ? invalid<Target>() : safe_cast<Target>(value);
+    } else {
+        return static_cast<Target>(value);
+    }
+}
+
+///
+/// Interprets a decoded blob as an array of values. The data is used in place when the stored
+/// value type matches the requested one, and converted otherwise.
+///
+/// @param[in]  buffer       Decoded blob.
+/// @param[in]  stored_type  Value type of the stored data.
+/// @param[in]  num_values   Expected number of values.
+///
+/// @tparam     T            Requested value type.
+///
+/// @return     A span sharing the ownership of the data.
+///
+template <typename T>
+SharedSpan<const T>
+get_values(const LgmBuffer& buffer, AttributeValueType stored_type, size_t num_values)
+{
+    if (buffer.size != num_values * internal::lgm_value_type_size(stored_type)) {
+        throw Error("Invalid .lgm file: inconsistent blob size");
+    }
+    if (stored_type == make_attribute_value_type<T>() &&
+        reinterpret_cast<uintptr_t>(buffer.data) % alignof(T) == 0) {
+        return make_shared_span(buffer.owner, reinterpret_cast<const T*>(buffer.data), num_values);
+    }
+
+    auto values = std::make_shared<std::vector<T>>(num_values);
+    internal::visit_lgm_value_type(stored_type, [&](auto dummy) {
+        using Source = decltype(dummy);
+        tbb::parallel_for(size_t(0), num_values, [&](size_t i) {
+            Source value;
+            std::memcpy(&value, buffer.data + i * sizeof(Source), sizeof(Source));
+            (*values)[i] = convert_value<T>(value);
+        });
+    });
+    return make_shared_span(values, static_cast<const T*>(values->data()), num_values);
+}
+
+template <typename T>
+T decode_default_value(const std::array<uint8_t, 8>& bytes, AttributeValueType stored_type)
+{
+    return internal::visit_lgm_value_type(stored_type, [&](auto dummy) {
+        using Source = decltype(dummy);
+        Source value;
+        std::memcpy(&value, bytes.data(), sizeof(Source));
+        return convert_value<T>(value);
+    });
+}
+
+bool is_index_usage(AttributeUsage usage)
+{
+    return usage == AttributeUsage::VertexIndex || usage == AttributeUsage::FacetIndex ||
+           usage == AttributeUsage::CornerIndex || usage == AttributeUsage::EdgeIndex;
+}
+
+/// Wrapped buffers are copied when modified, resized or shrunk.
+template <typename ValueType>
+void set_copy_on_write(Attribute<ValueType>& attr)
+{
+    attr.set_write_policy(AttributeWritePolicy::SilentCopy);
+    attr.set_growth_policy(AttributeGrowthPolicy::SilentCopy);
+    attr.set_shrink_policy(AttributeShrinkPolicy::SilentCopy);
+}
+
+template <typename MeshType>
+MeshType load_mesh_lgm_internal(std::string_view content, std::shared_ptr<const void> owner)
+{
+    using Scalar = typename MeshType::Scalar;
+    using Index = typename MeshType::Index;
+
+    const uint64_t toc_size = internal::read_lgm_header(content);
+    if (toc_size > content.size() - internal::lgm_header_size) {
+        throw Error("Invalid .lgm file: truncated table of contents");
+    }
+    const internal::LgmToc toc =
+        internal::read_lgm_toc(content.substr(internal::lgm_header_size, toc_size));
+
+    // Decode all data blobs in parallel.
+    std::vector<const internal::LgmBlob*> blobs;
+    blobs.push_back(&toc.positions);
+    blobs.push_back(&toc.corner_to_vertex);
+    if (toc.vertex_per_facet == 0 && toc.num_facets > 0) {
+        blobs.push_back(&toc.facet_to_first_corner);
+    }
+    if (toc.has_edges) blobs.push_back(&toc.edge_to_vertices);
+    for (const auto& attr : toc.attributes) {
+        blobs.push_back(&attr.values);
+        if (attr.element == AttributeElement::Indexed) blobs.push_back(&attr.indices);
+    }
+    std::vector<LgmBuffer> buffers(blobs.size());
+    tbb::parallel_for(size_t(0), blobs.size(), [&](size_t i) {
+        buffers[i] = decode_blob(*blobs[i], content, owner);
+    });
+    std::unordered_map<const internal::LgmBlob*, const LgmBuffer*> blob_to_buffer;
+    for (size_t i = 0; i < blobs.size(); ++i) blob_to_buffer[blobs[i]] = &buffers[i];
+    auto get_buffer = [&](const internal::LgmBlob& blob) -> const LgmBuffer& {
+        return *blob_to_buffer.at(&blob);
+    };
+
+    const Index num_vertices = safe_cast<Index>(toc.num_vertices);
+    const Index num_facets = safe_cast<Index>(toc.num_facets);
+    const Index num_corners = safe_cast<Index>(toc.num_corners);
+    MeshType mesh(safe_cast<Index>(toc.dimension));
+
+    // Vertices
+    if (num_vertices > 0) {
+        mesh.wrap_as_const_vertices(
+            get_values<Scalar>(
+                get_buffer(toc.positions),
+                toc.scalar_type,
+                toc.num_vertices * toc.dimension),
+            num_vertices);
+        set_copy_on_write(mesh.ref_vertex_to_position());
+    }
+
+    // Facets
+    if (num_facets > 0) {
+        auto corner_to_vertex =
+            get_values<Index>(get_buffer(toc.corner_to_vertex), toc.index_type, toc.num_corners);
+        if (toc.vertex_per_facet > 0) {
+            if (toc.num_corners != toc.num_facets * toc.vertex_per_facet) {
+                throw Error("Invalid .lgm file: inconsistent number of corners");
+            }
+            mesh.wrap_as_const_facets(
+                corner_to_vertex,
+                num_facets,
+                safe_cast<Index>(toc.vertex_per_facet));
+        } else {
+            auto facet_to_first_corner = get_values<Index>(
+                get_buffer(toc.facet_to_first_corner),
+                toc.index_type,
+                toc.num_facets);
+            mesh.wrap_as_const_facets(
+                facet_to_first_corner,
+                num_facets,
+                corner_to_vertex,
+                num_corners);
+            set_copy_on_write(
+                mesh.template ref_attribute<Index>(mesh.attr_id_facet_to_first_corner()));
+        }
+        set_copy_on_write(mesh.ref_corner_to_vertex());
+    }
+
+    // Edges
+    if (toc.has_edges) {
+        auto edge_to_vertices = get_values<Index>(
+            get_buffer(toc.edge_to_vertices),
+            toc.index_type,
+            2 * toc.num_edges);
+        mesh.initialize_edges(edge_to_vertices.get());
+        if (mesh.get_num_edges() != toc.num_edges) {
+            throw Error("Invalid .lgm file: inconsistent number of edges");
+        }
+    }
+
+    // Attributes
+    for (const auto& entry : toc.attributes) {
+        logger().debug("Reading attribute '{}'", entry.name);
+        auto load_attribute = [&](auto dummy) {
+            using ValueType = decltype(dummy);
+            auto values = get_values<ValueType>(
+                get_buffer(entry.values),
+                entry.value_type,
+                entry.num_values * entry.num_channels);
+            auto default_value =
+                decode_default_value<ValueType>(entry.default_value, entry.value_type);
+            if (entry.element == AttributeElement::Indexed) {
+                auto indices =
+                    get_values<Index>(get_buffer(entry.indices), toc.index_type, toc.num_corners);
+                auto id = mesh.template wrap_as_const_indexed_attribute<ValueType>(
+                    entry.name,
+                    entry.usage,
+                    entry.num_values,
+                    entry.num_channels,
+                    values,
+                    indices);
+                auto& attr = mesh.template ref_indexed_attribute<ValueType>(id);
+                attr.values().set_default_value(default_value);
+                set_copy_on_write(attr.values());
+                set_copy_on_write(attr.indices());
+            } else if (entry.element == AttributeElement::Value) {
+                // Value attributes are not attached to mesh elements, and cannot be wrapped.
+                auto id = mesh.template create_attribute<ValueType>(
+                    entry.name,
+                    entry.element,
+                    entry.usage,
+                    entry.num_channels,
+                    values.get());
+                mesh.template ref_attribute<ValueType>(id).set_default_value(default_value);
+            } else {
+                auto id = mesh.template wrap_as_const_attribute<ValueType>(
+                    entry.name,
+                    entry.element,
+                    entry.usage,
+                    entry.num_channels,
+                    values);
+                auto& attr = mesh.template ref_attribute<ValueType>(id);
+                if (attr.get_num_elements() != entry.num_values) {
+                    throw Error(fmt::format(
+                        "Invalid .lgm file: inconsistent number of elements for attribute '{}'",
+                        entry.name));
+                }
+                attr.set_default_value(default_value);
+                set_copy_on_write(attr);
+            }
+        };
+        if (is_index_usage(entry.usage)) {
+            // Element indices must use the mesh index type.
+            load_attribute(Index());
+        } else {
+            internal::visit_lgm_value_type(entry.value_type, load_attribute);
+        }
+    }
+
+    return mesh;
+}
+
+} // namespace
+
+template <typename MeshType>
+MeshType load_mesh_lgm(std::istream& input_stream, const LoadOptions& /*options*/)
+{
+    auto content = std::make_shared<std::string>(
+        std::istreambuf_iterator<char>(input_stream),
+        std::istreambuf_iterator<char>());
+    std::string_view view(*content);
+    return load_mesh_lgm_internal<MeshType>(view, std::move(content));
+}
+
+template <typename MeshType>
+MeshType load_mesh_lgm(const fs::path& filename, const LoadOptions& /*options*/)
+{
+    auto file = std::make_shared<fs::MappedFile>(filename);
+    std::string_view view = file->view();
+    return load_mesh_lgm_internal<MeshType>(view, std::move(file));
+}
+
+#define LA_X_load_mesh_lgm(_, S, I)                                                                \
+    template LA_IO_API SurfaceMesh<S, I> load_mesh_lgm(std::istream&, const LoadOptions& options); \
+    template LA_IO_API SurfaceMesh<S, I> load_mesh_lgm(                                            \
+        const fs::path& filename,                                                                  \
+        const LoadOptions& options);
+LA_SURFACE_MESH_X(load_mesh_lgm, 0)
+
+} // namespace lagrange::io
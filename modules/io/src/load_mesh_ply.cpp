@@ -16,19 +16,30 @@
 #include <lagrange/Logger.h>
 #include <lagrange/SurfaceMesh.h>
 #include <lagrange/SurfaceMeshTypes.h>
+#include <lagrange/fs/MappedFile.h>
 #include <lagrange/internal/attribute_string_utils.h>
 #include <lagrange/io/api.h>
+#include <lagrange/utils/SharedSpan.h>
 #include <lagrange/utils/assert.h>
 #include <lagrange/utils/build.h>
+#include <lagrange/utils/invalid.h>
+#include <lagrange/utils/safe_cast.h>
 #include <lagrange/utils/strings.h>
 #include <lagrange/views.h>
 
+#include "internal/ply_format.h"
+
 // clang-format off
 #include <lagrange/utils/warnoff.h>
 #include <happly.h>
+#include <tbb/parallel_for.h>
 #include <lagrange/utils/warnon.h>
 // clang-format on
 
+#include <atomic>
+#include <memory>
+#include <sstream>
+
 namespace lagrange::io {
 
 std::string_view get_suffix(std::string_view name)
@@ -54,8 +65,11 @@ void extract_normal(
 
     Index num_entries = static_cast<Index>(nx.size());
     auto usage = AttributeUsage::Normal;
-    std::string attr_name =
-        fmt::format("{}_{}{}", internal::to_string(element), internal::to_string(usage), suffix);
+    std::string attr_name = fmt::format(
+        "{}_{}{}",
+        lagrange::internal::to_string(element),
+        lagrange::internal::to_string(usage),
+        suffix);
 
     logger().debug("Reading normal attribute {} -> {}", name, attr_name);
 
@@ -82,8 +96,11 @@ void extract_vertex_uv(
     Index num_vertices = static_cast<Index>(u.size());
     auto element = AttributeElement::Vertex;
     auto usage = AttributeUsage::UV;
-    std::string attr_name =
-        fmt::format("{}_{}{}", internal::to_string(element), internal::to_string(usage), suffix);
+    std::string attr_name = fmt::format(
+        "{}_{}{}",
+        lagrange::internal::to_string(element),
+        lagrange::internal::to_string(usage),
+        suffix);
 
     logger().debug("Reading uv attribute {} -> {}", name, attr_name);
 
@@ -109,8 +126,11 @@ void extract_color(
 
     Index num_entries = static_cast<Index>(red.size());
     auto usage = AttributeUsage::Color;
-    std::string attr_name =
-        fmt::format("{}_{}{}", internal::to_string(element), internal::to_string(usage), suffix);
+    std::string attr_name = fmt::format(
+        "{}_{}{}",
+        lagrange::internal::to_string(element),
+        lagrange::internal::to_string(usage),
+        suffix);
     Index num_channels = has_alpha ? 4 : 3;
 
     logger().debug("Reading color attribute {} -> {}", name, attr_name);
@@ -297,7 +317,7 @@ void extract_facet_properties(
 }
 
 template <typename MeshType>
-MeshType load_mesh_ply(std::istream& input_stream, const LoadOptions& options)
+MeshType load_mesh_ply_happly(std::istream& input_stream, const LoadOptions& options)
 {
     using Scalar = typename MeshType::Scalar;
     using Index = typename MeshType::Index;
@@ -344,12 +364,671 @@ MeshType load_mesh_ply(std::istream& input_stream, const LoadOptions& options)
     return mesh;
 }
 
+namespace {
+
+// =====================================
+// Native binary PLY reader
+// =====================================
+
+template <typename T>
+T byte_swap(T value)
+{
+    char bytes[sizeof(T)];
+    std::memcpy(bytes, &value, sizeof(T));
+    std::reverse(bytes, bytes + sizeof(T));
+    std::memcpy(&value, bytes, sizeof(T));
+    return value;
+}
+
+/// Converts `n` packed values read from a PLY payload and writes them to `dst`.
+using ConvertFn = void (*)(const char* src, size_t n, void* dst);
+
+template <typename SrcType, typename DstType, bool Swap>
+void convert_values(const char* src, size_t n, void* dst)
+{
+    auto* out = static_cast<DstType*>(dst);
+    for (size_t k = 0; k < n; ++k) {
+        SrcType value;
+        std::memcpy(&value, src + k * sizeof(SrcType), sizeof(SrcType));
+        if constexpr (Swap) value = byte_swap(value);
+        out[k] = static_cast<DstType>(value);
+    }
+}
+
+template <typename DstType>
+ConvertFn get_convert_fn(internal::PlyType type, bool swap)
+{
+    return internal::visit_ply_type(type, [&](auto x) -> ConvertFn {
+        using SrcType = decltype(x);
+        if (swap) {
+            return &convert_values<SrcType, DstType, true>;
+        } else {
+            return &convert_values<SrcType, DstType, false>;
+        }
+    });
+}
+
+///
+/// Location of the records of a PLY element in a binary payload.
+///
+struct PlyElementLayout
+{
+    /// Pointer to the first record.
+    const char* data = nullptr;
+
+    /// Total size of the element records in bytes.
+    size_t size = 0;
+
+    /// Size of each record in bytes, or 0 if records have a variable size.
+    size_t stride = 0;
+
+    /// Offset of each record if records have a variable size.
+    std::vector<size_t> offsets;
+
+    const char* record(size_t i) const { return data + (stride ? i * stride : offsets[i]); }
+};
+
+///
+/// Helper to walk through the properties of the records of a PLY element.
+///
+class PlyRecordWalker
+{
+public:
+    PlyRecordWalker(const internal::PlyElement& element, bool swap)
+    {
+        for (const auto& prop : element.properties) {
+            m_item_sizes.push_back(internal::ply_type_size(prop.type));
+            m_count_sizes.push_back(prop.is_list ? internal::ply_type_size(prop.count_type) : 0);
+            m_count_fns.push_back(
+                prop.is_list ? get_convert_fn<uint64_t>(prop.count_type, swap) : nullptr);
+        }
+    }
+
+    size_t get_num_properties() const { return m_item_sizes.size(); }
+
+    /// Reads the number of values of property k at `p`, and advances `p` to the first value.
+    size_t read_count(size_t k, const char*& p) const
+    {
+        if (!m_count_fns[k]) return 1;
+        uint64_t count = 0;
+        m_count_fns[k](p, 1, &count);
+        p += m_count_sizes[k];
+        return static_cast<size_t>(count);
+    }
+
+    size_t get_item_size(size_t k) const { return m_item_sizes[k]; }
+
+    ///
+    /// Computes the size of a record, and optionally the number of values of each list property.
+    ///
+    /// @return     False if the record extends past `limit`.
+    ///
+    bool get_record_size(const char* record, const char* limit, size_t& size, size_t* counts)
+        const
+    {
+        const char* p = record;
+        for (size_t k = 0; k < m_item_sizes.size(); ++k) {
+            if (p + m_count_sizes[k] > limit) return false;
+            const size_t n = read_count(k, p);
+            if (counts) counts[k] = n;
+            p += n * m_item_sizes[k];
+        }
+        if (p > limit) return false;
+        size = static_cast<size_t>(p - record);
+        return true;
+    }
+
+    /// Returns a pointer to property k of a record.
+    const char* find_property(const char* record, size_t k) const
+    {
+        const char* p = record;
+        for (size_t j = 0; j < k; ++j) {
+            p += read_count(j, p) * m_item_sizes[j];
+        }
+        return p;
+    }
+
+private:
+    std::vector<size_t> m_item_sizes;
+    std::vector<size_t> m_count_sizes;
+    std::vector<ConvertFn> m_count_fns;
+};
+
+///
+/// Locates the records of an element in a binary payload. Records have a fixed size if the element
+/// has no list property, or if all list properties have the same length across records (e.g. a
+/// pure triangle mesh). Otherwise, the offset of each record is computed with a sequential scan.
+///
+PlyElementLayout locate_element(
+    const internal::PlyElement& element,
+    const PlyRecordWalker& walker,
+    const char* begin,
+    const char* end)
+{
+    PlyElementLayout layout;
+    layout.data = begin;
+    if (element.count == 0) return layout;
+
+    const size_t num_props = walker.get_num_properties();
+    const size_t available = static_cast<size_t>(end - begin);
+    const auto truncated = [&] {
+        return Error(fmt::format("Truncated PLY payload in element '{}'", element.name));
+    };
+
+    // Guess a fixed stride from the first record, and check it in parallel.
+    std::vector<size_t> first_counts(num_props);
+    size_t first_size = 0;
+    if (!walker.get_record_size(begin, end, first_size, first_counts.data())) {
+        throw truncated();
+    }
+    if (first_size > 0 && element.count <= available / first_size) {
+        std::atomic_bool uniform = true;
+        tbb::parallel_for(
+            tbb::blocked_range<size_t>(1, element.count),
+            [&](const tbb::blocked_range<size_t>& r) {
+                std::vector<size_t> counts(num_props);
+                for (size_t i = r.begin(); i != r.end() && uniform; ++i) {
+                    const char* record = begin + i * first_size;
+                    size_t size = 0;
+                    if (!walker.get_record_size(record, end, size, counts.data()) ||
+                        counts != first_counts) {
+                        uniform = false;
+                    }
+                }
+            });
+        if (uniform) {
+            layout.stride = first_size;
+            layout.size = element.count * first_size;
+            return layout;
+        }
+    }
+
+    // Variable-size records.
+    layout.offsets.resize(element.count);
+    size_t offset = 0;
+    for (size_t i = 0; i < element.count; ++i) {
+        size_t size = 0;
+        if (!walker.get_record_size(begin + offset, end, size, nullptr)) {
+            throw truncated();
+        }
+        layout.offsets[i] = offset;
+        offset += size;
+    }
+    layout.size = offset;
+    return layout;
+}
+
+///
+/// Destination of a PLY property in a mesh buffer.
+///
+template <typename Index>
+struct PlyTarget
+{
+    /// Conversion function to the destination type. The property is skipped if null.
+    ConvertFn convert = nullptr;
+
+    /// Destination of the first record.
+    char* data = nullptr;
+
+    /// Destination offset (in bytes) between two consecutive records.
+    size_t stride = 0;
+
+    /// Expected number of values per record, or invalid<size_t>() if any size is allowed.
+    size_t num_values = 1;
+
+    /// Optional per-record offsets in units of `stride`, used for the indices of hybrid meshes.
+    span<const Index> offsets;
+};
+
+///
+/// Scatters the properties of all records of an element to their destination buffers, in a single
+/// parallel pass over the payload.
+///
+template <typename Index>
+void scatter_element(
+    const internal::PlyElement& element,
+    const PlyRecordWalker& walker,
+    const PlyElementLayout& layout,
+    span<const PlyTarget<Index>> targets)
+{
+    bool any_target = std::any_of(targets.begin(), targets.end(), [](const auto& t) {
+        return t.convert != nullptr;
+    });
+    if (!any_target) return;
+
+    std::atomic_bool size_mismatch = false;
+    tbb::parallel_for(
+        tbb::blocked_range<size_t>(0, element.count),
+        [&](const tbb::blocked_range<size_t>& r) {
+            for (size_t i = r.begin(); i != r.end(); ++i) {
+                const char* p = layout.record(i);
+                for (size_t k = 0; k < targets.size(); ++k) {
+                    const auto& target = targets[k];
+                    const size_t n = walker.read_count(k, p);
+                    if (target.convert) {
+                        if (target.num_values != invalid<size_t>() && n != target.num_values) {
+                            size_mismatch = true;
+                        } else {
+                            const size_t j = target.offsets.empty()
+                                                 ? i
+                                                 : static_cast<size_t>(target.offsets[i]);
+                            target.convert(p, n, target.data + j * target.stride);
+                        }
+                    }
+                    p += n * walker.get_item_size(k);
+                }
+            }
+        });
+    if (size_mismatch) {
+        throw Error(fmt::format("Inconsistent list sizes in PLY element '{}'", element.name));
+    }
+}
+
+///
+/// Creates mesh attributes from the properties of a PLY element, and sets up the targets to fill
+/// them. Naming and typing conventions match the happly-based loader.
+///
+template <typename Scalar, typename Index>
+class PlyAttributeBuilder
+{
+public:
+    PlyAttributeBuilder(
+        SurfaceMesh<Scalar, Index>& mesh,
+        const internal::PlyElement& element,
+        const PlyRecordWalker& walker,
+        const PlyElementLayout& layout,
+        AttributeElement attr_element,
+        bool swap,
+        std::vector<PlyTarget<Index>>& targets)
+        : m_mesh(mesh)
+        , m_element(element)
+        , m_walker(walker)
+        , m_layout(layout)
+        , m_attr_element(attr_element)
+        , m_swap(swap)
+        , m_targets(targets)
+    {}
+
+    size_t get_property(std::string_view name) const
+    {
+        size_t k = m_element.find_property(name);
+        la_runtime_assert(
+            k < m_element.properties.size() && !m_element.properties[k].is_list,
+            fmt::format("Missing scalar PLY property '{}'", name));
+        return k;
+    }
+
+    /// Whether a scalar property exists with a given type.
+    bool has_property(std::string_view name, internal::PlyType type) const
+    {
+        size_t k = m_element.find_property(name);
+        return k < m_element.properties.size() && !m_element.properties[k].is_list &&
+               m_element.properties[k].type == type;
+    }
+
+    ///
+    /// Creates a multi-channel attribute from a group of scalar properties. The value type of the
+    /// attribute is the type of the first property.
+    ///
+    void add_group(
+        std::string_view name,
+        AttributeUsage usage,
+        std::initializer_list<std::string_view> prefixes)
+    {
+        std::string_view suffix = get_suffix(name);
+        std::vector<size_t> props;
+        for (auto prefix : prefixes) {
+            props.push_back(get_property(fmt::format("{}{}", prefix, suffix)));
+        }
+        if (usage == AttributeUsage::Color &&
+            has_property(
+                fmt::format("alpha{}", suffix),
+                m_element.properties[props.front()].type)) {
+            props.push_back(get_property(fmt::format("alpha{}", suffix)));
+        }
+
+        std::string attr_name = fmt::format(
+            "{}_{}{}",
+            lagrange::internal::to_string(m_attr_element),
+            lagrange::internal::to_string(usage),
+            suffix);
+        logger().debug("Reading attribute {} -> {}", name, attr_name);
+
+        internal::visit_ply_type(m_element.properties[props.front()].type, [&](auto x) {
+            using ValueType = decltype(x);
+            const Index num_channels = static_cast<Index>(props.size());
+            auto id = m_mesh.template create_attribute<ValueType>(
+                attr_name,
+                m_attr_element,
+                usage,
+                num_channels);
+            auto data = m_mesh.template ref_attribute<ValueType>(id).ref_all();
+            for (size_t c = 0; c < props.size(); ++c) {
+                auto& target = m_targets[props[c]];
+                target.convert = get_convert_fn<ValueType>(
+                    m_element.properties[props[c]].type,
+                    m_swap);
+                target.data = reinterpret_cast<char*>(data.data() + c);
+                target.stride = num_channels * sizeof(ValueType);
+            }
+        });
+    }
+
+    ///
+    /// Creates an attribute from a generic property. Scalar properties map to single-channel
+    /// attributes, list properties map to multi-channel attributes.
+    ///
+    void add_property(size_t k)
+    {
+        if (m_element.count == 0) return;
+        const auto& prop = m_element.properties[k];
+
+        Index num_channels = 1;
+        AttributeUsage usage = AttributeUsage::Scalar;
+        if (prop.is_list) {
+            const char* p = m_walker.find_property(m_layout.record(0), k);
+            num_channels = safe_cast<Index>(m_walker.read_count(k, p));
+            usage = AttributeUsage::Vector;
+        }
+
+        internal::visit_ply_type(prop.type, [&](auto x) {
+            using ValueType = decltype(x);
+            auto id = m_mesh.template create_attribute<ValueType>(
+                prop.name,
+                m_attr_element,
+                usage,
+                num_channels);
+            auto data = m_mesh.template ref_attribute<ValueType>(id).ref_all();
+            auto& target = m_targets[k];
+            target.convert = get_convert_fn<ValueType>(prop.type, m_swap);
+            target.data = reinterpret_cast<char*>(data.data());
+            target.stride = num_channels * sizeof(ValueType);
+            target.num_values = (prop.is_list ? num_channels : 1);
+        });
+    }
+
+private:
+    SurfaceMesh<Scalar, Index>& m_mesh;
+    const internal::PlyElement& m_element;
+    const PlyRecordWalker& m_walker;
+    const PlyElementLayout& m_layout;
+    AttributeElement m_attr_element;
+    bool m_swap;
+    std::vector<PlyTarget<Index>>& m_targets;
+};
+
+template <typename Scalar, typename Index>
+void setup_vertex_attributes(
+    PlyAttributeBuilder<Scalar, Index>& builder,
+    const internal::PlyElement& vertex_element,
+    const LoadOptions& options)
+{
+    for (size_t k = 0; k < vertex_element.properties.size(); ++k) {
+        const std::string& name = vertex_element.properties[k].name;
+        if (options.load_normals && (name == "nx" || starts_with(name, "nx_"))) {
+            builder.add_group(name, AttributeUsage::Normal, {"nx", "ny", "nz"});
+        } else if (options.load_vertex_colors && (name == "red" || starts_with(name, "red_"))) {
+            builder.add_group(name, AttributeUsage::Color, {"red", "green", "blue"});
+        } else if (options.load_uvs && (name == "s" || starts_with(name, "s_"))) {
+            builder.add_group(name, AttributeUsage::UV, {"s", "t"});
+        } else {
+            // Skip other known channels.
+            if (name == "x") continue;
+            if (name == "y") continue;
+            if (name == "z") continue;
+            if (name == "ny" || starts_with(name, "ny_")) continue;
+            if (name == "nz" || starts_with(name, "nz_")) continue;
+            if (name == "green" || starts_with(name, "green_")) continue;
+            if (name == "blue" || starts_with(name, "blue_")) continue;
+            if (name == "alpha" || starts_with(name, "alpha_")) continue;
+            if (name == "t" || starts_with(name, "t_")) continue;
+            builder.add_property(k);
+        }
+    }
+}
+
+template <typename Scalar, typename Index>
+void setup_facet_attributes(
+    PlyAttributeBuilder<Scalar, Index>& builder,
+    const internal::PlyElement& facet_element,
+    const LoadOptions& options)
+{
+    for (size_t k = 0; k < facet_element.properties.size(); ++k) {
+        const std::string& name = facet_element.properties[k].name;
+        if (options.load_normals && (name == "nx" || starts_with(name, "nx_"))) {
+            builder.add_group(name, AttributeUsage::Normal, {"nx", "ny", "nz"});
+        } else if (name == "red" || starts_with(name, "red_")) {
+            builder.add_group(name, AttributeUsage::Color, {"red", "green", "blue"});
+        } else {
+            // Skip other known channels.
+            if (name == "ny" || starts_with(name, "ny_")) continue;
+            if (name == "nz" || starts_with(name, "nz_")) continue;
+            if (name == "green" || starts_with(name, "green_")) continue;
+            if (name == "blue" || starts_with(name, "blue_")) continue;
+            if (name == "vertex_indices" || starts_with(name, "vertex_indices_")) continue;
+            if (name == "vertex_index" || starts_with(name, "vertex_index_")) continue;
+            builder.add_property(k);
+        }
+    }
+}
+
+///
+/// Loads a mesh from the binary payload of a PLY file.
+///
+/// @param[in]  header   Parsed PLY header.
+/// @param[in]  payload  Binary payload following the header.
+/// @param[in]  owner    Owner of the payload memory. If provided, vertex positions are wrapped
+///                      without copy when their layout and type match the mesh.
+/// @param[in]  options  Load options.
+///
+template <typename MeshType>
+MeshType load_mesh_ply_binary(
+    const internal::PlyHeader& header,
+    std::string_view payload,
+    std::shared_ptr<fs::MappedFile> owner,
+    const LoadOptions& options)
+{
+    using Scalar = typename MeshType::Scalar;
+    using Index = typename MeshType::Index;
+
+    const bool swap = !internal::is_native_byte_order(header.format);
+    const internal::PlyElement* vertex_element = header.find_element("vertex");
+    const internal::PlyElement* facet_element = header.find_element("face");
+    la_runtime_assert(vertex_element, "PLY file has no vertex element");
+
+    // Locate the vertex and face elements in the payload. Elements are stored contiguously, so
+    // any element stored before them must be located as well.
+    const size_t vertex_index = static_cast<size_t>(vertex_element - header.elements.data());
+    const size_t facet_index =
+        facet_element ? static_cast<size_t>(facet_element - header.elements.data()) : 0;
+    std::vector<PlyRecordWalker> walkers;
+    std::vector<PlyElementLayout> layouts;
+    walkers.reserve(header.elements.size());
+    layouts.reserve(header.elements.size());
+    const char* p = payload.data();
+    const char* payload_end = payload.data() + payload.size();
+    for (size_t i = 0; i <= std::max(vertex_index, facet_index); ++i) {
+        walkers.emplace_back(header.elements[i], swap);
+        layouts.push_back(locate_element(header.elements[i], walkers.back(), p, payload_end));
+        p += layouts.back().size;
+    }
+    const auto& vertex_walker = walkers[vertex_index];
+    const auto& vertex_layout = layouts[vertex_index];
+
+    MeshType mesh;
+
+    // Vertex positions
+    std::vector<PlyTarget<Index>> vertex_targets(vertex_element->properties.size());
+    const size_t xyz[3] = {
+        vertex_element->find_property("x"),
+        vertex_element->find_property("y"),
+        vertex_element->find_property("z")};
+    for (size_t k : xyz) {
+        la_runtime_assert(
+            k < vertex_element->properties.size() && !vertex_element->properties[k].is_list,
+            "PLY vertex element is missing x, y, z properties");
+    }
+    const Index num_vertices = safe_cast<Index>(vertex_element->count);
+    const bool can_wrap_positions =
+        owner && !swap && num_vertices > 0 && vertex_element->properties.size() == 3 &&
+        xyz[0] == 0 && xyz[1] == 1 && xyz[2] == 2 &&
+        std::all_of(
+            vertex_element->properties.begin(),
+            vertex_element->properties.end(),
+            [](const auto& prop) { return prop.type == internal::ply_type_of<Scalar>(); }) &&
+        reinterpret_cast<uintptr_t>(vertex_layout.data) % alignof(Scalar) == 0;
+    if (can_wrap_positions) {
+        // Zero-copy: the vertex payload is exactly the position buffer of the mesh.
+        logger().debug("Wrapping PLY vertex positions from memory-mapped file");
+        auto shared_vertices = make_shared_span(
+            owner,
+            reinterpret_cast<const Scalar*>(vertex_layout.data),
+            static_cast<size_t>(num_vertices) * 3);
+        mesh.wrap_as_const_vertices(shared_vertices, num_vertices);
+        auto& positions = mesh.ref_vertex_to_position();
+        positions.set_write_policy(AttributeWritePolicy::SilentCopy);
+        positions.set_growth_policy(AttributeGrowthPolicy::SilentCopy);
+        positions.set_shrink_policy(AttributeShrinkPolicy::SilentCopy);
+    } else {
+        mesh.add_vertices(num_vertices);
+        auto positions = mesh.ref_vertex_to_position().ref_all();
+        for (size_t c = 0; c < 3; ++c) {
+            auto& target = vertex_targets[xyz[c]];
+            target.convert = get_convert_fn<Scalar>(vertex_element->properties[xyz[c]].type, swap);
+            target.data = reinterpret_cast<char*>(positions.data() + c);
+            target.stride = 3 * sizeof(Scalar);
+        }
+    }
+
+    // Facets
+    std::vector<PlyTarget<Index>> facet_targets;
+    const PlyRecordWalker* facet_walker = nullptr;
+    const PlyElementLayout* facet_layout = nullptr;
+    if (facet_element) {
+        facet_walker = &walkers[facet_index];
+        facet_layout = &layouts[facet_index];
+        facet_targets.resize(facet_element->properties.size());
+
+        size_t k = facet_element->find_property("vertex_indices");
+        if (k == facet_element->properties.size()) {
+            k = facet_element->find_property("vertex_index");
+        }
+        la_runtime_assert(
+            k < facet_element->properties.size() && facet_element->properties[k].is_list,
+            "PLY face element is missing vertex indices");
+
+        const Index num_facets = safe_cast<Index>(facet_element->count);
+        auto& target = facet_targets[k];
+        target.convert = get_convert_fn<Index>(facet_element->properties[k].type, swap);
+        if (num_facets > 0 && facet_layout->stride > 0) {
+            // All facets have the same size.
+            const char* q = facet_walker->find_property(facet_layout->record(0), k);
+            const Index facet_size = safe_cast<Index>(facet_walker->read_count(k, q));
+            mesh.add_polygons(num_facets, facet_size);
+            target.data = reinterpret_cast<char*>(mesh.ref_corner_to_vertex().ref_all().data());
+            target.stride = facet_size * sizeof(Index);
+            target.num_values = facet_size;
+        } else if (num_facets > 0) {
+            std::vector<Index> facet_sizes(num_facets);
+            tbb::parallel_for(Index(0), num_facets, [&](Index f) {
+                const char* q = facet_walker->find_property(facet_layout->record(f), k);
+                facet_sizes[f] = static_cast<Index>(facet_walker->read_count(k, q));
+            });
+            mesh.add_hybrid(facet_sizes);
+            target.data = reinterpret_cast<char*>(mesh.ref_corner_to_vertex().ref_all().data());
+            target.stride = sizeof(Index);
+            target.num_values = invalid<size_t>();
+            target.offsets =
+                mesh.template get_attribute<Index>(mesh.attr_id_facet_to_first_corner()).get_all();
+        }
+    }
+
+    // Attributes
+    {
+        PlyAttributeBuilder<Scalar, Index> builder(
+            mesh,
+            *vertex_element,
+            vertex_walker,
+            vertex_layout,
+            AttributeElement::Vertex,
+            swap,
+            vertex_targets);
+        setup_vertex_attributes(builder, *vertex_element, options);
+    }
+    if (facet_element) {
+        PlyAttributeBuilder<Scalar, Index> builder(
+            mesh,
+            *facet_element,
+            *facet_walker,
+            *facet_layout,
+            AttributeElement::Facet,
+            swap,
+            facet_targets);
+        setup_facet_attributes(builder, *facet_element, options);
+    }
+
+    // Fill buffers
+    scatter_element<Index>(*vertex_element, vertex_walker, vertex_layout, vertex_targets);
+    if (facet_element) {
+        scatter_element<Index>(*facet_element, *facet_walker, *facet_layout, facet_targets);
+
+        // Indices are signed in most PLY files, negative values wrap around and are rejected too.
+        auto corner_to_vertex = mesh.get_corner_to_vertex().get_all();
+        std::atomic_bool out_of_range = false;
+        tbb::parallel_for(
+            tbb::blocked_range<size_t>(0, corner_to_vertex.size()),
+            [&](const tbb::blocked_range<size_t>& r) {
+                for (size_t c = r.begin(); c != r.end(); ++c) {
+                    if (corner_to_vertex[c] >= num_vertices) out_of_range = true;
+                }
+            });
+        la_runtime_assert(!out_of_range, "PLY face element has out-of-range vertex indices");
+    }
+
+    return mesh;
+}
+
+} // namespace
+
+template <typename MeshType>
+MeshType load_mesh_ply(std::istream& input_stream, const LoadOptions& options)
+{
+    std::string header_text = internal::read_ply_header(input_stream);
+    internal::PlyHeader header = internal::parse_ply_header(header_text);
+
+    if (header.format == internal::PlyFormat::Ascii) {
+        // Hand the whole content over to happly.
+        std::stringstream buffer;
+        buffer << header_text;
+        if (input_stream.peek() != std::char_traits<char>::eof()) {
+            buffer << input_stream.rdbuf();
+        }
+        return load_mesh_ply_happly<MeshType>(buffer, options);
+    }
+
+    std::string payload;
+    std::vector<char> chunk(size_t(1) << 20);
+    while (input_stream.read(chunk.data(), static_cast<std::streamsize>(chunk.size())) ||
+           input_stream.gcount() > 0) {
+        payload.append(chunk.data(), static_cast<size_t>(input_stream.gcount()));
+    }
+    return load_mesh_ply_binary<MeshType>(header, payload, nullptr, options);
+}
+
 template <typename MeshType>
 MeshType load_mesh_ply(const fs::path& filename, const LoadOptions& options)
 {
-    fs::ifstream fin(filename, std::ios::binary);
-    la_runtime_assert(fin.good(), fmt::format("Unable to open file {}", filename.string()));
-    return load_mesh_ply<MeshType>(fin, options);
+    auto file = std::make_shared<fs::MappedFile>(filename);
+    internal::PlyHeader header = internal::parse_ply_header(file->view());
+
+    if (header.format == internal::PlyFormat::Ascii) {
+        fs::ifstream fin(filename, std::ios::binary);
+        la_runtime_assert(fin.good(), fmt::format("Unable to open file {}", filename.string()));
+        return load_mesh_ply_happly<MeshType>(fin, options);
+    }
+
+    std::string_view payload = file->view().substr(header.size);
+    return load_mesh_ply_binary<MeshType>(header, payload, std::move(file), options);
 }
 
 #define LA_X_load_mesh_ply(_, S, I)                                                                \
@@ -16,6 +16,7 @@
 #include <lagrange/io/load_mesh_obj.h>
 #include <lagrange/io/load_scene_obj.h>
 
+#include "internal/parse_obj.h"
 #include "stitch_mesh.h"
 
 // ====
@@ -25,6 +26,7 @@
 #include <lagrange/Logger.h>
 #include <lagrange/SurfaceMeshTypes.h>
 #include <lagrange/attribute_names.h>
+#include <lagrange/fs/MappedFile.h>
 #include <lagrange/io/internal/scene_utils.h>
 #include <lagrange/scene/Scene.h>
 #include <lagrange/scene/SceneTypes.h>
@@ -310,11 +312,11 @@ MeshType load_mesh_obj(const tinyobj::ObjReader& reader, const LoadOptions& opti
     auto result = extract_mesh<MeshType>(reader, options);
     return std::move(result.mesh);
 }
-#define LA_X_load_mesh_obj(_, S, I)             \
-    template SurfaceMesh<S, I> load_mesh_obj(   \
-        const const tinyobj::ObjReader& reader, \
-        const LoadOptions& options);            \
-    LA_SURFACE_MESH_X(load_mesh_obj, 0)
+#define LA_X_load_mesh_obj(_, S, I)                     \
+    template LA_IO_API SurfaceMesh<S, I> load_mesh_obj( \
+        const tinyobj::ObjReader& reader,               \
+        const LoadOptions& options);
+LA_SURFACE_MESH_X(load_mesh_obj, 0)
 #undef LA_X_load_mesh_obj
 
 template <typename SceneType>
@@ -444,8 +446,19 @@ template <typename MeshType>
 auto load_mesh_obj(const fs::path& filename, const LoadOptions& options)
     -> ObjReaderResult<typename MeshType::Scalar, typename MeshType::Index>
 {
-    auto reader = load_obj(filename, options);
-    return extract_mesh<MeshType>(reader, options);
+    logger().trace("[load_mesh_obj] Parsing obj file: {}", filename.string());
+    fs::MappedFile file;
+    try {
+        file = fs::MappedFile(filename);
+    } catch (const Error& e) {
+        logger().error("[load_mesh_obj] {}", e.what());
+        ObjReaderResult<typename MeshType::Scalar, typename MeshType::Index> result;
+        result.success = false;
+        return result;
+    }
+    LoadOptions opt2 = options;
+    if (opt2.search_path.empty()) opt2.search_path = filename.parent_path();
+    return parse_obj<MeshType>(file.view(), nullptr, opt2);
 }
 
 template <typename MeshType>
@@ -455,8 +468,10 @@ auto load_mesh_obj(
     const LoadOptions& options)
     -> ObjReaderResult<typename MeshType::Scalar, typename MeshType::Index>
 {
-    auto reader = load_obj(input_stream_obj, input_stream_mtl, options);
-    return extract_mesh<MeshType>(reader, options);
+    logger().trace("[load_mesh_obj] Parsing obj from stream");
+    std::istreambuf_iterator<char> data_itr_obj(input_stream_obj), end_of_stream_obj;
+    std::string obj_data(data_itr_obj, end_of_stream_obj);
+    return parse_obj<MeshType>(obj_data, &input_stream_mtl, options);
 }
 
 #define LA_X_load_mesh(_, Scalar, Index)                                                         \
@@ -24,6 +24,8 @@
 #include <lagrange/SurfaceMeshTypes.h>
 #include <lagrange/foreach_attribute.h>
 #include <lagrange/internal/string_from_scalar.h>
+#include <lagrange/quantize_attribute.h>
+#include <lagrange/reorder_mesh.h>
 #include <lagrange/scene/SceneTypes.h>
 #include <lagrange/scene/SimpleSceneTypes.h>
 #include <lagrange/scene/scene_utils.h>
@@ -33,6 +35,7 @@
 #include <lagrange/views.h>
 
 #include "internal/convert_attribute_utils.h"
+#include "internal/gltf_compression.h"
 
 #include <tiny_gltf.h>
 
@@ -113,8 +116,82 @@ std::vector<double> to_vec4(const Eigen::Vector4f& v)
     return {v(0), v(1), v(2), v(3)};
 }
 
-void save_gltf(const fs::path& filename, const tinygltf::Model& model, const SaveOptions& options)
+///
+/// Moves the images saved as is (i.e. still encoded) into buffer views of the model, so that they
+/// are embedded in the output file.
+///
+void embed_encoded_images(tinygltf::Model& model)
 {
+    for (tinygltf::Image& image : model.images) {
+        if (!image.as_is) continue;
+
+        if (model.buffers.empty()) {
+            model.buffers.push_back(tinygltf::Buffer());
+        }
+        tinygltf::Buffer& buffer = model.buffers.back();
+        buffer.data.resize((buffer.data.size() + 3) / 4 * 4, 0); // align to 4 bytes
+
+        tinygltf::BufferView buffer_view;
+        buffer_view.buffer = static_cast<int>(model.buffers.size()) - 1;
+        buffer_view.byteOffset = buffer.data.size();
+        buffer_view.byteLength = image.image.size();
+        buffer.data.insert(buffer.data.end(), image.image.begin(), image.image.end());
+
+        image.bufferView = static_cast<int>(model.bufferViews.size());
+        model.bufferViews.push_back(std::move(buffer_view));
+        image.image.clear();
+        image.uri.clear();
+        image.as_is = false;
+    }
+}
+
+///
+/// Image writer callback. Images saved as is are written to disk without re-encoding them, other
+/// images are encoded by tinygltf.
+///
+bool write_image_data(
+    const std::string* basepath,
+    const std::string* filename,
+    const tinygltf::Image* image,
+    bool embed_images,
+    const tinygltf::URICallbacks* uri_cb,
+    std::string* out_uri,
+    void* user_data)
+{
+    if (!image->as_is) {
+        return tinygltf::WriteImageData(
+            basepath,
+            filename,
+            image,
+            embed_images,
+            uri_cb,
+            out_uri,
+            user_data);
+    }
+
+    // Embedded encoded images were already moved to buffer views.
+    la_debug_assert(!embed_images);
+    auto* fs_callbacks = static_cast<tinygltf::FsCallbacks*>(user_data);
+    const std::string path = (fs::path(*basepath) / *filename).string();
+    std::string err;
+    if (!fs_callbacks->WriteWholeFile(&err, path, image->image, fs_callbacks->user_data)) {
+        logger().error("Error writing image {}: {}", path, err);
+        return false;
+    }
+    if (uri_cb->encode) {
+        return uri_cb->encode(*filename, "image", out_uri, uri_cb->user_data);
+    }
+    *out_uri = *filename;
+    return true;
+}
+
+void save_gltf(const fs::path& filename, tinygltf::Model& model, const SaveOptions& options)
+{
+    if (options.embed_images) {
+        embed_encoded_images(model);
+    }
+    internal::encode_gltf_compression(model, options);
+
     bool binary = to_lower(filename.extension().string()) == ".glb";
     if (binary && options.encoding != FileEncoding::Binary) {
         logger().warn("Saving mesh in binary due to `.glb` extension.");
@@ -126,7 +203,7 @@ void save_gltf(const fs::path& filename, const tinygltf::Model& model, const Sav
     }
 
     // https://github.com/syoyo/tinygltf/issues/323
-    tinygltf::WriteImageDataFunction write_image_data_function = &tinygltf::WriteImageData;
+    tinygltf::WriteImageDataFunction write_image_data_function = &write_image_data;
     tinygltf::FsCallbacks fs_callbacks;
     fs_callbacks.FileExists = &tinygltf::FileExists;
     fs_callbacks.ExpandFilePath = &tinygltf::ExpandFilePath;
@@ -149,11 +226,12 @@ void save_gltf(const fs::path& filename, const tinygltf::Model& model, const Sav
     if (!success) logger().error("Error saving {}", filename.string());
 }
 
-void save_gltf(
-    std::ostream& output_stream,
-    const tinygltf::Model& model,
-    const SaveOptions& options)
+void save_gltf(std::ostream& output_stream, tinygltf::Model& model, const SaveOptions& options)
 {
+    // Images are always embedded when writing to a stream.
+    embed_encoded_images(model);
+    internal::encode_gltf_compression(model, options);
+
     bool binary = options.encoding == FileEncoding::Binary;
     tinygltf::TinyGLTF loader;
     constexpr bool pretty_print = true;
@@ -208,6 +286,119 @@ std::tuple<int, size_t, size_t> write_to_buffer(tinygltf::Model& model, span<con
     return {int(model.buffers.size()) - 1, byte_offset, byte_length};
 }
 
+// Vertex attribute elements must be aligned to 4 bytes. Elements whose size is not a multiple of 4
+// (e.g. 16-bit normals) are padded, and the padded element size is returned as the byte stride.
+// returns buffer_index, byte_offset, byte_length, byte_stride (0 if tightly packed)
+template <typename T>
+std::tuple<int, size_t, size_t, size_t>
+write_vertex_attribute_to_buffer(tinygltf::Model& model, span<const T> data, size_t num_channels)
+{
+    const size_t element_size = num_channels * sizeof(T);
+    if (element_size % 4 == 0) {
+        auto [buffer_index, byte_offset, byte_length] = write_to_buffer<T>(model, data);
+        return {buffer_index, byte_offset, byte_length, 0};
+    }
+
+    const size_t stride = (element_size + 3) / 4 * 4;
+    const size_t num_elements = data.size() / num_channels;
+    std::vector<std::byte> padded(num_elements * stride, std::byte(0));
+    const auto data_bytes = as_bytes(data);
+    for (size_t i = 0; i < num_elements; ++i) {
+        std::copy_n(
+            data_bytes.begin() + i * element_size,
+            element_size,
+            padded.begin() + i * stride);
+    }
+    auto [buffer_index, byte_offset, byte_length] =
+        write_to_buffer<std::byte>(model, span<const std::byte>(padded));
+    return {buffer_index, byte_offset, byte_length, stride};
+}
+
+void require_extension(tinygltf::Model& model, const std::string& extension)
+{
+    if (std::find(model.extensionsUsed.begin(), model.extensionsUsed.end(), extension) ==
+        model.extensionsUsed.end()) {
+        model.extensionsUsed.push_back(extension);
+    }
+    if (std::find(model.extensionsRequired.begin(), model.extensionsRequired.end(), extension) ==
+        model.extensionsRequired.end()) {
+        model.extensionsRequired.push_back(extension);
+    }
+}
+
+// Normalized integer encodings map directly to glTF accessors. Other encodings (half floats,
+// bounded values) have no glTF equivalent and are decoded to float, while octahedral vectors are
+// re-encoded as normalized 16-bit vectors.
+void set_quantized_component_type(
+    tinygltf::Accessor& accessor,
+    const AttributeQuantization& quantization)
+{
+    accessor.normalized = true;
+    switch (quantization.encoding) {
+    case AttributeEncoding::Unorm8:
+        accessor.componentType = TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE;
+        break;
+    case AttributeEncoding::Unorm16:
+        accessor.componentType = TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT;
+        break;
+    case AttributeEncoding::Snorm8: accessor.componentType = TINYGLTF_COMPONENT_TYPE_BYTE; break;
+    case AttributeEncoding::Snorm16:
+    case AttributeEncoding::Octahedral16:
+        accessor.componentType = TINYGLTF_COMPONENT_TYPE_SHORT;
+        break;
+    default:
+        accessor.normalized = false;
+        accessor.componentType = TINYGLTF_COMPONENT_TYPE_FLOAT;
+        break;
+    }
+}
+
+// returns buffer_index, byte_offset, byte_length, byte_stride
+template <typename Scalar, typename Index>
+std::tuple<int, size_t, size_t, size_t> write_quantized_attribute(
+    tinygltf::Model& model,
+    const SurfaceMesh<Scalar, Index>& lmesh,
+    std::string_view name,
+    const AttributeQuantization& quantization)
+{
+    const size_t num_channels = quantization.num_channels;
+    auto write_stored = [&](auto stored_value) {
+        using ValueType = decltype(stored_value);
+        span<const ValueType> data =
+            lmesh.is_attribute_indexed(name)
+                ? lmesh.template get_indexed_attribute<ValueType>(name).values().get_all()
+                : lmesh.template get_attribute<ValueType>(name).get_all();
+        return write_vertex_attribute_to_buffer<ValueType>(model, data, num_channels);
+    };
+
+    switch (quantization.encoding) {
+    case AttributeEncoding::Unorm8: return write_stored(uint8_t());
+    case AttributeEncoding::Unorm16: return write_stored(uint16_t());
+    case AttributeEncoding::Snorm8: return write_stored(int8_t());
+    case AttributeEncoding::Snorm16: return write_stored(int16_t());
+    case AttributeEncoding::Octahedral16: {
+        auto decoded = decoded_matrix_view<float>(lmesh, name);
+        std::vector<int16_t> tmp(decoded.size());
+        for (Eigen::Index i = 0; i < decoded.rows(); ++i) {
+            for (Eigen::Index j = 0; j < decoded.cols(); ++j) {
+                tmp[i * decoded.cols() + j] = encode_snorm<int16_t>(decoded(i, j));
+            }
+        }
+        return write_vertex_attribute_to_buffer<int16_t>(model, tmp, num_channels);
+    }
+    default: {
+        auto decoded = decoded_matrix_view<float>(lmesh, name);
+        std::vector<float> tmp(decoded.size());
+        for (Eigen::Index i = 0; i < decoded.rows(); ++i) {
+            for (Eigen::Index j = 0; j < decoded.cols(); ++j) {
+                tmp[i * decoded.cols() + j] = decoded(i, j);
+            }
+        }
+        return write_vertex_attribute_to_buffer<float>(model, tmp, num_channels);
+    }
+    }
+}
+
 template <typename Scalar, typename Index>
 void populate_vertices(
     tinygltf::Model& model,
@@ -291,6 +482,7 @@ void populate_attributes(
         // TODO: change this for the attribute visitor that takes id and simplify this.
 
         if (lmesh.attr_name_is_reserved(name)) return;
+        if (starts_with(name, quantization_attribute_name(""))) return;
         AttributeId id = lmesh.get_attribute_id(name);
         if (options.output_attributes == SaveOptions::OutputAttributes::SelectedOnly) {
             if (std::find(
@@ -316,11 +508,21 @@ void populate_attributes(
             }
         }
 
+        // Quantized attributes are written with their decoded usage and number of channels.
+        const auto quantization = get_attribute_quantization(lmesh, name);
+        const AttributeUsage usage = quantization ? quantization->usage : attr.get_usage();
+        const size_t num_channels =
+            quantization ? quantization->num_channels : attr.get_num_channels();
+
         tinygltf::Accessor accessor;
-        if constexpr (std::is_same_v<ValueType, char>) {
+        if (quantization) {
+            set_quantized_component_type(accessor, *quantization);
+        } else if constexpr (std::is_same_v<ValueType, char> || std::is_same_v<ValueType, int8_t>) {
             accessor.componentType = TINYGLTF_COMPONENT_TYPE_BYTE;
         } else if constexpr (std::is_same_v<ValueType, unsigned char>) {
             accessor.componentType = TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE;
+        } else if constexpr (std::is_same_v<ValueType, int16_t>) {
+            accessor.componentType = TINYGLTF_COMPONENT_TYPE_SHORT;
         } else if constexpr (std::is_same_v<ValueType, uint16_t>) {
             accessor.componentType = TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT;
         } else if constexpr (
@@ -341,11 +543,11 @@ void populate_attributes(
             logger().warn(
                 "Skipping attribute `{}`: unsupported type {}",
                 name,
-                internal::string_from_scalar<ValueType>());
+                lagrange::internal::string_from_scalar<ValueType>());
             return;
         }
 
-        switch (attr.get_num_channels()) {
+        switch (num_channels) {
         case 1: accessor.type = TINYGLTF_TYPE_SCALAR; break;
         case 2: accessor.type = TINYGLTF_TYPE_VEC2; break;
         case 3: accessor.type = TINYGLTF_TYPE_VEC3; break;
@@ -357,12 +559,12 @@ void populate_attributes(
             logger().warn(
                 "Skipping attribute `{}`: unsupported number of channels {}",
                 name,
-                attr.get_num_channels());
+                num_channels);
             return;
         }
 
         std::string name_uppercase = to_upper(std::string(name));
-        if (attr.get_usage() == AttributeUsage::Normal) {
+        if (usage == AttributeUsage::Normal) {
             if (found_normal) {
                 name_uppercase = "_" + name_uppercase;
                 logger().warn(
@@ -373,7 +575,7 @@ void populate_attributes(
                 found_normal = true;
                 name_uppercase = "NORMAL";
             }
-        } else if (attr.get_usage() == AttributeUsage::Tangent) {
+        } else if (usage == AttributeUsage::Tangent) {
             if (!found_tangent && accessor.type == TINYGLTF_TYPE_VEC4) {
                 // this is good!
                 found_tangent = true;
@@ -391,10 +593,10 @@ void populate_attributes(
                     name,
                     name_uppercase);
             }
-        } else if (attr.get_usage() == AttributeUsage::Color) {
+        } else if (usage == AttributeUsage::Color) {
             name_uppercase = "COLOR_" + std::to_string(color_count);
             ++color_count;
-        } else if (attr.get_usage() == AttributeUsage::UV) {
+        } else if (usage == AttributeUsage::UV) {
             name_uppercase = "TEXCOORD_" + std::to_string(texcoord_count);
             ++texcoord_count;
         } else {
@@ -432,11 +634,15 @@ void populate_attributes(
         // we are committed to writing the buffer here. Do not return early after this line.
 
         int buffer_index;
-        size_t byte_offset, byte_length;
-        if constexpr (std::is_same_v<ValueType, double>) {
+        size_t byte_offset, byte_length, byte_stride;
+        if (quantization) {
+            std::tie(buffer_index, byte_offset, byte_length, byte_stride) =
+                write_quantized_attribute(model, lmesh, name, *quantization);
+        } else if constexpr (std::is_same_v<ValueType, double>) {
             std::vector<float> tmp;
             span<const float> data = get_attribute_as<ValueType, float>(values.get_all(), tmp);
-            std::tie(buffer_index, byte_offset, byte_length) = write_to_buffer<float>(model, data);
+            std::tie(buffer_index, byte_offset, byte_length, byte_stride) =
+                write_vertex_attribute_to_buffer<float>(model, data, num_channels);
         } else if constexpr (
             std::is_same_v<ValueType, int> || std::is_same_v<ValueType, int32_t> ||
             std::is_same_v<ValueType, int64_t> || std::is_same_v<ValueType, uint64_t> ||
@@ -444,20 +650,31 @@ void populate_attributes(
             std::vector<uint32_t> tmp;
             span<const uint32_t> data =
                 get_attribute_as<ValueType, uint32_t>(values.get_all(), tmp);
-            std::tie(buffer_index, byte_offset, byte_length) =
-                write_to_buffer<uint32_t>(model, data);
+            std::tie(buffer_index, byte_offset, byte_length, byte_stride) =
+                write_vertex_attribute_to_buffer<uint32_t>(model, data, num_channels);
         } else {
             std::vector<ValueType> tmp;
             span<const ValueType> data =
                 get_attribute_as<ValueType, ValueType>(values.get_all(), tmp);
-            std::tie(buffer_index, byte_offset, byte_length) =
-                write_to_buffer<ValueType>(model, data);
+            std::tie(buffer_index, byte_offset, byte_length, byte_stride) =
+                write_vertex_attribute_to_buffer<ValueType>(model, data, num_channels);
+        }
+
+        // Normalized integer normals, tangents and signed texture coordinates are only valid with
+        // KHR_mesh_quantization.
+        if (accessor.componentType != TINYGLTF_COMPONENT_TYPE_FLOAT &&
+            (name_uppercase == "NORMAL" || name_uppercase == "TANGENT" ||
+             (starts_with(name_uppercase, "TEXCOORD_") &&
+              (accessor.componentType == TINYGLTF_COMPONENT_TYPE_BYTE ||
+               accessor.componentType == TINYGLTF_COMPONENT_TYPE_SHORT)))) {
+            require_extension(model, "KHR_mesh_quantization");
         }
 
         tinygltf::BufferView buffer_view;
         buffer_view.buffer = buffer_index;
         buffer_view.byteLength = byte_length;
         buffer_view.byteOffset = byte_offset;
+        buffer_view.byteStride = byte_stride;
         buffer_view.target = TINYGLTF_TARGET_ARRAY_BUFFER;
         int buffer_view_index = int(model.bufferViews.size());
         model.bufferViews.push_back(buffer_view);
@@ -495,6 +712,11 @@ tinygltf::Primitive create_gltf_primitive(
 
     SurfaceMesh<Scalar, Index> lmesh_copy = lmesh;
     scene::utils::convert_texcoord_uv_st(lmesh_copy);
+    if (options.reorder_method != ReorderingMethod::None) {
+        // Edges are not exported, drop them rather than having them recomputed by the reordering.
+        lmesh_copy.clear_edges();
+        reorder_mesh(lmesh_copy, options.reorder_method);
+    }
 
     tinygltf::Primitive primitive;
     primitive.mode = TINYGLTF_MODE_TRIANGLES;
@@ -741,7 +963,26 @@ tinygltf::Model lagrange_scene_to_gltf_model(
         tinygltf::Image image;
         image.name = limage.name;
 
-        const scene::ImageBufferExperimental& lbuffer = limage.image;
+        if (limage.image.data.empty() && limage.lazy_image) {
+            const scene::LazyImageExperimental& lazy_image = *limage.lazy_image;
+            const std::string& mime_type = lazy_image.get_mime_type();
+            span<const unsigned char> encoded_data = lazy_image.get_encoded_data();
+            if (!encoded_data.empty() && (mime_type == "image/png" || mime_type == "image/jpeg")) {
+                // The encoded image is saved as is, without decoding it.
+                image.as_is = true;
+                image.mimeType = mime_type;
+                image.image.assign(encoded_data.begin(), encoded_data.end());
+                image.uri = limage.uri.string();
+                if (!limage.extensions.empty()) {
+                    image.extensions = convert_extension_map(limage.extensions, options);
+                }
+                model.images.push_back(std::move(image));
+                continue;
+            }
+        }
+
+        const auto lbuffer_ptr = limage.get_image();
+        const scene::ImageBufferExperimental& lbuffer = *lbuffer_ptr;
         image.width = static_cast<int>(lbuffer.width);
         image.height = static_cast<int>(lbuffer.height);
         image.component = static_cast<int>(lbuffer.num_channels);
@@ -18,6 +18,7 @@
 
 #include <lagrange/io/api.h>
 #include <lagrange/io/save_mesh_gltf.h>
+#include <lagrange/io/save_mesh_lgm.h>
 #include <lagrange/io/save_mesh_msh.h>
 #include <lagrange/io/save_mesh_obj.h>
 #include <lagrange/io/save_mesh_ply.h>
@@ -38,6 +39,7 @@ void save_mesh(
     case FileFormat::Ply: save_mesh_ply(output_stream, mesh, options); break;
     case FileFormat::Msh: save_mesh_msh(output_stream, mesh, options); break;
     case FileFormat::Gltf: save_mesh_gltf(output_stream, mesh, options); break;
+    case FileFormat::Lgm: save_mesh_lgm(output_stream, mesh, options); break;
     default: la_runtime_assert(false, "Unrecognized file format!");
     }
 }
@@ -57,6 +59,8 @@ void save_mesh(
         save_mesh_msh(filename, mesh, options);
     } else if (ext == ".gltf" || ext == ".glb") {
         save_mesh_gltf(filename, mesh, options);
+    } else if (ext == ".lgm") {
+        save_mesh_lgm(filename, mesh, options);
     } else {
         la_runtime_assert(false, string_format("Unrecognized filetype: {}!", ext));
     }
@@ -0,0 +1,253 @@
+/*
+ * Copyright 2024 Adobe. All rights reserved.
+ * This file is licensed to you under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License. You may obtain a copy
+ * of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under
+ * the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR REPRESENTATIONS
+ * OF ANY KIND, either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+ */
+
+#include <lagrange/Attribute.h>
+#include <lagrange/IndexedAttribute.h>
+#include <lagrange/Logger.h>
+#include <lagrange/SurfaceMeshTypes.h>
+#include <lagrange/foreach_attribute.h>
+#include <lagrange/io/api.h>
+#include <lagrange/io/save_mesh_lgm.h>
+#include <lagrange/utils/assert.h>
+
+#include "internal/lgm_format.h"
+
+// clang-format off
+#include <lagrange/utils/warnoff.h>
+#include <miniz.h>
+#include <tbb/parallel_for.h>
+#include <lagrange/utils/warnon.h>
+// clang-format on
+
+#include <ostream>
+
+namespace lagrange::io {
+
+namespace {
+
+///
+/// A data buffer to be written to the file.
+///
+struct PendingBlob
+{
+    /// Entry of the table of contents describing the blob.
+    internal::LgmBlob* entry = nullptr;
+
+    /// Uncompressed data, pointing to mesh memory.
+    span<const char> raw;
+
+    /// Compressed data, if compression was applied.
+    std::vector<char> compressed;
+
+    span<const char> get_data() const
+    {
+        if (entry->compression == internal::LgmCompression::None) return raw;
+        return {compressed.data(), compressed.size()};
+    }
+};
+
+template <typename T>
+span<const char> as_bytes(span<const T> values)
+{
+    return {reinterpret_cast<const char*>(values.data()), values.size_bytes()};
+}
+
+template <typename T>
+std::array<uint8_t, 8> encode_default_value(T value)
+{
+    static_assert(sizeof(T) <= 8);
+    std::array<uint8_t, 8> bytes = {};
+    std::memcpy(bytes.data(), &value, sizeof(T));
+    return bytes;
+}
+
+size_t align_offset(size_t offset)
+{
+    return (offset + internal::lgm_alignment - 1) / internal::lgm_alignment *
+           internal::lgm_alignment;
+}
+
+void compress_blob(PendingBlob& blob)
+{
+    if (blob.raw.size() < internal::lgm_min_compressed_size) return;
+
+    mz_ulong size = mz_compressBound(static_cast<mz_ulong>(blob.raw.size()));
+    blob.compressed.resize(size);
+    int status = mz_compress2(
+        reinterpret_cast<unsigned char*>(blob.compressed.data()),
+        &size,
+        reinterpret_cast<const unsigned char*>(blob.raw.data()),
+        static_cast<mz_ulong>(blob.raw.size()),
+        MZ_BEST_SPEED);
+    if (status != MZ_OK || size >= blob.raw.size()) {
+        // Keep incompressible data as-is, so that it can be used in place when loading.
+        blob.compressed = {};
+        return;
+    }
+    blob.compressed.resize(size);
+    blob.entry->compression = internal::LgmCompression::Deflate;
+}
+
+void write_padding(std::ostream& output_stream, size_t& offset)
+{
+    static const char zeros[internal::lgm_alignment] = {};
+    size_t aligned = align_offset(offset);
+    output_stream.write(zeros, static_cast<std::streamsize>(aligned - offset));
+    offset = aligned;
+}
+
+} // namespace
+
+template <typename Scalar, typename Index>
+void save_mesh_lgm(
+    std::ostream& output_stream,
+    const SurfaceMesh<Scalar, Index>& mesh,
+    const SaveOptions& options)
+{
+    internal::LgmToc toc;
+    toc.scalar_type = make_attribute_value_type<Scalar>();
+    toc.index_type = make_attribute_value_type<Index>();
+    toc.dimension = static_cast<uint32_t>(mesh.get_dimension());
+    toc.num_vertices = mesh.get_num_vertices();
+    toc.num_facets = mesh.get_num_facets();
+    toc.num_corners = mesh.get_num_corners();
+    toc.has_edges = mesh.has_edges();
+    toc.num_edges = toc.has_edges ? mesh.get_num_edges() : 0;
+    if (mesh.get_num_facets() > 0 && mesh.is_regular()) {
+        toc.vertex_per_facet = static_cast<uint32_t>(mesh.get_vertex_per_facet());
+    }
+
+    // Edges are stored as a list of vertex endpoints, from which the connectivity is rebuilt.
+    std::vector<Index> edge_to_vertices;
+    if (toc.has_edges) {
+        edge_to_vertices.resize(2 * toc.num_edges);
+        tbb::parallel_for(Index(0), mesh.get_num_edges(), [&](Index e) {
+            auto v = mesh.get_edge_vertices(e);
+            edge_to_vertices[2 * e] = v[0];
+            edge_to_vertices[2 * e + 1] = v[1];
+        });
+    }
+
+    // Attributes
+    std::vector<span<const char>> attribute_values;
+    std::vector<span<const char>> attribute_indices;
+    auto add_attribute = [&](std::string_view name, auto&& attr) {
+        if (mesh.attr_name_is_reserved(name)) return;
+        using AttributeType = std::decay_t<decltype(attr)>;
+        using ValueType = typename AttributeType::ValueType;
+        logger().debug("Writing attribute '{}'", name);
+
+        internal::LgmAttribute entry;
+        entry.name = name;
+        entry.element = attr.get_element_type();
+        entry.usage = attr.get_usage();
+        entry.value_type = make_attribute_value_type<ValueType>();
+        entry.num_channels = attr.get_num_channels();
+        if constexpr (AttributeType::IsIndexed) {
+            entry.num_values = attr.values().get_num_elements();
+            entry.default_value = encode_default_value(attr.values().get_default_value());
+            attribute_values.push_back(as_bytes(attr.values().get_all()));
+            attribute_indices.push_back(as_bytes(attr.indices().get_all()));
+        } else {
+            entry.num_values = attr.get_num_elements();
+            entry.default_value = encode_default_value(attr.get_default_value());
+            attribute_values.push_back(as_bytes(attr.get_all()));
+            attribute_indices.emplace_back();
+        }
+        toc.attributes.push_back(std::move(entry));
+    };
+    if (options.output_attributes == SaveOptions::OutputAttributes::All) {
+        seq_foreach_named_attribute_read(mesh, add_attribute);
+    } else if (!options.selected_attributes.empty()) {
+        details::internal_foreach_named_attribute<
+            BitField<AttributeElement>::all(),
+            details::Ordering::Sequential,
+            details::Access::Read>(mesh, add_attribute, options.selected_attributes);
+    }
+
+    // Gather data blobs
+    std::vector<PendingBlob> blobs;
+    auto add_blob = [&](internal::LgmBlob& entry, span<const char> data) {
+        entry.raw_size = data.size();
+        blobs.push_back({&entry, data, {}});
+    };
+    add_blob(toc.positions, as_bytes(mesh.get_vertex_to_position().get_all()));
+    add_blob(toc.corner_to_vertex, as_bytes(mesh.get_corner_to_vertex().get_all()));
+    if (mesh.is_hybrid()) {
+        add_blob(
+            toc.facet_to_first_corner,
+            as_bytes(mesh.template get_attribute<Index>(mesh.attr_id_facet_to_first_corner())
+                         .get_all()));
+    }
+    if (toc.has_edges) {
+        add_blob(toc.edge_to_vertices, as_bytes(span<const Index>(edge_to_vertices)));
+    }
+    for (size_t i = 0; i < toc.attributes.size(); ++i) {
+        add_blob(toc.attributes[i].values, attribute_values[i]);
+        if (toc.attributes[i].element == AttributeElement::Indexed) {
+            add_blob(toc.attributes[i].indices, attribute_indices[i]);
+        }
+    }
+
+    if (options.compress) {
+        tbb::parallel_for(size_t(0), blobs.size(), [&](size_t i) { compress_blob(blobs[i]); });
+    }
+
+    // Layout. Blob offsets have a fixed size in the table of contents, so its size is known before
+    // the offsets are assigned.
+    const size_t toc_size = internal::write_lgm_toc(toc).size();
+    size_t offset = align_offset(internal::lgm_header_size + toc_size);
+    for (auto& blob : blobs) {
+        blob.entry->offset = offset;
+        blob.entry->size = blob.get_data().size();
+        offset = align_offset(offset + blob.entry->size);
+    }
+
+    // Write everything
+    std::string header = internal::write_lgm_header(toc_size);
+    std::string toc_data = internal::write_lgm_toc(toc);
+    la_debug_assert(toc_data.size() == toc_size);
+    output_stream.write(header.data(), static_cast<std::streamsize>(header.size()));
+    output_stream.write(toc_data.data(), static_cast<std::streamsize>(toc_data.size()));
+    offset = header.size() + toc_data.size();
+    for (const auto& blob : blobs) {
+        write_padding(output_stream, offset);
+        auto data = blob.get_data();
+        output_stream.write(data.data(), static_cast<std::streamsize>(data.size()));
+        offset += data.size();
+    }
+    la_runtime_assert(output_stream.good(), "Failed to write .lgm data");
+}
+
+template <typename Scalar, typename Index>
+void save_mesh_lgm(
+    const fs::path& filename,
+    const SurfaceMesh<Scalar, Index>& mesh,
+    const SaveOptions& options)
+{
+    fs::ofstream fout(filename, std::ios::binary);
+    la_runtime_assert(fout.good(), fmt::format("Unable to open file {}", filename.string()));
+    save_mesh_lgm(fout, mesh, options);
+}
+
+#define LA_X_save_mesh_lgm(_, Scalar, Index)    \
+    template LA_IO_API void save_mesh_lgm(      \
+        std::ostream&,                          \
+        const SurfaceMesh<Scalar, Index>& mesh, \
+        const SaveOptions& options);            \
+    template LA_IO_API void save_mesh_lgm(      \
+        const fs::path& filename,               \
+        const SurfaceMesh<Scalar, Index>& mesh, \
+        const SaveOptions& options);
+LA_SURFACE_MESH_X(save_mesh_lgm, 0)
+
+} // namespace lagrange::io
@@ -22,6 +22,7 @@
 #include <lagrange/views.h>
 
 #include "internal/convert_attribute_utils.h"
+#include "internal/ply_format.h"
 
 // clang-format off
 #include <lagrange/utils/warnoff.h>
@@ -30,6 +31,9 @@
 // clang-format on
 
 #include <algorithm>
+#include <cstring>
+#include <functional>
+#include <limits>
 
 namespace lagrange::io {
 
@@ -207,6 +211,387 @@ void register_attribute(happly::Element& element, std::string_view name, T&& att
     }
 }
 
+// =====================================
+// Native binary PLY writer
+// =====================================
+
+///
+/// A property of a PLY element, streamed directly from a mesh buffer.
+///
+struct PlyColumn
+{
+    std::string name;
+    internal::PlyType type;
+    bool is_list = false;
+    internal::PlyType count_type = internal::PlyType::UInt8;
+
+    /// Maximum number of bytes written per record.
+    size_t max_record_size = 0;
+
+    /// Adds the number of bytes of records [first, last) to `sizes`. Only set when records have a
+    /// variable size, otherwise every record takes `max_record_size` bytes.
+    std::function<void(size_t first, size_t last, size_t* sizes)> add_record_sizes;
+
+    /// Encodes the value(s) of records [first, last). `out[k]` points to where record `first + k`
+    /// is written, and is advanced past the written bytes.
+    std::function<void(size_t first, size_t last, char** out)> write;
+};
+
+template <typename T>
+char* write_value(char* out, T value)
+{
+    std::memcpy(out, &value, sizeof(T));
+    return out + sizeof(T);
+}
+
+template <typename OutType, typename ValueType>
+OutType convert_value(ValueType value)
+{
+    if constexpr (std::is_same_v<OutType, ValueType>) {
+        return value;
+    } else {
+        return safe_cast<OutType>(value);
+    }
+}
+
+/// PLY-compatible type used to write values of a given type.
+template <typename ValueType>
+using PlyValueType = std::conditional_t<
+    is_valid_ply_type<ValueType>(),
+    ValueType,
+    std::conditional_t<std::is_signed_v<ValueType>, int32_t, uint32_t>>;
+
+///
+/// Creates a scalar column from one channel of a row-major buffer.
+///
+template <typename ValueType>
+PlyColumn
+make_scalar_column(std::string name, span<const ValueType> values, size_t num_channels, size_t c)
+{
+    using OutType = PlyValueType<ValueType>;
+    PlyColumn column;
+    column.name = std::move(name);
+    column.type = internal::ply_type_of<OutType>();
+    column.max_record_size = sizeof(OutType);
+    column.write = [=](size_t first, size_t last, char** out) {
+        for (size_t i = first; i < last; ++i, ++out) {
+            *out = write_value(*out, convert_value<OutType>(values[i * num_channels + c]));
+        }
+    };
+    return column;
+}
+
+///
+/// Creates a list column from all channels of a row-major buffer.
+///
+template <typename ValueType>
+PlyColumn make_list_column(std::string name, span<const ValueType> values, size_t num_channels)
+{
+    using OutType = PlyValueType<ValueType>;
+    PlyColumn column;
+    column.name = std::move(name);
+    column.type = internal::ply_type_of<OutType>();
+    column.is_list = true;
+    column.count_type = internal::PlyType::UInt8;
+    la_runtime_assert(num_channels <= std::numeric_limits<uint8_t>::max());
+    column.max_record_size = 1 + num_channels * sizeof(OutType);
+    column.write = [=](size_t first, size_t last, char** out) {
+        for (size_t i = first; i < last; ++i, ++out) {
+            *out = write_value(*out, static_cast<uint8_t>(num_channels));
+            for (size_t c = 0; c < num_channels; ++c) {
+                *out = write_value(*out, convert_value<OutType>(values[i * num_channels + c]));
+            }
+        }
+    };
+    return column;
+}
+
+template <typename AttributeType>
+void add_columns(
+    std::vector<PlyColumn>& columns,
+    std::string_view name,
+    const AttributeType& attr,
+    std::initializer_list<std::string_view> channel_names,
+    size_t& count)
+{
+    using ValueType = typename AttributeType::ValueType;
+    std::string suffix = count == 0 ? "" : fmt::format("_{}", count);
+    logger().debug("Writing attribute '{}'", name);
+    const size_t num_channels = attr.get_num_channels();
+    size_t c = 0;
+    for (auto channel_name : channel_names) {
+        if (c == num_channels) break;
+        columns.push_back(make_scalar_column<ValueType>(
+            fmt::format("{}{}", channel_name, suffix),
+            attr.get_all(),
+            num_channels,
+            c++));
+    }
+    ++count;
+}
+
+template <typename AttributeType>
+void add_columns(std::vector<PlyColumn>& columns, std::string_view name, const AttributeType& attr)
+{
+    using ValueType = typename AttributeType::ValueType;
+    logger().debug("Writing attribute '{}'", name);
+    if (attr.get_num_channels() == 1) {
+        columns.push_back(make_scalar_column<ValueType>(std::string(name), attr.get_all(), 1, 0));
+    } else {
+        columns.push_back(make_list_column<ValueType>(
+            std::string(name),
+            attr.get_all(),
+            attr.get_num_channels()));
+    }
+}
+
+void write_header_element(
+    std::string& header,
+    std::string_view name,
+    size_t count,
+    const std::vector<PlyColumn>& columns)
+{
+    header += fmt::format("element {} {}\n", name, count);
+    for (const auto& column : columns) {
+        if (column.is_list) {
+            header += fmt::format(
+                "property list {} {} {}\n",
+                internal::ply_type_name(column.count_type),
+                internal::ply_type_name(column.type),
+                column.name);
+        } else {
+            header +=
+                fmt::format("property {} {}\n", internal::ply_type_name(column.type), column.name);
+        }
+    }
+}
+
+///
+/// Streams the records of an element through a fixed-size buffer. Records are encoded in batches,
+/// one column at a time, so that each column is dispatched once per batch rather than per value.
+///
+void write_element(std::ostream& output_stream, size_t count, const std::vector<PlyColumn>& columns)
+{
+    size_t max_record_size = 0;
+    size_t fixed_record_size = 0;
+    bool has_variable_size = false;
+    for (const auto& column : columns) {
+        max_record_size += column.max_record_size;
+        if (column.add_record_sizes) {
+            has_variable_size = true;
+        } else {
+            fixed_record_size += column.max_record_size;
+        }
+    }
+    if (count == 0 || max_record_size == 0) return;
+
+    std::vector<char> buffer(std::max(size_t(1) << 20, max_record_size));
+    const size_t batch_size = buffer.size() / max_record_size;
+    std::vector<char*> cursors(batch_size);
+    std::vector<size_t> sizes(has_variable_size ? batch_size : 0);
+    for (size_t first = 0; first < count; first += batch_size) {
+        const size_t last = std::min(count, first + batch_size);
+        const size_t n = last - first;
+
+        // Start of each record in the buffer.
+        char* out = buffer.data();
+        if (has_variable_size) {
+            std::fill_n(sizes.begin(), n, fixed_record_size);
+            for (const auto& column : columns) {
+                if (column.add_record_sizes) column.add_record_sizes(first, last, sizes.data());
+            }
+            for (size_t k = 0; k < n; ++k) {
+                cursors[k] = out;
+                out += sizes[k];
+            }
+        } else {
+            for (size_t k = 0; k < n; ++k) {
+                cursors[k] = out;
+                out += fixed_record_size;
+            }
+        }
+
+        for (const auto& column : columns) {
+            column.write(first, last, cursors.data());
+        }
+        la_debug_assert(cursors[n - 1] == out);
+        output_stream.write(buffer.data(), out - buffer.data());
+    }
+}
+
+template <typename Scalar, typename Index>
+void save_mesh_ply_binary(
+    std::ostream& output_stream,
+    const SurfaceMesh<Scalar, Index>& mesh,
+    const SaveOptions& options)
+{
+    std::vector<PlyColumn> vertex_columns;
+    std::vector<PlyColumn> facet_columns;
+    std::vector<PlyColumn> edge_columns;
+
+    // Vertex positions
+    auto positions = mesh.get_vertex_to_position().get_all();
+    for (size_t c = 0; c < 3; ++c) {
+        vertex_columns.push_back(
+            make_scalar_column<Scalar>(std::string(1, "xyz"[c]), positions, 3, c));
+    }
+
+    // Facet indices
+    {
+        using OutType = PlyValueType<Index>;
+        PlyColumn column;
+        column.name = "vertex_indices";
+        column.type = internal::ply_type_of<OutType>();
+        column.is_list = true;
+        Index max_facet_size = 0;
+        if (mesh.is_regular()) {
+            max_facet_size = mesh.get_vertex_per_facet();
+        } else {
+            for (Index f = 0; f < mesh.get_num_facets(); ++f) {
+                max_facet_size = std::max(max_facet_size, mesh.get_facet_size(f));
+            }
+        }
+        const bool small_facets = max_facet_size <= std::numeric_limits<uint8_t>::max();
+        column.count_type = small_facets ? internal::PlyType::UInt8 : internal::PlyType::UInt32;
+        column.max_record_size =
+            (small_facets ? 1 : 4) + static_cast<size_t>(max_facet_size) * sizeof(OutType);
+        if (!mesh.is_regular()) {
+            const size_t count_size = small_facets ? 1 : 4;
+            column.add_record_sizes = [&mesh, count_size](size_t first, size_t last, size_t* s) {
+                for (size_t f = first; f < last; ++f, ++s) {
+                    const auto facet_size = mesh.get_facet_size(static_cast<Index>(f));
+                    *s += count_size + static_cast<size_t>(facet_size) * sizeof(OutType);
+                }
+            };
+        }
+        auto write_facets = [&mesh](auto count_type, size_t first, size_t last, char** out) {
+            using CountType = decltype(count_type);
+            for (size_t f = first; f < last; ++f, ++out) {
+                auto facet = mesh.get_facet_vertices(static_cast<Index>(f));
+                *out = write_value(*out, static_cast<CountType>(facet.size()));
+                for (Index v : facet) {
+                    *out = write_value(*out, convert_value<OutType>(v));
+                }
+            }
+        };
+        if (small_facets) {
+            column.write = [write_facets](size_t first, size_t last, char** out) {
+                write_facets(uint8_t(), first, last, out);
+            };
+        } else {
+            column.write = [write_facets](size_t first, size_t last, char** out) {
+                write_facets(uint32_t(), first, last, out);
+            };
+        }
+        facet_columns.push_back(std::move(column));
+    }
+
+    // Edge indices
+    if (mesh.has_edges()) {
+        using OutType = PlyValueType<Index>;
+        for (size_t c = 0; c < 2; ++c) {
+            PlyColumn column;
+            column.name = fmt::format("vertex{}", c + 1);
+            column.type = internal::ply_type_of<OutType>();
+            column.max_record_size = sizeof(OutType);
+            column.write = [&mesh, c](size_t first, size_t last, char** out) {
+                for (size_t e = first; e < last; ++e, ++out) {
+                    auto verts = mesh.get_edge_vertices(static_cast<Index>(e));
+                    *out = write_value(*out, convert_value<OutType>(verts[c]));
+                }
+            };
+            edge_columns.push_back(std::move(column));
+        }
+    }
+
+    size_t vertex_normal_count = 0;
+    size_t vertex_uv_count = 0;
+    size_t vertex_color_count = 0;
+    size_t facet_normal_count = 0;
+    size_t facet_color_count = 0;
+
+    auto add_vertex_attribute = [&](std::string_view name, auto&& attr) {
+        if (mesh.attr_name_is_reserved(name)) return;
+        switch (attr.get_usage()) {
+        case AttributeUsage::UV:
+            add_columns(vertex_columns, name, attr, {"s", "t"}, vertex_uv_count);
+            break;
+        case AttributeUsage::Normal:
+            add_columns(vertex_columns, name, attr, {"nx", "ny", "nz"}, vertex_normal_count);
+            break;
+        case AttributeUsage::Color:
+            if (attr.get_num_channels() != 3 && attr.get_num_channels() != 4) break;
+            add_columns(
+                vertex_columns,
+                name,
+                attr,
+                {"red", "green", "blue", "alpha"},
+                vertex_color_count);
+            break;
+        default: add_columns(vertex_columns, name, attr);
+        }
+    };
+
+    auto add_facet_attribute = [&](std::string_view name, auto&& attr) {
+        if (mesh.attr_name_is_reserved(name)) return;
+        switch (attr.get_usage()) {
+        case AttributeUsage::Normal:
+            add_columns(facet_columns, name, attr, {"nx", "ny", "nz"}, facet_normal_count);
+            break;
+        case AttributeUsage::Color:
+            if (attr.get_num_channels() != 3 && attr.get_num_channels() != 4) break;
+            add_columns(
+                facet_columns,
+                name,
+                attr,
+                {"red", "green", "blue", "alpha"},
+                facet_color_count);
+            break;
+        default: add_columns(facet_columns, name, attr);
+        }
+    };
+
+    if (options.output_attributes == io::SaveOptions::OutputAttributes::All) {
+        seq_foreach_named_attribute_read<AttributeElement::Vertex>(mesh, add_vertex_attribute);
+        seq_foreach_named_attribute_read<AttributeElement::Facet>(mesh, add_facet_attribute);
+    } else if (!options.selected_attributes.empty()) {
+        details::internal_foreach_named_attribute<
+            AttributeElement::Vertex,
+            details::Ordering::Sequential,
+            details::Access::Read>(mesh, add_vertex_attribute, options.selected_attributes);
+
+        details::internal_foreach_named_attribute<
+            AttributeElement::Facet,
+            details::Ordering::Sequential,
+            details::Access::Read>(mesh, add_facet_attribute, options.selected_attributes);
+    }
+
+    // Header. The comment line is padded so that the payload starts at an offset that is a
+    // multiple of 16 bytes, which allows loading vertex positions without copy.
+    std::string elements;
+    write_header_element(elements, "vertex", mesh.get_num_vertices(), vertex_columns);
+    write_header_element(elements, "face", mesh.get_num_facets(), facet_columns);
+    if (mesh.has_edges()) {
+        write_header_element(elements, "edge", mesh.get_num_edges(), edge_columns);
+    }
+    std::string header = fmt::format(
+        "ply\nformat {} 1.0\ncomment Written by Lagrange",
+        internal::host_is_little_endian() ? "binary_little_endian" : "binary_big_endian");
+    constexpr size_t alignment = 16;
+    const size_t unpadded_size = header.size() + 1 + elements.size() + strlen("end_header\n");
+    header.append((alignment - unpadded_size % alignment) % alignment, ' ');
+    header += '\n';
+    header += elements;
+    header += "end_header\n";
+    output_stream.write(header.data(), static_cast<std::streamsize>(header.size()));
+
+    // Payload
+    write_element(output_stream, mesh.get_num_vertices(), vertex_columns);
+    write_element(output_stream, mesh.get_num_facets(), facet_columns);
+    if (mesh.has_edges()) {
+        write_element(output_stream, mesh.get_num_edges(), edge_columns);
+    }
+}
 
 } // namespace
 
@@ -234,6 +619,11 @@ void save_mesh_ply(
         return save_mesh_ply(output_stream, mesh2, options2);
     }
 
+    if (options.encoding != FileEncoding::Ascii) {
+        save_mesh_ply_binary(output_stream, mesh, options);
+        return;
+    }
+
     // Create an empty object
     happly::PLYData ply;
 
@@ -364,15 +754,8 @@ void save_mesh_ply(
     }
 
     // Write the object to file
-    happly::DataFormat format;
-    switch (options.encoding) {
-    case FileEncoding::Binary: format = happly::DataFormat::Binary; break;
-    case FileEncoding::Ascii: format = happly::DataFormat::ASCII; break;
-    default: format = happly::DataFormat::Binary;
-    }
-
     ply.validate();
-    ply.write(output_stream, format);
+    ply.write(output_stream, happly::DataFormat::ASCII);
 }
 
 template <typename Scalar, typename Index>
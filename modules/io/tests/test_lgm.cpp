@@ -0,0 +1,306 @@
+/*
+ * Copyright 2024 Adobe. All rights reserved.
+ * This file is licensed to you under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License. You may obtain a copy
+ * of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under
+ * the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR REPRESENTATIONS
+ * OF ANY KIND, either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+ */
+#include <lagrange/Attribute.h>
+#include <lagrange/IndexedAttribute.h>
+#include <lagrange/foreach_attribute.h>
+#include <lagrange/io/load_mesh.h>
+#include <lagrange/io/load_mesh_lgm.h>
+#include <lagrange/io/save_mesh.h>
+#include <lagrange/io/save_mesh_lgm.h>
+#include <lagrange/testing/check_mesh.h>
+#include <lagrange/testing/common.h>
+
+#include <algorithm>
+#include <cstring>
+#include <sstream>
+
+namespace {
+
+template <typename Scalar, typename Index>
+lagrange::SurfaceMesh<Scalar, Index> create_lgm_test_mesh()
+{
+    using namespace lagrange;
+
+    // A grid of quads, with the last row split into triangles.
+    const Index n = 32;
+    SurfaceMesh<Scalar, Index> mesh;
+    for (Index j = 0; j <= n; ++j) {
+        for (Index i = 0; i <= n; ++i) {
+            mesh.add_vertex({Scalar(i) / n, Scalar(j) / n, Scalar(i * j) / (n * n)});
+        }
+    }
+    for (Index j = 0; j < n; ++j) {
+        for (Index i = 0; i < n; ++i) {
+            Index v0 = j * (n + 1) + i;
+            Index v1 = v0 + 1;
+            Index v2 = v1 + n + 1;
+            Index v3 = v0 + n + 1;
+            if (j + 1 < n) {
+                mesh.add_quad(v0, v1, v2, v3);
+            } else {
+                mesh.add_triangle(v0, v1, v2);
+                mesh.add_triangle(v0, v2, v3);
+            }
+        }
+    }
+    mesh.initialize_edges();
+
+    auto vertex_id = mesh.template create_attribute<float>(
+        "vertex_color",
+        AttributeElement::Vertex,
+        AttributeUsage::Color,
+        3);
+    auto vertex_values = mesh.template ref_attribute<float>(vertex_id).ref_all();
+    for (size_t i = 0; i < vertex_values.size(); ++i) vertex_values[i] = float(i % 7) / 7.f;
+
+    auto facet_id = mesh.template create_attribute<int64_t>(
+        "facet_label",
+        AttributeElement::Facet,
+        AttributeUsage::Scalar,
+        1);
+    auto& facet_attr = mesh.template ref_attribute<int64_t>(facet_id);
+    facet_attr.set_default_value(-1);
+    auto facet_values = facet_attr.ref_all();
+    for (size_t i = 0; i < facet_values.size(); ++i) facet_values[i] = int64_t(i) - 100;
+
+    auto corner_id = mesh.template create_attribute<Index>(
+        "corner_next",
+        AttributeElement::Corner,
+        AttributeUsage::CornerIndex,
+        1);
+    auto corner_values = mesh.template ref_attribute<Index>(corner_id).ref_all();
+    for (Index c = 0; c < mesh.get_num_corners(); ++c) {
+        Index f = mesh.get_corner_facet(c);
+        Index first = mesh.get_facet_corner_begin(f);
+        corner_values[c] = first + (c - first + 1) % mesh.get_facet_size(f);
+    }
+
+    auto edge_id = mesh.template create_attribute<uint8_t>(
+        "edge_flag",
+        AttributeElement::Edge,
+        AttributeUsage::Scalar,
+        1);
+    auto edge_values = mesh.template ref_attribute<uint8_t>(edge_id).ref_all();
+    for (Index e = 0; e < mesh.get_num_edges(); ++e) {
+        edge_values[e] = mesh.is_boundary_edge(e) ? 1 : 0;
+    }
+
+    std::vector<double> uv_values = {0, 0, 1, 0, 1, 1, 0, 1};
+    std::vector<Index> uv_indices(mesh.get_num_corners());
+    for (Index c = 0; c < mesh.get_num_corners(); ++c) uv_indices[c] = c % 4;
+    mesh.template create_attribute<double>(
+        "uv",
+        AttributeElement::Indexed,
+        AttributeUsage::UV,
+        2,
+        uv_values,
+        uv_indices);
+
+    mesh.create_metadata("description", "lgm test mesh");
+
+    return mesh;
+}
+
+template <typename Scalar, typename Index>
+void ensure_identical_mesh(
+    const lagrange::SurfaceMesh<Scalar, Index>& mesh1,
+    const lagrange::SurfaceMesh<Scalar, Index>& mesh2)
+{
+    using namespace lagrange;
+
+    auto same = [](auto a, auto b) { return std::equal(a.begin(), a.end(), b.begin(), b.end()); };
+
+    REQUIRE(mesh1.get_dimension() == mesh2.get_dimension());
+    REQUIRE(mesh1.get_num_vertices() == mesh2.get_num_vertices());
+    REQUIRE(mesh1.get_num_facets() == mesh2.get_num_facets());
+    REQUIRE(mesh1.get_num_corners() == mesh2.get_num_corners());
+    REQUIRE(mesh1.has_edges() == mesh2.has_edges());
+    REQUIRE(same(
+        mesh1.get_vertex_to_position().get_all(),
+        mesh2.get_vertex_to_position().get_all()));
+    REQUIRE(same(mesh1.get_corner_to_vertex().get_all(), mesh2.get_corner_to_vertex().get_all()));
+    for (Index f = 0; f < mesh1.get_num_facets(); ++f) {
+        REQUIRE(mesh1.get_facet_corner_begin(f) == mesh2.get_facet_corner_begin(f));
+    }
+    if (mesh1.has_edges()) {
+        REQUIRE(mesh1.get_num_edges() == mesh2.get_num_edges());
+        for (Index e = 0; e < mesh1.get_num_edges(); ++e) {
+            REQUIRE(mesh1.get_edge_vertices(e) == mesh2.get_edge_vertices(e));
+        }
+    }
+
+    seq_foreach_named_attribute_read(mesh1, [&](std::string_view name, auto&& attr1) {
+        if (mesh1.attr_name_is_reserved(name)) return;
+        using AttributeType = std::decay_t<decltype(attr1)>;
+        using ValueType = typename AttributeType::ValueType;
+        REQUIRE(mesh2.has_attribute(name));
+        REQUIRE(mesh2.template is_attribute_type<ValueType>(name));
+        if constexpr (AttributeType::IsIndexed) {
+            const auto& attr2 = mesh2.template get_indexed_attribute<ValueType>(name);
+            REQUIRE(attr1.get_usage() == attr2.get_usage());
+            REQUIRE(attr1.get_num_channels() == attr2.get_num_channels());
+            REQUIRE(same(attr1.values().get_all(), attr2.values().get_all()));
+            REQUIRE(same(attr1.indices().get_all(), attr2.indices().get_all()));
+        } else {
+            const auto& attr2 = mesh2.template get_attribute<ValueType>(name);
+            REQUIRE(attr1.get_element_type() == attr2.get_element_type());
+            REQUIRE(attr1.get_usage() == attr2.get_usage());
+            REQUIRE(attr1.get_num_channels() == attr2.get_num_channels());
+            REQUIRE(attr1.get_default_value() == attr2.get_default_value());
+            REQUIRE(same(attr1.get_all(), attr2.get_all()));
+        }
+    });
+}
+
+} // namespace
+
+TEST_CASE("io/lgm", "[io][lgm]")
+{
+    using namespace lagrange;
+    using Scalar = double;
+    using Index = uint32_t;
+
+    auto mesh = create_lgm_test_mesh<Scalar, Index>();
+    io::SaveOptions options;
+
+    SECTION("Stream")
+    {
+        std::stringstream data;
+        io::save_mesh_lgm(data, mesh, options);
+        auto mesh2 = io::load_mesh_lgm<SurfaceMesh<Scalar, Index>>(data);
+        testing::check_mesh(mesh2);
+        ensure_identical_mesh(mesh, mesh2);
+        REQUIRE(mesh2.get_metadata("description") == "lgm test mesh");
+    }
+
+    SECTION("Compressed stream")
+    {
+        std::stringstream data1;
+        std::stringstream data2;
+        io::save_mesh_lgm(data1, mesh, options);
+        options.compress = true;
+        io::save_mesh_lgm(data2, mesh, options);
+        REQUIRE(data2.str().size() < data1.str().size());
+        auto mesh2 = io::load_mesh<SurfaceMesh<Scalar, Index>>(data2);
+        testing::check_mesh(mesh2);
+        ensure_identical_mesh(mesh, mesh2);
+    }
+
+    SECTION("Memory-mapped file")
+    {
+        fs::path filename = "test_lgm.lgm";
+        io::save_mesh(filename, mesh, options);
+        auto mesh2 = io::load_mesh<SurfaceMesh<Scalar, Index>>(filename);
+        testing::check_mesh(mesh2);
+        ensure_identical_mesh(mesh, mesh2);
+        REQUIRE(mesh2.get_vertex_to_position().is_external());
+        REQUIRE(mesh2.get_attribute<float>("vertex_color").is_external());
+
+        // Wrapped buffers are copied upon modification.
+        mesh2.ref_position(0)[0] = 10;
+        REQUIRE(!mesh2.get_vertex_to_position().is_external());
+        mesh2.add_vertex({1, 2, 3});
+        mesh2.add_triangle(0, 1, mesh2.get_num_vertices() - 1);
+        testing::check_mesh(mesh2);
+    }
+
+    SECTION("Selected attributes")
+    {
+        options.output_attributes = io::SaveOptions::OutputAttributes::SelectedOnly;
+        options.selected_attributes = {mesh.get_attribute_id("facet_label")};
+        std::stringstream data;
+        io::save_mesh_lgm(data, mesh, options);
+        auto mesh2 = io::load_mesh_lgm<SurfaceMesh<Scalar, Index>>(data);
+        REQUIRE(mesh2.has_attribute("facet_label"));
+        REQUIRE(!mesh2.has_attribute("vertex_color"));
+        REQUIRE(!mesh2.has_attribute("uv"));
+    }
+
+    SECTION("Different mesh type")
+    {
+        std::stringstream data;
+        io::save_mesh_lgm(data, mesh, options);
+        auto mesh2 = io::load_mesh_lgm<SurfaceMesh<float, uint64_t>>(data);
+        testing::check_mesh(mesh2);
+        REQUIRE(mesh2.get_num_vertices() == mesh.get_num_vertices());
+        REQUIRE(mesh2.get_num_facets() == mesh.get_num_facets());
+        REQUIRE(mesh2.get_num_edges() == mesh.get_num_edges());
+        for (Index c = 0; c < mesh.get_num_corners(); ++c) {
+            REQUIRE(mesh2.get_corner_vertex(c) == mesh.get_corner_vertex(c));
+        }
+        REQUIRE(
+            mesh2.get_attribute<uint64_t>("corner_next").get_all().back() ==
+            mesh.get_attribute<Index>("corner_next").get_all().back());
+    }
+
+    SECTION("Invalid data")
+    {
+        std::stringstream data;
+        io::save_mesh_lgm(data, mesh, options);
+        std::string str = data.str();
+        std::stringstream truncated(str.substr(0, str.size() / 2));
+        LA_REQUIRE_THROWS(io::load_mesh_lgm<SurfaceMesh<Scalar, Index>>(truncated));
+        std::stringstream garbage("not a mesh file");
+        LA_REQUIRE_THROWS(io::load_mesh_lgm<SurfaceMesh<Scalar, Index>>(garbage));
+    }
+
+    SECTION("Invalid attribute enums")
+    {
+        options.output_attributes = io::SaveOptions::OutputAttributes::SelectedOnly;
+        options.selected_attributes = {mesh.get_attribute_id("facet_label")};
+        std::stringstream data;
+        io::save_mesh_lgm(data, mesh, options);
+        const std::string str = data.str();
+
+        // The attribute name is followed by its element (u32), usage (u32) and value type (u8).
+        const size_t name_pos = str.find("facet_label");
+        REQUIRE(name_pos != std::string::npos);
+        const size_t element_pos = name_pos + std::strlen("facet_label");
+        const size_t usage_pos = element_pos + sizeof(uint32_t);
+        const size_t value_type_pos = usage_pos + sizeof(uint32_t);
+
+        auto load_with = [&](size_t pos, auto value) {
+            std::string corrupted = str;
+            std::memcpy(corrupted.data() + pos, &value, sizeof(value));
+            std::stringstream input(corrupted);
+            return io::load_mesh_lgm<SurfaceMesh<Scalar, Index>>(input);
+        };
+        REQUIRE_NOTHROW(load_with(element_pos, uint32_t(AttributeElement::Facet)));
+        for (uint32_t element : {0u, 3u, 64u, 0xffffffffu}) {
+            LA_REQUIRE_THROWS_WITH(
+                load_with(element_pos, element),
+                fmt::format("Invalid .lgm file: unknown attribute element {}", element));
+        }
+        for (uint32_t usage : {0u, 6u, 1u << 13, 0xffffffffu}) {
+            LA_REQUIRE_THROWS_WITH(
+                load_with(usage_pos, usage),
+                fmt::format("Invalid .lgm file: unknown attribute usage {}", usage));
+        }
+        for (uint8_t value_type : {uint8_t(100), uint8_t(255)}) {
+            LA_REQUIRE_THROWS_WITH(
+                load_with(value_type_pos, value_type),
+                fmt::format("Invalid .lgm file: unknown attribute value type {}", value_type));
+        }
+    }
+}
+
+TEST_CASE("io/lgm empty", "[io][lgm]")
+{
+    using namespace lagrange;
+
+    SurfaceMesh32f mesh;
+    std::stringstream data;
+    io::save_mesh_lgm(data, mesh);
+    auto mesh2 = io::load_mesh_lgm<SurfaceMesh32f>(data);
+    REQUIRE(mesh2.get_num_vertices() == 0);
+    REQUIRE(mesh2.get_num_facets() == 0);
+}
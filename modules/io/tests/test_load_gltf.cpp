@@ -9,16 +9,161 @@
  * OF ANY KIND, either express or implied. See the License for the specific language
  * governing permissions and limitations under the License.
  */
+#include <lagrange/Attribute.h>
 #include <lagrange/attribute_names.h>
+#include <lagrange/io/internal/load_gltf.h>
 #include <lagrange/io/load_mesh_gltf.h>
 #include <lagrange/io/load_simple_scene_gltf.h>
 #include <lagrange/io/save_simple_scene_gltf.h>
 #include <lagrange/mesh_cleanup/remove_topologically_degenerate_facets.h>
+#include <lagrange/scene/Scene.h>
 #include <lagrange/scene/simple_scene_convert.h>
 #include <lagrange/testing/common.h>
+#include <lagrange/utils/assert.h>
+
+#include <tiny_gltf.h>
+
+#ifdef LAGRANGE_WITH_DRACO
+    #include <draco/compression/encode.h>
+    #include <draco/mesh/mesh.h>
+#endif
+
+#include <array>
+#include <cstring>
+#include <initializer_list>
 
 using namespace lagrange;
 
+namespace {
+
+/// Appends values to a binary glTF buffer.
+template <typename T>
+void append_values(std::vector<unsigned char>& bin, std::initializer_list<T> values)
+{
+    for (T x : values) {
+        const auto* bytes = reinterpret_cast<const unsigned char*>(&x);
+        bin.insert(bin.end(), bytes, bytes + sizeof(T));
+    }
+}
+
+/// Builds a single triangle glTF document from raw buffer views, accessors and primitive
+/// attributes, using accessor 0 for the facet indices.
+std::string make_triangle_json(
+    size_t buffer_size,
+    const std::string& buffer_views,
+    const std::string& accessors,
+    const std::string& attributes)
+{
+    return R"({"asset":{"version":"2.0"},"scene":0,"scenes":[{"nodes":[0]}],)"
+           R"("nodes":[{"mesh":0}],"meshes":[{"primitives":[{"attributes":{)" +
+           attributes + R"(},"indices":0}]}],"buffers":[{"byteLength":)" +
+           std::to_string(buffer_size) + R"(}],"bufferViews":[)" + buffer_views +
+           R"(],"accessors":[)" + accessors + "]}";
+}
+
+/// Packs a glTF document and its binary buffer into a GLB container.
+std::string make_glb(std::string json, std::vector<unsigned char> bin)
+{
+    json.resize((json.size() + 3) / 4 * 4, ' ');
+    bin.resize((bin.size() + 3) / 4 * 4, 0);
+
+    std::string glb;
+    auto append_u32 = [&](uint32_t x) { glb.append(reinterpret_cast<const char*>(&x), 4); };
+    append_u32(0x46546C67); // "glTF"
+    append_u32(2);
+    append_u32(static_cast<uint32_t>(12 + 8 + json.size() + 8 + bin.size()));
+    append_u32(static_cast<uint32_t>(json.size()));
+    append_u32(0x4E4F534A); // "JSON"
+    glb += json;
+    append_u32(static_cast<uint32_t>(bin.size()));
+    append_u32(0x004E4942); // "BIN"
+    glb.append(reinterpret_cast<const char*>(bin.data()), bin.size());
+    return glb;
+}
+
+/// Loads a GLB through a temporary file, so that it is parsed from a file mapping.
+scene::Scene32f load_glb(const std::string& glb, std::shared_ptr<tinygltf::Model>& model)
+{
+    const fs::path path = fs::temp_directory_path() / "lagrange_test_load_gltf.glb";
+    {
+        fs::ofstream out(path, std::ios::binary);
+        out.write(glb.data(), glb.size());
+    }
+    try {
+        model = io::internal::load_tinygltf(path);
+    } catch (...) {
+        fs::remove(path);
+        throw;
+    }
+    fs::remove(path);
+    return io::internal::load_scene_gltf<scene::Scene32f>(model);
+}
+
+/// Encodes vertex data with the EXT_meshopt_compression attribute codec (version 0). Every group
+/// of 16 byte deltas is stored uncompressed, which is valid but keeps the encoder trivial. Only
+/// supports up to 16 vertices, i.e. a single vertex block with a single byte group per channel.
+std::vector<unsigned char> encode_meshopt_vertices(
+    const std::vector<unsigned char>& vertices,
+    size_t vertex_size)
+{
+    constexpr size_t group_size = 16;
+    constexpr size_t tail_size = 32;
+    const size_t num_vertices = vertices.size() / vertex_size;
+    la_runtime_assert(num_vertices <= group_size && vertex_size <= tail_size);
+
+    std::vector<unsigned char> data = {0xa0};
+    for (size_t k = 0; k < vertex_size; ++k) {
+        data.push_back(0x03); // Group header: 8 bits per delta.
+        unsigned char previous = vertices[k];
+        for (size_t i = 0; i < group_size; ++i) {
+            const unsigned char value = i < num_vertices ? vertices[i * vertex_size + k] : previous;
+            const auto delta = static_cast<unsigned char>(value - previous);
+            data.push_back(static_cast<unsigned char>((delta << 1) ^ (delta & 0x80 ? 0xff : 0)));
+            previous = value;
+        }
+    }
+    // The tail holds the first vertex, used as the starting point of the deltas.
+    data.resize(data.size() + tail_size - vertex_size, 0);
+    data.insert(data.end(), vertices.begin(), vertices.begin() + vertex_size);
+    return data;
+}
+
+#ifdef LAGRANGE_WITH_DRACO
+/// Compresses a single triangle with Draco. Positions are stored in the attribute with unique id 0.
+std::vector<unsigned char> encode_draco_triangle(const std::array<float, 9>& positions)
+{
+    draco::Mesh mesh;
+    mesh.set_num_points(3);
+    mesh.SetNumFaces(1);
+    mesh.SetFace(
+        draco::FaceIndex(0),
+        {draco::PointIndex(0), draco::PointIndex(1), draco::PointIndex(2)});
+    draco::GeometryAttribute attribute;
+    attribute.Init(draco::GeometryAttribute::POSITION, nullptr, 3, draco::DT_FLOAT32, false, 12, 0);
+    draco::PointAttribute* point_attribute = mesh.attribute(mesh.AddAttribute(attribute, true, 3));
+    la_runtime_assert(point_attribute->unique_id() == 0);
+    for (uint32_t i = 0; i < 3; ++i) {
+        point_attribute->SetAttributeValue(draco::AttributeValueIndex(i), positions.data() + 3 * i);
+    }
+
+    draco::Encoder encoder;
+    draco::EncoderBuffer buffer;
+    la_runtime_assert(encoder.EncodeMeshToBuffer(mesh, &buffer).ok());
+    return std::vector<unsigned char>(buffer.data(), buffer.data() + buffer.size());
+}
+#endif
+
+bool is_in_buffer(const tinygltf::Model& model, const void* ptr)
+{
+    const auto* p = static_cast<const unsigned char*>(ptr);
+    for (const auto& buffer : model.buffers) {
+        if (p >= buffer.data.data() && p < buffer.data.data() + buffer.data.size()) return true;
+    }
+    return false;
+}
+
+} // namespace
+
 // this file is a single gltf with embedded buffers
 TEST_CASE("load_mesh_gltf", "[io]")
 {
@@ -157,3 +302,265 @@ TEST_CASE("load_gltf_point_cloud", "[io][gltf]")
         lagrange::io::load_simple_scene_gltf<lagrange::scene::SimpleScene<Scalar, Index>>(ss);
     REQUIRE(scene2.get_num_meshes() == 1);
 }
+
+TEST_CASE("load_scene_gltf_release_images", "[io][gltf]")
+{
+    const auto path = testing::get_data_path("open/io/avocado/Avocado.gltf");
+    auto model = io::internal::load_tinygltf(path);
+    REQUIRE(!model->images.empty());
+    for (const auto& image : model->images) {
+        REQUIRE(!image.image.empty());
+    }
+
+    SECTION("Eager")
+    {
+        auto scene = io::internal::load_scene_gltf<scene::Scene32f>(model);
+        REQUIRE(scene.images.size() == model->images.size());
+        for (size_t i = 0; i < scene.images.size(); ++i) {
+            REQUIRE(scene.images[i].image.width > 0);
+            REQUIRE(model->images[i].image.empty());
+            REQUIRE(model->images[i].image.capacity() == 0);
+        }
+    }
+
+    SECTION("Lazy")
+    {
+        io::LoadOptions options;
+        options.lazy_images = true;
+        auto scene = io::internal::load_scene_gltf<scene::Scene32f>(model, options);
+        REQUIRE(scene.images.size() == model->images.size());
+        for (size_t i = 0; i < scene.images.size(); ++i) {
+            REQUIRE(scene.images[i].lazy_image != nullptr);
+            REQUIRE(!model->images[i].image.empty());
+        }
+    }
+}
+
+TEST_CASE("load_gltf_accessors", "[io][gltf]")
+{
+    using Scalar = float;
+    using Index = uint32_t;
+    std::shared_ptr<tinygltf::Model> model;
+
+    SECTION("Tightly packed")
+    {
+        std::vector<unsigned char> bin;
+        append_values<Index>(bin, {0, 1, 2});
+        append_values<Scalar>(bin, {0, 0, 0, 1, 0, 0, 0, 1, 0});
+        append_values<Scalar>(bin, {0, 0, 1, 0, 0, 1, 0, 0, 1});
+        const std::string json = make_triangle_json(
+            bin.size(),
+            R"({"buffer":0,"byteOffset":0,"byteLength":12},)"
+            R"({"buffer":0,"byteOffset":12,"byteLength":36},)"
+            R"({"buffer":0,"byteOffset":48,"byteLength":36})",
+            R"({"bufferView":0,"componentType":5125,"count":3,"type":"SCALAR"},)"
+            R"({"bufferView":1,"componentType":5126,"count":3,"type":"VEC3"},)"
+            R"({"bufferView":2,"componentType":5126,"count":3,"type":"VEC3"})",
+            R"("POSITION":1,"NORMAL":2)");
+        auto scene = load_glb(make_glb(json, bin), model);
+        REQUIRE(scene.meshes.size() == 1);
+        auto& mesh = scene.meshes[0];
+        REQUIRE(mesh.get_num_vertices() == 3);
+        REQUIRE(mesh.get_num_facets() == 1);
+
+        // Positions, facets and attributes are wrapped from the parsed glTF buffer.
+        const auto& normals = mesh.get_attribute<Scalar>("normal");
+        REQUIRE(mesh.get_vertex_to_position().is_external());
+        REQUIRE(mesh.get_corner_to_vertex().is_external());
+        REQUIRE(normals.is_external());
+        REQUIRE(is_in_buffer(*model, mesh.get_vertex_to_position().get_all().data()));
+        REQUIRE(is_in_buffer(*model, mesh.get_corner_to_vertex().get_all().data()));
+        REQUIRE(is_in_buffer(*model, normals.get_all().data()));
+        REQUIRE(mesh.get_position(1)[0] == 1);
+        REQUIRE(normals.get(2, 2) == 1);
+
+        // Writing to a wrapped buffer makes a copy, and leaves the glTF buffer untouched.
+        mesh.ref_position(1)[0] = 2;
+        mesh.ref_attribute<Scalar>("normal").ref(2, 2) = -1;
+        REQUIRE(!mesh.get_vertex_to_position().is_external());
+        REQUIRE(!mesh.get_attribute<Scalar>("normal").is_external());
+        REQUIRE(!is_in_buffer(*model, mesh.get_vertex_to_position().get_all().data()));
+        REQUIRE(mesh.get_position(1)[0] == 2);
+        REQUIRE(mesh.get_attribute<Scalar>("normal").get(2, 2) == -1);
+
+        Scalar x;
+        std::memcpy(&x, model->buffers[0].data.data() + 24, sizeof(Scalar));
+        REQUIRE(x == 1);
+        std::memcpy(&x, model->buffers[0].data.data() + 80, sizeof(Scalar));
+        REQUIRE(x == 1);
+
+        // Wrapped buffers can also grow.
+        mesh.add_triangle(0, 2, 1);
+        REQUIRE(!mesh.get_corner_to_vertex().is_external());
+        REQUIRE(mesh.get_num_facets() == 2);
+    }
+
+    SECTION("Strided")
+    {
+        // Positions and normals are interleaved in a single buffer view.
+        std::vector<unsigned char> bin;
+        append_values<Index>(bin, {0, 1, 2});
+        append_values<Scalar>(bin, {0, 0, 0, 0, 0, 1});
+        append_values<Scalar>(bin, {1, 0, 0, 0, 0, 1});
+        append_values<Scalar>(bin, {0, 1, 0, 0, 0, 1});
+        const std::string json = make_triangle_json(
+            bin.size(),
+            R"({"buffer":0,"byteOffset":0,"byteLength":12},)"
+            R"({"buffer":0,"byteOffset":12,"byteLength":72,"byteStride":24})",
+            R"({"bufferView":0,"componentType":5125,"count":3,"type":"SCALAR"},)"
+            R"({"bufferView":1,"componentType":5126,"count":3,"type":"VEC3"},)"
+            R"({"bufferView":1,"byteOffset":12,"componentType":5126,"count":3,"type":"VEC3"})",
+            R"("POSITION":1,"NORMAL":2)");
+        auto scene = load_glb(make_glb(json, bin), model);
+        REQUIRE(scene.meshes.size() == 1);
+        const auto& mesh = scene.meshes[0];
+        const auto& normals = mesh.get_attribute<Scalar>("normal");
+
+        // Strided data is copied, but indices are still wrapped.
+        REQUIRE(!is_in_buffer(*model, mesh.get_vertex_to_position().get_all().data()));
+        REQUIRE(!is_in_buffer(*model, normals.get_all().data()));
+        REQUIRE(is_in_buffer(*model, mesh.get_corner_to_vertex().get_all().data()));
+        for (Index v = 0; v < 3; ++v) {
+            REQUIRE(mesh.get_position(v)[0] == (v == 1 ? 1 : 0));
+            REQUIRE(mesh.get_position(v)[1] == (v == 2 ? 1 : 0));
+            REQUIRE(mesh.get_position(v)[2] == 0);
+            REQUIRE(normals.get(v, 0) == 0);
+            REQUIRE(normals.get(v, 1) == 0);
+            REQUIRE(normals.get(v, 2) == 1);
+        }
+    }
+
+    SECTION("Normalized")
+    {
+        // Quantized positions, stored as normalized unsigned shorts.
+        std::vector<unsigned char> bin;
+        append_values<Index>(bin, {0, 1, 2});
+        append_values<uint16_t>(bin, {0, 0, 0, 65535, 0, 0, 0, 65535, 0});
+        const std::string json = make_triangle_json(
+            bin.size(),
+            R"({"buffer":0,"byteOffset":0,"byteLength":12},)"
+            R"({"buffer":0,"byteOffset":12,"byteLength":18})",
+            R"({"bufferView":0,"componentType":5125,"count":3,"type":"SCALAR"},)"
+            R"({"bufferView":1,"componentType":5123,"normalized":true,"count":3,"type":"VEC3"})",
+            R"("POSITION":1)");
+        auto scene = load_glb(make_glb(json, bin), model);
+        REQUIRE(scene.meshes.size() == 1);
+        const auto& mesh = scene.meshes[0];
+        REQUIRE(mesh.get_position(0)[0] == 0);
+        REQUIRE(mesh.get_position(1)[0] == 1);
+        REQUIRE(mesh.get_position(1)[1] == 0);
+        REQUIRE(mesh.get_position(2)[1] == 1);
+    }
+
+    SECTION("Out of bounds")
+    {
+        // The position accessor reads past the end of the buffer.
+        std::vector<unsigned char> bin;
+        append_values<Index>(bin, {0, 1, 2});
+        append_values<Scalar>(bin, {0, 0, 0, 1, 0, 0, 0, 1, 0});
+        const std::string json = make_triangle_json(
+            bin.size(),
+            R"({"buffer":0,"byteOffset":0,"byteLength":12},)"
+            R"({"buffer":0,"byteOffset":12,"byteLength":36})",
+            R"({"bufferView":0,"componentType":5125,"count":3,"type":"SCALAR"},)"
+            R"({"bufferView":1,"byteOffset":12,"componentType":5126,"count":3,"type":"VEC3"})",
+            R"("POSITION":1)");
+        REQUIRE_THROWS(load_glb(make_glb(json, bin), model));
+    }
+}
+
+TEST_CASE("load_gltf_meshopt", "[io][gltf]")
+{
+    using Scalar = float;
+    using Index = uint32_t;
+    std::shared_ptr<tinygltf::Model> model;
+
+    // Positions are compressed with EXT_meshopt_compression. The fallback buffer view is filled
+    // with zeros, so that decoded and fallback positions can be told apart.
+    std::vector<unsigned char> positions;
+    append_values<Scalar>(positions, {0, 0, 0, 1, 0, 0, 0, 1, 0});
+    const std::vector<unsigned char> compressed = encode_meshopt_vertices(positions, 12);
+
+    std::vector<unsigned char> bin;
+    append_values<Index>(bin, {0, 1, 2});
+    bin.resize(bin.size() + positions.size(), 0);
+    bin.insert(bin.end(), compressed.begin(), compressed.end());
+    const std::string json = make_triangle_json(
+        bin.size(),
+        R"({"buffer":0,"byteOffset":0,"byteLength":12},)"
+        R"({"buffer":0,"byteOffset":12,"byteLength":36,"byteStride":12,"extensions":{)"
+        R"("EXT_meshopt_compression":{"buffer":0,"byteOffset":48,"byteLength":)" +
+            std::to_string(compressed.size()) +
+            R"(,"byteStride":12,"count":3,"mode":"ATTRIBUTES"}}})",
+        R"({"bufferView":0,"componentType":5125,"count":3,"type":"SCALAR"},)"
+        R"({"bufferView":1,"componentType":5126,"count":3,"type":"VEC3"})",
+        R"("POSITION":1)");
+    auto scene = load_glb(make_glb(json, bin), model);
+    REQUIRE(scene.meshes.size() == 1);
+    const auto& mesh = scene.meshes[0];
+    REQUIRE(mesh.get_num_vertices() == 3);
+    REQUIRE(mesh.get_num_facets() == 1);
+
+#ifdef LAGRANGE_WITH_MESHOPTIMIZER
+    for (Index v = 0; v < 3; ++v) {
+        REQUIRE(mesh.get_position(v)[0] == (v == 1 ? 1 : 0));
+        REQUIRE(mesh.get_position(v)[1] == (v == 2 ? 1 : 0));
+        REQUIRE(mesh.get_position(v)[2] == 0);
+    }
+#else
+    // The extension is optional, so the uncompressed fallback is used instead.
+    for (Index v = 0; v < 3; ++v) {
+        REQUIRE(mesh.get_position(v)[0] == 0);
+        REQUIRE(mesh.get_position(v)[1] == 0);
+    }
+#endif
+}
+
+#ifdef LAGRANGE_WITH_DRACO
+TEST_CASE("load_gltf_draco_shared_accessors", "[io][gltf]")
+{
+    using Index = uint32_t;
+    std::shared_ptr<tinygltf::Model> model;
+
+    // Two Draco primitives, at different heights, share their index and position accessors.
+    std::vector<unsigned char> bin = encode_draco_triangle({0, 0, 0, 1, 0, 0, 0, 1, 0});
+    const size_t size0 = bin.size();
+    bin.resize((bin.size() + 3) / 4 * 4, 0);
+    const size_t offset1 = bin.size();
+    const std::vector<unsigned char> second = encode_draco_triangle({0, 0, 1, 1, 0, 1, 0, 1, 1});
+    bin.insert(bin.end(), second.begin(), second.end());
+
+    auto make_mesh = [](int view) {
+        return R"({"primitives":[{"attributes":{"POSITION":1},"indices":0,"extensions":{)"
+               R"("KHR_draco_mesh_compression":{"bufferView":)" +
+               std::to_string(view) + R"(,"attributes":{"POSITION":0}}}}]})";
+    };
+    const std::string json =
+        R"({"asset":{"version":"2.0"},"scene":0,"scenes":[{"nodes":[0,1]}],)"
+        R"("nodes":[{"mesh":0},{"mesh":1}],"meshes":[)" +
+        make_mesh(0) + "," + make_mesh(1) + R"(],"buffers":[{"byteLength":)" +
+        std::to_string(bin.size()) + R"(}],"bufferViews":[{"buffer":0,"byteLength":)" +
+        std::to_string(size0) + R"(},{"buffer":0,"byteOffset":)" + std::to_string(offset1) +
+        R"(,"byteLength":)" + std::to_string(second.size()) + "}]," +
+        R"("accessors":[{"componentType":5125,"count":3,"type":"SCALAR"},)"
+        R"({"componentType":5126,"count":3,"type":"VEC3"}],)"
+        R"("extensionsUsed":["KHR_draco_mesh_compression"],)"
+        R"("extensionsRequired":["KHR_draco_mesh_compression"]})";
+    auto scene = load_glb(make_glb(json, bin), model);
+
+    // Each primitive gets its own decoded accessors.
+    REQUIRE(scene.meshes.size() == 2);
+    for (size_t i = 0; i < 2; ++i) {
+        const auto& mesh = scene.meshes[i];
+        REQUIRE(mesh.get_num_vertices() == 3);
+        REQUIRE(mesh.get_num_facets() == 1);
+        for (Index v = 0; v < 3; ++v) {
+            REQUIRE(mesh.get_position(v)[2] == static_cast<float>(i));
+        }
+    }
+    const auto& primitive0 = model->meshes[0].primitives[0];
+    const auto& primitive1 = model->meshes[1].primitives[0];
+    REQUIRE(primitive0.indices != primitive1.indices);
+    REQUIRE(primitive0.attributes.at("POSITION") != primitive1.attributes.at("POSITION"));
+}
+#endif
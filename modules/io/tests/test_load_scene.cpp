@@ -14,6 +14,7 @@
 #ifdef LAGRANGE_WITH_ASSIMP
     #include <lagrange/io/load_scene_assimp.h>
 #endif
+#include <lagrange/AttributeValueType.h>
 #include <lagrange/IndexedAttribute.h>
 #include <lagrange/Logger.h>
 #include <lagrange/attribute_names.h>
@@ -29,6 +30,8 @@
 
 #include <catch2/catch_approx.hpp>
 
+#include <sstream>
+
 using namespace lagrange;
 
 template <typename MeshType>
@@ -207,6 +210,109 @@ TEST_CASE("load_scene_avocado", "[io]")
     }
 }
 
+TEST_CASE("load_scene_order", "[io]")
+{
+    // Meshes and images are converted concurrently, but must be added to the scene in the same
+    // order as a serial loader would.
+    using SceneType = scene::Scene32f;
+    constexpr size_t num_elements = 8;
+
+    SceneType expected;
+    for (size_t i = 0; i < num_elements; ++i) {
+        // Mesh i is made of i + 1 disjoint triangles.
+        SceneType::MeshType mesh;
+        for (size_t j = 0; j <= i; ++j) {
+            const float x = static_cast<float>(j);
+            mesh.add_vertex({x, 0, 0});
+            mesh.add_vertex({x + 1, 0, 0});
+            mesh.add_vertex({x, 1, 0});
+            const auto v = mesh.get_num_vertices();
+            mesh.add_triangle(v - 3, v - 2, v - 1);
+        }
+        expected.meshes.push_back(std::move(mesh));
+
+        // Image i has a width of i + 1 pixels and a uniform value of 10 * i.
+        scene::ImageExperimental image;
+        image.name = fmt::format("image_{}", i);
+        image.image.width = i + 1;
+        image.image.height = 2;
+        image.image.num_channels = 4;
+        image.image.element_type = AttributeValueType::e_uint8_t;
+        image.image.data.assign(image.image.width * image.image.height * 4, uint8_t(10 * i));
+        expected.images.push_back(std::move(image));
+
+        scene::Texture texture;
+        texture.image = static_cast<scene::ElementId>(i);
+        expected.textures.push_back(std::move(texture));
+
+        scene::MaterialExperimental material;
+        material.name = fmt::format("material_{}", i);
+        material.base_color_texture.index = static_cast<scene::ElementId>(i);
+        expected.materials.push_back(std::move(material));
+
+        scene::Node node;
+        node.name = fmt::format("node_{}", i);
+        node.meshes.push_back(
+            {static_cast<scene::ElementId>(i), {static_cast<scene::ElementId>(i)}});
+        expected.root_nodes.push_back(static_cast<scene::ElementId>(expected.nodes.size()));
+        expected.nodes.push_back(std::move(node));
+    }
+
+    std::stringstream data;
+    io::save_scene_gltf(data, expected);
+    const std::string encoded = data.str();
+
+    auto check_order = [&](const SceneType& scene, const SceneType& reference) {
+        REQUIRE(scene.meshes.size() == reference.meshes.size());
+        for (size_t i = 0; i < scene.meshes.size(); ++i) {
+            REQUIRE(scene.meshes[i].get_num_vertices() == reference.meshes[i].get_num_vertices());
+            REQUIRE(scene.meshes[i].get_num_facets() == reference.meshes[i].get_num_facets());
+        }
+        REQUIRE(scene.images.size() == reference.images.size());
+        for (size_t i = 0; i < scene.images.size(); ++i) {
+            REQUIRE(scene.images[i].name == reference.images[i].name);
+            REQUIRE(scene.images[i].image.width == reference.images[i].image.width);
+            REQUIRE(scene.images[i].image.height == reference.images[i].image.height);
+            REQUIRE(!scene.images[i].image.data.empty());
+            REQUIRE(scene.images[i].image.data[0] == reference.images[i].image.data[0]);
+        }
+        REQUIRE(scene.textures.size() == reference.textures.size());
+        for (size_t i = 0; i < scene.textures.size(); ++i) {
+            REQUIRE(scene.textures[i].image == reference.textures[i].image);
+        }
+        REQUIRE(scene.materials.size() == reference.materials.size());
+        for (size_t i = 0; i < scene.materials.size(); ++i) {
+            REQUIRE(scene.materials[i].name == reference.materials[i].name);
+            REQUIRE(
+                scene.materials[i].base_color_texture.index ==
+                reference.materials[i].base_color_texture.index);
+        }
+    };
+
+    SECTION("gltf")
+    {
+        for (int k = 0; k < 5; ++k) {
+            std::stringstream input(encoded);
+            check_order(io::load_scene_gltf<SceneType>(input), expected);
+        }
+    }
+#ifdef LAGRANGE_WITH_ASSIMP
+    SECTION("assimp")
+    {
+        // Assimp may reorder elements compared to the glTF file. Repeated loads must match the
+        // first one.
+        std::stringstream first_input(encoded);
+        const auto first = io::load_scene_assimp<SceneType>(first_input);
+        REQUIRE(first.meshes.size() == num_elements);
+        REQUIRE(first.images.size() == num_elements);
+        for (int k = 0; k < 5; ++k) {
+            std::stringstream input(encoded);
+            check_order(io::load_scene_assimp<SceneType>(input), first);
+        }
+    }
+#endif
+}
+
 TEST_CASE("load_scene_cameras", "[io]")
 {
     using SceneType = scene::Scene32f;
@@ -9,15 +9,59 @@
  * OF ANY KIND, either express or implied. See the License for the specific language
  * governing permissions and limitations under the License.
  */
+#include <lagrange/attribute_names.h>
+#include <lagrange/io/internal/load_obj.h>
 #include <lagrange/io/load_mesh_obj.h>
 #include <lagrange/io/save_mesh_obj.h>
 #include <lagrange/testing/check_mesh.h>
 #include <lagrange/testing/common.h>
 #include <lagrange/testing/create_test_mesh.h>
 #include <lagrange/testing/equivalence_check.h>
+#include <lagrange/utils/invalid.h>
+#include <lagrange/utils/scope_guard.h>
 
 #include <catch2/catch_approx.hpp>
 
+#include <algorithm>
+#include <sstream>
+
+namespace {
+
+///
+/// Builds an .obj file with objects, groups and materials, relative indices and mixed facet sizes.
+/// Coordinates are exactly representable as floats, so that tinyobj yields the same values.
+///
+std::string make_chunked_obj()
+{
+    std::string obj = "mtllib test.mtl\n";
+    for (int i = 0; i < 12; ++i) {
+        if (i % 4 == 0) obj += fmt::format("o object_{}\n", i / 4);
+        if (i % 3 == 1) obj += fmt::format("g group_{} part\n", i);
+        if (i % 2 == 0) obj += fmt::format("usemtl {}\n", i % 4 == 0 ? "red" : "blue");
+        for (int k = 0; k < 4; ++k) {
+            obj += fmt::format("v {} {} {}\n", 0.25 * i, 0.5 * k, 0.25 * (k % 2));
+            obj += fmt::format("vt {} {}\n", 0.25 * k, 0.5 * i);
+            obj += fmt::format("vn 0 0 {}\n", k % 2 ? 1 : -1);
+        }
+        // Relative indices refer to the vertices above, which end up in earlier chunks when
+        // chunks are small. Absolute indices refer to the first vertices of the file.
+        const int n = 4 * (i + 1);
+        obj += "f -4/-4/-4 -3/-3/-3 -2/-2/-2 -1/-1/-1\n";
+        obj += fmt::format("f 1/1/1 {0}/{0}/{0} -1/-1/-1\n", n - 2);
+        obj += "f -4//-4 -2//-2 -1//-1\n";
+    }
+    return obj;
+}
+
+template <typename T>
+void require_same_values(lagrange::span<const T> a, lagrange::span<const T> b)
+{
+    REQUIRE(a.size() == b.size());
+    REQUIRE(std::equal(a.begin(), a.end(), b.begin()));
+}
+
+} // namespace
+
 TEST_CASE("Grenade_H", "[mesh][io]" LA_CORP_FLAG)
 {
     using namespace lagrange;
@@ -63,3 +107,120 @@ TEST_CASE("io/obj empty", "[io][obj]")
     testing::check_mesh(mesh2);
     testing::ensure_approx_equivalent_mesh(mesh, mesh2);
 }
+
+TEST_CASE("io/obj polygons", "[io][obj]")
+{
+    using namespace lagrange;
+    using Scalar = double;
+    using Index = uint32_t;
+
+    // Mixed facet sizes, relative indices, missing uv indices and multiple objects.
+    std::stringstream data;
+    data << "v 0 0 0\n"
+            "v 1 0 0\n"
+            "v 1 1 0\n"
+            "v 0 1 0\n"
+            "v 0.5 0.5 1e-1\n"
+            "vt 0 0\n"
+            "vt 1 0\n"
+            "vt 1 1\n"
+            "o first\n"
+            "f 1/1 2/2 3/3 4\n"
+            "g second\n"
+            "f -5 -4 -1\n"
+            "f 2 3 5\n";
+
+    SECTION("polygons")
+    {
+        auto mesh = io::load_mesh_obj<SurfaceMesh<Scalar, Index>>(data);
+        testing::check_mesh(mesh);
+        REQUIRE(mesh.get_num_vertices() == 5);
+        REQUIRE(mesh.get_num_facets() == 3);
+        REQUIRE(mesh.get_facet_size(0) == 4);
+        REQUIRE(mesh.get_facet_size(1) == 3);
+        REQUIRE(mesh.get_position(4)[2] == Catch::Approx(0.1));
+
+        auto f1 = mesh.get_facet_vertices(1);
+        REQUIRE(f1[0] == 0);
+        REQUIRE(f1[1] == 1);
+        REQUIRE(f1[2] == 4);
+
+        auto& object_ids = mesh.get_attribute<Index>(AttributeName::object_id);
+        REQUIRE(object_ids.get(0) == 0);
+        REQUIRE(object_ids.get(1) == 1);
+        REQUIRE(object_ids.get(2) == 1);
+
+        auto& uv = mesh.get_indexed_attribute<Scalar>(AttributeName::texcoord);
+        REQUIRE(uv.values().get_num_elements() == 3);
+        REQUIRE(uv.indices().get(2) == 2);
+        REQUIRE(uv.indices().get(3) == invalid<Index>());
+    }
+
+    SECTION("triangulate")
+    {
+        io::LoadOptions options;
+        options.triangulate = true;
+        auto mesh = io::load_mesh_obj<SurfaceMesh<Scalar, Index>>(data, options);
+        testing::check_mesh(mesh);
+        REQUIRE(mesh.is_triangle_mesh());
+        REQUIRE(mesh.get_num_facets() == 4);
+        auto& object_ids = mesh.get_attribute<Index>(AttributeName::object_id);
+        REQUIRE(object_ids.get(1) == 0);
+        REQUIRE(object_ids.get(2) == 1);
+    }
+}
+
+TEST_CASE("io/obj chunks", "[io][obj]")
+{
+    using namespace lagrange;
+    using Scalar = float;
+    using Index = uint32_t;
+    using MeshType = SurfaceMesh<Scalar, Index>;
+    using SignedIndex = MeshType::SignedIndex;
+
+    const std::string obj = make_chunked_obj();
+    const std::string mtl = "newmtl red\nKd 1 0 0\nnewmtl blue\nKd 0 0 1\n";
+    io::LoadOptions options;
+
+    // Reference mesh loaded with tinyobj.
+    std::istringstream ref_obj(obj);
+    std::istringstream ref_mtl(mtl);
+    const auto expected = io::internal::load_mesh_obj<MeshType>(
+        io::internal::load_obj(ref_obj, ref_mtl, options),
+        options);
+    REQUIRE(expected.get_num_facets() == 36);
+
+    // Small chunks split the file at every kind of statement, down to one line per chunk.
+    auto guard = make_scope_guard([]() noexcept { io::internal::set_obj_chunk_size(0); });
+    for (size_t chunk_size : {1, 7, 16, 64, 251, 1000}) {
+        io::internal::set_obj_chunk_size(chunk_size);
+        std::istringstream obj_stream(obj);
+        std::istringstream mtl_stream(mtl);
+        auto result = io::internal::load_mesh_obj<MeshType>(obj_stream, mtl_stream, options);
+        REQUIRE(result.success);
+        const auto& mesh = result.mesh;
+        testing::check_mesh(mesh);
+
+        require_same_values(
+            mesh.get_vertex_to_position().get_all(),
+            expected.get_vertex_to_position().get_all());
+        require_same_values(
+            mesh.get_corner_to_vertex().get_all(),
+            expected.get_corner_to_vertex().get_all());
+        for (Index f = 0; f < mesh.get_num_facets(); ++f) {
+            REQUIRE(mesh.get_facet_size(f) == expected.get_facet_size(f));
+        }
+        for (auto name : {AttributeName::texcoord, AttributeName::normal}) {
+            const auto& attr = mesh.get_indexed_attribute<Scalar>(name);
+            const auto& expected_attr = expected.get_indexed_attribute<Scalar>(name);
+            require_same_values(attr.values().get_all(), expected_attr.values().get_all());
+            require_same_values(attr.indices().get_all(), expected_attr.indices().get_all());
+        }
+        require_same_values(
+            mesh.get_attribute<Index>(AttributeName::object_id).get_all(),
+            expected.get_attribute<Index>(AttributeName::object_id).get_all());
+        require_same_values(
+            mesh.get_attribute<SignedIndex>(AttributeName::material_id).get_all(),
+            expected.get_attribute<SignedIndex>(AttributeName::material_id).get_all());
+    }
+}
@@ -16,6 +16,9 @@
 #include <lagrange/testing/create_test_mesh.h>
 #include <lagrange/testing/equivalence_check.h>
 
+#include <algorithm>
+#include <array>
+#include <cstring>
 #include <sstream>
 
 TEST_CASE("load_ply", "[io][ply]")
@@ -148,3 +151,194 @@ TEST_CASE("io/ply multiple special attributes", "[io][ply]")
         testing::ensure_approx_equivalent_mesh(mesh, mesh2);
     }
 }
+
+TEST_CASE("io/ply binary hybrid", "[io][ply]")
+{
+    using namespace lagrange;
+    using Scalar = float;
+    using Index = uint32_t;
+
+    SurfaceMesh<Scalar, Index> mesh;
+    mesh.add_vertex({0, 0, 0});
+    mesh.add_vertex({1, 0, 0});
+    mesh.add_vertex({1, 1, 0});
+    mesh.add_vertex({0, 1, 0});
+    mesh.add_vertex({2, 0, 0});
+    mesh.add_vertex({2, 1, 1});
+    mesh.add_triangle(1, 4, 5);
+    mesh.add_quad(0, 1, 2, 3);
+    mesh.add_polygon({1, 5, 2});
+    std::vector<int64_t> facet_ids = {7, -3, 12};
+    mesh.template create_attribute<int64_t>(
+        "facet_ids",
+        AttributeElement::Facet,
+        AttributeUsage::Scalar,
+        1,
+        {facet_ids.data(), facet_ids.size()});
+    std::vector<double> vertex_data(mesh.get_num_vertices() * 2);
+    for (size_t i = 0; i < vertex_data.size(); ++i) vertex_data[i] = 0.5 * double(i);
+    mesh.template create_attribute<double>(
+        "vertex_data",
+        AttributeElement::Vertex,
+        AttributeUsage::Vector,
+        2,
+        {vertex_data.data(), vertex_data.size()});
+
+    io::SaveOptions save_options;
+    save_options.encoding = io::FileEncoding::Binary;
+    save_options.output_attributes = io::SaveOptions::OutputAttributes::All;
+
+    auto check_facets = [&](const SurfaceMesh<Scalar, Index>& mesh2) {
+        REQUIRE(mesh2.get_num_facets() == mesh.get_num_facets());
+        for (Index f = 0; f < mesh.get_num_facets(); ++f) {
+            auto facet = mesh.get_facet_vertices(f);
+            auto facet2 = mesh2.get_facet_vertices(f);
+            REQUIRE(std::equal(facet.begin(), facet.end(), facet2.begin(), facet2.end()));
+        }
+    };
+
+    SECTION("Stream")
+    {
+        std::stringstream data;
+        REQUIRE_NOTHROW(io::save_mesh_ply(data, mesh, save_options));
+        auto mesh2 = io::load_mesh_ply<SurfaceMesh<Scalar, Index>>(data);
+        testing::check_mesh(mesh2);
+        check_facets(mesh2);
+        testing::ensure_approx_equivalent_mesh(mesh, mesh2);
+    }
+
+    SECTION("File")
+    {
+        const fs::path path = fs::temp_directory_path() / "test_binary_hybrid.ply";
+        REQUIRE_NOTHROW(io::save_mesh_ply(path, mesh, save_options));
+        {
+            auto mesh2 = io::load_mesh_ply<SurfaceMesh<Scalar, Index>>(path);
+            testing::check_mesh(mesh2);
+            check_facets(mesh2);
+            testing::ensure_approx_equivalent_mesh(mesh, mesh2);
+
+            // Positions may reference the mapped file, make sure the mesh can still be modified.
+            mesh2.add_vertex({3, 3, 3});
+            REQUIRE(mesh2.get_num_vertices() == mesh.get_num_vertices() + 1);
+            REQUIRE(mesh2.get_position(0)[0] == mesh.get_position(0)[0]);
+        }
+        fs::remove(path);
+    }
+
+    SECTION("File with positions only")
+    {
+        SurfaceMesh<Scalar, Index> positions_only;
+        positions_only.add_vertices(
+            mesh.get_num_vertices(),
+            mesh.get_vertex_to_position().get_all());
+        positions_only.add_triangle(1, 4, 5);
+        positions_only.add_quad(0, 1, 2, 3);
+        positions_only.add_polygon({1, 5, 2});
+
+        const fs::path path = fs::temp_directory_path() / "test_binary_positions_only.ply";
+        REQUIRE_NOTHROW(io::save_mesh_ply(path, positions_only, save_options));
+        {
+            auto mesh2 = io::load_mesh_ply<SurfaceMesh<Scalar, Index>>(path);
+            testing::check_mesh(mesh2);
+            check_facets(mesh2);
+            testing::ensure_approx_equivalent_mesh(positions_only, mesh2);
+
+            // Positions are wrapped from the mapped file without copy.
+            REQUIRE(mesh2.get_vertex_to_position().is_external());
+
+            // Writing to them makes a private copy, leaving the file untouched.
+            mesh2.ref_position(0)[0] = 5;
+            REQUIRE(!mesh2.get_vertex_to_position().is_external());
+            REQUIRE(mesh2.get_position(0)[0] == 5);
+            auto mesh3 = io::load_mesh_ply<SurfaceMesh<Scalar, Index>>(path);
+            REQUIRE(mesh3.get_position(0)[0] == positions_only.get_position(0)[0]);
+        }
+        fs::remove(path);
+    }
+}
+
+TEST_CASE("io/ply binary big endian", "[io][ply]")
+{
+    using namespace lagrange;
+
+    auto swap = [](auto value) {
+        std::array<char, sizeof(value)> bytes;
+        std::memcpy(bytes.data(), &value, sizeof(value));
+        std::reverse(bytes.begin(), bytes.end());
+        return std::string(bytes.data(), bytes.size());
+    };
+
+    std::string data = "ply\n"
+                       "format binary_big_endian 1.0\n"
+                       "element vertex 3\n"
+                       "property float x\n"
+                       "property float y\n"
+                       "property float z\n"
+                       "element face 1\n"
+                       "property list uchar int vertex_indices\n"
+                       "end_header\n";
+    for (float x : {0.f, 0.f, 0.f, 1.f, 0.f, 0.f, 0.f, 1.f, 0.f}) data += swap(x);
+    data += char(3);
+    for (int32_t v : {0, 1, 2}) data += swap(v);
+
+    std::stringstream input(data);
+    auto mesh = io::load_mesh_ply<SurfaceMesh32f>(input);
+    REQUIRE(mesh.get_num_vertices() == 3);
+    REQUIRE(mesh.get_num_facets() == 1);
+    REQUIRE(mesh.get_position(1)[0] == 1.f);
+    REQUIRE(mesh.get_position(2)[1] == 1.f);
+    REQUIRE(mesh.get_facet_vertices(0)[2] == 2);
+}
+
+TEST_CASE("io/ply binary invalid", "[io][ply]")
+{
+    using namespace lagrange;
+
+    auto swap = [](auto value) {
+        std::array<char, sizeof(value)> bytes;
+        std::memcpy(bytes.data(), &value, sizeof(value));
+        std::reverse(bytes.begin(), bytes.end());
+        return std::string(bytes.data(), bytes.size());
+    };
+
+    auto make_ply = [&](std::string_view num_vertices, std::array<int32_t, 3> facet) {
+        std::string data = fmt::format(
+            "ply\n"
+            "format binary_big_endian 1.0\n"
+            "element vertex {}\n"
+            "property float x\n"
+            "property float y\n"
+            "property float z\n"
+            "element face 1\n"
+            "property list uchar int vertex_indices\n"
+            "end_header\n",
+            num_vertices);
+        for (float x : {0.f, 0.f, 0.f, 1.f, 0.f, 0.f, 0.f, 1.f, 0.f}) data += swap(x);
+        data += char(3);
+        for (int32_t v : facet) data += swap(v);
+        return data;
+    };
+
+    SECTION("Valid")
+    {
+        std::stringstream input(make_ply("3", {0, 1, 2}));
+        auto mesh = io::load_mesh_ply<SurfaceMesh32f>(input);
+        REQUIRE(mesh.get_num_facets() == 1);
+    }
+
+    SECTION("Invalid element count")
+    {
+        for (auto count : {"three", "3x", "-3", "99999999999999999999999"}) {
+            std::stringstream input(make_ply(count, {0, 1, 2}));
+            LA_REQUIRE_THROWS(io::load_mesh_ply<SurfaceMesh32f>(input));
+        }
+    }
+
+    SECTION("Out-of-range facet indices")
+    {
+        for (auto facet : {std::array<int32_t, 3>{0, 1, 3}, std::array<int32_t, 3>{-1, 1, 2}}) {
+            std::stringstream input(make_ply("3", facet));
+            LA_REQUIRE_THROWS(io::load_mesh_ply<SurfaceMesh32f>(input));
+        }
+    }
+}
@@ -27,8 +27,13 @@
 #include <lagrange/io/save_mesh_obj.h>
 #include <lagrange/io/save_mesh_ply.h>
 #include <lagrange/map_attribute.h>
+#include <lagrange/quantize_attribute.h>
+#include <lagrange/reorder_mesh.h>
 #include <lagrange/unify_index_buffer.h>
 
+#include <catch2/catch_approx.hpp>
+
+#include <algorithm>
 #include <sstream>
 
 using namespace lagrange;
@@ -309,3 +314,109 @@ TEST_CASE("save_mesh_indexed_attributes", "[io]")
         testing::ensure_approx_equivalent_usage<AttributeUsage::Normal>(cube, loaded);
     }
 }
+
+TEST_CASE("save_mesh_gltf_reorder", "[io]")
+{
+    auto cube = testing::create_test_cube<double, uint32_t>();
+    using Scalar = decltype(cube)::Scalar;
+    using Index = decltype(cube)::Index;
+    auto normal_id = lagrange::compute_normal(cube, static_cast<Scalar>(M_PI / 4));
+    const Scalar area = compute_mesh_area(cube);
+
+    io::SaveOptions opt;
+    opt.output_attributes = io::SaveOptions::OutputAttributes::SelectedOnly;
+    opt.attribute_conversion_policy = io::SaveOptions::AttributeConversionPolicy::ConvertAsNeeded;
+    opt.selected_attributes = {normal_id};
+
+    for (auto method :
+         {ReorderingMethod::VertexCache,
+          ReorderingMethod::Overdraw,
+          ReorderingMethod::VertexFetch}) {
+        opt.reorder_method = method;
+        std::stringstream buffer;
+        REQUIRE_NOTHROW(io::save_mesh_gltf(buffer, cube, opt));
+        auto loaded = io::load_mesh_gltf<SurfaceMesh32d>(buffer);
+        ensure_attributes_exist(loaded, false, true);
+        REQUIRE(loaded.get_num_facets() == cube.get_num_facets());
+        REQUIRE(compute_mesh_area(loaded) == Catch::Approx(area));
+
+        // Vertices are sorted by first use in the exported index buffer
+        Index max_vertex = 0;
+        for (Index v : loaded.get_corner_to_vertex().get_all()) {
+            REQUIRE(v <= max_vertex + 1);
+            max_vertex = std::max(max_vertex, v);
+        }
+    }
+}
+
+TEST_CASE("save_mesh_gltf_quantized", "[io]")
+{
+    auto cube_indexed = testing::create_test_cube<double, uint32_t>();
+    using Scalar = decltype(cube_indexed)::Scalar;
+    using Index = decltype(cube_indexed)::Index;
+    lagrange::compute_normal<Scalar, Index>(cube_indexed, [](Index) -> bool { return false; });
+    auto cube = unify_index_buffer(cube_indexed);
+    auto normal_id = internal::find_matching_attribute<Scalar>(
+        cube,
+        "",
+        AttributeElement::Vertex,
+        AttributeUsage::Normal,
+        3);
+    REQUIRE(normal_id != invalid_attribute_id());
+    const std::string normal_name(cube.get_attribute_name(normal_id));
+    const auto expected_normals = attribute_matrix_view<Scalar>(cube, normal_name).eval();
+
+    QuantizeAttributeOptions quantize_options;
+    quantize_options.encoding = AttributeEncoding::Octahedral16;
+    quantize_attribute(cube, normal_name, quantize_options);
+    auto uv_id = internal::find_matching_attribute<Scalar>(
+        cube,
+        "",
+        AttributeElement::Vertex,
+        AttributeUsage::UV,
+        2);
+    REQUIRE(uv_id != invalid_attribute_id());
+    quantize_options.encoding = AttributeEncoding::Half;
+    quantize_attribute(cube, std::string(cube.get_attribute_name(uv_id)), quantize_options);
+
+    io::SaveOptions opt;
+    opt.encoding = io::FileEncoding::Binary;
+    std::stringstream buffer;
+    REQUIRE_NOTHROW(io::save_mesh_gltf(buffer, cube, opt));
+    auto loaded = io::load_mesh_gltf<SurfaceMesh32d>(buffer);
+    ensure_attributes_exist(loaded, true, true);
+
+    // Normals are written as normalized 16-bit integers, half precision uvs as floats.
+    auto loaded_normal_id = internal::find_matching_attribute<Scalar>(
+        loaded,
+        "",
+        AttributeElement::Vertex,
+        AttributeUsage::Normal,
+        3);
+    REQUIRE(loaded_normal_id != invalid_attribute_id());
+    auto loaded_normals = matrix_view(loaded.get_attribute<Scalar>(loaded_normal_id));
+    REQUIRE(loaded_normals.rows() == expected_normals.rows());
+    REQUIRE((loaded_normals - expected_normals).cwiseAbs().maxCoeff() < 1e-3);
+}
+
+TEST_CASE("save_mesh_gltf_draco", "[io]")
+{
+    auto cube = testing::create_test_cube<double, uint32_t>();
+    lagrange::compute_normal(cube, static_cast<double>(M_PI / 4));
+    const double area = compute_mesh_area(cube);
+
+    io::SaveOptions opt;
+    opt.encoding = io::FileEncoding::Binary;
+    opt.attribute_conversion_policy = io::SaveOptions::AttributeConversionPolicy::ConvertAsNeeded;
+    opt.geometry_compression = io::SaveOptions::GeometryCompression::Draco;
+    std::stringstream buffer;
+#ifdef LAGRANGE_WITH_DRACO
+    REQUIRE_NOTHROW(io::save_mesh_gltf(buffer, cube, opt));
+    auto loaded = io::load_mesh_gltf<SurfaceMesh32d>(buffer);
+    ensure_attributes_exist(loaded, true, true);
+    REQUIRE(loaded.get_num_facets() == cube.get_num_facets());
+    REQUIRE(compute_mesh_area(loaded) == Catch::Approx(area).epsilon(1e-3));
+#else
+    LA_REQUIRE_THROWS(io::save_mesh_gltf(buffer, cube, opt));
+#endif
+}
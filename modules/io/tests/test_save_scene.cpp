@@ -41,5 +41,38 @@ TEST_CASE("save_scene", "[io]")
         REQUIRE(scene.skeletons.size() == scene2.skeletons.size());
         REQUIRE(scene.animations.size() == scene2.animations.size());
     }
+
+    SECTION("Lazy images")
+    {
+        fs::path avocado_path = testing::get_data_path("open/io/avocado/Avocado.gltf");
+        io::LoadOptions load_options;
+        load_options.lazy_images = true;
+        auto scene = io::load_scene<SceneType>(avocado_path, load_options);
+        REQUIRE(!scene.images.empty());
+        for (const auto& image : scene.images) {
+            REQUIRE(image.image.data.empty());
+            REQUIRE(image.lazy_image != nullptr);
+            REQUIRE(!image.lazy_image->get_encoded_data().empty());
+            REQUIRE(!image.lazy_image->is_decoded());
+        }
+
+        // Encoded images are saved as is.
+        std::stringstream ss;
+        io::save_scene(ss, scene, io::FileFormat::Gltf);
+        for (const auto& image : scene.images) {
+            REQUIRE(!image.lazy_image->is_decoded());
+        }
+
+        auto scene2 = io::load_scene<SceneType>(ss);
+        REQUIRE(scene.images.size() == scene2.images.size());
+        for (size_t i = 0; i < scene.images.size(); ++i) {
+            auto buffer = scene.images[i].get_image();
+            REQUIRE(scene.images[i].lazy_image->is_decoded());
+            const auto& buffer2 = scene2.images[i].image;
+            REQUIRE(buffer->width == buffer2.width);
+            REQUIRE(buffer->height == buffer2.height);
+            REQUIRE(buffer->data == buffer2.data);
+        }
+    }
 }
 
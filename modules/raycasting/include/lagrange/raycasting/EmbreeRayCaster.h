@@ -20,7 +20,18 @@
 #include <lagrange/raycasting/RayCasterMesh.h>
 #include <lagrange/raycasting/embree_closest_point.h>
 #include <lagrange/utils/safe_cast.h>
-
+#include <lagrange/utils/span.h>
+
+// clang-format off
+#include <lagrange/utils/warnoff.h>
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#include <lagrange/utils/warnon.h>
+// clang-format on
+
+#include <algorithm>
+#include <array>
 #include <cassert>
 #include <cmath>
 #include <exception>
@@ -38,9 +49,9 @@ namespace raycasting {
 
 /**
  * A wrapper for Embree's raycasting API to compute ray intersections with (instances of) meshes.
- * Supports intersection and occlusion queries on single rays and ray packets (currently only
- * packets of size at most 4 are supported). Filters may be specified (per mesh, not per instance)
- * to process each individual hit event during any of these queries.
+ * Supports intersection and occlusion queries on single rays, ray packets of size 4, 8 and 16, and
+ * arbitrarily long ray streams. Filters may be specified (per mesh, not per instance) to process
+ * each individual hit event during any of these queries.
  */
 template <typename ScalarType>
 class EmbreeRayCaster
@@ -60,9 +71,44 @@ public:
     using Scalar4 = Eigen::Matrix<Scalar, 4, 1>;
     using Mask4 = Eigen::Matrix<std::int32_t, 4, 1>;
 
+    using Point8 = Eigen::Matrix<Scalar, 8, 3>;
+    using Direction8 = Eigen::Matrix<Scalar, 8, 3>;
+    using Index8 = Eigen::Matrix<size_t, 8, 1>;
+    using Scalar8 = Eigen::Matrix<Scalar, 8, 1>;
+    using Mask8 = Eigen::Matrix<std::int32_t, 8, 1>;
+
+    using Point16 = Eigen::Matrix<Scalar, 16, 3>;
+    using Direction16 = Eigen::Matrix<Scalar, 16, 3>;
+    using Index16 = Eigen::Matrix<size_t, 16, 1>;
+    using Scalar16 = Eigen::Matrix<Scalar, 16, 1>;
+    using Mask16 = Eigen::Matrix<std::int32_t, 16, 1>;
+
     using FloatData = std::vector<float>;
     using IntData = std::vector<unsigned>;
 
+    /** A single ray of a ray stream. */
+    struct Ray
+    {
+        Point origin = Point::Zero();
+        Direction direction = Direction::Zero();
+        Scalar tmin = 0;
+        Scalar tmax = std::numeric_limits<Scalar>::infinity();
+    };
+
+    /** Closest intersection of a ray of a ray stream. Indices are invalid if the ray missed. */
+    struct Hit
+    {
+        Index mesh_index = invalid<Index>();
+        Index instance_index = invalid<Index>();
+        Index facet_index = invalid<Index>();
+        Scalar ray_depth = 0;
+        Point barycentric_coord = Point::Zero();
+        Point normal = Point::Zero();
+
+        /** Whether the ray hit anything. */
+        bool is_hit() const { return facet_index != invalid<Index>(); }
+    };
+
     /**
      * Interface for a hit filter function. Most information in `RTCFilterFunctionNArguments` maps
      * directly to elements of the EmbreeRayCaster class, but the mesh and instance IDs need special
@@ -446,75 +492,19 @@ public:
         const Scalar4& tmin = Scalar4::Zero(),
         const Scalar4& tmax = Scalar4::Constant(std::numeric_limits<Scalar>::infinity()))
     {
-        la_debug_assert(batch_size <= 4);
-
-        update_internal();
-
-        RTCRayHit4 embree_raypacket;
-        for (int i = 0; i < static_cast<int>(batch_size); ++i) {
-            // Set ray origins
-            embree_raypacket.ray.org_x[i] = static_cast<float>(origin(i, 0));
-            embree_raypacket.ray.org_y[i] = static_cast<float>(origin(i, 1));
-            embree_raypacket.ray.org_z[i] = static_cast<float>(origin(i, 2));
-
-            // Set ray directions
-            embree_raypacket.ray.dir_x[i] = static_cast<float>(direction(i, 0));
-            embree_raypacket.ray.dir_y[i] = static_cast<float>(direction(i, 1));
-            embree_raypacket.ray.dir_z[i] = static_cast<float>(direction(i, 2));
-
-            // Misc
-            embree_raypacket.ray.tnear[i] = static_cast<float>(tmin[i]);
-            embree_raypacket.ray.tfar[i] = std::isinf(tmax[i]) ? std::numeric_limits<float>::max()
-                                                               : static_cast<float>(tmax[i]);
-            embree_raypacket.ray.mask[i] = 0xFFFFFFFF;
-            embree_raypacket.ray.id[i] = static_cast<unsigned>(i);
-            embree_raypacket.ray.flags[i] = 0;
-
-            // Required initialization of the hit substructure
-            embree_raypacket.hit.geomID[i] = RTC_INVALID_GEOMETRY_ID;
-            embree_raypacket.hit.primID[i] = RTC_INVALID_GEOMETRY_ID;
-            embree_raypacket.hit.instID[0][i] = RTC_INVALID_GEOMETRY_ID;
-        }
-
-        // Modify the mask to make 100% sure extra rays in the packet will be ignored
-        auto packet_mask = mask;
-        for (int i = static_cast<int>(batch_size); i < 4; ++i) packet_mask[i] = 0;
-
-        ensure_no_errors_internal();
-        {
-            RTCIntersectContext context;
-            rtcInitIntersectContext(&context);
-            rtcIntersect4(packet_mask.data(), m_embree_world_scene, &context, &embree_raypacket);
-        }
-        ensure_no_errors_internal();
-
-        uint32_t is_hits = 0;
-        for (int i = 0; i < static_cast<int>(batch_size); ++i) {
-            if (embree_raypacket.hit.geomID[i] != RTC_INVALID_GEOMETRY_ID) {
-                Index rtc_inst_id = embree_raypacket.hit.instID[0][i];
-                Index rtc_mesh_id = (rtc_inst_id == RTC_INVALID_GEOMETRY_ID)
-                                        ? embree_raypacket.hit.geomID[i]
-                                        : rtc_inst_id;
-                assert(rtc_mesh_id < m_instance_to_user_mesh.size());
-                assert(m_visibility[rtc_mesh_id]);
-                mesh_index[i] = m_instance_to_user_mesh[rtc_mesh_id];
-                assert(mesh_index[i] + 1 < m_instance_index_ranges.size());
-                assert(mesh_index[i] < safe_cast<Index>(m_meshes.size()));
-                instance_index[i] = rtc_mesh_id - m_instance_index_ranges[mesh_index[i]];
-                facet_index[i] = embree_raypacket.hit.primID[i];
-                ray_depth[i] = embree_raypacket.ray.tfar[i];
-                barycentric_coord(i, 0) =
-                    1.0f - embree_raypacket.hit.u[i] - embree_raypacket.hit.v[i];
-                barycentric_coord(i, 1) = embree_raypacket.hit.u[i];
-                barycentric_coord(i, 2) = embree_raypacket.hit.v[i];
-                normal(i, 0) = embree_raypacket.hit.Ng_x[i];
-                normal(i, 1) = embree_raypacket.hit.Ng_y[i];
-                normal(i, 2) = embree_raypacket.hit.Ng_z[i];
-                is_hits = is_hits | (1 << i);
-            }
-        }
-
-        return is_hits;
+        return cast_packet<4, RTCRayHit4>(
+            batch_size,
+            origin,
+            direction,
+            mask,
+            mesh_index,
+            instance_index,
+            facet_index,
+            ray_depth,
+            barycentric_coord,
+            normal,
+            tmin,
+            tmax);
     }
 
     /**
@@ -561,49 +551,290 @@ public:
         const Scalar4& tmin = Scalar4::Zero(),
         const Scalar4& tmax = Scalar4::Constant(std::numeric_limits<Scalar>::infinity()))
     {
-        la_debug_assert(batch_size <= 4);
+        return occluded_packet<4, RTCRay4>(batch_size, origin, direction, mask, tmin, tmax);
+    }
 
+    /**
+     * Cast a packet of up to 8 rays through the scene, returning full data of the closest
+     * intersections including normals and instance indices.
+     */
+    uint32_t cast8(
+        uint32_t batch_size,
+        const Point8& origin,
+        const Direction8& direction,
+        const Mask8& mask,
+        Index8& mesh_index,
+        Index8& instance_index,
+        Index8& facet_index,
+        Scalar8& ray_depth,
+        Point8& barycentric_coord,
+        Point8& normal,
+        const Scalar8& tmin = Scalar8::Zero(),
+        const Scalar8& tmax = Scalar8::Constant(std::numeric_limits<Scalar>::infinity()))
+    {
+        return cast_packet<8, RTCRayHit8>(
+            batch_size,
+            origin,
+            direction,
+            mask,
+            mesh_index,
+            instance_index,
+            facet_index,
+            ray_depth,
+            barycentric_coord,
+            normal,
+            tmin,
+            tmax);
+    }
+
+    /**
+     * Cast a packet of up to 8 rays through the scene, returning data of the closest intersections
+     * excluding normals and instance indices.
+     */
+    uint32_t cast8(
+        uint32_t batch_size,
+        const Point8& origin,
+        const Direction8& direction,
+        const Mask8& mask,
+        Index8& mesh_index,
+        Index8& facet_index,
+        Scalar8& ray_depth,
+        Point8& barycentric_coord,
+        const Scalar8& tmin = Scalar8::Zero(),
+        const Scalar8& tmax = Scalar8::Constant(std::numeric_limits<Scalar>::infinity()))
+    {
+        Index8 instance_index;
+        Point8 normal;
+        return cast8(
+            batch_size,
+            origin,
+            direction,
+            mask,
+            mesh_index,
+            instance_index,
+            facet_index,
+            ray_depth,
+            barycentric_coord,
+            normal,
+            tmin,
+            tmax);
+    }
+
+    /**
+     * Cast a packet of up to 8 rays through the scene and check whether they hit anything or not.
+     */
+    uint32_t cast8(
+        uint32_t batch_size,
+        const Point8& origin,
+        const Direction8& direction,
+        const Mask8& mask,
+        const Scalar8& tmin = Scalar8::Zero(),
+        const Scalar8& tmax = Scalar8::Constant(std::numeric_limits<Scalar>::infinity()))
+    {
+        return occluded_packet<8, RTCRay8>(batch_size, origin, direction, mask, tmin, tmax);
+    }
+
+    /**
+     * Cast a packet of up to 16 rays through the scene, returning full data of the closest
+     * intersections including normals and instance indices.
+     */
+    uint32_t cast16(
+        uint32_t batch_size,
+        const Point16& origin,
+        const Direction16& direction,
+        const Mask16& mask,
+        Index16& mesh_index,
+        Index16& instance_index,
+        Index16& facet_index,
+        Scalar16& ray_depth,
+        Point16& barycentric_coord,
+        Point16& normal,
+        const Scalar16& tmin = Scalar16::Zero(),
+        const Scalar16& tmax = Scalar16::Constant(std::numeric_limits<Scalar>::infinity()))
+    {
+        return cast_packet<16, RTCRayHit16>(
+            batch_size,
+            origin,
+            direction,
+            mask,
+            mesh_index,
+            instance_index,
+            facet_index,
+            ray_depth,
+            barycentric_coord,
+            normal,
+            tmin,
+            tmax);
+    }
+
+    /**
+     * Cast a packet of up to 16 rays through the scene, returning data of the closest intersections
+     * excluding normals and instance indices.
+     */
+    uint32_t cast16(
+        uint32_t batch_size,
+        const Point16& origin,
+        const Direction16& direction,
+        const Mask16& mask,
+        Index16& mesh_index,
+        Index16& facet_index,
+        Scalar16& ray_depth,
+        Point16& barycentric_coord,
+        const Scalar16& tmin = Scalar16::Zero(),
+        const Scalar16& tmax = Scalar16::Constant(std::numeric_limits<Scalar>::infinity()))
+    {
+        Index16 instance_index;
+        Point16 normal;
+        return cast16(
+            batch_size,
+            origin,
+            direction,
+            mask,
+            mesh_index,
+            instance_index,
+            facet_index,
+            ray_depth,
+            barycentric_coord,
+            normal,
+            tmin,
+            tmax);
+    }
+
+    /**
+     * Cast a packet of up to 16 rays through the scene and check whether they hit anything or not.
+     */
+    uint32_t cast16(
+        uint32_t batch_size,
+        const Point16& origin,
+        const Direction16& direction,
+        const Mask16& mask,
+        const Scalar16& tmin = Scalar16::Zero(),
+        const Scalar16& tmax = Scalar16::Constant(std::numeric_limits<Scalar>::infinity()))
+    {
+        return occluded_packet<16, RTCRay16>(batch_size, origin, direction, mask, tmin, tmax);
+    }
+
+    /**
+     * Cast a stream of rays through the scene, returning full data of the closest intersection of
+     * each ray. The stream is split into chunks that are processed in parallel with Embree's stream
+     * API. Chunks are processed serially if any intersection or occlusion filter is set, since
+     * filters are not required to be thread-safe.
+     *
+     * @param[in]  rays      Rays to cast.
+     * @param[out] hits      Closest intersection of each ray. Must have the same size as `rays`.
+     * @param[in]  coherent  Hint that consecutive rays have similar origins and directions (e.g.
+     *                       primary camera rays), which lets Embree trace them as packets.
+     */
+    void cast_stream(span<const Ray> rays, span<Hit> hits, bool coherent = false)
+    {
+        la_runtime_assert(hits.size() == rays.size(), "Output size must match the number of rays");
+
+        // Scene updates are not thread-safe, do them before entering the parallel loop.
         update_internal();
 
-        RTCRay4 embree_raypacket;
-        for (int i = 0; i < static_cast<int>(batch_size); ++i) {
-            // Set ray origins
-            embree_raypacket.org_x[i] = static_cast<float>(origin(i, 0));
-            embree_raypacket.org_y[i] = static_cast<float>(origin(i, 1));
-            embree_raypacket.org_z[i] = static_cast<float>(origin(i, 2));
+        for_each_stream_chunk(
+            rays.size(),
+            [&](const tbb::blocked_range<size_t>& range) {
+                std::array<RTCRayHit, s_stream_chunk_size> embree_rayhits;
+                const auto num_rays = static_cast<unsigned>(range.size());
+                for (unsigned i = 0; i < num_rays; ++i) {
+                    auto& embree_rayhit = embree_rayhits[i];
+                    set_stream_ray(rays[range.begin() + i], i, embree_rayhit.ray);
+                    embree_rayhit.hit.geomID = RTC_INVALID_GEOMETRY_ID;
+                    embree_rayhit.hit.primID = RTC_INVALID_GEOMETRY_ID;
+                    embree_rayhit.hit.instID[0] = RTC_INVALID_GEOMETRY_ID;
+                }
 
-            // Set ray directions
-            embree_raypacket.dir_x[i] = static_cast<float>(direction(i, 0));
-            embree_raypacket.dir_y[i] = static_cast<float>(direction(i, 1));
-            embree_raypacket.dir_z[i] = static_cast<float>(direction(i, 2));
+                ensure_no_errors_internal();
+                {
+                    RTCIntersectContext context;
+                    rtcInitIntersectContext(&context);
+                    if (coherent) context.flags = RTC_INTERSECT_CONTEXT_FLAG_COHERENT;
+                    rtcIntersect1M(
+                        m_embree_world_scene,
+                        &context,
+                        embree_rayhits.data(),
+                        num_rays,
+                        sizeof(RTCRayHit));
+                }
+                ensure_no_errors_internal();
 
-            // Misc
-            embree_raypacket.tnear[i] = static_cast<float>(tmin[i]);
-            embree_raypacket.tfar[i] = std::isinf(tmax[i]) ? std::numeric_limits<float>::max()
-                                                           : static_cast<float>(tmax[i]);
-            embree_raypacket.mask[i] = 0xFFFFFFFF;
-            embree_raypacket.id[i] = static_cast<unsigned>(i);
-            embree_raypacket.flags[i] = 0;
-        }
+                for (unsigned i = 0; i < num_rays; ++i) {
+                    const auto& embree_rayhit = embree_rayhits[i];
+                    Hit& hit = hits[range.begin() + i];
+                    if (embree_rayhit.hit.geomID == RTC_INVALID_GEOMETRY_ID) {
+                        hit = Hit();
+                        continue;
+                    }
+                    Index rtc_inst_id = embree_rayhit.hit.instID[0];
+                    Index rtc_mesh_id = (rtc_inst_id == RTC_INVALID_GEOMETRY_ID)
+                                            ? embree_rayhit.hit.geomID
+                                            : rtc_inst_id;
+                    assert(rtc_mesh_id < m_instance_to_user_mesh.size());
+                    assert(m_visibility[rtc_mesh_id]);
+                    hit.mesh_index = m_instance_to_user_mesh[rtc_mesh_id];
+                    assert(hit.mesh_index + 1 < m_instance_index_ranges.size());
+                    assert(hit.mesh_index < safe_cast<Index>(m_meshes.size()));
+                    hit.instance_index = rtc_mesh_id - m_instance_index_ranges[hit.mesh_index];
+                    hit.facet_index = embree_rayhit.hit.primID;
+                    hit.ray_depth = embree_rayhit.ray.tfar;
+                    hit.barycentric_coord[0] = 1.0f - embree_rayhit.hit.u - embree_rayhit.hit.v;
+                    hit.barycentric_coord[1] = embree_rayhit.hit.u;
+                    hit.barycentric_coord[2] = embree_rayhit.hit.v;
+                    hit.normal[0] = embree_rayhit.hit.Ng_x;
+                    hit.normal[1] = embree_rayhit.hit.Ng_y;
+                    hit.normal[2] = embree_rayhit.hit.Ng_z;
+                }
+            });
+    }
+
+    /**
+     * Cast a stream of rays through the scene and check whether each of them hits anything or not.
+     * This is cheaper than computing the closest intersections, e.g. for shadow or ambient
+     * occlusion rays. Like the other overload, chunks are processed serially if any filter is set.
+     *
+     * @param[in]  rays      Rays to cast.
+     * @param[out] is_hit    Whether each ray hit anything (0 or 1). Must have the same size as
+     *                       `rays`.
+     * @param[in]  coherent  Hint that consecutive rays have similar origins and directions.
+     */
+    void cast_stream(span<const Ray> rays, span<uint8_t> is_hit, bool coherent = false)
+    {
+        la_runtime_assert(
+            is_hit.size() == rays.size(),
+            "Output size must match the number of rays");
 
-        // Modify the mask to make 100% sure extra rays in the packet will be ignored
-        auto packet_mask = mask;
-        for (int i = static_cast<int>(batch_size); i < 4; ++i) packet_mask[i] = 0;
+        // Scene updates are not thread-safe, do them before entering the parallel loop.
+        update_internal();
 
-        ensure_no_errors_internal();
-        {
-            RTCIntersectContext context;
-            rtcInitIntersectContext(&context);
-            rtcOccluded4(packet_mask.data(), m_embree_world_scene, &context, &embree_raypacket);
-        }
-        ensure_no_errors_internal();
+        for_each_stream_chunk(
+            rays.size(),
+            [&](const tbb::blocked_range<size_t>& range) {
+                std::array<RTCRay, s_stream_chunk_size> embree_rays;
+                const auto num_rays = static_cast<unsigned>(range.size());
+                for (unsigned i = 0; i < num_rays; ++i) {
+                    set_stream_ray(rays[range.begin() + i], i, embree_rays[i]);
+                }
 
-        // If hit, the tfar field will be set to -inf.
-        uint32_t is_hits = 0;
-        for (uint32_t i = 0; i < batch_size; ++i)
-            if (!std::isfinite(embree_raypacket.tfar[i])) is_hits = is_hits | (1 << i);
+                ensure_no_errors_internal();
+                {
+                    RTCIntersectContext context;
+                    rtcInitIntersectContext(&context);
+                    if (coherent) context.flags = RTC_INTERSECT_CONTEXT_FLAG_COHERENT;
+                    rtcOccluded1M(
+                        m_embree_world_scene,
+                        &context,
+                        embree_rays.data(),
+                        num_rays,
+                        sizeof(RTCRay));
+                }
+                ensure_no_errors_internal();
 
-        return is_hits;
+                // If hit, the tfar field will be set to -inf.
+                for (unsigned i = 0; i < num_rays; ++i) {
+                    is_hit[range.begin() + i] = !std::isfinite(embree_rays[i].tfar);
+                }
+            });
     }
 
     /**
@@ -959,6 +1190,265 @@ protected:
     }
 
 private:
+    /** Number of rays handed to Embree at once by the stream queries. */
+    static constexpr size_t s_stream_chunk_size = 256;
+
+    /** Packet-size dispatch of Embree's intersection and occlusion functions. */
+    static void rtc_intersect_packet(
+        const int* valid,
+        RTCScene scene,
+        RTCIntersectContext* context,
+        RTCRayHit4* rayhit)
+    {
+        rtcIntersect4(valid, scene, context, rayhit);
+    }
+    static void rtc_intersect_packet(
+        const int* valid,
+        RTCScene scene,
+        RTCIntersectContext* context,
+        RTCRayHit8* rayhit)
+    {
+        rtcIntersect8(valid, scene, context, rayhit);
+    }
+    static void rtc_intersect_packet(
+        const int* valid,
+        RTCScene scene,
+        RTCIntersectContext* context,
+        RTCRayHit16* rayhit)
+    {
+        rtcIntersect16(valid, scene, context, rayhit);
+    }
+    static void rtc_occluded_packet(
+        const int* valid,
+        RTCScene scene,
+        RTCIntersectContext* context,
+        RTCRay4* ray)
+    {
+        rtcOccluded4(valid, scene, context, ray);
+    }
+    static void rtc_occluded_packet(
+        const int* valid,
+        RTCScene scene,
+        RTCIntersectContext* context,
+        RTCRay8* ray)
+    {
+        rtcOccluded8(valid, scene, context, ray);
+    }
+    static void rtc_occluded_packet(
+        const int* valid,
+        RTCScene scene,
+        RTCIntersectContext* context,
+        RTCRay16* ray)
+    {
+        rtcOccluded16(valid, scene, context, ray);
+    }
+
+    /**
+     * Cast a packet of up to N rays through the scene, returning full data of the closest
+     * intersections. Shared implementation of cast4, cast8 and cast16.
+     */
+    template <int N, typename RTCRayHitN>
+    uint32_t cast_packet(
+        uint32_t batch_size,
+        const Eigen::Matrix<Scalar, N, 3>& origin,
+        const Eigen::Matrix<Scalar, N, 3>& direction,
+        const Eigen::Matrix<std::int32_t, N, 1>& mask,
+        Eigen::Matrix<size_t, N, 1>& mesh_index,
+        Eigen::Matrix<size_t, N, 1>& instance_index,
+        Eigen::Matrix<size_t, N, 1>& facet_index,
+        Eigen::Matrix<Scalar, N, 1>& ray_depth,
+        Eigen::Matrix<Scalar, N, 3>& barycentric_coord,
+        Eigen::Matrix<Scalar, N, 3>& normal,
+        const Eigen::Matrix<Scalar, N, 1>& tmin,
+        const Eigen::Matrix<Scalar, N, 1>& tmax)
+    {
+        la_debug_assert(batch_size <= N);
+
+        update_internal();
+
+        RTCRayHitN embree_raypacket;
+        for (int i = 0; i < static_cast<int>(batch_size); ++i) {
+            // Set ray origins
+            embree_raypacket.ray.org_x[i] = static_cast<float>(origin(i, 0));
+            embree_raypacket.ray.org_y[i] = static_cast<float>(origin(i, 1));
+            embree_raypacket.ray.org_z[i] = static_cast<float>(origin(i, 2));
+
+            // Set ray directions
+            embree_raypacket.ray.dir_x[i] = static_cast<float>(direction(i, 0));
+            embree_raypacket.ray.dir_y[i] = static_cast<float>(direction(i, 1));
+            embree_raypacket.ray.dir_z[i] = static_cast<float>(direction(i, 2));
+
+            // Misc
+            embree_raypacket.ray.tnear[i] = static_cast<float>(tmin[i]);
+            embree_raypacket.ray.tfar[i] = std::isinf(tmax[i]) ? std::numeric_limits<float>::max()
+                                                               : static_cast<float>(tmax[i]);
+            embree_raypacket.ray.mask[i] = 0xFFFFFFFF;
+            embree_raypacket.ray.id[i] = static_cast<unsigned>(i);
+            embree_raypacket.ray.flags[i] = 0;
+
+            // Required initialization of the hit substructure
+            embree_raypacket.hit.geomID[i] = RTC_INVALID_GEOMETRY_ID;
+            embree_raypacket.hit.primID[i] = RTC_INVALID_GEOMETRY_ID;
+            embree_raypacket.hit.instID[0][i] = RTC_INVALID_GEOMETRY_ID;
+        }
+
+        // Modify the mask to make 100% sure extra rays in the packet will be ignored. Embree
+        // requires the mask to be aligned to the packet size.
+        alignas(64) std::array<int, N> packet_mask;
+        for (int i = 0; i < N; ++i) {
+            packet_mask[i] = (i < static_cast<int>(batch_size)) ? mask[i] : 0;
+        }
+
+        ensure_no_errors_internal();
+        {
+            RTCIntersectContext context;
+            rtcInitIntersectContext(&context);
+            rtc_intersect_packet(
+                packet_mask.data(),
+                m_embree_world_scene,
+                &context,
+                &embree_raypacket);
+        }
+        ensure_no_errors_internal();
+
+        uint32_t is_hits = 0;
+        for (int i = 0; i < static_cast<int>(batch_size); ++i) {
+            if (embree_raypacket.hit.geomID[i] != RTC_INVALID_GEOMETRY_ID) {
+                Index rtc_inst_id = embree_raypacket.hit.instID[0][i];
+                Index rtc_mesh_id = (rtc_inst_id == RTC_INVALID_GEOMETRY_ID)
+                                        ? embree_raypacket.hit.geomID[i]
+                                        : rtc_inst_id;
+                assert(rtc_mesh_id < m_instance_to_user_mesh.size());
+                assert(m_visibility[rtc_mesh_id]);
+                mesh_index[i] = m_instance_to_user_mesh[rtc_mesh_id];
+                assert(mesh_index[i] + 1 < m_instance_index_ranges.size());
+                assert(mesh_index[i] < safe_cast<Index>(m_meshes.size()));
+                instance_index[i] = rtc_mesh_id - m_instance_index_ranges[mesh_index[i]];
+                facet_index[i] = embree_raypacket.hit.primID[i];
+                ray_depth[i] = embree_raypacket.ray.tfar[i];
+                barycentric_coord(i, 0) =
+                    1.0f - embree_raypacket.hit.u[i] - embree_raypacket.hit.v[i];
+                barycentric_coord(i, 1) = embree_raypacket.hit.u[i];
+                barycentric_coord(i, 2) = embree_raypacket.hit.v[i];
+                normal(i, 0) = embree_raypacket.hit.Ng_x[i];
+                normal(i, 1) = embree_raypacket.hit.Ng_y[i];
+                normal(i, 2) = embree_raypacket.hit.Ng_z[i];
+                is_hits = is_hits | (1 << i);
+            }
+        }
+
+        return is_hits;
+    }
+
+    /**
+     * Cast a packet of up to N rays through the scene and check whether they hit anything or not.
+     * Shared implementation of cast4, cast8 and cast16.
+     */
+    template <int N, typename RTCRayN>
+    uint32_t occluded_packet(
+        uint32_t batch_size,
+        const Eigen::Matrix<Scalar, N, 3>& origin,
+        const Eigen::Matrix<Scalar, N, 3>& direction,
+        const Eigen::Matrix<std::int32_t, N, 1>& mask,
+        const Eigen::Matrix<Scalar, N, 1>& tmin,
+        const Eigen::Matrix<Scalar, N, 1>& tmax)
+    {
+        la_debug_assert(batch_size <= N);
+
+        update_internal();
+
+        RTCRayN embree_raypacket;
+        for (int i = 0; i < static_cast<int>(batch_size); ++i) {
+            // Set ray origins
+            embree_raypacket.org_x[i] = static_cast<float>(origin(i, 0));
+            embree_raypacket.org_y[i] = static_cast<float>(origin(i, 1));
+            embree_raypacket.org_z[i] = static_cast<float>(origin(i, 2));
+
+            // Set ray directions
+            embree_raypacket.dir_x[i] = static_cast<float>(direction(i, 0));
+            embree_raypacket.dir_y[i] = static_cast<float>(direction(i, 1));
+            embree_raypacket.dir_z[i] = static_cast<float>(direction(i, 2));
+
+            // Misc
+            embree_raypacket.tnear[i] = static_cast<float>(tmin[i]);
+            embree_raypacket.tfar[i] = std::isinf(tmax[i]) ? std::numeric_limits<float>::max()
+                                                           : static_cast<float>(tmax[i]);
+            embree_raypacket.mask[i] = 0xFFFFFFFF;
+            embree_raypacket.id[i] = static_cast<unsigned>(i);
+            embree_raypacket.flags[i] = 0;
+        }
+
+        // Modify the mask to make 100% sure extra rays in the packet will be ignored. Embree
+        // requires the mask to be aligned to the packet size.
+        alignas(64) std::array<int, N> packet_mask;
+        for (int i = 0; i < N; ++i) {
+            packet_mask[i] = (i < static_cast<int>(batch_size)) ? mask[i] : 0;
+        }
+
+        ensure_no_errors_internal();
+        {
+            RTCIntersectContext context;
+            rtcInitIntersectContext(&context);
+            rtc_occluded_packet(
+                packet_mask.data(),
+                m_embree_world_scene,
+                &context,
+                &embree_raypacket);
+        }
+        ensure_no_errors_internal();
+
+        // If hit, the tfar field will be set to -inf.
+        uint32_t is_hits = 0;
+        for (uint32_t i = 0; i < batch_size; ++i)
+            if (!std::isfinite(embree_raypacket.tfar[i])) is_hits = is_hits | (1 << i);
+
+        return is_hits;
+    }
+
+    /**
+     * Call a function on consecutive chunks of at most s_stream_chunk_size rays of a stream. Chunks
+     * are processed in parallel, unless a user filter is set: filters are called from the thread
+     * tracing the ray, and are not required to be thread-safe.
+     */
+    template <typename Func>
+    void for_each_stream_chunk(size_t num_rays, Func&& func) const
+    {
+        auto is_set = [](const FilterFunction& filter) { return bool(filter); };
+        const bool has_filters =
+            std::any_of(std::begin(m_filters), std::end(m_filters), [&](const auto& filters) {
+                return std::any_of(filters.begin(), filters.end(), is_set);
+            });
+        if (has_filters) {
+            for (size_t begin = 0; begin < num_rays; begin += s_stream_chunk_size) {
+                func(tbb::blocked_range<size_t>(
+                    begin,
+                    std::min(begin + s_stream_chunk_size, num_rays)));
+            }
+        } else {
+            tbb::parallel_for(
+                tbb::blocked_range<size_t>(0, num_rays, s_stream_chunk_size),
+                func,
+                tbb::simple_partitioner());
+        }
+    }
+
+    /** Convert a ray of a ray stream to Embree's format. */
+    static void set_stream_ray(const Ray& ray, unsigned id, RTCRay& embree_ray)
+    {
+        embree_ray.org_x = static_cast<float>(ray.origin.x());
+        embree_ray.org_y = static_cast<float>(ray.origin.y());
+        embree_ray.org_z = static_cast<float>(ray.origin.z());
+        embree_ray.dir_x = static_cast<float>(ray.direction.x());
+        embree_ray.dir_y = static_cast<float>(ray.direction.y());
+        embree_ray.dir_z = static_cast<float>(ray.direction.z());
+        embree_ray.tnear = static_cast<float>(ray.tmin);
+        embree_ray.tfar = std::isinf(ray.tmax) ? std::numeric_limits<float>::max()
+                                               : static_cast<float>(ray.tmax);
+        embree_ray.mask = 0xFFFFFFFF;
+        embree_ray.id = id;
+        embree_ray.flags = 0;
+    }
+
     /**
      * Helper function for setting intersection filters. Does NOT commit the geometry. The caller
      * must explicitly call `rtcCommitGeometry()` afterwards.
@@ -1023,13 +1513,15 @@ private:
 
         // In case Embree's implementation changes in the future, the callback should be written
         // generally, without assuming the single geometry/instance condition above.
-        Index4 mesh_index4;
-        mesh_index4.fill(mesh_index);
-        Index4 instance_index4;
-        instance_index4.fill(instance_index);
+        // Packets hold at most 16 rays.
+        assert(args->N <= 16);
+        Index16 mesh_index16;
+        mesh_index16.fill(mesh_index);
+        Index16 instance_index16;
+        instance_index16.fill(instance_index);
 
         // Call the wrapped filter with the indices specific to this object
-        filter(obj, mesh_index4.data(), instance_index4.data(), args);
+        filter(obj, mesh_index16.data(), instance_index16.data(), args);
     }
 
     /**
@@ -95,11 +95,11 @@ void project_attributes_directional(
     using Point = typename EmbreeRayCaster<Scalar>::Point;
     using Direction = typename EmbreeRayCaster<Scalar>::Direction;
     using RayCasterIndex = typename EmbreeRayCaster<Scalar>::Index;
-    using Scalar4 = typename EmbreeRayCaster<Scalar>::Scalar4;
-    using Index4 = typename EmbreeRayCaster<Scalar>::Index4;
-    using Point4 = typename EmbreeRayCaster<Scalar>::Point4;
-    using Direction4 = typename EmbreeRayCaster<Scalar>::Direction4;
-    using Mask4 = typename EmbreeRayCaster<Scalar>::Mask4;
+    using Scalar16 = typename EmbreeRayCaster<Scalar>::Scalar16;
+    using Index16 = typename EmbreeRayCaster<Scalar>::Index16;
+    using Point16 = typename EmbreeRayCaster<Scalar>::Point16;
+    using Direction16 = typename EmbreeRayCaster<Scalar>::Direction16;
+    using Mask16 = typename EmbreeRayCaster<Scalar>::Mask16;
 
     // We need to convert to a shared_ptr AND the ray caster will make another copy of the data..
     std::unique_ptr<EmbreeRayCaster<Scalar>> engine;
@@ -144,23 +144,23 @@ void project_attributes_directional(
     }
 
     Index num_vertices = target.get_num_vertices();
-    Index num_packets = (num_vertices + 3) / 4;
+    Index num_packets = (num_vertices + 15) / 16;
 
-    Direction4 dirs;
+    Direction16 dirs;
     dirs.row(0) = direction.normalized().transpose();
-    for (int i = 1; i < 4; ++i) {
+    for (int i = 1; i < 16; ++i) {
         dirs.row(i) = dirs.row(0);
     }
-    Direction4 dirs2 = -dirs;
+    Direction16 dirs2 = -dirs;
 
     tbb::parallel_for(Index(0), num_packets, [&](Index packet_index) {
-        Index batchsize = std::min(num_vertices - (packet_index << 2), 4);
-        Mask4 mask = Mask4::Constant(-1);
-        Point4 origins;
+        Index batchsize = std::min(num_vertices - packet_index * 16, 16);
+        Mask16 mask = Mask16::Constant(-1);
+        Point16 origins;
 
         int num_skipped_in_packet = 0;
         for (Index b = 0; b < batchsize; ++b) {
-            Index i = (packet_index << 2) + b;
+            Index i = packet_index * 16 + b;
             if (skip_vertex && skip_vertex(i)) {
                 logger().trace("skipping vertex: {}", i);
                 if (!is_hit.empty()) {
@@ -176,17 +176,17 @@ void project_attributes_directional(
 
         if (num_skipped_in_packet == batchsize) return;
 
-        for (Index b = batchsize; b < 4; ++b) {
+        for (Index b = batchsize; b < 16; ++b) {
             mask(b) = 0;
         }
 
-        Index4 mesh_indices;
-        Index4 instance_indices;
-        Index4 facet_indices;
-        Scalar4 ray_depths;
-        Point4 barys;
-        Point4 normals;
-        uint8_t hits = ray_caster->cast4(
+        Index16 mesh_indices;
+        Index16 instance_indices;
+        Index16 facet_indices;
+        Scalar16 ray_depths;
+        Point16 barys;
+        Point16 normals;
+        uint32_t hits = ray_caster->cast16(
             batchsize,
             origins,
             dirs,
@@ -200,14 +200,14 @@ void project_attributes_directional(
 
         if (cast_mode == CastMode::BOTH_WAYS) {
             // Try again in the other direction. Slightly offset ray origin, and keep closest point.
-            Point4 origins2 = origins + Scalar(1e-6) * diag * dirs;
-            Index4 mesh_indices2;
-            Index4 instance_indices2;
-            Index4 facet_indices2;
-            Scalar4 ray_depths2;
-            Point4 barys2;
-            Point4 norms2;
-            uint8_t hits2 = ray_caster->cast4(
+            Point16 origins2 = origins + Scalar(1e-6) * diag * dirs;
+            Index16 mesh_indices2;
+            Index16 instance_indices2;
+            Index16 facet_indices2;
+            Scalar16 ray_depths2;
+            Point16 barys2;
+            Point16 norms2;
+            uint32_t hits2 = ray_caster->cast16(
                 batchsize,
                 origins2,
                 dirs2,
@@ -235,7 +235,7 @@ void project_attributes_directional(
         for (Index b = 0; b < batchsize; ++b) {
             if (!mask(b)) continue;
             bool hit = hits & (1 << b);
-            Index i = (packet_index << 2) + b;
+            Index i = packet_index * 16 + b;
             if (hit) {
                 // Hit occurred, interpolate data
                 la_runtime_assert(
@@ -93,11 +93,11 @@ void project_particles_directional(
     using Index = typename MeshType::Index;
     using Point = typename EmbreeRayCaster<Scalar>::Point;
     using Direction = typename EmbreeRayCaster<Scalar>::Direction;
-    using Scalar4 = typename EmbreeRayCaster<Scalar>::Scalar4;
-    using Index4 = typename EmbreeRayCaster<Scalar>::Index4;
-    using Point4 = typename EmbreeRayCaster<Scalar>::Point4;
-    using Direction4 = typename EmbreeRayCaster<Scalar>::Direction4;
-    using Mask4 = typename EmbreeRayCaster<Scalar>::Mask4;
+    using Scalar16 = typename EmbreeRayCaster<Scalar>::Scalar16;
+    using Index16 = typename EmbreeRayCaster<Scalar>::Index16;
+    using Point16 = typename EmbreeRayCaster<Scalar>::Point16;
+    using Direction16 = typename EmbreeRayCaster<Scalar>::Direction16;
+    using Mask16 = typename EmbreeRayCaster<Scalar>::Mask16;
 
     // We need to convert to a shared_ptr AND the ray caster will make another copy of the data..
     std::unique_ptr<EmbreeRayCaster<Scalar>> engine;
@@ -125,14 +125,14 @@ void project_particles_directional(
     bool use_parent_transforms = !parent_transforms.isIdentity();
 
     VectorType dir = direction.normalized();
-    Index num_ray_packets = (num_particles + 3) / 4;
-    Direction4 dirs;
+    Index num_ray_packets = (num_particles + 15) / 16;
+    Direction16 dirs;
     dirs.row(0) = dir.transpose();
-    for (int i = 1; i < 4; ++i) {
+    for (int i = 1; i < 16; ++i) {
         dirs.row(i) = dirs.row(0);
     }
 
-    std::vector<uint8_t> vector_hits(num_ray_packets, safe_cast<uint8_t>(0u));
+    std::vector<uint32_t> vector_hits(num_ray_packets, 0u);
 
     ParticleDataType projected_origins;
     ParticleDataType projected_normals;
@@ -142,12 +142,12 @@ void project_particles_directional(
 
     tbb::parallel_for(Index(0), num_ray_packets, [&](Index packet_index) {
         uint32_t batchsize =
-            safe_cast<uint32_t>(std::min(num_particles - (packet_index << 2), safe_cast<Index>(4)));
-        Mask4 mask = Mask4::Constant(-1);
-        Point4 ray_origins;
+            safe_cast<uint32_t>(std::min(num_particles - packet_index * 16, safe_cast<Index>(16)));
+        Mask16 mask = Mask16::Constant(-1);
+        Point16 ray_origins;
 
         for (uint32_t b = 0; b < batchsize; ++b) {
-            Index i = (packet_index << 2) + b;
+            Index i = packet_index * 16 + b;
 
             // C * L
             if (use_parent_transforms) {
@@ -158,17 +158,17 @@ void project_particles_directional(
             }
         }
 
-        for (Index b = batchsize; b < 4; ++b) {
+        for (Index b = batchsize; b < 16; ++b) {
             mask(b) = 0;
         }
 
-        Index4 mesh_indices;
-        Index4 instance_indices;
-        Index4 facet_indices;
-        Scalar4 ray_depths;
-        Point4 barys;
-        Point4 normals;
-        uint8_t hits = ray_caster->cast4(
+        Index16 mesh_indices;
+        Index16 instance_indices;
+        Index16 facet_indices;
+        Scalar16 ray_depths;
+        Point16 barys;
+        Point16 normals;
+        uint32_t hits = ray_caster->cast16(
             batchsize,
             ray_origins,
             dirs,
@@ -187,7 +187,7 @@ void project_particles_directional(
         for (uint32_t b = 0; b < batchsize; ++b) {
             bool hit = hits & (1 << b);
             if (hit) {
-                Index i = (packet_index << 2) + b;
+                Index i = packet_index * 16 + b;
                 if (has_normals) {
                     VectorType norm =
                         (ray_caster->get_transform(mesh_indices[b], instance_indices[b])
@@ -213,8 +213,8 @@ void project_particles_directional(
     // remove redundant output data
     Index i = 0;
     auto remove_func = [&](const VectorType&) -> bool {
-        Index packet_index = i >> 2;
-        Index b = i++ - (packet_index << 2);
+        Index packet_index = i / 16;
+        Index b = i++ - packet_index * 16;
         return !(vector_hits[packet_index] & (1 << b));
     };
 
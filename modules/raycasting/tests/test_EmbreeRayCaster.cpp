@@ -640,6 +640,164 @@ TEST_CASE("EmbreeDynamicRayCaster_visibility", "[embree][ray_caster][dynamic][vi
     REQUIRE(facet_index == lagrange::invalid<size_t>());
 }
 
+TEST_CASE("EmbreeRayCaster_packets_and_streams", "[embree][ray_caster][default][stream]")
+{
+    const auto cube = lagrange::to_shared_ptr(lagrange::create_cube());
+    REQUIRE(cube);
+
+    using MeshType = decltype(cube)::element_type;
+    using Scalar = typename MeshType::Scalar;
+    using RayCasterPtr = std::unique_ptr<lagrange::raycasting::EmbreeRayCaster<Scalar>>;
+    using RayCaster = typename RayCasterPtr::element_type;
+    using Index = RayCaster::Index;
+    using Point = typename RayCaster::Point;
+    using Direction = typename RayCaster::Direction;
+
+    auto ray_caster =
+        lagrange::raycasting::create_ray_caster<Scalar>(lagrange::raycasting::EMBREE_DEFAULT);
+    REQUIRE(ray_caster);
+    ray_caster->add_mesh(cube, Eigen::Matrix<Scalar, 4, 4>::Identity());
+
+    // Rays shot from the center of the cube in all directions. Some are tested with a maximum
+    // distance that is too short to reach the cube.
+    const Index num_rays = 1000;
+    std::vector<RayCaster::Ray> rays(num_rays);
+    for (Index i = 0; i < num_rays; ++i) {
+        const Scalar theta = Scalar(i) * 2.399963;
+        const Scalar z = Scalar(1) - Scalar(2 * i + 1) / Scalar(num_rays);
+        const Scalar r = std::sqrt(Scalar(1) - z * z);
+        rays[i].origin = Point(0.1, -0.2, 0.3);
+        rays[i].direction = Direction(r * std::cos(theta), r * std::sin(theta), z);
+        if (i % 7 == 0) rays[i].tmax = 0.5;
+    }
+
+    // Reference results from single ray queries
+    std::vector<RayCaster::Hit> expected(num_rays);
+    for (Index i = 0; i < num_rays; ++i) {
+        auto& e = expected[i];
+        bool hit = ray_caster->cast(
+            rays[i].origin,
+            rays[i].direction,
+            e.mesh_index,
+            e.instance_index,
+            e.facet_index,
+            e.ray_depth,
+            e.barycentric_coord,
+            e.normal,
+            rays[i].tmin,
+            rays[i].tmax);
+        REQUIRE(hit == (i % 7 != 0));
+    }
+
+    auto check_hit = [&](Index i, bool hit, Index facet_index, Scalar ray_depth) {
+        REQUIRE(hit == expected[i].is_hit());
+        if (hit) {
+            REQUIRE(facet_index == expected[i].facet_index);
+            REQUIRE(ray_depth == Catch::Approx(expected[i].ray_depth));
+        }
+    };
+
+    SECTION("cast8")
+    {
+        using Point8 = typename RayCaster::Point8;
+        using Index8 = typename RayCaster::Index8;
+        using Scalar8 = typename RayCaster::Scalar8;
+        using Mask8 = typename RayCaster::Mask8;
+        for (Index j = 0; j < num_rays; j += 8) {
+            const auto batch_size = static_cast<uint32_t>(std::min<Index>(num_rays - j, 8));
+            Point8 from = Point8::Zero();
+            Point8 dir = Point8::Zero();
+            Scalar8 tmin = Scalar8::Zero();
+            Scalar8 tmax = Scalar8::Constant(std::numeric_limits<Scalar>::infinity());
+            for (uint32_t b = 0; b < batch_size; ++b) {
+                from.row(b) = rays[j + b].origin.transpose();
+                dir.row(b) = rays[j + b].direction.transpose();
+                tmax(b) = rays[j + b].tmax;
+            }
+            Index8 mesh_index, facet_index;
+            Scalar8 ray_depth;
+            Point8 bc;
+            uint32_t hits = ray_caster->cast8(
+                batch_size,
+                from,
+                dir,
+                Mask8::Constant(-1),
+                mesh_index,
+                facet_index,
+                ray_depth,
+                bc,
+                tmin,
+                tmax);
+            uint32_t occluded =
+                ray_caster->cast8(batch_size, from, dir, Mask8::Constant(-1), tmin, tmax);
+            REQUIRE(hits == occluded);
+            for (uint32_t b = 0; b < batch_size; ++b) {
+                check_hit(j + b, hits & (1 << b), facet_index(b), ray_depth(b));
+            }
+        }
+    }
+
+    SECTION("cast16")
+    {
+        using Point16 = typename RayCaster::Point16;
+        using Index16 = typename RayCaster::Index16;
+        using Scalar16 = typename RayCaster::Scalar16;
+        using Mask16 = typename RayCaster::Mask16;
+        for (Index j = 0; j < num_rays; j += 16) {
+            const auto batch_size = static_cast<uint32_t>(std::min<Index>(num_rays - j, 16));
+            Point16 from = Point16::Zero();
+            Point16 dir = Point16::Zero();
+            Scalar16 tmin = Scalar16::Zero();
+            Scalar16 tmax = Scalar16::Constant(std::numeric_limits<Scalar>::infinity());
+            for (uint32_t b = 0; b < batch_size; ++b) {
+                from.row(b) = rays[j + b].origin.transpose();
+                dir.row(b) = rays[j + b].direction.transpose();
+                tmax(b) = rays[j + b].tmax;
+            }
+            Index16 mesh_index, instance_index, facet_index;
+            Scalar16 ray_depth;
+            Point16 bc, normal;
+            uint32_t hits = ray_caster->cast16(
+                batch_size,
+                from,
+                dir,
+                Mask16::Constant(-1),
+                mesh_index,
+                instance_index,
+                facet_index,
+                ray_depth,
+                bc,
+                normal,
+                tmin,
+                tmax);
+            uint32_t occluded =
+                ray_caster->cast16(batch_size, from, dir, Mask16::Constant(-1), tmin, tmax);
+            REQUIRE(hits == occluded);
+            for (uint32_t b = 0; b < batch_size; ++b) {
+                check_hit(j + b, hits & (1 << b), facet_index(b), ray_depth(b));
+            }
+        }
+    }
+
+    SECTION("stream")
+    {
+        for (bool coherent : {false, true}) {
+            std::vector<RayCaster::Hit> hits(num_rays);
+            ray_caster->cast_stream(rays, hits, coherent);
+            std::vector<uint8_t> occluded(num_rays);
+            ray_caster->cast_stream(rays, occluded, coherent);
+            for (Index i = 0; i < num_rays; ++i) {
+                check_hit(i, hits[i].is_hit(), hits[i].facet_index, hits[i].ray_depth);
+                REQUIRE(bool(occluded[i]) == expected[i].is_hit());
+                if (hits[i].is_hit()) {
+                    REQUIRE(hits[i].mesh_index == expected[i].mesh_index);
+                    REQUIRE(hits[i].instance_index == expected[i].instance_index);
+                }
+            }
+        }
+    }
+}
+
 TEST_CASE("EmbreeDynamicRayCaster_updates", "[embree][ray_caster][dynamic][updates]")
 {
     auto cube = lagrange::to_shared_ptr(lagrange::create_cube());
@@ -848,4 +1006,27 @@ TEST_CASE("EmbreeDefaultRayCaster_filters", "[embree][ray_caster][default][filte
                                  (double)(NUM_STEPSx2 * NUM_STEPSx2);
     REQUIRE(avg_hit_count >= Catch::Approx(2));
     REQUIRE(avg_hit_count <= Catch::Approx(MAX_AVG_HITS4));
+
+    // Ray stream tests. The filter above is not thread-safe, so streams must call it serially.
+    std::vector<typename RayCaster::Ray> rays;
+    for (int i = 0; i < NUM_STEPS; ++i) {
+        for (int j = 0; j < NUM_STEPS; ++j) {
+            typename RayCaster::Ray ray;
+            ray.origin = typename RayCaster::Point(
+                2 * (i + 0.5) / (Scalar)NUM_STEPS - 1,
+                2 * (j + 0.5) / (Scalar)NUM_STEPS - 1,
+                EYE_DIST);
+            ray.direction = typename RayCaster::Direction(0.0, 0.0, -1.0);
+            rays.push_back(ray);
+        }
+    }
+    hit_count = 0;
+    std::vector<typename RayCaster::Hit> hits(rays.size());
+    ray_caster->cast_stream(rays, hits);
+    avg_hit_count = hit_count / (double)rays.size();
+    REQUIRE(avg_hit_count >= Catch::Approx(2));
+    REQUIRE(avg_hit_count <= Catch::Approx(MAX_AVG_HITS));
+    for (const auto& hit : hits) {
+        REQUIRE(!hit.is_hit()); // All hits were rejected by the filter
+    }
 }
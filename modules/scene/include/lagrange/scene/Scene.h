@@ -16,11 +16,18 @@
 #include <lagrange/fs/filesystem.h>
 #include <lagrange/scene/SceneExtension.h>
 #include <lagrange/scene/api.h>
+#include <lagrange/utils/SharedSpan.h>
 #include <lagrange/utils/invalid.h>
+#include <lagrange/utils/span.h>
 
 #include <Eigen/Geometry>
 
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace lagrange {
@@ -106,6 +113,135 @@ struct LA_SCENE_API ImageBufferExperimental
     size_t get_bits_per_element() const;
 };
 
+class ImageCacheExperimental;
+
+///
+/// Image whose pixels are decoded on demand. It keeps the encoded image (e.g. the content of a PNG
+/// or JPEG file) or a handle to it, and only decodes it upon first access. Decoded pixels are kept
+/// until released, or until they are evicted by an ImageCacheExperimental.
+///
+/// All methods are thread-safe.
+///
+class LA_SCENE_API LazyImageExperimental
+{
+public:
+    /// Function decoding the image pixels.
+    using DecodeFunction = std::function<ImageBufferExperimental()>;
+
+    ///
+    /// Constructs a lazy image.
+    ///
+    /// @param[in]  encoded_data  Encoded image bytes. May be empty if the image is decoded from
+    ///                           another source, such as a file on disk.
+    /// @param[in]  mime_type     Mime type of the encoded data (e.g. "image/png"). May be empty.
+    /// @param[in]  decode        Function decoding the image pixels.
+    /// @param[in]  cache         Optional cache bounding the memory used by decoded pixels.
+    ///
+    LazyImageExperimental(
+        SharedSpan<const unsigned char> encoded_data,
+        std::string mime_type,
+        DecodeFunction decode,
+        std::shared_ptr<ImageCacheExperimental> cache = nullptr);
+
+    LazyImageExperimental(const LazyImageExperimental&) = delete;
+    LazyImageExperimental& operator=(const LazyImageExperimental&) = delete;
+
+    ~LazyImageExperimental();
+
+    ///
+    /// Gets the encoded image bytes.
+    ///
+    /// @return     The encoded bytes, or an empty span if they are not held in memory.
+    ///
+    span<const unsigned char> get_encoded_data() const { return m_encoded_data.get(); }
+
+    ///
+    /// Gets the mime type of the encoded data.
+    ///
+    /// @return     The mime type, or an empty string if unknown.
+    ///
+    const std::string& get_mime_type() const { return m_mime_type; }
+
+    ///
+    /// Gets the image pixels, decoding them if needed. Concurrent calls decode the image once.
+    ///
+    /// @return     The decoded image. It remains valid after the image is released or evicted.
+    ///
+    std::shared_ptr<const ImageBufferExperimental> get_image() const;
+
+    ///
+    /// Checks whether the decoded pixels are currently held in memory.
+    ///
+    bool is_decoded() const;
+
+    ///
+    /// Releases the decoded pixels. They are decoded again upon next access.
+    ///
+    void release() const;
+
+private:
+    friend class ImageCacheExperimental;
+
+    struct Pixels
+    {
+        std::mutex mutex;
+        std::shared_ptr<const ImageBufferExperimental> buffer;
+    };
+
+    SharedSpan<const unsigned char> m_encoded_data;
+    std::string m_mime_type;
+    DecodeFunction m_decode;
+    std::shared_ptr<ImageCacheExperimental> m_cache;
+    std::shared_ptr<Pixels> m_pixels;
+};
+
+///
+/// Memory budget shared by lazy images. When the decoded pixels of the images using a cache exceed
+/// its budget, the least recently accessed images are released. The most recently accessed image
+/// is always kept, even if it exceeds the budget on its own.
+///
+/// All methods are thread-safe.
+///
+class LA_SCENE_API ImageCacheExperimental
+{
+public:
+    ///
+    /// Constructs a cache.
+    ///
+    /// @param[in]  max_num_bytes  Maximum number of bytes of decoded pixels.
+    ///
+    explicit ImageCacheExperimental(size_t max_num_bytes);
+
+    /// Maximum number of bytes of decoded pixels.
+    size_t get_max_num_bytes() const { return m_max_num_bytes; }
+
+    /// Number of bytes of decoded pixels currently held by the images using this cache.
+    size_t get_num_bytes() const;
+
+private:
+    friend class LazyImageExperimental;
+    using Pixels = LazyImageExperimental::Pixels;
+
+    struct Entry
+    {
+        const Pixels* key = nullptr;
+        std::weak_ptr<Pixels> pixels;
+        size_t num_bytes = 0;
+    };
+
+    /// Marks pixels as most recently used, and evicts the least recently used ones if needed.
+    void touch(const std::shared_ptr<Pixels>& pixels, const ImageBufferExperimental* buffer);
+
+    /// Stops tracking pixels that were released.
+    void remove(const Pixels* pixels);
+
+    size_t m_max_num_bytes = 0;
+    size_t m_num_bytes = 0;
+    mutable std::mutex m_mutex;
+    std::list<Entry> m_entries; // Most recently used first.
+    std::unordered_map<const Pixels*, std::list<Entry>::iterator> m_lookup;
+};
+
 ///
 /// Image structure that can store either image data or reference to an image file.
 ///
@@ -114,15 +250,26 @@ struct LA_SCENE_API ImageExperimental
     /// Image name. Not guaranteed to be unique and can be empty.
     std::string name;
 
-    /// Image data.
+    /// Image data. Empty if the pixels are decoded on demand from `lazy_image`.
     ImageBufferExperimental image;
 
+    /// Image decoded on demand, set when loading a scene with `LoadOptions::lazy_images`.
+    std::shared_ptr<LazyImageExperimental> lazy_image;
+
     /// Image file path. This path is relative to the file that contains the scene.
     /// It is only valid if image data should be mapped to an external file.
     fs::path uri;
 
     /// Image extensions.
     Extensions extensions;
+
+    ///
+    /// Gets the image pixels, decoding the lazy image if needed.
+    ///
+    /// @return     The decoded image. If the pixels are stored in `image`, the returned pointer
+    ///             does not own them and is only valid as long as this object.
+    ///
+    std::shared_ptr<const ImageBufferExperimental> get_image() const;
 };
 
 
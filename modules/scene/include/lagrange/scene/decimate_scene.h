@@ -0,0 +1,48 @@
+/*
+ * Copyright 2024 Adobe. All rights reserved.
+ * This file is licensed to you under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License. You may obtain a copy
+ * of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under
+ * the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR REPRESENTATIONS
+ * OF ANY KIND, either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+ */
+#pragma once
+
+#include <lagrange/decimate_mesh.h>
+#include <lagrange/scene/RemeshingOptions.h>
+#include <lagrange/scene/SimpleScene.h>
+
+namespace lagrange::scene {
+
+///
+/// Decimates the meshes of a scene with quadric edge collapses (see `lagrange::decimate_mesh`).
+///
+/// The facet target of the decimation options applies to the total number of facets of the
+/// decimated meshes, and is split between meshes according to the facet allocation strategy.
+/// Budget that a mesh cannot use (because it already has fewer facets) is redistributed to the
+/// other meshes. With the synchronized strategy, all meshes are decimated jointly, with collapse
+/// errors measured in world space using the largest scaling of each mesh's instances.
+///
+/// @param[in,out] scene               Scene whose meshes are decimated in place.
+/// @param[in]     decimation_options  Decimation options.
+/// @param[in]     remeshing_options   Scene-level options. A mesh importance is the largest
+///                                    importance of its instances, and scales its share of the
+///                                    facet budget. The default minimum number of facets is 0.
+///                                    Meshes without instances are decimated as if they had a
+///                                    single instance with identity transform, unless another
+///                                    strategy is specified.
+///
+/// @tparam        Scalar              Scene scalar type.
+/// @tparam        Index               Scene index type.
+/// @tparam        Dimension           Scene dimension.
+///
+template <typename Scalar, typename Index, size_t Dimension>
+void decimate_scene(
+    SimpleScene<Scalar, Index, Dimension>& scene,
+    const DecimationOptions& decimation_options = {},
+    const RemeshingOptions& remeshing_options = {});
+
+} // namespace lagrange::scene
@@ -0,0 +1,77 @@
+/*
+ * Copyright 2024 Adobe. All rights reserved.
+ * This file is licensed to you under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License. You may obtain a copy
+ * of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under
+ * the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR REPRESENTATIONS
+ * OF ANY KIND, either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+ */
+#pragma once
+
+#include <lagrange/scene/Scene.h>
+#include <lagrange/scene/SimpleScene.h>
+
+namespace lagrange::scene {
+
+///
+/// Options for deduplicate_meshes().
+///
+struct DeduplicateMeshesOptions
+{
+    ///
+    /// Also merge meshes that are identical up to a rotation and a translation, such as repeated
+    /// parts of an assembly exported in world space. Only applies to 3D meshes whose vertices and
+    /// facets are listed in the same order.
+    ///
+    bool rigid = false;
+
+    ///
+    /// Maximum distance between corresponding vertices of rigidly transformed duplicates, relative
+    /// to the bounding box diagonal of the mesh. Normal, tangent and bitangent attributes are
+    /// compared with the same relative tolerance. Other attributes must match exactly.
+    ///
+    double tolerance = 1e-5;
+};
+
+///
+/// Merges duplicate meshes of a scene into a single mesh, and turns the instances of the removed
+/// meshes into instances of the remaining one.
+///
+/// Meshes are first grouped by a content hash of their connectivity and attributes, computed in
+/// parallel, and candidates within a group are then compared exactly. Remaining meshes keep their
+/// relative order. With rigid deduplication, the transform between two meshes is folded into the
+/// transforms of the merged instances.
+///
+/// @param[in,out] scene    Scene to deduplicate.
+/// @param[in]     options  Deduplication options.
+///
+/// @tparam        Scalar     Scene scalar type.
+/// @tparam        Index      Scene index type.
+/// @tparam        Dimension  Scene dimension.
+///
+template <typename Scalar, typename Index, size_t Dimension>
+void deduplicate_meshes(
+    SimpleScene<Scalar, Index, Dimension>& scene,
+    const DeduplicateMeshesOptions& options = {});
+
+///
+/// Merges duplicate meshes of a scene into a single mesh, and makes the nodes referencing the
+/// removed meshes reference the remaining one.
+///
+/// See the SimpleScene overload for details. Materials are stored per mesh instance and are left
+/// unchanged. When a duplicate is found up to a rigid transform, its instance is moved to a new
+/// child node carrying that transform. Skeleton mesh indices are updated as well.
+///
+/// @param[in,out] scene    Scene to deduplicate.
+/// @param[in]     options  Deduplication options.
+///
+/// @tparam        Scalar   Scene scalar type.
+/// @tparam        Index    Scene index type.
+///
+template <typename Scalar, typename Index>
+void deduplicate_meshes(Scene<Scalar, Index>& scene, const DeduplicateMeshesOptions& options = {});
+
+} // namespace lagrange::scene
@@ -11,6 +11,7 @@
  */
 #include <lagrange/AttributeValueType.h>
 #include <lagrange/scene/Scene.h>
+#include <lagrange/utils/assert.h>
 
 namespace lagrange {
 namespace scene {
@@ -46,5 +47,119 @@ size_t ImageBufferExperimental::get_bits_per_element() const
     }
 }
 
+LazyImageExperimental::LazyImageExperimental(
+    SharedSpan<const unsigned char> encoded_data,
+    std::string mime_type,
+    DecodeFunction decode,
+    std::shared_ptr<ImageCacheExperimental> cache)
+    : m_encoded_data(std::move(encoded_data))
+    , m_mime_type(std::move(mime_type))
+    , m_decode(std::move(decode))
+    , m_cache(std::move(cache))
+    , m_pixels(std::make_shared<Pixels>())
+{
+    la_runtime_assert(m_decode, "Missing image decoding function");
+}
+
+LazyImageExperimental::~LazyImageExperimental()
+{
+    if (m_cache) m_cache->remove(m_pixels.get());
+}
+
+std::shared_ptr<const ImageBufferExperimental> LazyImageExperimental::get_image() const
+{
+    std::shared_ptr<const ImageBufferExperimental> buffer;
+    {
+        // Other images can be decoded concurrently, only accesses to this image are serialized.
+        std::lock_guard<std::mutex> lock(m_pixels->mutex);
+        if (!m_pixels->buffer) {
+            m_pixels->buffer = std::make_shared<const ImageBufferExperimental>(m_decode());
+        }
+        buffer = m_pixels->buffer;
+    }
+    if (m_cache) m_cache->touch(m_pixels, buffer.get());
+    return buffer;
+}
+
+bool LazyImageExperimental::is_decoded() const
+{
+    std::lock_guard<std::mutex> lock(m_pixels->mutex);
+    return m_pixels->buffer != nullptr;
+}
+
+void LazyImageExperimental::release() const
+{
+    {
+        std::lock_guard<std::mutex> lock(m_pixels->mutex);
+        m_pixels->buffer.reset();
+    }
+    if (m_cache) m_cache->remove(m_pixels.get());
+}
+
+ImageCacheExperimental::ImageCacheExperimental(size_t max_num_bytes)
+    : m_max_num_bytes(max_num_bytes)
+{}
+
+size_t ImageCacheExperimental::get_num_bytes() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_num_bytes;
+}
+
+void ImageCacheExperimental::touch(
+    const std::shared_ptr<Pixels>& pixels,
+    const ImageBufferExperimental* buffer)
+{
+    // Lock order is always cache then pixels. Lazy images never hold their pixel lock while
+    // calling into the cache.
+    std::lock_guard<std::mutex> lock(m_mutex);
+    {
+        std::lock_guard<std::mutex> pixels_lock(pixels->mutex);
+        if (pixels->buffer.get() != buffer) {
+            // The pixels were released or evicted since they were accessed.
+            return;
+        }
+    }
+
+    auto it = m_lookup.find(pixels.get());
+    if (it != m_lookup.end()) {
+        m_entries.splice(m_entries.begin(), m_entries, it->second);
+    } else {
+        m_entries.push_front({pixels.get(), pixels, buffer->data.size()});
+        m_lookup.emplace(pixels.get(), m_entries.begin());
+        m_num_bytes += buffer->data.size();
+    }
+
+    while (m_num_bytes > m_max_num_bytes && m_entries.size() > 1) {
+        Entry& entry = m_entries.back();
+        if (auto evicted = entry.pixels.lock()) {
+            std::lock_guard<std::mutex> evicted_lock(evicted->mutex);
+            evicted->buffer.reset();
+        }
+        m_num_bytes -= entry.num_bytes;
+        m_lookup.erase(entry.key);
+        m_entries.pop_back();
+    }
+}
+
+void ImageCacheExperimental::remove(const Pixels* pixels)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_lookup.find(pixels);
+    if (it == m_lookup.end()) return;
+    m_num_bytes -= it->second->num_bytes;
+    m_entries.erase(it->second);
+    m_lookup.erase(it);
+}
+
+std::shared_ptr<const ImageBufferExperimental> ImageExperimental::get_image() const
+{
+    if (lazy_image && image.data.empty()) {
+        return lazy_image->get_image();
+    }
+    // Non-owning pointer to the pixels stored in this object.
+    return std::shared_ptr<const ImageBufferExperimental>(std::shared_ptr<void>(), &image);
+}
+
 } // namespace scene
 } // namespace lagrange
@@ -0,0 +1,180 @@
+/*
+ * Copyright 2024 Adobe. All rights reserved.
+ * This file is licensed to you under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License. You may obtain a copy
+ * of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under
+ * the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR REPRESENTATIONS
+ * OF ANY KIND, either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+ */
+#include <lagrange/scene/decimate_scene.h>
+
+#include <lagrange/scene/SimpleSceneTypes.h>
+#include <lagrange/scene/compute_mesh_weights.h>
+#include <lagrange/utils/assert.h>
+#include <lagrange/utils/invalid.h>
+
+#include <Eigen/SVD>
+
+#include <algorithm>
+#include <cmath>
+
+namespace lagrange::scene {
+
+namespace {
+
+/// Largest scaling factor applied by an affine transform.
+template <typename AffineTransform>
+double compute_max_scale(const AffineTransform& transform)
+{
+    Eigen::JacobiSVD<Eigen::MatrixXd> svd(transform.linear().template cast<double>());
+    return svd.singularValues().maxCoeff();
+}
+
+///
+/// Splits a facet budget between meshes proportionally to their weights. Budget allocated beyond
+/// the current number of facets of a mesh is redistributed to the other meshes.
+///
+std::vector<size_t> allocate_facets(
+    std::vector<double> weights,
+    const std::vector<size_t>& num_facets,
+    size_t target_num_facets)
+{
+    std::vector<size_t> budgets(weights.size(), invalid<size_t>());
+    double remaining = static_cast<double>(target_num_facets);
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        double total_weight = 0;
+        for (size_t i = 0; i < weights.size(); ++i) {
+            if (budgets[i] == invalid<size_t>()) total_weight += weights[i];
+        }
+        for (size_t i = 0; i < weights.size(); ++i) {
+            if (budgets[i] != invalid<size_t>()) continue;
+            const double share = total_weight > 0 ? weights[i] / total_weight : 0;
+            if (share * remaining >= static_cast<double>(num_facets[i])) {
+                budgets[i] = num_facets[i];
+                remaining -= static_cast<double>(num_facets[i]);
+                changed = true;
+            }
+        }
+        if (!changed) {
+            for (size_t i = 0; i < weights.size(); ++i) {
+                if (budgets[i] != invalid<size_t>()) continue;
+                const double share = total_weight > 0 ? weights[i] / total_weight : 0;
+                budgets[i] = static_cast<size_t>(std::floor(share * std::max(0.0, remaining)));
+            }
+        }
+    }
+    return budgets;
+}
+
+} // namespace
+
+template <typename Scalar, typename Index, size_t Dimension>
+void decimate_scene(
+    SimpleScene<Scalar, Index, Dimension>& scene,
+    const DecimationOptions& decimation_options,
+    const RemeshingOptions& remeshing_options)
+{
+    using MeshType = typename SimpleScene<Scalar, Index, Dimension>::MeshType;
+    using InstanceType = typename SimpleScene<Scalar, Index, Dimension>::InstanceType;
+
+    const auto& per_instance_importance = remeshing_options.per_instance_importance;
+    la_runtime_assert(
+        per_instance_importance.empty() ||
+            per_instance_importance.size() == scene.compute_num_instances(),
+        "Per-instance importance must have one value per instance");
+
+    // Importance and largest scaling of each mesh, over its instances
+    const Index num_meshes = scene.get_num_meshes();
+    std::vector<double> importance(num_meshes, 0);
+    std::vector<double> scale(num_meshes, 0);
+    size_t instance_index = 0;
+    for (Index m = 0; m < num_meshes; ++m) {
+        scene.foreach_instances_for_mesh(m, [&](const InstanceType& instance) {
+            const double w = per_instance_importance.empty()
+                                 ? 1.0
+                                 : static_cast<double>(per_instance_importance[instance_index]);
+            la_runtime_assert(w > 0, "Instance importance must be > 0");
+            importance[m] = std::max(importance[m], w);
+            scale[m] = std::max(scale[m], compute_max_scale(instance.transform));
+            ++instance_index;
+        });
+    }
+
+    // Meshes to decimate
+    std::vector<Index> selected;
+    for (Index m = 0; m < num_meshes; ++m) {
+        if (scene.get_num_instances(m) == 0) {
+            switch (remeshing_options.uninstantiated_meshes_strategy) {
+            case UninstantiatedMeshesStrategy::Skip: continue;
+            case UninstantiatedMeshesStrategy::ReplaceWithEmpty:
+                scene.ref_mesh(m).clear_vertices();
+                continue;
+            case UninstantiatedMeshesStrategy::None:
+                importance[m] = 1;
+                scale[m] = 1;
+                break;
+            }
+        }
+        selected.push_back(m);
+    }
+    if (selected.empty()) return;
+
+    std::vector<size_t> num_facets;
+    size_t total_num_facets = 0;
+    for (Index m : selected) {
+        num_facets.push_back(scene.get_mesh(m).get_num_facets());
+        total_num_facets += num_facets.back();
+    }
+    size_t target_num_facets = decimation_options.target_num_facets;
+    if (target_num_facets == invalid<size_t>()) {
+        la_runtime_assert(
+            decimation_options.target_facet_ratio >= 0 &&
+                decimation_options.target_facet_ratio <= 1,
+            "Target facet ratio must be in [0, 1]");
+        target_num_facets = static_cast<size_t>(std::ceil(
+            decimation_options.target_facet_ratio * static_cast<double>(total_num_facets)));
+    }
+    const size_t min_facets =
+        remeshing_options.min_facets == invalid<size_t>() ? 0 : remeshing_options.min_facets;
+
+    if (remeshing_options.facet_allocation_strategy == FacetAllocationStrategy::Synchronized) {
+        std::vector<MeshType*> meshes;
+        std::vector<double> error_weights;
+        for (Index m : selected) {
+            meshes.push_back(&scene.ref_mesh(m));
+            error_weights.push_back(importance[m] * scale[m] * scale[m]);
+        }
+        const std::vector<size_t> min_num_facets(selected.size(), min_facets);
+        DecimationOptions options = decimation_options;
+        options.target_num_facets = target_num_facets;
+        decimate_meshes<Scalar, Index>(meshes, options, error_weights, min_num_facets);
+        return;
+    }
+
+    const auto mesh_weights =
+        compute_mesh_weights(scene, remeshing_options.facet_allocation_strategy);
+    std::vector<double> weights;
+    for (Index m : selected) {
+        weights.push_back(mesh_weights[m] * importance[m]);
+    }
+    const auto budgets = allocate_facets(weights, num_facets, target_num_facets);
+    for (size_t i = 0; i < selected.size(); ++i) {
+        DecimationOptions options = decimation_options;
+        options.target_num_facets = std::max(budgets[i], min_facets);
+        decimate_mesh(scene.ref_mesh(selected[i]), options);
+    }
+}
+
+#define LA_X_decimate_scene(_, Scalar, Index, Dim)         \
+    template LA_SCENE_API void decimate_scene(              \
+        SimpleScene<Scalar, Index, Dim>& scene,             \
+        const DecimationOptions& decimation_options,        \
+        const RemeshingOptions& remeshing_options);
+LA_SIMPLE_SCENE_X(decimate_scene, 0)
+
+} // namespace lagrange::scene
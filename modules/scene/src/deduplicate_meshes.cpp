@@ -0,0 +1,513 @@
+/*
+ * Copyright 2024 Adobe. All rights reserved.
+ * This file is licensed to you under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License. You may obtain a copy
+ * of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under
+ * the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR REPRESENTATIONS
+ * OF ANY KIND, either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+ */
+#include <lagrange/scene/deduplicate_meshes.h>
+
+#include <lagrange/Attribute.h>
+#include <lagrange/AttributeValueType.h>
+#include <lagrange/IndexedAttribute.h>
+#include <lagrange/compute_pointcloud_pca.h>
+#include <lagrange/foreach_attribute.h>
+#include <lagrange/scene/SceneTypes.h>
+#include <lagrange/scene/SimpleSceneTypes.h>
+#include <lagrange/utils/assert.h>
+#include <lagrange/utils/hash.h>
+#include <lagrange/utils/invalid.h>
+
+// clang-format off
+#include <lagrange/utils/warnoff.h>
+#include <tbb/parallel_for.h>
+#include <lagrange/utils/warnon.h>
+// clang-format on
+
+#include <Eigen/Geometry>
+#include <Eigen/SVD>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+
+namespace lagrange::scene {
+
+namespace {
+
+using Transform3d = Eigen::Transform<double, 3, Eigen::Affine>;
+
+///
+/// How an attribute is compared between two meshes.
+///
+enum class AttributeKind {
+    Ignored, ///< Derived data (edges, adjacency), not compared.
+    Exact, ///< Values must be bitwise identical.
+    Point, ///< Positions, compared after applying the rigid transform.
+    Vector, ///< Directions, compared after applying the rotation of the rigid transform.
+};
+
+template <typename Scalar, typename Index>
+AttributeKind get_attribute_kind(const SurfaceMesh<Scalar, Index>& mesh, AttributeId id, bool rigid)
+{
+    if (id == mesh.attr_id_vertex_to_position()) {
+        return rigid ? AttributeKind::Point : AttributeKind::Exact;
+    }
+    if (id == mesh.attr_id_corner_to_vertex() || id == mesh.attr_id_facet_to_first_corner()) {
+        return AttributeKind::Exact;
+    }
+    if (mesh.attr_name_is_reserved(mesh.get_attribute_name(id))) {
+        return AttributeKind::Ignored;
+    }
+    if (!rigid) {
+        return AttributeKind::Exact;
+    }
+
+    const auto& attr = mesh.get_attribute_base(id);
+    const bool is_floating_point = attr.get_value_type() == AttributeValueType::e_float ||
+                                   attr.get_value_type() == AttributeValueType::e_double;
+    if (!is_floating_point || attr.get_num_channels() < 3) {
+        return AttributeKind::Exact;
+    }
+    switch (attr.get_usage()) {
+    case AttributeUsage::Position: return AttributeKind::Point;
+    case AttributeUsage::Normal:
+    case AttributeUsage::Tangent:
+    case AttributeUsage::Bitangent: return AttributeKind::Vector;
+    default: return AttributeKind::Exact;
+    }
+}
+
+/// Summary of a mesh used to quickly discard meshes that cannot be duplicates.
+struct MeshSignature
+{
+    /// Hash of the connectivity, the attribute layout and the values compared exactly.
+    size_t hash = 0;
+
+    /// Whether the mesh can be matched up to a rigid transform.
+    bool rigid = false;
+
+    /// Vertex centroid.
+    Eigen::Vector3d centroid = Eigen::Vector3d::Zero();
+
+    /// Standard deviations along the principal axes, which are invariant under rigid transforms.
+    Eigen::Vector3d extents = Eigen::Vector3d::Zero();
+
+    /// Bounding box diagonal, only used to scale tolerances.
+    double diagonal = 0;
+};
+
+template <typename Scalar, typename Index>
+Eigen::Vector3d get_position(const SurfaceMesh<Scalar, Index>& mesh, Index v)
+{
+    auto p = mesh.get_position(v);
+    return Eigen::Vector3d(p[0], p[1], p[2]);
+}
+
+template <typename ValueType>
+void hash_values(size_t& seed, span<const ValueType> values)
+{
+    hash_combine(
+        seed,
+        std::string_view(reinterpret_cast<const char*>(values.data()), values.size_bytes()));
+}
+
+template <typename Scalar, typename Index>
+MeshSignature compute_signature(const SurfaceMesh<Scalar, Index>& mesh, bool rigid)
+{
+    MeshSignature signature;
+    signature.rigid = rigid && mesh.get_dimension() == 3 && mesh.get_num_vertices() > 0;
+
+    size_t& h = signature.hash;
+    hash_combine(h, signature.rigid);
+    hash_combine(h, static_cast<size_t>(mesh.get_dimension()));
+    hash_combine(h, static_cast<size_t>(mesh.get_num_vertices()));
+    hash_combine(h, static_cast<size_t>(mesh.get_num_facets()));
+    hash_combine(h, static_cast<size_t>(mesh.get_num_corners()));
+    seq_foreach_named_attribute_read(mesh, [&](std::string_view name, auto&& attr) {
+        using AttributeType = std::decay_t<decltype(attr)>;
+        const AttributeKind kind =
+            get_attribute_kind(mesh, mesh.get_attribute_id(name), signature.rigid);
+        if (kind == AttributeKind::Ignored) return;
+        hash_combine(h, name);
+        hash_combine(h, static_cast<int>(attr.get_value_type()));
+        hash_combine(h, static_cast<int>(attr.get_element_type()));
+        hash_combine(h, static_cast<int>(attr.get_usage()));
+        hash_combine(h, attr.get_num_channels());
+        if constexpr (AttributeType::IsIndexed) {
+            hash_values(h, attr.indices().get_all());
+            if (kind == AttributeKind::Exact) hash_values(h, attr.values().get_all());
+        } else {
+            if (kind == AttributeKind::Exact) hash_values(h, attr.get_all());
+        }
+    });
+
+    if (signature.rigid) {
+        auto positions = mesh.get_vertex_to_position().get_all();
+        ComputePointcloudPCAOptions pca_options;
+        pca_options.shift_centroid = true;
+        pca_options.normalize = true;
+        const auto pca = compute_pointcloud_pca<Scalar>(positions, pca_options);
+        Eigen::AlignedBox<double, 3> bbox;
+        for (Index v = 0; v < mesh.get_num_vertices(); ++v) {
+            bbox.extend(get_position(mesh, v));
+        }
+        for (int k = 0; k < 3; ++k) {
+            signature.centroid[k] = static_cast<double>(pca.center[k]);
+            signature.extents[k] = std::sqrt(std::max(0.0, double(pca.eigenvalues[k])));
+        }
+        signature.diagonal = bbox.diagonal().norm();
+    }
+    return signature;
+}
+
+///
+/// Compares the values of two attributes. Without a transform, values must be bitwise identical.
+/// Otherwise, points and vectors of `a` are transformed and compared to `b` with a tolerance.
+///
+template <typename ValueType>
+bool match_values(
+    const Attribute<ValueType>& a,
+    const Attribute<ValueType>& b,
+    AttributeKind kind,
+    const Transform3d* transform,
+    double point_eps,
+    double vector_eps)
+{
+    auto va = a.get_all();
+    auto vb = b.get_all();
+    if (va.size() != vb.size()) return false;
+    if (transform == nullptr || kind == AttributeKind::Exact) {
+        return va.empty() || std::memcmp(va.data(), vb.data(), va.size_bytes()) == 0;
+    }
+
+    if constexpr (std::is_floating_point_v<ValueType>) {
+        const size_t nc = a.get_num_channels();
+        la_debug_assert(nc >= 3);
+        for (size_t i = 0; i < a.get_num_elements(); ++i) {
+            const ValueType* p = va.data() + i * nc;
+            const ValueType* q = vb.data() + i * nc;
+            const Eigen::Vector3d x(p[0], p[1], p[2]);
+            const Eigen::Vector3d y(q[0], q[1], q[2]);
+            if (kind == AttributeKind::Point) {
+                if ((*transform * x - y).norm() > point_eps) return false;
+            } else {
+                const double eps = vector_eps * std::max(1.0, x.norm());
+                if ((transform->linear() * x - y).norm() > eps) return false;
+            }
+            // Extra channels, such as the handedness of tangents, are not transformed.
+            for (size_t c = 3; c < nc; ++c) {
+                if (std::abs(double(p[c]) - double(q[c])) > vector_eps) return false;
+            }
+        }
+        return true;
+    } else {
+        return false;
+    }
+}
+
+///
+/// Checks whether mesh `b` is a copy of mesh `a`, optionally transformed by a rigid transform.
+///
+template <typename Scalar, typename Index>
+bool match_attributes(
+    const SurfaceMesh<Scalar, Index>& a,
+    const SurfaceMesh<Scalar, Index>& b,
+    bool rigid,
+    const Transform3d* transform,
+    double point_eps,
+    double vector_eps)
+{
+    if (a.get_dimension() != b.get_dimension() || a.get_num_vertices() != b.get_num_vertices() ||
+        a.get_num_facets() != b.get_num_facets() || a.get_num_corners() != b.get_num_corners()) {
+        return false;
+    }
+
+    bool match = true;
+    size_t num_compared = 0;
+    seq_foreach_named_attribute_read(a, [&](std::string_view name, auto&& attr_a) {
+        if (!match) return;
+        using AttributeType = std::decay_t<decltype(attr_a)>;
+        using ValueType = typename AttributeType::ValueType;
+        const AttributeKind kind = get_attribute_kind(a, a.get_attribute_id(name), rigid);
+        if (kind == AttributeKind::Ignored) return;
+        ++num_compared;
+
+        if (!b.has_attribute(name)) {
+            match = false;
+            return;
+        }
+        const AttributeId id_b = b.get_attribute_id(name);
+        const auto& base_b = b.get_attribute_base(id_b);
+        if (!b.template is_attribute_type<ValueType>(id_b) ||
+            b.is_attribute_indexed(id_b) != AttributeType::IsIndexed ||
+            base_b.get_element_type() != attr_a.get_element_type() ||
+            base_b.get_usage() != attr_a.get_usage() ||
+            base_b.get_num_channels() != attr_a.get_num_channels()) {
+            match = false;
+            return;
+        }
+
+        if constexpr (AttributeType::IsIndexed) {
+            const auto& attr_b = b.template get_indexed_attribute<ValueType>(id_b);
+            match = match_values(
+                        attr_a.indices(),
+                        attr_b.indices(),
+                        AttributeKind::Exact,
+                        nullptr,
+                        0,
+                        0) &&
+                    match_values(
+                        attr_a.values(),
+                        attr_b.values(),
+                        kind,
+                        transform,
+                        point_eps,
+                        vector_eps);
+        } else {
+            const auto& attr_b = b.template get_attribute<ValueType>(id_b);
+            match = match_values(attr_a, attr_b, kind, transform, point_eps, vector_eps);
+        }
+    });
+    if (!match) return false;
+
+    // Make sure `b` does not have attributes missing from `a`.
+    size_t num_attributes_b = 0;
+    b.seq_foreach_attribute_id([&](AttributeId id) {
+        if (get_attribute_kind(b, id, rigid) != AttributeKind::Ignored) ++num_attributes_b;
+    });
+    return num_attributes_b == num_compared;
+}
+
+///
+/// Computes the rotation and translation best aligning corresponding vertices of two meshes in the
+/// least squares sense (Kabsch algorithm).
+///
+template <typename Scalar, typename Index>
+Transform3d compute_rigid_transform(
+    const SurfaceMesh<Scalar, Index>& a,
+    const MeshSignature& sa,
+    const SurfaceMesh<Scalar, Index>& b,
+    const MeshSignature& sb)
+{
+    Eigen::Matrix3d covariance = Eigen::Matrix3d::Zero();
+    for (Index v = 0; v < a.get_num_vertices(); ++v) {
+        const Eigen::Vector3d pa = get_position(a, v);
+        const Eigen::Vector3d pb = get_position(b, v);
+        covariance += (pa - sa.centroid) * (pb - sb.centroid).transpose();
+    }
+    Eigen::JacobiSVD<Eigen::Matrix3d> svd(covariance, Eigen::ComputeFullU | Eigen::ComputeFullV);
+    Eigen::Matrix3d reflection = Eigen::Matrix3d::Identity();
+    if ((svd.matrixV() * svd.matrixU().transpose()).determinant() < 0) {
+        reflection(2, 2) = -1;
+    }
+    const Eigen::Matrix3d rotation = svd.matrixV() * reflection * svd.matrixU().transpose();
+
+    Transform3d transform = Transform3d::Identity();
+    transform.linear() = rotation;
+    transform.translation() = sb.centroid - rotation * sa.centroid;
+    return transform;
+}
+
+/// Result of the deduplication for a single mesh.
+struct MeshMatch
+{
+    /// Index of the mesh replacing this one. Equal to the mesh index for unique meshes.
+    size_t representative = invalid<size_t>();
+
+    /// Transform mapping the representative mesh onto this one.
+    Transform3d transform = Transform3d::Identity();
+
+    /// Whether the transform is the identity.
+    bool is_identity = true;
+};
+
+template <typename Scalar, typename Index>
+bool match_meshes(
+    const SurfaceMesh<Scalar, Index>& a,
+    const MeshSignature& sa,
+    const SurfaceMesh<Scalar, Index>& b,
+    const MeshSignature& sb,
+    const DeduplicateMeshesOptions& options,
+    MeshMatch& result)
+{
+    if (match_attributes(a, b, sa.rigid, nullptr, 0, 0)) {
+        result.transform = Transform3d::Identity();
+        result.is_identity = true;
+        return true;
+    }
+    if (!sa.rigid) return false;
+
+    const double eps = options.tolerance * std::max(sa.diagonal, sb.diagonal);
+    if ((sa.extents - sb.extents).cwiseAbs().maxCoeff() > eps) return false;
+
+    const Transform3d transform = compute_rigid_transform(a, sa, b, sb);
+    if (!match_attributes(a, b, true, &transform, eps, options.tolerance)) return false;
+    result.transform = transform;
+    result.is_identity = false;
+    return true;
+}
+
+///
+/// Finds duplicate meshes. Signatures are computed in parallel, and groups of meshes sharing the
+/// same hash are then processed in parallel. Within a group, each mesh is compared against the
+/// representatives found so far, so the first mesh of a set of duplicates is always kept.
+///
+template <typename Scalar, typename Index>
+std::vector<MeshMatch> find_duplicate_meshes(
+    const std::vector<const SurfaceMesh<Scalar, Index>*>& meshes,
+    const DeduplicateMeshesOptions& options)
+{
+    const size_t num_meshes = meshes.size();
+    std::vector<MeshSignature> signatures(num_meshes);
+    tbb::parallel_for(size_t(0), num_meshes, [&](size_t i) {
+        signatures[i] = compute_signature(*meshes[i], options.rigid);
+    });
+
+    std::unordered_map<size_t, size_t> bucket_of_hash;
+    std::vector<std::vector<size_t>> buckets;
+    for (size_t i = 0; i < num_meshes; ++i) {
+        auto [it, inserted] = bucket_of_hash.try_emplace(signatures[i].hash, buckets.size());
+        if (inserted) buckets.emplace_back();
+        buckets[it->second].push_back(i);
+    }
+
+    std::vector<MeshMatch> matches(num_meshes);
+    tbb::parallel_for(size_t(0), buckets.size(), [&](size_t k) {
+        std::vector<size_t> representatives;
+        for (size_t i : buckets[k]) {
+            matches[i].representative = i;
+            for (size_t r : representatives) {
+                if (match_meshes(
+                        *meshes[r],
+                        signatures[r],
+                        *meshes[i],
+                        signatures[i],
+                        options,
+                        matches[i])) {
+                    matches[i].representative = r;
+                    break;
+                }
+            }
+            if (matches[i].representative == i) representatives.push_back(i);
+        }
+    });
+    return matches;
+}
+
+} // namespace
+
+template <typename Scalar, typename Index, size_t Dimension>
+void deduplicate_meshes(
+    SimpleScene<Scalar, Index, Dimension>& scene,
+    const DeduplicateMeshesOptions& options)
+{
+    using SceneType = SimpleScene<Scalar, Index, Dimension>;
+    using MeshType = typename SceneType::MeshType;
+    using InstanceType = typename SceneType::InstanceType;
+
+    // Rigid transforms can only be folded into 3D instance transforms.
+    DeduplicateMeshesOptions local_options = options;
+    local_options.rigid = options.rigid && Dimension == 3;
+
+    std::vector<const MeshType*> meshes(scene.get_num_meshes());
+    for (Index i = 0; i < scene.get_num_meshes(); ++i) {
+        meshes[i] = &scene.get_mesh(i);
+    }
+    const auto matches = find_duplicate_meshes(meshes, local_options);
+
+    SceneType result;
+    std::vector<Index> new_indices(meshes.size(), invalid<Index>());
+    for (Index i = 0; i < scene.get_num_meshes(); ++i) {
+        if (matches[i].representative == i) {
+            new_indices[i] = result.add_mesh(std::move(scene.ref_mesh(i)));
+        }
+    }
+    for (Index i = 0; i < scene.get_num_meshes(); ++i) {
+        const MeshMatch& match = matches[i];
+        scene.foreach_instances_for_mesh(i, [&](const InstanceType& instance) {
+            InstanceType new_instance = instance;
+            new_instance.mesh_index = new_indices[match.representative];
+            if constexpr (Dimension == 3) {
+                if (!match.is_identity) {
+                    new_instance.transform =
+                        instance.transform * match.transform.template cast<Scalar>();
+                }
+            }
+            result.add_instance(std::move(new_instance));
+        });
+    }
+    scene = std::move(result);
+}
+
+template <typename Scalar, typename Index>
+void deduplicate_meshes(Scene<Scalar, Index>& scene, const DeduplicateMeshesOptions& options)
+{
+    using MeshType = typename Scene<Scalar, Index>::MeshType;
+
+    std::vector<const MeshType*> meshes(scene.meshes.size());
+    for (size_t i = 0; i < meshes.size(); ++i) {
+        meshes[i] = &scene.meshes[i];
+    }
+    const auto matches = find_duplicate_meshes(meshes, options);
+
+    std::vector<MeshType> unique_meshes;
+    std::vector<ElementId> new_indices(meshes.size(), invalid_element);
+    for (size_t i = 0; i < meshes.size(); ++i) {
+        if (matches[i].representative == i) {
+            new_indices[i] = static_cast<ElementId>(unique_meshes.size());
+            unique_meshes.push_back(std::move(scene.meshes[i]));
+        }
+    }
+    scene.meshes = std::move(unique_meshes);
+
+    // New child nodes are appended to the node list, so only visit the original nodes.
+    const size_t num_nodes = scene.nodes.size();
+    for (size_t node_id = 0; node_id < num_nodes; ++node_id) {
+        std::vector<SceneMeshInstance> instances = std::move(scene.nodes[node_id].meshes);
+        scene.nodes[node_id].meshes.clear();
+        for (SceneMeshInstance& instance : instances) {
+            la_runtime_assert(instance.mesh < matches.size(), "Invalid mesh index");
+            const MeshMatch& match = matches[instance.mesh];
+            instance.mesh = new_indices[match.representative];
+            if (match.is_identity) {
+                scene.nodes[node_id].meshes.push_back(std::move(instance));
+            } else {
+                Node child;
+                child.name = scene.nodes[node_id].name;
+                child.transform = match.transform.template cast<float>();
+                child.meshes.push_back(std::move(instance));
+                const ElementId child_id = scene.add(std::move(child));
+                scene.add_child(static_cast<ElementId>(node_id), child_id);
+            }
+        }
+    }
+
+    for (auto& skeleton : scene.skeletons) {
+        for (ElementId& mesh_id : skeleton.meshes) {
+            la_runtime_assert(mesh_id < matches.size(), "Invalid mesh index");
+            mesh_id = new_indices[matches[mesh_id].representative];
+        }
+    }
+}
+
+#define LA_X_deduplicate_meshes_simple_scene(_, Scalar, Index, Dim) \
+    template LA_SCENE_API void deduplicate_meshes(                   \
+        SimpleScene<Scalar, Index, Dim>& scene,                      \
+        const DeduplicateMeshesOptions& options);
+LA_SIMPLE_SCENE_X(deduplicate_meshes_simple_scene, 0)
+
+#define LA_X_deduplicate_meshes_scene(_, Scalar, Index) \
+    template LA_SCENE_API void deduplicate_meshes(       \
+        Scene<Scalar, Index>& scene,                     \
+        const DeduplicateMeshesOptions& options);
+LA_SCENE_X(deduplicate_meshes_scene, 0)
+
+} // namespace lagrange::scene
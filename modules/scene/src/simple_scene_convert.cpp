@@ -16,6 +16,12 @@
 #include <lagrange/transform_mesh.h>
 #include <lagrange/utils/assert.h>
 
+// clang-format off
+#include <lagrange/utils/warnoff.h>
+#include <tbb/parallel_for.h>
+#include <lagrange/utils/warnon.h>
+// clang-format on
+
 namespace lagrange::scene {
 
 template <size_t Dimension, typename Scalar, typename Index>
@@ -46,14 +52,18 @@ SurfaceMesh<Scalar, Index> simple_scene_to_mesh(
     const TransformOptions& transform_options,
     bool preserve_attributes)
 {
-    std::vector<SurfaceMesh<Scalar, Index>> meshes;
-    meshes.reserve(scene.compute_num_instances());
+    using InstanceType = typename SimpleScene<Scalar, Index, Dimension>::InstanceType;
+    std::vector<const InstanceType*> instances;
+    instances.reserve(scene.compute_num_instances());
+    scene.foreach_instances([&](const auto& instance) { instances.push_back(&instance); });
 
-    scene.foreach_instances([&](const auto& instance) {
-        meshes.emplace_back(transformed_mesh<Scalar, Index>(
-            scene.get_mesh(instance.mesh_index),
-            instance.transform,
-            transform_options));
+    // Transform instances in parallel, combine_meshes then copies them in parallel as well.
+    std::vector<SurfaceMesh<Scalar, Index>> meshes(instances.size());
+    tbb::parallel_for(size_t(0), instances.size(), [&](size_t i) {
+        meshes[i] = transformed_mesh<Scalar, Index>(
+            scene.get_mesh(instances[i]->mesh_index),
+            instances[i]->transform,
+            transform_options);
     });
     return combine_meshes<Scalar, Index>(meshes, preserve_attributes);
 }
@@ -0,0 +1,120 @@
+/*
+ * Copyright 2024 Adobe. All rights reserved.
+ * This file is licensed to you under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License. You may obtain a copy
+ * of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under
+ * the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR REPRESENTATIONS
+ * OF ANY KIND, either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+ */
+#include <lagrange/testing/common.h>
+#include <lagrange/testing/create_test_mesh.h>
+
+#include <lagrange/scene/SimpleSceneTypes.h>
+#include <lagrange/scene/decimate_scene.h>
+
+namespace {
+
+using Scalar = double;
+using Index = uint32_t;
+using SceneType = lagrange::scene::SimpleScene<Scalar, Index, 3>;
+
+SceneType create_scene(Index num_meshes)
+{
+    // Indexed normals of the test sphere are per-facet, which would lock every vertex
+    lagrange::testing::CreateOptions create_options;
+    create_options.with_indexed_normal = false;
+    create_options.with_indexed_uv = false;
+    auto sphere = lagrange::testing::create_test_sphere<Scalar, Index>(create_options);
+
+    SceneType scene;
+    for (Index m = 0; m < num_meshes; ++m) {
+        scene.add_mesh(sphere);
+        typename SceneType::InstanceType instance;
+        instance.mesh_index = m;
+        instance.transform.translate(Eigen::Vector3d(Scalar(m), 0, 0));
+        scene.add_instance(instance);
+    }
+    return scene;
+}
+
+size_t count_facets(const SceneType& scene)
+{
+    size_t num_facets = 0;
+    for (Index m = 0; m < scene.get_num_meshes(); ++m) {
+        num_facets += scene.get_mesh(m).get_num_facets();
+    }
+    return num_facets;
+}
+
+} // namespace
+
+TEST_CASE("decimate_scene", "[scene][decimate]")
+{
+    auto scene = create_scene(2);
+    const size_t num_facets = count_facets(scene);
+
+    lagrange::DecimationOptions options;
+    options.target_facet_ratio = 0.5;
+    lagrange::scene::RemeshingOptions remeshing_options;
+
+    SECTION("Even split")
+    {
+        lagrange::scene::decimate_scene(scene, options, remeshing_options);
+        REQUIRE(count_facets(scene) <= num_facets / 2);
+        REQUIRE(scene.get_mesh(0).get_num_facets() == scene.get_mesh(1).get_num_facets());
+    }
+
+    SECTION("Synchronized")
+    {
+        remeshing_options.facet_allocation_strategy =
+            lagrange::scene::FacetAllocationStrategy::Synchronized;
+        lagrange::scene::decimate_scene(scene, options, remeshing_options);
+        REQUIRE(count_facets(scene) <= num_facets / 2);
+        REQUIRE(count_facets(scene) > num_facets / 4);
+    }
+
+    SECTION("Instance importance")
+    {
+        remeshing_options.per_instance_importance = {1.f, 3.f};
+        lagrange::scene::decimate_scene(scene, options, remeshing_options);
+        REQUIRE(scene.get_mesh(0).get_num_facets() < scene.get_mesh(1).get_num_facets());
+
+        remeshing_options.per_instance_importance = {1.f};
+        LA_REQUIRE_THROWS(lagrange::scene::decimate_scene(scene, options, remeshing_options));
+    }
+
+    SECTION("Minimum number of facets")
+    {
+        options.target_num_facets = 0;
+        remeshing_options.min_facets = 40;
+        lagrange::scene::decimate_scene(scene, options, remeshing_options);
+        REQUIRE(scene.get_mesh(0).get_num_facets() >= 40);
+        REQUIRE(scene.get_mesh(1).get_num_facets() >= 40);
+    }
+
+    SECTION("Uninstantiated meshes")
+    {
+        const Index num_sphere_facets = scene.get_mesh(0).get_num_facets();
+        scene.add_mesh(scene.get_mesh(0));
+
+        remeshing_options.uninstantiated_meshes_strategy =
+            lagrange::scene::UninstantiatedMeshesStrategy::Skip;
+        auto skipped = scene;
+        lagrange::scene::decimate_scene(skipped, options, remeshing_options);
+        REQUIRE(skipped.get_mesh(2).get_num_facets() == num_sphere_facets);
+
+        remeshing_options.uninstantiated_meshes_strategy =
+            lagrange::scene::UninstantiatedMeshesStrategy::ReplaceWithEmpty;
+        auto emptied = scene;
+        lagrange::scene::decimate_scene(emptied, options, remeshing_options);
+        REQUIRE(emptied.get_mesh(2).get_num_vertices() == 0);
+
+        remeshing_options.uninstantiated_meshes_strategy =
+            lagrange::scene::UninstantiatedMeshesStrategy::None;
+        lagrange::scene::decimate_scene(scene, options, remeshing_options);
+        REQUIRE(scene.get_mesh(2).get_num_facets() < num_sphere_facets);
+    }
+}
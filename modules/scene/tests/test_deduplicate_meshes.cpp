@@ -0,0 +1,184 @@
+/*
+ * Copyright 2024 Adobe. All rights reserved.
+ * This file is licensed to you under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License. You may obtain a copy
+ * of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under
+ * the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR REPRESENTATIONS
+ * OF ANY KIND, either express or implied. See the License for the specific language
+ * governing permissions and limitations under the License.
+ */
+#include <lagrange/testing/common.h>
+#include <lagrange/testing/create_test_mesh.h>
+
+#include <lagrange/IndexedAttribute.h>
+#include <lagrange/attribute_names.h>
+#include <lagrange/scene/Scene.h>
+#include <lagrange/scene/SimpleSceneTypes.h>
+#include <lagrange/scene/deduplicate_meshes.h>
+
+#include <Eigen/Geometry>
+
+namespace {
+
+using Scalar = double;
+using Index = uint32_t;
+using MeshType = lagrange::SurfaceMesh<Scalar, Index>;
+using SceneType = lagrange::scene::SimpleScene<Scalar, Index, 3>;
+
+MeshType transformed(MeshType mesh, const Eigen::Affine3d& transform)
+{
+    for (Index v = 0; v < mesh.get_num_vertices(); ++v) {
+        auto p = mesh.ref_position(v);
+        const Eigen::Vector3d q = transform * Eigen::Vector3d(p[0], p[1], p[2]);
+        p[0] = q.x();
+        p[1] = q.y();
+        p[2] = q.z();
+    }
+    if (mesh.has_attribute(lagrange::AttributeName::normal)) {
+        auto& normals = mesh.ref_indexed_attribute<Scalar>(lagrange::AttributeName::normal);
+        auto values = normals.values().ref_all();
+        for (size_t i = 0; i < values.size(); i += 3) {
+            const Eigen::Vector3d n =
+                transform.linear() * Eigen::Vector3d(values[i], values[i + 1], values[i + 2]);
+            values[i] = n.x();
+            values[i + 1] = n.y();
+            values[i + 2] = n.z();
+        }
+    }
+    return mesh;
+}
+
+Eigen::Affine3d make_rigid_transform()
+{
+    Eigen::Affine3d transform = Eigen::Affine3d::Identity();
+    transform.translate(Eigen::Vector3d(1, 2, 3));
+    transform.rotate(Eigen::AngleAxisd(0.7, Eigen::Vector3d(1, 1, 0).normalized()));
+    return transform;
+}
+
+SceneType create_scene(const std::vector<MeshType>& meshes)
+{
+    SceneType scene;
+    for (const auto& mesh : meshes) {
+        const Index m = scene.add_mesh(mesh);
+        typename SceneType::InstanceType instance;
+        instance.mesh_index = m;
+        instance.transform.translate(Eigen::Vector3d(Scalar(m), 0, 0));
+        scene.add_instance(instance);
+    }
+    return scene;
+}
+
+/// Vertex positions of every instance, in world space.
+std::vector<Eigen::Vector3d> collect_world_positions(const SceneType& scene)
+{
+    std::vector<Eigen::Vector3d> positions;
+    for (Index m = 0; m < scene.get_num_meshes(); ++m) {
+        const auto& mesh = scene.get_mesh(m);
+        scene.foreach_instances_for_mesh(m, [&](const auto& instance) {
+            for (Index v = 0; v < mesh.get_num_vertices(); ++v) {
+                auto p = mesh.get_position(v);
+                positions.push_back(instance.transform * Eigen::Vector3d(p[0], p[1], p[2]));
+            }
+        });
+    }
+    return positions;
+}
+
+bool contains(const std::vector<Eigen::Vector3d>& positions, const Eigen::Vector3d& p)
+{
+    for (const auto& q : positions) {
+        if ((p - q).norm() < 1e-6) return true;
+    }
+    return false;
+}
+
+} // namespace
+
+TEST_CASE("deduplicate_meshes", "[scene][deduplicate]")
+{
+    using namespace lagrange::scene;
+
+    lagrange::testing::CreateOptions create_options;
+    create_options.with_indexed_uv = false;
+    const auto sphere = lagrange::testing::create_test_sphere<Scalar, Index>(create_options);
+    const auto cube = lagrange::testing::create_test_cube<Scalar, Index>(create_options);
+    const Eigen::Affine3d transform = make_rigid_transform();
+
+    SECTION("Exact duplicates")
+    {
+        auto scene = create_scene({sphere, cube, sphere, cube, sphere});
+        deduplicate_meshes(scene);
+        REQUIRE(scene.get_num_meshes() == 2);
+        REQUIRE(scene.compute_num_instances() == 5);
+        REQUIRE(scene.get_num_instances(0) == 3);
+        REQUIRE(scene.get_num_instances(1) == 2);
+        REQUIRE(scene.get_mesh(0).get_num_vertices() == sphere.get_num_vertices());
+        REQUIRE(scene.get_mesh(1).get_num_vertices() == cube.get_num_vertices());
+    }
+
+    SECTION("Different attributes")
+    {
+        auto other = sphere;
+        other.create_attribute<int>(
+            "tag",
+            lagrange::AttributeElement::Facet,
+            lagrange::AttributeUsage::Scalar);
+        auto scene = create_scene({sphere, other});
+        deduplicate_meshes(scene);
+        REQUIRE(scene.get_num_meshes() == 2);
+    }
+
+    SECTION("Rigid duplicates")
+    {
+        auto scene = create_scene({sphere, transformed(sphere, transform), cube});
+        const auto expected = collect_world_positions(scene);
+
+        deduplicate_meshes(scene);
+        REQUIRE(scene.get_num_meshes() == 3);
+
+        DeduplicateMeshesOptions options;
+        options.rigid = true;
+        deduplicate_meshes(scene, options);
+        REQUIRE(scene.get_num_meshes() == 2);
+        REQUIRE(scene.compute_num_instances() == 3);
+
+        const auto positions = collect_world_positions(scene);
+        REQUIRE(positions.size() == expected.size());
+        for (const auto& p : expected) {
+            REQUIRE(contains(positions, p));
+        }
+    }
+
+    SECTION("Scene")
+    {
+        Scene<Scalar, Index> scene;
+        scene.add(sphere);
+        scene.add(transformed(sphere, transform));
+        scene.add(sphere);
+        for (ElementId m = 0; m < 3; ++m) {
+            Node node;
+            node.meshes.push_back(SceneMeshInstance{m, {}});
+            scene.add(std::move(node));
+        }
+        Skeleton skeleton;
+        skeleton.meshes = {2};
+        scene.add(std::move(skeleton));
+
+        DeduplicateMeshesOptions options;
+        options.rigid = true;
+        deduplicate_meshes(scene, options);
+        REQUIRE(scene.meshes.size() == 1);
+        REQUIRE(scene.nodes.size() == 4);
+        REQUIRE(scene.nodes[0].meshes.front().mesh == 0);
+        REQUIRE(scene.nodes[1].meshes.empty());
+        REQUIRE(scene.nodes[1].children == std::vector<ElementId>{3});
+        REQUIRE(scene.nodes[2].meshes.front().mesh == 0);
+        REQUIRE(scene.nodes[3].parent == 1);
+        REQUIRE(scene.nodes[3].meshes.front().mesh == 0);
+        REQUIRE(scene.nodes[3].transform.isApprox(transform.cast<float>(), 1e-5f));
+        REQUIRE(scene.skeletons[0].meshes == std::vector<ElementId>{0});
+    }
+}
@@ -11,8 +11,17 @@
  */
 #include <lagrange/testing/common.h>
 
+#include <lagrange/AttributeValueType.h>
 #include <lagrange/scene/Scene.h>
 
+// clang-format off
+#include <lagrange/utils/warnoff.h>
+#include <tbb/parallel_for.h>
+#include <lagrange/utils/warnon.h>
+// clang-format on
+
+#include <atomic>
+
 TEST_CASE("scene_extension_value", "[scene]") {
     using Value = lagrange::scene::Value;
     STATIC_CHECK(Value::variant_index<bool>() == 0);
@@ -90,3 +99,100 @@ TEST_CASE("scene_extension_value", "[scene]") {
     REQUIRE(object_value["number"].get_real() == 123.4);
     REQUIRE(object_value["string"].get_string() == "hello");
 }
+
+TEST_CASE("scene_lazy_image", "[scene]")
+{
+    using namespace lagrange;
+    using namespace lagrange::scene;
+
+    std::atomic<int> num_decoded(0);
+    auto make_image = [&](size_t size, std::shared_ptr<ImageCacheExperimental> cache) {
+        auto encoded = std::make_shared<const std::vector<unsigned char>>(3, uint8_t(size));
+        return std::make_shared<LazyImageExperimental>(
+            make_shared_span(encoded, encoded->data(), encoded->size()),
+            "image/png",
+            [&num_decoded, size]() {
+                ++num_decoded;
+                ImageBufferExperimental buffer;
+                buffer.width = size;
+                buffer.height = 1;
+                buffer.num_channels = 1;
+                buffer.element_type = AttributeValueType::e_uint8_t;
+                buffer.data.assign(size, 0);
+                return buffer;
+            },
+            std::move(cache));
+    };
+
+    SECTION("decode once")
+    {
+        auto lazy = make_image(8, nullptr);
+        REQUIRE(lazy->get_encoded_data().size() == 3);
+        REQUIRE(lazy->get_mime_type() == "image/png");
+        REQUIRE(!lazy->is_decoded());
+
+        ImageExperimental image;
+        image.lazy_image = lazy;
+        auto buffer = image.get_image();
+        REQUIRE(buffer->width == 8);
+        REQUIRE(lazy->is_decoded());
+        REQUIRE(image.get_image() == buffer);
+        REQUIRE(num_decoded == 1);
+
+        lazy->release();
+        REQUIRE(!lazy->is_decoded());
+        REQUIRE(buffer->data.size() == 8);
+        REQUIRE(image.get_image()->width == 8);
+        REQUIRE(num_decoded == 2);
+    }
+
+    SECTION("concurrent access")
+    {
+        auto lazy = make_image(8, nullptr);
+        std::vector<std::shared_ptr<const ImageBufferExperimental>> buffers(64);
+        tbb::parallel_for(size_t(0), buffers.size(), [&](size_t i) {
+            buffers[i] = lazy->get_image();
+        });
+        REQUIRE(num_decoded == 1);
+        for (const auto& buffer : buffers) {
+            REQUIRE(buffer == buffers.front());
+        }
+    }
+
+    SECTION("cache budget")
+    {
+        auto cache = std::make_shared<ImageCacheExperimental>(20);
+        auto a = make_image(8, cache);
+        auto b = make_image(8, cache);
+        auto c = make_image(8, cache);
+
+        a->get_image();
+        b->get_image();
+        REQUIRE(cache->get_num_bytes() == 16);
+        a->get_image(); // a is now the most recently used.
+        c->get_image();
+        REQUIRE(cache->get_num_bytes() == 16);
+        REQUIRE(a->is_decoded());
+        REQUIRE(!b->is_decoded());
+        REQUIRE(c->is_decoded());
+
+        c.reset();
+        REQUIRE(cache->get_num_bytes() == 8);
+        a->release();
+        REQUIRE(cache->get_num_bytes() == 0);
+
+        // An image larger than the budget is still kept while it is the most recent one.
+        auto d = make_image(32, cache);
+        d->get_image();
+        REQUIRE(d->is_decoded());
+        REQUIRE(cache->get_num_bytes() == 32);
+    }
+
+    SECTION("eager image")
+    {
+        ImageExperimental image;
+        image.image.width = 2;
+        image.image.data.assign(2, 0);
+        REQUIRE(image.get_image().get() == &image.image);
+    }
+}
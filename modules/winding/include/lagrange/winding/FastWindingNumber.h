@@ -13,6 +13,10 @@
 #pragma once
 
 #include <lagrange/SurfaceMesh.h>
+#include <lagrange/utils/span.h>
+
+#include <array>
+#include <cstdint>
 
 namespace lagrange {
 
@@ -28,7 +32,8 @@ public:
     /// Constructs an acceleration structure on a given mesh to speed up winding number queries.
     ///
     /// @note       Internally, point coordinates are converted to `float` and vertex indices are
-    ///             converted to `int`.
+    ///             converted to `int`. For `SurfaceMesh<float, uint32_t>`, the mesh buffers are
+    ///             shared with the input mesh (copy-on-write) instead of being copied.
     ///
     /// @param[in]  mesh    Triangle mesh used to initialize the fast winding number acceleration
     ///                     structure.
@@ -99,6 +104,25 @@ public:
     ///
     float solid_angle(const std::array<float, 3>& pos) const;
 
+    ///
+    /// Determines whether a batch of query points are inside the volume. Queries are evaluated in
+    /// parallel, and reordered along a space-filling curve so that each thread processes groups of
+    /// nearby points that traverse the same parts of the tree.
+    ///
+    /// @param[in]  queries  #N query positions.
+    /// @param[out] inside   #N output flags, set to 1 if the query point is inside, 0 otherwise.
+    ///
+    void is_inside(span<const std::array<float, 3>> queries, span<uint8_t> inside) const;
+
+    ///
+    /// Computes the solid angle at a batch of query points. Queries are evaluated in parallel, in
+    /// the same order as the batched `is_inside()`.
+    ///
+    /// @param[in]  queries       #N query positions.
+    /// @param[out] solid_angles  #N output solid angles.
+    ///
+    void solid_angle(span<const std::array<float, 3>> queries, span<float> solid_angles) const;
+
 protected:
     /// Internal implementation.
     struct Impl;
@@ -10,59 +10,131 @@
  * governing permissions and limitations under the License.
  */
 
+#include <lagrange/Attribute.h>
 #include <lagrange/SurfaceMeshTypes.h>
 #include <lagrange/utils/assert.h>
 #include <lagrange/utils/safe_cast.h>
-#include <lagrange/views.h>
 #include <lagrange/winding/FastWindingNumber.h>
 
 #include <UT_SolidAngle.h>
 
+// clang-format off
+#include <lagrange/utils/warnoff.h>
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/parallel_sort.h>
+#include <lagrange/utils/warnon.h>
+// clang-format on
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <type_traits>
 #include <vector>
 
 namespace lagrange {
 
 namespace winding {
 
+namespace {
+
+// Spread the lower 10 bits of x so that there are two zero bits between consecutive bits.
+uint32_t spread_bits(uint32_t x)
+{
+    x &= 0x3ff;
+    x = (x | (x << 16)) & 0x030000ff;
+    x = (x | (x << 8)) & 0x0300f00f;
+    x = (x | (x << 4)) & 0x030c30c3;
+    x = (x | (x << 2)) & 0x09249249;
+    return x;
+}
+
+///
+/// Sort query points along a Morton curve, so that consecutive queries are spatially close.
+///
+/// @param[in]  queries  Query points.
+///
+/// @return     Query indices, in Morton order.
+///
+std::vector<size_t> compute_coherent_order(span<const std::array<float, 3>> queries)
+{
+    std::array<float, 3> bbox_min, bbox_max;
+    bbox_min.fill(std::numeric_limits<float>::max());
+    bbox_max.fill(std::numeric_limits<float>::lowest());
+    for (const auto& q : queries) {
+        for (int k = 0; k < 3; ++k) {
+            bbox_min[k] = std::min(bbox_min[k], q[k]);
+            bbox_max[k] = std::max(bbox_max[k], q[k]);
+        }
+    }
+
+    std::vector<uint32_t> codes(queries.size());
+    tbb::parallel_for(size_t(0), queries.size(), [&](size_t i) {
+        uint32_t code = 0;
+        for (int k = 0; k < 3; ++k) {
+            const float extent = bbox_max[k] - bbox_min[k];
+            const float t = extent > 0 ? (queries[i][k] - bbox_min[k]) / extent : 0.f;
+            code |= spread_bits(static_cast<uint32_t>(std::clamp(t, 0.f, 1.f) * 1023.f)) << k;
+        }
+        codes[i] = code;
+    });
+
+    std::vector<size_t> order(queries.size());
+    std::iota(order.begin(), order.end(), size_t(0));
+    tbb::parallel_sort(order.begin(), order.end(), [&](size_t i, size_t j) {
+        return codes[i] < codes[j] || (codes[i] == codes[j] && i < j);
+    });
+    return order;
+}
+
+} // namespace
+
 struct FastWindingNumber::Impl
 {
 public:
-    template <typename DerivedV, typename DerivedF>
-    void initialize(
-        const Eigen::MatrixBase<DerivedV>& vertices,
-        const Eigen::MatrixBase<DerivedF>& facets)
+    template <typename Scalar, typename Index>
+    void initialize(const SurfaceMesh<Scalar, Index>& mesh)
     {
-        la_runtime_assert(vertices.cols() == 3);
-        la_runtime_assert(facets.cols() == 3);
-
-        // TODO: Avoid copy if possible. For now we just copy stuff around.
-        m_vertices.resize(vertices.rows());
-        for (Eigen::Index v = 0; v < vertices.rows(); ++v) {
-            m_vertices[v][0] = static_cast<float>(vertices(v, 0));
-            m_vertices[v][1] = static_cast<float>(vertices(v, 1));
-            m_vertices[v][2] = static_cast<float>(vertices(v, 2));
+        la_runtime_assert(
+            mesh.get_num_vertices() <= safe_cast<Index>(std::numeric_limits<int>::max()),
+            "Too many vertices for the fast winding number engine");
+
+        const float* vertices_ptr = nullptr;
+        const int* triangles_ptr = nullptr;
+        if constexpr (std::is_same_v<Scalar, float> && std::is_same_v<Index, uint32_t>) {
+            // Share the mesh buffers. Vertex indices fit in an int, so they can be reinterpreted.
+            m_mesh = mesh;
+            vertices_ptr = m_mesh.get_vertex_to_position().get_all().data();
+            triangles_ptr =
+                reinterpret_cast<const int*>(m_mesh.get_corner_to_vertex().get_all().data());
+        } else {
+            auto vertices = mesh.get_vertex_to_position().get_all();
+            auto corners = mesh.get_corner_to_vertex().get_all();
+            m_vertices.resize(vertices.size());
+            m_triangles.resize(corners.size());
+            tbb::parallel_for(size_t(0), vertices.size(), [&](size_t i) {
+                m_vertices[i] = static_cast<float>(vertices[i]);
+            });
+            tbb::parallel_for(size_t(0), corners.size(), [&](size_t i) {
+                m_triangles[i] = static_cast<int>(corners[i]);
+            });
+            vertices_ptr = m_vertices.data();
+            triangles_ptr = m_triangles.data();
         }
 
-        m_triangles.resize(facets.rows());
-        for (Eigen::Index f = 0; f < facets.rows(); ++f) {
-            m_triangles[f][0] = static_cast<int>(facets(f, 0));
-            m_triangles[f][1] = static_cast<int>(facets(f, 1));
-            m_triangles[f][2] = static_cast<int>(facets(f, 2));
-        }
-
-        const int num_vertices = static_cast<int>(m_vertices.size());
-        const int num_triangles = static_cast<int>(m_triangles.size());
-        const int* const triangles_ptr = reinterpret_cast<const int*>(m_triangles.data());
-        m_engine.init(num_triangles, triangles_ptr, num_vertices, m_vertices.data());
+        static_assert(sizeof(Vector) == 3 * sizeof(float));
+        const int num_vertices = static_cast<int>(mesh.get_num_vertices());
+        const int num_triangles = static_cast<int>(mesh.get_num_facets());
+        m_engine.init(
+            num_triangles,
+            triangles_ptr,
+            num_vertices,
+            reinterpret_cast<const Vector*>(vertices_ptr));
     }
 
     bool is_inside(const std::array<float, 3>& pos) const
     {
-        Vector q;
-        q[0] = pos[0];
-        q[1] = pos[1];
-        q[2] = pos[2];
-        return m_engine.computeSolidAngle(q) / (4.f * M_PI) > 0.5f;
+        return solid_angle(pos) / (4.f * M_PI) > 0.5f;
     }
 
     float solid_angle(const std::array<float, 3>& pos) const
@@ -74,12 +146,30 @@ public:
         return m_engine.computeSolidAngle(q);
     }
 
+    template <typename Func>
+    void foreach_query(span<const std::array<float, 3>> queries, Func func) const
+    {
+        const auto order = compute_coherent_order(queries);
+        tbb::parallel_for(
+            tbb::blocked_range<size_t>(0, order.size(), 256),
+            [&](const tbb::blocked_range<size_t>& r) {
+                for (size_t i = r.begin(); i != r.end(); ++i) {
+                    func(order[i], solid_angle(queries[order[i]]));
+                }
+            });
+    }
+
 protected:
     using Vector = HDK_Sample::UT_Vector3T<float>;
     using Engine = HDK_Sample::UT_SolidAngle<float, float>;
 
-    std::vector<Vector> m_vertices;
-    std::vector<std::array<int, 3>> m_triangles;
+    // Shared buffers, when the input mesh is a SurfaceMesh<float, uint32_t>.
+    SurfaceMesh<float, uint32_t> m_mesh;
+
+    // Converted buffers, for other mesh types.
+    std::vector<float> m_vertices;
+    std::vector<int> m_triangles;
+
     Engine m_engine;
 };
 
@@ -93,7 +183,7 @@ FastWindingNumber::FastWindingNumber(const SurfaceMesh<Scalar, Index>& mesh)
     la_runtime_assert(
         mesh.is_triangle_mesh(),
         "Fast winding number engine only supports triangle meshes");
-    m_impl->initialize(vertex_view(mesh), facet_view(mesh));
+    m_impl->initialize(mesh);
 }
 
 FastWindingNumber::FastWindingNumber() = default;
@@ -111,6 +201,24 @@ float FastWindingNumber::solid_angle(const std::array<float, 3>& pos) const
     return m_impl->solid_angle(pos);
 }
 
+void FastWindingNumber::is_inside(
+    span<const std::array<float, 3>> queries,
+    span<uint8_t> inside) const
+{
+    la_runtime_assert(inside.size() == queries.size(), "Output size mismatch");
+    m_impl->foreach_query(queries, [&](size_t i, float angle) {
+        inside[i] = (angle / (4.f * M_PI) > 0.5f);
+    });
+}
+
+void FastWindingNumber::solid_angle(
+    span<const std::array<float, 3>> queries,
+    span<float> solid_angles) const
+{
+    la_runtime_assert(solid_angles.size() == queries.size(), "Output size mismatch");
+    m_impl->foreach_query(queries, [&](size_t i, float angle) { solid_angles[i] = angle; });
+}
+
 // Iterate over mesh (scalar, index) types
 #define LA_X_fast_winding_number(_, Scalar, Index) \
     template FastWindingNumber::FastWindingNumber(const SurfaceMesh<Scalar, Index>& mesh);
@@ -10,6 +10,7 @@
  * governing permissions and limitations under the License.
  */
 #include <lagrange/testing/common.h>
+#include <lagrange/testing/create_test_mesh.h>
 #include <lagrange/views.h>
 #include <lagrange/winding/FastWindingNumber.h>
 
@@ -17,6 +18,7 @@
 #include <Eigen/Geometry>
 #include <catch2/benchmark/catch_benchmark.hpp>
 
+#include <algorithm>
 #include <random>
 
 namespace {
@@ -80,6 +82,53 @@ TEST_CASE("winding number noop", "[winding]")
     SUCCEED();
 }
 
+namespace {
+
+template <typename Scalar, typename Index>
+void test_batch_queries()
+{
+    lagrange::testing::CreateOptions opt;
+    opt.with_indexed_normal = false;
+    opt.with_indexed_uv = false;
+    auto mesh = lagrange::testing::create_test_cube<Scalar, Index>(opt);
+    lagrange::winding::FastWindingNumber engine(mesh);
+
+    // Random queries in [-2, 2]^3, away from the cube [-1, 1]^3 boundary.
+    std::mt19937 gen;
+    std::uniform_real_distribution<float> dist(-2.f, 2.f);
+    std::vector<std::array<float, 3>> queries;
+    std::vector<uint8_t> expected;
+    while (queries.size() < 5000) {
+        std::array<float, 3> q = {dist(gen), dist(gen), dist(gen)};
+        float d = 0;
+        for (float x : q) d = std::max(d, std::abs(x));
+        if (std::abs(d - 1.f) < 1e-2f) continue;
+        queries.push_back(q);
+        expected.push_back(d < 1.f);
+    }
+
+    std::vector<uint8_t> inside(queries.size());
+    std::vector<float> solid_angles(queries.size());
+    engine.is_inside(queries, inside);
+    engine.solid_angle(queries, solid_angles);
+    for (size_t i = 0; i < queries.size(); ++i) {
+        REQUIRE(inside[i] == expected[i]);
+        REQUIRE(bool(inside[i]) == engine.is_inside(queries[i]));
+        REQUIRE(solid_angles[i] == engine.solid_angle(queries[i]));
+    }
+
+    std::vector<uint8_t> too_small(queries.size() - 1);
+    LA_REQUIRE_THROWS(engine.is_inside(queries, too_small));
+}
+
+} // namespace
+
+TEST_CASE("fast winding number batch", "[winding]")
+{
+    test_batch_queries<float, uint32_t>();
+    test_batch_queries<double, uint64_t>();
+}
+
 TEST_CASE("fast winding number", "[winding][!benchmark]")
 {
     using Scalar = float;
@@ -110,6 +159,19 @@ TEST_CASE("fast winding number", "[winding][!benchmark]")
         });
     };
 
+    BENCHMARK_ADVANCED("batch")(Catch::Benchmark::Chronometer meter)
+    {
+        lagrange::winding::FastWindingNumber engine(mesh);
+        std::mt19937 gen;
+        std::vector<std::array<float, 3>> queries(num_samples);
+        for (auto& q : queries) q = {px(gen), py(gen), pz(gen)};
+        std::vector<uint8_t> inside(num_samples);
+        meter.measure([&]() {
+            engine.is_inside(queries, inside);
+            return std::count(inside.begin(), inside.end(), uint8_t(1));
+        });
+    };
+
     BENCHMARK_ADVANCED("direct wrapper")(Catch::Benchmark::Chronometer meter)
     {
         FastWindingNumberDirect engine;